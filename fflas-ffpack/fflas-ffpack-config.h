@@ -89,7 +89,28 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
 
 #include "fflas-ffpack/fflas-ffpack-optimise.h"
 
-#if defined(__FFLASFFPACK_USE_SSE) or defined(__FFLASFFPACK_USE_AVX) or defined(__FFLASFFPACK_USE_AVX2)
+// libfflas and libffpack built with --enable-simd-dispatch are compiled
+// without the instruction set flags found by configure, their SIMD variants
+// being chosen at runtime: only keep what the compiler flags still allow
+#ifdef __FFLASFFPACK_DISPATCH_BASELINE
+#ifndef __SSE4_1__
+#undef __FFLASFFPACK_USE_SSE
+#endif
+#ifndef __AVX__
+#undef __FFLASFFPACK_USE_AVX
+#endif
+#ifndef __AVX2__
+#undef __FFLASFFPACK_USE_AVX2
+#endif
+#ifndef __AVX512F__
+#undef __FFLASFFPACK_USE_AVX512F
+#endif
+#ifndef __AVX512IFMA__
+#undef __FFLASFFPACK_USE_AVX512IFMA
+#endif
+#endif
+
+#if defined(__FFLASFFPACK_USE_SSE) or defined(__FFLASFFPACK_USE_AVX) or defined(__FFLASFFPACK_USE_AVX2) or defined(__FFLASFFPACK_USE_AVX512F)
 #define __FFLASFFPACK_USE_SIMD // see configure...
 #endif
 
@@ -123,7 +144,7 @@ _GLIBCXX_BEGIN_NAMESPACE_VERSION
 #ifdef __x86_64__
 #if defined(__GNUC__) || defined (__clang__) /* who supports __int128_t ? */
 #define int128_t __int128_t
-#define uint128_t unsigned __int128_t
+#define uint128_t __uint128_t
 #else /* hopefully this exists */
 #define int128_t __int128
 #define uint128_t unsigned __int128
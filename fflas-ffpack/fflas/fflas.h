@@ -54,10 +54,10 @@
 /** Thresholds determining which floating point representation to use, depending
  * on the cardinality of the finite field. This is only used when the element
  * representation is not a floating point type.
- * @bug to be benchmarked.
+ * Read from the machine profile (see utils/fflas_tuning.h) unless defined here.
  */
 #ifndef DOUBLE_TO_FLOAT_CROSSOVER
-#define DOUBLE_TO_FLOAT_CROSSOVER 800
+#define DOUBLE_TO_FLOAT_CROSSOVER (FFLAS::tuning().double_to_float_crossover)
 #endif
 
 #include <float.h>
@@ -69,6 +69,7 @@
 #include "fflas_enum.h"
 
 #include "fflas-ffpack/utils/fflas_memory.h"
+#include "fflas-ffpack/utils/fflas_tuning.h"
 #include "fflas-ffpack/paladin/parallel.h"
 
 //---------------------------------------------------------------------
@@ -103,13 +104,16 @@
 
 #include "fflas_fgemm.inl"
 #include "fflas_pfgemm.inl"
+#include "fflas_fgemm_batched.inl"
 // fgemm must be before fgemv according to ScalAndReduce function declaration ?!? PG
 #include "fflas_fgemv.inl"
 #include "fflas_freivalds.inl"
 #include "fflas_fger.inl"
+#include "fflas_pfgemv.inl"
 #include "fflas_ftrsm.inl"
 #include "fflas_pftrsm.inl"
 #include "fflas_ftrmm.inl"
+#include "fflas_fsyrk.inl"
 #include "fflas_ftrsv.inl"
 #include "fflas_faxpy.inl"
 #include "fflas_fdot.inl"
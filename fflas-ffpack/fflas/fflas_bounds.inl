@@ -108,6 +108,31 @@ namespace FFLAS { namespace Protected {
 		//kmax--; // we computed a strict upper bound
 		return  (size_t) std::min ((uint64_t)kmax, 1_ui64 << 31);
 	}
+
+	/** \brief Largest inner dimension \c kr of the blocks for which one level
+	 * of Bini's scheme over \p w levels of Winograd's algorithm is exact.
+	 *
+	 * With \f$\epsilon = p\f$ and inputs bounded by \f$c\f$, the operands of
+	 * the 10 products are bounded by \f$(p+1)c\f$ and their combinations
+	 * by \f$2(p+1)(p+2)k_rc^2\f$; each level of Winograd's algorithm below
+	 * multiplies the bound on the products by at most 9.
+	 * Returns 0 if no \c kr fits (or if p = 0).
+	 */
+	template <class Field>
+	inline size_t BiniBound (const Field& F, const int w)
+	{
+		Givaro::Integer p=0;
+		F.characteristic(p);
+		if (p == 0)
+			return 0;
+
+		double c = computeFactorClassic(F);
+		double e = (double) p;
+		double g = std::max (std::pow (9.0, w) * (e+1) * (e+1), 2 * (e+1) * (e+2));
+		double kmax = floor (double (limits<typename Field::Element>::max()) / (c*c*g));
+		if (kmax < 1) return 0;
+		return  (size_t) std::min ((uint64_t)kmax, 1_ui64 << 31);
+	}
 		
 } // FFLAS
 } // Protected
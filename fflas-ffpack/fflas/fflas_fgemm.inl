@@ -89,6 +89,7 @@ namespace FFLAS { namespace Protected{
 		MMHelper<Givaro::ModularBalanced<FloatElement>, 
 			 MMHelperAlgo::Winograd> 
 			HG(G,H.recLevel, ParSeqHelper::Sequential());
+		HG.workspace = H.workspace;
 		fgemm (G, ta, tb, m, n, k, alphaf, Af, ldaf, Bf, ldbf, betaf, Cf, ldcf, HG);
 
 		finit (F, m, n, Cf, n, C, ldc);
@@ -98,6 +99,19 @@ namespace FFLAS { namespace Protected{
 		fflas_delete (Cf);
 		return C;
 	}
+
+	// defined in fflas_fgemm/fgemm_bini.inl
+	template<class Field>
+	inline bool fgemm_bini_auto (const Field& F,
+				     const FFLAS_TRANSPOSE ta,
+				     const FFLAS_TRANSPOSE tb,
+				     const size_t m, const size_t n, const size_t k,
+				     const typename Field::Element alpha,
+				     typename Field::ConstElement_ptr A, const size_t lda,
+				     typename Field::ConstElement_ptr B, const size_t ldb,
+				     const typename Field::Element beta,
+				     typename Field::Element_ptr C, const size_t ldc,
+				     MMHelper<Field, MMHelperAlgo::Winograd, ModeCategories::DelayedTag, ParSeqHelper::Sequential> & H);
 	}//Protected
 }//FFLAS
 
@@ -394,7 +408,12 @@ namespace FFLAS {
 		    Protected::AreEqual<Field, Givaro::ModularBalanced<int64_t> >::value)
 			if (16*F.cardinality() < Givaro::ModularBalanced<double>::maxCardinality())
 				return Protected::fgemm_convert<double,Field>(F,ta,tb,m,n,k,alpha,A,lda,B,ldb,beta,C,ldc,H);
-		
+
+		// Bini's scheme in place of the top level of Winograd's recursion, when exact
+		if (H.recLevel < 0 &&
+		    Protected::fgemm_bini_auto (F, ta, tb, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, H))
+			return C;
+
 		typename Field::Element alpha_,beta_;
 		if ( !F.isOne(alpha) && !F.isMOne(alpha)){
 			F.assign (alpha_, F.one);
@@ -420,7 +439,8 @@ namespace FFLAS {
 // #include "fflas_fgemm/matmul_algos.inl"
 #include "fflas_fgemm/fgemm_classical.inl"
 #include "fflas_fgemm/fgemm_winograd.inl"
-// #include "fflas_fgemm/gemm_bini.inl"
+#include "fflas_fgemm/fgemm_packed.inl"
+#include "fflas_fgemm/fgemm_bini.inl"
 
 // fsquare
 namespace FFLAS {
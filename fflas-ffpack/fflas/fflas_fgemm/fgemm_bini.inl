@@ -0,0 +1,292 @@
+/* -*- mode: C++; tab-width: 8; indent-tabs-mode: t; c-basic-offset: 8 -*- */
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/*
+ * Copyright (C) 2016 the FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ *.
+ */
+
+/** @file fflas_fgemm/fgemm_bini.inl
+ * @brief Bini's 3x2x2 product over a small prime field.
+ *
+ * One level of Bini's scheme (see BLAS3::Bini) over Winograd's algorithm,
+ * the ten products being computed over \f$\mathbb{Z}\f$ and reduced once
+ * at the end.  It saves one sixth of the products of the top level when the
+ * dimensions are too small for one more level of Winograd's algorithm to pay
+ * off, and is exact as long as the inner dimension of the blocks does not
+ * exceed Protected::BiniBound.
+ * Selected with <code>MMHelper<Field, MMHelperAlgo::Bini></code>, or by
+ * the default fgemm when \f$p\f$ and \f$k\f$ allow it.
+ */
+
+#ifndef __FFLASFFPACK_fflas_fflas_fgemm_bini_INL
+#define __FFLASFFPACK_fflas_fflas_fgemm_bini_INL
+
+#include "schedule_bini.inl"
+
+namespace FFLAS { namespace Protected {
+
+	//! Fields over which Bini's scheme is implemented
+	template<class Field>
+	struct IsBiniField : std::integral_constant<bool,
+		std::is_floating_point<typename Field::Element>::value &&
+		std::is_same<typename ModeTraits<Field>::value, ModeCategories::DelayedTag>::value> {};
+
+	//! Whether one level of Bini's scheme over \p w levels of Winograd's algorithm is exact for a \p m x \p n x \p k product
+	template<class Field>
+	inline bool BiniFits (const Field& F, const size_t m, const size_t n, const size_t k, const int w)
+	{
+		const size_t mr = (m / (3 << w)) << w;
+		const size_t nr = (n / (2 << w)) << w;
+		const size_t kr = (k / (2 << w)) << w;
+		if (!mr || !nr || !kr)
+			return false;
+		return kr <= BiniBound (F, w);
+	}
+
+	/** Number of levels of Winograd's algorithm below the Bini level: the
+	 * largest one not above \p w0 for which the scheme is exact, -1 if none.
+	 * \param w0 -1 for one level less than the default Winograd recursion
+	 */
+	template<class Field>
+	inline int BiniSteps (const Field& F, const size_t m, const size_t n, const size_t k, int w0)
+	{
+		if (w0 < 0)
+			w0 = std::max (WinogradSteps (F, min3(m,k,n)) - 1, 0);
+		for (int w = w0; w >= 0; --w)
+			if (BiniFits (F, m, n, k, w))
+				return w;
+		return -1;
+	}
+
+	template<class Field>
+	inline int BiniAutoSteps (const Field& F, const size_t m, const size_t n, const size_t k, std::false_type)
+	{
+		return -1;
+	}
+
+	template<class Field>
+	inline int BiniAutoSteps (const Field& F, const size_t m, const size_t n, const size_t k, std::true_type)
+	{
+		// below the crossover, the default fgemm works over single precision floats
+		if (F.characteristic() < DOUBLE_TO_FLOAT_CROSSOVER)
+			return -1;
+		const int w = WinogradSteps (F, min3(m,k,n)) - 1;
+		return (w >= 0 && BiniFits (F, m, n, k, w)) ? w : -1;
+	}
+
+	/** Levels below the Bini level when the default fgemm replaces the top
+	 * level of its Winograd recursion by Bini's scheme, -1 when it does not.
+	 */
+	template<class Field>
+	inline int BiniAutoSteps (const Field& F, const size_t m, const size_t n, const size_t k)
+	{
+		return BiniAutoSteps (F, m, n, k, typename IsBiniField<Field>::type());
+	}
+
+	//! Temporaries of BLAS3::Bini, with \p w levels of Winograd's algorithm below
+	template<class Field>
+	inline size_t BiniCalcWorkspace (const Field& F, const size_t mr, const size_t nr, const size_t kr, const int w)
+	{
+		return WorkspaceFootprint (F, mr, kr) + WorkspaceFootprint (F, kr, nr)
+			+ 2 * WorkspaceFootprint (F, mr, nr)
+			+ fgemm_workspace_size (F, mr, nr, kr, w);
+	}
+
+	template<class Field>
+	inline size_t BiniWorkspaceSize (const Field& F, const size_t m, const size_t n, const size_t k, const int w)
+	{
+		if (!m || !n || !k)
+			return 0;
+		const int ww = BiniSteps (F, m, n, k, w);
+		if (ww < 0)
+			return fgemm_workspace_size (F, m, n, k);
+		const size_t mr = (m / (3 << ww)) << ww;
+		const size_t nr = (n / (2 << ww)) << ww;
+		const size_t kr = (k / (2 << ww)) << ww;
+
+		size_t ws = WorkspaceFootprint (F, 3*mr, 2*nr) + BiniCalcWorkspace (F, mr, nr, kr, ww);
+		// the peeled products run after the Bini level, with the default fgemm
+		if (k > 2*kr) ws = std::max (ws, fgemm_workspace_size (F, 3*mr, 2*nr, k-2*kr));
+		if (n > 2*nr) ws = std::max (ws, fgemm_workspace_size (F, 3*mr, n-2*nr, k));
+		if (m > 3*mr) ws = std::max (ws, fgemm_workspace_size (F, m-3*mr, n, k));
+		return ws;
+	}
+
+	template<class Field>
+	inline bool fgemm_bini_auto (const Field& F,
+				     const FFLAS_TRANSPOSE ta,
+				     const FFLAS_TRANSPOSE tb,
+				     const size_t m, const size_t n, const size_t k,
+				     const typename Field::Element alpha,
+				     typename Field::ConstElement_ptr A, const size_t lda,
+				     typename Field::ConstElement_ptr B, const size_t ldb,
+				     const typename Field::Element beta,
+				     typename Field::Element_ptr C, const size_t ldc,
+				     MMHelper<Field, MMHelperAlgo::Winograd, ModeCategories::DelayedTag, ParSeqHelper::Sequential> & H,
+				     std::false_type)
+	{
+		return false;
+	}
+
+	template<class Field>
+	inline bool fgemm_bini_auto (const Field& F,
+				     const FFLAS_TRANSPOSE ta,
+				     const FFLAS_TRANSPOSE tb,
+				     const size_t m, const size_t n, const size_t k,
+				     const typename Field::Element alpha,
+				     typename Field::ConstElement_ptr A, const size_t lda,
+				     typename Field::ConstElement_ptr B, const size_t ldb,
+				     const typename Field::Element beta,
+				     typename Field::Element_ptr C, const size_t ldc,
+				     MMHelper<Field, MMHelperAlgo::Winograd, ModeCategories::DelayedTag, ParSeqHelper::Sequential> & H,
+				     std::true_type)
+	{
+		const int w = BiniAutoSteps (F, m, n, k);
+		if (w < 0)
+			return false;
+		MMHelper<Field, MMHelperAlgo::Bini, ModeCategories::DelayedTag> HB(H);
+		HB.recLevel = w;
+		fgemm (F, ta, tb, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, HB);
+		H.initOut();
+		return true;
+	}
+
+	/** Runs the product with Bini's scheme if the default fgemm should,
+	 * returns false otherwise (and does nothing).
+	 */
+	template<class Field>
+	inline bool fgemm_bini_auto (const Field& F,
+				     const FFLAS_TRANSPOSE ta,
+				     const FFLAS_TRANSPOSE tb,
+				     const size_t m, const size_t n, const size_t k,
+				     const typename Field::Element alpha,
+				     typename Field::ConstElement_ptr A, const size_t lda,
+				     typename Field::ConstElement_ptr B, const size_t ldb,
+				     const typename Field::Element beta,
+				     typename Field::Element_ptr C, const size_t ldc,
+				     MMHelper<Field, MMHelperAlgo::Winograd, ModeCategories::DelayedTag, ParSeqHelper::Sequential> & H)
+	{
+		return fgemm_bini_auto (F, ta, tb, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, H,
+					typename IsBiniField<Field>::type());
+	}
+
+} // Protected
+} // FFLAS
+
+namespace FFLAS {
+
+	/** Bini's product over a prime field with floating point elements.
+	 * \f$C \gets \alpha \mathrm{op}(A) \mathrm{op}(B) + \beta C\f$, inputs are reduced.
+	 * \c H.recLevel is the number of levels of Winograd's algorithm below the
+	 * Bini level (-1 for the default), lowered until the scheme is exact.
+	 * Falls back to the default schedule when it never is.
+	 */
+	template<class Field>
+	inline typename std::enable_if<std::is_floating_point<typename Field::Element>::value, typename Field::Element_ptr>::type
+	fgemm (const Field& F,
+	       const FFLAS_TRANSPOSE ta,
+	       const FFLAS_TRANSPOSE tb,
+	       const size_t m, const size_t n, const size_t k,
+	       const typename Field::Element alpha,
+	       typename Field::ConstElement_ptr A, const size_t lda,
+	       typename Field::ConstElement_ptr B, const size_t ldb,
+	       const typename Field::Element beta,
+	       typename Field::Element_ptr C, const size_t ldc,
+	       MMHelper<Field, MMHelperAlgo::Bini, ModeCategories::DelayedTag, ParSeqHelper::Sequential> & H)
+	{
+		typedef MMHelper<Field, MMHelperAlgo::Winograd, ModeCategories::DelayedTag> WinoHelper;
+
+		if (!m || !n) {return C;}
+
+		if (!k || F.isZero (alpha)){
+			fscalin(F, m, n, beta, C, ldc);
+			return C;
+		}
+
+		const int w = Protected::BiniSteps (F, m, n, k, H.recLevel);
+		if (w < 0) {
+			WinoHelper HW(F, m, k, n, ParSeqHelper::Sequential());
+			HW.workspace = H.workspace;
+			fgemm (F, ta, tb, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, HW);
+			H.initOut();
+			return C;
+		}
+		const size_t mr = (m / (3 << w)) << w;
+		const size_t nr = (n / (2 << w)) << w;
+		const size_t kr = (k / (2 << w)) << w;
+
+		{
+			MMHelper<Field, MMHelperAlgo::Bini, ModeCategories::DelayedTag> HB(H);
+			HB.recLevel = w;
+			Protected::WorkspaceFrame ws (H.workspace);
+			// the product is written in C when nothing has to be added to it
+			const bool direct = F.isZero (beta) && F.isOne (alpha);
+			typename Field::Element_ptr P = direct ? C : ws.allocate (F, 3*mr, 2*nr);
+			const size_t ldp = direct ? ldc : 2*nr;
+
+			BLAS3::Bini (F, ta, tb, mr, nr, kr, A, lda, B, ldb, P, ldp, HB);
+			freduce (F, 3*mr, 2*nr, P, ldp);
+			if (!direct) {
+				fscalin (F, 3*mr, 2*nr, beta, C, ldc);
+				faxpy (F, 3*mr, 2*nr, alpha, P, ldp, C, ldc);
+				ws.release (P);
+			}
+		}
+
+		// peeled parts of op(A) and op(B)
+		typename Field::ConstElement_ptr A12 = (ta == FflasNoTrans) ? A + 2*kr : A + 2*kr*lda;
+		typename Field::ConstElement_ptr A21 = (ta == FflasNoTrans) ? A + 3*mr*lda : A + 3*mr;
+		typename Field::ConstElement_ptr B12 = (tb == FflasNoTrans) ? B + 2*nr : B + 2*nr*ldb;
+		typename Field::ConstElement_ptr B21 = (tb == FflasNoTrans) ? B + 2*kr*ldb : B + 2*kr;
+		if (k > 2*kr) {
+			WinoHelper HW(F, 3*mr, k-2*kr, 2*nr, ParSeqHelper::Sequential());
+			HW.workspace = H.workspace;
+			fgemm (F, ta, tb, 3*mr, 2*nr, k-2*kr, alpha, A12, lda, B21, ldb, F.one, C, ldc, HW);
+		}
+		if (n > 2*nr) {
+			WinoHelper HW(F, 3*mr, k, n-2*nr, ParSeqHelper::Sequential());
+			HW.workspace = H.workspace;
+			fgemm (F, ta, tb, 3*mr, n-2*nr, k, alpha, A, lda, B12, ldb, beta, C+2*nr, ldc, HW);
+		}
+		if (m > 3*mr) {
+			WinoHelper HW(F, m-3*mr, k, n, ParSeqHelper::Sequential());
+			HW.workspace = H.workspace;
+			fgemm (F, ta, tb, m-3*mr, n, k, alpha, A21, lda, B, ldb, beta, C+3*mr*ldc, ldc, HW);
+		}
+		H.initOut();
+		return C;
+	}
+
+	/** \brief Size of a MMWorkspace for one sequential fgemm with
+	 * <code>MMHelper<Field, MMHelperAlgo::Bini></code>, as fgemm_workspace_size.
+	 * \param w number of levels of Winograd's algorithm below the Bini level, -1 for the default
+	 */
+	template<class Field>
+	inline size_t fgemm_bini_workspace_size (const Field& F,
+						 const size_t m, const size_t n, const size_t k,
+						 const int w = -1)
+	{
+		return Protected::BiniWorkspaceSize (F, m, n, k, w);
+	}
+
+} // FFLAS
+
+#endif // __FFLASFFPACK_fflas_fflas_fgemm_bini_INL
@@ -39,10 +39,100 @@
 #include <cmath>
 
 #include "fflas-ffpack/field/field-traits.h"
-#if defined(__AVX2__) or defined(__AVX__) or defined(__SSE4_1__)
 #include "fflas-ffpack/fflas/fflas_igemm/igemm.h"
-#endif
 #include "fflas-ffpack/utils/Matio.h"
+
+namespace FFLAS { namespace Protected {
+
+	//! whether fgemm_igemm52 handles the field \p F
+	template<class Field>
+	inline bool has_igemm52 (const Field& F)
+	{
+		return false;
+	}
+
+	// Classic multiplication modulo a word size prime with 52 bits products,
+	// for the primes whose products cannot be delayed over int64_t at all,
+	// or, with IFMA, need more than one block of the inner dimension
+	template<class Field>
+	inline bool fgemm_igemm52 (const Field& F,
+				   const FFLAS_TRANSPOSE ta,
+				   const FFLAS_TRANSPOSE tb,
+				   const size_t m, const size_t n,const size_t k,
+				   const typename Field::Element alpha,
+				   typename Field::ConstElement_ptr A, const size_t lda,
+				   typename Field::ConstElement_ptr B, const size_t ldb,
+				   const typename Field::Element beta,
+				   typename Field::Element_ptr C, const size_t ldc)
+	{
+		return false;
+	}
+
+#ifdef __FFLASFFPACK_HAVE_IGEMM52
+	inline bool has_igemm52 (const Givaro::Modular<int64_t>& F)
+	{
+		return (uint64_t) F.characteristic() < details::igemm52_maxmod;
+	}
+
+	inline bool has_igemm52 (const Givaro::ModularBalanced<int64_t>& F)
+	{
+		return (uint64_t) F.characteristic() < details::igemm52_maxmod;
+	}
+
+	inline bool fgemm_igemm52 (const Givaro::Modular<int64_t>& F,
+				   const FFLAS_TRANSPOSE ta,
+				   const FFLAS_TRANSPOSE tb,
+				   const size_t m, const size_t n,const size_t k,
+				   const int64_t alpha,
+				   const int64_t * A, const size_t lda,
+				   const int64_t * B, const size_t ldb,
+				   const int64_t beta,
+				   int64_t * C, const size_t ldc)
+	{
+		const uint64_t p = (uint64_t) F.characteristic();
+		if (p >= details::igemm52_maxmod) return false;
+		igemm_ (FflasRowMajor, ta, tb, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, (int64_t)p);
+		return true;
+	}
+
+	inline bool fgemm_igemm52 (const Givaro::ModularBalanced<int64_t>& F,
+				   const FFLAS_TRANSPOSE ta,
+				   const FFLAS_TRANSPOSE tb,
+				   const size_t m, const size_t n,const size_t k,
+				   const int64_t alpha,
+				   const int64_t * A, const size_t lda,
+				   const int64_t * B, const size_t ldb,
+				   const int64_t beta,
+				   int64_t * C, const size_t ldc)
+	{
+		const uint64_t p = (uint64_t) F.characteristic();
+		if (p >= details::igemm52_maxmod) return false;
+		igemm_ (FflasRowMajor, ta, tb, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, (int64_t)p);
+		// back to the balanced representatives
+		freduce (F, m, n, C, ldc);
+		return true;
+	}
+#endif
+
+	/*! whether fgemm_igemm52 should replace the delayed products over
+	 * \p F with at most \p kmax terms before a reduction: always when
+	 * nothing can be delayed, otherwise only with the vpmadd52 kernel, as
+	 * its scalar emulation is slower than the vectorised int64_t igemm.
+	 */
+	template<class Field>
+	inline bool use_igemm52 (const Field& F, const size_t k, const size_t kmax)
+	{
+		if (!has_igemm52 (F)) return false;
+#ifdef __FFLASFFPACK_HAVE_IGEMM52
+		return !kmax || (kmax < k && details::igemm52_vectorised);
+#else
+		return false;
+#endif
+	}
+
+} // Protected
+} // FFLAS
+
 namespace FFLAS {
 
 	// F is a field supporting delayed reductions
@@ -102,6 +192,23 @@ namespace FFLAS {
 			kmax = H.MaxDelayedDim (betadf);
 		}
 		
+		// Rather than k/kmax blocks over int64_t and their reductions, or
+		// the unvectorised DefaultTag product, one pass of the 52 bits
+		// kernel, which takes inputs in (-p,p)
+		if (Protected::use_igemm52 (F, k, kmax)){
+			if (H.Amin < H.FieldMin || H.Amax>H.FieldMax){
+				H.initA();
+				freduce_constoverride (F, (ta==FflasNoTrans)?m:k, (ta==FflasNoTrans)?k:m, A, lda);
+			}
+			if (H.Bmin < H.FieldMin || H.Bmax>H.FieldMax){
+				H.initB();
+				freduce_constoverride (F, (tb==FflasNoTrans)?k:n, (tb==FflasNoTrans)?n:k, B, ldb);
+			}
+			Protected::fgemm_igemm52 (F, ta, tb, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+			H.initOut();
+			return;
+		}
+
 		if (!kmax){
 			MMHelper<Field, MMHelperAlgo::Classic, ModeCategories::DefaultTag> HG(H);
 			H.initOut();
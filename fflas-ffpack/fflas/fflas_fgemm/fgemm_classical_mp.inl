@@ -53,15 +53,42 @@ namespace FFLAS {
 		Givaro::Integer normA,normB;
 		int recLevel;
 		ParSeqTrait parseq;
-		MMHelper() : normA(0), normB(0), recLevel(-1) {}
+		MMWorkspace * workspace; // unused: multiprecision temporaries are never taken from a workspace
+		MMHelper() : normA(0), normB(0), recLevel(-1), workspace(nullptr) {}
 		template <class F2, class A2, class M2, class PS2>
 		MMHelper(MMHelper<F2, A2, M2, PS2> H2) : 
-				normA(H2.normA), normB(H2.normB), recLevel(H2.recLevel), parseq(H2.parseq) {}
-		MMHelper(Givaro::Integer Amax, Givaro::Integer Bmax) : normA(Amax), normB(Bmax), recLevel(-1) {}
+				normA(H2.normA), normB(H2.normB), recLevel(H2.recLevel), parseq(H2.parseq), workspace(nullptr) {}
+		MMHelper(Givaro::Integer Amax, Givaro::Integer Bmax) : normA(Amax), normB(Bmax), recLevel(-1), workspace(nullptr) {}
 		MMHelper(const Field& F, size_t m, size_t n, size_t k, ParSeqTrait PS=ParSeqTrait())
-				: recLevel(-1), parseq(PS)
+				: recLevel(-1), parseq(PS), workspace(nullptr)
+			{F.characteristic(normA);F.characteristic(normB);}
+		MMHelper(const Field& F, int wino, ParSeqTrait PS=ParSeqTrait()) : recLevel(wino), parseq(PS), workspace(nullptr)
+			{F.characteristic(normA);F.characteristic(normB);}
+		void setNorm(Givaro::Integer p){normA=normB=p;}
+	};
+	/*! Helper of the output sensitive fgemm over Z: the norms only bound the
+	 * number of primes, the product stops as soon as its reconstruction is
+	 * stable. \c nbprimes and \c maxprimes report, after each product, the
+	 * number of primes used and the size of the worst case basis.
+	 */
+	template<typename Field,
+			 typename ParSeqTrait>
+	struct MMHelper<Field, MMHelperAlgo::EarlyTerm,ModeCategories::ConvertTo<ElementCategories::RNSElementTag>, ParSeqTrait> {
+		Givaro::Integer normA,normB;
+		int recLevel;
+		ParSeqTrait parseq;
+		MMWorkspace * workspace; // unused: multiprecision temporaries are never taken from a workspace
+		size_t nbprimes, maxprimes;
+		MMHelper() : normA(0), normB(0), recLevel(-1), workspace(nullptr), nbprimes(0), maxprimes(0) {}
+		template <class F2, class A2, class M2, class PS2>
+		MMHelper(MMHelper<F2, A2, M2, PS2> H2) :
+				normA(H2.normA), normB(H2.normB), recLevel(H2.recLevel), parseq(H2.parseq), workspace(nullptr), nbprimes(0), maxprimes(0) {}
+		MMHelper(Givaro::Integer Amax, Givaro::Integer Bmax) : normA(Amax), normB(Bmax), recLevel(-1), workspace(nullptr), nbprimes(0), maxprimes(0) {}
+		MMHelper(const Field& F, size_t m, size_t n, size_t k, ParSeqTrait PS=ParSeqTrait())
+				: recLevel(-1), parseq(PS), workspace(nullptr), nbprimes(0), maxprimes(0)
 			{F.characteristic(normA);F.characteristic(normB);}
-		MMHelper(const Field& F, int wino, ParSeqTrait PS=ParSeqTrait()) : recLevel(wino), parseq(PS)
+		MMHelper(const Field& F, int wino, ParSeqTrait PS=ParSeqTrait())
+				: recLevel(wino), parseq(PS), workspace(nullptr), nbprimes(0), maxprimes(0)
 			{F.characteristic(normA);F.characteristic(normB);}
 		void setNorm(Givaro::Integer p){normA=normB=p;}
 	};
@@ -282,9 +309,9 @@ namespace FFLAS {
 		chrono.start();
 #endif
 
-			// convert the input matrices to RNS representation
-		finit_rns(Zrns,Arowd,Acold,(logA/16)+((logA%16)?1:0),A,lda,Ap);
-		finit_rns(Zrns,Browd,Bcold,(logB/16)+((logB%16)?1:0),B,ldb,Bp);
+			// convert the input matrices to RNS representation (in parallel if ParSeq is)
+		finit_rns(Zrns,Arowd,Acold,(logA/16)+((logA%16)?1:0),A,lda,Ap,H.parseq);
+		finit_rns(Zrns,Browd,Bcold,(logB/16)+((logB%16)?1:0),B,ldb,Bp,H.parseq);
 
 #ifdef PROFILE_FGEMM_MP
 		chrono.stop();
@@ -312,7 +339,7 @@ namespace FFLAS {
 
 		
 			// convert the RNS output to integer representation (C=beta.C+ RNS^(-1)(Cp) )
-		fconvert_rns(Zrns,m,n,beta,C,ldc,Cp);
+		fconvert_rns(Zrns,m,n,beta,C,ldc,Cp,H.parseq);
 
 		FFLAS::fflas_delete(Ap);
 		FFLAS::fflas_delete(Bp);
@@ -361,6 +388,148 @@ namespace FFLAS {
 		MMHelper<Givaro::ZRing<Givaro::Integer>, MMHelperAlgo::Classic, ModeCategories::ConvertTo<ElementCategories::RNSElementTag>, ParSeq> H2(F, H.recLevel,H.parseq);
 		return fgemm(F,ta,tb,m,n,k,alpha,A,lda,B,ldb,beta,C,ldc,H2);
 
+	}
+
+		/************************************************
+		 *** OUTPUT SENSITIVE MULTIPRECISION FGEMM OVER Z ***
+		 ************************************************/
+
+	/* The residues of A and B are computed once, on the worst case basis of
+	 * the classic product; the products modulo its primes are then computed
+	 * by batches, each batch being as large as all the previous ones, and
+	 * lifted onto the current reconstruction X modulo M by a Garner step
+	 * X <- X + M ((Y - X) M^{-1} mod Mb), Y being the reconstruction of the
+	 * batch modulo Mb. Once a batch leaves X unchanged, X is checked by
+	 * freivalds modulo the next unused prime of the basis, and the product
+	 * goes on if the check fails. When the basis is exhausted X is exact by
+	 * the bound on the norms.
+	 */
+	template<class ParSeq>
+	inline Givaro::Integer*
+	fgemm (const Givaro::ZRing<Givaro::Integer>& F,
+	       const FFLAS_TRANSPOSE ta,
+	       const FFLAS_TRANSPOSE tb,
+	       const size_t m, const size_t n,const size_t k,
+	       const Givaro::Integer alpha,
+	       const Givaro::Integer* A, const size_t lda,
+	       const Givaro::Integer* B, const size_t ldb,
+	       Givaro::Integer beta,
+	       Givaro::Integer* C, const size_t ldc,
+	       MMHelper<Givaro::ZRing<Givaro::Integer>, MMHelperAlgo::EarlyTerm, ModeCategories::ConvertTo<ElementCategories::RNSElementTag>, ParSeq >  & H)
+	{
+		H.nbprimes = H.maxprimes = 0;
+		if (alpha == 0 || k == 0){
+			fscalin(F,m,n,beta,C,ldc);
+			return C;
+		}
+
+			// same basis as the classic product
+		size_t _k=k,lk=0;
+		while ( _k ) {_k>>=1; ++lk;}
+		size_t prime_bitsize= (53-lk)>>1;
+
+		size_t logA,logB;
+		if (H.normA==0)
+			H.normA = InfNorm ((ta==FflasNoTrans)?m:k,(ta==FflasNoTrans)?k:m,A,lda);
+		logA = H.normA.bitsize();
+		if (H.normB==0)
+			H.normB = InfNorm ((tb==FflasNoTrans)?k:n,(tb==FflasNoTrans)?n:k,B,ldb);
+		logB = H.normB.bitsize();
+		Givaro::Integer mC = 2*uint64_t(k)*H.normA*H.normB*abs(alpha);
+
+		FFPACK::rns_double RNS(mC, prime_bitsize);
+		typedef FFPACK::RNSInteger<FFPACK::rns_double> RnsDomain;
+		RnsDomain Zrns(RNS);
+		const size_t s = RNS._size;
+		H.maxprimes = s;
+
+		size_t Acold,Arowd,Bcold,Browd;
+		if (ta == FFLAS::FflasNoTrans){Arowd=m; Acold = k; }
+		else { Arowd=k; Acold = m;}
+		if (tb == FFLAS::FflasNoTrans){Browd=k; Bcold = n; }
+		else { Browd=n; Bcold = k;}
+
+		typename RnsDomain::Element_ptr Ap,Bp,Cp;
+		Ap = FFLAS::fflas_new(Zrns,Arowd,Acold);
+		Bp = FFLAS::fflas_new(Zrns,Browd,Bcold);
+		Cp = FFLAS::fflas_new(Zrns,m,n);
+		finit_rns(Zrns,Arowd,Acold,(logA/16)+((logA%16)?1:0),A,lda,Ap,H.parseq);
+		finit_rns(Zrns,Browd,Bcold,(logB/16)+((logB%16)?1:0),B,ldb,Bp,H.parseq);
+
+		Givaro::Integer* X = FFLAS::fflas_new(F,m,n);
+		Givaro::Integer* Y = FFLAS::fflas_new(F,m,n);
+		Givaro::Integer M(1);
+		size_t t = 0;
+		bool done = false;
+		while (!done){
+			const size_t t2 = std::min(s, t + std::max(t, size_t(1)));
+
+				// the primes [t,t2) of the basis, seen as an RNS domain on the
+				// corresponding rows of the residues
+			std::vector<double> batch(RNS._basis.begin()+t, RNS._basis.begin()+t2);
+			FFPACK::rns_double RNSb(batch);
+			RnsDomain Zb(RNSb);
+			typename RnsDomain::ConstElement_ptr Ab(Ap._ptr+t*Ap._stride,Ap._stride), Bb(Bp._ptr+t*Bp._stride,Bp._stride);
+			typename RnsDomain::Element_ptr Cb(Cp._ptr+t*Cp._stride,Cp._stride);
+			typename RnsDomain::Element alphab, betab;
+			Zb.init(alphab, alpha);
+			Zb.init(betab, F.zero);
+			MMHelper<RnsDomain, MMHelperAlgo::Classic, ModeCategories::DefaultTag, ParSeq> H2(Zb,H.recLevel,H.parseq);
+			fgemm(Zb,ta,tb,m,n,k,alphab,Ab,Acold,Bb,Bcold,betab,Cb,n,H2);
+			fconvert_rns(Zb,m,n,F.zero,(t?Y:X),n,Cb,H.parseq);
+
+			bool stable = false;
+			if (t){
+					// Garner step, X being kept in symmetric representation modulo M Mb
+				const Givaro::Integer& Mb = RNSb._M;
+				Givaro::Modular<Givaro::Integer> Fb(Mb);
+				Givaro::Integer Minv, d, MM(M*Mb);
+				Givaro::Integer hMb((Mb-1)>>1), hMM((MM-1)>>1);
+				Fb.init(Minv, M);
+				Fb.invin(Minv);
+				stable = true;
+				for (size_t i=0; i<m*n; ++i){
+					Fb.init(d, Y[i]-X[i]);
+					if (Fb.isZero(d)) continue;
+					stable = false;
+					Fb.mulin(d, Minv);
+					if (d > hMb) d -= Mb;
+					X[i] += M*d;
+					if (X[i] > hMM) X[i] -= MM;
+					else if (X[i] < -hMM) X[i] += MM;
+				}
+				M = MM;
+			}
+			else
+				M = RNSb._M;
+			t = t2;
+
+			if (t == s)
+				done = true;
+			else if (stable){
+					// probabilistic certificate: alpha op(A) op(B) = X modulo basis[t]
+				const typename FFPACK::rns_double::ModField& Fp = RNS._field_rns[t];
+				double* Xp = FFLAS::fflas_new<double>(m*n);
+				for (size_t i=0; i<m*n; ++i)
+					Fp.init(Xp[i], X[i] % RNS._basis[t]);
+				double alphap;
+				Fp.init(alphap, alpha % RNS._basis[t]);
+				done = freivalds(Fp,ta,tb,m,n,k,alphap,Ap._ptr+t*Ap._stride,Acold,Bp._ptr+t*Bp._stride,Bcold,Xp,n);
+				FFLAS::fflas_delete(Xp);
+			}
+		}
+		H.nbprimes = t;
+
+			// C <- beta C + X
+		fscalin(F,m,n,beta,C,ldc);
+		faddin(F,m,n,X,n,C,ldc);
+
+		FFLAS::fflas_delete(Ap);
+		FFLAS::fflas_delete(Bp);
+		FFLAS::fflas_delete(Cp);
+		FFLAS::fflas_delete(X);
+		FFLAS::fflas_delete(Y);
+		return C;
 	}
 		/************************************
 		 *** MULTIPRECISION FGEMM OVER Fp ***
@@ -0,0 +1,332 @@
+/* -*- mode: C++; tab-width: 8; indent-tabs-mode: t; c-basic-offset: 8 -*- */
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/*
+ * Copyright (C) 2016 the FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ *.
+ */
+
+/** @file fflas_fgemm/fgemm_packed.inl
+ * @brief Packed classical matrix multiplication over a word size prime field.
+ *
+ * BLIS-like schedule: \f$A\f$ and \f$B\f$ are packed in \c mc x \c kc and
+ * \c kc x \c nc panels, a \c _mr x \c _nr register tile of \f$C\f$ is
+ * accumulated by the micro-kernel and reduced modulo \f$p\f$ (and scaled by
+ * \f$\alpha\f$ on the last panel) before being written back, so that no
+ * separate freduce pass over \f$C\f$ is needed.  \c kc never exceeds the
+ * number of products that can be accumulated without overflowing the
+ * mantissa.
+ * Selected with <code>MMHelper<Field, MMHelperAlgo::Packed></code>.
+ */
+
+#ifndef __FFLASFFPACK_fflas_fflas_fgemm_packed_INL
+#define __FFLASFFPACK_fflas_fflas_fgemm_packed_INL
+
+#include "fflas-ffpack/utils/fflas_memory.h"
+
+namespace FFLAS { namespace Protected { namespace packed {
+
+	//! register tile of the micro-kernel
+	template<class Element>
+	struct TileTraits {
+#ifdef __FFLASFFPACK_USE_SIMD
+		typedef Simd<Element> simd;
+		static const size_t vect_size = simd::vect_size;
+#else
+		static const size_t vect_size = 1;
+#endif
+		static const size_t mr = 4;
+		static const size_t nr = (vect_size > 1) ? 2*vect_size : 4;
+	};
+
+	/** \internal
+	 * Cache blocking, as in FFLAS::details::BlockingFactor:
+	 * a \c kc x (mr+nr) pair of slivers fits in L1, an \c mc x \c kc panel of
+	 * \f$A\f$ in L2 and a \c kc x \c nc panel of \f$B\f$ in the last level cache.
+	 * On input \p kc is the largest depth allowed by the bounds.
+	 */
+	template<class Element>
+	inline void BlockingFactor (size_t& mc, size_t& nc, size_t& kc)
+	{
+		typedef TileTraits<Element> TT;
+		static int l1 = -1, l2 = -1, l3 = -1;
+		if (l1 < 0) {
+			queryCacheSizes(l1,l2,l3);
+			if (l1 <= 0) l1 = 32*1024;
+			if (l2 <= 0) l2 = 256*1024;
+			l3 = std::max(l2,l3);
+		}
+		size_t k1 = (size_t)l1 / (2*(TT::mr+TT::nr)*sizeof(Element));
+		kc = std::max(std::min(kc, k1), (size_t)1);
+		size_t m1 = (size_t)l2 / (2*kc*sizeof(Element));
+		m1 = std::max(m1 - m1 % TT::mr, TT::mr);
+		mc = std::min(mc, m1);
+		size_t n1 = (size_t)l3 / (2*kc*sizeof(Element));
+		n1 = std::max(n1 - n1 % TT::nr, TT::nr);
+		nc = std::min(nc, n1);
+	}
+
+	//! packs op(A)[i0..i0+mc[ x [l0..l0+kc[ in slivers of \c mr rows, padded with zeros
+	template<class Element, size_t MR>
+	inline void pack_A (Element* Ap, const Element* A, const size_t lda, const FFLAS_TRANSPOSE ta,
+			    const size_t mc, const size_t kc)
+	{
+		for (size_t i = 0; i < mc; i += MR) {
+			const size_t mr = std::min(MR, mc-i);
+			for (size_t l = 0; l < kc; ++l) {
+				size_t r = 0;
+				if (ta == FflasNoTrans)
+					for (; r < mr; ++r) *Ap++ = A[(i+r)*lda+l];
+				else
+					for (; r < mr; ++r) *Ap++ = A[l*lda+i+r];
+				for (; r < MR; ++r) *Ap++ = 0;
+			}
+		}
+	}
+
+	//! packs op(B)[l0..l0+kc[ x [j0..j0+nc[ in slivers of \c nr columns, padded with zeros
+	template<class Element, size_t NR>
+	inline void pack_B (Element* Bp, const Element* B, const size_t ldb, const FFLAS_TRANSPOSE tb,
+			    const size_t kc, const size_t nc)
+	{
+		for (size_t j = 0; j < nc; j += NR) {
+			const size_t nr = std::min(NR, nc-j);
+			for (size_t l = 0; l < kc; ++l) {
+				size_t c = 0;
+				if (tb == FflasNoTrans)
+					for (; c < nr; ++c) *Bp++ = B[l*ldb+j+c];
+				else
+					for (; c < nr; ++c) *Bp++ = B[(j+c)*ldb+l];
+				for (; c < NR; ++c) *Bp++ = 0;
+			}
+		}
+	}
+
+	/** \internal
+	 * Micro-kernel: \f$C \gets (C_0 + A_p B_p) \bmod p\f$ on a full \c mr x \c nr
+	 * tile, where \f$C_0 = \beta' C\f$ if \p scaleC and \f$C\f$ otherwise.
+	 * On the last panel the reduced tile is multiplied by \p alpha and reduced again.
+	 */
+#ifdef __FFLASFFPACK_USE_SIMD
+	template<class Field>
+	inline void kernel (const Field& F, const size_t kc,
+			    const typename Field::Element* Ap, const typename Field::Element* Bp,
+			    typename Field::Element* C, const size_t ldc,
+			    const bool scaleC, const typename Field::Element betap,
+			    const bool scaleOut, const typename Field::Element alpha,
+			    vectorised::HelperModSimd<Field, typename TileTraits<typename Field::Element>::simd> & H)
+	{
+		typedef TileTraits<typename Field::Element> TT;
+		typedef typename TT::simd simd;
+		typedef typename simd::vect_t vect_t;
+		const size_t vs = TT::vect_size;
+
+		vect_t C0,C1,C2,C3,C4,C5,C6,C7;
+		if (scaleC) {
+			if (F.isZero(betap)) {
+				C0 = C1 = C2 = C3 = C4 = C5 = C6 = C7 = simd::zero();
+			} else {
+				vect_t b = simd::set1(betap);
+				C0 = simd::mul(b, simd::loadu(C));         C1 = simd::mul(b, simd::loadu(C+vs));
+				C2 = simd::mul(b, simd::loadu(C+ldc));     C3 = simd::mul(b, simd::loadu(C+ldc+vs));
+				C4 = simd::mul(b, simd::loadu(C+2*ldc));   C5 = simd::mul(b, simd::loadu(C+2*ldc+vs));
+				C6 = simd::mul(b, simd::loadu(C+3*ldc));   C7 = simd::mul(b, simd::loadu(C+3*ldc+vs));
+			}
+		} else {
+			C0 = simd::loadu(C);         C1 = simd::loadu(C+vs);
+			C2 = simd::loadu(C+ldc);     C3 = simd::loadu(C+ldc+vs);
+			C4 = simd::loadu(C+2*ldc);   C5 = simd::loadu(C+2*ldc+vs);
+			C6 = simd::loadu(C+3*ldc);   C7 = simd::loadu(C+3*ldc+vs);
+		}
+
+		for (size_t l = 0; l < kc; ++l, Ap += TT::mr, Bp += TT::nr) {
+			vect_t B0 = simd::load(Bp), B1 = simd::load(Bp+vs), A0;
+			A0 = simd::set1(Ap[0]); C0 = simd::fmadd(C0,A0,B0); C1 = simd::fmadd(C1,A0,B1);
+			A0 = simd::set1(Ap[1]); C2 = simd::fmadd(C2,A0,B0); C3 = simd::fmadd(C3,A0,B1);
+			A0 = simd::set1(Ap[2]); C4 = simd::fmadd(C4,A0,B0); C5 = simd::fmadd(C5,A0,B1);
+			A0 = simd::set1(Ap[3]); C6 = simd::fmadd(C6,A0,B0); C7 = simd::fmadd(C7,A0,B1);
+		}
+
+#define __FFLAS_PACKED_WRITEBACK(V,OFF)					\
+		vectorised::VEC_MOD<Field,simd,0>(V,H);			\
+		if (scaleOut) {						\
+			V = simd::mul(V, simd::set1(alpha));		\
+			vectorised::VEC_MOD<Field,simd,0>(V,H);		\
+		}							\
+		simd::storeu(C+(OFF), V);
+
+		__FFLAS_PACKED_WRITEBACK(C0,0)       __FFLAS_PACKED_WRITEBACK(C1,vs)
+		__FFLAS_PACKED_WRITEBACK(C2,ldc)     __FFLAS_PACKED_WRITEBACK(C3,ldc+vs)
+		__FFLAS_PACKED_WRITEBACK(C4,2*ldc)   __FFLAS_PACKED_WRITEBACK(C5,2*ldc+vs)
+		__FFLAS_PACKED_WRITEBACK(C6,3*ldc)   __FFLAS_PACKED_WRITEBACK(C7,3*ldc+vs)
+#undef __FFLAS_PACKED_WRITEBACK
+	}
+#else
+	template<class Field, class Helper>
+	inline void kernel (const Field& F, const size_t kc,
+			    const typename Field::Element* Ap, const typename Field::Element* Bp,
+			    typename Field::Element* C, const size_t ldc,
+			    const bool scaleC, const typename Field::Element betap,
+			    const bool scaleOut, const typename Field::Element alpha,
+			    Helper &)
+	{
+		typedef TileTraits<typename Field::Element> TT;
+		typename Field::Element T[TT::mr][TT::nr];
+		for (size_t r = 0; r < TT::mr; ++r)
+			for (size_t c = 0; c < TT::nr; ++c)
+				T[r][c] = scaleC ? betap*C[r*ldc+c] : C[r*ldc+c];
+		for (size_t l = 0; l < kc; ++l, Ap += TT::mr, Bp += TT::nr)
+			for (size_t r = 0; r < TT::mr; ++r)
+				for (size_t c = 0; c < TT::nr; ++c)
+					T[r][c] += Ap[r]*Bp[c];
+		for (size_t r = 0; r < TT::mr; ++r)
+			for (size_t c = 0; c < TT::nr; ++c) {
+				F.reduce(T[r][c]);
+				if (scaleOut) F.mulin(T[r][c], alpha);
+				C[r*ldc+c] = T[r][c];
+			}
+	}
+#endif
+
+	/** \internal
+	 * Block-panel product on packed operands, \p C is \c mc x \c nc.
+	 * Edge tiles go through a local \c mr x \c nr buffer.
+	 */
+	template<class Field, class Helper>
+	inline void gebp (const Field& F, const size_t mc, const size_t nc, const size_t kc,
+			  const typename Field::Element* Ap, const typename Field::Element* Bp,
+			  typename Field::Element* C, const size_t ldc,
+			  const bool scaleC, const typename Field::Element betap,
+			  const bool scaleOut, const typename Field::Element alpha,
+			  Helper & H)
+	{
+		typedef typename Field::Element Element;
+		typedef TileTraits<Element> TT;
+		Element W[TT::mr*TT::nr];
+		for (size_t j = 0; j < nc; j += TT::nr) {
+			const size_t nr = std::min(TT::nr, nc-j);
+			const Element* Bj = Bp + j*kc;
+			for (size_t i = 0; i < mc; i += TT::mr) {
+				const size_t mr = std::min(TT::mr, mc-i);
+				const Element* Ai = Ap + i*kc;
+				Element* Cij = C + i*ldc + j;
+				if (mr == TT::mr && nr == TT::nr)
+					kernel(F, kc, Ai, Bj, Cij, ldc, scaleC, betap, scaleOut, alpha, H);
+				else {
+					for (size_t r = 0; r < TT::mr; ++r)
+						for (size_t c = 0; c < TT::nr; ++c)
+							W[r*TT::nr+c] = (r < mr && c < nr) ? Cij[r*ldc+c] : F.zero;
+					kernel(F, kc, Ai, Bj, W, TT::nr, scaleC, betap, scaleOut, alpha, H);
+					for (size_t r = 0; r < mr; ++r)
+						for (size_t c = 0; c < nr; ++c)
+							Cij[r*ldc+c] = W[r*TT::nr+c];
+				}
+			}
+		}
+	}
+
+} // packed
+} // Protected
+} // FFLAS
+
+namespace FFLAS {
+
+	/** Packed classical product over a prime field with floating point elements.
+	 * \f$C \gets \alpha \mathrm{op}(A) \mathrm{op}(B) + \beta C\f$, inputs are reduced.
+	 * Falls back to the default schedule when \f$p\f$ is too large for any
+	 * useful delayed accumulation.
+	 */
+	template<class Field>
+	inline typename std::enable_if<std::is_floating_point<typename Field::Element>::value, typename Field::Element_ptr>::type
+	fgemm (const Field& F,
+	       const FFLAS_TRANSPOSE ta,
+	       const FFLAS_TRANSPOSE tb,
+	       const size_t m, const size_t n, const size_t k,
+	       const typename Field::Element alpha,
+	       typename Field::ConstElement_ptr A, const size_t lda,
+	       typename Field::ConstElement_ptr B, const size_t ldb,
+	       const typename Field::Element beta,
+	       typename Field::Element_ptr C, const size_t ldc,
+	       MMHelper<Field, MMHelperAlgo::Packed, ModeCategories::DelayedTag, ParSeqHelper::Sequential> & H)
+	{
+		typedef typename Field::Element Element;
+		typedef Protected::packed::TileTraits<Element> TT;
+
+		if (!m || !n) {return C;}
+
+		if (!k || F.isZero (alpha)){
+			fscalin(F, m, n, beta, C, ldc);
+			return C;
+		}
+
+		// C_0 = beta/alpha C counts as one more product in the accumulation
+		typedef typename MMHelper<Field, MMHelperAlgo::Packed, ModeCategories::DelayedTag>::DFElt DFElt;
+		DFElt absmax = std::max(static_cast<const DFElt&>(-H.FieldMin), H.FieldMax);
+		size_t kmax = H.MaxDelayedDim(absmax);
+		if (kmax < 2*TT::mr) {
+			MMHelper<Field, MMHelperAlgo::Winograd, ModeCategories::DelayedTag> HW(F, m, k, n, ParSeqHelper::Sequential());
+			fgemm (F, ta, tb, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, HW);
+			H.initOut();
+			return C;
+		}
+
+		Element betap;
+		F.init(betap);
+		F.div (betap, beta, alpha);
+		const bool scaleOut = !F.isOne(alpha);
+
+		size_t mc = m, nc = n, kc = std::min(k, kmax);
+		Protected::packed::BlockingFactor<Element>(mc, nc, kc);
+
+		Element* Ap = fflas_new<Element>((mc+TT::mr)*kc, Alignment::CACHE_LINE);
+		Element* Bp = fflas_new<Element>((nc+TT::nr)*kc, Alignment::CACHE_LINE);
+#ifdef __FFLASFFPACK_USE_SIMD
+		vectorised::HelperModSimd<Field, typename TT::simd> HM(F);
+#else
+		vectorised::HelperMod<Field> HM(F);
+#endif
+
+		for (size_t j0 = 0; j0 < n; j0 += nc) {
+			const size_t ncur = std::min(nc, n-j0);
+			for (size_t l0 = 0; l0 < k; l0 += kc) {
+				const size_t kcur = std::min(kc, k-l0);
+				const bool first = (l0 == 0);
+				const bool last = (l0+kcur == k);
+				const Element* Bl = (tb == FflasNoTrans) ? B+l0*ldb+j0 : B+j0*ldb+l0;
+				Protected::packed::pack_B<Element,TT::nr>(Bp, Bl, ldb, tb, kcur, ncur);
+				for (size_t i0 = 0; i0 < m; i0 += mc) {
+					const size_t mcur = std::min(mc, m-i0);
+					const Element* Ai = (ta == FflasNoTrans) ? A+i0*lda+l0 : A+l0*lda+i0;
+					Protected::packed::pack_A<Element,TT::mr>(Ap, Ai, lda, ta, mcur, kcur);
+					Protected::packed::gebp(F, mcur, ncur, kcur, Ap, Bp, C+i0*ldc+j0, ldc,
+								first, betap, last && scaleOut, alpha, HM);
+				}
+			}
+		}
+
+		fflas_delete(Ap);
+		fflas_delete(Bp);
+		H.initOut();
+		return C;
+	}
+
+} // FFLAS
+
+#endif // __FFLASFFPACK_fflas_fflas_fgemm_packed_INL
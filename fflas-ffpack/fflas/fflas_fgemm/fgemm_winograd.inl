@@ -44,7 +44,6 @@
 #include "schedule_winograd_acc.inl"
 #include "schedule_winograd_acc_ip.inl"
 #include "schedule_winograd_ip.inl"
-// #include "fflas_fgemm/bini.inl"
 
 
 #ifndef NEWWINO
@@ -54,6 +53,7 @@
 //#define OLDWINO
 
 #include "fflas-ffpack/fflas-ffpack-config.h"
+#include "fflas-ffpack/utils/fflas_tuning.h"
 
 
 // DynamicPeeling, WinogradCalc
@@ -64,13 +64,17 @@ namespace FFLAS { namespace Protected {
 	 * \param m the common dimension in the product AxB
 	 */
 	template<class Field>
-	inline int WinogradThreshold(const Field& F) {return __FFLASFFPACK_WINOTHRESHOLD;}
+	inline int WinogradThreshold(const Field& F) {return (int)tuning().winothreshold;}
 	template<>
-	inline int WinogradThreshold (const Givaro::Modular<float>& F) {return __FFLASFFPACK_WINOTHRESHOLD_FLT;}
+	inline int WinogradThreshold (const Givaro::Modular<float>& F) {return (int)tuning().winothreshold_flt;}
 	template<>
-	inline int WinogradThreshold (const Givaro::ModularBalanced<double> & F) {return __FFLASFFPACK_WINOTHRESHOLD_BAL;}
+	inline int WinogradThreshold (const Givaro::ModularBalanced<double> & F) {return (int)tuning().winothreshold_bal;}
 	template<>
-	inline int WinogradThreshold (const Givaro::ModularBalanced<float> & F) {return __FFLASFFPACK_WINOTHRESHOLD_BAL_FLT;}
+	inline int WinogradThreshold (const Givaro::ModularBalanced<float> & F) {return (int)tuning().winothreshold_bal_flt;}
+	template<>
+	inline int WinogradThreshold (const Givaro::Modular<int64_t> & F) {return (int)tuning().winothreshold_int64;}
+	template<>
+	inline int WinogradThreshold (const Givaro::ModularBalanced<int64_t> & F) {return (int)tuning().winothreshold_int64;}
 		
 	template<class Field>
 	inline int WinogradSteps (const Field & F, const size_t & m)
@@ -85,6 +89,33 @@ namespace FFLAS { namespace Protected {
 		return w;
 	}
 
+	//! number of elements of \p F taken in a MMWorkspace by a m x n temporary
+	template<class Field>
+	inline size_t WorkspaceFootprint (const Field & F, const size_t m, const size_t n)
+	{
+		typedef typename Field::Element Element;
+		return (MMWorkspace::footprint<Element>(m*n) + sizeof(Element) - 1) / sizeof(Element);
+	}
+
+	/** \brief Workspace used by the Winograd schedules below WinogradCalc.
+	 *
+	 * Temporaries of one level are live while the level recurses, so that
+	 * the levels add up. The accumulating schedules take at most 3 temporaries
+	 * (X3, X2, X1 in WinogradAcc_3_21 and WinogradAcc_3_23), the others 2.
+	 * \param mr, nr, kr dimensions of the quarter products
+	 * \param w number of recursive levels left, including this one
+	 */
+	template<class Field>
+	inline size_t WinogradCalcWorkspace (const Field & F, const size_t mr, const size_t nr, const size_t kr, const int w)
+	{
+		if (w <= 0 || !mr || !nr || !kr)
+			return 0;
+		size_t wzero = WorkspaceFootprint(F, kr, nr) + WorkspaceFootprint(F, mr, std::max(nr,kr));
+		size_t wacc = WorkspaceFootprint(F, std::max(mr,kr), nr) + WorkspaceFootprint(F, mr, kr)
+			+ WorkspaceFootprint(F, mr, nr);
+		return std::max(wzero, wacc) + WinogradCalcWorkspace(F, mr/2, nr/2, kr/2, w-1);
+	}
+
 	template  < class Field, class FieldMode >
 	inline void
 	DynamicPeeling (const Field& F,
@@ -533,6 +564,150 @@ namespace FFLAS{
 		return C;
 	} // fgemm
 
+	namespace Protected {
+		// defined in fgemm_bini.inl
+		template<class Field>
+		inline int BiniAutoSteps (const Field& F, const size_t m, const size_t n, const size_t k);
+		template<class Field>
+		inline size_t BiniWorkspaceSize (const Field& F, const size_t m, const size_t n, const size_t k, const int w);
+	}
+
+	/** \brief Size of a MMWorkspace for one sequential Winograd fgemm.
+	 *
+	 * Returns the number of elements of \p F such that
+	 * \code
+	 * MMWorkspace W (F, fgemm_workspace_size (F, m, n, k, w));
+	 * MMHelper<Field, MMHelperAlgo::Winograd> H (F, w);
+	 * H.workspace = &W;
+	 * \endcode
+	 * lets any \p m x \p n x \p k fgemm with \p H take all the temporaries
+	 * of its recursion from \p W, whatever alpha, beta and the transpositions.
+	 * The workspace can be reused by subsequent calls of the same or smaller
+	 * dimensions. When fgemm computes over a floating point field
+	 * (fgemm_convert), the size covers the temporaries taken over that field.
+	 * \param w number of recursive levels, -1 for the default choice of fgemm
+	 */
+	template<class Field>
+	inline size_t fgemm_workspace_size (const Field& F,
+					    const size_t m, const size_t n, const size_t k,
+					    const int w = -1);
+
+	namespace Protected {
+
+		//! workspace of the recursion of fgemm over \p F itself
+		template<class Field>
+		inline size_t WinogradWorkspaceSize (const Field& F,
+						     const size_t m, const size_t n, const size_t k,
+						     const int w)
+		{
+			if (!m || !n || !k)
+				return 0;
+			if (w < 0) {
+				// the default fgemm may use Bini's scheme for its top level
+				const int wb = Protected::BiniAutoSteps (F, m, n, k);
+				if (wb >= 0)
+					return Protected::BiniWorkspaceSize (F, m, n, k, wb);
+			}
+			int ww = (w < 0) ? Protected::WinogradSteps (F, min3(m,k,n)) : w;
+			if (ww == 0)
+				return 0;
+			size_t m2 = (m >> ww) << (ww-1) ;
+			size_t n2 = (n >> ww) << (ww-1) ;
+			size_t k2 = (k >> ww) << (ww-1) ;
+			size_t mr = m -2*m2;
+			size_t nr = n -2*n2;
+			size_t kr = k -2*k2;
+
+			size_t ws = Protected::WinogradCalcWorkspace (F, m2, n2, k2, ww);
+			// the peeled products of DynamicPeeling2 run after WinogradCalc, with the default recursion
+			if (nr) ws = std::max (ws, fgemm_workspace_size (F, m, nr, k));
+			if (kr) ws = std::max (ws, fgemm_workspace_size (F, m, n, kr));
+			if (mr) ws = std::max (ws, fgemm_workspace_size (F, mr, n, k));
+			return ws;
+		}
+
+		/* workspace of the same product over ModularBalanced<FloatElement>,
+		 * where fgemm_convert computes it, in elements of F
+		 */
+		template<class FloatElement, class Field>
+		inline size_t ConvertWorkspaceSize (const Field& F,
+						    const size_t m, const size_t n, const size_t k,
+						    const int w)
+		{
+			typedef typename Field::Element Element;
+			Givaro::ModularBalanced<FloatElement> G ((FloatElement) F.characteristic());
+			const size_t ws = fgemm_workspace_size (G, m, n, k, w);
+			return (ws * sizeof(FloatElement) + sizeof(Element) - 1) / sizeof(Element);
+		}
+
+		// the fields switching to another one follow the choices of fgemm
+		template<class Field, class Mode>
+		inline size_t WorkspaceSize (const Field& F, const size_t m, const size_t n, const size_t k,
+					     const int w, Mode)
+		{
+			return WinogradWorkspaceSize (F, m, n, k, w);
+		}
+
+		template<class Field>
+		inline size_t WorkspaceSize (const Field& F, const size_t m, const size_t n, const size_t k,
+					     const int w, ModeCategories::ConvertTo<ElementCategories::MachineFloatTag>)
+		{
+			if (F.cardinality() < DOUBLE_TO_FLOAT_CROSSOVER)
+				return ConvertWorkspaceSize<float> (F, m, n, k, w);
+			else if (16*F.cardinality() < Givaro::ModularBalanced<double>::maxCardinality())
+				return ConvertWorkspaceSize<double> (F, m, n, k, w);
+			return 0;
+		}
+
+		template<class Field>
+		inline size_t DoubleWorkspaceSize (const Field& F, const size_t m, const size_t n, const size_t k, const int w)
+		{
+			if (F.characteristic() < DOUBLE_TO_FLOAT_CROSSOVER)
+				return ConvertWorkspaceSize<float> (F, m, n, k, w);
+			return WinogradWorkspaceSize (F, m, n, k, w);
+		}
+
+		template<class Field>
+		inline size_t Int64WorkspaceSize (const Field& F, const size_t m, const size_t n, const size_t k, const int w)
+		{
+			if (16*F.cardinality() < Givaro::ModularBalanced<double>::maxCardinality())
+				return ConvertWorkspaceSize<double> (F, m, n, k, w);
+			return WinogradWorkspaceSize (F, m, n, k, w);
+		}
+
+		inline size_t WorkspaceSize (const Givaro::Modular<double>& F, const size_t m, const size_t n, const size_t k,
+					     const int w, ModeCategories::DelayedTag)
+		{
+			return DoubleWorkspaceSize (F, m, n, k, w);
+		}
+
+		inline size_t WorkspaceSize (const Givaro::ModularBalanced<double>& F, const size_t m, const size_t n, const size_t k,
+					     const int w, ModeCategories::DelayedTag)
+		{
+			return DoubleWorkspaceSize (F, m, n, k, w);
+		}
+
+		inline size_t WorkspaceSize (const Givaro::Modular<int64_t>& F, const size_t m, const size_t n, const size_t k,
+					     const int w, ModeCategories::DelayedTag)
+		{
+			return Int64WorkspaceSize (F, m, n, k, w);
+		}
+
+		inline size_t WorkspaceSize (const Givaro::ModularBalanced<int64_t>& F, const size_t m, const size_t n, const size_t k,
+					     const int w, ModeCategories::DelayedTag)
+		{
+			return Int64WorkspaceSize (F, m, n, k, w);
+		}
+
+	} // Protected
+
+	template<class Field>
+	inline size_t fgemm_workspace_size (const Field& F,
+					    const size_t m, const size_t n, const size_t k,
+					    const int w)
+	{
+		return Protected::WorkspaceSize (F, m, n, k, w, typename ModeTraits<Field>::value());
+	}
 	
 } // FFLAS
 
@@ -29,82 +29,176 @@
 
 /** @file fflas/fflas_fgemm/schedule_bini.inl
  * @ingroup MMalgos
- * @brief Bini implementation
+ * @brief Bini's approximate 3x2x2 product, made exact modulo a small prime.
+ *
+ * Bini's scheme multiplies a 3x2 by a 2x2 block matrix with 10 products
+ * instead of 12, up to terms in \f$\epsilon\f$. Over \f$\mathbb{Z}\f$ the
+ * combinations divided by \f$\epsilon\f$ are exact multiples of it, so that
+ * with \f$\epsilon = p\f$ every division is exact and the error terms left
+ * are multiples of \f$p\f$: one level of the scheme gives the product modulo
+ * \f$p\f$, as long as no intermediate value exceeds the mantissa
+ * (see Protected::BiniBound).
  */
 
 #ifndef __FFLASFFPACK_fgemm_bini_INL
 #define __FFLASFFPACK_fgemm_bini_INL
 
-namespace FFLAS { namespace BLAS3 {
+#include <cmath>
+
+namespace FFLAS { namespace Protected {
 
-	template < class Field >
+	//! \p C <- \p C / e, the entries of \p C being multiples of e = 1 / \p inve
+	template <class Element>
+	inline void BiniDivin (const size_t m, const size_t n, const Element inve,
+			       Element* C, const size_t ldc)
+	{
+		for (size_t i = 0; i < m; ++i, C += ldc)
+			for (size_t j = 0; j < n; ++j)
+				C[j] = std::rint (C[j] * inve);
+	}
+
+} // Protected
+
+namespace BLAS3 {
+
+	/** \brief One level of Bini's scheme, with \f$\epsilon = p\f$.
+	 *
+	 * \f$C \gets \mathrm{op}(A) \mathrm{op}(B)\f$ over \f$\mathbb{Z}\f$, up to
+	 * multiples of \f$p\f$, where \f$\mathrm{op}(A)\f$ is \c 3mr x \c 2kr and
+	 * \f$\mathrm{op}(B)\f$ is \c 2kr x \c 2nr. C is not reduced.
+	 * The products are done over the delayed field with \c H.recLevel levels
+	 * of Winograd's algorithm: \c mr, \c nr and \c kr must be multiples of
+	 * \f$2^{\mathtt{H.recLevel}}\f$.
+	 */
+	template <class Field, class FieldMode>
 	inline void Bini (const Field& F,
 			  const FFLAS_TRANSPOSE ta,
 			  const FFLAS_TRANSPOSE tb,
 			  const size_t mr, const size_t nr, const size_t kr,
-			  const typename Field::Element alpha,
-			  const typename Field::Element_ptr A,const size_t lda,
-			  const typename Field::Element_ptr B,const size_t ldb,
-			  const typename Field::Element  beta,
+			  typename Field::ConstElement_ptr A, const size_t lda,
+			  typename Field::ConstElement_ptr B, const size_t ldb,
 			  typename Field::Element_ptr C, const size_t ldc,
-			  const size_t kmax, const size_t w, const FFLAS_BASE base,
-			  const size_t rec_level)
+			  MMHelper<Field, MMHelperAlgo::Bini, FieldMode> & H)
 	{
-
-		FFLASFFPACK_check(F.isZero(beta));
-		FFLASFFPACK_check(rec_level>0);
-
-		size_t imaxb, jmaxb, imaxa, jmaxa, ldx2;
-		// size_t x3rd = std::max(mr,kr);
-		const typename Field::Element_ptr d11,d12,d21,d22;
-		typename Field::Element_ptr d11c,d12c,d21c,d22c,dx1,dx2;
-		const typename Field::Element_ptr A11=A, A12, A21, A22;
-		const typename Field::Element_ptr B11=B, B12, B21, B22;
-		typename Field::Element_ptr C11=C, C12=C+nr, C21=C+mr*ldc, C22=C+nr+mr*ldc;
-
-
-		size_t x1rd = std::max(nr,kr);
-		size_t ldx1;
-		if (ta == FflasTrans) {
-			A21 = A + mr;
-			A12 = A + kr*lda;
-			A22 = A12 + mr;
-			imaxa = kr;
-			jmaxa = mr;
-			ldx1 = mr;
-		}
-		else {
-			A12 = A + kr;
-			A21 = A + mr*lda;
-			A22 = A21 + kr;
-			imaxa = mr;
-			jmaxa = kr;
-			ldx1  = x1rd;
-		}
-		if (tb == FflasTrans) {
-			B21 = B + kr;
-			B12 = B + nr*ldb;
-			B22 = B12 + kr;
-			imaxb = nr;
-			jmaxb = kr;
-			ldx2 = kr;
-		}
-		else {
-			B12 = B + nr;
-			B21 = B + kr*ldb;
-			B22 = B21 + nr;
-			imaxb = kr;
-			ldx2 = jmaxb = nr;
-		}
-
-
-
+		typedef MMHelper<Field, MMHelperAlgo::Bini, FieldMode> HelperType;
+		typedef typename HelperType::DelayedField DelayedField;
+		typedef typename DelayedField::Element DFElt;
+		typedef typename DelayedField::Element_ptr DFElt_ptr;
+		typedef typename DelayedField::ConstElement_ptr DFCElt_ptr;
+		const DelayedField & Z = H.delayedField;
+
+		MMHelper<DelayedField, MMHelperAlgo::Winograd, ModeCategories::DefaultBoundedTag> HZ(H);
+		const DFElt e = (DFElt) F.characteristic();
+		const DFElt me = -e;
+		const DFElt inve = Z.one / e;
+
+		// blocks of op(A) and op(B), stored transposed when ta or tb is FflasTrans
+		const size_t ra = (ta == FflasNoTrans) ? mr*lda : mr;
+		const size_t ca = (ta == FflasNoTrans) ? kr : kr*lda;
+		const size_t rb = (tb == FflasNoTrans) ? kr*ldb : kr;
+		const size_t cb = (tb == FflasNoTrans) ? nr : nr*ldb;
+		const size_t ma = (ta == FflasNoTrans) ? mr : kr;
+		const size_t na = (ta == FflasNoTrans) ? kr : mr;
+		const size_t mb = (tb == FflasNoTrans) ? kr : nr;
+		const size_t nb = (tb == FflasNoTrans) ? nr : kr;
+
+		DFCElt_ptr A11 = (DFCElt_ptr) A, A12 = A11 + ca;
+		DFCElt_ptr A21 = A11 + ra, A22 = A21 + ca;
+		DFCElt_ptr A31 = A21 + ra, A32 = A31 + ca;
+		DFCElt_ptr B11 = (DFCElt_ptr) B, B12 = B11 + cb;
+		DFCElt_ptr B21 = B11 + rb, B22 = B21 + cb;
+		DFElt_ptr C11 = (DFElt_ptr) C, C12 = C11 + nr;
+		DFElt_ptr C21 = C11 + mr*ldc, C22 = C21 + nr;
+		DFElt_ptr C31 = C21 + mr*ldc, C32 = C31 + nr;
+
+		Protected::WorkspaceFrame ws (H.workspace);
+		DFElt_ptr S = ws.allocate (Z, ma, na);
+		DFElt_ptr T = ws.allocate (Z, mb, nb);
+		DFElt_ptr X = ws.allocate (Z, mr, nr);
+		DFElt_ptr Y = ws.allocate (Z, mr, nr);
+
+		/*
+		 * S1  := A11 + A22,     T1  := e B11 + B22,    P1  := S1 T1
+		 * S4  := e A12 + A22,   T4  := B21 - e B11,    P4  := S4 T4
+		 *                       T2  := B21 + B22,      P2  := A22 T2
+		 *                                              P3  := A11 B22
+		 * S5  := A11 + e A12,   T5  := e B12 + B22,    P5  := S5 T5
+		 * S6  := A21 + A32,     T6  := B11 + e B22,    P6  := S6 T6
+		 *                       T7  := B11 + B12,      P7  := A21 T7
+		 *                                              P8  := A32 B11
+		 * S9  := A21 + e A31,   T9  := B12 - e B22,    P9  := S9 T9
+		 * S10 := e A31 + A32,   T10 := B11 + e B21,    P10 := S10 T10
+		 *
+		 * C11 := (P1 - P2 - P3 + P4) / e,   C12 := (P5 - P3) / e,
+		 * C21 := P4 + P6 - P10,             C22 := P1 - P5 + P9,
+		 * C31 := (P10 - P8) / e,            C32 := (P6 - P7 - P8 + P9) / e.
+		 */
+
+		// P1 in C22
+		fadd (Z, ma, na, A11, lda, A22, lda, S, na);
+		fassign (Z, mb, nb, B22, ldb, T, nb);
+		faxpy (Z, mb, nb, e, B11, ldb, T, nb);
+		fgemm (Z, ta, tb, mr, nr, kr, Z.one, S, na, T, nb, Z.zero, C22, ldc, HZ);
+		// P4 in C21
+		fassign (Z, ma, na, A22, lda, S, na);
+		faxpy (Z, ma, na, e, A12, lda, S, na);
+		fassign (Z, mb, nb, B21, ldb, T, nb);
+		faxpy (Z, mb, nb, me, B11, ldb, T, nb);
+		fgemm (Z, ta, tb, mr, nr, kr, Z.one, S, na, T, nb, Z.zero, C21, ldc, HZ);
+		// C11 = P1 + P4
+		fadd (Z, mr, nr, C21, ldc, C22, ldc, C11, ldc);
+		// P2 in X, P3 in C12
+		fadd (Z, mb, nb, B21, ldb, B22, ldb, T, nb);
+		fgemm (Z, ta, tb, mr, nr, kr, Z.one, A22, lda, T, nb, Z.zero, X, nr, HZ);
+		fgemm (Z, ta, tb, mr, nr, kr, Z.one, A11, lda, B22, ldb, Z.zero, C12, ldc, HZ);
+		fsubin (Z, mr, nr, X, nr, C11, ldc);
+		fsubin (Z, mr, nr, C12, ldc, C11, ldc);
+		Protected::BiniDivin (mr, nr, inve, C11, ldc);
+		// P5 in Y
+		fassign (Z, ma, na, A11, lda, S, na);
+		faxpy (Z, ma, na, e, A12, lda, S, na);
+		fassign (Z, mb, nb, B22, ldb, T, nb);
+		faxpy (Z, mb, nb, e, B12, ldb, T, nb);
+		fgemm (Z, ta, tb, mr, nr, kr, Z.one, S, na, T, nb, Z.zero, Y, nr, HZ);
+		fsub (Z, mr, nr, Y, nr, C12, ldc, C12, ldc);
+		Protected::BiniDivin (mr, nr, inve, C12, ldc);
+		// P6 in C32
+		fadd (Z, ma, na, A21, lda, A32, lda, S, na);
+		fassign (Z, mb, nb, B11, ldb, T, nb);
+		faxpy (Z, mb, nb, e, B22, ldb, T, nb);
+		fgemm (Z, ta, tb, mr, nr, kr, Z.one, S, na, T, nb, Z.zero, C32, ldc, HZ);
+		faddin (Z, mr, nr, C32, ldc, C21, ldc);
+		// P7 in X, P8 in C31
+		fadd (Z, mb, nb, B11, ldb, B12, ldb, T, nb);
+		fgemm (Z, ta, tb, mr, nr, kr, Z.one, A21, lda, T, nb, Z.zero, X, nr, HZ);
+		fgemm (Z, ta, tb, mr, nr, kr, Z.one, A32, lda, B11, ldb, Z.zero, C31, ldc, HZ);
+		fsubin (Z, mr, nr, X, nr, C32, ldc);
+		fsubin (Z, mr, nr, C31, ldc, C32, ldc);
+		// P9 in X
+		fassign (Z, ma, na, A21, lda, S, na);
+		faxpy (Z, ma, na, e, A31, lda, S, na);
+		fassign (Z, mb, nb, B12, ldb, T, nb);
+		faxpy (Z, mb, nb, me, B22, ldb, T, nb);
+		fgemm (Z, ta, tb, mr, nr, kr, Z.one, S, na, T, nb, Z.zero, X, nr, HZ);
+		faddin (Z, mr, nr, X, nr, C32, ldc);
+		Protected::BiniDivin (mr, nr, inve, C32, ldc);
+		faddin (Z, mr, nr, X, nr, C22, ldc);
+		fsubin (Z, mr, nr, Y, nr, C22, ldc);
+		// P10 in X
+		fassign (Z, ma, na, A32, lda, S, na);
+		faxpy (Z, ma, na, e, A31, lda, S, na);
+		fassign (Z, mb, nb, B11, ldb, T, nb);
+		faxpy (Z, mb, nb, e, B21, ldb, T, nb);
+		fgemm (Z, ta, tb, mr, nr, kr, Z.one, S, na, T, nb, Z.zero, X, nr, HZ);
+		fsubin (Z, mr, nr, X, nr, C21, ldc);
+		fsub (Z, mr, nr, X, nr, C31, ldc, C31, ldc);
+		Protected::BiniDivin (mr, nr, inve, C31, ldc);
+
+		ws.release (S, T, X, Y);
 	} // Bini
 
 } // BLAS3
 
-
 } // FFLAS
 
 #endif // __FFLASFFPACK_fgemm_bini_INL
-
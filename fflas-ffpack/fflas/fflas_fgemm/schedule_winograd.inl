@@ -357,18 +357,20 @@ namespace FFLAS { namespace BLAS3 {
 				lb = kr;
 				ldX2 = cb = nr;
 			}
+			Protected::WorkspaceFrame ws (WH.workspace);
 			    // Two temporary submatrices are required
-			typename Field::Element_ptr X2 = fflas_new (F, kr, nr);
+			typename Field::Element_ptr X2 = ws.allocate (F, kr, nr);
 
 			    // T3 = B22 - B12 in X2
 			fsub(DF,lb,cb, (DFCEptr) B22,ldb, (DFCEptr) B12,ldb, (DFEptr)X2,ldX2);
 
 			    // S3 = A11 - A21 in X1
-			typename Field::Element_ptr X1 = fflas_new (F,mr,x1rd);
+			typename Field::Element_ptr X1 = ws.allocate (F, mr, x1rd);
 			fsub(DF,la,ca,(DFCEptr)A11,lda,(DFCEptr)A21,lda,(DFEptr)X1,ldX1);
 
 			    // P7 = alpha . S3 * T3  in C21
 			MMH_t H7(F, WH.recLevel-1, -(WH.Amax-WH.Amin), WH.Amax-WH.Amin, -(WH.Bmax-WH.Bmin), WH.Bmax-WH.Bmin, 0,0);
+			H7.workspace = WH.workspace;
 			fgemm (F, ta, tb, mr, nr, kr, alpha, X1, ldX1, X2, ldX2, F.zero, C21, ldc, H7);
 
 			    // T1 = B12 - B11 in X2
@@ -379,6 +381,7 @@ namespace FFLAS { namespace BLAS3 {
 
 			    // P5 = alpha . S1*T1 in C22
 			MMH_t H5(F, WH.recLevel-1, 2*WH.Amin, 2*WH.Amax, -(WH.Bmax-WH.Bmin), WH.Bmax-WH.Bmin, 0, 0);
+			H5.workspace = WH.workspace;
 			fgemm (F, ta, tb, mr, nr, kr, alpha, X1, ldX1, X2, ldX2, F.zero, C22, ldc, H5);
 
 			    // T2 = B22 - T1 in X2
@@ -389,6 +392,7 @@ namespace FFLAS { namespace BLAS3 {
 
 			    // P6 = alpha . S2 * T2 in C12
 			MMH_t H6(F, WH.recLevel-1, 2*WH.Amin-WH.Amax, 2*WH.Amax-WH.Amin, 2*WH.Bmin-WH.Bmax, 2*WH.Bmax-WH.Bmin, 0, 0);
+			H6.workspace = WH.workspace;
 			fgemm (F, ta, tb, mr, nr, kr, alpha, X1, ldX1, X2, ldX2, F.zero, C12, ldc, H6);
 
 			    // S4 = A12 -S2 in X1
@@ -396,10 +400,12 @@ namespace FFLAS { namespace BLAS3 {
 
 			    // P3 = alpha . S4*B22 in C11
 			MMH_t H3(F, WH.recLevel-1, 2*WH.Amin-2*WH.Amax, 2*WH.Amax-2*WH.Amin, WH.Bmin, WH.Bmax, 0, 0);
+			H3.workspace = WH.workspace;
 			fgemm (F, ta, tb, mr, nr, kr, alpha, X1, ldX1, B22, ldb, F.zero, C11, ldc, H3);
 
 			    // P1 = alpha . A11 * B11 in X1
 			MMH_t H1(F, WH.recLevel-1, WH.Amin, WH.Amax, WH.Bmin, WH.Bmax, 0, 0);
+			H1.workspace = WH.workspace;
 			fgemm (F, ta, tb, mr, nr, kr, alpha, A11, lda, B11, ldb, F.zero, X1, nr, H1);
 
 			    // U2 = P1 + P6 in C12  and
@@ -453,9 +459,10 @@ namespace FFLAS { namespace BLAS3 {
 
 			    // P4 = alpha . A22 * T4 in C11
 			MMH_t H4(F, WH.recLevel-1, WH.Amin, WH.Amax, 2*WH.Bmin-2*WH.Bmax, 2*WH.Bmax-2*WH.Bmin, 0, 0);
+			H4.workspace = WH.workspace;
 			fgemm (F, ta, tb, mr, nr, kr, alpha, A22, lda, X2, ldX2, F.zero, C11, ldc, H4);
 
-			fflas_delete (X2);
+			ws.release (X2);
 
 			    // U6 = U3 - P4 in C21
 			DFElt U6Min, U6Max;
@@ -468,6 +475,7 @@ namespace FFLAS { namespace BLAS3 {
 
 			    // P2 = alpha . A12 * B21  in C11
 			MMH_t H2(F, WH.recLevel-1, WH.Amin, WH.Amax, WH.Bmin, WH.Bmax, 0, 0);
+			H2.workspace = WH.workspace;
 			fgemm (F, ta, tb, mr, nr, kr, alpha, A12, lda, B21, ldb, F.zero, C11, ldc, H2);
 
 			    //  U1 = P2 + P1 in C11
@@ -479,7 +487,7 @@ namespace FFLAS { namespace BLAS3 {
 			}
 			faddin(DF,mr,nr,(DFCEptr)X1,nr,(DFEptr)C11,ldc);
 
-			fflas_delete (X1);
+			ws.release (X1);
 
 			WH.Outmin = std::min (U1Min, std::min (U5Min, std::min (U6Min, U7Min)));
 			WH.Outmax = std::max (U1Max, std::max (U5Max, std::max (U6Max, U7Max)));
@@ -106,12 +106,13 @@ namespace FFLAS { namespace BLAS3 {
 		// P2 = alpha . A12 * B21 + beta . C11  in C11
 		fgemm (F, ta, tb, mr, nr, kr, alpha, A12, lda, B21, ldb, beta, C11, ldc, H);
 
-		typename Field::Element_ptr X3 = fflas_new (F, x3rd, nr);
+		Protected::WorkspaceFrame ws (WH.workspace);
+		typename Field::Element_ptr X3 = ws.allocate (F, x3rd, nr);
 
 		// T3 = B22 - B12 in X3
 		fsub(F,lb,cb,B22,ldb,B12,ldb,X3,ldX3);
 
-		typename Field::Element_ptr X2 = fflas_new (F, mr, kr);
+		typename Field::Element_ptr X2 = ws.allocate (F, mr, kr);
 
 		// S3 = A11 - A21 in X2
 		fsub(F,la,ca,A11,lda,A21,lda,X2,ca);
@@ -140,7 +141,7 @@ namespace FFLAS { namespace BLAS3 {
 		// S2 = S1 - A11 in X2
 		fsubin(F,la,ca,A11,lda,X2,ca);
 
-		typename Field::Element_ptr X1 = fflas_new (F, mr, nr);
+		typename Field::Element_ptr X1 = ws.allocate (F, mr, nr);
 
 		// P6 = alpha . S2 * T2 in X1
 		fgemm (F, ta, tb, mr, nr, kr, alpha, X2, ca, X3, ldX3, F.zero, X1, nr, H);
@@ -172,17 +173,17 @@ namespace FFLAS { namespace BLAS3 {
 		// U4 = P5 + U2 in C12    and
 		faddin(F, mr, nr, X1, nr, C12, ldc);
 
-		fflas_delete (X1);
+		ws.release (X1);
 
 		// U6 = U3 - P4 in C21    and
 		fsub(F, mr, nr, X3, nr, C21, ldc, C21, ldc);
 
-		fflas_delete (X3);
+		ws.release (X3);
 
 		// P3 = alpha . S4*B22 in X1
 		fgemm (F, ta, tb, mr, nr, kr, alpha, X2, ca, B22, ldb, F.one, C12, ldc, H);
 
-		fflas_delete (X2);
+		ws.release (X2);
 
 	} // WinogradAccOld
 
@@ -253,24 +254,26 @@ namespace FFLAS { namespace BLAS3 {
 			ldX3 = cb = nr;
 		}
 
+		Protected::WorkspaceFrame ws (WH.workspace);
 		// Three temporary submatrices are required
-		typename Field::Element_ptr X3 = fflas_new (F, x3rd, nr);
+		typename Field::Element_ptr X3 = ws.allocate (F, x3rd, nr);
 
 		// T1 = B12 - B11 in X3
 		fsub(DF,lb,cb,(DFCEptr)B12,ldb,(DFCEptr)B11,ldb,(DFEptr)X3,ldX3);
 
-		typename Field::Element_ptr X2 = fflas_new(F,mr,kr);
+		typename Field::Element_ptr X2 = ws.allocate (F, mr, kr);
 
 		// S1 = A21 + A22 in X2
 		fadd(DF,la,ca,(DFCEptr)A21,lda,(DFCEptr)A22,lda,(DFEptr)X2,ca);
 
-		typename Field::Element_ptr X1 = fflas_new(F,mr,nr);
+		typename Field::Element_ptr X1 = ws.allocate (F, mr, nr);
                 // P5 = alpha . S1*T1  in X1
 		MMH_t H5(F, WH.recLevel-1,
 			 2*WH.Amin, 2*WH.Amax,
 			 -(WH.Bmax-WH.Bmin),
 			 WH.Bmax-WH.Bmin,
 			 0, 0);
+		H5.workspace = WH.workspace;
 		fgemm (F, ta, tb, mr, nr, kr, alpha, X2, ca, X3, ldX3, F.zero, X1, nr, H5);
 
 		DFElt C22Min, C22Max;
@@ -293,6 +296,7 @@ namespace FFLAS { namespace BLAS3 {
 			 WH.Amin, WH.Amax,
 			 WH.Bmin, WH.Bmax,
 			 0, 0);
+		H1.workspace = WH.workspace;
 		fgemm (F, ta, tb, mr, nr, kr, alpha, A11, lda, B11, ldb, F.zero, X1, nr, H1);
 
 		// P2 = alpha . A12 * B21 + beta . C11  in C11
@@ -300,6 +304,7 @@ namespace FFLAS { namespace BLAS3 {
 			 WH.Amin, WH.Amax,
 			 WH.Bmin, WH.Bmax,
 			 WH.Cmin, WH.Cmax);
+		H2.workspace = WH.workspace;
 		fgemm (F, ta, tb, mr, nr, kr, alpha, A12, lda, B21, ldb, beta, C11, ldc, H2);
 
 		//  U1 = P2 + P1 in C11
@@ -321,6 +326,7 @@ namespace FFLAS { namespace BLAS3 {
 			 2*WH.Amin-WH.Amax, 2*WH.Amax-WH.Amin,
 			 2*WH.Bmin-WH.Bmax, 2*WH.Bmax-WH.Bmin,
 			 H1.Outmin, H1.Outmax);
+		H6.workspace = WH.workspace;
 		fgemm (F, ta, tb, mr, nr, kr, alpha, X2, ca, X3, ldX3, F.one, X1, nr, H6);
 
 		// U4 = U2 + C12 in C12
@@ -342,6 +348,7 @@ namespace FFLAS { namespace BLAS3 {
 			 WH.Amin, WH.Amax,
 			 2*WH.Bmin-2*WH.Bmax, 2*WH.Bmax-2*WH.Bmin,
 			 WH.Cmin, WH.Cmax);
+		H4.workspace = WH.workspace;
 		fgemm (F, ta, tb, mr, nr, kr, alpha, A22, lda, X3, ldX3, mbeta, C21, ldc, H4);
 
 		// U5 = P3 + U4 = alpha . S4*B22 + U4 in C12
@@ -349,6 +356,7 @@ namespace FFLAS { namespace BLAS3 {
 			 2*WH.Amin-2*WH.Amax, 2*WH.Amax-2*WH.Amin,
 			 WH.Bmin, WH.Bmax,
 			 U4Min, U4Max);
+		H3.workspace = WH.workspace;
 		fgemm (F, ta, tb, mr, nr, kr, alpha, X2, ca, B22, ldb, F.one, C12, ldc, H3);
 
                 // T3 = B22 - B12 in X3
@@ -362,10 +370,11 @@ namespace FFLAS { namespace BLAS3 {
 			 WH.Amin-WH.Amax, WH.Amax-WH.Amin,
 			 WH.Bmin-WH.Bmax, WH.Bmax-WH.Bmin,
 			 H6.Outmin, H6.Outmax);
+		H7.workspace = WH.workspace;
 		fgemm (F, ta, tb, mr, nr, kr, alpha, X2, ca, X3, ldX3, F.one, X1, nr, H7);
 
-		fflas_delete (X2);
-		fflas_delete (X3);
+		ws.release (X2);
+		ws.release (X3);
 
 		// U7 =  U3 + C22 in C22
 		DFElt U7Min, U7Max;
@@ -383,7 +392,7 @@ namespace FFLAS { namespace BLAS3 {
 		}
 		fsub(DF,mr,nr,(DFCEptr)X1,nr,(DFCEptr)C21,ldc,(DFEptr)C21,ldc);
 
-		fflas_delete (X1);
+		ws.release (X1);
 
 		// Updating WH with Outmin, Outmax of the result
 		WH.Outmin = min4 (U1Min, H3.Outmin, U6Min, U7Min);
@@ -460,11 +469,12 @@ namespace FFLAS { namespace BLAS3 {
 		fsubin(F,mr,nr,C12,ldc,C22,ldc);
 		// Z3 = C12-C21           in C12
 		fsubin(F,mr,nr,C21,ldc,C12,ldc);
+		Protected::WorkspaceFrame ws (WH.workspace);
 		// S1 = A21 + A22         in X
-		typename Field::Element_ptr X = fflas_new(F,mr,std::max(nr,kr));
+		typename Field::Element_ptr X = ws.allocate (F, mr, std::max(nr,kr));
 		fadd(F,la,ca,A21,lda,A22,lda,X,ca);
 		// T1 = B12 - B11         in Y
-		typename Field::Element_ptr Y = fflas_new(F,nr,kr);
+		typename Field::Element_ptr Y = ws.allocate (F, nr, kr);
 		fsub(F,lb,cb,B12,ldb,B11,ldb,Y,cb);
 		// P5 = a S1 T1 + b Z3    in C12
 		fgemm (F, ta, tb, mr, nr, kr, alpha, X, ca, Y, cb, beta, C12, ldc, H);
@@ -496,7 +506,7 @@ namespace FFLAS { namespace BLAS3 {
 		fsub(F,lb,cb,B22,ldb,B12,ldb,Y,cb);
 		// U3 = a S3 T3 + U2      in C21
 		fgemm (F, ta, tb, mr, nr, kr, alpha, X, ca, Y, cb, F.one, C21, ldc, H);
-		fflas_delete (X);
+		ws.release (X);
 		// U7 = U3 + W1           in C22
 		faddin(F,mr,nr,C21,ldc,C22,ldc);
 		// T1_ = B12 - B11        in Y
@@ -507,7 +517,7 @@ namespace FFLAS { namespace BLAS3 {
 		fsub(F,lb,cb,Y,cb,B21,ldb,Y,cb);
 		// U6 = -a A22 T4 + U3    in C21;
 		fgemm (F, ta, tb, mr, nr, kr, malpha, A22, lda, Y, cb, F.one, C21, ldc, H);
-		fflas_delete (Y);
+		ws.release (Y);
 
 
 	} // WinogradAccOld
@@ -580,11 +590,12 @@ namespace FFLAS { namespace BLAS3 {
 		fsubin(F,mr,nr,C12,ldc,C22,ldc);
 		// Z3 = C12-C21           in C12
 		fsubin(F,mr,nr,C21,ldc,C12,ldc);
+		Protected::WorkspaceFrame ws (WH.workspace);
 		// S1 = A21 + A22         in X
-		typename Field::Element_ptr X = fflas_new(F,mr,std::max(nr,kr));
+		typename Field::Element_ptr X = ws.allocate (F, mr, std::max(nr,kr));
 		fadd(F,la,ca,A21,lda,A22,lda,X,ca);
 		// T1 = B12 - B11         in Y
-		typename Field::Element_ptr Y = fflas_new(F,nr,std::max(kr,mr));
+		typename Field::Element_ptr Y = ws.allocate (F, nr, std::max(kr,mr));
 		fsub(F,lb,cb,B12,ldb,B11,ldb,Y,cb);
 		// P5 = a S1 T1 + b Z3    in C12
 		fgemm (F, ta, tb, mr, nr, kr, alpha, X, ca, Y, cb, beta, C12, ldc, H);
@@ -628,9 +639,9 @@ namespace FFLAS { namespace BLAS3 {
 		fsub(F,lb,cb,Y,cb,B21,ldb,Y,cb);
 		// U6 = -a A22 T4 + U3    in C21;
 		fgemm (F, ta, tb, mr, nr, kr, alpha, A22, lda, Y, cb, F.zero, X, nr, H);
-		fflas_delete (Y);
+		ws.release (Y);
 		fsub(F,mr,nr,C21,ldc,X,nr,C21,ldc);
-		fflas_delete (X);
+		ws.release (X);
 
 
 	} // WinogradAcc3
@@ -105,11 +105,12 @@ namespace FFLAS { namespace BLAS3 {
 
 		// Z1 = C22 - C12         in C22
 		fsubin(F,mr,nr,C12,ldc,C22,ldc);
+		Protected::WorkspaceFrame ws (WH.workspace);
 		// S1 = A21 + A22         in X
-		typename Field::Element_ptr X = fflas_new (F, std::max(std::max(mr*nr,kr*nr),mr*kr), 1);
+		typename Field::Element_ptr X = ws.allocate (F, std::max(std::max(mr*nr,kr*nr),mr*kr), 1);
 		fadd(F,la,ca,A21,lda,A22,lda,X,ca);
 		// T1 = B12 - B11         in Y
-		typename Field::Element_ptr Y = fflas_new (F, std::max(mr,kr), nr);
+		typename Field::Element_ptr Y = ws.allocate (F, std::max(mr,kr), nr);
 		fsub(F,lb,cb,B12,ldb,B11,ldb,Y,cb);
 		// Z2 = C21 - Z1          in C21
 		fsubin(F,mr,nr,C22,ldc,C21,ldc);
@@ -145,7 +146,7 @@ namespace FFLAS { namespace BLAS3 {
 		faddin(F,mr,nr,Y,nr,C11,ldc);
 		// U2 = P6 + P1           in X
 		faddin(F,mr,nr,Y,nr,X,nr);
-		fflas_delete (Y);
+		ws.release (Y);
 		// U3 = U2 + P7           in C22
 		faddin(F,mr,nr,X,nr,C22,ldc);
 		// U4 = U2 + P5           in X
@@ -159,7 +160,7 @@ namespace FFLAS { namespace BLAS3 {
 		// U5 = U4 + P3           in C12
 		faddin(F,mr,nr,X,nr,C12,ldc);
 
-		fflas_delete (X);
+		ws.release (X);
 
 
 	} // WinogradAccOld
@@ -233,16 +234,17 @@ namespace FFLAS { namespace BLAS3 {
 
 		// Z1 = C22 - C12         in C22
 		fsubin(F,mr,nr,C12,ldc,C22,ldc);
+		Protected::WorkspaceFrame ws (WH.workspace);
 		// T1 = B12 - B11         in X
 		// typename Field::Element_ptr X = fflas_new (F, std::max(mr,kr)*nr];
-		typename Field::Element_ptr X = fflas_new (F, mr, nr);
+		typename Field::Element_ptr X = ws.allocate (F, mr, nr);
 		fsub(F,lb,cb,B12,ldb,B11,ldb,X,cb);
 		// Z2 = C21 - Z1          in C21
 		fsubin(F,mr,nr,C22,ldc,C21,ldc);
 		// T3 = B22 - B12         in B12 ;
 		fsub(F,lb,cb,B22,ldb,B12,ldb,B12,ldb);
 		// S3 =  A11 - A21        in Y
-		typename Field::Element_ptr Y = fflas_new (F, mr, kr);
+		typename Field::Element_ptr Y = ws.allocate (F, mr, kr);
 		fsub(F,la,ca,A11,lda,A21,lda,Y,ca);
 		// P7 = a S3 T3 + b Z1    in C22
 		fgemm2 (F, ta, tb, mr, nr, kr, alpha, Y, ca, B12, ldb, beta, C22, ldc, H);
@@ -278,12 +280,12 @@ namespace FFLAS { namespace BLAS3 {
 		fsub(F,mr,nr,C22,ldc,C21,ldc,C21,ldc);
 		// U1 = P1 + P2           in C11
 		faddin(F,mr,nr,X,nr,C11,ldc);
-		fflas_delete (X);
+		ws.release (X);
 		// U7 = U3 + P5           in C22
 		faddin(F,mr,nr,C12,ldc,C22,ldc);
 		// P3 = a S4 B22          in C12
 		fgemm2 (F, ta, tb, mr, nr, kr, alpha, Y, ca, B22, ldb, F.zero, C12, ldc, H);
-		fflas_delete (Y);
+		ws.release (Y);
 		// U5 = U4 + P3           in C12
 		faddin(F,mr,nr,B21,ldb,C12,ldc);
 
@@ -364,13 +366,14 @@ namespace FFLAS { namespace BLAS3 {
 		fsubin(F,mr,nr,C12,ldc,C22,ldc);
 		// Z2 = C21 - Z1          in C21
 		fsubin(F,mr,nr,C22,ldc,C21,ldc);
+		Protected::WorkspaceFrame ws (WH.workspace);
 		// S3 =  A11 - A21        in X
-		typename Field::Element_ptr X = fflas_new (F, mr, nr);
+		typename Field::Element_ptr X = ws.allocate (F, mr, nr);
 		fsub(F,la,ca,A11,lda,A21,lda,X,ca);
 		// S1 = A21 + A22         in A21
 		faddin(F,la,ca,A22,lda,A21,lda);
 		// T3 = B22 - B12         in Y ;
-		typename Field::Element_ptr Y = fflas_new (F, mr, kr);
+		typename Field::Element_ptr Y = ws.allocate (F, mr, kr);
 		fsub(F,lb,cb,B22,ldb,B12,ldb,Y,cb);
 		// P7 = a S3 T3 + b Z1    in C22
 		fgemm2 (F, ta, tb, mr, nr, kr, alpha, X, ca, Y, cb, beta, C22, ldc, H);
@@ -408,12 +411,12 @@ namespace FFLAS { namespace BLAS3 {
 		faddin(F,mr,nr,C12,ldc,C22,ldc);
 		// U4 = U2 + P5           in C12
 		faddin(F,mr,nr,X,nr,C12,ldc);
-		fflas_delete (X);
+		ws.release (X);
 		// W3 = a S4 B22          in Y
 		fgemm2 (F, ta, tb, mr, nr, kr, alpha, A11, lda, B22, ldb, F.zero, Y, nr, H);
 		// U5 = U4 + W3           in C12
 		faddin(F,mr,nr,Y,nr,C12,ldc);
-		fflas_delete (Y);
+		ws.release (Y);
 
 
 	} // WinogradAccOld
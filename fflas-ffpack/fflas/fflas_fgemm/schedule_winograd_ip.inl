@@ -213,8 +213,9 @@ namespace FFLAS { namespace BLAS3 {
 		fgemm2 (F, ta, tb, mr, nr, kr, alpha, A11, lda, B11, ldb, F.zero, C11, ldc, H);
 		// T3 = B22 - B12         in A11
 		fsub(F,lb,cb,B22,ldb,B12,ldb,A11,lda);
+		Protected::WorkspaceFrame ws (WH.workspace);
 		// P7 = S3 T3             in X
-		typename Field::Element_ptr X = fflas_new (F, mr, nr);
+		typename Field::Element_ptr X = ws.allocate (F, mr, nr);
 		fgemm2 (F, ta, tb, mr, nr, kr, alpha, C22, ldc, A11, lda, F.zero, X, nr, H);
 		// T2 = B22 - T1          in A11
 		fsub(F,lb,cb,B22,ldb,C21,ldc,A11,lda);
@@ -242,7 +243,7 @@ namespace FFLAS { namespace BLAS3 {
 		fgemm2 (F, ta, tb, mr, nr, kr, alpha, A12, lda, B21, ldb, F.zero, X, nr, H);
 		// U1 = P1 + P2           in C11
 		faddin(F,mr,nr,X,nr,C11,ldc);
-		fflas_delete (X);
+		ws.release (X);
 		// P4 = A22 T4            in A21
 		fgemm2 (F, ta, tb, mr, nr, kr, alpha, A22, lda, A11, lda, F.zero, A21, lda, H);
 		// U6 = U3 - P4           in C21
@@ -319,8 +320,9 @@ namespace FFLAS { namespace BLAS3 {
 		fsub(F,la,ca,C21,ldc,A11,lda,B11,ldb);
 		// T3 = B22 - B12         in B12
 		fsub(F,lb,cb,B22,ldb,B12,ldb,B12,ldb);
+		Protected::WorkspaceFrame ws (WH.workspace);
 		// P7 = S3 T3             in X
-		typename Field::Element_ptr X = fflas_new (F, mr, nr);
+		typename Field::Element_ptr X = ws.allocate (F, mr, nr);
 		fgemm2 (F, ta, tb, mr, nr, kr, alpha, C22, ldc, B12, ldb, F.zero, X, nr, H);
 		// T2 = B22 - T1          in B12
 		fsub(F,lb,cb,B22,ldb,C12,ldc,B12,ldb);
@@ -340,7 +342,7 @@ namespace FFLAS { namespace BLAS3 {
 		fadd(F,mr,nr,C22,ldc,C21,ldc,C12,ldc);
 		// U3 = U2 + P7           in C21
 		faddin(F,mr,nr,X,nr,C21,ldc);
-		fflas_delete (X);
+		ws.release (X);
 		// U7 = U3 + P5           in C22
 		faddin(F,mr,nr,C21,ldc,C22,ldc);
 		// U6 = U3 - P4           in C21
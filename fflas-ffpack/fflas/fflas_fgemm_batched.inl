@@ -0,0 +1,518 @@
+/* -*- mode: C++; tab-width: 8; indent-tabs-mode: t; c-basic-offset: 8 -*- */
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/*
+ * Copyright (C) 2016 the FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ *.
+ */
+
+/** @file fflas/fflas_fgemm_batched.inl
+ * @brief Products of many small matrices of the same shape.
+ *
+ * The bounds on the delayed reductions are computed once for the whole batch.
+ * Over a prime field with floating point elements the matrices are
+ * interleaved by groups of one SIMD vector: entry \f$(i,j)\f$ of the \c vect_size
+ * matrices of a group are contiguous, so that each fused multiply-add of the
+ * classical product works on one entry of \c vect_size different products.
+ * Groups are distributed over the threads when a
+ * ParSeqHelper::Parallel helper is given.
+ * Other fields fall back to one classical fgemm per matrix.
+ */
+
+#ifndef __FFLASFFPACK_fflas_fgemm_batched_INL
+#define __FFLASFFPACK_fflas_fgemm_batched_INL
+
+#include <vector>
+#include "fflas-ffpack/utils/fflas_memory.h"
+
+namespace FFLAS { namespace Protected { namespace batched {
+
+	/** \internal
+	 * Width of an interleaved group: one SIMD vector over prime fields with
+	 * floating point elements and delayed reductions, one matrix otherwise.
+	 */
+	template<class Field,
+		 bool = std::is_floating_point<typename Field::Element>::value
+		 && std::is_same<typename ModeTraits<Field>::value, ModeCategories::DelayedTag>::value>
+	struct BatchTraits {
+		static const bool vectorised = false;
+		static const size_t vect_size = 1;
+	};
+
+#ifdef __FFLASFFPACK_USE_SIMD
+	template<class Field>
+	struct BatchTraits<Field, true> {
+		typedef Simd<typename Field::Element> simd;
+		static const bool vectorised = true;
+		static const size_t vect_size = simd::vect_size;
+	};
+#endif
+
+	/** \internal
+	 * Number of products that can be added to a reduced value without
+	 * overflowing the mantissa; 0 if no delayed accumulation is possible.
+	 */
+	template<class Field>
+	inline size_t MaxDelayedProducts (const Field& F, std::true_type)
+	{
+		typedef MMHelper<Field, MMHelperAlgo::Classic, ModeCategories::DelayedTag> Helper;
+		Helper H(F, 0, ParSeqHelper::Sequential());
+		return H.MaxDelayedDim(typename Helper::DFElt(1));
+	}
+
+	template<class Field>
+	inline size_t MaxDelayedProducts (const Field&, std::false_type)
+	{
+		return 0;
+	}
+
+	template<class Field>
+	inline size_t MaxDelayedProducts (const Field& F)
+	{
+		return MaxDelayedProducts(F, std::integral_constant<bool, BatchTraits<Field>::vectorised>());
+	}
+
+	//! calls \c f(first,last) on sub-ranges of the \p ngroups groups
+	template<class Func>
+	inline void forGroups (const size_t ngroups, const Func& f, const ParSeqHelper::Sequential&)
+	{
+		f(0, ngroups);
+	}
+
+	template<class Func, class Cut, class Param>
+	inline void forGroups (const size_t ngroups, const Func& f, const ParSeqHelper::Parallel<Cut,Param>& psH)
+	{
+		SYNCH_GROUP(
+			FORBLOCK1D(iter, ngroups, SPLITTER(psH.numthreads()),
+				   TASK(MODE(CONSTREFERENCE(f)),
+					f(iter.begin(), iter.end());
+					);
+				   );
+			);
+	}
+
+	/** \internal
+	 * Interleaves the \p nb matrices \c X[b] (\p rows x \p cols, leading dimension \p ldx)
+	 * in \p W, where entry \f$(i,j)\f$ of \c X[b] goes to \c W[(i*cols+j)*inc+b].
+	 */
+	template<class Element>
+	inline void interleave (Element* W, const size_t inc, const Element* const* X, const size_t nb,
+				const size_t rows, const size_t cols, const size_t ldx)
+	{
+		for (size_t b = 0; b < nb; ++b) {
+			const Element* Xb = X[b];
+			Element* Wb = W + b;
+			for (size_t i = 0; i < rows; ++i)
+				for (size_t j = 0; j < cols; ++j)
+					Wb[(i*cols+j)*inc] = Xb[i*ldx+j];
+		}
+	}
+
+	//! inverse of interleave
+	template<class Element>
+	inline void deinterleave (Element* const* X, const size_t nb, const size_t rows, const size_t cols,
+				  const size_t ldx, const Element* W, const size_t inc)
+	{
+		for (size_t b = 0; b < nb; ++b) {
+			Element* Xb = X[b];
+			const Element* Wb = W + b;
+			for (size_t i = 0; i < rows; ++i)
+				for (size_t j = 0; j < cols; ++j)
+					Xb[i*ldx+j] = Wb[(i*cols+j)*inc];
+		}
+	}
+
+	/** \internal
+	 * Interleaved operands: entry \f$(i,j)\f$ of \c X_b is at <code>X + i*rs + j*cs + b</code>.
+	 * Row and column strides already account for the transposition and the interleaving.
+	 */
+	struct Strides {
+		size_t rsA, csA, rsB, csB, ldc, inc;
+		Strides (const FFLAS_TRANSPOSE ta, const FFLAS_TRANSPOSE tb,
+			 const size_t lda, const size_t ldb, const size_t ldc_, const size_t inc_) :
+			rsA((ta == FflasNoTrans ? lda : 1)*inc_), csA((ta == FflasNoTrans ? 1 : lda)*inc_),
+			rsB((tb == FflasNoTrans ? ldb : 1)*inc_), csB((tb == FflasNoTrans ? 1 : ldb)*inc_),
+			ldc(ldc_*inc_), inc(inc_)
+		{}
+	};
+
+	/** \internal
+	 * Generic lane of an interleaved product, with the field operations.
+	 */
+	template<class Field>
+	inline void gemm_lane (const Field& F, const size_t m, const size_t n, const size_t k,
+			       const typename Field::Element alpha,
+			       const typename Field::Element* A, const typename Field::Element* B,
+			       const typename Field::Element beta, typename Field::Element* C,
+			       const Strides& S)
+	{
+		typename Field::Element c;
+		F.init(c);
+		for (size_t i = 0; i < m; ++i)
+			for (size_t j = 0; j < n; ++j) {
+				F.assign(c, F.zero);
+				for (size_t l = 0; l < k; ++l)
+					F.axpyin(c, A[i*S.rsA+l*S.csA], B[l*S.rsB+j*S.csB]);
+				typename Field::Element& cij = C[i*S.ldc+j*S.inc];
+				F.mulin(c, alpha);
+				if (!F.isZero(beta))
+					F.axpyin(c, beta, cij);
+				F.assign(cij, c);
+			}
+	}
+
+#ifdef __FFLASFFPACK_USE_SIMD
+	/** \internal
+	 * \c NJ columns of one row of \c vect_size consecutive lanes:
+	 * at most \p kmax products are accumulated between two reductions.
+	 */
+	template<size_t NJ, class Field, class HelperSimd>
+	inline void gemm_simd_block (const Field& F, const size_t k,
+				     const typename Field::Element alpha,
+				     const typename Field::Element* Ai, const typename Field::Element* Bj,
+				     const typename Field::Element beta, typename Field::Element* Cij,
+				     const Strides& S, const size_t kmax, HelperSimd& H)
+	{
+		typedef typename BatchTraits<Field>::simd simd;
+		typedef typename simd::vect_t vect_t;
+		vect_t c[NJ];
+		for (size_t jj = 0; jj < NJ; ++jj) c[jj] = simd::zero();
+		for (size_t l = 0; l < k; ) {
+			const size_t lend = std::min(k, l+kmax);
+			for (; l < lend; ++l) {
+				const vect_t a = simd::loadu(Ai+l*S.csA);
+				const typename Field::Element* Bl = Bj+l*S.rsB;
+				for (size_t jj = 0; jj < NJ; ++jj)
+					c[jj] = simd::fmadd(c[jj], a, simd::loadu(Bl+jj*S.csB));
+			}
+			for (size_t jj = 0; jj < NJ; ++jj)
+				vectorised::VEC_MOD<Field,simd,0>(c[jj],H);
+		}
+		const bool scaleOut = !F.isOne(alpha);
+		const bool addC = !F.isZero(beta);
+		for (size_t jj = 0; jj < NJ; ++jj) {
+			if (scaleOut) {
+				c[jj] = simd::mul(c[jj], simd::set1(alpha));
+				vectorised::VEC_MOD<Field,simd,0>(c[jj],H);
+			}
+			if (addC) {
+				c[jj] = simd::fmadd(c[jj], simd::set1(beta), simd::loadu(Cij+jj*S.inc));
+				vectorised::VEC_MOD<Field,simd,0>(c[jj],H);
+			}
+			simd::storeu(Cij+jj*S.inc, c[jj]);
+		}
+	}
+
+	/** \internal
+	 * SIMD part of gemm_interleaved: full vectors of lanes of \f$[0,nb[\f$,
+	 * returns the number of lanes done.
+	 */
+	template<class Field>
+	inline size_t gemm_interleaved_simd (const Field& F, const size_t m, const size_t n, const size_t k,
+					     const typename Field::Element alpha,
+					     const typename Field::Element* A, const typename Field::Element* B,
+					     const typename Field::Element beta, typename Field::Element* C,
+					     const Strides& S, const size_t nb, const size_t kmax, std::true_type)
+	{
+		typedef BatchTraits<Field> BT;
+		vectorised::HelperModSimd<Field, typename BT::simd> H(F);
+		size_t b = 0;
+		for (; b+BT::vect_size <= nb; b += BT::vect_size)
+			for (size_t i = 0; i < m; ++i) {
+				size_t j = 0;
+				for (; j+4 <= n; j += 4)
+					gemm_simd_block<4>(F, k, alpha, A+i*S.rsA+b, B+j*S.csB+b, beta,
+							   C+i*S.ldc+j*S.inc+b, S, kmax, H);
+				for (; j < n; ++j)
+					gemm_simd_block<1>(F, k, alpha, A+i*S.rsA+b, B+j*S.csB+b, beta,
+							   C+i*S.ldc+j*S.inc+b, S, kmax, H);
+			}
+		return b;
+	}
+#endif
+
+	template<class Field>
+	inline size_t gemm_interleaved_simd (const Field&, const size_t, const size_t, const size_t,
+					     const typename Field::Element,
+					     const typename Field::Element*, const typename Field::Element*,
+					     const typename Field::Element, typename Field::Element*,
+					     const Strides&, const size_t, const size_t, std::false_type)
+	{
+		return 0;
+	}
+
+	/** \internal
+	 * \f$C_b \gets \alpha \mathrm{op}(A_b) \mathrm{op}(B_b) + \beta C_b\f$ for the
+	 * lanes \f$b \in [0,nb[\f$ of interleaved operands.
+	 * Full SIMD vectors of lanes go through gemm_simd_block, the remaining lanes
+	 * through gemm_lane.
+	 */
+	template<class Field>
+	inline void gemm_interleaved (const Field& F, const size_t m, const size_t n, const size_t k,
+				      const typename Field::Element alpha,
+				      const typename Field::Element* A, const typename Field::Element* B,
+				      const typename Field::Element beta, typename Field::Element* C,
+				      const Strides& S, const size_t nb, const size_t kmax)
+	{
+		size_t b = 0;
+		if (kmax)
+			b = gemm_interleaved_simd(F, m, n, k, alpha, A, B, beta, C, S, nb, kmax,
+						  std::integral_constant<bool, BatchTraits<Field>::vectorised>());
+		for (; b < nb; ++b)
+			gemm_lane(F, m, n, k, alpha, A+b, B+b, beta, C+b, S);
+	}
+
+	/** \internal
+	 * Products of the matrices \f$[first,last[\f$ of pointer arrays, by
+	 * interleaved groups of \c vect_size matrices.
+	 */
+	template<class Field>
+	inline void gemm_range (const Field& F, const FFLAS_TRANSPOSE ta, const FFLAS_TRANSPOSE tb,
+				const size_t m, const size_t n, const size_t k,
+				const typename Field::Element alpha,
+				const typename Field::ConstElement_ptr* A, const size_t lda,
+				const typename Field::ConstElement_ptr* B, const size_t ldb,
+				const typename Field::Element beta,
+				const typename Field::Element_ptr* C, const size_t ldc,
+				const size_t first, const size_t last, const size_t kmax)
+	{
+		typedef typename Field::Element Element;
+		const size_t G = BatchTraits<Field>::vect_size;
+		const size_t rA = (ta == FflasNoTrans) ? m : k, cA = (ta == FflasNoTrans) ? k : m;
+		const size_t rB = (tb == FflasNoTrans) ? k : n, cB = (tb == FflasNoTrans) ? n : k;
+		const bool addC = !F.isZero(beta);
+		Element* WA = fflas_new<Element>(rA*cA*G, Alignment::CACHE_LINE);
+		Element* WB = fflas_new<Element>(rB*cB*G, Alignment::CACHE_LINE);
+		Element* WC = fflas_new<Element>(m*n*G, Alignment::CACHE_LINE);
+		// the lanes of the last group past the end of the batch are computed and discarded
+		for (size_t i = 0; i < rA*cA*G; ++i) F.assign(WA[i], F.zero);
+		for (size_t i = 0; i < rB*cB*G; ++i) F.assign(WB[i], F.zero);
+		for (size_t i = 0; i < m*n*G; ++i) F.assign(WC[i], F.zero);
+		const Strides S(ta, tb, cA, cB, n, G);
+
+		for (size_t b0 = first; b0 < last; b0 += G) {
+			const size_t nb = std::min(G, last-b0);
+			interleave<Element>(WA, G, A+b0, nb, rA, cA, lda);
+			interleave<Element>(WB, G, B+b0, nb, rB, cB, ldb);
+			if (addC)
+				interleave<Element>(WC, G, C+b0, nb, m, n, ldc);
+			gemm_interleaved(F, m, n, k, alpha, WA, WB, beta, WC, S, G, kmax);
+			deinterleave<Element>(C+b0, nb, m, n, ldc, WC, G);
+		}
+		fflas_delete(WA, WB, WC);
+	}
+
+	/** \internal
+	 * Products of the matrices \f$[first,last[\f$ of pointer arrays, one
+	 * classical fgemm each.  The helper \p H0 is copied, not recomputed.
+	 */
+	template<class Field, class Helper>
+	inline void gemm_range_each (const Field& F, const FFLAS_TRANSPOSE ta, const FFLAS_TRANSPOSE tb,
+				     const size_t m, const size_t n, const size_t k,
+				     const typename Field::Element alpha,
+				     const typename Field::ConstElement_ptr* A, const size_t lda,
+				     const typename Field::ConstElement_ptr* B, const size_t ldb,
+				     const typename Field::Element beta,
+				     const typename Field::Element_ptr* C, const size_t ldc,
+				     const size_t first, const size_t last, const Helper& H0)
+	{
+		for (size_t b = first; b < last; ++b) {
+			Helper H(H0);
+			fgemm(F, ta, tb, m, n, k, alpha, A[b], lda, B[b], ldb, beta, C[b], ldc, H);
+		}
+	}
+
+} // batched
+} // Protected
+} // FFLAS
+
+namespace FFLAS {
+
+	/** @brief fgemm_batched: products of a batch of small matrices, pointer array variant.
+	 *
+	 * Computes \f$C_b \gets \alpha \mathrm{op}(A_b) \mathrm{op}(B_b) + \beta C_b\f$
+	 * for \f$0 \leq b < \f$ \p batchCount, where the matrices \f$A_b\f$, \f$B_b\f$
+	 * and \f$C_b\f$ are pointed to by <code>A[b]</code>, <code>B[b]</code> and <code>C[b]</code>.
+	 * All the matrices of the batch share the same dimensions and leading dimensions,
+	 * the inputs are reduced and the \f$C_b\f$ must not overlap.
+	 * \param psH ParSeqHelper::Sequential, or ParSeqHelper::Parallel to distribute the batch over threads.
+	 */
+	template<class Field, class PSHelper>
+	inline void
+	fgemm_batched (const Field& F,
+		       const FFLAS_TRANSPOSE ta,
+		       const FFLAS_TRANSPOSE tb,
+		       const size_t m, const size_t n, const size_t k,
+		       const typename Field::Element alpha,
+		       const typename Field::ConstElement_ptr* A, const size_t lda,
+		       const typename Field::ConstElement_ptr* B, const size_t ldb,
+		       const typename Field::Element beta,
+		       const typename Field::Element_ptr* C, const size_t ldc,
+		       const size_t batchCount, const PSHelper& psH)
+	{
+		if (!m || !n || !batchCount) return;
+		if (!k || F.isZero(alpha)) {
+			for (size_t b = 0; b < batchCount; ++b)
+				fscalin(F, m, n, beta, C[b], ldc);
+			return;
+		}
+
+		typedef Protected::batched::BatchTraits<Field> BT;
+		const size_t kmax = Protected::batched::MaxDelayedProducts(F);
+		if (BT::vectorised && kmax) {
+			const size_t G = BT::vect_size;
+			const size_t ngroups = (batchCount+G-1)/G;
+			auto range = [&](size_t g0, size_t g1) {
+				Protected::batched::gemm_range(F, ta, tb, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc,
+							       g0*G, std::min(g1*G, batchCount), kmax);
+			};
+			Protected::batched::forGroups(ngroups, range, psH);
+		} else {
+			// no Winograd level on such small matrices
+			const MMHelper<Field, MMHelperAlgo::Winograd> H0(F, 0, ParSeqHelper::Sequential());
+			auto range = [&](size_t b0, size_t b1) {
+				Protected::batched::gemm_range_each(F, ta, tb, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc,
+								    b0, b1, H0);
+			};
+			Protected::batched::forGroups(batchCount, range, psH);
+		}
+	}
+
+	template<class Field>
+	inline void
+	fgemm_batched (const Field& F,
+		       const FFLAS_TRANSPOSE ta,
+		       const FFLAS_TRANSPOSE tb,
+		       const size_t m, const size_t n, const size_t k,
+		       const typename Field::Element alpha,
+		       const typename Field::ConstElement_ptr* A, const size_t lda,
+		       const typename Field::ConstElement_ptr* B, const size_t ldb,
+		       const typename Field::Element beta,
+		       const typename Field::Element_ptr* C, const size_t ldc,
+		       const size_t batchCount)
+	{
+		fgemm_batched(F, ta, tb, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, batchCount,
+			      ParSeqHelper::Sequential());
+	}
+
+	/** @brief fgemm_batched: products of a batch of small matrices, strided variant.
+	 *
+	 * Same as the pointer array variant, with \f$A_b\f$ starting at <code>A+b*strideA</code>,
+	 * \f$B_b\f$ at <code>B+b*strideB</code> and \f$C_b\f$ at <code>C+b*strideC</code>.
+	 * A stride of 0 shares the same operand between all the products.
+	 */
+	template<class Field, class PSHelper>
+	inline typename Field::Element_ptr
+	fgemm_batched (const Field& F,
+		       const FFLAS_TRANSPOSE ta,
+		       const FFLAS_TRANSPOSE tb,
+		       const size_t m, const size_t n, const size_t k,
+		       const typename Field::Element alpha,
+		       typename Field::ConstElement_ptr A, const size_t lda, const size_t strideA,
+		       typename Field::ConstElement_ptr B, const size_t ldb, const size_t strideB,
+		       const typename Field::Element beta,
+		       typename Field::Element_ptr C, const size_t ldc, const size_t strideC,
+		       const size_t batchCount, const PSHelper& psH)
+	{
+		std::vector<typename Field::ConstElement_ptr> Ab(batchCount), Bb(batchCount);
+		std::vector<typename Field::Element_ptr> Cb(batchCount);
+		for (size_t b = 0; b < batchCount; ++b) {
+			Ab[b] = A+b*strideA;
+			Bb[b] = B+b*strideB;
+			Cb[b] = C+b*strideC;
+		}
+		fgemm_batched(F, ta, tb, m, n, k, alpha, Ab.data(), lda, Bb.data(), ldb, beta, Cb.data(), ldc,
+			      batchCount, psH);
+		return C;
+	}
+
+	template<class Field>
+	inline typename Field::Element_ptr
+	fgemm_batched (const Field& F,
+		       const FFLAS_TRANSPOSE ta,
+		       const FFLAS_TRANSPOSE tb,
+		       const size_t m, const size_t n, const size_t k,
+		       const typename Field::Element alpha,
+		       typename Field::ConstElement_ptr A, const size_t lda, const size_t strideA,
+		       typename Field::ConstElement_ptr B, const size_t ldb, const size_t strideB,
+		       const typename Field::Element beta,
+		       typename Field::Element_ptr C, const size_t ldc, const size_t strideC,
+		       const size_t batchCount)
+	{
+		return fgemm_batched(F, ta, tb, m, n, k, alpha, A, lda, strideA, B, ldb, strideB,
+				     beta, C, ldc, strideC, batchCount, ParSeqHelper::Sequential());
+	}
+
+	/** @brief fgemm_batched_interleaved: products of a batch of interleaved small matrices.
+	 *
+	 * Entry \f$(i,j)\f$ of the matrix \f$X_b\f$ of the batch is stored at
+	 * <code>X[(i*ldx+j)*batchCount+b]</code>: this is the layout used internally by
+	 * fgemm_batched, so that no copy is made.
+	 * \f$C_b \gets \alpha \mathrm{op}(A_b) \mathrm{op}(B_b) + \beta C_b\f$, the inputs are reduced.
+	 * \param psH ParSeqHelper::Sequential, or ParSeqHelper::Parallel to distribute the batch over threads.
+	 */
+	template<class Field, class PSHelper>
+	inline typename Field::Element_ptr
+	fgemm_batched_interleaved (const Field& F,
+				   const FFLAS_TRANSPOSE ta,
+				   const FFLAS_TRANSPOSE tb,
+				   const size_t m, const size_t n, const size_t k,
+				   const typename Field::Element alpha,
+				   typename Field::ConstElement_ptr A, const size_t lda,
+				   typename Field::ConstElement_ptr B, const size_t ldb,
+				   const typename Field::Element beta,
+				   typename Field::Element_ptr C, const size_t ldc,
+				   const size_t batchCount, const PSHelper& psH)
+	{
+		if (!m || !n || !batchCount) return C;
+		typedef Protected::batched::BatchTraits<Field> BT;
+		const size_t G = BT::vect_size;
+		const size_t kmax = Protected::batched::MaxDelayedProducts(F);
+		const Protected::batched::Strides S(ta, tb, lda, ldb, ldc, batchCount);
+		const size_t ngroups = (batchCount+G-1)/G;
+		auto range = [&](size_t g0, size_t g1) {
+			const size_t b0 = g0*G;
+			Protected::batched::gemm_interleaved(F, m, n, k, alpha, A+b0, B+b0, beta, C+b0, S,
+							     std::min(g1*G, batchCount)-b0, kmax);
+		};
+		Protected::batched::forGroups(ngroups, range, psH);
+		return C;
+	}
+
+	template<class Field>
+	inline typename Field::Element_ptr
+	fgemm_batched_interleaved (const Field& F,
+				   const FFLAS_TRANSPOSE ta,
+				   const FFLAS_TRANSPOSE tb,
+				   const size_t m, const size_t n, const size_t k,
+				   const typename Field::Element alpha,
+				   typename Field::ConstElement_ptr A, const size_t lda,
+				   typename Field::ConstElement_ptr B, const size_t ldb,
+				   const typename Field::Element beta,
+				   typename Field::Element_ptr C, const size_t ldc,
+				   const size_t batchCount)
+	{
+		return fgemm_batched_interleaved(F, ta, tb, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc,
+						 batchCount, ParSeqHelper::Sequential());
+	}
+
+} // FFLAS
+
+#endif // __FFLASFFPACK_fflas_fgemm_batched_INL
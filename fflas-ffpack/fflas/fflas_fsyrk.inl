@@ -0,0 +1,288 @@
+/* -*- mode: C++; tab-width: 8; indent-tabs-mode: t; c-basic-offset: 8 -*- */
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/*
+ * Copyright (C) 2016 the FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ *.
+ */
+
+/** @file fflas/fflas_fsyrk.inl
+ * @brief Symmetric rank k update: one triangle of \f$\alpha A A^T + \beta C\f$.
+ */
+
+#ifndef __FFLASFFPACK_fflas_fsyrk_INL
+#define __FFLASFFPACK_fflas_fsyrk_INL
+
+#include "fflas-ffpack/paladin/parallel.h"
+
+#ifndef __FFLASFFPACK_FSYRK_THRESHOLD
+//! dimension of C under which fsyrk computes a square block by fgemm
+#define __FFLASFFPACK_FSYRK_THRESHOLD 64
+#endif
+
+namespace FFLAS { namespace Protected {
+
+	//! UpLo triangle of C <- beta C
+	template<class Field>
+	inline void
+	fsyrk_scal (const Field& F, const FFLAS_UPLO UpLo, const size_t N,
+		    const typename Field::Element beta,
+		    typename Field::Element_ptr C, const size_t ldc)
+	{
+		if (F.isOne (beta)) return;
+		for (size_t i = 0; i < N; ++i)
+			if (UpLo == FflasLower)
+				fscalin (F, i+1, beta, C+i*ldc, 1);
+			else
+				fscalin (F, N-i, beta, C+i*(ldc+1), 1);
+	}
+
+	/* Base case: the N x N product goes to a temporary, of which only the
+	 * UpLo triangle is added to C.
+	 */
+	template<class Field>
+	inline void
+	fsyrk_base (const Field& F, const FFLAS_UPLO UpLo, const FFLAS_TRANSPOSE trans,
+		    const size_t N, const size_t K,
+		    const typename Field::Element alpha,
+		    typename Field::ConstElement_ptr A, const size_t lda,
+		    typename Field::ConstElement_ptr B, const size_t ldb,
+		    const typename Field::Element beta,
+		    typename Field::Element_ptr C, const size_t ldc)
+	{
+		const FFLAS_TRANSPOSE tb = (trans == FflasNoTrans) ? FflasTrans : FflasNoTrans;
+		typename Field::Element_ptr T = fflas_new (F, N, N);
+		fgemm (F, trans, tb, N, N, K, alpha, A, lda, B, ldb, F.zero, T, N);
+		fsyrk_scal (F, UpLo, N, beta, C, ldc);
+		for (size_t i = 0; i < N; ++i)
+			if (UpLo == FflasLower)
+				faddin (F, i+1, T+i*N, 1, C+i*ldc, 1);
+			else
+				faddin (F, N-i, T+i*(N+1), 1, C+i*(ldc+1), 1);
+		fflas_delete (T);
+	}
+
+	/* UpLo triangle of C <- alpha op(A) op(B)^T + beta C, where the product
+	 * op(A) op(B)^T is symmetric (B = A, or B = A D for a diagonal D). The
+	 * diagonal blocks are computed recursively and the off diagonal block by
+	 * fgemm, hence half of the multiplications of a product by fgemm, the
+	 * large off diagonal blocks using Strassen-Winograd's algorithm.
+	 */
+	template<class Field>
+	inline void
+	fsyrk_rec (const Field& F, const FFLAS_UPLO UpLo, const FFLAS_TRANSPOSE trans,
+		   const size_t N, const size_t K,
+		   const typename Field::Element alpha,
+		   typename Field::ConstElement_ptr A, const size_t lda,
+		   typename Field::ConstElement_ptr B, const size_t ldb,
+		   const typename Field::Element beta,
+		   typename Field::Element_ptr C, const size_t ldc,
+		   const ParSeqHelper::Sequential seq)
+	{
+		if (N <= __FFLASFFPACK_FSYRK_THRESHOLD)
+			return fsyrk_base (F, UpLo, trans, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
+
+		const size_t N1 = N >> 1;
+		const size_t N2 = N - N1;
+		const FFLAS_TRANSPOSE tb = (trans == FflasNoTrans) ? FflasTrans : FflasNoTrans;
+		// the rows N1.. of op(A) and op(B)
+		typename Field::ConstElement_ptr A2 = A + ((trans == FflasNoTrans) ? N1*lda : N1);
+		typename Field::ConstElement_ptr B2 = B + ((trans == FflasNoTrans) ? N1*ldb : N1);
+
+		fsyrk_rec (F, UpLo, trans, N1, K, alpha, A, lda, B, ldb, beta, C, ldc, seq);
+		if (UpLo == FflasLower)
+			fgemm (F, trans, tb, N2, N1, K, alpha, A2, lda, B, ldb, beta, C+N1*ldc, ldc, seq);
+		else
+			fgemm (F, trans, tb, N1, N2, K, alpha, A, lda, B2, ldb, beta, C+N1, ldc, seq);
+		fsyrk_rec (F, UpLo, trans, N2, K, alpha, A2, lda, B2, ldb, beta, C+N1*(ldc+1), ldc, seq);
+	}
+
+	/* The two diagonal blocks and the off diagonal block are independent
+	 * tasks: the fgemm, having twice as many operations as each of the
+	 * recursive calls, gets half of the threads.
+	 */
+	template<class Field, class Cut, class Param>
+	inline void
+	fsyrk_rec (const Field& F, const FFLAS_UPLO UpLo, const FFLAS_TRANSPOSE trans,
+		   const size_t N, const size_t K,
+		   const typename Field::Element alpha,
+		   typename Field::ConstElement_ptr A, const size_t lda,
+		   typename Field::ConstElement_ptr B, const size_t ldb,
+		   const typename Field::Element beta,
+		   typename Field::Element_ptr C, const size_t ldc,
+		   const ParSeqHelper::Parallel<Cut,Param> par)
+	{
+		const size_t nt = par.numthreads();
+		if (N <= __FFLASFFPACK_FSYRK_THRESHOLD || nt <= 1)
+			return fsyrk_rec (F, UpLo, trans, N, K, alpha, A, lda, B, ldb, beta, C, ldc,
+					  ParSeqHelper::Sequential());
+
+		const size_t N1 = N >> 1;
+		const size_t N2 = N - N1;
+		const FFLAS_TRANSPOSE tb = (trans == FflasNoTrans) ? FflasTrans : FflasNoTrans;
+		typename Field::ConstElement_ptr A2 = A + ((trans == FflasNoTrans) ? N1*lda : N1);
+		typename Field::ConstElement_ptr B2 = B + ((trans == FflasNoTrans) ? N1*ldb : N1);
+		typename Field::Element_ptr C2 = C + N1*(ldc+1);
+		typename Field::Element_ptr C3 = (UpLo == FflasLower) ? C + N1*ldc : C + N1;
+
+		ParSeqHelper::Parallel<Cut,Param> pdiag (std::max (nt/4, (size_t)1));
+		ParSeqHelper::Parallel<Cut,Param> poff (std::max (nt - 2*pdiag.numthreads(), (size_t)1));
+		SYNCH_GROUP(
+			TASK(MODE(CONSTREFERENCE(F, pdiag) READ(A[0], B[0]) READWRITE(C[0])),
+			     fsyrk_rec (F, UpLo, trans, N1, K, alpha, A, lda, B, ldb, beta, C, ldc, pdiag));
+			if (UpLo == FflasLower) {
+				TASK(MODE(CONSTREFERENCE(F, poff) READ(A2[0], B[0]) READWRITE(C3[0])),
+				     fgemm (F, trans, tb, N2, N1, K, alpha, A2, lda, B, ldb, beta, C3, ldc, poff));
+			} else {
+				TASK(MODE(CONSTREFERENCE(F, poff) READ(A[0], B2[0]) READWRITE(C3[0])),
+				     fgemm (F, trans, tb, N1, N2, K, alpha, A, lda, B2, ldb, beta, C3, ldc, poff));
+			}
+			TASK(MODE(CONSTREFERENCE(F, pdiag) READ(A2[0], B2[0]) READWRITE(C2[0])),
+			     fsyrk_rec (F, UpLo, trans, N2, K, alpha, A2, lda, B2, ldb, beta, C2, ldc, pdiag));
+			);
+	}
+
+	template<class Field, class PSHelper>
+	inline typename Field::Element_ptr
+	fsyrk (const Field& F, const FFLAS_UPLO UpLo, const FFLAS_TRANSPOSE trans,
+	       const size_t N, const size_t K,
+	       const typename Field::Element alpha,
+	       typename Field::ConstElement_ptr A, const size_t lda,
+	       typename Field::ConstElement_ptr D, const size_t incD,
+	       const typename Field::Element beta,
+	       typename Field::Element_ptr C, const size_t ldc,
+	       const PSHelper& psh)
+	{
+		if (!N) return C;
+		if (!K || F.isZero (alpha)) {
+			fsyrk_scal (F, UpLo, N, beta, C, ldc);
+			return C;
+		}
+		if (D == NULL) {
+			fsyrk_rec (F, UpLo, trans, N, K, alpha, A, lda, A, lda, beta, C, ldc, psh);
+			return C;
+		}
+		// B = op(A) D, stored as A
+		typename Field::Element_ptr B;
+		size_t ldb;
+		if (trans == FflasNoTrans) {
+			B = fflas_new (F, N, K);
+			ldb = K;
+			for (size_t k = 0; k < K; ++k)
+				fscal (F, N, D[k*incD], A+k, lda, B+k, ldb);
+		} else {
+			B = fflas_new (F, K, N);
+			ldb = N;
+			for (size_t k = 0; k < K; ++k)
+				fscal (F, N, D[k*incD], A+k*lda, 1, B+k*ldb, 1);
+		}
+		fsyrk_rec (F, UpLo, trans, N, K, alpha, A, lda, B, ldb, beta, C, ldc, psh);
+		fflas_delete (B);
+		return C;
+	}
+
+} // Protected
+} // FFLAS
+
+namespace FFLAS {
+
+	template<class Field>
+	inline typename Field::Element_ptr
+	fsyrk (const Field& F, const FFLAS_UPLO UpLo, const FFLAS_TRANSPOSE trans,
+	       const size_t N, const size_t K,
+	       const typename Field::Element alpha,
+	       typename Field::ConstElement_ptr A, const size_t lda,
+	       const typename Field::Element beta,
+	       typename Field::Element_ptr C, const size_t ldc)
+	{
+		return fsyrk (F, UpLo, trans, N, K, alpha, A, lda, beta, C, ldc, ParSeqHelper::Sequential());
+	}
+
+	template<class Field>
+	inline typename Field::Element_ptr
+	fsyrk (const Field& F, const FFLAS_UPLO UpLo, const FFLAS_TRANSPOSE trans,
+	       const size_t N, const size_t K,
+	       const typename Field::Element alpha,
+	       typename Field::ConstElement_ptr A, const size_t lda,
+	       const typename Field::Element beta,
+	       typename Field::Element_ptr C, const size_t ldc,
+	       const ParSeqHelper::Sequential seq)
+	{
+		return Protected::fsyrk (F, UpLo, trans, N, K, alpha, A, lda, NULL, 0, beta, C, ldc, seq);
+	}
+
+	template<class Field, class Cut, class Param>
+	inline typename Field::Element_ptr
+	fsyrk (const Field& F, const FFLAS_UPLO UpLo, const FFLAS_TRANSPOSE trans,
+	       const size_t N, const size_t K,
+	       const typename Field::Element alpha,
+	       typename Field::ConstElement_ptr A, const size_t lda,
+	       const typename Field::Element beta,
+	       typename Field::Element_ptr C, const size_t ldc,
+	       const ParSeqHelper::Parallel<Cut,Param> par)
+	{
+		return Protected::fsyrk (F, UpLo, trans, N, K, alpha, A, lda, NULL, 0, beta, C, ldc, par);
+	}
+
+	template<class Field>
+	inline typename Field::Element_ptr
+	fsyrk (const Field& F, const FFLAS_UPLO UpLo, const FFLAS_TRANSPOSE trans,
+	       const size_t N, const size_t K,
+	       const typename Field::Element alpha,
+	       typename Field::ConstElement_ptr A, const size_t lda,
+	       typename Field::ConstElement_ptr D, const size_t incD,
+	       const typename Field::Element beta,
+	       typename Field::Element_ptr C, const size_t ldc)
+	{
+		return Protected::fsyrk (F, UpLo, trans, N, K, alpha, A, lda, D, incD, beta, C, ldc,
+					 ParSeqHelper::Sequential());
+	}
+
+	template<class Field>
+	inline typename Field::Element_ptr
+	fsyrk (const Field& F, const FFLAS_UPLO UpLo, const FFLAS_TRANSPOSE trans,
+	       const size_t N, const size_t K,
+	       const typename Field::Element alpha,
+	       typename Field::ConstElement_ptr A, const size_t lda,
+	       typename Field::ConstElement_ptr D, const size_t incD,
+	       const typename Field::Element beta,
+	       typename Field::Element_ptr C, const size_t ldc,
+	       const ParSeqHelper::Sequential seq)
+	{
+		return Protected::fsyrk (F, UpLo, trans, N, K, alpha, A, lda, D, incD, beta, C, ldc, seq);
+	}
+
+	template<class Field, class Cut, class Param>
+	inline typename Field::Element_ptr
+	fsyrk (const Field& F, const FFLAS_UPLO UpLo, const FFLAS_TRANSPOSE trans,
+	       const size_t N, const size_t K,
+	       const typename Field::Element alpha,
+	       typename Field::ConstElement_ptr A, const size_t lda,
+	       typename Field::ConstElement_ptr D, const size_t incD,
+	       const typename Field::Element beta,
+	       typename Field::Element_ptr C, const size_t ldc,
+	       const ParSeqHelper::Parallel<Cut,Param> par)
+	{
+		return Protected::fsyrk (F, UpLo, trans, N, K, alpha, A, lda, D, incD, beta, C, ldc, par);
+	}
+
+} // FFLAS
+
+#endif // __FFLASFFPACK_fflas_fsyrk_INL
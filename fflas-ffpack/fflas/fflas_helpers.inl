@@ -36,6 +36,7 @@
 #include "fflas-ffpack/field/field-traits.h"
 #include "fflas-ffpack/paladin/parallel.h"
 #include "fflas-ffpack/utils/flimits.h"
+#include "fflas-ffpack/utils/fflas_workspace.h"
 
 #include <algorithm> // std::max
 
@@ -59,6 +60,18 @@ namespace FFLAS {
 		inline bool unfit(int64_t x){return (x>limits<int32_t>::max());}
 		template <size_t K>
 		inline bool unfit(RecInt::rint<K> x){return (x > RecInt::rint<K>(limits<RecInt::rint<K-1>>::max()));}
+
+		/*! Workspace to be inherited by a copy of the helper \p WH.
+		 * The arena is a stack: it is not handed over from a parallel helper,
+		 * whose copies run concurrently, nor from helpers without one.
+		 */
+		template <class PS, class MMH>
+		inline auto attachedWorkspace(const MMH& WH, int) -> decltype((void)WH.workspace, (MMWorkspace*)nullptr)
+		{
+			return std::is_same<PS, ParSeqHelper::Sequential>::value ? WH.workspace : nullptr;
+		}
+		template <class PS, class MMH>
+		inline MMWorkspace* attachedWorkspace(const MMH&, long) {return nullptr;}
 	}
 
 	namespace MMHelperAlgo{
@@ -67,6 +80,8 @@ namespace FFLAS {
 		struct Winograd{};
 		struct WinogradPar{};
 		struct Bini{};
+		struct Packed{};
+		struct EarlyTerm{};
 	}
 
 	template<class Field,
@@ -84,14 +99,16 @@ namespace FFLAS {
 		typedef MMHelper<Field,AlgoTrait, ModeCategories::DefaultTag,ParSeqTrait> Self_t;
 		int recLevel ;
 		ParSeqTrait parseq;
+		MMWorkspace * workspace;
 
-		MMHelper(){}
-		MMHelper(const Field& F, size_t m, size_t k, size_t n, ParSeqTrait _PS) : recLevel(-1), parseq(_PS) {}
-		MMHelper(const Field& F, int w, ParSeqTrait _PS=ParSeqTrait()) : recLevel(w), parseq(_PS) {}
+		MMHelper() : workspace(nullptr) {}
+		MMHelper(const Field& F, size_t m, size_t k, size_t n, ParSeqTrait _PS) : recLevel(-1), parseq(_PS), workspace(nullptr) {}
+		MMHelper(const Field& F, int w, ParSeqTrait _PS=ParSeqTrait()) : recLevel(w), parseq(_PS), workspace(nullptr) {}
 
 		// copy constructor from other Field and Algo Traits
 		template<class F2, typename AlgoT2, typename FT2, typename PS2>
-		MMHelper(MMHelper<F2, AlgoT2, FT2, PS2>& WH) : recLevel(WH.recLevel), parseq(WH.parseq) {}
+		MMHelper(MMHelper<F2, AlgoT2, FT2, PS2>& WH) : recLevel(WH.recLevel), parseq(WH.parseq),
+							       workspace(Protected::attachedWorkspace<PS2>(WH,0)) {}
 
 		friend std::ostream& operator<<(std::ostream& out, const Self_t& M)
 		{
@@ -111,14 +128,16 @@ namespace FFLAS {
 		typedef MMHelper<Field,AlgoTrait, ModeCategories::ConvertTo<Dest>,ParSeqTrait> Self_t;
 		int recLevel ;
 		ParSeqTrait parseq;
+		MMWorkspace * workspace;
 
-		MMHelper(){}
-		MMHelper(const Field& F, size_t m, size_t k, size_t n, ParSeqTrait _PS) : recLevel(-1), parseq(_PS) {}
-		MMHelper(const Field& F, int w, ParSeqTrait _PS=ParSeqTrait()) : recLevel(w), parseq(_PS) {}
+		MMHelper() : workspace(nullptr) {}
+		MMHelper(const Field& F, size_t m, size_t k, size_t n, ParSeqTrait _PS) : recLevel(-1), parseq(_PS), workspace(nullptr) {}
+		MMHelper(const Field& F, int w, ParSeqTrait _PS=ParSeqTrait()) : recLevel(w), parseq(_PS), workspace(nullptr) {}
 
 		// copy constructor from other Field and Algo Traits
 		template<class F2, typename AlgoT2, typename FT2, typename PS2>
-		MMHelper(MMHelper<F2, AlgoT2, FT2, PS2>& WH) : recLevel(WH.recLevel), parseq(WH.parseq) {}
+		MMHelper(MMHelper<F2, AlgoT2, FT2, PS2>& WH) : recLevel(WH.recLevel), parseq(WH.parseq),
+							       workspace(Protected::attachedWorkspace<PS2>(WH,0)) {}
 
 		friend std::ostream& operator<<(std::ostream& out, const Self_t& M)
 		{
@@ -145,6 +164,8 @@ namespace FFLAS {
 	
 		const DelayedField_t delayedField;
 		ParSeqTrait parseq;
+		//! optional arena for the temporaries of the Winograd schedules (not owned)
+		MMWorkspace * workspace;
 		void initC(){Cmin = FieldMin; Cmax = FieldMax;}
 		void initA(){Amin = FieldMin; Amax = FieldMax;}
 		void initB(){Bmin = FieldMin; Bmax = FieldMax;}
@@ -229,7 +250,7 @@ namespace FFLAS {
 			return true;
 		}
 
-		MMHelper(){}
+		MMHelper() : workspace(nullptr) {}
 		//TODO: delayedField constructor has a >0 characteristic even when it is a Double/FloatDomain
 		// correct but semantically not satisfactory
 		MMHelper(const Field& F, size_t m, size_t k, size_t n, ParSeqTrait _PS) :
@@ -242,7 +263,7 @@ namespace FFLAS {
 			MaxStorableValue ((DFElt)(limits<typename DelayedField::Element>::max())),
 			delayedField(F),
 			// delayedField((typename Field::Element)F.characteristic()),
-			parseq(_PS)
+			parseq(_PS), workspace(nullptr)
 		{
 		}
 
@@ -255,7 +276,7 @@ namespace FFLAS {
 			Outmin(0), Outmax(0),
 			MaxStorableValue ((DFElt)(limits<typename DelayedField::Element>::max())),
 			delayedField(F),
-			parseq(_PS)
+			parseq(_PS), workspace(nullptr)
 	        {
 		}
 
@@ -270,7 +291,8 @@ namespace FFLAS {
 			Outmin(WH.Outmin), Outmax(WH.Outmax),
 			MaxStorableValue(WH.MaxStorableValue),
 			delayedField(WH.delayedField),
-			parseq(WH.parseq)
+			parseq(WH.parseq),
+			workspace(Protected::attachedWorkspace<PS2>(WH,0))
 		{
 		}
 
@@ -286,7 +308,7 @@ namespace FFLAS {
 			Outmin(0),Outmax(0),
 			MaxStorableValue(limits<typename DelayedField::Element>::max()),
 			delayedField(F),
-            parseq(_PS)
+            parseq(_PS), workspace(nullptr)
 		{
 		}
 
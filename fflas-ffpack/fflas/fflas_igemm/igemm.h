@@ -92,5 +92,6 @@ namespace FFLAS { /*  igemm */
 #if defined(__AVX2__) or defined(__AVX__) or defined(__SSE4_1__)
 #include "igemm.inl"
 #endif
+#include "igemm_mod52.inl"
 #endif // __FFLASFFPACK_fflas_igemm_igemm_H
 
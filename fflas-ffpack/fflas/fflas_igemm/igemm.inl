@@ -70,7 +70,7 @@ namespace FFLAS { namespace Protected {
 			    int64_t* C, size_t ldc)
 	{
 
-		using simd = Simd<int64_t> ;
+		using simd = FFLAS::details::igemm_simd ;
 		size_t mc,kc,nc;
 		mc=rows;
 		nc=cols;
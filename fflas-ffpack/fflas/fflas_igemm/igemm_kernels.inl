@@ -61,7 +61,7 @@ namespace FFLAS { namespace details { /*  kernels */
 			    , int64_t* C, size_t ldc
 			   )
 	{
-		using simd = Simd<int64_t>;
+		using simd = FFLAS::details::igemm_simd;
 		using vect_t =  typename simd::vect_t;
 		size_t k;
 		vect_t C0,C1,C2,C3,C4,C5,C6,C7;
@@ -231,7 +231,7 @@ namespace FFLAS { namespace details { /*  kernels */
 			    , int64_t* C, size_t ldc
 			   )
 	{
-		using simd = Simd<int64_t>;
+		using simd = FFLAS::details::igemm_simd;
 		using vect_t =  typename simd::vect_t;
 
 		//cout<<"aligned 32:"<< int64_t( blA)% 32 <<endl;
@@ -386,7 +386,7 @@ namespace FFLAS { namespace details { /*  kernels */
 			    , int64_t* C, size_t ldc
 			   )
 	{
-		using simd = Simd<int64_t>;
+		using simd = FFLAS::details::igemm_simd;
 		using vect_t =  typename simd::vect_t;
 
 		size_t k;
@@ -437,7 +437,7 @@ namespace FFLAS { namespace details { /*  kernels */
 			    , int64_t* C, size_t ldc
 			   )
 	{
-		using simd = Simd<int64_t>;
+		using simd = FFLAS::details::igemm_simd;
 		using vect_t =  typename simd::vect_t;
 
 		size_t k;
@@ -510,7 +510,7 @@ namespace FFLAS { namespace details { /*  main */
 		    int64_t* C, size_t ldc,
 		    int64_t* blockW)
 	{
-		using simd = Simd<int64_t>;
+		using simd = FFLAS::details::igemm_simd;
 		// using vect_t =  typename simd::vect_t;
 		size_t i,j;
 		size_t prows,pcols,pdepth;
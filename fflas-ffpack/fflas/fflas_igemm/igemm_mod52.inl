@@ -0,0 +1,288 @@
+/* -*- mode: C++; tab-width: 8; indent-tabs-mode: t; c-basic-offset: 8 -*- */
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/*
+ * Copyright (C) 2016 the FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ *.
+ */
+
+/** @file fflas_igemm/igemm_mod52.inl
+ * @brief igemm modulo a prime \f$p < 2^{50}\f$.
+ *
+ * Each product of two residues is split in its low and high 52 bits, which
+ * are accumulated separately in 64 bits words (\c vpmadd52luq and
+ * \c vpmadd52huq with AVX-512 IFMA, an exact scalar emulation otherwise).
+ * Up to \c _kc52 products can be accumulated without overflow; the
+ * \f$104\f$ bits result is then reduced modulo \f$p\f$ once per \c kc block.
+ */
+
+#ifndef __FFLASFFPACK_fflas_igemm_igemm_mod52_INL
+#define __FFLASFFPACK_fflas_igemm_igemm_mod52_INL
+
+#ifdef __x86_64__
+
+#define __FFLASFFPACK_HAVE_IGEMM52 1
+
+#include "fflas-ffpack/utils/fflas_memory.h"
+#if defined(__AVX512IFMA__)
+#include <immintrin.h>
+#endif
+
+namespace FFLAS { namespace details { /*  52 bits kernels */
+
+	//! largest modulus supported by igemm_ with a modulus
+	const uint64_t igemm52_maxmod = (uint64_t)1 << 50 ;
+	const uint64_t mask52 = ((uint64_t)1 << 52) - 1 ;
+	//! whether the kernel runs on vpmadd52 rather than on its scalar emulation
+#if defined(__AVX512IFMA__)
+	const bool igemm52_vectorised = true ;
+#else
+	const bool igemm52_vectorised = false ;
+#endif
+
+	// register tile: _mr52 rows (one 512 bits register) times _nr52 columns
+	const size_t _mr52 = 8 ;
+	const size_t _nr52 = 4 ;
+	// at most 2^12 low halves fit in 64 bits
+	const size_t _kc52 = 1024 ;
+
+	//! \f$c + (ab \bmod 2^{52})\f$, as vpmadd52luq
+	inline uint64_t madd52lo(const uint64_t c, const uint64_t a, const uint64_t b)
+	{
+		return c + ((uint64_t)((uint128_t)(a & mask52) * (b & mask52)) & mask52);
+	}
+
+	//! \f$c + \lfloor ab / 2^{52} \rfloor\f$, as vpmadd52huq
+	inline uint64_t madd52hi(const uint64_t c, const uint64_t a, const uint64_t b)
+	{
+		return c + (uint64_t)(((uint128_t)(a & mask52) * (b & mask52)) >> 52);
+	}
+
+	// residues of the entries in (-p,p) are mapped to [0,p)
+	inline uint64_t normalize52(const int64_t x, const int64_t p)
+	{
+		return (uint64_t)((x < 0) ? x + p : x);
+	}
+
+	// pack rows [0,mc) of op(A) in slivers of _mr52 rows, A in column major
+	template<enum FFLAS_TRANSPOSE tA>
+	void pack_lhs52(uint64_t* XX, const int64_t* X, size_t ldx, size_t mc, size_t kc, int64_t p)
+	{
+		for (size_t i = 0; i < mc; i += _mr52) {
+			const size_t mr = std::min(_mr52, mc-i);
+			for (size_t l = 0; l < kc; ++l) {
+				size_t r = 0;
+				for (; r < mr; ++r)
+					*XX++ = normalize52((tA == FflasNoTrans) ? X[i+r+l*ldx] : X[l+(i+r)*ldx], p);
+				for (; r < _mr52; ++r)
+					*XX++ = 0;
+			}
+		}
+	}
+
+	// pack columns [0,nc) of op(B) in slivers of _nr52 columns, B in column major
+	template<enum FFLAS_TRANSPOSE tB>
+	void pack_rhs52(uint64_t* XX, const int64_t* X, size_t ldx, size_t kc, size_t nc, int64_t p)
+	{
+		for (size_t j = 0; j < nc; j += _nr52) {
+			const size_t nr = std::min(_nr52, nc-j);
+			for (size_t l = 0; l < kc; ++l) {
+				size_t c = 0;
+				for (; c < nr; ++c)
+					*XX++ = normalize52((tB == FflasNoTrans) ? X[l+(j+c)*ldx] : X[j+c+l*ldx], p);
+				for (; c < _nr52; ++c)
+					*XX++ = 0;
+			}
+		}
+	}
+
+	// lo, hi <- low and high 52 bits halves of the _mr52 x _nr52 tile of A.B
+	inline void igemm52_kernel(size_t kc, const uint64_t* blockA, const uint64_t* blockB,
+				   uint64_t* lo, uint64_t* hi)
+	{
+#if defined(__AVX512IFMA__)
+		__m512i L0, L1, L2, L3, H0, H1, H2, H3, a, b;
+		L0 = L1 = L2 = L3 = H0 = H1 = H2 = H3 = _mm512_setzero_si512();
+		for (size_t l = 0; l < kc; ++l, blockA += _mr52, blockB += _nr52) {
+			a = _mm512_load_si512((const void*)blockA);
+			b = _mm512_set1_epi64((long long)blockB[0]);
+			L0 = _mm512_madd52lo_epu64(L0, a, b); H0 = _mm512_madd52hi_epu64(H0, a, b);
+			b = _mm512_set1_epi64((long long)blockB[1]);
+			L1 = _mm512_madd52lo_epu64(L1, a, b); H1 = _mm512_madd52hi_epu64(H1, a, b);
+			b = _mm512_set1_epi64((long long)blockB[2]);
+			L2 = _mm512_madd52lo_epu64(L2, a, b); H2 = _mm512_madd52hi_epu64(H2, a, b);
+			b = _mm512_set1_epi64((long long)blockB[3]);
+			L3 = _mm512_madd52lo_epu64(L3, a, b); H3 = _mm512_madd52hi_epu64(H3, a, b);
+		}
+		_mm512_store_si512((void*)(lo),         L0); _mm512_store_si512((void*)(hi),         H0);
+		_mm512_store_si512((void*)(lo+_mr52),   L1); _mm512_store_si512((void*)(hi+_mr52),   H1);
+		_mm512_store_si512((void*)(lo+2*_mr52), L2); _mm512_store_si512((void*)(hi+2*_mr52), H2);
+		_mm512_store_si512((void*)(lo+3*_mr52), L3); _mm512_store_si512((void*)(hi+3*_mr52), H3);
+#else
+		for (size_t t = 0; t < _mr52*_nr52; ++t)
+			lo[t] = hi[t] = 0;
+		for (size_t l = 0; l < kc; ++l, blockA += _mr52, blockB += _nr52)
+			for (size_t c = 0; c < _nr52; ++c)
+				for (size_t r = 0; r < _mr52; ++r) {
+					lo[c*_mr52+r] = madd52lo(lo[c*_mr52+r], blockA[r], blockB[c]);
+					hi[c*_mr52+r] = madd52hi(hi[c*_mr52+r], blockA[r], blockB[c]);
+				}
+#endif
+	}
+
+	// C <- C + alpha (hi.2^52 + lo) mod p, on the mr x nr upper left part of the tile
+	inline void igemm52_writeback(size_t mr, size_t nr, const uint64_t* lo, const uint64_t* hi,
+				      const uint64_t alpha, const uint64_t p, int64_t* C, size_t ldc)
+	{
+		for (size_t c = 0; c < nr; ++c)
+			for (size_t r = 0; r < mr; ++r) {
+				uint64_t t = (uint64_t)((((uint128_t)hi[c*_mr52+r] << 52) + lo[c*_mr52+r]) % p);
+				if (alpha != 1)
+					t = (uint64_t)(((uint128_t)t * alpha) % p);
+				t += (uint64_t)C[r+c*ldc];
+				C[r+c*ldc] = (int64_t)((t >= p) ? t - p : t);
+			}
+	}
+
+} // details
+} // FFLAS
+
+namespace FFLAS { namespace Protected {
+
+	// Assume matrices A,B,C are stored in column major order
+	template<enum FFLAS_TRANSPOSE tA, enum FFLAS_TRANSPOSE tB>
+	void igemm52_colmajor(size_t rows, size_t cols, size_t depth,
+			      const uint64_t alpha,
+			      const int64_t* A, size_t lda, const int64_t* B, size_t ldb,
+			      int64_t* C, size_t ldc, const uint64_t p)
+	{
+		using namespace FFLAS::details;
+		size_t kc = std::min(depth, _kc52);
+		size_t mc, nc;
+		int l1, l2, l3;
+		queryCacheSizes(l1,l2,l3);
+		if (l2 <= 0) l2 = 256*1024;
+		l3 = std::max(l2,l3);
+		mc = std::max((size_t)l2/(2*kc*sizeof(uint64_t)), _mr52);
+		mc = std::min(rows, mc - mc % _mr52);
+		nc = std::max((size_t)l3/(2*kc*sizeof(uint64_t)), _nr52);
+		nc = std::min(cols, nc - nc % _nr52);
+
+		uint64_t *blockA, *blockB, *lo, *hi;
+		blockA = fflas_new<uint64_t>((mc+_mr52)*kc, Alignment::CACHE_LINE);
+		blockB = fflas_new<uint64_t>((nc+_nr52)*kc, Alignment::CACHE_LINE);
+		lo = fflas_new<uint64_t>(_mr52*_nr52, Alignment::CACHE_LINE);
+		hi = fflas_new<uint64_t>(_mr52*_nr52, Alignment::CACHE_LINE);
+
+		for (size_t j2 = 0; j2 < cols; j2 += nc) {
+			const size_t actual_nc = std::min(j2+nc,cols)-j2;
+			for (size_t k2 = 0; k2 < depth; k2 += kc) {
+				const size_t actual_kc = std::min(k2+kc,depth)-k2;
+				pack_rhs52<tB>(blockB, (tB == FflasNoTrans) ? B+k2+j2*ldb : B+j2+k2*ldb,
+					       ldb, actual_kc, actual_nc, (int64_t)p);
+				for (size_t i2 = 0; i2 < rows; i2 += mc) {
+					const size_t actual_mc = std::min(i2+mc,rows)-i2;
+					pack_lhs52<tA>(blockA, (tA == FflasNoTrans) ? A+i2+k2*lda : A+k2+i2*lda,
+						       lda, actual_mc, actual_kc, (int64_t)p);
+					for (size_t j = 0; j < actual_nc; j += _nr52)
+						for (size_t i = 0; i < actual_mc; i += _mr52) {
+							igemm52_kernel(actual_kc, blockA+i*actual_kc, blockB+j*actual_kc, lo, hi);
+							igemm52_writeback(std::min(_mr52,actual_mc-i), std::min(_nr52,actual_nc-j),
+									  lo, hi, alpha, p, C+i2+i+(j2+j)*ldc, ldc);
+						}
+				}
+			}
+		}
+
+		fflas_delete(blockA);
+		fflas_delete(blockB);
+		fflas_delete(lo);
+		fflas_delete(hi);
+	}
+
+	inline void igemm52( const enum FFLAS_TRANSPOSE TransA, const enum FFLAS_TRANSPOSE TransB,
+			     size_t rows, size_t cols, size_t depth
+			     , const int64_t alpha
+			     , const int64_t* A, size_t lda, const int64_t* B, size_t ldb
+			     , const int64_t beta
+			     , int64_t* C, size_t ldc
+			     , const int64_t p
+			   )
+	{
+		FFLASFFPACK_check(p > 1 && (uint64_t)p < details::igemm52_maxmod);
+		if (!rows || !cols) {
+			return ;
+		}
+		const uint64_t up = (uint64_t)p;
+		const uint64_t alpha_ = details::normalize52(alpha % p, p);
+		const uint64_t beta_ = details::normalize52(beta % p, p);
+
+		// C <- beta C, with entries in [0,p)
+		for (size_t j = 0; j < cols; ++j)
+			for (size_t i = 0; i < rows; ++i) {
+				uint64_t c = details::normalize52(C[i+j*ldc] % p, p);
+				C[i+j*ldc] = (int64_t)(((uint128_t)c * beta_) % up);
+			}
+		if (!depth || !alpha_) {
+			return ;
+		}
+		if (TransA == FflasNoTrans) {
+			if (TransB == FflasNoTrans)
+				igemm52_colmajor<FflasNoTrans,FflasNoTrans>(rows, cols, depth, alpha_, A, lda, B, ldb, C, ldc, up);
+			else
+				igemm52_colmajor<FflasNoTrans,FflasTrans>(rows, cols, depth, alpha_, A, lda, B, ldb, C, ldc, up);
+		}
+		else {
+			if (TransB == FflasNoTrans)
+				igemm52_colmajor<FflasTrans,FflasNoTrans>(rows, cols, depth, alpha_, A, lda, B, ldb, C, ldc, up);
+			else
+				igemm52_colmajor<FflasTrans,FflasTrans>(rows, cols, depth, alpha_, A, lda, B, ldb, C, ldc, up);
+		}
+	}
+
+} // Protected
+} // FFLAS
+
+namespace FFLAS {
+
+	/** \f$C \gets \alpha op(A) op(B) + \beta C \bmod p\f$ for a modulus \f$1 < p < 2^{50}\f$.
+	 * Entries of \p A and \p B must lie in \f$(-p,p)\f$, \p C is arbitrary;
+	 * on output the entries of \p C are in \f$[0,p)\f$.
+	 */
+	inline void igemm_(const enum FFLAS_ORDER Order, const enum FFLAS_TRANSPOSE TransA, const enum FFLAS_TRANSPOSE TransB,
+			   const size_t M, const size_t N, const size_t K,
+			   const int64_t alpha,
+			   const int64_t *A, const size_t lda,
+			   const int64_t *B, const size_t ldb,
+			   const int64_t beta,
+			   int64_t *C, const size_t ldc,
+			   const int64_t p)
+	{
+		if (Order == FflasColMajor)
+			Protected::igemm52(TransA,TransB,M,N,K,alpha,A,lda,B,ldb,beta,C,ldc,p);
+		else
+			Protected::igemm52(TransB,TransA,N,M,K,alpha,B,ldb,A,lda,beta,C,ldc,p);
+	}
+
+} // FFLAS
+
+#endif // __x86_64__
+
+#endif // __FFLASFFPACK_fflas_igemm_igemm_mod52_INL
@@ -35,8 +35,17 @@
 /* TOOLS */
 /* ***** */
 
+#include "fflas-ffpack/fflas/fflas_simd.h"
+
 namespace FFLAS { namespace details { /*  tools */
 
+	// the kernels are written for 128 and 256 bits registers (see _mr, _nr, StepA)
+#ifdef __FFLASFFPACK_USE_AVX512F
+	using igemm_simd = Simd256<int64_t> ;
+#else
+	using igemm_simd = Simd<int64_t> ;
+#endif
+
 	// duplicate each entry into vector register
 	template<size_t N>
 	inline void duplicate_vect (int64_t* XX, const int64_t* X, size_t n){}
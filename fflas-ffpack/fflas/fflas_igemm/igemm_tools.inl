@@ -96,7 +96,7 @@ namespace FFLAS { namespace details {
 	template<size_t k, bool transpose>
 	void pack_lhs(int64_t* XX, const int64_t* X, size_t ldx, size_t rows, size_t cols)
 	{
-		using simd = Simd<int64_t> ;
+		using simd = FFLAS::details::igemm_simd ;
 		size_t p=0;
 		size_t rows_by_k=(rows/k)*k;
 		// pack rows by group of k
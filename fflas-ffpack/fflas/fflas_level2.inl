@@ -470,6 +470,52 @@ namespace FFLAS {
 	       const  typename Field::Element beta,
 	       typename Field::Element_ptr Y, const size_t incY);
 
+	/**  @brief fgemv with a ParSeqHelper.
+	 *
+	 * ParSeqHelper::Sequential is the sequential fgemv. With a
+	 * ParSeqHelper::Parallel, the rows of \f$\mathrm{op}(A)\f$ are cut in the
+	 * blocks of a ForStrategy1D and each block is a sequential fgemv, with its
+	 * own delayed reductions, writing its own entries of \p Y. Called outside
+	 * of a parallel region, the blocks are statically given to the threads,
+	 * so that a thread gets the same rows of \p A at each call.
+	 * Small products are sequential (see __FFLASFFPACK_SEQPARTHRESHOLD).
+	 * @param par the ParSeqHelper
+	 */
+	template<class Field>
+	typename Field::Element_ptr
+	fgemv (const Field& F, const FFLAS_TRANSPOSE TransA,
+	       const size_t M, const size_t N,
+	       const typename Field::Element alpha,
+	       typename Field::ConstElement_ptr A, const size_t lda,
+	       typename Field::ConstElement_ptr X, const size_t incX,
+	       const  typename Field::Element beta,
+	       typename Field::Element_ptr Y, const size_t incY,
+	       const ParSeqHelper::Sequential par);
+
+	template<class Field, class Cut, class Param>
+	typename Field::Element_ptr
+	fgemv (const Field& F, const FFLAS_TRANSPOSE TransA,
+	       const size_t M, const size_t N,
+	       const typename Field::Element alpha,
+	       typename Field::ConstElement_ptr A, const size_t lda,
+	       typename Field::ConstElement_ptr X, const size_t incX,
+	       const  typename Field::Element beta,
+	       typename Field::Element_ptr Y, const size_t incY,
+	       const ParSeqHelper::Parallel<Cut,Param> par);
+
+	/**  @brief fgemv on \p numths threads, cutting the rows of \f$\mathrm{op}(A)\f$ (see above).
+	 */
+	template<class Field>
+	typename Field::Element_ptr
+	pfgemv (const Field& F, const FFLAS_TRANSPOSE TransA,
+		const size_t M, const size_t N,
+		const typename Field::Element alpha,
+		typename Field::ConstElement_ptr A, const size_t lda,
+		typename Field::ConstElement_ptr X, const size_t incX,
+		const  typename Field::Element beta,
+		typename Field::Element_ptr Y, const size_t incY,
+		const size_t numths = MAX_THREADS);
+
 	/**  @brief fger: rank one update of a general matrix
 	 *
 	 *  Computes  \f$A \gets \alpha x . y^T + A\f$
@@ -492,6 +538,43 @@ namespace FFLAS {
 	      typename Field::ConstElement_ptr y, const size_t incy,
 	      typename Field::Element_ptr A, const size_t lda);
 
+	/**  @brief fger with a ParSeqHelper.
+	 *
+	 * With a ParSeqHelper::Parallel, the rows of \p A, or its columns if it
+	 * has more columns than rows, are cut in the blocks of a ForStrategy1D,
+	 * each block being updated and reduced by a sequential fger. The blocks
+	 * are given to the threads as in fgemv.
+	 * @param par the ParSeqHelper
+	 */
+	template<class Field>
+	void
+	fger (const Field& F, const size_t M, const size_t N,
+	      const typename Field::Element alpha,
+	      typename Field::ConstElement_ptr x, const size_t incx,
+	      typename Field::ConstElement_ptr y, const size_t incy,
+	      typename Field::Element_ptr A, const size_t lda,
+	      const ParSeqHelper::Sequential par);
+
+	template<class Field, class Cut, class Param>
+	void
+	fger (const Field& F, const size_t M, const size_t N,
+	      const typename Field::Element alpha,
+	      typename Field::ConstElement_ptr x, const size_t incx,
+	      typename Field::ConstElement_ptr y, const size_t incy,
+	      typename Field::Element_ptr A, const size_t lda,
+	      const ParSeqHelper::Parallel<Cut,Param> par);
+
+	/**  @brief fger on \p numths threads (see above).
+	 */
+	template<class Field>
+	void
+	pfger (const Field& F, const size_t M, const size_t N,
+	       const typename Field::Element alpha,
+	       typename Field::ConstElement_ptr x, const size_t incx,
+	       typename Field::ConstElement_ptr y, const size_t incy,
+	       typename Field::Element_ptr A, const size_t lda,
+	       const size_t numths = MAX_THREADS);
+
 	/** @brief ftrsv: TRiangular System solve with Vector
 	 *  Computes  \f$ X \gets \mathrm{op}(A^{-1}) X\f$
 	 *  @param F field
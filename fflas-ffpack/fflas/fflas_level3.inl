@@ -393,6 +393,91 @@ namespace FFLAS {
 					  typename Field::Element_ptr C,
 					  const size_t ldc);
 
+	/** @brief fsyrk: <b>SY</b>mmetric <b>R</b>ank <b>K</b> update.
+	 * Computes the \p UpLo triangle of \f$ C \gets \alpha \mathrm{op}(A) \mathrm{op}(A)^T + \beta C\f$.
+	 * The diagonal blocks are computed recursively and the off diagonal
+	 * ones by fgemm: half of the multiplications of fgemm.
+	 * The other triangle of \p C is not referenced.
+	 * @param F field
+	 * @param UpLo whether the upper or the lower triangle of \p C is updated
+	 * @param trans if \c trans==FflasTrans, \f$\mathrm{op}(A)=A^T\f$.
+	 * @param N dimension of \p C
+	 * @param K see \p A
+	 * @param alpha scalar
+	 * @param A \f$\mathrm{op}(A)\f$ is \f$N \times K\f$
+	 * @param lda leading dimension of \p A
+	 * @param beta scalar
+	 * @param C symmetric matrix of size \c NxN
+	 * @param ldc leading dimension of \p C
+	 */
+	template<class Field>
+	typename Field::Element_ptr
+	fsyrk (const Field& F, const FFLAS_UPLO UpLo, const FFLAS_TRANSPOSE trans,
+	       const size_t N, const size_t K,
+	       const typename Field::Element alpha,
+	       typename Field::ConstElement_ptr A, const size_t lda,
+	       const typename Field::Element beta,
+	       typename Field::Element_ptr C, const size_t ldc);
+
+	template<class Field>
+	typename Field::Element_ptr
+	fsyrk (const Field& F, const FFLAS_UPLO UpLo, const FFLAS_TRANSPOSE trans,
+	       const size_t N, const size_t K,
+	       const typename Field::Element alpha,
+	       typename Field::ConstElement_ptr A, const size_t lda,
+	       const typename Field::Element beta,
+	       typename Field::Element_ptr C, const size_t ldc,
+	       const ParSeqHelper::Sequential seq);
+
+	/** Parallel fsyrk: the diagonal and off diagonal blocks are tasks, to
+	 * be run in a parallel region (PAR_BLOCK). \p par is given to fgemm,
+	 * with a share of its threads.
+	 */
+	template<class Field, class Cut, class Param>
+	typename Field::Element_ptr
+	fsyrk (const Field& F, const FFLAS_UPLO UpLo, const FFLAS_TRANSPOSE trans,
+	       const size_t N, const size_t K,
+	       const typename Field::Element alpha,
+	       typename Field::ConstElement_ptr A, const size_t lda,
+	       const typename Field::Element beta,
+	       typename Field::Element_ptr C, const size_t ldc,
+	       const ParSeqHelper::Parallel<Cut,Param> par);
+
+	/** @brief fsyrk with a diagonal matrix.
+	 * Computes the \p UpLo triangle of \f$ C \gets \alpha \mathrm{op}(A) D \mathrm{op}(A)^T + \beta C\f$,
+	 * \p D being the \c KxK diagonal matrix of diagonal \c D[0], \c D[incD], ...
+	 */
+	template<class Field>
+	typename Field::Element_ptr
+	fsyrk (const Field& F, const FFLAS_UPLO UpLo, const FFLAS_TRANSPOSE trans,
+	       const size_t N, const size_t K,
+	       const typename Field::Element alpha,
+	       typename Field::ConstElement_ptr A, const size_t lda,
+	       typename Field::ConstElement_ptr D, const size_t incD,
+	       const typename Field::Element beta,
+	       typename Field::Element_ptr C, const size_t ldc);
+
+	template<class Field>
+	typename Field::Element_ptr
+	fsyrk (const Field& F, const FFLAS_UPLO UpLo, const FFLAS_TRANSPOSE trans,
+	       const size_t N, const size_t K,
+	       const typename Field::Element alpha,
+	       typename Field::ConstElement_ptr A, const size_t lda,
+	       typename Field::ConstElement_ptr D, const size_t incD,
+	       const typename Field::Element beta,
+	       typename Field::Element_ptr C, const size_t ldc,
+	       const ParSeqHelper::Sequential seq);
+
+	template<class Field, class Cut, class Param>
+	typename Field::Element_ptr
+	fsyrk (const Field& F, const FFLAS_UPLO UpLo, const FFLAS_TRANSPOSE trans,
+	       const size_t N, const size_t K,
+	       const typename Field::Element alpha,
+	       typename Field::ConstElement_ptr A, const size_t lda,
+	       typename Field::ConstElement_ptr D, const size_t incD,
+	       const typename Field::Element beta,
+	       typename Field::Element_ptr C, const size_t ldc,
+	       const ParSeqHelper::Parallel<Cut,Param> par);
 
 } // FFLAS
 
@@ -30,7 +30,9 @@
 #ifndef __FFLASFFPACK_fflas_pfgemm_INL
 #define __FFLASFFPACK_fflas_pgemm_INL
 
-#define __FFLASFFPACK_SEQPARTHRESHOLD 220
+#ifndef __FFLASFFPACK_SEQPARTHRESHOLD
+#define __FFLASFFPACK_SEQPARTHRESHOLD (FFLAS::tuning().seqpar_threshold)
+#endif
 #define __FFLASFFPACK_DIMKPENALTY 1
 
 #ifdef __FFLASFFPACK_USE_KAAPI
@@ -0,0 +1,215 @@
+/* -*- mode: C++; tab-width: 8; indent-tabs-mode: t; c-basic-offset: 8 -*- */
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+
+/* fflas/fflas_pfgemv.inl
+ * Copyright (C) 2016 the FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ *.
+ */
+
+/** @file fflas/fflas_pfgemv.inl
+ * Level 2 routines with a ParSeqHelper: fgemv and fger.
+ *
+ * The parallel versions cut the rows (or the columns) of A in the blocks of
+ * a ForStrategy1D and run the sequential routine on each block: the delayed
+ * reductions of fgemv and the final reduction of fger are done block by
+ * block, by the thread owning the block.
+ */
+
+#ifndef __FFLASFFPACK_fflas_pfgemv_INL
+#define __FFLASFFPACK_fflas_pfgemv_INL
+
+#include <vector>
+
+#include "fflas-ffpack/paladin/parallel.h"
+
+namespace FFLAS { namespace Protected {
+
+	/* Runs f(ibeg, iend) on the blocks of the cutting of [0,n) by par.
+	 * Outside of a parallel region, the blocks are statically given to the
+	 * threads of a new team, block t to thread t when there are as many
+	 * blocks as threads: the cutting only depends on n and on par, so a
+	 * thread gets the same rows of A at each call on the same matrix and
+	 * finds them in its cache, or in the memory of its NUMA node once it
+	 * touched them first. Inside a parallel region (PAR_BLOCK), the blocks
+	 * are tasks.
+	 */
+	template <class Cut, class Param, class Func>
+	inline void pforblock1d_static (const size_t n, const ParSeqHelper::Parallel<Cut,Param> par, Func f)
+	{
+		ParSeqHelper::Parallel<Cut,Param> psh (par);
+#ifdef __FFLASFFPACK_USE_OPENMP
+		if (!omp_in_parallel()) {
+			ForStrategy1D<size_t, Cut, Param> iter (n, psh);
+			std::vector<size_t> cuts;
+			for (iter.initialize(); !iter.isTerminated(); ++iter)
+				cuts.push_back (iter.begin());
+			cuts.push_back (n);
+			const size_t nb = cuts.size() - 1;
+			const size_t nt = std::min (nb, (size_t) MAX_THREADS);
+#pragma omp parallel for num_threads(nt) schedule(static)
+			for (size_t t = 0; t < nb; ++t)
+				f (cuts[t], cuts[t+1]);
+			return;
+		}
+#endif
+		SYNCH_GROUP(
+			FORBLOCK1D(iter, n, psh,
+				   TASK(MODE(CONSTREFERENCE(f)), f (iter.begin(), iter.end()));
+				   );
+			);
+	}
+
+	/* Caps the number of threads of par, for the Threads strategy, so that a
+	 * block holds at least __FFLASFFPACK_SEQPARTHRESHOLD^2 entries of an
+	 * M x N matrix; returns false if the product is better left sequential.
+	 */
+	template <class Cut, class Param>
+	inline bool pfgemv_numthreads (ParSeqHelper::Parallel<Cut,Param>& par, const size_t M, const size_t N)
+	{
+		const size_t T = __FFLASFFPACK_SEQPARTHRESHOLD;
+		if (M*N <= T*T)
+			return false;
+		if (AreEqual<Param, StrategyParameter::Threads>::value) {
+			par.set_numthreads (std::min (par.numthreads(), M*N/(T*T)));
+			return par.numthreads() > 1;
+		}
+		return true;
+	}
+
+} // Protected
+} // FFLAS
+
+namespace FFLAS {
+
+	template<class Field>
+	inline typename Field::Element_ptr
+	fgemv (const Field& F, const FFLAS_TRANSPOSE ta,
+	       const size_t M, const size_t N,
+	       const typename Field::Element alpha,
+	       typename Field::ConstElement_ptr A, const size_t lda,
+	       typename Field::ConstElement_ptr X, const size_t incX,
+	       const typename Field::Element beta,
+	       typename Field::Element_ptr Y, const size_t incY,
+	       const ParSeqHelper::Sequential)
+	{
+		return fgemv (F, ta, M, N, alpha, A, lda, X, incX, beta, Y, incY);
+	}
+
+	/* The blocks are made of rows of op(A), so that each thread writes its
+	 * own entries of Y: rows of A without transposition, columns otherwise.
+	 */
+	template<class Field, class Cut, class Param>
+	inline typename Field::Element_ptr
+	fgemv (const Field& F, const FFLAS_TRANSPOSE ta,
+	       const size_t M, const size_t N,
+	       const typename Field::Element alpha,
+	       typename Field::ConstElement_ptr A, const size_t lda,
+	       typename Field::ConstElement_ptr X, const size_t incX,
+	       const typename Field::Element beta,
+	       typename Field::Element_ptr Y, const size_t incY,
+	       const ParSeqHelper::Parallel<Cut,Param> par)
+	{
+		const size_t Ydim = (ta == FflasNoTrans)?M:N;
+		ParSeqHelper::Parallel<Cut,Param> psh (par);
+		if (Ydim < 2 || !Protected::pfgemv_numthreads (psh, M, N))
+			return fgemv (F, ta, M, N, alpha, A, lda, X, incX, beta, Y, incY);
+
+		if (ta == FflasNoTrans)
+			Protected::pforblock1d_static (M, psh, [&](size_t ib, size_t ie) {
+				fgemv (F, FflasNoTrans, ie-ib, N, alpha, A+ib*lda, lda, X, incX, beta, Y+ib*incY, incY);
+			});
+		else
+			Protected::pforblock1d_static (N, psh, [&](size_t jb, size_t je) {
+				fgemv (F, FflasTrans, M, je-jb, alpha, A+jb, lda, X, incX, beta, Y+jb*incY, incY);
+			});
+		return Y;
+	}
+
+	template<class Field>
+	inline typename Field::Element_ptr
+	pfgemv (const Field& F, const FFLAS_TRANSPOSE ta,
+		const size_t M, const size_t N,
+		const typename Field::Element alpha,
+		typename Field::ConstElement_ptr A, const size_t lda,
+		typename Field::ConstElement_ptr X, const size_t incX,
+		const typename Field::Element beta,
+		typename Field::Element_ptr Y, const size_t incY,
+		const size_t numths)
+	{
+		ParSeqHelper::Parallel<CuttingStrategy::Row, StrategyParameter::Threads> par (numths);
+		return fgemv (F, ta, M, N, alpha, A, lda, X, incX, beta, Y, incY, par);
+	}
+
+	template<class Field>
+	inline void
+	fger (const Field& F, const size_t M, const size_t N,
+	      const typename Field::Element alpha,
+	      typename Field::ConstElement_ptr x, const size_t incx,
+	      typename Field::ConstElement_ptr y, const size_t incy,
+	      typename Field::Element_ptr A, const size_t lda,
+	      const ParSeqHelper::Sequential)
+	{
+		fger (F, M, N, alpha, x, incx, y, incy, A, lda);
+	}
+
+	/* The blocks are made of rows of A, or of columns when A has more
+	 * columns than rows.
+	 */
+	template<class Field, class Cut, class Param>
+	inline void
+	fger (const Field& F, const size_t M, const size_t N,
+	      const typename Field::Element alpha,
+	      typename Field::ConstElement_ptr x, const size_t incx,
+	      typename Field::ConstElement_ptr y, const size_t incy,
+	      typename Field::Element_ptr A, const size_t lda,
+	      const ParSeqHelper::Parallel<Cut,Param> par)
+	{
+		if (F.isZero (alpha)) return;
+		ParSeqHelper::Parallel<Cut,Param> psh (par);
+		if (!Protected::pfgemv_numthreads (psh, M, N))
+			return fger (F, M, N, alpha, x, incx, y, incy, A, lda);
+
+		if (M >= N)
+			Protected::pforblock1d_static (M, psh, [&](size_t ib, size_t ie) {
+				fger (F, ie-ib, N, alpha, x+ib*incx, incx, y, incy, A+ib*lda, lda);
+			});
+		else
+			Protected::pforblock1d_static (N, psh, [&](size_t jb, size_t je) {
+				fger (F, M, je-jb, alpha, x, incx, y+jb*incy, incy, A+jb, lda);
+			});
+	}
+
+	template<class Field>
+	inline void
+	pfger (const Field& F, const size_t M, const size_t N,
+	       const typename Field::Element alpha,
+	       typename Field::ConstElement_ptr x, const size_t incx,
+	       typename Field::ConstElement_ptr y, const size_t incy,
+	       typename Field::Element_ptr A, const size_t lda,
+	       const size_t numths)
+	{
+		ParSeqHelper::Parallel<CuttingStrategy::Row, StrategyParameter::Threads> par (numths);
+		fger (F, M, N, alpha, x, incx, y, incy, A, lda, par);
+	}
+
+} // FFLAS
+
+#endif // __FFLASFFPACK_fflas_pfgemv_INL
@@ -31,7 +31,9 @@
 #ifndef __FFLASFFPACK_fflas_pftrsm_INL
 #define __FFLASFFPACK_fflas_pftrsm_INL
 
-#define PTRSM_HYBRID_THRESHOLD 256
+#ifndef PTRSM_HYBRID_THRESHOLD
+#define PTRSM_HYBRID_THRESHOLD (FFLAS::tuning().ptrsm_threshold)
+#endif
 
 #include "fflas-ffpack/paladin/parallel.h"
 
@@ -128,6 +128,44 @@ std::ostream &operator<<(std::ostream &o, const __m256d &v) {
 } // std
 #endif // __FFLASFFPACK_USE_AVX
 
+#ifdef __FFLASFFPACK_USE_AVX512F
+namespace std {
+
+inline
+std::ostream &operator<<(std::ostream &o, const __m512 &v) {
+    const float *vArray = (const float *)(&v);
+    o << '<';
+    for (size_t i = 0; i < 15; ++i)
+        o << vArray[i] << ',';
+    o << vArray[15];
+    o << '>';
+    return o;
+}
+
+inline
+std::ostream &operator<<(std::ostream &o, const __m512i &v) {
+    const int64_t *vArray = (const int64_t *)(&v);
+    o << '<';
+    o << vArray[0] << ',' << vArray[1] << ',' << vArray[2] << ',' << vArray[3];
+    o << ',';
+    o << vArray[4] << ',' << vArray[5] << ',' << vArray[6] << ',' << vArray[7];
+    o << '>';
+    return o;
+}
+
+inline
+std::ostream &operator<<(std::ostream &o, const __m512d &v) {
+    const double *vArray = (const double *)(&v);
+    o << '<';
+    o << vArray[0] << ',' << vArray[1] << ',' << vArray[2] << ',' << vArray[3];
+    o << ',';
+    o << vArray[4] << ',' << vArray[5] << ',' << vArray[6] << ',' << vArray[7];
+    o << '>';
+    return o;
+}
+} // std
+#endif // __FFLASFFPACK_USE_AVX512F
+
 #endif // __FFLASFFPACK_USE_SIMD
 
 namespace FFLAS {
@@ -229,6 +267,32 @@ template <> struct is_simd<__m256i> {
 #endif
 #endif // AVX
 
+// AVX512
+#if defined(__FFLASFFPACK_USE_AVX512F)
+#include "fflas-ffpack/fflas/fflas_simd/simd512.inl"
+
+template <> struct simdToType<__m512d> { using type = double; };
+
+template <> struct simdToType<__m512> { using type = float; };
+
+template <> struct is_simd<__m512d> {
+    static const constexpr bool value = true;
+    using type = std::integral_constant<bool, true>;
+};
+
+template <> struct is_simd<__m512> {
+    static const constexpr bool value = true;
+    using type = std::integral_constant<bool, true>;
+};
+
+#ifdef SIMD_INT
+template <> struct is_simd<__m512i> {
+    static const constexpr bool value = true;
+    using type = std::integral_constant<bool, true>;
+};
+#endif
+#endif // AVX512
+
 /*
  * Simd functors
  */
@@ -250,7 +314,9 @@ template <class T, bool b> struct SimdChooser<T, false, b> { using value = NoSim
 template <class T>
 struct SimdChooser<T, true, false> // floating number
     {
-#ifdef __FFLASFFPACK_USE_AVX
+#ifdef __FFLASFFPACK_USE_AVX512F
+    using value = Simd512<T>;
+#elif defined(__FFLASFFPACK_USE_AVX)
     using value = Simd256<T>;
 #elif defined(__FFLASFFPACK_USE_SSE)
     using value = Simd128<T>;
@@ -262,7 +328,10 @@ struct SimdChooser<T, true, false> // floating number
 template <class T>
 struct SimdChooser<T, true, true> // integral number
     {
-#ifdef __FFLASFFPACK_USE_AVX2
+#ifdef __FFLASFFPACK_USE_AVX512F
+    // no 512 bits int16_t without AVX512BW
+    using value = typename std::conditional<(sizeof(T) >= 4), Simd512<T>, Simd256<T>>::type;
+#elif defined(__FFLASFFPACK_USE_AVX2)
     using value = Simd256<T>;
 #elif __FFLASFFPACK_USE_SSE
     using value = Simd128<T>;
@@ -347,6 +416,17 @@ inline std::ostream &operator<<(std::ostream &o, const typename Simd256<T>::vect
 }
 #endif // __FFLASFFPACK_USE_AVX
 
+#ifdef __FFLASFFPACK_USE_AVX512F
+namespace std {
+// cannot be instanciated, T is not déductible
+template <class T>
+inline std::ostream &operator<<(std::ostream &o, const typename Simd512<T>::vect_t &v) {
+    FFLAS::print<Simd512<T>>(o, v);
+    return o;
+}
+}
+#endif // __FFLASFFPACK_USE_AVX512F
+
 #endif // __FFLASFFPACK_USE_SIMD
 
 #undef INLINE
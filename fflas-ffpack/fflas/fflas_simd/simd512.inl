@@ -0,0 +1,49 @@
+/* -*- mode: C++; tab-width: 8; indent-tabs-mode: t; c-basic-offset: 8 -*- */
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/*
+ * Copyright (C) 2016 the FFLAS-FFPACK group
+ *
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ *.
+ */
+
+#ifndef __FFLASFFPACK_fflas_ffpack_utils_simd512_INL
+#define __FFLASFFPACK_fflas_ffpack_utils_simd512_INL
+
+template <bool ArithType, bool Int, bool Signed, int Size> struct Simd512_impl;
+
+#include "simd512_float.inl"
+#include "simd512_double.inl"
+
+#ifdef SIMD_INT
+// only 32 and 64 bits integers, 16 bits ones need AVX512BW
+
+#if defined(__FFLASFFPACK_USE_AVX512F)
+#include "simd512_int32.inl"
+#include "simd512_int64.inl"
+#endif
+
+#endif //#ifdef SIMD_INT
+
+template <class T>
+using Simd512 =
+    Simd512_impl<std::is_arithmetic<T>::value, std::is_integral<T>::value, std::is_signed<T>::value, sizeof(T)>;
+
+#endif // __FFLASFFPACK_fflas_ffpack_utils_simd512_INL
@@ -0,0 +1,392 @@
+/* -*- mode: C++; tab-width: 8; indent-tabs-mode: t; c-basic-offset: 8 -*- */
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/*
+ * Copyright (C) 2016 the FFLAS-FFPACK group
+ *
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ *.
+ */
+
+#ifndef __FFLASFFPACK_fflas_ffpack_utils_simd512_double_INL
+#define __FFLASFFPACK_fflas_ffpack_utils_simd512_double_INL
+
+/*
+ * Simd512 specialized for double
+ */
+template <> struct Simd512_impl<true, false, true, 8> {
+#if defined(__FFLASFFPACK_USE_AVX512F)
+
+    /*
+     * alias to 512 bit simd register
+     */
+    using vect_t = __m512d;
+
+    /*
+     * alias to the mask register returned by AVX512 comparisons
+     */
+    using mask_t = __mmask8;
+
+    /*
+     * define the scalar type corresponding to the specialization
+     */
+    using scalar_t = double;
+
+    /*
+     *	number of scalar_t in a simd register
+     */
+    static const constexpr size_t vect_size = 8;
+
+    /*
+     *	alignement required by scalar_t pointer to be loaded in a vect_t
+     */
+    static const constexpr size_t alignment = 64;
+
+    /*
+     * Check if the pointer p is a multiple of alignemnt
+     */
+    template <class T> static constexpr bool valid(T *p) { return (int64_t)p % alignment == 0; }
+
+    /*
+     * Check if the number n is a multiple of vect_size
+     */
+    template <class T> static constexpr bool compliant(T n) { return n % vect_size == 0; }
+
+    /*
+     *	Expand the mask m to a vect_t, lanes set in m are all ones, the others are zero.
+     *  Return [m0 ? 0xFFFFFFFFFFFFFFFF : 0, ..., m7 ? 0xFFFFFFFFFFFFFFFF : 0]
+     */
+    static INLINE CONST vect_t mask_to_vect(const mask_t m) {
+        return _mm512_castsi512_pd(_mm512_maskz_set1_epi64(m, -1));
+    }
+
+    /*
+     *	Return vector of type vect_t with all elements set to zero
+     *  Return [0,0,0,0,0,0,0,0]
+     */
+    static INLINE CONST vect_t zero() { return _mm512_setzero_pd(); }
+
+    /*
+     *	Broadcast double-precision (64-bit) floating-point value x to all elements of vect_t.
+     *  Return [x,x,x,x,x,x,x,x]
+     */
+    static INLINE CONST vect_t set1(const scalar_t x) { return _mm512_set1_pd(x); }
+
+    /*
+     *	Set packed double-precision (64-bit) floating-point elements in vect_t with the supplied values.
+     *  Return [x1,x2,x3,x4,x5,x6,x7,x8]
+     */
+    static INLINE CONST vect_t set(const scalar_t x1, const scalar_t x2, const scalar_t x3, const scalar_t x4,
+                                   const scalar_t x5, const scalar_t x6, const scalar_t x7, const scalar_t x8) {
+        return _mm512_set_pd(x8, x7, x6, x5, x4, x3, x2, x1);
+    }
+
+    /*
+     *	Gather double-precision (64-bit) floating-point elements with indexes idx[0], ..., idx[7] from the address p in
+     *vect_t.
+     *  Return [p[idx[0]], p[idx[1]], p[idx[2]], p[idx[3]], p[idx[4]], p[idx[5]], p[idx[6]], p[idx[7]]]
+     */
+    template <class T> static INLINE PURE vect_t gather(const scalar_t *const p, const T *const idx) {
+        return gather_impl(p, idx, std::integral_constant<size_t, sizeof(T)>());
+    }
+
+    /*
+     * Load 512-bits (composed of 8 packed double-precision (64-bit) floating-point elements) from memory into vect_t.
+     * p must be aligned on a 64-byte boundary or a general-protection exception will be generated.
+     * Return [p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7]]
+     */
+    static INLINE PURE vect_t load(const scalar_t *const p) { return _mm512_load_pd(p); }
+
+    /*
+     * Load 512-bits (composed of 8 packed double-precision (64-bit) floating-point elements) from memory into vect_t.
+     * p does not need to be aligned on any particular boundary.
+     * Return [p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7]]
+     */
+    static INLINE PURE vect_t loadu(const scalar_t *const p) { return _mm512_loadu_pd(p); }
+
+    /*
+     * Store 512-bits (composed of 8 packed double-precision (64-bit) floating-point elements) from p into memory.
+     * p must be aligned on a 64-byte boundary or a general-protection exception will be generated.
+     */
+    static INLINE void store(const scalar_t *p, const vect_t v) { _mm512_store_pd(const_cast<scalar_t *>(p), v); }
+
+    /*
+     * Store 512-bits (composed of 8 packed double-precision (64-bit) floating-point elements) from p into memory.
+     * p does not need to be aligned on any particular boundary.
+     */
+    static INLINE void storeu(const scalar_t *p, const vect_t v) { _mm512_storeu_pd(const_cast<scalar_t *>(p), v); }
+
+    /*
+     * Store 512-bits (composed of 8 packed double-precision (64-bit) floating-point elements) from a into memory using
+     * a non-temporal memory hint.
+     * p must be aligned on a 64-byte boundary or a general-protection exception may be generated.
+     */
+    static INLINE void stream(const scalar_t *p, const vect_t v) { _mm512_stream_pd(const_cast<scalar_t *>(p), v); }
+
+    /*
+     * Add packed double-precision (64-bit) floating-point elements in a and b, and store the results in vect_t.
+     * Args   : [a0, ..., a7], [b0, ..., b7]
+     * Return : [a0+b0, ..., a7+b7]
+     */
+    static INLINE CONST vect_t add(const vect_t a, const vect_t b) { return _mm512_add_pd(a, b); }
+
+    static INLINE vect_t addin(vect_t &a, const vect_t b) { return a = add(a, b); }
+
+    /*
+     * Subtract packed double-precision (64-bit) floating-point elements in b from packed double-precision (64-bit)
+     * floating-point elements in a, and store the results in vect_t.
+     * Args   : [a0, ..., a7], [b0, ..., b7]
+     * Return : [a0-b0, ..., a7-b7]
+     */
+    static INLINE CONST vect_t sub(const vect_t a, const vect_t b) { return _mm512_sub_pd(a, b); }
+
+    static INLINE CONST vect_t subin(vect_t &a, const vect_t b) { return a = sub(a, b); }
+
+    /*
+     * Multiply packed double-precision (64-bit) floating-point elements in a and b, and store the results in vect_t.
+     * Args   : [a0, ..., a7], [b0, ..., b7]
+     * Return : [a0*b0, ..., a7*b7]
+     */
+    static INLINE CONST vect_t mul(const vect_t a, const vect_t b) { return _mm512_mul_pd(a, b); }
+
+    static INLINE CONST vect_t mulin(vect_t &a, const vect_t b) { return a = mul(a, b); }
+
+    /*
+     * Multiply packed double-precision (64-bit) floating-point elements in a and b, add the intermediate result to
+     * packed elements in c, and store the results in vect_t.
+     * Args   : [a0, ..., a7], [b0, ..., b7], [c0, ..., c7]
+     * Return : [a0*b0+c0, ..., a7*b7+c7]
+     */
+    static INLINE CONST vect_t fmadd(const vect_t c, const vect_t a, const vect_t b) { return _mm512_fmadd_pd(a, b, c); }
+
+    static INLINE CONST vect_t madd(const vect_t c, const vect_t a, const vect_t b) { return fmadd(c, a, b); }
+
+    static INLINE CONST vect_t maddx(const vect_t c, const vect_t a, const vect_t b) { return fmadd(c, a, b); }
+
+    static INLINE CONST vect_t fmaddin(vect_t &c, const vect_t a, const vect_t b) { return c = fmadd(c, a, b); }
+
+    /*
+     * Multiply packed double-precision (64-bit) floating-point elements in a and b, add the negated intermediate result
+     * to packed elements in c, and store the results in vect_t.
+     * Args   : [a0, ..., a7], [b0, ..., b7], [c0, ..., c7]
+     * Return : [-(a0*b0)+c0, ..., -(a7*b7)+c7]
+     */
+    static INLINE CONST vect_t fnmadd(const vect_t c, const vect_t a, const vect_t b) {
+        return _mm512_fnmadd_pd(a, b, c);
+    }
+
+    static INLINE CONST vect_t nmadd(const vect_t c, const vect_t a, const vect_t b) { return fnmadd(c, a, b); }
+
+    static INLINE CONST vect_t fnmaddin(vect_t &c, const vect_t a, const vect_t b) { return c = fnmadd(c, a, b); }
+
+    /*
+     * Multiply packed double-precision (64-bit) floating-point elements in a and b, subtract packed elements in c from
+     * the intermediate result, and store the results in vect_t.
+     * Args   : [a0, ..., a7], [b0, ..., b7], [c0, ..., c7]
+     * Return : [a0*b0-c0, ..., a7*b7-c7]
+     */
+    static INLINE CONST vect_t fmsub(const vect_t c, const vect_t a, const vect_t b) { return _mm512_fmsub_pd(a, b, c); }
+
+    static INLINE CONST vect_t msub(const vect_t c, const vect_t a, const vect_t b) { return fmsub(c, a, b); }
+
+    static INLINE CONST vect_t fmsubin(vect_t &c, const vect_t a, const vect_t b) { return c = fmsub(c, a, b); }
+
+    /*
+     * Compare packed double-precision (64-bit) floating-point elements in a and b, and store the results in a mask.
+     * These are the native AVX512 comparisons, used by mod to avoid the and/or sequence of NORML_MOD.
+     */
+    static INLINE CONST mask_t eq_mask(const vect_t a, const vect_t b) { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+
+    static INLINE CONST mask_t lesser_mask(const vect_t a, const vect_t b) {
+        return _mm512_cmp_pd_mask(a, b, _CMP_LT_OS);
+    }
+
+    static INLINE CONST mask_t greater_mask(const vect_t a, const vect_t b) {
+        return _mm512_cmp_pd_mask(a, b, _CMP_GT_OS);
+    }
+
+    /*
+     * Compare packed double-precision (64-bit) floating-point elements in a and b for equality, and store the results
+     in vect_t.
+     * Args   : [a0, ..., a7], [b0, ..., b7]
+     * Return : [(a0==b0) ? 0xFFFFFFFFFFFFFFFF : 0, ..., (a7==b7) ? 0xFFFFFFFFFFFFFFFF : 0]
+     */
+    static INLINE CONST vect_t eq(const vect_t a, const vect_t b) { return mask_to_vect(eq_mask(a, b)); }
+
+    /*
+     * Compare packed double-precision (64-bit) floating-point elements in a and b for lesser-than, and store the
+     results in vect_t.
+     * Args   : [a0, ..., a7], [b0, ..., b7]
+     * Return : [(a0<b0) ? 0xFFFFFFFFFFFFFFFF : 0, ..., (a7<b7) ? 0xFFFFFFFFFFFFFFFF : 0]
+     */
+    static INLINE CONST vect_t lesser(const vect_t a, const vect_t b) { return mask_to_vect(lesser_mask(a, b)); }
+
+    /*
+     * Compare packed double-precision (64-bit) floating-point elements in a and b for lesser or equal than, and store
+     the results in vect_t.
+     * Args   : [a0, ..., a7], [b0, ..., b7]
+     * Return : [(a0<=b0) ? 0xFFFFFFFFFFFFFFFF : 0, ..., (a7<=b7) ? 0xFFFFFFFFFFFFFFFF : 0]
+     */
+    static INLINE CONST vect_t lesser_eq(const vect_t a, const vect_t b) {
+        return mask_to_vect(_mm512_cmp_pd_mask(a, b, _CMP_LE_OS));
+    }
+
+    /*
+     * Compare packed double-precision (64-bit) floating-point elements in a and b for greater-than, and store the
+     results in vect_t.
+     * Args   : [a0, ..., a7], [b0, ..., b7]
+     * Return : [(a0>b0) ? 0xFFFFFFFFFFFFFFFF : 0, ..., (a7>b7) ? 0xFFFFFFFFFFFFFFFF : 0]
+     */
+    static INLINE CONST vect_t greater(const vect_t a, const vect_t b) { return mask_to_vect(greater_mask(a, b)); }
+
+    /*
+     * Compare packed double-precision (64-bit) floating-point elements in a and b for greater or equal than, and store
+     the results in vect_t.
+     * Args   : [a0, ..., a7], [b0, ..., b7]
+     * Return : [(a0>=b0) ? 0xFFFFFFFFFFFFFFFF : 0, ..., (a7>=b7) ? 0xFFFFFFFFFFFFFFFF : 0]
+     */
+    static INLINE CONST vect_t greater_eq(const vect_t a, const vect_t b) {
+        return mask_to_vect(_mm512_cmp_pd_mask(a, b, _CMP_GE_OS));
+    }
+
+    /*
+     * Compute the bitwise AND of packed double-precision (64-bit) floating-point elements in a and b, and store the
+     * results in vect_t.
+     * (_mm512_and_pd needs AVX512DQ, the integer version only needs AVX512F)
+     * Args   : [a0, ..., a7], [b0, ..., b7]
+     * Return : [a0 AND b0, ..., a7 AND b7]
+     */
+    static INLINE CONST vect_t vand(const vect_t a, const vect_t b) {
+        return _mm512_castsi512_pd(_mm512_and_si512(_mm512_castpd_si512(a), _mm512_castpd_si512(b)));
+    }
+
+    /*
+     * Compute the bitwise OR of packed double-precision (64-bit) floating-point elements in a and b, and store the
+     * results in vect_t.
+     * Args   : [a0, ..., a7], [b0, ..., b7]
+     * Return : [a0 OR b0, ..., a7 OR b7]
+     */
+    static INLINE CONST vect_t vor(const vect_t a, const vect_t b) {
+        return _mm512_castsi512_pd(_mm512_or_si512(_mm512_castpd_si512(a), _mm512_castpd_si512(b)));
+    }
+
+    /*
+     * Compute the bitwise XOR of packed double-precision (64-bit) floating-point elements in a and b, and store the
+     * results in vect_t.
+     * Args   : [a0, ..., a7], [b0, ..., b7]
+     * Return : [a0 XOR b0, ..., a7 XOR b7]
+     */
+    static INLINE CONST vect_t vxor(const vect_t a, const vect_t b) {
+        return _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(a), _mm512_castpd_si512(b)));
+    }
+
+    /*
+     * Compute the bitwise AND NOT of packed double-precision (64-bit) floating-point elements in a and b, and store the
+     * results in vect_t.
+     * Args   : [a0, ..., a7], [b0, ..., b7]
+     * Return : [a0 AND NOT b0, ..., a7 AND NOT b7]
+     */
+    static INLINE CONST vect_t vandnot(const vect_t a, const vect_t b) {
+        return _mm512_castsi512_pd(_mm512_andnot_si512(_mm512_castpd_si512(a), _mm512_castpd_si512(b)));
+    }
+
+    /*
+     * Round the packed double-precision (64-bit) floating-point elements in a down to an integer value, and store the
+     * results as packed double-precision floating-point elements in vect_t.
+     * Args   : [a0, ..., a7]
+     * Return : [floor(a0), ..., floor(a7)]
+     */
+    static INLINE CONST vect_t floor(const vect_t a) {
+        return _mm512_roundscale_pd(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+    }
+
+    /*
+     * Round the packed double-precision (64-bit) floating-point elements in a up to an integer value, and store the
+     * results as packed double-precision floating-point elements in vect_t.
+     * Args   : [a0, ..., a7]
+     * Return : [ceil(a0), ..., ceil(a7)]
+     */
+    static INLINE CONST vect_t ceil(const vect_t a) {
+        return _mm512_roundscale_pd(a, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC);
+    }
+
+    /*
+     * Round the packed double-precision (64-bit) floating-point elements in a, and store the results as packed
+     * double-precision floating-point elements in vect_t.
+     * Args   : [a0, ..., a7]
+     * Return : [round(a0), ..., round(a7)]
+     */
+    static INLINE CONST vect_t round(const vect_t a) {
+        return _mm512_roundscale_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    }
+
+    /*
+     * Horizontally add adjacent pairs of double-precision (64-bit) floating-point elements in a and b, and pack the
+     * results in vect_t.
+     * Args   : [a0, a1, a2, a3, a4, a5, a6, a7], [b0, b1, b2, b3, b4, b5, b6, b7]
+     * Return : [a0+a1, b0+b1, a2+a3, b2+b3, a4+a5, b4+b5, a6+a7, b6+b7]
+     */
+    static INLINE CONST vect_t hadd(const vect_t a, const vect_t b) {
+        return add(_mm512_unpacklo_pd(a, b), _mm512_unpackhi_pd(a, b));
+    }
+
+    /*
+     * Horizontally add double-precision (64-bit) floating-point elements in a.
+     * Args   : [a0, ..., a7]
+     * Return : a0+a1+a2+a3+a4+a5+a6+a7
+     */
+    static INLINE CONST scalar_t hadd_to_scal(const vect_t a) { return _mm512_reduce_add_pd(a); }
+
+    /*
+     * Reduce C modulo P, C is assumed to be an integer with |C| < 2^53.
+     * The normalisation into [MIN, MAX] uses masked additions instead of NORML_MOD.
+     */
+    static INLINE vect_t mod(vect_t &C, const vect_t &P, const vect_t &INVP, const vect_t &NEGP, const vect_t &MIN,
+                             const vect_t &MAX, vect_t &Q, vect_t &T) {
+        FLOAT_MOD(C, P, INVP, Q);
+        C = _mm512_mask_add_pd(C, greater_mask(C, MAX), C, NEGP);
+        C = _mm512_mask_add_pd(C, lesser_mask(C, MIN), C, P);
+        return C;
+    }
+
+  private:
+    template <class T>
+    static INLINE PURE vect_t gather_impl(const scalar_t *const p, const T *const idx,
+                                          std::integral_constant<size_t, 4>) {
+        return _mm512_i32gather_pd(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(idx)), p, 8);
+    }
+
+    template <class T>
+    static INLINE PURE vect_t gather_impl(const scalar_t *const p, const T *const idx,
+                                          std::integral_constant<size_t, 8>) {
+        return _mm512_i64gather_pd(_mm512_loadu_si512(reinterpret_cast<const void *>(idx)), p, 8);
+    }
+
+    template <class T, size_t S>
+    static INLINE PURE vect_t gather_impl(const scalar_t *const p, const T *const idx,
+                                          std::integral_constant<size_t, S>) {
+        return set(p[idx[0]], p[idx[1]], p[idx[2]], p[idx[3]], p[idx[4]], p[idx[5]], p[idx[6]], p[idx[7]]);
+    }
+
+#else // __AVX512F__
+#error "You need AVX512F instructions to perform 512bits operations on double"
+#endif
+};
+
+#endif // __FFLASFFPACK_fflas_ffpack_utils_simd512_double_INL
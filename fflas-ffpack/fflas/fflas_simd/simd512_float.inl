@@ -0,0 +1,397 @@
+/* -*- mode: C++; tab-width: 8; indent-tabs-mode: t; c-basic-offset: 8 -*- */
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/*
+ * Copyright (C) 2016 the FFLAS-FFPACK group
+ *
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ *.
+ */
+
+#ifndef __FFLASFFPACK_fflas_ffpack_utils_simd512_float_INL
+#define __FFLASFFPACK_fflas_ffpack_utils_simd512_float_INL
+
+/*
+ * Simd512 specialized for float
+ */
+template <> struct Simd512_impl<true, false, true, 4> {
+#if defined(__FFLASFFPACK_USE_AVX512F)
+    /*
+     * alias to 512 bit simd register
+     */
+    using vect_t = __m512;
+
+    /*
+     * alias to the mask register returned by AVX512 comparisons
+     */
+    using mask_t = __mmask16;
+
+    /*
+     * define the scalar type corresponding to the specialization
+     */
+    using scalar_t = float;
+
+    /*
+     *	number of scalar_t in a simd register
+     */
+    static const constexpr size_t vect_size = 16;
+
+    /*
+     *	alignement required by scalar_t pointer to be loaded in a vect_t
+     */
+    static const constexpr size_t alignment = 64;
+
+    /*
+     * Check if the pointer p is a multiple of alignemnt
+     */
+    template <class T> static constexpr bool valid(T *p) { return (int64_t)p % alignment == 0; }
+
+    /*
+     * Check if the number n is a multiple of vect_size
+     */
+    template <class T> static constexpr bool compliant(T n) { return n % vect_size == 0; }
+
+    /*
+     *	Expand the mask m to a vect_t, lanes set in m are all ones, the others are zero.
+     *  Return [m0 ? 0xFFFFFFFF : 0, ..., m15 ? 0xFFFFFFFF : 0]
+     */
+    static INLINE CONST vect_t mask_to_vect(const mask_t m) {
+        return _mm512_castsi512_ps(_mm512_maskz_set1_epi32(m, -1));
+    }
+
+    /*
+     *	Return vector of type vect_t with all elements set to zero
+     *  Return [0, ..., 0]
+     */
+    static INLINE CONST vect_t zero() { return _mm512_setzero_ps(); }
+
+    /*
+     *	Broadcast single-precision (32-bit) floating-point value x to all elements of vect_t.
+     *  Return [x, ..., x]
+     */
+    static INLINE CONST vect_t set1(const scalar_t x) { return _mm512_set1_ps(x); }
+
+    /*
+     *	Set packed single-precision (32-bit) floating-point elements in vect_t with the supplied values.
+     *  Return [x1, ..., x16]
+     */
+    static INLINE CONST vect_t set(const scalar_t x1, const scalar_t x2, const scalar_t x3, const scalar_t x4,
+                                   const scalar_t x5, const scalar_t x6, const scalar_t x7, const scalar_t x8,
+                                   const scalar_t x9, const scalar_t x10, const scalar_t x11, const scalar_t x12,
+                                   const scalar_t x13, const scalar_t x14, const scalar_t x15, const scalar_t x16) {
+        return _mm512_set_ps(x16, x15, x14, x13, x12, x11, x10, x9, x8, x7, x6, x5, x4, x3, x2, x1);
+    }
+
+    /*
+     *	Gather single-precision (32-bit) floating-point elements with indexes idx[0], ..., idx[15] from the address p in
+     *vect_t.
+     *  Return [p[idx[0]], ..., p[idx[15]]]
+     */
+    template <class T> static INLINE PURE vect_t gather(const scalar_t *const p, const T *const idx) {
+        return gather_impl(p, idx, std::integral_constant<size_t, sizeof(T)>());
+    }
+
+    /*
+     * Load 512-bits (composed of 16 packed single-precision (32-bit) floating-point elements) from memory into vect_t.
+     * p must be aligned on a 64-byte boundary or a general-protection exception will be generated.
+     * Return [p[0], ..., p[15]]
+     */
+    static INLINE PURE vect_t load(const scalar_t *const p) { return _mm512_load_ps(p); }
+
+    /*
+     * Load 512-bits (composed of 16 packed single-precision (32-bit) floating-point elements) from memory into vect_t.
+     * p does not need to be aligned on any particular boundary.
+     * Return [p[0], ..., p[15]]
+     */
+    static INLINE PURE vect_t loadu(const scalar_t *const p) { return _mm512_loadu_ps(p); }
+
+    /*
+     * Store 512-bits (composed of 16 packed single-precision (32-bit) floating-point elements) from p into memory.
+     * p must be aligned on a 64-byte boundary or a general-protection exception will be generated.
+     */
+    static INLINE void store(const scalar_t *p, const vect_t v) { _mm512_store_ps(const_cast<scalar_t *>(p), v); }
+
+    /*
+     * Store 512-bits (composed of 16 packed single-precision (32-bit) floating-point elements) from p into memory.
+     * p does not need to be aligned on any particular boundary.
+     */
+    static INLINE void storeu(const scalar_t *p, const vect_t v) { _mm512_storeu_ps(const_cast<scalar_t *>(p), v); }
+
+    /*
+     * Store 512-bits (composed of 16 packed single-precision (32-bit) floating-point elements) from a into memory using
+     * a non-temporal memory hint.
+     * p must be aligned on a 64-byte boundary or a general-protection exception may be generated.
+     */
+    static INLINE void stream(const scalar_t *p, const vect_t v) { _mm512_stream_ps(const_cast<scalar_t *>(p), v); }
+
+    /*
+     * Add packed single-precision (32-bit) floating-point elements in a and b, and store the results in vect_t.
+     * Args   : [a0, ..., a15], [b0, ..., b15]
+     * Return : [a0+b0, ..., a15+b15]
+     */
+    static INLINE CONST vect_t add(const vect_t a, const vect_t b) { return _mm512_add_ps(a, b); }
+
+    static INLINE vect_t addin(vect_t &a, const vect_t b) { return a = add(a, b); }
+
+    /*
+     * Subtract packed single-precision (32-bit) floating-point elements in b from packed single-precision (32-bit)
+     * floating-point elements in a, and store the results in vect_t.
+     * Args   : [a0, ..., a15], [b0, ..., b15]
+     * Return : [a0-b0, ..., a15-b15]
+     */
+    static INLINE CONST vect_t sub(const vect_t a, const vect_t b) { return _mm512_sub_ps(a, b); }
+
+    static INLINE CONST vect_t subin(vect_t &a, const vect_t b) { return a = sub(a, b); }
+
+    /*
+     * Multiply packed single-precision (32-bit) floating-point elements in a and b, and store the results in vect_t.
+     * Args   : [a0, ..., a15], [b0, ..., b15]
+     * Return : [a0*b0, ..., a15*b15]
+     */
+    static INLINE CONST vect_t mul(const vect_t a, const vect_t b) { return _mm512_mul_ps(a, b); }
+
+    static INLINE CONST vect_t mulin(vect_t &a, const vect_t b) { return a = mul(a, b); }
+
+    /*
+     * Multiply packed single-precision (32-bit) floating-point elements in a and b, add the intermediate result to
+     * packed elements in c, and store the results in vect_t.
+     * Args   : [a0, ..., a15], [b0, ..., b15], [c0, ..., c15]
+     * Return : [a0*b0+c0, ..., a15*b15+c15]
+     */
+    static INLINE CONST vect_t fmadd(const vect_t c, const vect_t a, const vect_t b) { return _mm512_fmadd_ps(a, b, c); }
+
+    static INLINE CONST vect_t madd(const vect_t c, const vect_t a, const vect_t b) { return fmadd(c, a, b); }
+
+    static INLINE CONST vect_t maddx(const vect_t c, const vect_t a, const vect_t b) { return fmadd(c, a, b); }
+
+    static INLINE CONST vect_t fmaddin(vect_t &c, const vect_t a, const vect_t b) { return c = fmadd(c, a, b); }
+
+    /*
+     * Multiply packed single-precision (32-bit) floating-point elements in a and b, add the negated intermediate result
+     * to packed elements in c, and store the results in vect_t.
+     * Args   : [a0, ..., a15], [b0, ..., b15], [c0, ..., c15]
+     * Return : [-(a0*b0)+c0, ..., -(a15*b15)+c15]
+     */
+    static INLINE CONST vect_t fnmadd(const vect_t c, const vect_t a, const vect_t b) {
+        return _mm512_fnmadd_ps(a, b, c);
+    }
+
+    static INLINE CONST vect_t nmadd(const vect_t c, const vect_t a, const vect_t b) { return fnmadd(c, a, b); }
+
+    static INLINE CONST vect_t fnmaddin(vect_t &c, const vect_t a, const vect_t b) { return c = fnmadd(c, a, b); }
+
+    /*
+     * Multiply packed single-precision (32-bit) floating-point elements in a and b, subtract packed elements in c from
+     * the intermediate result, and store the results in vect_t.
+     * Args   : [a0, ..., a15], [b0, ..., b15], [c0, ..., c15]
+     * Return : [a0*b0-c0, ..., a15*b15-c15]
+     */
+    static INLINE CONST vect_t fmsub(const vect_t c, const vect_t a, const vect_t b) { return _mm512_fmsub_ps(a, b, c); }
+
+    static INLINE CONST vect_t msub(const vect_t c, const vect_t a, const vect_t b) { return fmsub(c, a, b); }
+
+    static INLINE CONST vect_t fmsubin(vect_t &c, const vect_t a, const vect_t b) { return c = fmsub(c, a, b); }
+
+    /*
+     * Compare packed single-precision (32-bit) floating-point elements in a and b, and store the results in a mask.
+     * These are the native AVX512 comparisons, used by mod to avoid the and/or sequence of NORML_MOD.
+     */
+    static INLINE CONST mask_t eq_mask(const vect_t a, const vect_t b) { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+
+    static INLINE CONST mask_t lesser_mask(const vect_t a, const vect_t b) {
+        return _mm512_cmp_ps_mask(a, b, _CMP_LT_OS);
+    }
+
+    static INLINE CONST mask_t greater_mask(const vect_t a, const vect_t b) {
+        return _mm512_cmp_ps_mask(a, b, _CMP_GT_OS);
+    }
+
+    /*
+     * Compare packed single-precision (32-bit) floating-point elements in a and b for equality, and store the results
+     in vect_t.
+     * Args   : [a0, ..., a15], [b0, ..., b15]
+     * Return : [(a0==b0) ? 0xFFFFFFFF : 0, ..., (a15==b15) ? 0xFFFFFFFF : 0]
+     */
+    static INLINE CONST vect_t eq(const vect_t a, const vect_t b) { return mask_to_vect(eq_mask(a, b)); }
+
+    /*
+     * Compare packed single-precision (32-bit) floating-point elements in a and b for lesser-than, and store the
+     results in vect_t.
+     * Args   : [a0, ..., a15], [b0, ..., b15]
+     * Return : [(a0<b0) ? 0xFFFFFFFF : 0, ..., (a15<b15) ? 0xFFFFFFFF : 0]
+     */
+    static INLINE CONST vect_t lesser(const vect_t a, const vect_t b) { return mask_to_vect(lesser_mask(a, b)); }
+
+    /*
+     * Compare packed single-precision (32-bit) floating-point elements in a and b for lesser or equal than, and store
+     the results in vect_t.
+     * Args   : [a0, ..., a15], [b0, ..., b15]
+     * Return : [(a0<=b0) ? 0xFFFFFFFF : 0, ..., (a15<=b15) ? 0xFFFFFFFF : 0]
+     */
+    static INLINE CONST vect_t lesser_eq(const vect_t a, const vect_t b) {
+        return mask_to_vect(_mm512_cmp_ps_mask(a, b, _CMP_LE_OS));
+    }
+
+    /*
+     * Compare packed single-precision (32-bit) floating-point elements in a and b for greater-than, and store the
+     results in vect_t.
+     * Args   : [a0, ..., a15], [b0, ..., b15]
+     * Return : [(a0>b0) ? 0xFFFFFFFF : 0, ..., (a15>b15) ? 0xFFFFFFFF : 0]
+     */
+    static INLINE CONST vect_t greater(const vect_t a, const vect_t b) { return mask_to_vect(greater_mask(a, b)); }
+
+    /*
+     * Compare packed single-precision (32-bit) floating-point elements in a and b for greater or equal than, and store
+     the results in vect_t.
+     * Args   : [a0, ..., a15], [b0, ..., b15]
+     * Return : [(a0>=b0) ? 0xFFFFFFFF : 0, ..., (a15>=b15) ? 0xFFFFFFFF : 0]
+     */
+    static INLINE CONST vect_t greater_eq(const vect_t a, const vect_t b) {
+        return mask_to_vect(_mm512_cmp_ps_mask(a, b, _CMP_GE_OS));
+    }
+
+    /*
+     * Compute the bitwise AND of packed single-precision (32-bit) floating-point elements in a and b, and store the
+     * results in vect_t.
+     * (_mm512_and_ps needs AVX512DQ, the integer version only needs AVX512F)
+     * Args   : [a0, ..., a15], [b0, ..., b15]
+     * Return : [a0 AND b0, ..., a15 AND b15]
+     */
+    static INLINE CONST vect_t vand(const vect_t a, const vect_t b) {
+        return _mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(a), _mm512_castps_si512(b)));
+    }
+
+    /*
+     * Compute the bitwise OR of packed single-precision (32-bit) floating-point elements in a and b, and store the
+     * results in vect_t.
+     * Args   : [a0, ..., a15], [b0, ..., b15]
+     * Return : [a0 OR b0, ..., a15 OR b15]
+     */
+    static INLINE CONST vect_t vor(const vect_t a, const vect_t b) {
+        return _mm512_castsi512_ps(_mm512_or_si512(_mm512_castps_si512(a), _mm512_castps_si512(b)));
+    }
+
+    /*
+     * Compute the bitwise XOR of packed single-precision (32-bit) floating-point elements in a and b, and store the
+     * results in vect_t.
+     * Args   : [a0, ..., a15], [b0, ..., b15]
+     * Return : [a0 XOR b0, ..., a15 XOR b15]
+     */
+    static INLINE CONST vect_t vxor(const vect_t a, const vect_t b) {
+        return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(a), _mm512_castps_si512(b)));
+    }
+
+    /*
+     * Compute the bitwise AND NOT of packed single-precision (32-bit) floating-point elements in a and b, and store the
+     * results in vect_t.
+     * Args   : [a0, ..., a15], [b0, ..., b15]
+     * Return : [a0 AND NOT b0, ..., a15 AND NOT b15]
+     */
+    static INLINE CONST vect_t vandnot(const vect_t a, const vect_t b) {
+        return _mm512_castsi512_ps(_mm512_andnot_si512(_mm512_castps_si512(a), _mm512_castps_si512(b)));
+    }
+
+    /*
+     * Round the packed single-precision (32-bit) floating-point elements in a down to an integer value, and store the
+     * results as packed single-precision floating-point elements in vect_t.
+     * Args   : [a0, ..., a15]
+     * Return : [floor(a0), ..., floor(a15)]
+     */
+    static INLINE CONST vect_t floor(const vect_t a) {
+        return _mm512_roundscale_ps(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+    }
+
+    /*
+     * Round the packed single-precision (32-bit) floating-point elements in a up to an integer value, and store the
+     * results as packed single-precision floating-point elements in vect_t.
+     * Args   : [a0, ..., a15]
+     * Return : [ceil(a0), ..., ceil(a15)]
+     */
+    static INLINE CONST vect_t ceil(const vect_t a) {
+        return _mm512_roundscale_ps(a, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC);
+    }
+
+    /*
+     * Round the packed single-precision (32-bit) floating-point elements in a, and store the results as packed
+     * single-precision floating-point elements in vect_t.
+     * Args   : [a0, ..., a15]
+     * Return : [round(a0), ..., round(a15)]
+     */
+    static INLINE CONST vect_t round(const vect_t a) {
+        return _mm512_roundscale_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    }
+
+    /*
+     * Horizontally add adjacent pairs of single-precision (32-bit) floating-point elements in a and b, and pack the
+     * results in vect_t (within each 128-bit lane, as _mm256_hadd_ps does).
+     * Args   : [a0, a1, a2, a3, ...], [b0, b1, b2, b3, ...]
+     * Return : [a0+a1, a2+a3, b0+b1, b2+b3, ...]
+     */
+    static INLINE CONST vect_t hadd(const vect_t a, const vect_t b) {
+        return add(_mm512_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)), _mm512_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+    }
+
+    /*
+     * Horizontally add single-precision (32-bit) floating-point elements in a.
+     * Args   : [a0, ..., a15]
+     * Return : a0+...+a15
+     */
+    static INLINE CONST scalar_t hadd_to_scal(const vect_t a) { return _mm512_reduce_add_ps(a); }
+
+    /*
+     * Reduce C modulo P, C is assumed to be an integer with |C| < 2^24.
+     * The normalisation into [MIN, MAX] uses masked additions instead of NORML_MOD.
+     */
+    static INLINE vect_t mod(vect_t &C, const vect_t &P, const vect_t &INVP, const vect_t &NEGP, const vect_t &MIN,
+                             const vect_t &MAX, vect_t &Q, vect_t &T) {
+        FLOAT_MOD(C, P, INVP, Q);
+        C = _mm512_mask_add_ps(C, greater_mask(C, MAX), C, NEGP);
+        C = _mm512_mask_add_ps(C, lesser_mask(C, MIN), C, P);
+        return C;
+    }
+
+  private:
+    template <class T>
+    static INLINE PURE vect_t gather_impl(const scalar_t *const p, const T *const idx,
+                                          std::integral_constant<size_t, 4>) {
+        return _mm512_i32gather_ps(_mm512_loadu_si512(reinterpret_cast<const void *>(idx)), p, 4);
+    }
+
+    template <class T>
+    static INLINE PURE vect_t gather_impl(const scalar_t *const p, const T *const idx,
+                                          std::integral_constant<size_t, 8>) {
+        __m256 lo = _mm512_i64gather_ps(_mm512_loadu_si512(reinterpret_cast<const void *>(idx)), p, 4);
+        __m256 hi = _mm512_i64gather_ps(_mm512_loadu_si512(reinterpret_cast<const void *>(idx + 8)), p, 4);
+        return _mm512_castpd_ps(
+            _mm512_insertf64x4(_mm512_castps_pd(_mm512_castps256_ps512(lo)), _mm256_castps_pd(hi), 1));
+    }
+
+    template <class T, size_t S>
+    static INLINE PURE vect_t gather_impl(const scalar_t *const p, const T *const idx,
+                                          std::integral_constant<size_t, S>) {
+        return set(p[idx[0]], p[idx[1]], p[idx[2]], p[idx[3]], p[idx[4]], p[idx[5]], p[idx[6]], p[idx[7]], p[idx[8]],
+                   p[idx[9]], p[idx[10]], p[idx[11]], p[idx[12]], p[idx[13]], p[idx[14]], p[idx[15]]);
+    }
+
+#else // __AVX512F__
+#error "You need AVX512F instructions to perform 512bits operations on float"
+#endif
+};
+
+#endif // __FFLASFFPACK_fflas_ffpack_utils_simd512_float_INL
@@ -0,0 +1,470 @@
+/* -*- mode: C++; tab-width: 8; indent-tabs-mode: t; c-basic-offset: 8 -*- */
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/*
+ * Copyright (C) 2016 the FFLAS-FFPACK group
+ *
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ *.
+ */
+
+#ifndef __FFLASFFPACK_fflas_ffpack_utils_simd512_int32_INL
+#define __FFLASFFPACK_fflas_ffpack_utils_simd512_int32_INL
+
+/*
+ * Simd512 specialized for int32_t
+ */
+template <> struct Simd512_impl<true, true, true, 4> {
+#if defined(__FFLASFFPACK_USE_AVX512F)
+    /*
+     * alias to 512 bit simd register
+     */
+    using vect_t = __m512i;
+
+    /*
+     * alias to 256 bit simd register
+     */
+    using half_t = __m256i;
+
+    /*
+     * alias to the mask register returned by AVX512 comparisons
+     */
+    using mask_t = __mmask16;
+
+    /*
+     * define the scalar type corresponding to the specialization
+     */
+    using scalar_t = int32_t;
+
+    /*
+     * Simd256 for scalar_t, to deal half_t
+     */
+    using simdHalf = Simd256<scalar_t>;
+
+    /*
+     *  number of scalar_t in a simd register
+     */
+    static const constexpr size_t vect_size = 16;
+
+    /*
+     *  alignement required by scalar_t pointer to be loaded in a vect_t
+     */
+    static const constexpr size_t alignment = 64;
+
+    /*
+     * Check if the pointer p is a multiple of alignemnt
+     */
+    template <class T> static constexpr bool valid(T *p) { return (int64_t)p % alignment == 0; }
+
+    /*
+     * Check if the number n is a multiple of vect_size
+     */
+    template <class T> static constexpr bool compliant(T n) { return n % vect_size == 0; }
+
+    /*
+     * Converter from vect_t to a tab.
+     * exple:
+     *		Converter conv;
+     *		conv.v = a;
+     *		scalart_t x = conv.t[1]
+     */
+    union Converter {
+        vect_t v;
+        scalar_t t[vect_size];
+    };
+
+    /*
+     *  Expand the mask m to a vect_t, lanes set in m are all ones, the others are zero.
+     *  Return [m0 ? 0xFFFFFFFF : 0, ..., m15 ? 0xFFFFFFFF : 0]
+     */
+    static INLINE CONST vect_t mask_to_vect(const mask_t m) { return _mm512_maskz_set1_epi32(m, -1); }
+
+    /*
+     *  Return vector of type vect_t with all elements set to zero
+     *  Return [0, ..., 0] int32_t
+     */
+    static INLINE CONST vect_t zero() { return _mm512_setzero_si512(); }
+
+    /*
+     *  Broadcast 32-bit integer a to all all elements of dst.
+     *  Return [x, ..., x] int32_t
+     */
+    static INLINE CONST vect_t set1(const scalar_t x) { return _mm512_set1_epi32(x); }
+
+    /*
+     *  Set packed 32-bit integers in dst with the supplied values.
+     *  Return [x0, ..., x15] int32_t
+     */
+    static INLINE CONST vect_t set(const scalar_t x0, const scalar_t x1, const scalar_t x2, const scalar_t x3,
+                                   const scalar_t x4, const scalar_t x5, const scalar_t x6, const scalar_t x7,
+                                   const scalar_t x8, const scalar_t x9, const scalar_t x10, const scalar_t x11,
+                                   const scalar_t x12, const scalar_t x13, const scalar_t x14, const scalar_t x15) {
+        return _mm512_set_epi32(x15, x14, x13, x12, x11, x10, x9, x8, x7, x6, x5, x4, x3, x2, x1, x0);
+    }
+
+    /*
+     *  Gather 32-bit integer elements with indexes idx[0], ..., idx[15] from the address p in vect_t.
+     *  Return [p[idx[0]], ..., p[idx[15]]] int32_t
+     */
+    template <class T> static INLINE PURE vect_t gather(const scalar_t *const p, const T *const idx) {
+        return gather_impl(p, idx, std::integral_constant<size_t, sizeof(T)>());
+    }
+
+    /*
+     * Load 512-bits of integer data from memory into dst.
+     * p must be aligned on a 64-byte boundary or a general-protection exception will be generated.
+     * Return [p[0], ..., p[15]] int32_t
+     */
+    static INLINE PURE vect_t load(const scalar_t *const p) {
+        return _mm512_load_si512(reinterpret_cast<const void *>(p));
+    }
+
+    /*
+     * Load 512-bits of integer data from memory into dst.
+     * p does not need to be aligned on any particular boundary.
+     * Return [p[0], ..., p[15]] int32_t
+     */
+    static INLINE PURE vect_t loadu(const scalar_t *const p) {
+        return _mm512_loadu_si512(reinterpret_cast<const void *>(p));
+    }
+
+    /*
+     * Store 512-bits of integer data from a into memory.
+     * p must be aligned on a 64-byte boundary or a general-protection exception will be generated.
+     */
+    static INLINE void store(const scalar_t *p, vect_t v) {
+        _mm512_store_si512(reinterpret_cast<void *>(const_cast<scalar_t *>(p)), v);
+    }
+
+    /*
+     * Store 512-bits of integer data from a into memory.
+     * p does not need to be aligned on any particular boundary.
+     */
+    static INLINE void storeu(const scalar_t *p, vect_t v) {
+        _mm512_storeu_si512(reinterpret_cast<void *>(const_cast<scalar_t *>(p)), v);
+    }
+
+    /*
+     * Store 512-bits of integer data from a into memory using a non-temporal memory hint.
+     * p must be aligned on a 64-byte boundary or a general-protection exception may be generated.
+     */
+    static INLINE void stream(const scalar_t *p, const vect_t v) {
+        _mm512_stream_si512(reinterpret_cast<vect_t *>(const_cast<scalar_t *>(p)), v);
+    }
+
+    /*
+     * Shift packed 32-bit integers in a left by s while shifting in zeros, and store the results in vect_t.
+     * Args   : [a0, ..., a15] int32_t
+     * Return : [a0 << s, ..., a15 << s] int32_t
+     */
+    static INLINE CONST vect_t sll(const vect_t a, const int s) { return _mm512_sll_epi32(a, _mm_cvtsi32_si128(s)); }
+
+    /*
+     * Shift packed 32-bit integers in a right by s while shifting in zeros, and store the results in vect_t.
+     * Args   : [a0, ..., a15] int32_t
+     * Return : [a0 >> s, ..., a15 >> s] int32_t
+     */
+    static INLINE CONST vect_t srl(const vect_t a, const int s) { return _mm512_srl_epi32(a, _mm_cvtsi32_si128(s)); }
+
+    static INLINE CONST vect_t sra(const vect_t a, const int s) { return _mm512_sra_epi32(a, _mm_cvtsi32_si128(s)); }
+
+    /*
+     * Add packed 32-bits integer in a and b, and store the results in vect_t.
+     * Args   : [a0, ..., a15] int32_t
+     [b0, ..., b15] int32_t
+     * Return : [a0+b0, ..., a15+b15] int32_t
+     */
+    static INLINE CONST vect_t add(const vect_t a, const vect_t b) { return _mm512_add_epi32(a, b); }
+
+    static INLINE vect_t addin(vect_t &a, const vect_t b) { return a = add(a, b); }
+
+    /*
+     * Subtract packed 32-bits integers in b from packed 32-bits integers in a, and store the results in vect_t.
+     * Args   : [a0, ..., a15] int32_t
+     [b0, ..., b15] int32_t
+     * Return : [a0-b0, ..., a15-b15] int32_t
+     */
+    static INLINE CONST vect_t sub(const vect_t a, const vect_t b) { return _mm512_sub_epi32(a, b); }
+
+    static INLINE vect_t subin(vect_t &a, const vect_t b) { return a = sub(a, b); }
+
+    /*
+     * Multiply the packed 32-bits integers in a and b, producing intermediate 64-bit integers, and store the low 32
+     bits of the intermediate integers in vect_t.
+     * Args   : [a0, ..., a15] int32_t
+     [b0, ..., b15] int32_t
+     * Return : [a0*b0 mod 2^32, ..., a15*b15 mod 2^32] int32_t
+     */
+    static INLINE CONST vect_t mullo(const vect_t a, const vect_t b) { return _mm512_mullo_epi32(a, b); }
+
+    static INLINE CONST vect_t mul(const vect_t a, const vect_t b) { return mullo(a, b); }
+
+    /*
+     * Multiply packed 32-bit integers in a and b, producing intermediate 64-bit integers, and add the low 32-bits of
+     the intermediate with c, and store the results in vect_t.
+     * Args   : [a0, ..., a15] int32_t
+     [b0, ..., b15] int32_t
+     [c0, ..., c15] int32_t
+     * Return : [(a0*b0 mod 2^32)+c0, ..., (a15*b15 mod 2^32)+c15]
+     */
+    static INLINE CONST vect_t fmadd(const vect_t c, const vect_t a, const vect_t b) { return add(c, mul(a, b)); }
+
+    static INLINE vect_t fmaddin(vect_t &c, const vect_t a, const vect_t b) { return c = fmadd(c, a, b); }
+
+    /*
+     * Multiply packed 32-bit integers in a and b, producing intermediate 64-bit integers, and substract the low 32-bits
+     of the intermediate to c, and store the results in vect_t.
+     * Args   : [a0, ..., a15] int32_t
+     [b0, ..., b15] int32_t
+     [c0, ..., c15] int32_t
+     * Return : [-(a0*b0 mod 2^32)+c0, ..., -(a15*b15 mod 2^32)+c15]
+     */
+    static INLINE CONST vect_t fnmadd(const vect_t c, const vect_t a, const vect_t b) { return sub(c, mul(a, b)); }
+
+    static INLINE vect_t fnmaddin(vect_t &c, const vect_t a, const vect_t b) { return c = fnmadd(c, a, b); }
+
+    /*
+     * Multiply packed 32-bit integers in a and b, producing intermediate 64-bit integers, and substract c to the low
+     32-bits of the intermediate, and store the results in vect_t.
+     * Args   : [a0, ..., a15] int32_t
+     [b0, ..., b15] int32_t
+     [c0, ..., c15] int32_t
+     * Return : [(a0*b0 mod 2^32)-c0, ..., (a15*b15 mod 2^32)-c15]
+     */
+    static INLINE CONST vect_t fmsub(const vect_t c, const vect_t a, const vect_t b) { return sub(mul(a, b), c); }
+
+    static INLINE vect_t fsubin(vect_t &c, const vect_t a, const vect_t b) { return c = fmsub(c, a, b); }
+
+    /*
+     * Multiply the packed 32-bits integers in a and b, producing intermediate 64-bit integers, and store the high 32
+     bits of the intermediate integers in vect_t.
+     * The even and odd lanes are multiplied separately with vpmuldq and merged back with a blend.
+     * Args   : [a0, ..., a15] int32_t
+     [b0, ..., b15] int32_t
+     * Return : [(a0*b0) >> 32, ..., (a15*b15) >> 32] int32_t
+     */
+    static INLINE CONST vect_t mulhi(const vect_t a, const vect_t b) {
+        vect_t even = _mm512_srli_epi64(_mm512_mul_epi32(a, b), 32);
+        vect_t odd = _mm512_mul_epi32(_mm512_srli_epi64(a, 32), _mm512_srli_epi64(b, 32));
+        return _mm512_mask_blend_epi32(0xAAAA, even, odd);
+    }
+
+    /*
+     * Multiply the low 16-bit integers from each packed 32-bit element in a and b, and store the signed 32-bit results
+     in dst.
+     * Args   : [a0, ..., a15] int32_t
+     [b0, ..., b15] int32_t
+     * Return : [a0*b0, ..., a15*b15] int32_t
+     */
+    static INLINE CONST vect_t mulx(vect_t a, vect_t b) {
+        vect_t mask = set1(0x0000FFFF);
+        a = vand(a, mask);
+        b = vand(b, mask);
+        return mullo(a, b);
+    }
+
+    /*
+     * Compare packed 32-bits in a and b for equality, and store the results in vect_t.
+     * Args   : [a0, ..., a15] int32_t
+     [b0, ..., b15] int32_t
+     * Return : [(a0==b0) ? 0xFFFFFFFF : 0, ..., (a15==b15) ? 0xFFFFFFFF : 0] int32_t
+     */
+    static INLINE CONST vect_t eq(const vect_t a, const vect_t b) { return mask_to_vect(_mm512_cmpeq_epi32_mask(a, b)); }
+
+    /*
+     * Compare packed 32-bits in a and b for greater-than, and store the results in vect_t.
+     * Args   : [a0, ..., a15] int32_t
+     [b0, ..., b15] int32_t
+     * Return : [(a0>b0) ? 0xFFFFFFFF : 0, ..., (a15>b15) ? 0xFFFFFFFF : 0] int32_t
+     */
+    static INLINE CONST vect_t greater(const vect_t a, const vect_t b) {
+        return mask_to_vect(_mm512_cmpgt_epi32_mask(a, b));
+    }
+
+    /*
+     * Compare packed 32-bits in a and b for lesser-than, and store the results in vect_t.
+     * Args   : [a0, ..., a15] int32_t
+     [b0, ..., b15] int32_t
+     * Return : [(a0<b0) ? 0xFFFFFFFF : 0, ..., (a15<b15) ? 0xFFFFFFFF : 0] int32_t
+     */
+    static INLINE CONST vect_t lesser(const vect_t a, const vect_t b) {
+        return mask_to_vect(_mm512_cmplt_epi32_mask(a, b));
+    }
+
+    /*
+     * Compare packed 32-bits in a and b for greater or equal than, and store the results in vect_t.
+     * Args   : [a0, ..., a15] int32_t
+     [b0, ..., b15] int32_t
+     * Return : [(a0>=b0) ? 0xFFFFFFFF : 0, ..., (a15>=b15) ? 0xFFFFFFFF : 0] int32_t
+     */
+    static INLINE CONST vect_t greater_eq(const vect_t a, const vect_t b) {
+        return mask_to_vect(_mm512_cmpge_epi32_mask(a, b));
+    }
+
+    /*
+     * Compare packed 32-bits in a and b for lesser or equal than, and store the results in vect_t.
+     * Args   : [a0, ..., a15] int32_t
+     [b0, ..., b15] int32_t
+     * Return : [(a0<=b0) ? 0xFFFFFFFF : 0, ..., (a15<=b15) ? 0xFFFFFFFF : 0] int32_t
+     */
+    static INLINE CONST vect_t lesser_eq(const vect_t a, const vect_t b) {
+        return mask_to_vect(_mm512_cmple_epi32_mask(a, b));
+    }
+
+    /*
+     * Compute the bitwise AND of packed 32-bits integer in a and b, and store the results in vect_t.
+     * Args   : [a0, ..., a15]
+     [b0, ..., b15]
+     * Return : [a0 AND b0, ..., a15 AND b15]
+     */
+    static INLINE CONST vect_t vand(const vect_t a, const vect_t b) { return _mm512_and_si512(b, a); }
+
+    /*
+     * Compute the bitwise OR of packed 32-bits integer in a and b, and store the results in vect_t.
+     * Args   : [a0, ..., a15]
+     [b0, ..., b15]
+     * Return : [a0 OR b0, ..., a15 OR b15]
+     */
+    static INLINE CONST vect_t vor(const vect_t a, const vect_t b) { return _mm512_or_si512(b, a); }
+
+    /*
+     * Compute the bitwise XOR of packed 32-bits integer in a and b, and store the results in vect_t.
+     * Args   : [a0, ..., a15]
+     [b0, ..., b15]
+     * Return : [a0 XOR b0, ..., a15 XOR b15]
+     */
+    static INLINE CONST vect_t vxor(const vect_t a, const vect_t b) { return _mm512_xor_si512(b, a); }
+
+    /*
+     * Compute the bitwise AND NOT of packed 32-bits integer in a and b, and store the results in vect_t.
+     * Args   : [a0, ..., a15]
+     [b0, ..., b15]
+     * Return : [a0 ANDNOT b0, ..., a15 ANDNOT b15]
+     */
+    static INLINE CONST vect_t vandnot(const vect_t a, const vect_t b) { return _mm512_andnot_si512(b, a); }
+
+    /*
+     * Horizontally add 32-bits elements of a.
+     * Args   : [a0, ..., a15]
+     * Return : a0+...+a15
+     */
+    static INLINE CONST scalar_t hadd_to_scal(const vect_t a) { return _mm512_reduce_add_epi32(a); }
+
+    static INLINE PURE half_t load_half(const scalar_t *const p) { return simdHalf::load(p); }
+
+    static INLINE PURE half_t loadu_half(const scalar_t *const p) { return simdHalf::loadu(p); }
+
+    static INLINE void store_half(const scalar_t *p, half_t v) { simdHalf::store(p, v); }
+
+    static INLINE void storeu_half(const scalar_t *p, half_t v) { simdHalf::storeu(p, v); }
+
+    /*
+     *
+     * Args   : [a0, ..., a15] int32_t
+     [b0, ..., b15] int32_t
+     [c0, ..., c15] int32_t
+     * Return : [c0+lo16(a0)*lo16(b0), ..., c15+lo16(a15)*lo16(b15)] int32_t
+     */
+    static INLINE CONST vect_t fmaddx(vect_t c, const vect_t a, const vect_t b) { return add(c, mulx(a, b)); }
+
+    static INLINE vect_t fmaddxin(vect_t &c, const vect_t a, const vect_t b) { return c = fmaddx(c, a, b); }
+
+    static INLINE CONST vect_t fnmaddx(const vect_t c, const vect_t a, const vect_t b) { return sub(c, mulx(a, b)); }
+
+    static INLINE vect_t fnmaddxin(vect_t &c, const vect_t a, const vect_t b) { return c = fnmaddx(c, a, b); }
+
+    static INLINE CONST vect_t round(const vect_t a) { return a; }
+
+    static INLINE CONST vect_t signbits(const vect_t x) { return sra(x, 31); }
+
+    /*
+     * Reduce C modulo P.
+     * The quotient is computed in double precision (exact for 32 bits integers) on both halves of C,
+     * then the remainder is normalised into [MIN, MAX] with masked additions.
+     */
+    static INLINE vect_t mod(vect_t &C, const vect_t &P, const vect_t &INVP, const vect_t &NEGP, const vect_t &MIN,
+                             const vect_t &MAX, vect_t &Q, vect_t &T) {
+#ifdef __INTEL_COMPILER
+        C = _mm512_rem_epi32(C, P);
+#else
+        __m512d c_lo = _mm512_cvtepi32_pd(_mm512_castsi512_si256(C));
+        __m512d c_hi = _mm512_cvtepi32_pd(_mm512_extracti64x4_epi64(C, 1));
+        __m512d p_lo = _mm512_cvtepi32_pd(_mm512_castsi512_si256(P));
+        __m512d p_hi = _mm512_cvtepi32_pd(_mm512_extracti64x4_epi64(P, 1));
+        c_lo = _mm512_roundscale_pd(_mm512_div_pd(c_lo, p_lo), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+        c_hi = _mm512_roundscale_pd(_mm512_div_pd(c_hi, p_hi), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+        Q = _mm512_inserti64x4(_mm512_castsi256_si512(_mm512_cvtpd_epi32(c_lo)), _mm512_cvtpd_epi32(c_hi), 1);
+        C = sub(C, mullo(Q, P));
+#endif
+        C = _mm512_mask_add_epi32(C, _mm512_cmpgt_epi32_mask(C, MAX), C, NEGP);
+        C = _mm512_mask_add_epi32(C, _mm512_cmplt_epi32_mask(C, MIN), C, P);
+        return C;
+    }
+
+  private:
+    template <class T>
+    static INLINE PURE vect_t gather_impl(const scalar_t *const p, const T *const idx,
+                                          std::integral_constant<size_t, 4>) {
+        return _mm512_i32gather_epi32(_mm512_loadu_si512(reinterpret_cast<const void *>(idx)), p, 4);
+    }
+
+    template <class T, size_t S>
+    static INLINE PURE vect_t gather_impl(const scalar_t *const p, const T *const idx,
+                                          std::integral_constant<size_t, S>) {
+        return set(p[idx[0]], p[idx[1]], p[idx[2]], p[idx[3]], p[idx[4]], p[idx[5]], p[idx[6]], p[idx[7]], p[idx[8]],
+                   p[idx[9]], p[idx[10]], p[idx[11]], p[idx[12]], p[idx[13]], p[idx[14]], p[idx[15]]);
+    }
+
+#else
+
+#error "You need AVX512F instructions to perform 512bits operations on int32_t"
+
+#endif // defined(__FFLASFFPACK_USE_AVX512F)
+};
+
+// uint32_t
+template <> struct Simd512_impl<true, true, false, 4> : public Simd512_impl<true, true, true, 4> {
+#if defined(__FFLASFFPACK_USE_AVX512F)
+
+    using scalar_t = uint32_t;
+
+    static INLINE CONST vect_t greater(const vect_t a, const vect_t b) {
+        return mask_to_vect(_mm512_cmpgt_epu32_mask(a, b));
+    }
+
+    static INLINE CONST vect_t lesser(const vect_t a, const vect_t b) {
+        return mask_to_vect(_mm512_cmplt_epu32_mask(a, b));
+    }
+
+    static INLINE CONST vect_t greater_eq(const vect_t a, const vect_t b) {
+        return mask_to_vect(_mm512_cmpge_epu32_mask(a, b));
+    }
+
+    static INLINE CONST vect_t lesser_eq(const vect_t a, const vect_t b) {
+        return mask_to_vect(_mm512_cmple_epu32_mask(a, b));
+    }
+
+#else
+
+#error "You need AVX512F instructions to perform 512bits operations on uint32_t"
+
+#endif // defined(__FFLASFFPACK_USE_AVX512F)
+};
+
+#endif // __FFLASFFPACK_fflas_ffpack_utils_simd512_int32_INL
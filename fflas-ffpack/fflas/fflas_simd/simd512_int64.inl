@@ -0,0 +1,540 @@
+/* -*- mode: C++; tab-width: 8; indent-tabs-mode: t; c-basic-offset: 8 -*- */
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/*
+ * Copyright (C) 2016 the FFLAS-FFPACK group
+ *
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ *.
+ */
+
+#ifndef __FFLASFFPACK_fflas_ffpack_utils_simd512_int64_INL
+#define __FFLASFFPACK_fflas_ffpack_utils_simd512_int64_INL
+
+/*
+ * Simd512 specialized for int64_t
+ */
+template <> struct Simd512_impl<true, true, true, 8> {
+
+#if defined(__FFLASFFPACK_USE_AVX512F)
+    /*
+     * alias to 512 bit simd register
+     */
+    using vect_t = __m512i;
+
+    /*
+     * alias to 256 bit simd register
+     */
+    using half_t = __m256i;
+
+    /*
+     * alias to the mask register returned by AVX512 comparisons
+     */
+    using mask_t = __mmask8;
+
+    /*
+     * define the scalar type corresponding to the specialization
+     */
+    using scalar_t = int64_t;
+
+    /*
+     * Simd256 for scalar_t, to deal half_t
+     */
+    using simdHalf = Simd256<scalar_t>;
+
+    /*
+     *  number of scalar_t in a simd register
+     */
+    static const constexpr size_t vect_size = 8;
+
+    /*
+     *  alignement required by scalar_t pointer to be loaded in a vect_t
+     */
+    static const constexpr size_t alignment = 64;
+
+    /*
+     * Check if the pointer p is a multiple of alignemnt
+     */
+    template <class T> static constexpr bool valid(T *p) { return (int64_t)p % alignment == 0; }
+
+    /*
+     * Check if the number n is a multiple of vect_size
+     */
+    template <class T> static constexpr bool compliant(T n) { return n % vect_size == 0; }
+
+    /*
+     * Converter from vect_t to a tab.
+     * exple:
+     *		Converter conv;
+     *		conv.v = a;
+     *		scalar_t x = conv.t[i]
+     */
+    union Converter {
+        vect_t v;
+        scalar_t t[vect_size];
+    };
+
+    /*
+     *  Expand the mask m to a vect_t, lanes set in m are all ones, the others are zero.
+     *  Return [m0 ? 0xFFFFFFFFFFFFFFFF : 0, ..., m7 ? 0xFFFFFFFFFFFFFFFF : 0]
+     */
+    static INLINE CONST vect_t mask_to_vect(const mask_t m) { return _mm512_maskz_set1_epi64(m, -1); }
+
+    /*
+     *  Return vector of type vect_t with all elements set to zero
+     *  Return [0,0,0,0,0,0,0,0] int64_t
+     */
+    static INLINE CONST vect_t zero() { return _mm512_setzero_si512(); }
+
+    /*
+     *  Broadcast 64-bit integer a to all all elements of dst.
+     *  Return [x,x,x,x,x,x,x,x] int64_t
+     */
+    static INLINE CONST vect_t set1(const scalar_t x) { return _mm512_set1_epi64(x); }
+
+    /*
+     *  Set packed 64-bit integers in dst with the supplied values.
+     *  Return [x0,x1,x2,x3,x4,x5,x6,x7] int64_t
+     */
+    static INLINE CONST vect_t set(const scalar_t x0, const scalar_t x1, const scalar_t x2, const scalar_t x3,
+                                   const scalar_t x4, const scalar_t x5, const scalar_t x6, const scalar_t x7) {
+        return _mm512_set_epi64(x7, x6, x5, x4, x3, x2, x1, x0);
+    }
+
+    /*
+     *  Gather 64-bit integer elements with indexes idx[0], ..., idx[7] from the address p in vect_t.
+     *  Return [p[idx[0]], ..., p[idx[7]]] int64_t
+     */
+    template <class T> static INLINE PURE vect_t gather(const scalar_t *const p, const T *const idx) {
+        return gather_impl(p, idx, std::integral_constant<size_t, sizeof(T)>());
+    }
+
+    /*
+     * Load 512-bits of integer data from memory into dst.
+     * p must be aligned on a 64-byte boundary or a general-protection exception will be generated.
+     * Return [p[0],...,p[7]] int64_t
+     */
+    static INLINE PURE vect_t load(const scalar_t *const p) {
+        return _mm512_load_si512(reinterpret_cast<const void *>(p));
+    }
+
+    /*
+     * Load 512-bits of integer data from memory into dst.
+     * p does not need to be aligned on any particular boundary.
+     * Return [p[0],...,p[7]] int64_t
+     */
+    static INLINE PURE vect_t loadu(const scalar_t *const p) {
+        return _mm512_loadu_si512(reinterpret_cast<const void *>(p));
+    }
+
+    /*
+     * Store 512-bits of integer data from a into memory.
+     * p must be aligned on a 64-byte boundary or a general-protection exception will be generated.
+     */
+    static INLINE void store(const scalar_t *p, vect_t v) {
+        _mm512_store_si512(reinterpret_cast<void *>(const_cast<scalar_t *>(p)), v);
+    }
+
+    /*
+     * Store 512-bits of integer data from a into memory.
+     * p does not need to be aligned on any particular boundary.
+     */
+    static INLINE void storeu(const scalar_t *p, vect_t v) {
+        _mm512_storeu_si512(reinterpret_cast<void *>(const_cast<scalar_t *>(p)), v);
+    }
+
+    /*
+     * Store 512-bits of integer data from a into memory using a non-temporal memory hint.
+     * p must be aligned on a 64-byte boundary or a general-protection exception may be generated.
+     */
+    static INLINE void stream(const scalar_t *p, const vect_t v) {
+        _mm512_stream_si512(reinterpret_cast<vect_t *>(const_cast<scalar_t *>(p)), v);
+    }
+
+    /*
+     * Add packed 64-bits integer in a and b, and store the results in vect_t.
+     * Args   : [a0, ..., a7] int64_t
+     [b0, ..., b7] int64_t
+     * Return : [a0+b0, ..., a7+b7] int64_t
+     */
+    static INLINE CONST vect_t add(const vect_t a, const vect_t b) { return _mm512_add_epi64(a, b); }
+
+    static INLINE vect_t addin(vect_t &a, const vect_t b) { return a = add(a, b); }
+
+    /*
+     * Subtract packed 64-bits integers in b from packed 64-bits integers in a, and store the results in vect_t.
+     * Args   : [a0, ..., a7] int64_t
+     [b0, ..., b7] int64_t
+     * Return : [a0-b0, ..., a7-b7] int64_t
+     */
+    static INLINE CONST vect_t sub(const vect_t a, const vect_t b) { return _mm512_sub_epi64(a, b); }
+
+    static INLINE vect_t subin(vect_t &a, const vect_t b) { return a = sub(a, b); }
+
+    /*
+     * Shift packed 64-bit integers in a left by s while shifting in zeros, and store the results in vect_t.
+     * Args   : [a0, ..., a7] int64_t
+     * Return : [a0 << s, ..., a7 << s] int64_t
+     */
+    static INLINE CONST vect_t sll(const vect_t a, const int s) { return _mm512_sll_epi64(a, _mm_cvtsi32_si128(s)); }
+
+    /*
+     * Shift packed 64-bit integers in a right by s while shifting in zeros, and store the results in vect_t.
+     * Args   : [a0, ..., a7] int64_t
+     * Return : [a0 >> s, ..., a7 >> s] int64_t
+     */
+    static INLINE CONST vect_t srl(const vect_t a, const int s) { return _mm512_srl_epi64(a, _mm_cvtsi32_si128(s)); }
+
+    /*
+     * Shift packed 64-bit integers in a right by s while shifting in sign bits, and store the results in vect_t.
+     * AVX512F has a native 64 bits arithmetic shift.
+     * Args   : [a0, ..., a7] int64_t
+     * Return : [a0 >> s, ..., a7 >> s] int64_t
+     */
+    static INLINE CONST vect_t sra(const vect_t a, const int s) { return _mm512_sra_epi64(a, _mm_cvtsi32_si128(s)); }
+
+    /*
+     * Multiply the packed 64-bits integers in a and b, producing intermediate 128-bit integers, and store the low 64
+     bits of the intermediate integers in vect_t.
+     * vpmullq needs AVX512DQ, otherwise the product is recombined from three 32x32 bits products.
+     * Args   : [a0, ..., a7] int64_t
+     [b0, ..., b7] int64_t
+     * Return : [a0*b0 mod 2^64, ..., a7*b7 mod 2^64] int64_t
+     */
+    static INLINE CONST vect_t mullo(const vect_t a, const vect_t b) {
+#ifdef __AVX512DQ__
+        return _mm512_mullo_epi64(a, b);
+#else
+        vect_t t = add(mulux(srl(a, 32), b), mulux(a, srl(b, 32)));
+        return add(mulux(a, b), sll(t, 32));
+#endif
+    }
+
+    static INLINE CONST vect_t mullox(const vect_t x0, const vect_t x1) { return _mm512_mullo_epi32(x0, x1); }
+
+    /*
+     * Multiply the packed 64-bits integers in a and b, producing intermediate 128-bit integers, and store the low 64
+     bits of the intermediate integers in vect_t.
+     * Args   : [a0, ..., a7] int64_t
+     [b0, ..., b7] int64_t
+     * Return : [a0*b0 mod 2^64, ..., a7*b7 mod 2^64] int64_t
+     */
+    static INLINE CONST vect_t mul(const vect_t a, const vect_t b) { return mullo(a, b); }
+
+    /*
+     * Multiply the packed 64-bits integers in a and b, producing intermediate 128-bit integers, and store the high 64
+     bits of the intermediate integers in vect_t.
+     * Args   : [a0, ..., a7] int64_t
+     [b0, ..., b7] int64_t
+     * Return : [(a0*b0) >> 64, ..., (a7*b7) >> 64] int64_t
+     */
+    static INLINE CONST vect_t mulhi(vect_t a, vect_t b) {
+        Converter ca, cb;
+        ca.v = a;
+        cb.v = b;
+        return set((int128_t(ca.t[0]) * cb.t[0]) >> 64, (int128_t(ca.t[1]) * cb.t[1]) >> 64,
+                   (int128_t(ca.t[2]) * cb.t[2]) >> 64, (int128_t(ca.t[3]) * cb.t[3]) >> 64,
+                   (int128_t(ca.t[4]) * cb.t[4]) >> 64, (int128_t(ca.t[5]) * cb.t[5]) >> 64,
+                   (int128_t(ca.t[6]) * cb.t[6]) >> 64, (int128_t(ca.t[7]) * cb.t[7]) >> 64);
+    }
+
+    /*
+     * Multiply packed 64-bit integers in a and b, producing intermediate 128-bit integers, and add the low 64-bits of
+     the intermediate with c, and store the results in vect_t.
+     * Args   : [a0, ..., a7] int64_t
+     [b0, ..., b7] int64_t
+     [c0, ..., c7] int64_t
+     * Return : [(a0*b0 mod 2^64)+c0, ..., (a7*b7 mod 2^64)+c7]
+     */
+    static INLINE CONST vect_t fmadd(const vect_t c, const vect_t a, const vect_t b) { return add(c, mul(a, b)); }
+
+    static INLINE vect_t fmaddin(vect_t &c, const vect_t a, const vect_t b) { return c = fmadd(c, a, b); }
+
+    /*
+     * Multiply packed 64-bit integers in a and b, producing intermediate 128-bit integers, and substract the low
+     64-bits of the intermediate to c, and store the results in vect_t.
+     * Args   : [a0, ..., a7] int64_t
+     [b0, ..., b7] int64_t
+     [c0, ..., c7] int64_t
+     * Return : [-(a0*b0 mod 2^64)+c0, ..., -(a7*b7 mod 2^64)+c7]
+     */
+    static INLINE CONST vect_t fnmadd(const vect_t c, const vect_t a, const vect_t b) { return sub(c, mul(a, b)); }
+
+    /*
+     * Multiply packed 64-bit integers in a and b, producing intermediate 128-bit integers, and substract c to the low
+     64-bits of the intermediate, and store the results in vect_t.
+     * Args   : [a0, ..., a7] int64_t
+     [b0, ..., b7] int64_t
+     [c0, ..., c7] int64_t
+     * Return : [(a0*b0 mod 2^64)-c0, ..., (a7*b7 mod 2^64)-c7]
+     */
+    static INLINE CONST vect_t fmsub(const vect_t c, const vect_t a, const vect_t b) { return sub(mul(a, b), c); }
+
+    /*
+     * Multiply the low 32-bits integers from each packed 64-bit element in a and b, and store the signed 64-bit results
+     in dst.
+     * Args   : [a0, ..., a7] int64_t
+     [b0, ..., b7] int64_t
+     * Return : [a0*b0, ..., a7*b7] int64_t
+     */
+    static INLINE CONST vect_t mulx(const vect_t a, const vect_t b) { return _mm512_mul_epi32(a, b); }
+
+    /*
+     * Multiply the low 32-bits integers from each packed 64-bit element in a and b, and store the unsigned 64-bit
+     results in dst.
+     * Args   : [a0, ..., a7] int64_t
+     [b0, ..., b7] int64_t
+     * Return : [a0*b0, ..., a7*b7] uint64_t
+     */
+    static INLINE CONST vect_t mulux(const vect_t a, const vect_t b) { return _mm512_mul_epu32(a, b); }
+
+    /*
+     * Compare packed 64-bits in a and b for equality, and store the results in vect_t.
+     * Args   : [a0, ..., a7] int64_t
+     [b0, ..., b7] int64_t
+     * Return : [(a0==b0) ? 0xFFFFFFFFFFFFFFFF : 0, ..., (a7==b7) ? 0xFFFFFFFFFFFFFFFF : 0] int64_t
+     */
+    static INLINE CONST vect_t eq(const vect_t a, const vect_t b) { return mask_to_vect(_mm512_cmpeq_epi64_mask(a, b)); }
+
+    /*
+     * Compare packed 64-bits in a and b for greater-than, and store the results in vect_t.
+     * Args   : [a0, ..., a7] int64_t
+     [b0, ..., b7] int64_t
+     * Return : [(a0>b0) ? 0xFFFFFFFFFFFFFFFF : 0, ..., (a7>b7) ? 0xFFFFFFFFFFFFFFFF : 0] int64_t
+     */
+    static INLINE CONST vect_t greater(const vect_t a, const vect_t b) {
+        return mask_to_vect(_mm512_cmpgt_epi64_mask(a, b));
+    }
+
+    /*
+     * Compare packed 64-bits in a and b for lesser-than, and store the results in vect_t.
+     * Args   : [a0, ..., a7] int64_t
+     [b0, ..., b7] int64_t
+     * Return : [(a0<b0) ? 0xFFFFFFFFFFFFFFFF : 0, ..., (a7<b7) ? 0xFFFFFFFFFFFFFFFF : 0] int64_t
+     */
+    static INLINE CONST vect_t lesser(const vect_t a, const vect_t b) {
+        return mask_to_vect(_mm512_cmplt_epi64_mask(a, b));
+    }
+
+    /*
+     * Compare packed 64-bits in a and b for greater or equal than, and store the results in vect_t.
+     * Args   : [a0, ..., a7] int64_t
+     [b0, ..., b7] int64_t
+     * Return : [(a0>=b0) ? 0xFFFFFFFFFFFFFFFF : 0, ..., (a7>=b7) ? 0xFFFFFFFFFFFFFFFF : 0] int64_t
+     */
+    static INLINE CONST vect_t greater_eq(const vect_t a, const vect_t b) {
+        return mask_to_vect(_mm512_cmpge_epi64_mask(a, b));
+    }
+
+    /*
+     * Compare packed 64-bits in a and b for lesser or equal than, and store the results in vect_t.
+     * Args   : [a0, ..., a7] int64_t
+     [b0, ..., b7] int64_t
+     * Return : [(a0<=b0) ? 0xFFFFFFFFFFFFFFFF : 0, ..., (a7<=b7) ? 0xFFFFFFFFFFFFFFFF : 0] int64_t
+     */
+    static INLINE CONST vect_t lesser_eq(const vect_t a, const vect_t b) {
+        return mask_to_vect(_mm512_cmple_epi64_mask(a, b));
+    }
+
+    /*
+     * Compute the bitwise AND of packed 64-bits integer in a and b, and store the results in vect_t.
+     * Args   : [a0, ..., a7]
+     [b0, ..., b7]
+     * Return : [a0 AND b0, ..., a7 AND b7]
+     */
+    static INLINE CONST vect_t vand(const vect_t a, const vect_t b) { return _mm512_and_si512(b, a); }
+
+    /*
+     * Compute the bitwise OR of packed 64-bits integer in a and b, and store the results in vect_t.
+     * Args   : [a0, ..., a7]
+     [b0, ..., b7]
+     * Return : [a0 OR b0, ..., a7 OR b7]
+     */
+    static INLINE CONST vect_t vor(const vect_t a, const vect_t b) { return _mm512_or_si512(b, a); }
+
+    /*
+     * Compute the bitwise XOR of packed 64-bits integer in a and b, and store the results in vect_t.
+     * Args   : [a0, ..., a7]
+     [b0, ..., b7]
+     * Return : [a0 XOR b0, ..., a7 XOR b7]
+     */
+    static INLINE CONST vect_t vxor(const vect_t a, const vect_t b) { return _mm512_xor_si512(b, a); }
+
+    /*
+     * Compute the bitwise AND NOT of packed 64-bits integer in a and b, and store the results in vect_t.
+     * Args   : [a0, ..., a7]
+     [b0, ..., b7]
+     * Return : [a0 ANDNOT b0, ..., a7 ANDNOT b7]
+     */
+    static INLINE CONST vect_t vandnot(const vect_t a, const vect_t b) { return _mm512_andnot_si512(b, a); }
+
+    /*
+     * Horizontally add 64-bits elements of a.
+     * Args   : [a0, ..., a7]
+     * Return : a0+a1+a2+a3+a4+a5+a6+a7
+     */
+    static INLINE CONST scalar_t hadd_to_scal(const vect_t a) { return _mm512_reduce_add_epi64(a); }
+
+    static INLINE PURE half_t load_half(const scalar_t *const p) { return simdHalf::load(p); }
+
+    static INLINE PURE half_t loadu_half(const scalar_t *const p) { return simdHalf::loadu(p); }
+
+    static INLINE void store_half(const scalar_t *p, half_t v) { simdHalf::store(p, v); }
+
+    static INLINE void storeu_half(const scalar_t *p, half_t v) { simdHalf::storeu(p, v); }
+
+    /*
+     *
+     * Args   : [a0, ..., a7] int64_t
+     [b0, ..., b7] int64_t
+     [c0, ..., c7] int64_t
+     * Return : [c0+lo32(a0)*lo32(b0), ..., c7+lo32(a7)*lo32(b7)] int64_t
+     */
+    static INLINE CONST vect_t fmaddx(const vect_t c, const vect_t a, const vect_t b) { return add(c, mulx(a, b)); }
+
+    static INLINE vect_t fmaddxin(vect_t &c, const vect_t a, const vect_t b) { return c = fmaddx(c, a, b); }
+
+    static INLINE CONST vect_t fnmaddx(const vect_t c, const vect_t a, const vect_t b) { return sub(c, mulx(a, b)); }
+
+    static INLINE vect_t fnmaddxin(vect_t &c, const vect_t a, const vect_t b) { return c = fnmaddx(c, a, b); }
+
+    static INLINE CONST vect_t round(const vect_t a) { return a; }
+
+    // mask the high 32 bits of a 64 bits, that is 00000000FFFFFFFF
+    static INLINE CONST vect_t mask_high() { return srl(set1(-1), 32); }
+
+    static INLINE CONST vect_t signbits(const vect_t x) { return sra(x, 63); }
+
+    // warning : may be off by 1 multiple, but we save a mul...
+    static INLINE CONST vect_t mulhi_fast(vect_t x, vect_t y) {
+        // unsigned mulhi starts:
+        // x1 = xy_high = mulhiu_fast(x,y)
+        const vect_t mask = mask_high();
+
+        vect_t x0 = vand(x, mask), x1 = srl(x, 32);
+        vect_t y0 = vand(y, mask), y1 = srl(y, 32);
+
+        x0 = mulux(x0, y1); // x0y1
+        y0 = mulux(x1, y0); // x1y0
+        y1 = mulux(x1, y1); // x1y1
+
+        x1 = vand(y0, mask);
+        y0 = srl(y0, 32); // x1y0_lo = x1 // y1yo_hi = y0
+        x1 = srl(add(x1, x0), 32);
+        y0 = add(y1, y0);
+
+        x1 = add(x1, y0);
+        // unsigned mulhi ends
+
+        // fixing signs
+        x0 = vand(signbits(x), y);
+        x1 = sub(x1, x0);
+        x0 = vand(signbits(y), x);
+        x1 = sub(x1, x0);
+        // end fixing
+        return x1;
+    }
+
+    template <bool overflow, bool poweroftwo>
+    static INLINE vect_t mod(vect_t &C, const vect_t &P, const int8_t &shifter, const vect_t &magic, const vect_t &NEGP,
+                             const vect_t &MIN, const vect_t &MAX, vect_t &Q, vect_t &T) {
+#ifdef __INTEL_COMPILER
+        C = _mm512_rem_epi64(C, P);
+#else
+        if (poweroftwo) {
+            Q = srl(C, 63);
+            vect_t un = set1(1);
+            T = sub(sll(un, shifter), un);
+            Q = add(C, vand(Q, T));
+            Q = sll(srl(Q, shifter), shifter);
+            C = sub(C, Q);
+            C = _mm512_mask_add_epi64(C, _mm512_cmpgt_epi64_mask(zero(), Q), C, P);
+        } else {
+            Q = mulhi_fast(C, magic);
+            if (overflow) {
+                Q = add(Q, C);
+            }
+            Q = sra(Q, shifter);
+            vect_t q1 = mulux(Q, P);
+            vect_t q2 = sll(mulux(srl(Q, 32), P), 32);
+            C = sub(C, add(q1, q2));
+            C = _mm512_mask_sub_epi64(C, _mm512_cmpge_epi64_mask(C, P), C, P);
+        }
+#endif
+        C = _mm512_mask_add_epi64(C, _mm512_cmpgt_epi64_mask(C, MAX), C, NEGP);
+        C = _mm512_mask_add_epi64(C, _mm512_cmplt_epi64_mask(C, MIN), C, P);
+        return C;
+    }
+
+  private:
+    template <class T>
+    static INLINE PURE vect_t gather_impl(const scalar_t *const p, const T *const idx,
+                                          std::integral_constant<size_t, 4>) {
+        return _mm512_i32gather_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(idx)), p, 8);
+    }
+
+    template <class T>
+    static INLINE PURE vect_t gather_impl(const scalar_t *const p, const T *const idx,
+                                          std::integral_constant<size_t, 8>) {
+        return _mm512_i64gather_epi64(_mm512_loadu_si512(reinterpret_cast<const void *>(idx)), p, 8);
+    }
+
+    template <class T, size_t S>
+    static INLINE PURE vect_t gather_impl(const scalar_t *const p, const T *const idx,
+                                          std::integral_constant<size_t, S>) {
+        return set(p[idx[0]], p[idx[1]], p[idx[2]], p[idx[3]], p[idx[4]], p[idx[5]], p[idx[6]], p[idx[7]]);
+    }
+
+#else
+
+#error "You need AVX512F instructions to perform 512bits operations on int64_t"
+
+#endif // defined(__FFLASFFPACK_USE_AVX512F)
+};
+
+// uint64_t
+template <> struct Simd512_impl<true, true, false, 8> : public Simd512_impl<true, true, true, 8> {
+    using scalar_t = uint64_t;
+
+#if defined(__FFLASFFPACK_USE_AVX512F)
+
+    static INLINE CONST vect_t greater(const vect_t a, const vect_t b) {
+        return mask_to_vect(_mm512_cmpgt_epu64_mask(a, b));
+    }
+
+    static INLINE CONST vect_t lesser(const vect_t a, const vect_t b) {
+        return mask_to_vect(_mm512_cmplt_epu64_mask(a, b));
+    }
+
+    static INLINE CONST vect_t greater_eq(const vect_t a, const vect_t b) {
+        return mask_to_vect(_mm512_cmpge_epu64_mask(a, b));
+    }
+
+    static INLINE CONST vect_t lesser_eq(const vect_t a, const vect_t b) {
+        return mask_to_vect(_mm512_cmple_epu64_mask(a, b));
+    }
+
+#else
+
+#error "You need AVX512F instructions to perform 512bits operations on uint64_t"
+
+#endif // defined(__FFLASFFPACK_USE_AVX512F)
+};
+
+#endif // __FFLASFFPACK_fflas_ffpack_utils_simd512_int64_INL
@@ -73,7 +73,7 @@
  #define assume_aligned(pout, pin, v) decltype(pin) pout = pin;
 #endif
 
-#define DENSE_THRESHOLD 0.5
+#define DENSE_THRESHOLD (FFLAS::tuning().sparse_dense_threshold)
 
 #include "fflas-ffpack/fflas/fflas.h"
 
@@ -116,7 +116,21 @@ enum class SparseMatrix_t {
     ELL_simd,
     ELL_simd_ZO,
     CSR_HYB,
-    HYB_ZO
+    HYB_ZO,
+    CSR_TILED,
+    AUTO
+};
+
+/* Symmetric reordering of a square matrix done by sparse_init, for the
+ * locality of the accesses to x in the products: the matrix is stored as
+ * P A P^T and the products permute x and y on the fly.
+ *  - NONE: A is stored as given;
+ *  - RCM: reverse Cuthill-McKee ordering of the graph of A + A^T, which
+ *    reduces the bandwidth of A.
+ */
+enum class SparseReordering {
+    NONE,
+    RCM
 };
 
 template <class Field, SparseMatrix_t, class IdxT = index_t, class PtrT = index_t> struct Sparse;
@@ -125,11 +139,14 @@ template <class Field, SparseMatrix_t, class IdxT = index_t, class PtrT = index_
 #include "fflas-ffpack/fflas/fflas_sparse/sparse_matrix_traits.h"
 #include "fflas-ffpack/fflas/fflas_sparse/utils.h"
 #include "fflas-ffpack/fflas/fflas_sparse/csr.h"
+#include "fflas-ffpack/fflas/fflas_sparse/csc.h"
 #include "fflas-ffpack/fflas/fflas_sparse/coo.h"
 #include "fflas-ffpack/fflas/fflas_sparse/ell.h"
 #include "fflas-ffpack/fflas/fflas_sparse/csr_hyb.h"
 #include "fflas-ffpack/fflas/fflas_sparse/ell_simd.h"
+#include "fflas-ffpack/fflas/fflas_sparse/sell.h"
 #include "fflas-ffpack/fflas/fflas_sparse/hyb_zo.h"
+#include "fflas-ffpack/fflas/fflas_sparse/csr_tiled.h"
 // #include "fflas-ffpack/fflas/fflas_sparse/sparse_matrix.h"
 
 namespace FFLAS {
@@ -340,29 +357,65 @@ inline void pfspmm(const Field &F, const SM &A, size_t blockSize, typename Field
 /*************************************
         pfspmv
 **************************************/
+
+template <class Field, class SM, class FC, class MZO>
+inline typename std::enable_if<
+    !(std::is_same<typename ElementTraits<typename Field::Element>::value, ElementCategories::MachineFloatTag>::value ||
+      std::is_same<typename ElementTraits<typename Field::Element>::value,
+                   ElementCategories::MachineIntTag>::value)>::type
+pfspmv_dispatch(const Field &F, const SM &A, typename Field::ConstElement_ptr x, typename Field::Element_ptr y, FC fc,
+                MZO mzo);
+
+template <class Field, class SM, class FC, class MZO>
+inline typename std::enable_if<
+    std::is_same<typename ElementTraits<typename Field::Element>::value, ElementCategories::MachineFloatTag>::value ||
+    std::is_same<typename ElementTraits<typename Field::Element>::value, ElementCategories::MachineIntTag>::value>::type
+pfspmv_dispatch(const Field &F, const SM &A, typename Field::ConstElement_ptr x, typename Field::Element_ptr y, FC fc,
+                MZO mzo);
+
+// non ZO matrix
 template <class Field, class SM>
 inline void pfspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
-                   FieldCategories::GenericTag, std::false_type);
+                   FieldCategories::GenericTag, NotZOSparseMatrix);
 
 template <class Field, class SM>
-inline void pfspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
-                   FieldCategories::UnparametricTag, std::false_type);
+inline typename std::enable_if<!isSparseMatrixSimdFormat<Field, SM>::value>::type
+pfspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
+       FieldCategories::UnparametricTag, NotZOSparseMatrix);
 
 template <class Field, class SM>
-inline void pfspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
-                   FieldCategories::ModularTag, std::false_type);
+inline typename std::enable_if<isSparseMatrixSimdFormat<Field, SM>::value>::type
+pfspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
+       FieldCategories::UnparametricTag, NotZOSparseMatrix);
 
 template <class Field, class SM>
-inline void pfspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
-                   FieldCategories::GenericTag, std::true_type);
+inline typename std::enable_if<!isSparseMatrixSimdFormat<Field, SM>::value>::type
+pfspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
+       FieldCategories::ModularTag, NotZOSparseMatrix);
+
+template <class Field, class SM>
+inline typename std::enable_if<isSparseMatrixSimdFormat<Field, SM>::value>::type
+pfspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
+       FieldCategories::ModularTag, NotZOSparseMatrix);
 
+// ZO matrix
 template <class Field, class SM>
 inline void pfspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
-                   FieldCategories::UnparametricTag, std::true_type);
+                   FieldCategories::GenericTag, ZOSparseMatrix);
+
+template <class Field, class SM>
+inline typename std::enable_if<!isSparseMatrixSimdFormat<Field, SM>::value>::type
+pfspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
+       FieldCategories::UnparametricTag, ZOSparseMatrix);
+
+template <class Field, class SM>
+inline typename std::enable_if<isSparseMatrixSimdFormat<Field, SM>::value>::type
+pfspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
+       FieldCategories::UnparametricTag, ZOSparseMatrix);
 
 template <class Field, class SM>
 inline void pfspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
-                   FieldCategories::ModularTag, std::true_type);
+                   FieldCategories::ModularTag, ZOSparseMatrix);
 
 } // sparse_details
 
@@ -389,11 +442,161 @@ template <class Field, class SM>
 inline void pfspmm(const Field &F, const SM &A, size_t blockSize, typename Field::ConstElement_ptr x, int ldx,
                    const typename Field::Element &beta, typename Field::Element_ptr y, int ldy);
 #endif
+
+/* Same products, sequential or parallel as in the dense routines: a
+ * ParSeqHelper::Parallel helper runs pfspmv/pfspmm with its number of
+ * threads, and the sequential kernels when it has a single thread or when
+ * OpenMP is not available.
+ */
+template <class Field, class SM>
+inline void fspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, const typename Field::Element &beta,
+                  typename Field::Element_ptr y, const ParSeqHelper::Sequential &);
+
+template <class Field, class SM, class Cut, class Param>
+inline void fspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, const typename Field::Element &beta,
+                  typename Field::Element_ptr y, const ParSeqHelper::Parallel<Cut, Param> &H);
+
+template <class Field, class SM>
+inline void fspmm(const Field &F, const SM &A, size_t blockSize, typename Field::ConstElement_ptr x, int ldx,
+                  const typename Field::Element &beta, typename Field::Element_ptr y, int ldy,
+                  const ParSeqHelper::Sequential &);
+
+template <class Field, class SM, class Cut, class Param>
+inline void fspmm(const Field &F, const SM &A, size_t blockSize, typename Field::ConstElement_ptr x, int ldx,
+                  const typename Field::Element &beta, typename Field::Element_ptr y, int ldy,
+                  const ParSeqHelper::Parallel<Cut, Param> &H);
+
+#if !defined(__FFLASFFPACK_USE_OPENMP)
+/* The SELL kernels split their chunks through paladin, so that SELL and
+ * SELL_ZO have parallel products with the TBB and native backends too, with
+ * the threads of the backend.
+ */
+template <class Field, class Cut, class Param>
+inline void fspmv(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, typename Field::ConstElement_ptr x,
+                  const typename Field::Element &beta, typename Field::Element_ptr y,
+                  const ParSeqHelper::Parallel<Cut, Param> &H);
+
+template <class Field, class Cut, class Param>
+inline void fspmv(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A, typename Field::ConstElement_ptr x,
+                  const typename Field::Element &beta, typename Field::Element_ptr y,
+                  const ParSeqHelper::Parallel<Cut, Param> &H);
+
+template <class Field, class Cut, class Param>
+inline void fspmm(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, size_t blockSize,
+                  typename Field::ConstElement_ptr x, int ldx, const typename Field::Element &beta,
+                  typename Field::Element_ptr y, int ldy, const ParSeqHelper::Parallel<Cut, Param> &H);
+
+template <class Field, class Cut, class Param>
+inline void fspmm(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A, size_t blockSize,
+                  typename Field::ConstElement_ptr x, int ldx, const typename Field::Element &beta,
+                  typename Field::Element_ptr y, int ldy, const ParSeqHelper::Parallel<Cut, Param> &H);
+#endif
+
+/*********************************************************************************************************************
+ *
+ *    Transposed SpMV, SpMM: y <- beta y + A^T x, for A m x n, x with m rows and y with n rows
+ *    CSR and CSC use the kernels of each other on the same arrays, ELL, SELL and SELL_ZO scatter their rows
+ *
+ *********************************************************************************************************************/
+
+template <class Field, class SM>
+inline void fspmv_transpose(const Field &F, const SM &A, typename Field::ConstElement_ptr x,
+                            const typename Field::Element &beta, typename Field::Element_ptr y);
+
+template <class Field>
+inline void fspmv_transpose(const Field &F, const Sparse<Field, SparseMatrix_t::ELL> &A,
+                            typename Field::ConstElement_ptr x, const typename Field::Element &beta,
+                            typename Field::Element_ptr y);
+
+template <class Field, class SM>
+inline void fspmm_transpose(const Field &F, const SM &A, size_t blockSize, typename Field::ConstElement_ptr x, int ldx,
+                            const typename Field::Element &beta, typename Field::Element_ptr y, int ldy);
+
+template <class Field>
+inline void fspmm_transpose(const Field &F, const Sparse<Field, SparseMatrix_t::ELL> &A, size_t blockSize,
+                            typename Field::ConstElement_ptr x, int ldx, const typename Field::Element &beta,
+                            typename Field::Element_ptr y, int ldy);
+
+template <class Field>
+inline void fspmv_transpose(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A,
+                            typename Field::ConstElement_ptr x, const typename Field::Element &beta,
+                            typename Field::Element_ptr y);
+
+template <class Field>
+inline void fspmv_transpose(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A,
+                            typename Field::ConstElement_ptr x, const typename Field::Element &beta,
+                            typename Field::Element_ptr y);
+
+template <class Field>
+inline void fspmm_transpose(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, size_t blockSize,
+                            typename Field::ConstElement_ptr x, int ldx, const typename Field::Element &beta,
+                            typename Field::Element_ptr y, int ldy);
+
+template <class Field>
+inline void fspmm_transpose(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A, size_t blockSize,
+                            typename Field::ConstElement_ptr x, int ldx, const typename Field::Element &beta,
+                            typename Field::Element_ptr y, int ldy);
+
+#if defined(__FFLASFFPACK_USE_OPENMP)
+template <class Field, class SM>
+inline void pfspmv_transpose(const Field &F, const SM &A, typename Field::ConstElement_ptr x,
+                             const typename Field::Element &beta, typename Field::Element_ptr y);
+
+template <class Field, class SM>
+inline void pfspmm_transpose(const Field &F, const SM &A, size_t blockSize, typename Field::ConstElement_ptr x, int ldx,
+                             const typename Field::Element &beta, typename Field::Element_ptr y, int ldy);
+
+// SELL and SELL_ZO: one copy of y per thread for pfspmv_transpose, the columns split among the threads for pfspmm_transpose
+template <class Field>
+inline void pfspmv_transpose(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A,
+                             typename Field::ConstElement_ptr x, const typename Field::Element &beta,
+                             typename Field::Element_ptr y);
+
+template <class Field>
+inline void pfspmv_transpose(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A,
+                             typename Field::ConstElement_ptr x, const typename Field::Element &beta,
+                             typename Field::Element_ptr y);
+
+template <class Field>
+inline void pfspmm_transpose(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, size_t blockSize,
+                             typename Field::ConstElement_ptr x, int ldx, const typename Field::Element &beta,
+                             typename Field::Element_ptr y, int ldy);
+
+template <class Field>
+inline void pfspmm_transpose(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A, size_t blockSize,
+                             typename Field::ConstElement_ptr x, int ldx, const typename Field::Element &beta,
+                             typename Field::Element_ptr y, int ldy);
+#endif
+
+/*********************************************************************************************************************
+ *
+ *    SpGEMM: C <- A B, for A and B in CSR or CSR_ZO; C is a CSR matrix allocated by the call, to be freed with
+ *    sparse_delete. The ParSeqHelper::Parallel version splits the rows of C among its threads.
+ *
+ *********************************************************************************************************************/
+
+template <class Field, class SMA, class SMB>
+inline void fspgemm(const Field &F, const SMA &A, const SMB &B, Sparse<Field, SparseMatrix_t::CSR> &C);
+
+template <class Field, class SMA, class SMB>
+inline void fspgemm(const Field &F, const SMA &A, const SMB &B, Sparse<Field, SparseMatrix_t::CSR> &C,
+                    const ParSeqHelper::Sequential &);
+
+template <class Field, class SMA, class SMB, class Cut, class Param>
+inline void fspgemm(const Field &F, const SMA &A, const SMB &B, Sparse<Field, SparseMatrix_t::CSR> &C,
+                    const ParSeqHelper::Parallel<Cut, Param> &H);
+
+#if defined(__FFLASFFPACK_USE_OPENMP)
+template <class Field, class SMA, class SMB>
+inline void pfspgemm(const Field &F, const SMA &A, const SMB &B, Sparse<Field, SparseMatrix_t::CSR> &C);
+#endif
 }
 
 #include "fflas-ffpack/fflas/fflas_sparse.inl"
 
 #include "fflas-ffpack/fflas/fflas_sparse/read_sparse.h"
+#include "fflas-ffpack/fflas/fflas_sparse/sparse_binary.h"
+#include "fflas-ffpack/fflas/fflas_sparse/auto.h"
 
 
 namespace FFLAS {
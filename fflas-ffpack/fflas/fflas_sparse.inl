@@ -55,13 +55,50 @@ namespace FFLAS {
 				if (F.isZero(b)) {
 					fzero(F, m, n, y, ldy);
 				} else if (F.isMOne(b)) {
-					fnegin(F, m, n, y, 1);
+					fnegin(F, m, n, y, ldy);
 				} else {
-					fscalin(F, m, n, b, y, 1);
+					fscalin(F, m, n, b, y, ldy);
 				}
 			}
 		}
 
+		/* Product by a reordered matrix, stored as B = P A P^T, perm giving P:
+		 * y <- beta y + A x is P^T (beta P y + B P x), the product
+		 * prod(xp, yp) computing yp <- beta yp + B xp on the permuted copies of
+		 * x and y, of leading dimension blockSize, kept in the scratch S of A.
+		 */
+		template <class Field, class Product>
+		inline void reordered_product(const Field &F, const index_t *perm, ReorderScratch<Field> *S, const size_t n,
+					      const size_t blockSize, typename Field::ConstElement_ptr x, const int ldx,
+					      const typename Field::Element &beta, typename Field::Element_ptr y, const int ldy,
+					      Product prod, const bool par) {
+			reorder_scratch_reserve(*S, n, blockSize);
+			typename Field::Element_ptr xp = S->x;
+			typename Field::Element_ptr yp = S->y;
+			const bool gathery = !F.isZero(beta);
+			auto gather = [&](size_t kb, size_t ke) {
+				for (size_t k = kb; k < ke; ++k) {
+					fassign(F, blockSize, x + perm[k] * (size_t)ldx, 1, xp + k * blockSize, 1);
+					if (gathery)
+						fassign(F, blockSize, y + perm[k] * (size_t)ldy, 1, yp + k * blockSize, 1);
+				}
+			};
+			auto scatter = [&](size_t kb, size_t ke) {
+				for (size_t k = kb; k < ke; ++k)
+					fassign(F, blockSize, yp + k * blockSize, 1, y + perm[k] * (size_t)ldy, 1);
+			};
+			if (par) {
+				const ParSeqHelper::Parallel<CuttingStrategy::Block, StrategyParameter::Threads> psh(MAX_THREADS);
+				Protected::pforblock1d_static(n, psh, gather);
+				prod(xp, yp);
+				Protected::pforblock1d_static(n, psh, scatter);
+			} else {
+				gather(0, n);
+				prod(xp, yp);
+				scatter(0, n);
+			}
+		}
+
 	} // sparse_details
 
 	namespace sparse_details {
@@ -107,9 +144,7 @@ namespace FFLAS {
 		}
 
 		template <class Field, class SM>
-		inline typename std::enable_if<isSparseMatrixSimdFormat<Field, SM>::value && 
-		support_simd<typename Field::Element>::value
-		>::type
+		inline typename std::enable_if<isSparseMatrixSimdFormat<Field, SM>::value>::type
 		fspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
 		      FieldCategories::UnparametricTag, NotZOSparseMatrix) {
 			// #ifdef __FFLASFFPACK_USE_SIMD
@@ -132,9 +167,7 @@ namespace FFLAS {
 		}
 
 		template <class Field, class SM>
-		inline typename std::enable_if<isSparseMatrixSimdFormat<Field, SM>::value &&
-		support_simd<typename Field::Element>::value
-		>::type
+		inline typename std::enable_if<isSparseMatrixSimdFormat<Field, SM>::value>::type
 		fspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
 		      FieldCategories::ModularTag, NotZOSparseMatrix) {
 			// #ifdef __FFLASFFPACK_USE_SIMD
@@ -166,7 +199,7 @@ namespace FFLAS {
 			} else {
 				auto x1 = fflas_new(F, A.n, 1, Alignment::CACHE_LINE);
 				fscal(F, A.n, A.cst, x, 1, x1, 1);
-				sparse_details_impl::fspmv_one(F, A, x, y, FieldCategories::GenericTag());
+				sparse_details_impl::fspmv_one(F, A, x1, y, FieldCategories::GenericTag());
 				fflas_delete(x1);
 			}
 		}
@@ -182,15 +215,13 @@ namespace FFLAS {
 			} else {
 				auto x1 = fflas_new(F, A.n, 1, Alignment::CACHE_LINE);
 				fscal(F, A.n, A.cst, x, 1, x1, 1);
-				sparse_details_impl::fspmv_one(F, A, x, y, FieldCategories::UnparametricTag());
+				sparse_details_impl::fspmv_one(F, A, x1, y, FieldCategories::UnparametricTag());
 				fflas_delete(x1);
 			}
 		}
 
 		template <class Field, class SM>
-		inline typename std::enable_if<isSparseMatrixSimdFormat<Field, SM>::value &&
-		support_simd<typename Field::Element>::value
-		>::type
+		inline typename std::enable_if<isSparseMatrixSimdFormat<Field, SM>::value>::type
 		fspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
 		      FieldCategories::UnparametricTag, ZOSparseMatrix) {
 			// #ifdef __FFLASFFPACK_USE_SIMD
@@ -201,7 +232,7 @@ namespace FFLAS {
 			} else {
 				auto x1 = fflas_new(F, A.n, 1, Alignment::CACHE_LINE);
 				fscal(F, A.n, A.cst, x, 1, x1, 1);
-				sparse_details_impl::fspmv_one_simd(F, A, x, y, FieldCategories::UnparametricTag());
+				sparse_details_impl::fspmv_one_simd(F, A, x1, y, FieldCategories::UnparametricTag());
 				fflas_delete(x1);
 			}
 			// #else
@@ -317,9 +348,9 @@ namespace FFLAS {
 			} else if (F.isMOne(A.cst)) {
 				sparse_details_impl::fspmm_mone(F, A, blockSize, x, ldx, y, ldy, FieldCategories::GenericTag());
 			} else {
-				auto x1 = fflas_new(F, A.m, blockSize, Alignment::CACHE_LINE);
-				fscal(F, A.m, blockSize, A.cst, x, ldx, x1, 1);
-				sparse_details_impl::fspmm_one(F, A, blockSize, x, ldx, y, ldy, FieldCategories::GenericTag());
+				auto x1 = fflas_new(F, A.n, blockSize, Alignment::CACHE_LINE);
+				fscal(F, A.n, blockSize, A.cst, x, ldx, x1, blockSize);
+				sparse_details_impl::fspmm_one(F, A, blockSize, x1, blockSize, y, ldy, FieldCategories::GenericTag());
 				fflas_delete(x1);
 			}
 		}
@@ -346,13 +377,13 @@ namespace FFLAS {
 										       FieldCategories::UnparametricTag());
 				}
 			} else {
-				auto x1 = fflas_new(F, A.m, blockSize, Alignment::CACHE_LINE);
-				fscal(F, A.m, blockSize, A.cst, x, ldx, x1, 1);
+				auto x1 = fflas_new(F, A.n, blockSize, Alignment::CACHE_LINE);
+				fscal(F, A.n, blockSize, A.cst, x, ldx, x1, blockSize);
 				if (simd::valid(x) && simd::valid(y) && simd::compliant(blockSize)) {
-					sparse_details_impl::fspmm_one_simd_aligned(F, A, blockSize, x, ldx, y, ldy,
+					sparse_details_impl::fspmm_one_simd_aligned(F, A, blockSize, x1, blockSize, y, ldy,
 										    FieldCategories::UnparametricTag());
 				} else {
-					sparse_details_impl::fspmm_one_simd_unaligned(F, A, blockSize, x, ldx, y, ldy,
+					sparse_details_impl::fspmm_one_simd_unaligned(F, A, blockSize, x1, blockSize, y, ldy,
 										      FieldCategories::UnparametricTag());
 				}
 				fflas_delete(x1);
@@ -368,9 +399,9 @@ namespace FFLAS {
 			} else if (F.isMOne(A.cst)) {
 				sparse_details_impl::fspmm_mone(F, A, blockSize, x, ldx, y, ldy, FieldCategories::UnparametricTag());
 			} else {
-				auto x1 = fflas_new(F, A.m, blockSize, Alignment::CACHE_LINE);
-				fscal(F, A.m, blockSize, A.cst, x, ldx, x1, 1);
-				sparse_details_impl::fspmm_one(F, A, blockSize, x1, ldx, y, ldy, FieldCategories::UnparametricTag());
+				auto x1 = fflas_new(F, A.n, blockSize, Alignment::CACHE_LINE);
+				fscal(F, A.n, blockSize, A.cst, x, ldx, x1, blockSize);
+				sparse_details_impl::fspmm_one(F, A, blockSize, x1, blockSize, y, ldy, FieldCategories::UnparametricTag());
 				fflas_delete(x1);
 			}
 		}
@@ -381,10 +412,13 @@ namespace FFLAS {
 		      typename Field::Element_ptr y, int ldy, FieldCategories::ModularTag, ZOSparseMatrix) {
 			sparse_details::fspmm(F, A, blockSize, x, ldx, y, ldy, typename FieldCategories::UnparametricTag(),
 					      ZOSparseMatrix());
-			freduce(F, blockSize, A.m, y, ldy);
+			freduce(F, A.m, blockSize, y, ldy);
 		}
- 
-#if defined(__FFLASFFPACK_USE_OPENMP)
+
+		/* The parallel dispatch is compiled without OpenMP too, for the SELL
+		 * kernels which run through paladin; the kernels of the other formats
+		 * need OpenMP.
+		 */
 
 		/*************************************************************************************
 		 *
@@ -480,9 +514,9 @@ namespace FFLAS {
 			} else if (F.isMOne(A.cst)) {
 				sparse_details_impl::pfspmm_mone(F, A, blockSize, x, ldx, y, ldy, FieldCategories::GenericTag());
 			} else {
-				auto x1 = fflas_new(F, A.m, blockSize, Alignment::CACHE_LINE);
-				fscal(F, A.m, blockSize, A.cst, x, ldx, x1, 1);
-				sparse_details_impl::pfspmm_one(F, A, blockSize, x, ldx, y, ldy, FieldCategories::GenericTag());
+				auto x1 = fflas_new(F, A.n, blockSize, Alignment::CACHE_LINE);
+				fscal(F, A.n, blockSize, A.cst, x, ldx, x1, blockSize);
+				sparse_details_impl::pfspmm_one(F, A, blockSize, x1, blockSize, y, ldy, FieldCategories::GenericTag());
 				fflas_delete(x1);
 			}
 		}
@@ -511,13 +545,13 @@ namespace FFLAS {
 											FieldCategories::UnparametricTag());
 				}
 			} else {
-				auto x1 = fflas_new(F, A.m, blockSize, Alignment::CACHE_LINE);
-				fscal(F, A.m, blockSize, A.cst, x, ldx, x1, 1);
+				auto x1 = fflas_new(F, A.n, blockSize, Alignment::CACHE_LINE);
+				fscal(F, A.n, blockSize, A.cst, x, ldx, x1, blockSize);
 				if (simd::valid(x) && simd::valid(y) && simd::compliant(blockSize)) {
-					sparse_details_impl::pfspmm_one_simd_aligned(F, A, blockSize, x, ldx, y, ldy,
+					sparse_details_impl::pfspmm_one_simd_aligned(F, A, blockSize, x1, blockSize, y, ldy,
 										     FieldCategories::UnparametricTag());
 				} else {
-					sparse_details_impl::pfspmm_one_simd_unaligned(F, A, blockSize, x, ldx, y, ldy,
+					sparse_details_impl::pfspmm_one_simd_unaligned(F, A, blockSize, x1, blockSize, y, ldy,
 										       FieldCategories::UnparametricTag());
 				}
 				fflas_delete(x1);
@@ -533,9 +567,9 @@ namespace FFLAS {
 			} else if (F.isMOne(A.cst)) {
 				sparse_details_impl::pfspmm_mone(F, A, blockSize, x, ldx, y, ldy, FieldCategories::UnparametricTag());
 			} else {
-				auto x1 = fflas_new(F, A.m, blockSize, Alignment::CACHE_LINE);
-				fscal(F, A.m, blockSize, A.cst, x, ldx, x1, 1);
-				sparse_details_impl::pfspmm_one(F, A, blockSize, x1, ldx, y, ldy, FieldCategories::UnparametricTag());
+				auto x1 = fflas_new(F, A.n, blockSize, Alignment::CACHE_LINE);
+				fscal(F, A.n, blockSize, A.cst, x, ldx, x1, blockSize);
+				sparse_details_impl::pfspmm_one(F, A, blockSize, x1, blockSize, y, ldy, FieldCategories::UnparametricTag());
 				fflas_delete(x1);
 			}
 		}
@@ -546,302 +580,212 @@ namespace FFLAS {
 		       typename Field::Element_ptr y, int ldy, FieldCategories::ModularTag, ZOSparseMatrix) {
 			sparse_details::pfspmm(F, A, blockSize, x, ldx, y, ldy, typename FieldCategories::UnparametricTag(),
 					       ZOSparseMatrix());
-			freduce(F, blockSize, A.m, y, ldy);
+			freduce(F, A.m, blockSize, y, ldy);
 		}
 
 #endif // __FFLASFFPACK_USE_SIMD
 
-		// /***************************** pfspmv ******************************/
-
-		// #if defined(__FFLASFFPACK_USE_OPENMP)
-
-		// template <class Field, class SM, class FC, class MZO>
-		// inline void pfspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
-		//                   FieldCategories::MultiPrecisionTag ,FC fc, MZO mzo) {
-		//     sparse_details::pfspmv(F, A, x, y, FieldCategories::GenericTag(), MZO());
-		// }
-
-		// template <class Field, class SM, class FC, class MZO>
-		// inline void pfspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
-		//                   FieldCategories::GenericTag ,FC fc, MZO mzo) {
-		//     sparse_details::pfspmv(F, A, x, y, FC(), MZO());
-		// }
-
-        template <class Field, class SM>
-        inline void pfspmv(const Field &F, const SM &A,
-                   typename Field::ConstElement_ptr x, 
-                   typename Field::Element_ptr y,
-                   FieldCategories::GenericTag tag, std::false_type) {
-			sparse_details_impl::pfspmv(F, A, x, y, tag);
-		}
-
-		// template <class Field, class SM>
-		// inline void pfspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
-		//                    FieldCategories::UnparametricTag, std::false_type) {
-		//     sparse_details_impl::pfspmv(F, A, x, y, FieldCategories::UnparametricTag());
-		// }
-
-		// template <class Field, class SM>
-		// inline void pfspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
-		//                    FieldCategories::ModularTag, std::false_type) {
-		//     if (A.delayed) {
-		//         sparse_details::pfspmv(F, A, x, y, FieldCategories::UnparametricTag(), std::false_type());
-		//         freduce(F, A.m, y, 1);
-		//     } else {
-		//         sparse_details_impl::pfspmv(F, A, x, y, A.kmax);
-		//     }
-		// }
-
-		// // ZO matrix
-		// template <class Field, class SM>
-		// inline void pfspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
-		//                    FieldCategories::GenericTag, std::true_type) {
-		//     if (A.cst == 1) {
-		//         sparse_details_impl::pfspmv_one(F, A, x, y, FieldCategories::GenericTag());
-		//     } else if (A.cst == -1) {
-		//         sparse_details_impl::pfspmv_mone(F, A, x, y, FieldCategories::GenericTag());
-		//     } else {
-		//         auto x1 = fflas_new(F, A.n, 1, Alignment::CACHE_LINE);
-		//         fscal(F, A.n, A.cst, x, 1, x1, 1);
-		//         sparse_details_impl::pfspmv_one(F, A, x, y, FieldCategories::GenericTag());
-		//         fflas_delete(x1);
-		//     }
-		// }
-
-		// template <class Field>
-		// inline void pfspmv(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, typename Field::ConstElement_ptr x,
-		//                    typename Field::Element_ptr y, FieldCategories::UnparametricTag, std::true_type) {
-		// #ifdef __FFLASFFPACK_USE_SIMD
-		//     if (A.cst == 1) {
-		//         sparse_details_impl::pfspmv_one_simd(F, A, x, y, FieldCategories::UnparametricTag());
-		//     } else if (A.cst == -1) {
-		//         sparse_details_impl::pfspmv_mone_simd(F, A, x, y, FieldCategories::UnparametricTag());
-		//     } else {
-		//         auto x1 = fflas_new(F, A.n, 1, Alignment::CACHE_LINE);
-		//         fscal(F, A.n, A.cst, x, 1, x1, 1);
-		//         sparse_details_impl::pfspmv_one_simd(F, A, x, y, FieldCategories::UnparametricTag());
-		//         fflas_delete(x1);
-		//     }
-		// #else
-		//     if (A.cst == 1) {
-		//         sparse_details_impl::pfspmv_one(F, A, x, y, FieldCategories::UnparametricTag());
-		//     } else if (A.cst == -1) {
-		//         sparse_details_impl::pfspmv_mone(F, A, x, y, FieldCategories::UnparametricTag());
-		//     } else {
-		//         auto x1 = fflas_new(F, A.n, 1, Alignment::CACHE_LINE);
-		//         fscal(F, A.n, A.cst, x, 1, x1, 1);
-		//         sparse_details_impl::pfspmv_one(F, A, x, y, FieldCategories::UnparametricTag());
-		//         fflas_delete(x1);
-		//     }
-		// #endif // SIMD
-		// }
-
-		// template <class Field>
-		// inline void pfspmv(const Field &F, const Sparse<Field, SparseMatrix_t::ELL_simd> &A, typename Field::ConstElement_ptr
-		// x,
-		//                    typename Field::Element_ptr y, FieldCategories::UnparametricTag, std::true_type) {
-		// #ifdef __FFLASFFPACK_USE_SIMD
-		//     if (A.cst == 1) {
-		//         sparse_details_impl::pfspmv_one_simd(F, A, x, y, FieldCategories::UnparametricTag());
-		//     } else if (A.cst == -1) {
-		//         sparse_details_impl::pfspmv_mone_simd(F, A, x, y, FieldCategories::UnparametricTag());
-		//     } else {
-		//         auto x1 = fflas_new(F, A.n, 1, Alignment::CACHE_LINE);
-		//         fscal(F, A.n, A.cst, x, 1, x1, 1);
-		//         sparse_details_impl::pfspmv_one_simd(F, A, x, y, FieldCategories::UnparametricTag());
-		//         fflas_delete(x1);
-		//     }
-		// #else
-		//     if (A.cst == 1) {
-		//         sparse_details_impl::pfspmv_one(F, A, x, y, FieldCategories::UnparametricTag());
-		//     } else if (A.cst == -1) {
-		//         sparse_details_impl::pfspmv_mone(F, A, x, y, FieldCategories::UnparametricTag());
-		//     } else {
-		//         auto x1 = fflas_new(F, A.n, 1, Alignment::CACHE_LINE);
-		//         fscal(F, A.n, A.cst, x, 1, x1, 1);
-		//         sparse_details_impl::pfspmv_one(F, A, x, y, FieldCategories::UnparametricTag());
-		//         fflas_delete(x1);
-		//     }
-		// #endif // SIMD
-		// }
-
-		// template <class Field, class SM>
-		// inline void pfspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
-		//                    FieldCategories::UnparametricTag, std::true_type) {
-		//     if (A.cst == 1) {
-		//         sparse_details_impl::pfspmv_one(F, A, x, y, FieldCategories::UnparametricTag());
-		//     } else if (A.cst == -1) {
-		//         sparse_details_impl::pfspmv_mone(F, A, x, y, FieldCategories::UnparametricTag());
-		//     } else {
-		//         auto x1 = fflas_new(F, A.n, 1, Alignment::CACHE_LINE);
-		//         fscal(F, A.n, A.cst, x, 1, x1, 1);
-		//         sparse_details_impl::pfspmv_one(F, A, x, y, FieldCategories::UnparametricTag());
-		//         fflas_delete(x1);
-		//     }
-		// }
-
-		// template <class Field, class SM>
-		// inline void pfspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
-		//                    FieldCategories::ModularTag, std::true_type) {
-		//     sparse_details::pfspmv<Field, SM>(F, A, x, y, FieldCategories::UnparametricTag(), std::true_type());
-		//     freduce(F, A.m, y, 1);
-		// }
-		// #endif
-
-		// /***************************** pfspmm *****************************/
-
-		// template<class Field, class SM, class FCat, class MZO>
-		// inline void pfspmm(const Field &F, const SM &A, size_t blockSize, typename Field::ConstElement_ptr x, int ldx,
-		//                   typename Field::Element_ptr y, int ldy, FieldCategories::MultiPrecisionTag, FCat fc, MZO mz) {
-		//     sparse_details::pfspmm(F, A, blockSize, x, ldx, y, ldy, typename FieldCategories::GenericTag(), MZO());
-		// }
-
-		// template<class Field, class SM, class FCat, class MZO>
-		// inline void pfspmm(const Field &F, const SM &A, size_t blockSize, typename Field::ConstElement_ptr x, int ldx,
-		//                   typename Field::Element_ptr y, int ldy, FieldCategories::GenericTag, FCat fc, MZO mz) {
-		//     sparse_details::pfspmm(F, A, blockSize, x, ldx, y, ldy, FCat(), MZO());
-		// }
-
-		// template <class Field, class SM>
-		// inline void pfspmm(const Field &F, const SM &A, size_t blockSize, typename Field::ConstElement_ptr x, int ldx,
-		//                   typename Field::Element_ptr y, int ldy, FieldCategories::GenericTag, std::false_type) {
-		//     // std::cout << "no ZO Generic" << std::endl;
-		//     /*sparse_details_impl::*/pfspmm(F, A, blockSize, x, ldx, y, ldy, FieldCategories::GenericTag());
-		// }
-
-		// template <class Field, class SM>
-		// inline void pfspmm(const Field &F, const SM &A, size_t blockSize, typename Field::ConstElement_ptr x, int ldx,
-		//                   typename Field::Element_ptr y, int ldy, FieldCategories::UnparametricTag, std::false_type) {
-		// // std::cout << "no ZO Unparametric" << std::endl;
-		// #ifdef __FFLASFFPACK_USE_SIMD
-		//     using simd = Simd<typename Field::Element>;
-		//     if (((uint64_t)y % simd::alignment == 0) && ((uint64_t)x % simd::alignment == 0) &&
-		//         (blockSize % simd::vect_size == 0)) {
-		//         // std::cout << "no ZO Unparametric algined" << std::endl;
-		//         sparse_details_impl::pfspmm_simd_aligned(F, A, blockSize, x, ldx, y, ldy,
-		//         FieldCategories::UnparametricTag());
-		//     }
-		// else{
-		//     sparse_details_impl::fspmm_simd_unaligned(F, A, blockSize, x, ldx, y, ldy, FieldCategories::UnparametricTag());
-		// }
-		// #else
-		//     sparse_details_impl::pfspmm(F, A, blockSize, x, ldx, y, ldy, FieldCategories::UnparametricTag());
-		// #endif
-		// }
-
-		// template <class Field, class SM>
-		// inline void pfspmm(const Field &F, const SM &A, size_t blockSize, typename Field::ConstElement_ptr x, int ldx,
-		//                   typename Field::Element_ptr y, int ldy, FieldCategories::ModularTag, std::false_type) {
-		//     // std::cout << "no ZO Modular" << std::endl;
-		//     if (A.delayed) {
-		//         sparse_details::pfspmm(F, A, blockSize, x, ldx, y, ldy, FieldCategories::UnparametricTag(),
-		//                               typename std::false_type());
-		//         freduce(F, A.m, blockSize, y, ldy);
-		//     } else {
-		// #ifdef __FFLASFFPACK_USE_SIMD
-		//         using simd = Simd<typename Field::Element>;
-		//         if (((uint64_t)y % simd::alignment == 0) && ((uint64_t)x % simd::alignment == 0) &&
-		//             (blockSize % simd::vect_size == 0)) {
-		//             sparse_details_impl::pfspmm_simd_aligned(F, A, blockSize, x, ldx, y, ldy, A.kmax);
-		//         } else {
-		//             sparse_details_impl::pfspmm_simd_unaligned(F, A, blockSize, x, ldx, y, ldy, A.kmax);
-		//         }
-		// #else
-		//         sparse_details_impl::pfspmm(F, A, blockSize, x, ldx, y, ldy, A.kmax);
-		// #endif
-		//     }
-		// }
-
-		// // ZO matrix
-		// template <class Field, class SM>
-		// inline void pfspmm(const Field &F, const SM &A, size_t blockSize, typename Field::ConstElement_ptr x, int ldx,
-		//                   typename Field::Element_ptr y, int ldy, FieldCategories::GenericTag, std::true_type) {
-		//     // std::cout << "ZO Generic" << std::endl;
-		//     if (F.isOne(A.cst)) {
-		//         sparse_details_impl::pfspmm_one(F, A, blockSize, x, ldx, y, ldy, FieldCategories::GenericTag());
-		//     } else if (F.isMOne(A.cst)) {
-		//         sparse_details_impl::pfspmm_mone(F, A, blockSize, x, ldx, y, ldy, FieldCategories::GenericTag());
-		//     } else {
-		//         auto x1 = fflas_new(F, A.m, blockSize, Alignment::CACHE_LINE);
-		//         fscal(F, A.m, blockSize, A.cst, x, ldx, x1, 1);
-		//         sparse_details_impl::pfspmm_one(F, A, blockSize, x, ldx, y, ldy, FieldCategories::GenericTag());
-		//         fflas_delete(x1);
-		//     }
-		// }
-
-		// template <class Field, class SM>
-		// inline void pfspmm(const Field &F, const SM &A, size_t blockSize, typename Field::ConstElement_ptr x, int ldx,
-		//                   typename Field::Element_ptr y, int ldy, FieldCategories::UnparametricTag, std::true_type) {
-		// // std::cout << "ZO Unparametric" << std::endl;
-		// #ifdef __FFLASFFPACK_USE_SIMD
-		//     using simd = Simd<typename Field::Element>;
-		//     if (F.isOne(A.cst)) {
-		//         if (((uint64_t)y % simd::alignment == 0) && ((uint64_t)x % simd::alignment == 0) &&
-		//             (blockSize % simd::vect_size == 0)) {
-		//             // std::cout << "ZO Unparametric aligned" << std::endl;
-		//             sparse_details_impl::pfspmm_one_simd_aligned(F, A, blockSize, x, ldx, y, ldy,
-		//                                                         FieldCategories::UnparametricTag());
-		//         } else {
-		//             // std::cout << "ZO Unparametric unaligned" << std::endl;
-		//             sparse_details_impl::pfspmm_one_simd_unaligned(F, A, blockSize, x, ldx, y, ldy,
-		//                                                           FieldCategories::UnparametricTag());
-		//         }
-		//     } else if (F.isMOne(A.cst)) {
-		//         if (((uint64_t)y % simd::alignment == 0) && ((uint64_t)x % simd::alignment == 0) &&
-		//             (blockSize % simd::vect_size == 0)) {
-		//             sparse_details_impl::pfspmm_mone_simd_aligned(F, A, blockSize, x, ldx, y, ldy,
-		//                                                          FieldCategories::UnparametricTag());
-		//         } else {
-		//             sparse_details_impl::pfspmm_mone_simd_unaligned(F, A, blockSize, x, ldx, y, ldy,
-		//                                                            FieldCategories::UnparametricTag());
-		//         }
-		//     } else {
-		//         auto x1 = fflas_new(F, A.m, blockSize, Alignment::CACHE_LINE);
-		//         fscal(F, A.m, blockSize, A.cst, x, ldx, x1, 1);
-		//         if (((uint64_t)y % simd::alignment == 0) && ((uint64_t)x % simd::alignment == 0) &&
-		//             (blockSize % simd::vect_size == 0)) {
-		//             sparse_details_impl::pfspmm_one_simd_aligned(F, A, blockSize, x, ldx, y, ldy,
-		//                                                         FieldCategories::UnparametricTag());
-		//         } else {
-		//             sparse_details_impl::pfspmm_one_simd_unaligned(F, A, blockSize, x, ldx, y, ldy,
-		//                                                           FieldCategories::UnparametricTag());
-		//         }
-		//         fflas_delete(x1);
-		//     }
-		// #else
-		//     if (F.isOne(A.cst)) {
-		//         sparse_details_impl::pfspmm_one(F, A, blockSize, x, ldx, y, ldy, FieldCategories::UnparametricTag());
-		//     } else if (F.isMOne(A.cst)) {
-		//         sparse_details_impl::pfspmm_mone(F, A, blockSize, x, ldx, y, ldy, FieldCategories::UnparametricTag());
-		//     } else {
-		//         auto x1 = fflas_new(F, A.m, blockSize, Alignment::CACHE_LINE);
-		//         fscal(F, A.m, blockSize, A.cst, x, ldx, x1, 1);
-		//         sparse_details_impl::pfspmm_one(F, A, blockSize, x1, ldx, y, ldy, FieldCategories::UnparametricTag());
-		//         fflas_delete(x1);
-		//     }
-		// #endif
-		// }
-
-		// template <class Field, class SM>
-		// inline void pfspmm(const Field &F, const SM &A, size_t blockSize, typename Field::ConstElement_ptr x, int ldx,
-		//                   typename Field::Element_ptr y, int ldy, FieldCategories::ModularTag, std::true_type) {
-		//     // std::cout << "ZO Modular" << std::endl;
-		//     if (A.delayed) {
-		//         sparse_details::pfspmm(F, A, blockSize, x, ldx, y, ldy, typename FieldCategories::UnparametricTag(),
-		//                               typename std::true_type());
-		//         freduce(F, blockSize, A.m, y, ldy);
-		//     } else {
-		//         sparse_details_impl::pfspmm(F, A, blockSize, x, ldx, y, ldy, A.kmax);
-		//     }
-		// }
+		/*************************************************************************************
+		 *
+		 *      pfspmv dispatch
+		 *
+		 *************************************************************************************/
 
-#endif // __FFLASFFPACK_USE_OPENMP
+		template <class Field, class SM, class FC, class MZO>
+		inline typename std::enable_if<
+			!(std::is_same<typename ElementTraits<typename Field::Element>::value, ElementCategories::MachineFloatTag>::value ||
+			  std::is_same<typename ElementTraits<typename Field::Element>::value,
+			  ElementCategories::MachineIntTag>::value)>::type
+		pfspmv_dispatch(const Field &F, const SM &A, typename Field::ConstElement_ptr x, typename Field::Element_ptr y, FC fc,
+				MZO mzo) {
+			sparse_details::pfspmv(F, A, x, y, FieldCategories::GenericTag(), MZO());
+		}
+
+		template <class Field, class SM, class FC, class MZO>
+		inline typename std::enable_if<
+			std::is_same<typename ElementTraits<typename Field::Element>::value, ElementCategories::MachineFloatTag>::value ||
+		std::is_same<typename ElementTraits<typename Field::Element>::value, ElementCategories::MachineIntTag>::value>::type
+		pfspmv_dispatch(const Field &F, const SM &A, typename Field::ConstElement_ptr x, typename Field::Element_ptr y, FC fc,
+				MZO mzo) {
+			sparse_details::pfspmv(F, A, x, y, FC(), MZO());
+		}
+
+		// non ZO matrix
+		template <class Field, class SM>
+		inline void
+		pfspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
+		       FieldCategories::GenericTag, NotZOSparseMatrix) {
+			sparse_details_impl::pfspmv(F, A, x, y, FieldCategories::GenericTag());
+		}
+
+		template <class Field, class SM>
+		inline typename std::enable_if<!isSparseMatrixSimdFormat<Field, SM>::value>::type
+		pfspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
+		       FieldCategories::UnparametricTag, NotZOSparseMatrix) {
+			sparse_details_impl::pfspmv(F, A, x, y, FieldCategories::UnparametricTag());
+		}
+
+		template <class Field, class SM>
+		inline typename std::enable_if<isSparseMatrixSimdFormat<Field, SM>::value>::type
+		pfspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
+		       FieldCategories::UnparametricTag, NotZOSparseMatrix) {
+			sparse_details_impl::pfspmv_simd(F, A, x, y, FieldCategories::UnparametricTag());
+		}
+
+		template <class Field, class SM>
+		inline typename std::enable_if<!isSparseMatrixSimdFormat<Field, SM>::value>::type
+		pfspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
+		       FieldCategories::ModularTag, NotZOSparseMatrix) {
+			if (A.delayed) {
+				sparse_details::pfspmv(F, A, x, y, FieldCategories::UnparametricTag(), NotZOSparseMatrix());
+				freduce(F, A.m, y, 1);
+			} else {
+				sparse_details_impl::pfspmv(F, A, x, y, A.kmax);
+			}
+		}
+
+		template <class Field, class SM>
+		inline typename std::enable_if<isSparseMatrixSimdFormat<Field, SM>::value>::type
+		pfspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
+		       FieldCategories::ModularTag, NotZOSparseMatrix) {
+			if (A.delayed) {
+				sparse_details::pfspmv(F, A, x, y, FieldCategories::UnparametricTag(), NotZOSparseMatrix());
+				freduce(F, A.m, y, 1);
+			} else {
+				sparse_details_impl::pfspmv_simd(F, A, x, y, A.kmax);
+			}
+		}
+
+		// ZO matrix
+		template <class Field, class SM>
+		inline void
+		pfspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
+		       FieldCategories::GenericTag, ZOSparseMatrix) {
+			if (F.isOne(A.cst)) {
+				sparse_details_impl::pfspmv_one(F, A, x, y, FieldCategories::GenericTag());
+			} else if (F.isMOne(A.cst)) {
+				sparse_details_impl::pfspmv_mone(F, A, x, y, FieldCategories::GenericTag());
+			} else {
+				auto x1 = fflas_new(F, A.n, 1, Alignment::CACHE_LINE);
+				fscal(F, A.n, A.cst, x, 1, x1, 1);
+				sparse_details_impl::pfspmv_one(F, A, x1, y, FieldCategories::GenericTag());
+				fflas_delete(x1);
+			}
+		}
+
+		template <class Field, class SM>
+		inline typename std::enable_if<!isSparseMatrixSimdFormat<Field, SM>::value>::type
+		pfspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
+		       FieldCategories::UnparametricTag, ZOSparseMatrix) {
+			if (A.cst == 1) {
+				sparse_details_impl::pfspmv_one(F, A, x, y, FieldCategories::UnparametricTag());
+			} else if (A.cst == -1) {
+				sparse_details_impl::pfspmv_mone(F, A, x, y, FieldCategories::UnparametricTag());
+			} else {
+				auto x1 = fflas_new(F, A.n, 1, Alignment::CACHE_LINE);
+				fscal(F, A.n, A.cst, x, 1, x1, 1);
+				sparse_details_impl::pfspmv_one(F, A, x1, y, FieldCategories::UnparametricTag());
+				fflas_delete(x1);
+			}
+		}
+
+		template <class Field, class SM>
+		inline typename std::enable_if<isSparseMatrixSimdFormat<Field, SM>::value>::type
+		pfspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
+		       FieldCategories::UnparametricTag, ZOSparseMatrix) {
+			if (A.cst == 1) {
+				sparse_details_impl::pfspmv_one_simd(F, A, x, y, FieldCategories::UnparametricTag());
+			} else if (A.cst == -1) {
+				sparse_details_impl::pfspmv_mone_simd(F, A, x, y, FieldCategories::UnparametricTag());
+			} else {
+				auto x1 = fflas_new(F, A.n, 1, Alignment::CACHE_LINE);
+				fscal(F, A.n, A.cst, x, 1, x1, 1);
+				sparse_details_impl::pfspmv_one_simd(F, A, x1, y, FieldCategories::UnparametricTag());
+				fflas_delete(x1);
+			}
+		}
+
+		template <class Field, class SM>
+		inline void
+		pfspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
+		       FieldCategories::ModularTag, ZOSparseMatrix) {
+			sparse_details::pfspmv(F, A, x, y, FieldCategories::UnparametricTag(), ZOSparseMatrix());
+			freduce(F, A.m, y, 1);
+		}
+
+		/* y <- beta y + A x by the parallel kernels of A, on the permuted
+		 * copies of x and y if A is reordered.
+		 */
+		template <class Field, class SM>
+		inline void parallel_fspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x,
+					   const typename Field::Element &beta, typename Field::Element_ptr y) {
+			auto prod = [&](typename Field::ConstElement_ptr xp, typename Field::Element_ptr yp) {
+				init_y(F, A.m, beta, yp);
+				pfspmv_dispatch(F, A, xp, yp, typename FieldTraits<Field>::category(),
+						typename isZOSparseMatrix<Field, SM>::type());
+			};
+			const index_t *perm = reordering(A, 0);
+			if (perm != nullptr)
+				reordered_product(F, perm, reorder_scratch<Field>(A, 0), A.m, 1, x, 1, beta, y, 1, prod, true);
+			else
+				prod(x, y);
+		}
+
+		template <class Field, class SM>
+		inline void parallel_fspmm(const Field &F, const SM &A, size_t blockSize, typename Field::ConstElement_ptr x,
+					   int ldx, const typename Field::Element &beta, typename Field::Element_ptr y, int ldy) {
+			const index_t *perm = reordering(A, 0);
+			if (perm != nullptr) {
+				reordered_product(F, perm, reorder_scratch<Field>(A, 0), A.m, blockSize, x, ldx, beta, y, ldy,
+						  [&](typename Field::ConstElement_ptr xp, typename Field::Element_ptr yp) {
+							  init_y(F, A.m, blockSize, beta, yp, (int)blockSize);
+							  pfspmm_dispatch<Field, SM>(F, A, blockSize, xp, (int)blockSize, yp, (int)blockSize,
+										     typename FieldTraits<Field>::category(),
+										     typename isZOSparseMatrix<Field, SM>::type());
+						  }, true);
+				return;
+			}
+			init_y(F, A.m, blockSize, beta, y, ldy);
+			pfspmm_dispatch<Field, SM>(F, A, blockSize, x, ldx, y, ldy, typename FieldTraits<Field>::category(),
+						   typename isZOSparseMatrix<Field, SM>::type());
+		}
+
+		/* y <- beta y + A^T x, the product prod(x, ldx, y, ldy) adding A^T x
+		 * to y, on the permuted copies of x and y if A is reordered: the
+		 * transpose of P A P^T is reordered by the same P.
+		 */
+		template <class Field, class SM, class Product>
+		inline void transpose_product(const Field &F, const SM &A, size_t blockSize, typename Field::ConstElement_ptr x,
+					      int ldx, const typename Field::Element &beta, typename Field::Element_ptr y, int ldy,
+					      Product prod, const bool par) {
+			const index_t *perm = reordering(A, 0);
+			if (perm != nullptr) {
+				reordered_product(F, perm, reorder_scratch<Field>(A, 0), A.n, blockSize, x, ldx, beta, y, ldy,
+						  [&](typename Field::ConstElement_ptr xp, typename Field::Element_ptr yp) {
+							  init_y(F, A.n, blockSize, beta, yp, (int)blockSize);
+							  prod(xp, (int)blockSize, yp, (int)blockSize);
+						  }, par);
+				return;
+			}
+			init_y(F, A.n, blockSize, beta, y, ldy);
+			prod(x, ldx, y, ldy);
+		}
 
 	} // sparse details
 
 	template <class Field, class SM>
 	inline void fspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, const typename Field::Element &beta,
 			  typename Field::Element_ptr y) {
+		const index_t *perm = sparse_details::reordering(A, 0);
+		if (perm != nullptr) {
+			sparse_details::reordered_product(F, perm, sparse_details::reorder_scratch<Field>(A, 0), A.m, 1, x, 1, beta, y, 1,
+							  [&](typename Field::ConstElement_ptr xp, typename Field::Element_ptr yp) {
+								  sparse_details::init_y(F, A.m, beta, yp);
+								  sparse_details::fspmv_dispatch(F, A, xp, yp, typename FieldTraits<Field>::category(),
+												 typename isZOSparseMatrix<Field, SM>::type());
+							  }, false);
+			return;
+		}
 		sparse_details::init_y(F, A.m, beta, y);
 		sparse_details::fspmv_dispatch(F, A, x, y, typename FieldTraits<Field>::category(),
 					       typename isZOSparseMatrix<Field, SM>::type());
@@ -850,6 +794,17 @@ namespace FFLAS {
 	template <class Field, class SM>
 	inline void fspmm(const Field &F, const SM &A, size_t blockSize, typename Field::ConstElement_ptr x, int ldx,
 			  const typename Field::Element &beta, typename Field::Element_ptr y, int ldy) {
+		const index_t *perm = sparse_details::reordering(A, 0);
+		if (perm != nullptr) {
+			sparse_details::reordered_product(F, perm, sparse_details::reorder_scratch<Field>(A, 0), A.m, blockSize, x, ldx, beta, y, ldy,
+							  [&](typename Field::ConstElement_ptr xp, typename Field::Element_ptr yp) {
+								  sparse_details::init_y(F, A.m, blockSize, beta, yp, (int)blockSize);
+								  sparse_details::fspmm_dispatch<Field, SM>(F, A, blockSize, xp, (int)blockSize, yp, (int)blockSize,
+													    typename FieldTraits<Field>::category(),
+													    typename isZOSparseMatrix<Field, SM>::type());
+							  }, false);
+			return;
+		}
 		sparse_details::init_y(F, A.m, blockSize, beta, y, ldy);
 		sparse_details::fspmm_dispatch<Field, SM>(F, A, blockSize, x, ldx, y, ldy, typename FieldTraits<Field>::category(),
 							  typename isZOSparseMatrix<Field, SM>::type());
@@ -860,22 +815,313 @@ namespace FFLAS {
 	template <class Field, class SM>
 	inline void pfspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, const typename Field::Element &beta,
 			   typename Field::Element_ptr y) {
-		sparse_details::init_y(F, A.m, beta, y);
-		sparse_details::pfspmv<Field, SM>(F, A, x, y, 
-                          typename FieldTraits<Field>::category(),
-						  typename isZOSparseMatrix<Field, SM>::type());
+		sparse_details::parallel_fspmv(F, A, x, beta, y);
 	}
 
 	template <class Field, class SM>
 	inline void pfspmm(const Field &F, const SM &A, size_t blockSize, typename Field::ConstElement_ptr x, int ldx,
 			   const typename Field::Element &beta, typename Field::Element_ptr y, int ldy) {
-		sparse_details::init_y(F, A.m, blockSize, beta, y, ldy);
-		sparse_details::pfspmm_dispatch<Field, SM>(F, A, blockSize, x, ldx, y, ldy, typename FieldTraits<Field>::category(),
-							   typename isZOSparseMatrix<Field, SM>::type());
+		sparse_details::parallel_fspmm(F, A, blockSize, x, ldx, beta, y, ldy);
+	}
+
+#endif // __FFLASFFPACK_USE_OPENMP
+
+	template <class Field, class SM>
+	inline void fspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, const typename Field::Element &beta,
+			  typename Field::Element_ptr y, const ParSeqHelper::Sequential &) {
+		fspmv(F, A, x, beta, y);
+	}
+
+	template <class Field, class SM, class Cut, class Param>
+	inline void fspmv(const Field &F, const SM &A, typename Field::ConstElement_ptr x, const typename Field::Element &beta,
+			  typename Field::Element_ptr y, const ParSeqHelper::Parallel<Cut, Param> &H) {
+#if defined(__FFLASFFPACK_USE_OPENMP)
+		if (H.numthreads() > 1) {
+			// the kernels size their teams with MAX_THREADS
+			const int nt = omp_get_max_threads();
+			omp_set_num_threads((int)H.numthreads());
+			pfspmv(F, A, x, beta, y);
+			omp_set_num_threads(nt);
+			return;
+		}
+#endif
+		fspmv(F, A, x, beta, y);
+	}
+
+	template <class Field, class SM>
+	inline void fspmm(const Field &F, const SM &A, size_t blockSize, typename Field::ConstElement_ptr x, int ldx,
+			  const typename Field::Element &beta, typename Field::Element_ptr y, int ldy,
+			  const ParSeqHelper::Sequential &) {
+		fspmm(F, A, blockSize, x, ldx, beta, y, ldy);
+	}
+
+	template <class Field, class SM, class Cut, class Param>
+	inline void fspmm(const Field &F, const SM &A, size_t blockSize, typename Field::ConstElement_ptr x, int ldx,
+			  const typename Field::Element &beta, typename Field::Element_ptr y, int ldy,
+			  const ParSeqHelper::Parallel<Cut, Param> &H) {
+#if defined(__FFLASFFPACK_USE_OPENMP)
+		if (H.numthreads() > 1) {
+			const int nt = omp_get_max_threads();
+			omp_set_num_threads((int)H.numthreads());
+			pfspmm(F, A, blockSize, x, ldx, beta, y, ldy);
+			omp_set_num_threads(nt);
+			return;
+		}
+#endif
+		fspmm(F, A, blockSize, x, ldx, beta, y, ldy);
+	}
+
+#if !defined(__FFLASFFPACK_USE_OPENMP)
+
+	template <class Field, class Cut, class Param>
+	inline void fspmv(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, typename Field::ConstElement_ptr x,
+			  const typename Field::Element &beta, typename Field::Element_ptr y,
+			  const ParSeqHelper::Parallel<Cut, Param> &H) {
+		if (H.numthreads() > 1)
+			sparse_details::parallel_fspmv(F, A, x, beta, y);
+		else
+			fspmv(F, A, x, beta, y);
+	}
+
+	template <class Field, class Cut, class Param>
+	inline void fspmv(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A, typename Field::ConstElement_ptr x,
+			  const typename Field::Element &beta, typename Field::Element_ptr y,
+			  const ParSeqHelper::Parallel<Cut, Param> &H) {
+		if (H.numthreads() > 1)
+			sparse_details::parallel_fspmv(F, A, x, beta, y);
+		else
+			fspmv(F, A, x, beta, y);
+	}
+
+	template <class Field, class Cut, class Param>
+	inline void fspmm(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, size_t blockSize,
+			  typename Field::ConstElement_ptr x, int ldx, const typename Field::Element &beta,
+			  typename Field::Element_ptr y, int ldy, const ParSeqHelper::Parallel<Cut, Param> &H) {
+		if (H.numthreads() > 1)
+			sparse_details::parallel_fspmm(F, A, blockSize, x, ldx, beta, y, ldy);
+		else
+			fspmm(F, A, blockSize, x, ldx, beta, y, ldy);
+	}
+
+	template <class Field, class Cut, class Param>
+	inline void fspmm(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A, size_t blockSize,
+			  typename Field::ConstElement_ptr x, int ldx, const typename Field::Element &beta,
+			  typename Field::Element_ptr y, int ldy, const ParSeqHelper::Parallel<Cut, Param> &H) {
+		if (H.numthreads() > 1)
+			sparse_details::parallel_fspmm(F, A, blockSize, x, ldx, beta, y, ldy);
+		else
+			fspmm(F, A, blockSize, x, ldx, beta, y, ldy);
+	}
+
+#endif // __FFLASFFPACK_USE_OPENMP
+
+	template <class Field, class SM>
+	inline void fspmv_transpose(const Field &F, const SM &A, typename Field::ConstElement_ptr x,
+				    const typename Field::Element &beta, typename Field::Element_ptr y) {
+		fspmv(F, sparse_details::transpose_view(A), x, beta, y);
+	}
+
+	template <class Field>
+	inline void fspmv_transpose(const Field &F, const Sparse<Field, SparseMatrix_t::ELL> &A,
+				    typename Field::ConstElement_ptr x, const typename Field::Element &beta,
+				    typename Field::Element_ptr y) {
+		sparse_details::init_y(F, A.n, beta, y);
+		sparse_details_impl::fspmv_transpose(F, A, x, y, FieldCategories::GenericTag());
+	}
+
+	template <class Field, class SM>
+	inline void fspmm_transpose(const Field &F, const SM &A, size_t blockSize, typename Field::ConstElement_ptr x, int ldx,
+				    const typename Field::Element &beta, typename Field::Element_ptr y, int ldy) {
+		fspmm(F, sparse_details::transpose_view(A), blockSize, x, ldx, beta, y, ldy);
+	}
+
+	template <class Field>
+	inline void fspmm_transpose(const Field &F, const Sparse<Field, SparseMatrix_t::ELL> &A, size_t blockSize,
+				    typename Field::ConstElement_ptr x, int ldx, const typename Field::Element &beta,
+				    typename Field::Element_ptr y, int ldy) {
+		sparse_details::init_y(F, A.n, blockSize, beta, y, ldy);
+		sparse_details_impl::fspmm_transpose(F, A, blockSize, x, ldx, y, ldy, FieldCategories::GenericTag());
+	}
+
+	template <class Field>
+	inline void fspmv_transpose(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A,
+				    typename Field::ConstElement_ptr x, const typename Field::Element &beta,
+				    typename Field::Element_ptr y) {
+		sparse_details::transpose_product(F, A, 1, x, 1, beta, y, 1,
+						  [&](typename Field::ConstElement_ptr xx, int, typename Field::Element_ptr yy, int) {
+							  sparse_details_impl::fspmv_transpose(F, A, xx, yy, FieldCategories::GenericTag());
+						  }, false);
+	}
+
+	template <class Field>
+	inline void fspmv_transpose(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A,
+				    typename Field::ConstElement_ptr x, const typename Field::Element &beta,
+				    typename Field::Element_ptr y) {
+		sparse_details::transpose_product(F, A, 1, x, 1, beta, y, 1,
+						  [&](typename Field::ConstElement_ptr xx, int, typename Field::Element_ptr yy, int) {
+							  sparse_details_impl::fspmv_transpose(F, A, xx, yy, FieldCategories::GenericTag());
+						  }, false);
+	}
+
+	template <class Field>
+	inline void fspmm_transpose(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, size_t blockSize,
+				    typename Field::ConstElement_ptr x, int ldx, const typename Field::Element &beta,
+				    typename Field::Element_ptr y, int ldy) {
+		sparse_details::transpose_product(F, A, blockSize, x, ldx, beta, y, ldy,
+						  [&](typename Field::ConstElement_ptr xx, int ldxx, typename Field::Element_ptr yy, int ldyy) {
+							  sparse_details_impl::fspmm_transpose(F, A, blockSize, xx, ldxx, yy, ldyy,
+											       FieldCategories::GenericTag());
+						  }, false);
+	}
+
+	template <class Field>
+	inline void fspmm_transpose(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A, size_t blockSize,
+				    typename Field::ConstElement_ptr x, int ldx, const typename Field::Element &beta,
+				    typename Field::Element_ptr y, int ldy) {
+		sparse_details::transpose_product(F, A, blockSize, x, ldx, beta, y, ldy,
+						  [&](typename Field::ConstElement_ptr xx, int ldxx, typename Field::Element_ptr yy, int ldyy) {
+							  sparse_details_impl::fspmm_transpose(F, A, blockSize, xx, ldxx, yy, ldyy,
+											       FieldCategories::GenericTag());
+						  }, false);
+	}
+
+#if defined(__FFLASFFPACK_USE_OPENMP)
+
+	template <class Field, class SM>
+	inline void pfspmv_transpose(const Field &F, const SM &A, typename Field::ConstElement_ptr x,
+				     const typename Field::Element &beta, typename Field::Element_ptr y) {
+		pfspmv(F, sparse_details::transpose_view(A), x, beta, y);
+	}
+
+	template <class Field, class SM>
+	inline void pfspmm_transpose(const Field &F, const SM &A, size_t blockSize, typename Field::ConstElement_ptr x, int ldx,
+				     const typename Field::Element &beta, typename Field::Element_ptr y, int ldy) {
+		pfspmm(F, sparse_details::transpose_view(A), blockSize, x, ldx, beta, y, ldy);
+	}
+
+	template <class Field>
+	inline void pfspmv_transpose(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A,
+				     typename Field::ConstElement_ptr x, const typename Field::Element &beta,
+				     typename Field::Element_ptr y) {
+		sparse_details::transpose_product(F, A, 1, x, 1, beta, y, 1,
+						  [&](typename Field::ConstElement_ptr xx, int, typename Field::Element_ptr yy, int) {
+							  sparse_details_impl::pfspmv_transpose(F, A, xx, yy, FieldCategories::GenericTag());
+						  }, true);
+	}
+
+	template <class Field>
+	inline void pfspmv_transpose(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A,
+				     typename Field::ConstElement_ptr x, const typename Field::Element &beta,
+				     typename Field::Element_ptr y) {
+		sparse_details::transpose_product(F, A, 1, x, 1, beta, y, 1,
+						  [&](typename Field::ConstElement_ptr xx, int, typename Field::Element_ptr yy, int) {
+							  sparse_details_impl::pfspmv_transpose(F, A, xx, yy, FieldCategories::GenericTag());
+						  }, true);
+	}
+
+	template <class Field>
+	inline void pfspmm_transpose(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, size_t blockSize,
+				     typename Field::ConstElement_ptr x, int ldx, const typename Field::Element &beta,
+				     typename Field::Element_ptr y, int ldy) {
+		sparse_details::transpose_product(F, A, blockSize, x, ldx, beta, y, ldy,
+						  [&](typename Field::ConstElement_ptr xx, int ldxx, typename Field::Element_ptr yy, int ldyy) {
+							  sparse_details_impl::pfspmm_transpose(F, A, blockSize, xx, ldxx, yy, ldyy,
+												FieldCategories::GenericTag());
+						  }, true);
+	}
+
+	template <class Field>
+	inline void pfspmm_transpose(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A, size_t blockSize,
+				     typename Field::ConstElement_ptr x, int ldx, const typename Field::Element &beta,
+				     typename Field::Element_ptr y, int ldy) {
+		sparse_details::transpose_product(F, A, blockSize, x, ldx, beta, y, ldy,
+						  [&](typename Field::ConstElement_ptr xx, int ldxx, typename Field::Element_ptr yy, int ldyy) {
+							  sparse_details_impl::pfspmm_transpose(F, A, blockSize, xx, ldxx, yy, ldyy,
+												FieldCategories::GenericTag());
+						  }, true);
 	}
 
 #endif // __FFLASFFPACK_USE_OPENMP
 
+	namespace sparse_details {
+
+		/*************************************************************************************
+		 *
+		 *      fspgemm dispatch: as fspmv, the modular fields accumulate without reduction
+		 *      up to kmax products
+		 *
+		 *************************************************************************************/
+
+		template <class Field, class SMA, class SMB, class FC>
+		inline typename std::enable_if<
+			!(std::is_same<typename ElementTraits<typename Field::Element>::value, ElementCategories::MachineFloatTag>::value ||
+			  std::is_same<typename ElementTraits<typename Field::Element>::value,
+			  ElementCategories::MachineIntTag>::value)>::type
+		fspgemm_dispatch(const Field &F, const SMA &A, const SMB &B, Sparse<Field, SparseMatrix_t::CSR> &C,
+				 size_t nt, FC) {
+			sparse_details_impl::fspgemm(F, A, B, C, nt, 0, FieldCategories::GenericTag());
+		}
+
+		template <class Field, class SMA, class SMB, class FC>
+		inline typename std::enable_if<
+			std::is_same<typename ElementTraits<typename Field::Element>::value, ElementCategories::MachineFloatTag>::value ||
+		std::is_same<typename ElementTraits<typename Field::Element>::value, ElementCategories::MachineIntTag>::value>::type
+		fspgemm_dispatch(const Field &F, const SMA &A, const SMB &B, Sparse<Field, SparseMatrix_t::CSR> &C,
+				 size_t nt, FC) {
+			sparse_details::fspgemm(F, A, B, C, nt, FC());
+		}
+
+		template <class Field, class SMA, class SMB>
+		inline void fspgemm(const Field &F, const SMA &A, const SMB &B, Sparse<Field, SparseMatrix_t::CSR> &C,
+				    size_t nt, FieldCategories::GenericTag) {
+			sparse_details_impl::fspgemm(F, A, B, C, nt, 0, FieldCategories::GenericTag());
+		}
+
+		template <class Field, class SMA, class SMB>
+		inline void fspgemm(const Field &F, const SMA &A, const SMB &B, Sparse<Field, SparseMatrix_t::CSR> &C,
+				    size_t nt, FieldCategories::UnparametricTag) {
+			sparse_details_impl::fspgemm(F, A, B, C, nt, 0, FieldCategories::UnparametricTag());
+		}
+
+		template <class Field, class SMA, class SMB>
+		inline void fspgemm(const Field &F, const SMA &A, const SMB &B, Sparse<Field, SparseMatrix_t::CSR> &C,
+				    size_t nt, FieldCategories::ModularTag) {
+			const uint64_t kmax = std::max<uint64_t>(1, Protected::DotProdBoundClassic(F, F.one));
+			sparse_details_impl::fspgemm(F, A, B, C, nt, kmax, FieldCategories::UnparametricTag());
+		}
+
+	} // sparse_details
+
+	template <class Field, class SMA, class SMB>
+	inline void fspgemm(const Field &F, const SMA &A, const SMB &B, Sparse<Field, SparseMatrix_t::CSR> &C) {
+		FFLASFFPACK_check(A.n == B.m);
+		FFLASFFPACK_check(A.reorder == nullptr && B.reorder == nullptr);
+		sparse_details::fspgemm_dispatch(F, A, B, C, 1, typename FieldTraits<Field>::category());
+	}
+
+	template <class Field, class SMA, class SMB>
+	inline void fspgemm(const Field &F, const SMA &A, const SMB &B, Sparse<Field, SparseMatrix_t::CSR> &C,
+			    const ParSeqHelper::Sequential &) {
+		fspgemm(F, A, B, C);
+	}
+
+	template <class Field, class SMA, class SMB, class Cut, class Param>
+	inline void fspgemm(const Field &F, const SMA &A, const SMB &B, Sparse<Field, SparseMatrix_t::CSR> &C,
+			    const ParSeqHelper::Parallel<Cut, Param> &H) {
+		FFLASFFPACK_check(A.n == B.m);
+		FFLASFFPACK_check(A.reorder == nullptr && B.reorder == nullptr);
+		sparse_details::fspgemm_dispatch(F, A, B, C, (size_t)H.numthreads(), typename FieldTraits<Field>::category());
+	}
+
+#if defined(__FFLASFFPACK_USE_OPENMP)
+	template <class Field, class SMA, class SMB>
+	inline void pfspgemm(const Field &F, const SMA &A, const SMB &B, Sparse<Field, SparseMatrix_t::CSR> &C) {
+		FFLASFFPACK_check(A.n == B.m);
+		FFLASFFPACK_check(A.reorder == nullptr && B.reorder == nullptr);
+		sparse_details::fspgemm_dispatch(F, A, B, C, (size_t)MAX_THREADS, typename FieldTraits<Field>::category());
+	}
+#endif
+
 	// template <class Field, class SM>
 	// inline void pfspmm(const Field &F, const SM &A, size_t blockSize,
 	//                    typename Field::ConstElement_ptr x, int ldx,
@@ -0,0 +1,112 @@
+/* -*- mode: C++; tab-width: 8; indent-tabs-mode: t; c-basic-offset: 8 -*- */
+// vim:sts=4:sw=4:ts=4:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/*
+ * Copyright (C) 2016 the FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ * ========LICENCE========
+ *.
+ */
+
+/** @file fflas/fflas_sparse/auto.h
+ * @brief Sparse matrix choosing its storage format.
+ *
+ * sparse_init computes the StatsMatrix of the input and keeps, best guess
+ * first, the formats suited to it among CSR, ELL, CSR_HYB and HYB_ZO (the
+ * fastest formats of FFLAS::tuning() come first when they are suited).
+ * The first fspmv calls are then timed on each candidate in turn, \c trials
+ * calls each, and the fastest format is kept; the others and the copy of the
+ * input are freed. With \c trials = 0 the best guess is used directly.
+ * The timed calls must not run concurrently on the same matrix.
+ */
+
+#ifndef __FFLASFFPACK_fflas_sparse_AUTO_H
+#define __FFLASFFPACK_fflas_sparse_AUTO_H
+
+#include <vector>
+#include <string>
+
+#include "fflas-ffpack/utils/timer.h"
+#include "fflas-ffpack/utils/fflas_tuning.h"
+
+#ifndef __FFLASFFPACK_SPARSE_AUTO_TRIALS
+#define __FFLASFFPACK_SPARSE_AUTO_TRIALS 3
+#endif
+
+namespace FFLAS { /*  AUTO */
+
+template <class _Field> struct Sparse<_Field, SparseMatrix_t::AUTO> {
+    using Field = _Field;
+    index_t m = 0;
+    index_t n = 0;
+    uint64_t nnz = 0;
+    uint64_t nElements = 0;
+    StatsMatrix stats;
+    // format in use, always built
+    mutable SparseMatrix_t format = SparseMatrix_t::CSR;
+    // formats to time, empty once the choice is made
+    mutable std::vector<SparseMatrix_t> candidates;
+    mutable size_t next = 0;
+    mutable size_t calls = 0;
+    mutable double elapsed = 0;
+    mutable double bestTime = 0;
+    size_t trials = 0;
+    // copy of the input, kept while candidates remain
+    mutable index_t *row = nullptr;
+    mutable index_t *col = nullptr;
+    mutable typename _Field::Element_ptr dat = nullptr;
+    mutable Sparse<_Field, SparseMatrix_t::CSR> *csr = nullptr;
+    mutable Sparse<_Field, SparseMatrix_t::ELL> *ell = nullptr;
+    mutable Sparse<_Field, SparseMatrix_t::CSR_HYB> *csr_hyb = nullptr;
+    mutable Sparse<_Field, SparseMatrix_t::HYB_ZO> *hyb_zo = nullptr;
+};
+
+template <class Field> using AutoSparse = Sparse<Field, SparseMatrix_t::AUTO>;
+
+//! name of a sparse format, as written in the machine profile
+inline std::string sparse_format_name(SparseMatrix_t f);
+
+template <class Field>
+inline void sparse_delete(const Sparse<Field, SparseMatrix_t::AUTO> &A);
+
+template <class Field, class IndexT>
+inline void sparse_init(const Field &F, Sparse<Field, SparseMatrix_t::AUTO> &A, const IndexT *row, const IndexT *col,
+                        typename Field::ConstElement_ptr dat, uint64_t rowdim, uint64_t coldim, uint64_t nnz,
+                        size_t trials = __FFLASFFPACK_SPARSE_AUTO_TRIALS);
+
+template <class Field>
+inline void fspmv(const Field &F, const Sparse<Field, SparseMatrix_t::AUTO> &A, typename Field::ConstElement_ptr x,
+                  const typename Field::Element &beta, typename Field::Element_ptr y);
+
+template <class Field>
+inline void fspmm(const Field &F, const Sparse<Field, SparseMatrix_t::AUTO> &A, size_t blockSize,
+                  typename Field::ConstElement_ptr x, int ldx, const typename Field::Element &beta,
+                  typename Field::Element_ptr y, int ldy);
+
+#if defined(__FFLASFFPACK_USE_OPENMP)
+template <class Field>
+inline void pfspmv(const Field &F, const Sparse<Field, SparseMatrix_t::AUTO> &A, typename Field::ConstElement_ptr x,
+                   const typename Field::Element &beta, typename Field::Element_ptr y);
+#endif
+
+} // FFLAS
+
+#include "fflas-ffpack/fflas/fflas_sparse/auto/auto_utils.inl"
+#include "fflas-ffpack/fflas/fflas_sparse/auto/auto_spmv.inl"
+
+#endif // __FFLASFFPACK_fflas_sparse_AUTO_H
@@ -0,0 +1,134 @@
+/* -*- mode: C++; tab-width: 8; indent-tabs-mode: t; c-basic-offset: 8 -*- */
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/*
+ * Copyright (C) 2016 the FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ * ========LICENCE========
+ *.
+ */
+
+#ifndef __FFLASFFPACK_fflas_sparse_AUTO_spmv_INL
+#define __FFLASFFPACK_fflas_sparse_AUTO_spmv_INL
+
+namespace FFLAS {
+
+namespace auto_details {
+
+template <class Field>
+inline void fspmv(const Field &F, const Sparse<Field, SparseMatrix_t::AUTO> &A, SparseMatrix_t f,
+                  typename Field::ConstElement_ptr x, const typename Field::Element &beta,
+                  typename Field::Element_ptr y) {
+    switch (f) {
+    case SparseMatrix_t::ELL:
+        FFLAS::fspmv(F, *(A.ell), x, beta, y);
+        break;
+    case SparseMatrix_t::CSR_HYB:
+        FFLAS::fspmv(F, *(A.csr_hyb), x, beta, y);
+        break;
+    case SparseMatrix_t::HYB_ZO:
+        FFLAS::fspmv(F, *(A.hyb_zo), x, beta, y);
+        break;
+    default:
+        FFLAS::fspmv(F, *(A.csr), x, beta, y);
+    }
+}
+
+template <class Field>
+inline void fspmm(const Field &F, const Sparse<Field, SparseMatrix_t::AUTO> &A, SparseMatrix_t f, size_t blockSize,
+                  typename Field::ConstElement_ptr x, int ldx, const typename Field::Element &beta,
+                  typename Field::Element_ptr y, int ldy) {
+    switch (f) {
+    case SparseMatrix_t::ELL:
+        FFLAS::fspmm(F, *(A.ell), blockSize, x, ldx, beta, y, ldy);
+        break;
+    case SparseMatrix_t::CSR_HYB:
+        FFLAS::fspmm(F, *(A.csr_hyb), blockSize, x, ldx, beta, y, ldy);
+        break;
+    case SparseMatrix_t::HYB_ZO:
+        FFLAS::fspmm(F, *(A.hyb_zo), blockSize, x, ldx, beta, y, ldy);
+        break;
+    default:
+        FFLAS::fspmm(F, *(A.csr), blockSize, x, ldx, beta, y, ldy);
+    }
+}
+
+} // auto_details
+
+template <class Field>
+inline void fspmv(const Field &F, const Sparse<Field, SparseMatrix_t::AUTO> &A, typename Field::ConstElement_ptr x,
+                  const typename Field::Element &beta, typename Field::Element_ptr y) {
+    if (A.candidates.empty()) {
+        auto_details::fspmv(F, A, A.format, x, beta, y);
+        return;
+    }
+    // timing the candidate A.next
+    const SparseMatrix_t f = A.candidates[A.next];
+    auto_details::build(F, A, f);
+    FFLAS::Timer chrono;
+    chrono.clear();
+    chrono.start();
+    auto_details::fspmv(F, A, f, x, beta, y);
+    chrono.stop();
+    A.elapsed += chrono.realtime();
+    if (++A.calls < A.trials)
+        return;
+    if (A.next == 0 || A.elapsed < A.bestTime) {
+        if (f != A.format)
+            auto_details::release(A, A.format);
+        A.format = f;
+        A.bestTime = A.elapsed;
+    } else {
+        auto_details::release(A, f);
+    }
+    A.calls = 0;
+    A.elapsed = 0;
+    if (++A.next == A.candidates.size())
+        auto_details::finish(A);
+}
+
+template <class Field>
+inline void fspmm(const Field &F, const Sparse<Field, SparseMatrix_t::AUTO> &A, size_t blockSize,
+                  typename Field::ConstElement_ptr x, int ldx, const typename Field::Element &beta,
+                  typename Field::Element_ptr y, int ldy) {
+    auto_details::fspmm(F, A, A.format, blockSize, x, ldx, beta, y, ldy);
+}
+
+#if defined(__FFLASFFPACK_USE_OPENMP)
+template <class Field>
+inline void pfspmv(const Field &F, const Sparse<Field, SparseMatrix_t::AUTO> &A, typename Field::ConstElement_ptr x,
+                   const typename Field::Element &beta, typename Field::Element_ptr y) {
+    switch (A.format) {
+    case SparseMatrix_t::ELL:
+        FFLAS::pfspmv(F, *(A.ell), x, beta, y);
+        break;
+    case SparseMatrix_t::CSR_HYB:
+        FFLAS::pfspmv(F, *(A.csr_hyb), x, beta, y);
+        break;
+    case SparseMatrix_t::HYB_ZO:
+        FFLAS::pfspmv(F, *(A.hyb_zo), x, beta, y);
+        break;
+    default:
+        FFLAS::pfspmv(F, *(A.csr), x, beta, y);
+    }
+}
+#endif // __FFLASFFPACK_USE_OPENMP
+
+} // FFLAS
+
+#endif // __FFLASFFPACK_fflas_sparse_AUTO_spmv_INL
@@ -0,0 +1,200 @@
+/* -*- mode: C++; tab-width: 8; indent-tabs-mode: t; c-basic-offset: 8 -*- */
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/*
+ * Copyright (C) 2016 the FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ * ========LICENCE========
+ *.
+ */
+
+#ifndef __FFLASFFPACK_fflas_sparse_AUTO_utils_INL
+#define __FFLASFFPACK_fflas_sparse_AUTO_utils_INL
+
+#include <algorithm>
+
+namespace FFLAS {
+
+inline std::string sparse_format_name(SparseMatrix_t f) {
+    switch (f) {
+    case SparseMatrix_t::CSR:         return "CSR";
+    case SparseMatrix_t::CSR_ZO:      return "CSR_ZO";
+    case SparseMatrix_t::CSC:         return "CSC";
+    case SparseMatrix_t::CSC_ZO:      return "CSC_ZO";
+    case SparseMatrix_t::COO:         return "COO";
+    case SparseMatrix_t::COO_ZO:      return "COO_ZO";
+    case SparseMatrix_t::ELL:         return "ELL";
+    case SparseMatrix_t::ELL_ZO:      return "ELL_ZO";
+    case SparseMatrix_t::SELL:        return "SELL";
+    case SparseMatrix_t::SELL_ZO:     return "SELL_ZO";
+    case SparseMatrix_t::ELL_simd:    return "ELL_simd";
+    case SparseMatrix_t::ELL_simd_ZO: return "ELL_simd_ZO";
+    case SparseMatrix_t::CSR_HYB:     return "CSR_HYB";
+    case SparseMatrix_t::HYB_ZO:      return "HYB_ZO";
+    case SparseMatrix_t::CSR_TILED:   return "CSR_TILED";
+    case SparseMatrix_t::AUTO:        return "AUTO";
+    }
+    return "";
+}
+
+namespace auto_details {
+
+// formats an AutoSparse can take
+static const SparseMatrix_t formats[] = {SparseMatrix_t::CSR, SparseMatrix_t::ELL, SparseMatrix_t::CSR_HYB,
+                                         SparseMatrix_t::HYB_ZO};
+
+/* Formats suited to a matrix, best guess first.
+ * ELL when its padding is below one half, HYB_ZO when at least half of the
+ * entries are +1 or -1, CSR_HYB when some are, and CSR always. The format
+ * measured as the fastest on this machine for the same kind of rows (see
+ * fflas-ffpack-tune) comes first if it is suited.
+ */
+inline std::vector<SparseMatrix_t> candidates(const StatsMatrix &s) {
+    const bool regular = (s.nnz > 0) && (2 * s.maxRow * s.rowdim <= 3 * s.nnz);
+    const uint64_t pm1 = s.nOnes + s.nMOnes;
+    std::vector<SparseMatrix_t> c;
+    if (2 * pm1 >= s.nnz && s.nnz > 0)
+        c.push_back(SparseMatrix_t::HYB_ZO);
+    if (regular)
+        c.push_back(SparseMatrix_t::ELL);
+    if (pm1 > 0)
+        c.push_back(SparseMatrix_t::CSR_HYB);
+    c.push_back(SparseMatrix_t::CSR);
+
+    const std::string &tuned = regular ? tuning().sparse_format_regular : tuning().sparse_format_irregular;
+    for (auto it = c.begin(); it != c.end(); ++it)
+        if (sparse_format_name(*it) == tuned) {
+            std::rotate(c.begin(), it, it + 1);
+            break;
+        }
+    return c;
+}
+
+template <class Field> inline void build(const Field &F, const Sparse<Field, SparseMatrix_t::AUTO> &A, SparseMatrix_t f) {
+    switch (f) {
+    case SparseMatrix_t::ELL:
+        if (A.ell == nullptr) {
+            A.ell = new Sparse<Field, SparseMatrix_t::ELL>();
+            sparse_init(F, *(A.ell), A.row, A.col, A.dat, A.m, A.n, A.nnz);
+        }
+        break;
+    case SparseMatrix_t::CSR_HYB:
+        if (A.csr_hyb == nullptr) {
+            A.csr_hyb = new Sparse<Field, SparseMatrix_t::CSR_HYB>();
+            sparse_init(F, *(A.csr_hyb), A.row, A.col, A.dat, A.m, A.n, A.nnz);
+        }
+        break;
+    case SparseMatrix_t::HYB_ZO:
+        if (A.hyb_zo == nullptr) {
+            A.hyb_zo = new Sparse<Field, SparseMatrix_t::HYB_ZO>();
+            sparse_init(F, *(A.hyb_zo), A.row, A.col, A.dat, A.m, A.n, A.nnz);
+        }
+        break;
+    default:
+        if (A.csr == nullptr) {
+            A.csr = new Sparse<Field, SparseMatrix_t::CSR>();
+            sparse_init(F, *(A.csr), A.row, A.col, A.dat, A.m, A.n, A.nnz);
+        }
+    }
+}
+
+template <class Field> inline void release(const Sparse<Field, SparseMatrix_t::AUTO> &A, SparseMatrix_t f) {
+    switch (f) {
+    case SparseMatrix_t::ELL:
+        if (A.ell != nullptr) {
+            sparse_delete(*(A.ell));
+            delete A.ell;
+            A.ell = nullptr;
+        }
+        break;
+    case SparseMatrix_t::CSR_HYB:
+        if (A.csr_hyb != nullptr) {
+            sparse_delete(*(A.csr_hyb));
+            delete A.csr_hyb;
+            A.csr_hyb = nullptr;
+        }
+        break;
+    case SparseMatrix_t::HYB_ZO:
+        if (A.hyb_zo != nullptr) {
+            sparse_delete(*(A.hyb_zo));
+            delete A.hyb_zo;
+            A.hyb_zo = nullptr;
+        }
+        break;
+    default:
+        if (A.csr != nullptr) {
+            sparse_delete(*(A.csr));
+            delete A.csr;
+            A.csr = nullptr;
+        }
+    }
+}
+
+// the format is chosen: frees the copy of the input
+template <class Field> inline void finish(const Sparse<Field, SparseMatrix_t::AUTO> &A) {
+    A.candidates.clear();
+    A.next = 0;
+    fflas_delete(A.row);
+    fflas_delete(A.col);
+    fflas_delete(A.dat);
+    A.row = nullptr;
+    A.col = nullptr;
+    A.dat = nullptr;
+}
+
+} // auto_details
+
+template <class Field> inline void sparse_delete(const Sparse<Field, SparseMatrix_t::AUTO> &A) {
+    for (SparseMatrix_t f : auto_details::formats)
+        auto_details::release(A, f);
+    auto_details::finish(A);
+}
+
+template <class Field, class IndexT>
+inline void sparse_init(const Field &F, Sparse<Field, SparseMatrix_t::AUTO> &A, const IndexT *row, const IndexT *col,
+                        typename Field::ConstElement_ptr dat, uint64_t rowdim, uint64_t coldim, uint64_t nnz,
+                        size_t trials) {
+    A.m = rowdim;
+    A.n = coldim;
+    A.nnz = nnz;
+    A.nElements = nnz;
+    A.trials = trials;
+    A.stats = getStat(F, row, col, dat, rowdim, coldim, nnz);
+    A.candidates = auto_details::candidates(A.stats);
+    A.next = 0;
+    A.calls = 0;
+    A.elapsed = 0;
+
+    A.row = fflas_new<index_t>(nnz, Alignment::CACHE_LINE);
+    A.col = fflas_new<index_t>(nnz, Alignment::CACHE_LINE);
+    A.dat = fflas_new(F, nnz, 1, Alignment::CACHE_LINE);
+    for (uint64_t i = 0; i < nnz; ++i) {
+        A.row[i] = static_cast<index_t>(row[i]);
+        A.col[i] = static_cast<index_t>(col[i]);
+        F.assign(A.dat[i], dat[i]);
+    }
+
+    A.format = A.candidates.front();
+    auto_details::build(F, A, A.format);
+    if (trials == 0 || A.candidates.size() == 1)
+        auto_details::finish(A);
+}
+
+} // FFLAS
+
+#endif // __FFLASFFPACK_fflas_sparse_AUTO_utils_INL
@@ -0,0 +1,98 @@
+/* -*- mode: C++; tab-width: 8; indent-tabs-mode: t; c-basic-offset: 8 -*- */
+// vim:sts=4:sw=4:ts=4:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/*
+ * Copyright (C) 2016 the FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ * ========LICENCE========
+ *.
+ */
+
+/** @file fflas/fflas_sparse/csc.h
+ * @brief Compressed sparse column storage.
+ *
+ * The entries of column j are dat[st[j]..st[j+1]-1], in rows row[...].
+ * A x scatters each column into y; A^T x gathers, as CSR does for A x.
+ * The arrays of a CSR matrix are those of the CSC storage of its transpose,
+ * which is how fspmv_transpose works on CSR and CSC without copy.
+ */
+
+#ifndef __FFLASFFPACK_fflas_sparse_CSC_H
+#define __FFLASFFPACK_fflas_sparse_CSC_H
+
+namespace FFLAS { /*  CSC */
+
+template <class _Field> struct Sparse<_Field, SparseMatrix_t::CSC> {
+    using Field = _Field;
+    bool delayed = false;
+    uint64_t kmax = 0;
+    index_t m = 0;
+    index_t n = 0;
+    uint64_t nnz = 0;
+    uint64_t nElements = 0;
+    uint64_t maxrow = 0;
+    uint64_t maxcol = 0;
+    index_t *row = nullptr;
+    index_t *st = nullptr;
+    typename _Field::Element_ptr dat = nullptr;
+    // reordering of the CSR matrix whose transposed view this is, see SparseReordering
+    index_t *reorder = nullptr;
+    // permuted copies of x and y for the products, nullptr if A is not reordered
+    sparse_details::ReorderScratch<_Field> *reorderScratch = nullptr;
+};
+
+template <class _Field>
+struct Sparse<_Field, SparseMatrix_t::CSC_ZO>
+    : public Sparse<_Field, SparseMatrix_t::CSC> {
+    using Field = _Field;
+    int64_t cst = 1;
+};
+
+template <class Field, class IndexT>
+inline void sparse_init(const Field &F, Sparse<Field, SparseMatrix_t::CSC> &A,
+                        const IndexT *row, const IndexT *col,
+                        typename Field::ConstElement_ptr dat, uint64_t rowdim,
+                        uint64_t coldim, uint64_t nnz);
+
+template <class Field, class IndexT>
+inline void sparse_init(const Field &F,
+                        Sparse<Field, SparseMatrix_t::CSC_ZO> &A,
+                        const IndexT *row, const IndexT *col,
+                        typename Field::ConstElement_ptr dat, uint64_t rowdim,
+                        uint64_t coldim, uint64_t nnz);
+
+template <class Field>
+inline void sparse_delete(const Sparse<Field, SparseMatrix_t::CSC> &A);
+
+template <class Field>
+inline void sparse_delete(const Sparse<Field, SparseMatrix_t::CSC_ZO> &A);
+
+} // FFLAS
+
+#include "fflas-ffpack/fflas/fflas_sparse/csc/csc_utils.inl"
+#include "fflas-ffpack/fflas/fflas_sparse/csc/csc_spmv.inl"
+#include "fflas-ffpack/fflas/fflas_sparse/csc/csc_spmm.inl"
+
+#if defined(__FFLASFFPACK_USE_OPENMP)
+
+#include "fflas-ffpack/fflas/fflas_sparse/csc/csc_pspmv.inl"
+#include "fflas-ffpack/fflas/fflas_sparse/csc/csc_pspmm.inl"
+
+#endif
+
+#endif // __FFLASFFPACK_fflas_sparse_CSC_H
@@ -0,0 +1,101 @@
+/* -*- mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+// vim:sts=4:sw=4:ts=4:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/*
+ * Copyright (C) 2016 the FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ * ========LICENCE========
+ *.
+ */
+
+#ifndef __FFLASFFPACK_fflas_sparse_CSC_pspmm_INL
+#define __FFLASFFPACK_fflas_sparse_CSC_pspmm_INL
+
+namespace FFLAS {
+namespace sparse_details_impl {
+
+template <class Field, class FieldCat>
+inline void pfspmm_columns(const Field &F, const Sparse<Field, SparseMatrix_t::CSC> &A, size_t blockSize,
+                           typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                           FieldCat tag) {
+    csc_parallel_columns(F, A, blockSize, y, ldy, tag,
+                         [&](index_t jbeg, index_t jend, size_t, typename Field::Element_ptr z, int ldz) {
+                             fspmm_columns(F, A, jbeg, jend, blockSize, x, ldx, z, ldz, tag);
+                         });
+}
+
+template <class Field>
+inline void pfspmm(const Field &F, const Sparse<Field, SparseMatrix_t::CSC> &A, size_t blockSize,
+                   typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                   FieldCategories::GenericTag) {
+    pfspmm_columns(F, A, blockSize, x, ldx, y, ldy, FieldCategories::GenericTag());
+}
+
+template <class Field>
+inline void pfspmm(const Field &F, const Sparse<Field, SparseMatrix_t::CSC> &A, size_t blockSize,
+                   typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                   FieldCategories::UnparametricTag) {
+    pfspmm_columns(F, A, blockSize, x, ldx, y, ldy, FieldCategories::UnparametricTag());
+}
+
+// each copy is reduced by its thread before the copies are added modulo p
+template <class Field>
+inline void pfspmm(const Field &F, const Sparse<Field, SparseMatrix_t::CSC> &A, size_t blockSize,
+                   typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                   const int64_t kmax) {
+    std::vector<index_t> cnt(std::max<size_t>(1, std::min<size_t>(MAX_THREADS, A.n)) * A.m, 0);
+    csc_parallel_columns(F, A, blockSize, y, ldy, FieldCategories::GenericTag(),
+                         [&](index_t jbeg, index_t jend, size_t t, typename Field::Element_ptr z, int ldz) {
+                             fspmm_columns(F, A, jbeg, jend, blockSize, x, ldx, z, ldz, cnt.data() + t * A.m, kmax);
+                             freduce(F, A.m, blockSize, z, ldz);
+                         });
+}
+
+template <class Field>
+inline void pfspmm_simd_aligned(const Field &F, const Sparse<Field, SparseMatrix_t::CSC> &A, size_t blockSize,
+                                typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                                FieldCategories::UnparametricTag) {
+    pfspmm(F, A, blockSize, x, ldx, y, ldy, FieldCategories::UnparametricTag());
+}
+
+template <class Field>
+inline void pfspmm_simd_unaligned(const Field &F, const Sparse<Field, SparseMatrix_t::CSC> &A, size_t blockSize,
+                                  typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                                  FieldCategories::UnparametricTag) {
+    pfspmm(F, A, blockSize, x, ldx, y, ldy, FieldCategories::UnparametricTag());
+}
+
+template <class Field>
+inline void pfspmm_simd_aligned(const Field &F, const Sparse<Field, SparseMatrix_t::CSC> &A, size_t blockSize,
+                                typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                                const int64_t kmax) {
+    pfspmm(F, A, blockSize, x, ldx, y, ldy, kmax);
+}
+
+template <class Field>
+inline void pfspmm_simd_unaligned(const Field &F, const Sparse<Field, SparseMatrix_t::CSC> &A, size_t blockSize,
+                                  typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                                  const int64_t kmax) {
+    pfspmm(F, A, blockSize, x, ldx, y, ldy, kmax);
+}
+
+} // sparse_details_impl
+
+} // FFLAS
+
+#endif // __FFLASFFPACK_fflas_sparse_CSC_pspmm_INL
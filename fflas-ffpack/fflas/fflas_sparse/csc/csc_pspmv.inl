@@ -0,0 +1,169 @@
+/* -*- mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+// vim:sts=4:sw=4:ts=4:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/*
+ * Copyright (C) 2016 the FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ * ========LICENCE========
+ *.
+ */
+
+#ifndef __FFLASFFPACK_fflas_sparse_CSC_pspmv_INL
+#define __FFLASFFPACK_fflas_sparse_CSC_pspmv_INL
+
+namespace FFLAS {
+namespace sparse_details_impl {
+
+/* The parallel products of a CSC matrix scatter the columns of thread t,
+ * chosen to hold about nnz/p entries, into a zeroed private copy of y; the
+ * copies are then added to y, the rows being split among the threads.
+ * They use MAX_THREADS copies of y.
+ */
+template <class Field>
+inline void csc_thread_columns(const Sparse<Field, SparseMatrix_t::CSC> &A, size_t t, size_t p, index_t &jbeg,
+                               index_t &jend) {
+    const index_t *start = A.st, *stop = A.st + A.n;
+    jbeg = (t == 0) ? 0 : (index_t)(std::lower_bound(start, stop, (index_t)(A.nnz * t / p)) - start);
+    jend = (t + 1 == p) ? A.n : (index_t)(std::lower_bound(start, stop, (index_t)(A.nnz * (t + 1) / p)) - start);
+}
+
+// y += the private copies of thread 0..p-1, rows split among the threads
+template <class Field>
+inline void csc_add_copies(const Field &F, index_t m, size_t blockSize, typename Field::ConstElement_ptr buf,
+                           size_t ldb, size_t p, typename Field::Element_ptr y, int ldy, FieldCategories::GenericTag) {
+#pragma omp for schedule(static)
+    for (index_t i = 0; i < m; ++i)
+        for (size_t s = 0; s < p; ++s)
+            faddin(F, blockSize, buf + s * ldb + i * blockSize, 1, y + i * ldy, 1);
+}
+
+template <class Field>
+inline void csc_add_copies(const Field &F, index_t m, size_t blockSize, typename Field::ConstElement_ptr buf,
+                           size_t ldb, size_t p, typename Field::Element_ptr y, int ldy,
+                           FieldCategories::UnparametricTag) {
+#pragma omp for schedule(static)
+    for (index_t i = 0; i < m; ++i)
+        for (size_t s = 0; s < p; ++s)
+            for (size_t b = 0; b < blockSize; ++b)
+                y[i * ldy + b] += buf[s * ldb + i * blockSize + b];
+}
+
+/* Runs f(jbeg, jend, t, z, ldz) on the columns of each thread t, z being its
+ * zeroed copy of Y, then adds the copies to Y with the tag addTag. With a
+ * single thread f writes Y directly.
+ */
+template <class Field, class FieldCat, class Func>
+inline void csc_parallel_columns(const Field &F, const Sparse<Field, SparseMatrix_t::CSC> &A, size_t blockSize,
+                                 typename Field::Element_ptr y, int ldy, FieldCat addTag, Func f) {
+    const size_t nt = std::min<size_t>(MAX_THREADS, A.n);
+    if (nt <= 1 || A.m == 0) {
+        f((index_t)0, A.n, (size_t)0, y, ldy);
+        return;
+    }
+    // the copies are one cache line apart
+    const size_t ldb = A.m * blockSize + __FFLASFFPACK_CACHE_LINE_SIZE / sizeof(typename Field::Element);
+    typename Field::Element_ptr buf = fflas_new(F, nt, ldb, Alignment::CACHE_LINE);
+#pragma omp parallel num_threads(nt)
+    {
+        const size_t p = omp_get_num_threads();
+        const size_t t = omp_get_thread_num();
+        index_t jbeg, jend;
+        csc_thread_columns(A, t, p, jbeg, jend);
+        fzero(F, A.m * blockSize, buf + t * ldb, 1);
+        f(jbeg, jend, t, buf + t * ldb, (int)blockSize);
+#pragma omp barrier
+        csc_add_copies(F, A.m, blockSize, buf, ldb, p, y, ldy, addTag);
+    }
+    fflas_delete(buf);
+}
+
+template <class Field>
+inline void pfspmv(const Field &F, const Sparse<Field, SparseMatrix_t::CSC> &A, typename Field::ConstElement_ptr x,
+                   typename Field::Element_ptr y, FieldCategories::GenericTag) {
+    csc_parallel_columns(F, A, 1, y, 1, FieldCategories::GenericTag(),
+                         [&](index_t jbeg, index_t jend, size_t, typename Field::Element_ptr z, int) {
+                             fspmv_columns(F, A, jbeg, jend, x, z, FieldCategories::GenericTag());
+                         });
+}
+
+template <class Field>
+inline void pfspmv(const Field &F, const Sparse<Field, SparseMatrix_t::CSC> &A, typename Field::ConstElement_ptr x,
+                   typename Field::Element_ptr y, FieldCategories::UnparametricTag) {
+    csc_parallel_columns(F, A, 1, y, 1, FieldCategories::UnparametricTag(),
+                         [&](index_t jbeg, index_t jend, size_t, typename Field::Element_ptr z, int) {
+                             fspmv_columns(F, A, jbeg, jend, x, z, FieldCategories::UnparametricTag());
+                         });
+}
+
+// each copy is reduced by its thread before the copies are added modulo p
+template <class Field>
+inline void pfspmv(const Field &F, const Sparse<Field, SparseMatrix_t::CSC> &A, typename Field::ConstElement_ptr x,
+                   typename Field::Element_ptr y, const int64_t kmax) {
+    std::vector<index_t> cnt(std::max<size_t>(1, std::min<size_t>(MAX_THREADS, A.n)) * A.m, 0);
+    csc_parallel_columns(F, A, 1, y, 1, FieldCategories::GenericTag(),
+                         [&](index_t jbeg, index_t jend, size_t t, typename Field::Element_ptr z, int) {
+                             fspmv_columns(F, A, jbeg, jend, x, z, cnt.data() + t * A.m, kmax);
+                             freduce(F, A.m, z, 1);
+                         });
+}
+
+template <class Field>
+inline void fspmv_zo_columns(const Field &F, const Sparse<Field, SparseMatrix_t::CSC_ZO> &A, index_t jbeg,
+                             index_t jend, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
+                             bool one, FieldCategories::GenericTag) {
+    for (index_t j = jbeg; j < jend; ++j)
+        for (index_t k = A.st[j]; k < A.st[j + 1]; ++k) {
+            if (one)
+                F.addin(y[A.row[k]], x[j]);
+            else
+                F.subin(y[A.row[k]], x[j]);
+        }
+}
+
+template <class Field>
+inline void fspmv_zo_columns(const Field &F, const Sparse<Field, SparseMatrix_t::CSC_ZO> &A, index_t jbeg,
+                             index_t jend, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
+                             bool one, FieldCategories::UnparametricTag) {
+    for (index_t j = jbeg; j < jend; ++j) {
+        const typename Field::Element xj = one ? x[j] : -x[j];
+        for (index_t k = A.st[j]; k < A.st[j + 1]; ++k)
+            y[A.row[k]] += xj;
+    }
+}
+
+template <class Field, class FieldCat>
+inline void pfspmv_one(const Field &F, const Sparse<Field, SparseMatrix_t::CSC_ZO> &A,
+                       typename Field::ConstElement_ptr x, typename Field::Element_ptr y, FieldCat tag) {
+    csc_parallel_columns(F, A, 1, y, 1, tag, [&](index_t jbeg, index_t jend, size_t, typename Field::Element_ptr z, int) {
+        fspmv_zo_columns(F, A, jbeg, jend, x, z, true, tag);
+    });
+}
+
+template <class Field, class FieldCat>
+inline void pfspmv_mone(const Field &F, const Sparse<Field, SparseMatrix_t::CSC_ZO> &A,
+                        typename Field::ConstElement_ptr x, typename Field::Element_ptr y, FieldCat tag) {
+    csc_parallel_columns(F, A, 1, y, 1, tag, [&](index_t jbeg, index_t jend, size_t, typename Field::Element_ptr z, int) {
+        fspmv_zo_columns(F, A, jbeg, jend, x, z, false, tag);
+    });
+}
+
+} // sparse_details_impl
+
+} // FFLAS
+
+#endif // __FFLASFFPACK_fflas_sparse_CSC_pspmv_INL
@@ -0,0 +1,252 @@
+/* -*- mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+// vim:sts=4:sw=4:ts=4:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/*
+ * Copyright (C) 2016 the FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ * ========LICENCE========
+ *.
+ */
+
+#ifndef __FFLASFFPACK_fflas_sparse_CSC_spmm_INL
+#define __FFLASFFPACK_fflas_sparse_CSC_spmm_INL
+
+namespace FFLAS {
+namespace sparse_details_impl {
+
+// Y += A[:, jbeg..jend-1] X[jbeg..jend-1, :]: row j of X is scattered into Y
+template <class Field>
+inline void fspmm_columns(const Field &F, const Sparse<Field, SparseMatrix_t::CSC> &A, index_t jbeg, index_t jend,
+                          size_t blockSize, typename Field::ConstElement_ptr x_, int ldx,
+                          typename Field::Element_ptr y_, int ldy, FieldCategories::GenericTag) {
+    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(dat, A.dat, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(row, A.row, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
+    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
+    for (index_t j = jbeg; j < jend; ++j) {
+        for (index_t k = st[j]; k < st[j + 1]; ++k) {
+            size_t b = 0;
+            for (; b < ROUND_DOWN(blockSize, 4); b += 4) {
+                F.axpyin(y[row[k] * ldy + b], dat[k], x[j * ldx + b]);
+                F.axpyin(y[row[k] * ldy + b + 1], dat[k], x[j * ldx + b + 1]);
+                F.axpyin(y[row[k] * ldy + b + 2], dat[k], x[j * ldx + b + 2]);
+                F.axpyin(y[row[k] * ldy + b + 3], dat[k], x[j * ldx + b + 3]);
+            }
+            for (; b < blockSize; ++b)
+                F.axpyin(y[row[k] * ldy + b], dat[k], x[j * ldx + b]);
+        }
+    }
+}
+
+template <class Field>
+inline void fspmm_columns(const Field &F, const Sparse<Field, SparseMatrix_t::CSC> &A, index_t jbeg, index_t jend,
+                          size_t blockSize, typename Field::ConstElement_ptr x_, int ldx,
+                          typename Field::Element_ptr y_, int ldy, FieldCategories::UnparametricTag) {
+    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(dat, A.dat, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(row, A.row, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
+    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
+    for (index_t j = jbeg; j < jend; ++j) {
+        for (index_t k = st[j]; k < st[j + 1]; ++k) {
+            const typename Field::Element d = dat[k];
+            typename Field::Element_ptr yi = y + row[k] * ldy;
+            typename Field::ConstElement_ptr xj = x + j * ldx;
+            for (size_t b = 0; b < blockSize; ++b)
+                yi[b] += d * xj[b];
+        }
+    }
+}
+
+// the block row i of Y is reduced each time it has received kmax products
+template <class Field>
+inline void fspmm_columns(const Field &F, const Sparse<Field, SparseMatrix_t::CSC> &A, index_t jbeg, index_t jend,
+                          size_t blockSize, typename Field::ConstElement_ptr x_, int ldx,
+                          typename Field::Element_ptr y_, int ldy, index_t *cnt, const int64_t kmax) {
+    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(dat, A.dat, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(row, A.row, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
+    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
+    const index_t km = static_cast<index_t>(std::max<int64_t>(1, std::min<int64_t>(kmax, std::numeric_limits<index_t>::max())));
+    for (index_t j = jbeg; j < jend; ++j) {
+        for (index_t k = st[j]; k < st[j + 1]; ++k) {
+            const index_t i = row[k];
+            const typename Field::Element d = dat[k];
+            typename Field::Element_ptr yi = y + i * ldy;
+            typename Field::ConstElement_ptr xj = x + j * ldx;
+            for (size_t b = 0; b < blockSize; ++b)
+                yi[b] += d * xj[b];
+            if (++cnt[i] == km) {
+                freduce(F, blockSize, yi, 1);
+                cnt[i] = 0;
+            }
+        }
+    }
+}
+
+template <class Field>
+inline void fspmm(const Field &F, const Sparse<Field, SparseMatrix_t::CSC> &A, size_t blockSize,
+                  typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                  FieldCategories::GenericTag) {
+    fspmm_columns(F, A, 0, A.n, blockSize, x, ldx, y, ldy, FieldCategories::GenericTag());
+}
+
+template <class Field>
+inline void fspmm(const Field &F, const Sparse<Field, SparseMatrix_t::CSC> &A, size_t blockSize,
+                  typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                  FieldCategories::UnparametricTag) {
+    fspmm_columns(F, A, 0, A.n, blockSize, x, ldx, y, ldy, FieldCategories::UnparametricTag());
+}
+
+template <class Field>
+inline void fspmm(const Field &F, const Sparse<Field, SparseMatrix_t::CSC> &A, size_t blockSize,
+                  typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                  const int64_t kmax) {
+    std::vector<index_t> cnt(A.m, 0);
+    fspmm_columns(F, A, 0, A.n, blockSize, x, ldx, y, ldy, cnt.data(), kmax);
+    freduce(F, A.m, blockSize, y, ldy);
+}
+
+/* The inner loop over the block is contiguous in x and y and left to the
+ * compiler vectorizer: the simd entry points of the dispatch forward to it.
+ */
+template <class Field>
+inline void fspmm_simd_aligned(const Field &F, const Sparse<Field, SparseMatrix_t::CSC> &A, size_t blockSize,
+                               typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                               FieldCategories::UnparametricTag) {
+    fspmm(F, A, blockSize, x, ldx, y, ldy, FieldCategories::UnparametricTag());
+}
+
+template <class Field>
+inline void fspmm_simd_unaligned(const Field &F, const Sparse<Field, SparseMatrix_t::CSC> &A, size_t blockSize,
+                                 typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                                 FieldCategories::UnparametricTag) {
+    fspmm(F, A, blockSize, x, ldx, y, ldy, FieldCategories::UnparametricTag());
+}
+
+template <class Field>
+inline void fspmm_simd_aligned(const Field &F, const Sparse<Field, SparseMatrix_t::CSC> &A, size_t blockSize,
+                               typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                               const int64_t kmax) {
+    fspmm(F, A, blockSize, x, ldx, y, ldy, kmax);
+}
+
+template <class Field>
+inline void fspmm_simd_unaligned(const Field &F, const Sparse<Field, SparseMatrix_t::CSC> &A, size_t blockSize,
+                                 typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                                 const int64_t kmax) {
+    fspmm(F, A, blockSize, x, ldx, y, ldy, kmax);
+}
+
+template <class Field>
+inline void fspmm_one(const Field &F, const Sparse<Field, SparseMatrix_t::CSC_ZO> &A, size_t blockSize,
+                      typename Field::ConstElement_ptr x_, int ldx, typename Field::Element_ptr y_, int ldy,
+                      FieldCategories::GenericTag) {
+    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(row, A.row, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
+    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
+    for (index_t j = 0; j < A.n; ++j)
+        for (index_t k = st[j]; k < st[j + 1]; ++k)
+            for (size_t b = 0; b < blockSize; ++b)
+                F.addin(y[row[k] * ldy + b], x[j * ldx + b]);
+}
+
+template <class Field>
+inline void fspmm_mone(const Field &F, const Sparse<Field, SparseMatrix_t::CSC_ZO> &A, size_t blockSize,
+                       typename Field::ConstElement_ptr x_, int ldx, typename Field::Element_ptr y_, int ldy,
+                       FieldCategories::GenericTag) {
+    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(row, A.row, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
+    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
+    for (index_t j = 0; j < A.n; ++j)
+        for (index_t k = st[j]; k < st[j + 1]; ++k)
+            for (size_t b = 0; b < blockSize; ++b)
+                F.subin(y[row[k] * ldy + b], x[j * ldx + b]);
+}
+
+template <class Field>
+inline void fspmm_one(const Field &F, const Sparse<Field, SparseMatrix_t::CSC_ZO> &A, size_t blockSize,
+                      typename Field::ConstElement_ptr x_, int ldx, typename Field::Element_ptr y_, int ldy,
+                      FieldCategories::UnparametricTag) {
+    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(row, A.row, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
+    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
+    for (index_t j = 0; j < A.n; ++j)
+        for (index_t k = st[j]; k < st[j + 1]; ++k) {
+            typename Field::Element_ptr yi = y + row[k] * ldy;
+            typename Field::ConstElement_ptr xj = x + j * ldx;
+            for (size_t b = 0; b < blockSize; ++b)
+                yi[b] += xj[b];
+        }
+}
+
+template <class Field>
+inline void fspmm_mone(const Field &F, const Sparse<Field, SparseMatrix_t::CSC_ZO> &A, size_t blockSize,
+                       typename Field::ConstElement_ptr x_, int ldx, typename Field::Element_ptr y_, int ldy,
+                       FieldCategories::UnparametricTag) {
+    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(row, A.row, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
+    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
+    for (index_t j = 0; j < A.n; ++j)
+        for (index_t k = st[j]; k < st[j + 1]; ++k) {
+            typename Field::Element_ptr yi = y + row[k] * ldy;
+            typename Field::ConstElement_ptr xj = x + j * ldx;
+            for (size_t b = 0; b < blockSize; ++b)
+                yi[b] -= xj[b];
+        }
+}
+
+template <class Field>
+inline void fspmm_one_simd_aligned(const Field &F, const Sparse<Field, SparseMatrix_t::CSC_ZO> &A, size_t blockSize,
+                                   typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                                   FieldCategories::UnparametricTag) {
+    fspmm_one(F, A, blockSize, x, ldx, y, ldy, FieldCategories::UnparametricTag());
+}
+
+template <class Field>
+inline void fspmm_one_simd_unaligned(const Field &F, const Sparse<Field, SparseMatrix_t::CSC_ZO> &A, size_t blockSize,
+                                     typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y,
+                                     int ldy, FieldCategories::UnparametricTag) {
+    fspmm_one(F, A, blockSize, x, ldx, y, ldy, FieldCategories::UnparametricTag());
+}
+
+template <class Field>
+inline void fspmm_mone_simd_aligned(const Field &F, const Sparse<Field, SparseMatrix_t::CSC_ZO> &A, size_t blockSize,
+                                    typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                                    FieldCategories::UnparametricTag) {
+    fspmm_mone(F, A, blockSize, x, ldx, y, ldy, FieldCategories::UnparametricTag());
+}
+
+template <class Field>
+inline void fspmm_mone_simd_unaligned(const Field &F, const Sparse<Field, SparseMatrix_t::CSC_ZO> &A, size_t blockSize,
+                                      typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y,
+                                      int ldy, FieldCategories::UnparametricTag) {
+    fspmm_mone(F, A, blockSize, x, ldx, y, ldy, FieldCategories::UnparametricTag());
+}
+
+} // sparse_details_impl
+
+} // FFLAS
+
+#endif // __FFLASFFPACK_fflas_sparse_CSC_spmm_INL
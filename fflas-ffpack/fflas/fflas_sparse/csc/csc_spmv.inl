@@ -0,0 +1,190 @@
+/* -*- mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+// vim:sts=4:sw=4:ts=4:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/*
+ * Copyright (C) 2016 the FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ * ========LICENCE========
+ *.
+ */
+
+#ifndef __FFLASFFPACK_fflas_sparse_CSC_spmv_INL
+#define __FFLASFFPACK_fflas_sparse_CSC_spmv_INL
+
+namespace FFLAS {
+namespace sparse_details_impl {
+
+/* y += A[:, jbeg..jend-1] x[jbeg..jend-1]: each column is scattered into y.
+ * The rows of a column are distinct, so the unrolled updates are independent.
+ */
+template <class Field>
+inline void fspmv_columns(const Field &F, const Sparse<Field, SparseMatrix_t::CSC> &A, index_t jbeg, index_t jend,
+                          typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
+                          FieldCategories::GenericTag) {
+    assume_aligned(dat, A.dat, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(row, A.row, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
+    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
+    for (index_t j = jbeg; j < jend; ++j) {
+        if (F.isZero(x[j]))
+            continue;
+        auto start = st[j], stop = st[j + 1];
+        index_t k = 0;
+        index_t diff = stop - start;
+        for (; k < ROUND_DOWN(diff, 4); k += 4) {
+            F.axpyin(y[row[start + k]], dat[start + k], x[j]);
+            F.axpyin(y[row[start + k + 1]], dat[start + k + 1], x[j]);
+            F.axpyin(y[row[start + k + 2]], dat[start + k + 2], x[j]);
+            F.axpyin(y[row[start + k + 3]], dat[start + k + 3], x[j]);
+        }
+        for (; k < diff; ++k) {
+            F.axpyin(y[row[start + k]], dat[start + k], x[j]);
+        }
+    }
+}
+
+template <class Field>
+inline void fspmv_columns(const Field &F, const Sparse<Field, SparseMatrix_t::CSC> &A, index_t jbeg, index_t jend,
+                          typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
+                          FieldCategories::UnparametricTag) {
+    assume_aligned(dat, A.dat, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(row, A.row, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
+    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
+    for (index_t j = jbeg; j < jend; ++j) {
+        const typename Field::Element xj = x[j];
+        auto start = st[j], stop = st[j + 1];
+        index_t k = 0;
+        index_t diff = stop - start;
+        for (; k < ROUND_DOWN(diff, 4); k += 4) {
+            y[row[start + k]] += dat[start + k] * xj;
+            y[row[start + k + 1]] += dat[start + k + 1] * xj;
+            y[row[start + k + 2]] += dat[start + k + 2] * xj;
+            y[row[start + k + 3]] += dat[start + k + 3] * xj;
+        }
+        for (; k < diff; ++k) {
+            y[row[start + k]] += dat[start + k] * xj;
+        }
+    }
+}
+
+/* Delayed reduction when some rows have more than kmax entries: y[i] is
+ * reduced each time it has received kmax products, cnt counts them.
+ */
+template <class Field>
+inline void fspmv_columns(const Field &F, const Sparse<Field, SparseMatrix_t::CSC> &A, index_t jbeg, index_t jend,
+                          typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_, index_t *cnt,
+                          const int64_t kmax) {
+    assume_aligned(dat, A.dat, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(row, A.row, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
+    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
+    const index_t km = static_cast<index_t>(std::max<int64_t>(1, std::min<int64_t>(kmax, std::numeric_limits<index_t>::max())));
+    for (index_t j = jbeg; j < jend; ++j) {
+        const typename Field::Element xj = x[j];
+        for (index_t k = st[j]; k < st[j + 1]; ++k) {
+            const index_t i = row[k];
+            y[i] += dat[k] * xj;
+            if (++cnt[i] == km) {
+                F.reduce(y[i]);
+                cnt[i] = 0;
+            }
+        }
+    }
+}
+
+template <class Field>
+inline void fspmv(const Field &F, const Sparse<Field, SparseMatrix_t::CSC> &A, typename Field::ConstElement_ptr x,
+                  typename Field::Element_ptr y, FieldCategories::GenericTag) {
+    fspmv_columns(F, A, 0, A.n, x, y, FieldCategories::GenericTag());
+}
+
+template <class Field>
+inline void fspmv(const Field &F, const Sparse<Field, SparseMatrix_t::CSC> &A, typename Field::ConstElement_ptr x,
+                  typename Field::Element_ptr y, FieldCategories::UnparametricTag) {
+    fspmv_columns(F, A, 0, A.n, x, y, FieldCategories::UnparametricTag());
+}
+
+template <class Field>
+inline void fspmv(const Field &F, const Sparse<Field, SparseMatrix_t::CSC> &A, typename Field::ConstElement_ptr x,
+                  typename Field::Element_ptr y, const int64_t kmax) {
+    std::vector<index_t> cnt(A.m, 0);
+    fspmv_columns(F, A, 0, A.n, x, y, cnt.data(), kmax);
+    freduce(F, A.m, y, 1);
+}
+
+template <class Field>
+inline void fspmv_one(const Field &F, const Sparse<Field, SparseMatrix_t::CSC_ZO> &A, typename Field::ConstElement_ptr x_,
+                      typename Field::Element_ptr y_, FieldCategories::GenericTag) {
+    assume_aligned(row, A.row, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
+    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
+    for (index_t j = 0; j < A.n; ++j)
+        for (index_t k = st[j]; k < st[j + 1]; ++k)
+            F.addin(y[row[k]], x[j]);
+}
+
+template <class Field>
+inline void fspmv_mone(const Field &F, const Sparse<Field, SparseMatrix_t::CSC_ZO> &A, typename Field::ConstElement_ptr x_,
+                       typename Field::Element_ptr y_, FieldCategories::GenericTag) {
+    assume_aligned(row, A.row, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
+    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
+    for (index_t j = 0; j < A.n; ++j)
+        for (index_t k = st[j]; k < st[j + 1]; ++k)
+            F.subin(y[row[k]], x[j]);
+}
+
+template <class Field>
+inline void fspmv_one(const Field &F, const Sparse<Field, SparseMatrix_t::CSC_ZO> &A, typename Field::ConstElement_ptr x_,
+                      typename Field::Element_ptr y_, FieldCategories::UnparametricTag) {
+    assume_aligned(row, A.row, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
+    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
+    for (index_t j = 0; j < A.n; ++j) {
+        const typename Field::Element xj = x[j];
+        for (index_t k = st[j]; k < st[j + 1]; ++k)
+            y[row[k]] += xj;
+    }
+}
+
+template <class Field>
+inline void fspmv_mone(const Field &F, const Sparse<Field, SparseMatrix_t::CSC_ZO> &A, typename Field::ConstElement_ptr x_,
+                       typename Field::Element_ptr y_, FieldCategories::UnparametricTag) {
+    assume_aligned(row, A.row, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
+    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
+    for (index_t j = 0; j < A.n; ++j) {
+        const typename Field::Element xj = x[j];
+        for (index_t k = st[j]; k < st[j + 1]; ++k)
+            y[row[k]] -= xj;
+    }
+}
+
+} // sparse_details_impl
+
+} // FFLAS
+
+#endif // __FFLASFFPACK_fflas_sparse_CSC_spmv_INL
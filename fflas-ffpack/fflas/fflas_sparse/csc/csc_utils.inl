@@ -0,0 +1,194 @@
+/* -*- mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+// vim:sts=4:sw=4:ts=4:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/*
+ * Copyright (C) 2016 the FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ * ========LICENCE========
+ *.
+ */
+
+#ifndef __FFLASFFPACK_fflas_sparse_CSC_utils_INL
+#define __FFLASFFPACK_fflas_sparse_CSC_utils_INL
+
+#include <algorithm>
+#include <vector>
+#include <limits>
+
+namespace FFLAS {
+
+template <class Field> inline void sparse_delete(const Sparse<Field, SparseMatrix_t::CSC> &A) {
+    fflas_delete(A.dat);
+    fflas_delete(A.row);
+    fflas_delete(A.st);
+}
+
+template <class Field> inline void sparse_delete(const Sparse<Field, SparseMatrix_t::CSC_ZO> &A) {
+    fflas_delete(A.row);
+    fflas_delete(A.st);
+}
+
+template <class Field> inline std::ostream& sparse_print(std::ostream& os, const Sparse<Field, SparseMatrix_t::CSC> &A) {
+    for (index_t j = 0; j < A.n; ++j) {
+        os << j << " : ";
+        for (index_t k = A.st[j]; k < A.st[j + 1]; ++k)
+            os << '(' << A.row[k] << ',' << A.dat[k] << ") ";
+        os << std::endl;
+    }
+    return os;
+}
+
+namespace sparse_details {
+
+/* Column pointers and row indices of A from a COO matrix in any order, the
+ * entries of a column keeping their input order. Returns the position in
+ * A.row of each input entry.
+ */
+template <class Field, class IndexT>
+inline std::vector<index_t> csc_init_pattern(Sparse<Field, SparseMatrix_t::CSC> &A, const IndexT *row,
+                                             const IndexT *col, uint64_t rowdim, uint64_t coldim, uint64_t nnz) {
+    A.m = rowdim;
+    A.n = coldim;
+    A.nnz = nnz;
+    A.nElements = nnz;
+    std::vector<uint64_t> rows(rowdim, 0);
+    A.st = fflas_new<index_t>(coldim + 1, Alignment::CACHE_LINE);
+    for (size_t j = 0; j <= coldim; ++j)
+        A.st[j] = 0;
+    for (uint64_t k = 0; k < nnz; ++k) {
+        rows[row[k]]++;
+        A.st[col[k] + 1]++;
+    }
+    A.maxrow = (rowdim > 0) ? *(std::max_element(rows.begin(), rows.end())) : 0;
+    A.maxcol = 0;
+    for (size_t j = 1; j <= coldim; ++j) {
+        A.maxcol = std::max<uint64_t>(A.maxcol, A.st[j]);
+        A.st[j] += A.st[j - 1];
+    }
+
+    A.row = fflas_new<index_t>(nnz, Alignment::CACHE_LINE);
+    std::vector<index_t> next(A.st, A.st + coldim);
+    std::vector<index_t> pos(nnz);
+    for (uint64_t k = 0; k < nnz; ++k) {
+        pos[k] = next[col[k]]++;
+        A.row[pos[k]] = static_cast<index_t>(row[k]);
+    }
+    return pos;
+}
+
+/* Transposed views: the arrays of a CSR matrix are those of the CSC storage
+ * of its transpose and conversely. The views share the arrays of A and must
+ * not be passed to sparse_delete. A reordered matrix P A P^T has the same
+ * reordering as its transpose P A^T P^T.
+ */
+template <class Field>
+inline Sparse<Field, SparseMatrix_t::CSC> transpose_view(const Sparse<Field, SparseMatrix_t::CSR> &A) {
+    Sparse<Field, SparseMatrix_t::CSC> T;
+    T.kmax = A.kmax;
+    T.m = A.n;
+    T.n = A.m;
+    T.nnz = A.nnz;
+    T.nElements = A.nElements;
+    T.maxcol = A.maxrow;
+    T.row = A.col;
+    T.st = A.st;
+    T.reorder = A.reorder;
+    T.reorderScratch = A.reorderScratch;
+    T.dat = A.dat;
+    // a row of T has at most A.m entries, otherwise the kmax kernels count them
+    T.delayed = (A.kmax > A.m);
+    return T;
+}
+
+template <class Field>
+inline Sparse<Field, SparseMatrix_t::CSC_ZO> transpose_view(const Sparse<Field, SparseMatrix_t::CSR_ZO> &A) {
+    Sparse<Field, SparseMatrix_t::CSC_ZO> T;
+    T.m = A.n;
+    T.n = A.m;
+    T.nnz = A.nnz;
+    T.nElements = A.nElements;
+    T.maxcol = A.maxrow;
+    T.row = A.col;
+    T.st = A.st;
+    T.reorder = A.reorder;
+    T.reorderScratch = A.reorderScratch;
+    T.delayed = true;
+    T.cst = A.cst;
+    return T;
+}
+
+template <class Field>
+inline Sparse<Field, SparseMatrix_t::CSR> transpose_view(const Sparse<Field, SparseMatrix_t::CSC> &A) {
+    Sparse<Field, SparseMatrix_t::CSR> T;
+    T.kmax = A.kmax;
+    T.m = A.n;
+    T.n = A.m;
+    T.nnz = A.nnz;
+    T.nElements = A.nElements;
+    T.maxrow = A.maxcol;
+    T.col = A.row;
+    T.st = A.st;
+    T.reorder = A.reorder;
+    T.reorderScratch = A.reorderScratch;
+    T.dat = A.dat;
+    T.delayed = (A.kmax > A.maxcol);
+    return T;
+}
+
+template <class Field>
+inline Sparse<Field, SparseMatrix_t::CSR_ZO> transpose_view(const Sparse<Field, SparseMatrix_t::CSC_ZO> &A) {
+    Sparse<Field, SparseMatrix_t::CSR_ZO> T;
+    T.m = A.n;
+    T.n = A.m;
+    T.nnz = A.nnz;
+    T.nElements = A.nElements;
+    T.maxrow = A.maxcol;
+    T.col = A.row;
+    T.st = A.st;
+    T.reorder = A.reorder;
+    T.reorderScratch = A.reorderScratch;
+    T.delayed = true;
+    T.cst = A.cst;
+    return T;
+}
+
+} // sparse_details
+
+template <class Field, class IndexT>
+inline void sparse_init(const Field &F, Sparse<Field, SparseMatrix_t::CSC> &A, const IndexT *row, const IndexT *col,
+                        typename Field::ConstElement_ptr dat, uint64_t rowdim, uint64_t coldim, uint64_t nnz) {
+    A.kmax = Protected::DotProdBoundClassic(F, F.one);
+    std::vector<index_t> pos = sparse_details::csc_init_pattern(A, row, col, rowdim, coldim, nnz);
+    // each y[i] of A x receives the entries of row i
+    if (A.kmax > A.maxrow)
+        A.delayed = true;
+    A.dat = fflas_new(F, nnz, 1, Alignment::CACHE_LINE);
+    for (uint64_t k = 0; k < nnz; ++k)
+        F.assign(A.dat[pos[k]], dat[k]);
+}
+
+template <class Field, class IndexT>
+inline void sparse_init(const Field &F, Sparse<Field, SparseMatrix_t::CSC_ZO> &A, const IndexT *row, const IndexT *col,
+                        typename Field::ConstElement_ptr dat, uint64_t rowdim, uint64_t coldim, uint64_t nnz) {
+    A.delayed = true;
+    sparse_details::csc_init_pattern(A, row, col, rowdim, coldim, nnz);
+}
+
+} // FFLAS
+
+#endif // __FFLASFFPACK_fflas_sparse_CSC_utils_INL
@@ -48,6 +48,10 @@ template <class _Field> struct Sparse<_Field, SparseMatrix_t::CSR> {
     index_t *st = nullptr;
     index_t *stend = nullptr;
     typename _Field::Element_ptr dat;
+    // row and column of A stored at position k, nullptr if A is not reordered (see SparseReordering)
+    index_t *reorder = nullptr;
+    // permuted copies of x and y for the products, nullptr if A is not reordered
+    sparse_details::ReorderScratch<_Field> *reorderScratch = nullptr;
 };
 
 template <class _Field>
@@ -71,6 +75,22 @@ inline void sparse_init(const Field &F,
                         typename Field::ConstElement_ptr dat, uint64_t rowdim,
                         uint64_t coldim, uint64_t nnz);
 
+/* Same, A being stored as P A P^T for the given reordering of a square
+ * matrix; col and st then describe P A P^T.
+ */
+template <class Field, class IndexT>
+inline void sparse_init(const Field &F, Sparse<Field, SparseMatrix_t::CSR> &A,
+                        const IndexT *row, const IndexT *col,
+                        typename Field::ConstElement_ptr dat, uint64_t rowdim,
+                        uint64_t coldim, uint64_t nnz, SparseReordering reorder);
+
+template <class Field, class IndexT>
+inline void sparse_init(const Field &F,
+                        Sparse<Field, SparseMatrix_t::CSR_ZO> &A,
+                        const IndexT *row, const IndexT *col,
+                        typename Field::ConstElement_ptr dat, uint64_t rowdim,
+                        uint64_t coldim, uint64_t nnz, SparseReordering reorder);
+
 template <class Field>
 inline void sparse_delete(const Sparse<Field, SparseMatrix_t::CSR> &A);
 
@@ -82,6 +102,7 @@ inline void sparse_delete(const Sparse<Field, SparseMatrix_t::CSR_ZO> &A);
 #include "fflas-ffpack/fflas/fflas_sparse/csr/csr_utils.inl"
 #include "fflas-ffpack/fflas/fflas_sparse/csr/csr_spmv.inl"
 #include "fflas-ffpack/fflas/fflas_sparse/csr/csr_spmm.inl"
+#include "fflas-ffpack/fflas/fflas_sparse/csr/csr_spgemm.inl"
 
 #if defined(__FFLASFFPACK_USE_OPENMP) || defined(__FFLASFFPACK_USE_TBB)
 
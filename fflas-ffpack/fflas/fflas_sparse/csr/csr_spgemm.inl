@@ -0,0 +1,289 @@
+/* -*- mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+// vim:sts=4:sw=4:ts=4:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/*
+ * Copyright (C) 2016 the FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ * ========LICENCE========
+ *.
+ */
+
+#ifndef __FFLASFFPACK_fflas_sparse_CSR_spgemm_INL
+#define __FFLASFFPACK_fflas_sparse_CSR_spgemm_INL
+
+#include <cstddef>
+#include <limits>
+
+namespace FFLAS {
+namespace sparse_details_impl {
+
+/* C = A B for A and B in CSR or CSR_ZO, row by row (Gustavson):
+ *  - the symbolic phase counts the columns of each row of C with a marker
+ *    array, which gives the row pointers of C;
+ *  - the numeric phase accumulates the row in a dense accumulator of size
+ *    B.n, whose touched columns are listed in place in C.col, then sorted.
+ * The entries of a ZO matrix all are its cst: they are not multiplied, the
+ * product of the csts scales each entry of C once. Over a modular field the
+ * products are accumulated without reduction and the touched columns are
+ * reduced every kmax entries of the row of A. The entries of C which vanish
+ * are removed at the end. Each thread owns a contiguous range of rows, of
+ * about the same number of products.
+ */
+
+// value of the entries of a ZO matrix, applied at the end
+struct SpgemmUnit {};
+
+template <class Field>
+inline const typename Field::Element &spgemm_value(const Sparse<Field, SparseMatrix_t::CSR> &A, index_t k) {
+    return A.dat[k];
+}
+
+template <class Field> inline SpgemmUnit spgemm_value(const Sparse<Field, SparseMatrix_t::CSR_ZO> &, index_t) {
+    return SpgemmUnit();
+}
+
+template <class Field>
+inline typename Field::ConstElement_ptr spgemm_values(const Sparse<Field, SparseMatrix_t::CSR> &B) {
+    return B.dat;
+}
+
+template <class Field> inline std::nullptr_t spgemm_values(const Sparse<Field, SparseMatrix_t::CSR_ZO> &) {
+    return nullptr;
+}
+
+template <class Field>
+inline void spgemm_cst(const Field &F, const Sparse<Field, SparseMatrix_t::CSR> &, typename Field::Element &c) {
+    F.assign(c, F.one);
+}
+
+template <class Field>
+inline void spgemm_cst(const Field &F, const Sparse<Field, SparseMatrix_t::CSR_ZO> &A, typename Field::Element &c) {
+    F.init(c, A.cst);
+}
+
+// acc += a b[l]
+template <class Field>
+inline void spgemm_addprod(const Field &F, typename Field::Element &acc, const typename Field::Element &a,
+                           typename Field::ConstElement_ptr b, index_t l, FieldCategories::GenericTag) {
+    F.axpyin(acc, a, b[l]);
+}
+
+template <class Field>
+inline void spgemm_addprod(const Field &F, typename Field::Element &acc, SpgemmUnit,
+                           typename Field::ConstElement_ptr b, index_t l, FieldCategories::GenericTag) {
+    F.addin(acc, b[l]);
+}
+
+template <class Field>
+inline void spgemm_addprod(const Field &F, typename Field::Element &acc, const typename Field::Element &a,
+                           std::nullptr_t, index_t, FieldCategories::GenericTag) {
+    F.addin(acc, a);
+}
+
+template <class Field>
+inline void spgemm_addprod(const Field &F, typename Field::Element &acc, SpgemmUnit, std::nullptr_t, index_t,
+                           FieldCategories::GenericTag) {
+    F.addin(acc, F.one);
+}
+
+template <class Field>
+inline void spgemm_addprod(const Field &, typename Field::Element &acc, const typename Field::Element &a,
+                           typename Field::ConstElement_ptr b, index_t l, FieldCategories::UnparametricTag) {
+    acc += a * b[l];
+}
+
+template <class Field>
+inline void spgemm_addprod(const Field &, typename Field::Element &acc, SpgemmUnit,
+                           typename Field::ConstElement_ptr b, index_t l, FieldCategories::UnparametricTag) {
+    acc += b[l];
+}
+
+template <class Field>
+inline void spgemm_addprod(const Field &, typename Field::Element &acc, const typename Field::Element &a,
+                           std::nullptr_t, index_t, FieldCategories::UnparametricTag) {
+    acc += a;
+}
+
+template <class Field>
+inline void spgemm_addprod(const Field &F, typename Field::Element &acc, SpgemmUnit, std::nullptr_t, index_t,
+                           FieldCategories::UnparametricTag) {
+    acc += F.one;
+}
+
+// number of columns of the rows ibeg..iend-1 of A B, in cnt
+template <class SMA, class SMB>
+inline void fspgemm_symbolic(const SMA &A, const SMB &B, index_t ibeg, index_t iend, index_t *mark, index_t *cnt) {
+    for (index_t i = ibeg; i < iend; ++i) {
+        index_t c = 0;
+        for (index_t k = A.st[i]; k < A.st[i + 1]; ++k) {
+            const index_t j = A.col[k];
+            for (index_t l = B.st[j]; l < B.st[j + 1]; ++l)
+                if (mark[B.col[l]] != i) {
+                    mark[B.col[l]] = i;
+                    ++c;
+                }
+        }
+        cnt[i] = c;
+    }
+}
+
+/* Rows ibeg..iend-1 of C = s A B, s the product of the csts, in the slots
+ * given by st; the number of non zero entries of row i is written in len[i].
+ * kmax > 0: unparametric accumulation reduced every kmax entries of A.
+ */
+template <class Field, class SMA, class SMB, class FieldCat>
+inline void fspgemm_numeric(const Field &F, const SMA &A, const SMB &B, index_t ibeg, index_t iend, index_t *mark,
+                            typename Field::Element_ptr acc, const typename Field::Element &s, const index_t *st,
+                            index_t *col, typename Field::Element_ptr dat, index_t *len, uint64_t kmax, FieldCat tag) {
+    const auto bv = spgemm_values(B);
+    const bool scale = !F.isOne(s);
+    for (index_t i = ibeg; i < iend; ++i) {
+        index_t *ci = col + st[i];
+        index_t c = 0;
+        uint64_t cnt = 0;
+        for (index_t k = A.st[i]; k < A.st[i + 1]; ++k) {
+            const auto a = spgemm_value(A, k);
+            const index_t j = A.col[k];
+            for (index_t l = B.st[j]; l < B.st[j + 1]; ++l) {
+                const index_t cj = B.col[l];
+                if (mark[cj] != i) {
+                    mark[cj] = i;
+                    ci[c++] = cj;
+                    F.assign(acc[cj], F.zero);
+                }
+                spgemm_addprod(F, acc[cj], a, bv, l, tag);
+            }
+            if (kmax > 0 && ++cnt == kmax) {
+                for (index_t t = 0; t < c; ++t)
+                    F.reduce(acc[ci[t]]);
+                cnt = 0;
+            }
+        }
+        std::sort(ci, ci + c);
+        typename Field::Element_ptr di = dat + st[i];
+        index_t nz = 0;
+        for (index_t t = 0; t < c; ++t) {
+            typename Field::Element &v = acc[ci[t]];
+            if (kmax > 0)
+                F.reduce(v);
+            if (scale)
+                F.mulin(v, s);
+            if (!F.isZero(v)) {
+                ci[nz] = ci[t];
+                F.assign(di[nz], v);
+                ++nz;
+            }
+        }
+        len[i] = nz;
+    }
+}
+
+/* first row of thread t among p, the rows being balanced by their number
+ * of products, flops[i] = products of the rows 0..i-1
+ */
+inline index_t spgemm_thread_rows(const std::vector<uint64_t> &flops, size_t t, size_t p) {
+    if (t == 0)
+        return 0;
+    if (t == p)
+        return (index_t)(flops.size() - 1);
+    return (index_t)(std::lower_bound(flops.begin(), flops.end(), flops.back() * t / p) - flops.begin());
+}
+
+template <class Field, class SMA, class SMB, class FieldCat>
+inline void fspgemm(const Field &F, const SMA &A, const SMB &B, Sparse<Field, SparseMatrix_t::CSR> &C, size_t nthreads,
+                    uint64_t kmax, FieldCat tag) {
+    const index_t m = A.m, n = B.n;
+    typename Field::Element s, sb;
+    spgemm_cst(F, A, s);
+    spgemm_cst(F, B, sb);
+    F.mulin(s, sb);
+
+    std::vector<uint64_t> flops(m + 1, 0);
+    for (index_t i = 0; i < m; ++i) {
+        uint64_t f = 0;
+        for (index_t k = A.st[i]; k < A.st[i + 1]; ++k)
+            f += B.st[A.col[k] + 1] - B.st[A.col[k]];
+        flops[i + 1] = flops[i] + f;
+    }
+    const size_t nt = std::max<size_t>(1, std::min<size_t>(nthreads, m));
+    // one block of rows per thread, balanced by flops
+    const ParSeqHelper::Parallel<CuttingStrategy::Block, StrategyParameter::Threads> par(nt);
+
+    index_t *st = fflas_new<index_t>(m + 1, Alignment::CACHE_LINE);
+    index_t *len = fflas_new<index_t>(m + 1, Alignment::CACHE_LINE);
+    st[0] = 0;
+    Protected::pforblock1d_static(nt, par, [&](size_t tb, size_t te) {
+        std::vector<index_t> mark(n, std::numeric_limits<index_t>::max());
+        for (size_t t = tb; t < te; ++t)
+            fspgemm_symbolic(A, B, spgemm_thread_rows(flops, t, nt), spgemm_thread_rows(flops, t + 1, nt),
+                             mark.data(), st + 1);
+    });
+    for (index_t i = 0; i < m; ++i)
+        st[i + 1] += st[i];
+
+    index_t *col = fflas_new<index_t>(st[m], Alignment::CACHE_LINE);
+    typename Field::Element_ptr dat = fflas_new(F, st[m], 1, Alignment::CACHE_LINE);
+    Protected::pforblock1d_static(nt, par, [&](size_t tb, size_t te) {
+        std::vector<index_t> mark(n, std::numeric_limits<index_t>::max());
+        typename Field::Element_ptr acc = fflas_new(F, n, 1, Alignment::CACHE_LINE);
+        for (size_t t = tb; t < te; ++t)
+            fspgemm_numeric(F, A, B, spgemm_thread_rows(flops, t, nt), spgemm_thread_rows(flops, t + 1, nt),
+                            mark.data(), acc, s, st, col, dat, len, kmax, tag);
+        fflas_delete(acc);
+    });
+
+    // removes the vanished entries
+    C.m = m;
+    C.n = n;
+    C.st = fflas_new<index_t>(m + 1, Alignment::CACHE_LINE);
+    C.st[0] = 0;
+    C.maxrow = 0;
+    for (index_t i = 0; i < m; ++i) {
+        C.st[i + 1] = C.st[i] + len[i];
+        C.maxrow = std::max<uint64_t>(C.maxrow, len[i]);
+    }
+    C.nnz = C.st[m];
+    C.nElements = C.nnz;
+    if (C.nnz == st[m]) {
+        C.col = col;
+        C.dat = dat;
+    } else {
+        C.col = fflas_new<index_t>(C.nnz, Alignment::CACHE_LINE);
+        C.dat = fflas_new(F, C.nnz, 1, Alignment::CACHE_LINE);
+        Protected::pforblock1d_static(m, par, [&](size_t ib, size_t ie) {
+            for (size_t i = ib; i < ie; ++i)
+                for (index_t k = 0; k < len[i]; ++k) {
+                    C.col[C.st[i] + k] = col[st[i] + k];
+                    F.assign(C.dat[C.st[i] + k], dat[st[i] + k]);
+                }
+        });
+        fflas_delete(col);
+        fflas_delete(dat);
+    }
+    fflas_delete(st);
+    fflas_delete(len);
+    C.kmax = Protected::DotProdBoundClassic(F, F.one);
+    C.delayed = C.kmax > C.maxrow;
+    C.stend = nullptr;
+}
+
+} // sparse_details_impl
+
+} // FFLAS
+
+#endif // __FFLASFFPACK_fflas_sparse_CSR_spgemm_INL
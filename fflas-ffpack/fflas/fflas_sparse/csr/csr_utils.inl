@@ -32,11 +32,15 @@ template <class Field> inline void sparse_delete(const Sparse<Field, SparseMatri
     fflas_delete(A.dat);
     fflas_delete(A.col);
     fflas_delete(A.st);
+    fflas_delete(A.reorder);
+    sparse_details::reorder_scratch_delete(A.reorderScratch);
 }
 
 template <class Field> inline void sparse_delete(const Sparse<Field, SparseMatrix_t::CSR_ZO> &A) {
     fflas_delete(A.col);
     fflas_delete(A.st);
+    fflas_delete(A.reorder);
+    sparse_details::reorder_scratch_delete(A.reorderScratch);
 }
 
 template <class Field> inline std::ostream& sparse_print(std::ostream& os, const Sparse<Field, SparseMatrix_t::CSR> &A) {
@@ -248,4 +252,33 @@ inline void sparse_init(const Field &F, Sparse<Field, SparseMatrix_t::CSR_ZO> &A
         A.st[i] += A.st[i - 1];
     }
 }
+template <class Field, class IndexT>
+inline void sparse_init(const Field &F, Sparse<Field, SparseMatrix_t::CSR> &A, const IndexT *row, const IndexT *col,
+                        typename Field::ConstElement_ptr dat, uint64_t rowdim, uint64_t coldim, uint64_t nnz,
+                        SparseReordering reorder) {
+    if (reorder == SparseReordering::NONE || rowdim != coldim) {
+        sparse_init(F, A, row, col, dat, rowdim, coldim, nnz);
+        return;
+    }
+    sparse_details::sparse_init_reordered<Field>(
+        A, row, col, dat, rowdim, nnz,
+        [&](const index_t *r, const index_t *c, typename Field::ConstElement_ptr d) {
+            sparse_init(F, A, r, c, d, rowdim, coldim, nnz);
+        });
+}
+
+template <class Field, class IndexT>
+inline void sparse_init(const Field &F, Sparse<Field, SparseMatrix_t::CSR_ZO> &A, const IndexT *row, const IndexT *col,
+                        typename Field::ConstElement_ptr dat, uint64_t rowdim, uint64_t coldim, uint64_t nnz,
+                        SparseReordering reorder) {
+    if (reorder == SparseReordering::NONE || rowdim != coldim) {
+        sparse_init(F, A, row, col, dat, rowdim, coldim, nnz);
+        return;
+    }
+    sparse_details::sparse_init_reordered<Field>(
+        A, row, col, dat, rowdim, nnz,
+        [&](const index_t *r, const index_t *c, typename Field::ConstElement_ptr d) {
+            sparse_init(F, A, r, c, d, rowdim, coldim, nnz);
+        });
+}
 }
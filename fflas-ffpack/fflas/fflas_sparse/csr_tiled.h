@@ -0,0 +1,92 @@
+/* -*- mode: C++; tab-width: 8; indent-tabs-mode: t; c-basic-offset: 8 -*- */
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/*
+ * Copyright (C) 2014 the FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ * ========LICENCE========
+ *.
+ */
+
+/** @file fflas/fflas_sparse/csr_tiled.h
+ * Column tiled CSR: the rows are grouped in blocks of tileRows rows and the
+ * columns in panels of tileCols columns. The part of a row in a panel is a
+ * segment, stored as a CSR row, and the segments of a row block are sorted
+ * by panel then by row. The products go through a row block panel by panel:
+ * the entries of x read by a panel stay in cache, whatever the number of
+ * columns of the matrix, and so do the entries of y of the row block.
+ */
+
+#ifndef __FFLASFFPACK_fflas_sparse_CSR_TILED_H
+#define __FFLASFFPACK_fflas_sparse_CSR_TILED_H
+
+#ifndef __FFLASFFPACK_CSR_TILED_L1
+//! L1 cache size, in bytes, when it cannot be queried
+#define __FFLASFFPACK_CSR_TILED_L1 32768
+#endif
+
+#ifndef __FFLASFFPACK_CSR_TILED_L2
+//! L2 cache size, in bytes, when it cannot be queried
+#define __FFLASFFPACK_CSR_TILED_L2 262144
+#endif
+
+namespace FFLAS { /*  CSR_TILED */
+
+template <class _Field> struct Sparse<_Field, SparseMatrix_t::CSR_TILED> {
+    using Field = _Field;
+    bool delayed = false;
+    uint64_t kmax = 0;
+    index_t m = 0;
+    index_t n = 0;
+    uint64_t nnz = 0;
+    uint64_t nElements = 0;
+    uint64_t maxrow = 0;
+    index_t tileRows = 0;       // rows of a row block
+    index_t tileCols = 0;       // columns of a panel
+    index_t nRowBlocks = 0;
+    index_t nPanels = 0;
+    uint64_t nSegments = 0;
+    uint64_t *blockSt = nullptr; // the segments of row block b are blockSt[b]..blockSt[b+1]-1
+    index_t *row = nullptr;      // row of segment s
+    uint64_t *st = nullptr;      // segment s is at st[s]..st[s+1]-1 in col and dat
+    index_t *col = nullptr;
+    typename _Field::Element_ptr dat = nullptr;
+};
+
+/* tileCols = 0 takes the panels whose entries of x fill half of the L2
+ * cache, tileRows = 0 the row blocks whose entries of y fill half of the L1
+ * cache.
+ */
+template <class Field, class IndexT>
+inline void sparse_init(const Field &F, Sparse<Field, SparseMatrix_t::CSR_TILED> &A, const IndexT *row,
+                        const IndexT *col, typename Field::ConstElement_ptr dat, uint64_t rowdim, uint64_t coldim,
+                        uint64_t nnz, uint64_t tileCols = 0, uint64_t tileRows = 0);
+
+template <class Field> inline void sparse_delete(const Sparse<Field, SparseMatrix_t::CSR_TILED> &A);
+
+} // FFLAS
+
+#include "fflas-ffpack/fflas/fflas_sparse/csr_tiled/csr_tiled_utils.inl"
+#include "fflas-ffpack/fflas/fflas_sparse/csr_tiled/csr_tiled_spmv.inl"
+#include "fflas-ffpack/fflas/fflas_sparse/csr_tiled/csr_tiled_spmm.inl"
+#if defined(__FFLASFFPACK_USE_OPENMP)
+#include "fflas-ffpack/fflas/fflas_sparse/csr_tiled/csr_tiled_pspmv.inl"
+#include "fflas-ffpack/fflas/fflas_sparse/csr_tiled/csr_tiled_pspmm.inl"
+#endif
+
+#endif // __FFLASFFPACK_fflas_sparse_CSR_TILED_H
@@ -0,0 +1,91 @@
+/* -*- mode: C++; tab-width: 8; indent-tabs-mode: t; c-basic-offset: 8 -*- */
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/*
+ * Copyright (C) 2014 the FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ * ========LICENCE========
+ *.
+ */
+
+#ifndef __FFLASFFPACK_fflas_sparse_CSR_TILED_pspmm_INL
+#define __FFLASFFPACK_fflas_sparse_CSR_TILED_pspmm_INL
+
+namespace FFLAS {
+namespace sparse_details_impl {
+
+template <class Field>
+inline void pfspmm(const Field &F, const Sparse<Field, SparseMatrix_t::CSR_TILED> &A, size_t blockSize,
+                   typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                   FieldCategories::GenericTag) {
+    csr_tiled_parallel_blocks(A, [&](index_t bbeg, index_t bend) {
+        fspmm_blocks(F, A, bbeg, bend, blockSize, x, ldx, y, ldy, FieldCategories::GenericTag());
+    });
+}
+
+template <class Field>
+inline void pfspmm(const Field &F, const Sparse<Field, SparseMatrix_t::CSR_TILED> &A, size_t blockSize,
+                   typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                   FieldCategories::UnparametricTag) {
+    csr_tiled_parallel_blocks(A, [&](index_t bbeg, index_t bend) {
+        fspmm_blocks(F, A, bbeg, bend, blockSize, x, ldx, y, ldy, FieldCategories::UnparametricTag());
+    });
+}
+
+template <class Field>
+inline void pfspmm(const Field &F, const Sparse<Field, SparseMatrix_t::CSR_TILED> &A, size_t blockSize,
+                   typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                   const uint64_t kmax) {
+    csr_tiled_parallel_blocks(A, [&](index_t bbeg, index_t bend) {
+        fspmm_blocks(F, A, bbeg, bend, blockSize, x, ldx, y, ldy, kmax);
+    });
+}
+
+template <class Field>
+inline void pfspmm_simd_aligned(const Field &F, const Sparse<Field, SparseMatrix_t::CSR_TILED> &A,
+                                size_t blockSize, typename Field::ConstElement_ptr x, int ldx,
+                                typename Field::Element_ptr y, int ldy, FieldCategories::UnparametricTag) {
+    pfspmm(F, A, blockSize, x, ldx, y, ldy, FieldCategories::UnparametricTag());
+}
+
+template <class Field>
+inline void pfspmm_simd_unaligned(const Field &F, const Sparse<Field, SparseMatrix_t::CSR_TILED> &A,
+                                  size_t blockSize, typename Field::ConstElement_ptr x, int ldx,
+                                  typename Field::Element_ptr y, int ldy, FieldCategories::UnparametricTag) {
+    pfspmm(F, A, blockSize, x, ldx, y, ldy, FieldCategories::UnparametricTag());
+}
+
+template <class Field>
+inline void pfspmm_simd_aligned(const Field &F, const Sparse<Field, SparseMatrix_t::CSR_TILED> &A,
+                                size_t blockSize, typename Field::ConstElement_ptr x, int ldx,
+                                typename Field::Element_ptr y, int ldy, const uint64_t kmax) {
+    pfspmm(F, A, blockSize, x, ldx, y, ldy, kmax);
+}
+
+template <class Field>
+inline void pfspmm_simd_unaligned(const Field &F, const Sparse<Field, SparseMatrix_t::CSR_TILED> &A,
+                                  size_t blockSize, typename Field::ConstElement_ptr x, int ldx,
+                                  typename Field::Element_ptr y, int ldy, const uint64_t kmax) {
+    pfspmm(F, A, blockSize, x, ldx, y, ldy, kmax);
+}
+
+} // sparse_details_impl
+
+} // FFLAS
+
+#endif // __FFLASFFPACK_fflas_sparse_CSR_TILED_pspmm_INL
@@ -0,0 +1,98 @@
+/* -*- mode: C++; tab-width: 8; indent-tabs-mode: t; c-basic-offset: 8 -*- */
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/*
+ * Copyright (C) 2014 the FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ * ========LICENCE========
+ *.
+ */
+
+#ifndef __FFLASFFPACK_fflas_sparse_CSR_TILED_pspmv_INL
+#define __FFLASFFPACK_fflas_sparse_CSR_TILED_pspmv_INL
+
+namespace FFLAS {
+namespace sparse_details_impl {
+
+/* The parallel products give each thread a contiguous range of row blocks
+ * holding about nnz/p entries. A thread goes through the panels of its own
+ * row blocks: it writes its own rows of y and keeps its panel of x in its
+ * own cache, there is neither synchronization nor false sharing but at the
+ * boundaries of the ranges.
+ */
+template <class Field>
+inline index_t csr_tiled_block_split(const Sparse<Field, SparseMatrix_t::CSR_TILED> &A, uint64_t t, uint64_t p) {
+    if (t == 0)
+        return 0;
+    if (t == p)
+        return A.nRowBlocks;
+    const uint64_t target = A.nElements * t / p;
+    index_t lo = 0, hi = A.nRowBlocks;
+    while (lo < hi) {
+        const index_t mid = lo + (hi - lo) / 2;
+        if (A.st[A.blockSt[mid]] < target)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+template <class Field, class Func>
+inline void csr_tiled_parallel_blocks(const Sparse<Field, SparseMatrix_t::CSR_TILED> &A, Func f) {
+    const size_t nt = std::min<size_t>(MAX_THREADS, A.nRowBlocks);
+    if (nt <= 1) {
+        f((index_t)0, (index_t)A.nRowBlocks);
+        return;
+    }
+#pragma omp parallel num_threads(nt)
+    {
+        const uint64_t p = omp_get_num_threads();
+        const uint64_t t = omp_get_thread_num();
+        f(csr_tiled_block_split(A, t, p), csr_tiled_block_split(A, t + 1, p));
+    }
+}
+
+template <class Field>
+inline void pfspmv(const Field &F, const Sparse<Field, SparseMatrix_t::CSR_TILED> &A,
+                   typename Field::ConstElement_ptr x, typename Field::Element_ptr y, FieldCategories::GenericTag) {
+    csr_tiled_parallel_blocks(A, [&](index_t bbeg, index_t bend) {
+        fspmv_blocks(F, A, bbeg, bend, x, y, FieldCategories::GenericTag());
+    });
+}
+
+template <class Field>
+inline void pfspmv(const Field &F, const Sparse<Field, SparseMatrix_t::CSR_TILED> &A,
+                   typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
+                   FieldCategories::UnparametricTag) {
+    csr_tiled_parallel_blocks(A, [&](index_t bbeg, index_t bend) {
+        fspmv_blocks(F, A, bbeg, bend, x, y, FieldCategories::UnparametricTag());
+    });
+}
+
+template <class Field>
+inline void pfspmv(const Field &F, const Sparse<Field, SparseMatrix_t::CSR_TILED> &A,
+                   typename Field::ConstElement_ptr x, typename Field::Element_ptr y, const uint64_t kmax) {
+    csr_tiled_parallel_blocks(A, [&](index_t bbeg, index_t bend) { fspmv_blocks(F, A, bbeg, bend, x, y, kmax); });
+}
+
+} // sparse_details_impl
+
+} // FFLAS
+
+#endif // __FFLASFFPACK_fflas_sparse_CSR_TILED_pspmv_INL
@@ -0,0 +1,168 @@
+/* -*- mode: C++; tab-width: 8; indent-tabs-mode: t; c-basic-offset: 8 -*- */
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/*
+ * Copyright (C) 2014 the FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ * ========LICENCE========
+ *.
+ */
+
+#ifndef __FFLASFFPACK_fflas_sparse_CSR_TILED_spmm_INL
+#define __FFLASFFPACK_fflas_sparse_CSR_TILED_spmm_INL
+
+namespace FFLAS {
+namespace sparse_details_impl {
+
+/* Y += A X on the row blocks bbeg..bend-1. The tiles are sized for the
+ * vectors of fspmv: a panel of X takes blockSize times more cache, a
+ * matrix built for fspmm can be given tileCols / blockSize to sparse_init.
+ */
+template <class Field>
+inline void fspmm_blocks(const Field &F, const Sparse<Field, SparseMatrix_t::CSR_TILED> &A, index_t bbeg,
+                         index_t bend, size_t blockSize, typename Field::ConstElement_ptr x_, int ldx,
+                         typename Field::Element_ptr y_, int ldy, FieldCategories::GenericTag) {
+    assume_aligned(dat, A.dat, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
+    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
+    for (uint64_t s = A.blockSt[bbeg]; s < A.blockSt[bend]; ++s) {
+        typename Field::Element_ptr yi = y + A.row[s] * ldy;
+        for (uint64_t k = st[s]; k < st[s + 1]; ++k)
+            for (size_t b = 0; b < blockSize; ++b)
+                F.axpyin(yi[b], dat[k], x[col[k] * ldx + b]);
+    }
+}
+
+template <class Field>
+inline void fspmm_blocks(const Field &F, const Sparse<Field, SparseMatrix_t::CSR_TILED> &A, index_t bbeg,
+                         index_t bend, size_t blockSize, typename Field::ConstElement_ptr x_, int ldx,
+                         typename Field::Element_ptr y_, int ldy, FieldCategories::UnparametricTag) {
+    assume_aligned(dat, A.dat, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
+    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
+    for (uint64_t s = A.blockSt[bbeg]; s < A.blockSt[bend]; ++s) {
+        typename Field::Element_ptr yi = y + A.row[s] * ldy;
+        for (uint64_t k = st[s]; k < st[s + 1]; ++k) {
+            const typename Field::Element d = dat[k];
+            typename Field::ConstElement_ptr xj = x + col[k] * ldx;
+            for (size_t b = 0; b < blockSize; ++b)
+                yi[b] += d * xj[b];
+        }
+    }
+}
+
+// the rows of Y are reduced as in fspmv_blocks
+template <class Field>
+inline void fspmm_blocks(const Field &F, const Sparse<Field, SparseMatrix_t::CSR_TILED> &A, index_t bbeg,
+                         index_t bend, size_t blockSize, typename Field::ConstElement_ptr x_, int ldx,
+                         typename Field::Element_ptr y_, int ldy, const uint64_t kmax) {
+    assume_aligned(dat, A.dat, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
+    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
+    const uint64_t km = std::max<uint64_t>(1, std::min<uint64_t>(kmax, A.maxrow));
+    std::vector<uint64_t> cnt(A.tileRows);
+    for (index_t b = bbeg; b < bend; ++b) {
+        const index_t r0 = b * A.tileRows, r1 = std::min<index_t>(A.m, r0 + A.tileRows);
+        std::fill(cnt.begin(), cnt.end(), 0);
+        for (uint64_t s = A.blockSt[b]; s < A.blockSt[b + 1]; ++s) {
+            typename Field::Element_ptr yi = y + A.row[s] * ldy;
+            uint64_t &c = cnt[A.row[s] - r0];
+            for (uint64_t k = st[s]; k < st[s + 1];) {
+                const uint64_t kend = std::min<uint64_t>(st[s + 1], k + km - c);
+                c += kend - k;
+                for (; k < kend; ++k) {
+                    const typename Field::Element d = dat[k];
+                    typename Field::ConstElement_ptr xj = x + col[k] * ldx;
+                    for (size_t l = 0; l < blockSize; ++l)
+                        yi[l] += d * xj[l];
+                }
+                if (c == km) {
+                    freduce(F, blockSize, yi, 1);
+                    c = 0;
+                }
+            }
+        }
+        for (index_t i = r0; i < r1; ++i)
+            if (cnt[i - r0] != 0)
+                freduce(F, blockSize, y + i * ldy, 1);
+    }
+}
+
+template <class Field>
+inline void fspmm(const Field &F, const Sparse<Field, SparseMatrix_t::CSR_TILED> &A, size_t blockSize,
+                  typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                  FieldCategories::GenericTag) {
+    fspmm_blocks(F, A, 0, A.nRowBlocks, blockSize, x, ldx, y, ldy, FieldCategories::GenericTag());
+}
+
+template <class Field>
+inline void fspmm(const Field &F, const Sparse<Field, SparseMatrix_t::CSR_TILED> &A, size_t blockSize,
+                  typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                  FieldCategories::UnparametricTag) {
+    fspmm_blocks(F, A, 0, A.nRowBlocks, blockSize, x, ldx, y, ldy, FieldCategories::UnparametricTag());
+}
+
+template <class Field>
+inline void fspmm(const Field &F, const Sparse<Field, SparseMatrix_t::CSR_TILED> &A, size_t blockSize,
+                  typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                  const uint64_t kmax) {
+    fspmm_blocks(F, A, 0, A.nRowBlocks, blockSize, x, ldx, y, ldy, kmax);
+}
+
+/* The loop over the block is contiguous in X and Y and left to the compiler
+ * vectorizer: the simd entry points of the dispatch forward to it.
+ */
+template <class Field>
+inline void fspmm_simd_aligned(const Field &F, const Sparse<Field, SparseMatrix_t::CSR_TILED> &A, size_t blockSize,
+                               typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                               FieldCategories::UnparametricTag) {
+    fspmm(F, A, blockSize, x, ldx, y, ldy, FieldCategories::UnparametricTag());
+}
+
+template <class Field>
+inline void fspmm_simd_unaligned(const Field &F, const Sparse<Field, SparseMatrix_t::CSR_TILED> &A,
+                                 size_t blockSize, typename Field::ConstElement_ptr x, int ldx,
+                                 typename Field::Element_ptr y, int ldy, FieldCategories::UnparametricTag) {
+    fspmm(F, A, blockSize, x, ldx, y, ldy, FieldCategories::UnparametricTag());
+}
+
+template <class Field>
+inline void fspmm_simd_aligned(const Field &F, const Sparse<Field, SparseMatrix_t::CSR_TILED> &A, size_t blockSize,
+                               typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                               const uint64_t kmax) {
+    fspmm(F, A, blockSize, x, ldx, y, ldy, kmax);
+}
+
+template <class Field>
+inline void fspmm_simd_unaligned(const Field &F, const Sparse<Field, SparseMatrix_t::CSR_TILED> &A,
+                                 size_t blockSize, typename Field::ConstElement_ptr x, int ldx,
+                                 typename Field::Element_ptr y, int ldy, const uint64_t kmax) {
+    fspmm(F, A, blockSize, x, ldx, y, ldy, kmax);
+}
+
+} // sparse_details_impl
+
+} // FFLAS
+
+#endif // __FFLASFFPACK_fflas_sparse_CSR_TILED_spmm_INL
@@ -0,0 +1,131 @@
+/* -*- mode: C++; tab-width: 8; indent-tabs-mode: t; c-basic-offset: 8 -*- */
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/*
+ * Copyright (C) 2014 the FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ * ========LICENCE========
+ *.
+ */
+
+#ifndef __FFLASFFPACK_fflas_sparse_CSR_TILED_spmv_INL
+#define __FFLASFFPACK_fflas_sparse_CSR_TILED_spmv_INL
+
+namespace FFLAS {
+namespace sparse_details_impl {
+
+/* The kernels compute the row blocks bbeg..bend-1 of y += A x, the
+ * sequential products taking all the row blocks and the parallel ones a
+ * range per thread. The segments of a row block come panel by panel, so
+ * that the reads of x stay in one panel of tileCols columns at a time.
+ */
+template <class Field>
+inline void fspmv_blocks(const Field &F, const Sparse<Field, SparseMatrix_t::CSR_TILED> &A, index_t bbeg,
+                         index_t bend, typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
+                         FieldCategories::GenericTag) {
+    assume_aligned(dat, A.dat, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
+    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
+    for (uint64_t s = A.blockSt[bbeg]; s < A.blockSt[bend]; ++s) {
+        typename Field::Element &yi = y[A.row[s]];
+        for (uint64_t k = st[s]; k < st[s + 1]; ++k)
+            F.axpyin(yi, dat[k], x[col[k]]);
+    }
+}
+
+template <class Field>
+inline void fspmv_blocks(const Field &F, const Sparse<Field, SparseMatrix_t::CSR_TILED> &A, index_t bbeg,
+                         index_t bend, typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
+                         FieldCategories::UnparametricTag) {
+    assume_aligned(dat, A.dat, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
+    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
+    for (uint64_t s = A.blockSt[bbeg]; s < A.blockSt[bend]; ++s) {
+        typename Field::Element yi = 0;
+        for (uint64_t k = st[s]; k < st[s + 1]; ++k)
+            yi += dat[k] * x[col[k]];
+        y[A.row[s]] += yi;
+    }
+}
+
+/* A row is reduced after each group of kmax entries: the entries of a row
+ * being spread over several segments, cnt counts those of each row of the
+ * row block since its last reduction.
+ */
+template <class Field>
+inline void fspmv_blocks(const Field &F, const Sparse<Field, SparseMatrix_t::CSR_TILED> &A, index_t bbeg,
+                         index_t bend, typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
+                         const uint64_t kmax) {
+    assume_aligned(dat, A.dat, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
+    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
+    const uint64_t km = std::max<uint64_t>(1, std::min<uint64_t>(kmax, A.maxrow));
+    std::vector<uint64_t> cnt(A.tileRows);
+    for (index_t b = bbeg; b < bend; ++b) {
+        const index_t r0 = b * A.tileRows, r1 = std::min<index_t>(A.m, r0 + A.tileRows);
+        std::fill(cnt.begin(), cnt.end(), 0);
+        for (uint64_t s = A.blockSt[b]; s < A.blockSt[b + 1]; ++s) {
+            typename Field::Element &yi = y[A.row[s]];
+            uint64_t &c = cnt[A.row[s] - r0];
+            for (uint64_t k = st[s]; k < st[s + 1];) {
+                const uint64_t kend = std::min<uint64_t>(st[s + 1], k + km - c);
+                c += kend - k;
+                for (; k < kend; ++k)
+                    yi += dat[k] * x[col[k]];
+                if (c == km) {
+                    F.reduce(yi);
+                    c = 0;
+                }
+            }
+        }
+        for (index_t i = r0; i < r1; ++i)
+            if (cnt[i - r0] != 0)
+                F.reduce(y[i]);
+    }
+}
+
+template <class Field>
+inline void fspmv(const Field &F, const Sparse<Field, SparseMatrix_t::CSR_TILED> &A,
+                  typename Field::ConstElement_ptr x, typename Field::Element_ptr y, FieldCategories::GenericTag) {
+    fspmv_blocks(F, A, 0, A.nRowBlocks, x, y, FieldCategories::GenericTag());
+}
+
+template <class Field>
+inline void fspmv(const Field &F, const Sparse<Field, SparseMatrix_t::CSR_TILED> &A,
+                  typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
+                  FieldCategories::UnparametricTag) {
+    fspmv_blocks(F, A, 0, A.nRowBlocks, x, y, FieldCategories::UnparametricTag());
+}
+
+template <class Field>
+inline void fspmv(const Field &F, const Sparse<Field, SparseMatrix_t::CSR_TILED> &A,
+                  typename Field::ConstElement_ptr x, typename Field::Element_ptr y, const uint64_t kmax) {
+    fspmv_blocks(F, A, 0, A.nRowBlocks, x, y, kmax);
+}
+
+} // sparse_details_impl
+
+} // FFLAS
+
+#endif // __FFLASFFPACK_fflas_sparse_CSR_TILED_spmv_INL
@@ -0,0 +1,135 @@
+/* -*- mode: C++; tab-width: 8; indent-tabs-mode: t; c-basic-offset: 8 -*- */
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/*
+ * Copyright (C) 2014 the FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ * ========LICENCE========
+ *.
+ */
+
+#ifndef __FFLASFFPACK_fflas_sparse_csr_tiled_utils_INL
+#define __FFLASFFPACK_fflas_sparse_csr_tiled_utils_INL
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace FFLAS {
+
+template <class Field> inline void sparse_delete(const Sparse<Field, SparseMatrix_t::CSR_TILED> &A) {
+    fflas_delete(A.dat);
+    fflas_delete(A.col);
+    fflas_delete(A.st);
+    fflas_delete(A.row);
+    fflas_delete(A.blockSt);
+}
+
+template <class Field> inline void sparse_print(const Sparse<Field, SparseMatrix_t::CSR_TILED> &A) {
+    for (index_t b = 0; b < A.nRowBlocks; ++b) {
+        std::cout << "row block " << b << std::endl;
+        for (uint64_t s = A.blockSt[b]; s < A.blockSt[b + 1]; ++s) {
+            std::cout << A.row[s] << " : ";
+            for (uint64_t k = A.st[s]; k < A.st[s + 1]; ++k)
+                std::cout << "(" << A.col[k] << "," << A.dat[k] << ") ";
+            std::cout << std::endl;
+        }
+    }
+}
+
+namespace sparse_details {
+
+// default tile sizes of sparse_init, from the cache sizes of the machine
+template <class Field> inline void csr_tiled_sizes(uint64_t &tileCols, uint64_t &tileRows) {
+    int l1 = -1, l2 = -1, l3 = -1;
+    queryCacheSizes(l1, l2, l3);
+    if (l1 <= 0)
+        l1 = __FFLASFFPACK_CSR_TILED_L1;
+    if (l2 <= 0)
+        l2 = __FFLASFFPACK_CSR_TILED_L2;
+    const uint64_t e = sizeof(typename Field::Element);
+    if (tileCols == 0)
+        tileCols = std::max<uint64_t>(64, (uint64_t)l2 / (2 * e));
+    if (tileRows == 0)
+        tileRows = std::max<uint64_t>(64, (uint64_t)l1 / (2 * e));
+}
+
+} // sparse_details
+
+template <class Field, class IndexT>
+inline void sparse_init(const Field &F, Sparse<Field, SparseMatrix_t::CSR_TILED> &A, const IndexT *row,
+                        const IndexT *col, typename Field::ConstElement_ptr dat, uint64_t rowdim, uint64_t coldim,
+                        uint64_t nnz, uint64_t tileCols, uint64_t tileRows) {
+    A.kmax = Protected::DotProdBoundClassic(F, F.one);
+    A.m = rowdim;
+    A.n = coldim;
+    A.nnz = nnz;
+    A.nElements = nnz;
+    sparse_details::csr_tiled_sizes<Field>(tileCols, tileRows);
+    A.tileCols = (index_t)std::min(tileCols, std::max<uint64_t>(coldim, 1));
+    A.tileRows = (index_t)std::min(tileRows, std::max<uint64_t>(rowdim, 1));
+    A.nRowBlocks = (rowdim + A.tileRows - 1) / A.tileRows;
+    A.nPanels = (coldim + A.tileCols - 1) / A.tileCols;
+
+    std::vector<index_t> len(rowdim, 0);
+    for (uint64_t k = 0; k < nnz; ++k)
+        len[row[k]]++;
+    A.maxrow = (rowdim > 0) ? *(std::max_element(len.begin(), len.end())) : 0;
+    if (A.kmax > A.maxrow)
+        A.delayed = true;
+
+    // the entries sorted by row block, panel and row, a segment being a run of equal keys
+    const uint64_t tr = A.tileRows, tc = A.tileCols, np = A.nPanels;
+    auto key = [&](uint64_t k) -> uint64_t {
+        return ((row[k] / tr) * np + col[k] / tc) * tr + row[k] % tr;
+    };
+    std::vector<uint64_t> order(nnz);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](uint64_t a, uint64_t b) { return key(a) < key(b); });
+    A.nSegments = 0;
+    for (uint64_t k = 0; k < nnz; ++k)
+        if (k == 0 || key(order[k]) != key(order[k - 1]))
+            A.nSegments++;
+
+    A.blockSt = fflas_new<uint64_t>(A.nRowBlocks + 1, Alignment::CACHE_LINE);
+    A.row = fflas_new<index_t>(A.nSegments, Alignment::CACHE_LINE);
+    A.st = fflas_new<uint64_t>(A.nSegments + 1, Alignment::CACHE_LINE);
+    A.col = fflas_new<index_t>(nnz, Alignment::CACHE_LINE);
+    A.dat = fflas_new(F, nnz, 1, Alignment::CACHE_LINE);
+    for (index_t b = 0; b <= A.nRowBlocks; ++b)
+        A.blockSt[b] = 0;
+    uint64_t s = 0;
+    for (uint64_t k = 0; k < nnz; ++k) {
+        const uint64_t e = order[k];
+        if (k == 0 || key(e) != key(order[k - 1])) {
+            A.row[s] = (index_t)row[e];
+            A.st[s] = k;
+            A.blockSt[row[e] / tr + 1]++;
+            s++;
+        }
+        A.col[k] = (index_t)col[e];
+        F.assign(A.dat[k], dat[e]);
+    }
+    A.st[A.nSegments] = nnz;
+    for (index_t b = 0; b < A.nRowBlocks; ++b)
+        A.blockSt[b + 1] += A.blockSt[b];
+}
+
+} // FFLAS
+
+#endif // __FFLASFFPACK_fflas_sparse_csr_tiled_utils_INL
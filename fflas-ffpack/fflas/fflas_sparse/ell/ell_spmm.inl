@@ -560,6 +560,23 @@ inline void fspmm_mone_simd_unaligned(const Field &F, const Sparse<Field, Sparse
 
 // #endif /*  __FFLASFFPACK_USE_SIMD */
 
+template <class Field>
+inline void fspmm_transpose(const Field &F, const Sparse<Field, SparseMatrix_t::ELL> &A, size_t blockSize,
+                            typename Field::ConstElement_ptr x_, int ldx, typename Field::Element_ptr y_, int ldy,
+                            FieldCategories::GenericTag) {
+    assume_aligned(dat, A.dat, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
+    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
+    for (index_t i = 0; i < A.m; ++i) {
+        for (index_t j = 0; j < A.ld; ++j) {
+            const index_t c = col[i * A.ld + j];
+            for (size_t k = 0; k < blockSize; ++k)
+                F.axpyin(y[c * ldy + k], dat[i * A.ld + j], x[i * ldx + k]);
+        }
+    }
+}
+
 } // ell_details
 
 } // FFLAS
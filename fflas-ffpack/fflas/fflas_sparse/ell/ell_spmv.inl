@@ -257,6 +257,26 @@ inline void fspmv_mone(const Field &F, const Sparse<Field, SparseMatrix_t::ELL_Z
     }
 }
 
+// y += A^T x: row i of A is scattered into y, the padding adds zeros to y[0]
+template <class Field>
+inline void fspmv_transpose(const Field &F, const Sparse<Field, SparseMatrix_t::ELL> &A,
+                            typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
+                            FieldCategories::GenericTag) {
+    assume_aligned(dat, A.dat, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
+
+    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
+    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
+    index_t start = 0;
+    for (index_t i = 0; i < A.m; ++i, start += A.ld) {
+        if (F.isZero(x[i]))
+            continue;
+        for (index_t j = 0; j < A.ld; ++j) {
+            F.axpyin(y[col[start + j]], dat[start + j], x[i]);
+        }
+    }
+}
+
 } // ELL_details
 
 } // FFLAS
@@ -79,9 +79,10 @@ inline void sparse_delete(const Sparse<Field, SparseMatrix_t::ELL_simd_ZO> &A);
 
 #include "fflas-ffpack/fflas/fflas_sparse/ell_simd/ell_simd_utils.inl"
 #include "fflas-ffpack/fflas/fflas_sparse/ell_simd/ell_simd_spmv.inl"
+#include "fflas-ffpack/fflas/fflas_sparse/ell_simd/ell_simd_spmm.inl"
 #if defined(__FFLASFFPACK_USE_OPENMP)
 #include "fflas-ffpack/fflas/fflas_sparse/ell_simd/ell_simd_pspmv.inl"
+#include "fflas-ffpack/fflas/fflas_sparse/ell_simd/ell_simd_pspmm.inl"
 #endif
-// #include "fflas-ffpack/fflas/fflas_sparse/ell_simd_spmm.inl"
 
 #endif // __FFLASFFPACK_fflas_sparse_ELL_simd_H
\ No newline at end of file
@@ -32,337 +32,338 @@
 namespace FFLAS {
 namespace sparse_details_impl {
 
+/* The kernels compute the chunks ibeg..iend-1 of y += A x, the sequential
+ * products taking all the chunks and the parallel ones a range per thread.
+ * Entry k of column j of chunk i is at (i * A.ld + j) * A.chunk + k.
+ * Rows beyond A.m in the last chunk are padding: they are never written, so
+ * y needs only A.m entries.
+ */
+template <class Field>
+inline index_t ell_simd_chunk_rows(const Sparse<Field, SparseMatrix_t::ELL_simd> &A, index_t i) {
+    return std::min<index_t>((index_t)A.chunk, A.m - i * (index_t)A.chunk);
+}
+
 template <class Field>
-inline void fspmv(const Field &F, const Sparse<Field, SparseMatrix_t::ELL_simd> &A, typename Field::ConstElement_ptr x_,
-                  typename Field::Element_ptr y_, FieldCategories::GenericTag) {
+inline void fspmv_chunks(const Field &F, const Sparse<Field, SparseMatrix_t::ELL_simd> &A, index_t ibeg, index_t iend,
+                         typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
+                         FieldCategories::GenericTag) {
     assume_aligned(dat, A.dat, (size_t)Alignment::CACHE_LINE);
     assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
-
     assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
     assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
-    for (index_t i = 0; i < A.nChunks; ++i) {
-        index_t j = 0;
-        for (; j < A.ld; ++j) {
-            for (index_t k = 0; k < A.chunk; ++k) {
-                F.axpyin(y[i * A.chunk + k], dat[i * A.ld * A.chunk + j * A.chunk + k],
-                         x[col[i * A.ld * A.chunk + j * A.chunk + k]]);
-            }
-        }
+    for (index_t i = ibeg; i < iend; ++i) {
+        const index_t r = ell_simd_chunk_rows(A, i);
+        const uint64_t start = (uint64_t)i * A.ld * A.chunk;
+        for (index_t j = 0; j < A.ld; ++j)
+            for (index_t k = 0; k < r; ++k)
+                F.axpyin(y[i * A.chunk + k], dat[start + j * A.chunk + k], x[col[start + j * A.chunk + k]]);
     }
 }
 
-// #ifdef __FFLASFFPACK_USE_SIMD
-
 template <class Field>
-inline void fspmv_simd(const Field &F, const Sparse<Field, SparseMatrix_t::ELL_simd> &A,
-                       typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
-                       FieldCategories::UnparametricTag) {
+inline void fspmv_chunks(const Field &F, const Sparse<Field, SparseMatrix_t::ELL_simd> &A, index_t ibeg, index_t iend,
+                         typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
+                         FieldCategories::UnparametricTag) {
     assume_aligned(dat, A.dat, (size_t)Alignment::CACHE_LINE);
     assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
-
     assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
     assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
-    using simd = Simd<typename Field::Element>;
-    using vect_t = typename simd::vect_t;
-    index_t chunk = A.chunk;
-    for (index_t i = 0; i < A.nChunks; ++i) {
-        index_t j = 0;
-        vect_t y1, y2, x1, x2, dat1, dat2, yy;
-        y1 = simd::zero();
-        y2 = simd::zero();
-        for (; j < ROUND_DOWN(A.ld, 2); j += 2) {
-            dat1 = simd::load(dat + i * A.ld * A.chunk + j * chunk);
-            dat2 = simd::load(dat + i * A.ld * A.chunk + (j + 1) * chunk);
-            x1 = simd::gather(x, col + i * A.ld * A.chunk + j * chunk);
-            x2 = simd::gather(x, col + i * A.ld * A.chunk + (j + 1) * chunk);
-            y1 = simd::fmadd(y1, dat1, x1);
-            y2 = simd::fmadd(y2, dat2, x2);
-        }
-        for (; j < A.ld; ++j) {
-            dat1 = simd::load(dat + i * A.ld * A.chunk + j * chunk);
-            x1 = simd::gather(x, col + i * A.ld * A.chunk + j * chunk);
-            y1 = simd::fmadd(y1, dat1, x1);
-        }
-        yy = simd::load(y + i * chunk);
-        simd::store(y + i * chunk, simd::add(yy, simd::add(y1, y2)));
+    for (index_t i = ibeg; i < iend; ++i) {
+        const index_t r = ell_simd_chunk_rows(A, i);
+        const uint64_t start = (uint64_t)i * A.ld * A.chunk;
+        typename Field::Element_ptr yi = y + i * A.chunk;
+        for (index_t j = 0; j < A.ld; ++j)
+            for (index_t k = 0; k < r; ++k)
+                yi[k] += dat[start + j * A.chunk + k] * x[col[start + j * A.chunk + k]];
     }
 }
-// #endif
 
+// the rows of a chunk are reduced after each group of kmax columns
 template <class Field>
-inline void fspmv(const Field &F, const Sparse<Field, SparseMatrix_t::ELL_simd> &A, typename Field::ConstElement_ptr x_,
-                  typename Field::Element_ptr y_, FieldCategories::UnparametricTag) {
+inline void fspmv_chunks(const Field &F, const Sparse<Field, SparseMatrix_t::ELL_simd> &A, index_t ibeg, index_t iend,
+                         typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_, const uint64_t kmax) {
     assume_aligned(dat, A.dat, (size_t)Alignment::CACHE_LINE);
     assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
-
     assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
     assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
-    for (index_t i = 0; i < A.nChunks; ++i) {
-        for (index_t j = 0; j < A.ld; ++j) {
-            size_t k = 0;
-            for (; k < ROUND_DOWN(A.chunk, 4); k += 4) {
-                y[i * A.chunk + k] +=
-                    dat[i * A.ld * A.chunk + j * A.chunk + k] * x[col[i * A.ld * A.chunk + j * A.chunk + k]];
-                y[i * A.chunk + k + 1] +=
-                    dat[i * A.ld * A.chunk + j * A.chunk + k + 1] * x[col[i * A.ld * A.chunk + j * A.chunk + k + 1]];
-                y[i * A.chunk + k + 2] +=
-                    dat[i * A.ld * A.chunk + j * A.chunk + k + 2] * x[col[i * A.ld * A.chunk + j * A.chunk + k + 2]];
-                y[i * A.chunk + k + 3] +=
-                    dat[i * A.ld * A.chunk + j * A.chunk + k + 3] * x[col[i * A.ld * A.chunk + j * A.chunk + k + 3]];
-            }
-            for (; k < A.chunk; ++k)
-                y[i * A.chunk + k] +=
-                    dat[i * A.ld * A.chunk + j * A.chunk + k] * x[col[i * A.ld * A.chunk + j * A.chunk + k]];
+    const index_t km = (index_t)std::max<uint64_t>(1, std::min<uint64_t>(kmax, A.ld));
+    for (index_t i = ibeg; i < iend; ++i) {
+        const index_t r = ell_simd_chunk_rows(A, i);
+        const uint64_t start = (uint64_t)i * A.ld * A.chunk;
+        typename Field::Element_ptr yi = y + i * A.chunk;
+        for (index_t j = 0; j < A.ld; j += km) {
+            const index_t jend = std::min<index_t>(A.ld, j + km);
+            for (index_t jj = j; jj < jend; ++jj)
+                for (index_t k = 0; k < r; ++k)
+                    yi[k] += dat[start + jj * A.chunk + k] * x[col[start + jj * A.chunk + k]];
+            freduce(F, r, yi, 1);
         }
     }
 }
 
-// #ifdef __FFLASFFPACK_USE_SIMD
+#ifdef __FFLASFFPACK_USE_SIMD
+
+/* A chunk holds simd::vect_size rows: a column of a chunk is one load of dat
+ * and one gather of x. The partial last chunk goes to the scalar kernel.
+ */
 template <class Field>
-inline void fspmv_simd(const Field &F, const Sparse<Field, SparseMatrix_t::ELL_simd> &A,
-                       typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_, const uint64_t kmax) {
+inline void fspmv_simd_chunks(const Field &F, const Sparse<Field, SparseMatrix_t::ELL_simd> &A, index_t ibeg,
+                              index_t iend, typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
+                              FieldCategories::UnparametricTag) {
+    using simd = Simd<typename Field::Element>;
+    using vect_t = typename simd::vect_t;
     assume_aligned(dat, A.dat, (size_t)Alignment::CACHE_LINE);
     assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
-
     assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
     assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
-    index_t block = (A.ld) / kmax; // use DIVIDE_INTO from fspmvgpu
-    index_t chunk = A.chunk;
-    size_t end = (A.m % chunk == 0) ? A.m : A.m + A.m % chunk;
-    using simd = Simd<typename Field::Element>;
-    using vect_t = typename simd::vect_t;
-
-    vect_t X, Y, D, C, Q, TMP, NEGP, INVP, MIN, MAX, P;
-    double p = (typename Field::Element)F.characteristic();
-
-    P = simd::set1(p);
-    NEGP = simd::set1(-p);
-    INVP = simd::set1(1 / p);
-    MIN = simd::set1(F.minElement());
-    MAX = simd::set1(F.maxElement());
-
-    for (size_t i = 0; i < end / chunk; ++i) {
-        index_t j = 0;
-        index_t j_loc = 0;
-        Y = simd::load(y + i * chunk);
-        for (size_t l = 0; l < block; ++l) {
-            j_loc += kmax;
-
-            for (; j < j_loc; ++j) {
-                D = simd::load(dat + i * A.chunk * A.ld + j * A.chunk);
-                X = simd::gather(x, col + i * A.chunk * A.ld + j * A.chunk);
-                Y = simd::fmadd(Y, D, X);
-            }
-            simd::mod(Y, P, INVP, NEGP, MIN, MAX, Q, TMP);
+    for (index_t i = ibeg; i < iend; ++i) {
+        if (ell_simd_chunk_rows(A, i) != (index_t)A.chunk) {
+            fspmv_chunks(F, A, i, i + 1, x, y, FieldCategories::UnparametricTag());
+            continue;
         }
-        for (; j < A.ld; ++j) {
-            D = simd::load(dat + i * A.chunk * A.ld + j * A.chunk);
-            X = simd::gather(x, col + i * A.chunk * A.ld + j * A.chunk);
-            Y = simd::fmadd(Y, D, X);
+        const uint64_t start = (uint64_t)i * A.ld * A.chunk;
+        vect_t y1 = simd::zero(), y2 = simd::zero();
+        index_t j = 0;
+        for (; j + 1 < A.ld; j += 2) {
+            y1 = simd::fmadd(y1, simd::load(dat + start + j * A.chunk), simd::gather(x, col + start + j * A.chunk));
+            y2 = simd::fmadd(y2, simd::load(dat + start + (j + 1) * A.chunk),
+                             simd::gather(x, col + start + (j + 1) * A.chunk));
         }
-        simd::mod(Y, P, INVP, NEGP, MIN, MAX, Q, TMP);
-        simd::store(y + i * A.chunk, Y);
+        if (j < A.ld)
+            y1 = simd::fmadd(y1, simd::load(dat + start + j * A.chunk), simd::gather(x, col + start + j * A.chunk));
+        simd::storeu(y + i * A.chunk, simd::add(simd::loadu(y + i * A.chunk), simd::add(y1, y2)));
     }
 }
-// #endif
 
 template <class Field>
-inline void fspmv(const Field &F, const Sparse<Field, SparseMatrix_t::ELL_simd> &A, typename Field::ConstElement_ptr x_,
-                  typename Field::Element_ptr y_, const uint64_t kmax) {
+inline void fspmv_simd_chunks(const Field &F, const Sparse<Field, SparseMatrix_t::ELL_simd> &A, index_t ibeg,
+                              index_t iend, typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
+                              const uint64_t kmax) {
+    using simd = Simd<typename Field::Element>;
+    using vect_t = typename simd::vect_t;
     assume_aligned(dat, A.dat, (size_t)Alignment::CACHE_LINE);
     assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
-
     assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
     assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
-    index_t block = (A.ld) / kmax; // use DIVIDE_INTO from fspmvgpu
-    index_t chunk = A.chunk;
-    size_t end = (A.m % chunk == 0) ? A.m : A.m + A.m % chunk;
-    for (size_t i = 0; i < end / chunk; ++i) {
-        index_t j = 0;
-        index_t j_loc = 0;
-        for (size_t l = 0; l < block; ++l) {
-            j_loc += kmax;
-
-            for (; j < j_loc; ++j) {
-                for (size_t k = 0; k < A.chunk; ++k) {
-                    y[i * A.chunk + k] +=
-                        dat[i * A.ld * A.chunk + j * A.chunk + k] * x[col[i * A.ld * A.chunk + j * A.chunk + k]];
-                }
-            }
-            for (size_t k = 0; k < A.chunk; ++k)
-                F.reduce(y[i * A.chunk + k], y[i * A.chunk + k]);
+    const index_t km = (index_t)std::max<uint64_t>(1, std::min<uint64_t>(kmax, A.ld));
+    for (index_t i = ibeg; i < iend; ++i) {
+        if (ell_simd_chunk_rows(A, i) != (index_t)A.chunk) {
+            fspmv_chunks(F, A, i, i + 1, x, y, kmax);
+            continue;
         }
-        for (; j < A.ld; ++j) {
-            for (size_t k = 0; k < A.chunk; ++k) {
-                y[i * A.chunk + k] +=
-                    dat[i * A.ld * A.chunk + j * A.chunk + k] * x[col[i * A.ld * A.chunk + j * A.chunk + k]];
-            }
+        const uint64_t start = (uint64_t)i * A.ld * A.chunk;
+        typename Field::Element_ptr yi = y + i * A.chunk;
+        for (index_t j = 0; j < A.ld; j += km) {
+            const index_t jend = std::min<index_t>(A.ld, j + km);
+            vect_t y1 = simd::loadu(yi);
+            for (index_t jj = j; jj < jend; ++jj)
+                y1 = simd::fmadd(y1, simd::load(dat + start + jj * A.chunk),
+                                 simd::gather(x, col + start + jj * A.chunk));
+            simd::storeu(yi, y1);
+            freduce(F, A.chunk, yi, 1);
         }
-        for (size_t k = 0; k < A.chunk; ++k)
-            F.reduce(y[i * A.chunk + k], y[i * A.chunk + k]);
     }
 }
 
+#else
+
+// without SIMD the simd entry points run the scalar kernels
 template <class Field>
-inline void fspmv_one(const Field &F, const Sparse<Field, SparseMatrix_t::ELL_simd_ZO> &A,
-                      typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
-                      FieldCategories::GenericTag) {
-    assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
+inline void fspmv_simd_chunks(const Field &F, const Sparse<Field, SparseMatrix_t::ELL_simd> &A, index_t ibeg,
+                              index_t iend, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
+                              FieldCategories::UnparametricTag) {
+    fspmv_chunks(F, A, ibeg, iend, x, y, FieldCategories::UnparametricTag());
+}
 
-    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
-    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
-    for (index_t i = 0; i < A.nChunks; ++i) {
-        index_t j = 0;
-        for (; j < A.ld; ++j) {
-            index_t k = 0;
-            for (; k < ROUND_DOWN(A.chunk, 4); k += 4) {
-                F.addin(y[i * A.chunk + k], x[col[i * A.ld * A.chunk + j * A.chunk + k]]);
-                F.addin(y[i * A.chunk + k + 1], x[col[i * A.ld * A.chunk + j * A.chunk + k + 1]]);
-                F.addin(y[i * A.chunk + k + 2], x[col[i * A.ld * A.chunk + j * A.chunk + k + 2]]);
-                F.addin(y[i * A.chunk + k + 3], x[col[i * A.ld * A.chunk + j * A.chunk + k + 3]]);
-            }
-            for (; k < A.chunk; ++k)
-                F.addin(y[i * A.chunk + k], x[col[i * A.ld * A.chunk + j * A.chunk + k]]);
-        }
-    }
+template <class Field>
+inline void fspmv_simd_chunks(const Field &F, const Sparse<Field, SparseMatrix_t::ELL_simd> &A, index_t ibeg,
+                              index_t iend, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
+                              const uint64_t kmax) {
+    fspmv_chunks(F, A, ibeg, iend, x, y, kmax);
 }
 
+#endif // __FFLASFFPACK_USE_SIMD
+
 template <class Field>
-inline void fspmv_mone(const Field &F, const Sparse<Field, SparseMatrix_t::ELL_simd_ZO> &A,
-                       typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
-                       FieldCategories::GenericTag) {
-    assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
+inline void fspmv(const Field &F, const Sparse<Field, SparseMatrix_t::ELL_simd> &A, typename Field::ConstElement_ptr x,
+                  typename Field::Element_ptr y, FieldCategories::GenericTag) {
+    fspmv_chunks(F, A, 0, A.nChunks, x, y, FieldCategories::GenericTag());
+}
+
+template <class Field>
+inline void fspmv(const Field &F, const Sparse<Field, SparseMatrix_t::ELL_simd> &A, typename Field::ConstElement_ptr x,
+                  typename Field::Element_ptr y, FieldCategories::UnparametricTag) {
+    fspmv_chunks(F, A, 0, A.nChunks, x, y, FieldCategories::UnparametricTag());
+}
 
+template <class Field>
+inline void fspmv(const Field &F, const Sparse<Field, SparseMatrix_t::ELL_simd> &A, typename Field::ConstElement_ptr x,
+                  typename Field::Element_ptr y, const uint64_t kmax) {
+    fspmv_chunks(F, A, 0, A.nChunks, x, y, kmax);
+}
+
+template <class Field>
+inline void fspmv_simd(const Field &F, const Sparse<Field, SparseMatrix_t::ELL_simd> &A,
+                       typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
+                       FieldCategories::UnparametricTag) {
+    fspmv_simd_chunks(F, A, 0, A.nChunks, x, y, FieldCategories::UnparametricTag());
+}
+
+template <class Field>
+inline void fspmv_simd(const Field &F, const Sparse<Field, SparseMatrix_t::ELL_simd> &A,
+                       typename Field::ConstElement_ptr x, typename Field::Element_ptr y, const uint64_t kmax) {
+    fspmv_simd_chunks(F, A, 0, A.nChunks, x, y, kmax);
+}
+
+/* ZO kernels: x has a zero at index A.n for the padding entries, see
+ * sparse_details::zo_padded_input.
+ */
+template <class Field>
+inline void fspmv_one_chunks(const Field &F, const Sparse<Field, SparseMatrix_t::ELL_simd_ZO> &A, index_t ibeg,
+                             index_t iend, typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
+                             FieldCategories::GenericTag) {
+    assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
     assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
     assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
-    for (index_t i = 0; i < A.nChunks; ++i) {
-        index_t j = 0;
-        for (; j < A.ld; ++j) {
-            index_t k = 0;
-            for (; k < ROUND_DOWN(A.chunk, 4); k += 4) {
-                F.subin(y[i * A.chunk + k], x[col[i * A.ld * A.chunk + j * A.chunk + k]]);
-                F.subin(y[i * A.chunk + k + 1], x[col[i * A.ld * A.chunk + j * A.chunk + k + 1]]);
-                F.subin(y[i * A.chunk + k + 2], x[col[i * A.ld * A.chunk + j * A.chunk + k + 2]]);
-                F.subin(y[i * A.chunk + k + 3], x[col[i * A.ld * A.chunk + j * A.chunk + k + 3]]);
-            }
-            for (; k < A.chunk; ++k)
-                F.subin(y[i * A.chunk + k], x[col[i * A.ld * A.chunk + j * A.chunk + k]]);
-        }
+    for (index_t i = ibeg; i < iend; ++i) {
+        const index_t r = ell_simd_chunk_rows(A, i);
+        const uint64_t start = (uint64_t)i * A.ld * A.chunk;
+        for (index_t j = 0; j < A.ld; ++j)
+            for (index_t k = 0; k < r; ++k)
+                F.addin(y[i * A.chunk + k], x[col[start + j * A.chunk + k]]);
     }
 }
 
 template <class Field>
-inline void fspmv_one(const Field &F, const Sparse<Field, SparseMatrix_t::ELL_simd_ZO> &A,
-                      typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
-                      FieldCategories::UnparametricTag) {
+inline void fspmv_mone_chunks(const Field &F, const Sparse<Field, SparseMatrix_t::ELL_simd_ZO> &A, index_t ibeg,
+                              index_t iend, typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
+                              FieldCategories::GenericTag) {
     assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
-
     assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
     assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
-    for (index_t i = 0; i < A.nChunks; ++i) {
-        index_t j = 0;
-        for (; j < A.ld; ++j) {
-            index_t k = 0;
-            for (; k < ROUND_DOWN(A.chunk, 4); k += 4) {
-                y[i * A.chunk + k] += x[col[i * A.ld * A.chunk + j * A.chunk + k]];
-                y[i * A.chunk + k + 1] += x[col[i * A.ld * A.chunk + j * A.chunk + k + 1]];
-                y[i * A.chunk + k + 2] += x[col[i * A.ld * A.chunk + j * A.chunk + k + 2]];
-                y[i * A.chunk + k + 3] += x[col[i * A.ld * A.chunk + j * A.chunk + k + 3]];
-            }
-            for (; k < A.chunk; ++k)
-                y[i * A.chunk + k] += x[col[i * A.ld * A.chunk + j * A.chunk + k]];
-        }
+    for (index_t i = ibeg; i < iend; ++i) {
+        const index_t r = ell_simd_chunk_rows(A, i);
+        const uint64_t start = (uint64_t)i * A.ld * A.chunk;
+        for (index_t j = 0; j < A.ld; ++j)
+            for (index_t k = 0; k < r; ++k)
+                F.subin(y[i * A.chunk + k], x[col[start + j * A.chunk + k]]);
     }
 }
 
 template <class Field>
-inline void fspmv_mone(const Field &F, const Sparse<Field, SparseMatrix_t::ELL_simd_ZO> &A,
-                       typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
-                       FieldCategories::UnparametricTag) {
+inline void fspmv_one_chunks(const Field &F, const Sparse<Field, SparseMatrix_t::ELL_simd_ZO> &A, index_t ibeg,
+                             index_t iend, typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
+                             FieldCategories::UnparametricTag) {
     assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
-
     assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
     assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
-    for (index_t i = 0; i < A.nChunks; ++i) {
-        index_t j = 0;
-        for (; j < A.ld; ++j) {
-            index_t k = 0;
-            for (; k < ROUND_DOWN(A.chunk, 4); k += 4) {
-                y[i * A.chunk + k] -= x[col[i * A.ld * A.chunk + j * A.chunk + k]];
-                y[i * A.chunk + k + 1] -= x[col[i * A.ld * A.chunk + j * A.chunk + k + 1]];
-                y[i * A.chunk + k + 2] -= x[col[i * A.ld * A.chunk + j * A.chunk + k + 2]];
-                y[i * A.chunk + k + 3] -= x[col[i * A.ld * A.chunk + j * A.chunk + k + 3]];
-            }
-            for (; k < A.chunk; ++k)
-                y[i * A.chunk + k] -= x[col[i * A.ld * A.chunk + j * A.chunk + k]];
-        }
+    for (index_t i = ibeg; i < iend; ++i) {
+        const index_t r = ell_simd_chunk_rows(A, i);
+        const uint64_t start = (uint64_t)i * A.ld * A.chunk;
+        typename Field::Element_ptr yi = y + i * A.chunk;
+        for (index_t j = 0; j < A.ld; ++j)
+            for (index_t k = 0; k < r; ++k)
+                yi[k] += x[col[start + j * A.chunk + k]];
     }
 }
 
-// #ifdef __FFLASFFPACK_USE_SIMD
 template <class Field>
-inline void fspmv_one_simd(const Field &F, const Sparse<Field, SparseMatrix_t::ELL_simd_ZO> &A,
-                           typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
-                           FieldCategories::UnparametricTag) {
+inline void fspmv_mone_chunks(const Field &F, const Sparse<Field, SparseMatrix_t::ELL_simd_ZO> &A, index_t ibeg,
+                              index_t iend, typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
+                              FieldCategories::UnparametricTag) {
     assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
-
     assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
     assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
+    for (index_t i = ibeg; i < iend; ++i) {
+        const index_t r = ell_simd_chunk_rows(A, i);
+        const uint64_t start = (uint64_t)i * A.ld * A.chunk;
+        typename Field::Element_ptr yi = y + i * A.chunk;
+        for (index_t j = 0; j < A.ld; ++j)
+            for (index_t k = 0; k < r; ++k)
+                yi[k] -= x[col[start + j * A.chunk + k]];
+    }
+}
+
+#ifdef __FFLASFFPACK_USE_SIMD
+// y += cst * (sum of the gathered columns), cst being 1 or -1
+template <class Field, bool one>
+inline void fspmv_zo_simd_chunks(const Field &F, const Sparse<Field, SparseMatrix_t::ELL_simd_ZO> &A, index_t ibeg,
+                                 index_t iend, typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_) {
     using simd = Simd<typename Field::Element>;
     using vect_t = typename simd::vect_t;
-    for (index_t i = 0; i < A.nChunks; ++i) {
-        index_t j = 0;
-        vect_t y1, y2, x1, x2, dat1, dat2, yy;
-        y1 = simd::zero();
-        y2 = simd::zero();
-        for (; j < ROUND_DOWN(A.ld, 2); j += 2) {
-            x1 = simd::gather(x, col + i * A.ld * A.chunk + j * A.chunk);
-            x2 = simd::gather(x, col + i * A.ld * A.chunk + (j + 1) * A.chunk);
-            y1 = simd::add(y1, x1);
-            y1 = simd::add(y2, x2);
+    assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
+    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
+    for (index_t i = ibeg; i < iend; ++i) {
+        if (ell_simd_chunk_rows(A, i) != (index_t)A.chunk) {
+            if (one)
+                fspmv_one_chunks(F, A, i, i + 1, x, y, FieldCategories::UnparametricTag());
+            else
+                fspmv_mone_chunks(F, A, i, i + 1, x, y, FieldCategories::UnparametricTag());
+            continue;
         }
-        for (; j < A.ld; ++j) {
-            x1 = simd::gather(x, col + i * A.ld * A.chunk + j * A.chunk);
-            y1 = simd::add(y1, x1);
+        const uint64_t start = (uint64_t)i * A.ld * A.chunk;
+        vect_t y1 = simd::zero(), y2 = simd::zero();
+        index_t j = 0;
+        for (; j + 1 < A.ld; j += 2) {
+            y1 = simd::add(y1, simd::gather(x, col + start + j * A.chunk));
+            y2 = simd::add(y2, simd::gather(x, col + start + (j + 1) * A.chunk));
         }
-        yy = simd::load(y + i * A.chunk);
-        simd::store(y + i * A.chunk, simd::add(yy, simd::add(y1, y2)));
+        if (j < A.ld)
+            y1 = simd::add(y1, simd::gather(x, col + start + j * A.chunk));
+        const vect_t yy = simd::loadu(y + i * A.chunk);
+        simd::storeu(y + i * A.chunk, one ? simd::add(yy, simd::add(y1, y2)) : simd::sub(yy, simd::add(y1, y2)));
     }
 }
+#else
+
+template <class Field, bool one>
+inline void fspmv_zo_simd_chunks(const Field &F, const Sparse<Field, SparseMatrix_t::ELL_simd_ZO> &A, index_t ibeg,
+                                 index_t iend, typename Field::ConstElement_ptr x, typename Field::Element_ptr y) {
+    if (one)
+        fspmv_one_chunks(F, A, ibeg, iend, x, y, FieldCategories::UnparametricTag());
+    else
+        fspmv_mone_chunks(F, A, ibeg, iend, x, y, FieldCategories::UnparametricTag());
+}
+
+#endif // __FFLASFFPACK_USE_SIMD
+
+template <class Field, class FieldCat>
+inline void fspmv_one(const Field &F, const Sparse<Field, SparseMatrix_t::ELL_simd_ZO> &A,
+                      typename Field::ConstElement_ptr x, typename Field::Element_ptr y, FieldCat tag) {
+    typename Field::Element_ptr x1 = sparse_details::zo_padded_input(F, A, 1, x, 1);
+    fspmv_one_chunks(F, A, 0, A.nChunks, x1 ? x1 : x, y, tag);
+    fflas_delete(x1);
+}
+
+template <class Field, class FieldCat>
+inline void fspmv_mone(const Field &F, const Sparse<Field, SparseMatrix_t::ELL_simd_ZO> &A,
+                       typename Field::ConstElement_ptr x, typename Field::Element_ptr y, FieldCat tag) {
+    typename Field::Element_ptr x1 = sparse_details::zo_padded_input(F, A, 1, x, 1);
+    fspmv_mone_chunks(F, A, 0, A.nChunks, x1 ? x1 : x, y, tag);
+    fflas_delete(x1);
+}
+
+template <class Field>
+inline void fspmv_one_simd(const Field &F, const Sparse<Field, SparseMatrix_t::ELL_simd_ZO> &A,
+                           typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
+                           FieldCategories::UnparametricTag) {
+    typename Field::Element_ptr x1 = sparse_details::zo_padded_input(F, A, 1, x, 1);
+    fspmv_zo_simd_chunks<Field, true>(F, A, 0, A.nChunks, x1 ? x1 : x, y);
+    fflas_delete(x1);
+}
 
 template <class Field>
 inline void fspmv_mone_simd(const Field &F, const Sparse<Field, SparseMatrix_t::ELL_simd_ZO> &A,
-                            typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
+                            typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
                             FieldCategories::UnparametricTag) {
-    assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
-
-    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
-    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
-    using simd = Simd<typename Field::Element>;
-    using vect_t = typename simd::vect_t;
-    for (index_t i = 0; i < A.nChunks; ++i) {
-        index_t j = 0;
-        vect_t y1, y2, x1, x2, dat1, dat2, yy;
-        y1 = simd::zero();
-        y2 = simd::zero();
-        for (; j < ROUND_DOWN(A.ld, 2); j += 2) {
-            x1 = simd::gather(x, col + i * A.ld * A.chunk + j * A.chunk);
-            x2 = simd::gather(x, col + i * A.ld * A.chunk + (j + 1) * A.chunk);
-            y1 = simd::add(y1, x1);
-            y1 = simd::add(y2, x2);
-        }
-        for (; j < A.ld; ++j) {
-            x1 = simd::gather(x, col + i * A.ld * A.chunk + j * A.chunk);
-            y1 = simd::add(y1, x1);
-        }
-        yy = simd::load(y + i * A.chunk);
-        simd::store(y + i * A.chunk, simd::sub(yy, simd::add(y1, y2)));
-    }
+    typename Field::Element_ptr x1 = sparse_details::zo_padded_input(F, A, 1, x, 1);
+    fspmv_zo_simd_chunks<Field, false>(F, A, 0, A.nChunks, x1 ? x1 : x, y);
+    fflas_delete(x1);
 }
-// #endif
 
-} // ELL_simd_details
+} // sparse_details_impl
 
 } // FFLAS
 
-#endif //  __FFLASFFPACK_fflas_ELL_simd_spmv_INL
\ No newline at end of file
+#endif // __FFLASFFPACK_fflas_sparse_ELL_simd_spmv_INL
@@ -140,8 +140,9 @@ inline void sparse_init(const Field &F, Sparse<Field, SparseMatrix_t::ELL_simd_Z
 
     A.nElements = A.nChunks * A.chunk * A.ld;
 
+    // padding entries point to column n, see sparse_details::zo_padded_input
     for (size_t i = 0; i < A.nChunks * A.chunk * A.ld; ++i) {
-        A.col[i] = 0;
+        A.col[i] = A.n;
     }
 
     for (size_t i = 0; i < A.nChunks; ++i) {
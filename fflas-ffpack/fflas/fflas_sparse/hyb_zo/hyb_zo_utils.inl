@@ -34,12 +34,18 @@ namespace FFLAS {
 // #define HYB_ZO_DEBUG 1
 
 template <class Field> inline void sparse_delete(const Sparse<Field, SparseMatrix_t::HYB_ZO> &A) {
-    if (A.dat != nullptr)
+    if (A.dat != nullptr) {
         sparse_delete(*(A.dat));
-    if (A.one != nullptr)
+        delete A.dat;
+    }
+    if (A.one != nullptr) {
         sparse_delete(*(A.one));
-    if (A.mone != nullptr)
+        delete A.one;
+    }
+    if (A.mone != nullptr) {
         sparse_delete(*(A.mone));
+        delete A.mone;
+    }
 }
 
 template <class Field, class IndexT>
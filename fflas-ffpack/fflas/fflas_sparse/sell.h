@@ -26,8 +26,10 @@
  *.
  */
 
-/** @file fflas/fflas_fspmv_sell.inl
- * NO DOC
+/** @file fflas/fflas_sparse/sell.h
+ * Sliced ELL (SELL-C-sigma): the rows are sorted by decreasing length inside
+ * windows of sigma rows, then stored by chunks of C rows as in ELL_simd, each
+ * chunk padded to its own longest row.
  */
 
 #ifndef __FFLASFFPACK_fflas_sparse_sell_H
@@ -36,10 +38,10 @@
 namespace FFLAS { /*  SELL */
 
 template <class _Field> struct Sparse<_Field, SparseMatrix_t::SELL> {
- using Field = _Field;
+    using Field = _Field;
     bool delayed = false;
     int chunk = 0;
-    index_t kmax = 0;
+    uint64_t kmax = 0;
     index_t m = 0;
     index_t n = 0;
     index_t maxrow = 0;
@@ -47,28 +49,55 @@ template <class _Field> struct Sparse<_Field, SparseMatrix_t::SELL> {
     index_t nChunks = 0;
     uint64_t nnz = 0;
     uint64_t nElements = 0;
-    index_t *perm = nullptr;
-    uint64_t *st = nullptr;
-    index_t *chunkSize = nullptr;
+    index_t *perm = nullptr;      // perm[s] is the row of A stored in slot s = i * chunk + k
+    uint64_t *st = nullptr;       // chunk i is at st[i]..st[i+1]-1 in col and dat
+    index_t *chunkSize = nullptr; // number of columns of chunk i
     index_t *col = nullptr;
-    typename _Field::Element_ptr dat;
+    typename _Field::Element_ptr dat = nullptr;
+    index_t *reorder = nullptr;   // reorder[k] is the row and column of A at k in P A P^T, see SparseReordering
+    sparse_details::ReorderScratch<_Field> *reorderScratch = nullptr; // x and y permuted by reorder
 };
 
 template <class _Field>
 struct Sparse<_Field, SparseMatrix_t::SELL_ZO>
     : public Sparse<_Field, SparseMatrix_t::SELL> {
-        using Field = _Field;
+    using Field = _Field;
     typename _Field::Element cst = 1;
 };
 
+template <class Field, class IndexT>
+inline void sparse_init(const Field &F, Sparse<Field, SparseMatrix_t::SELL> &A, const IndexT *row, const IndexT *col,
+                        typename Field::ConstElement_ptr dat, uint64_t rowdim, uint64_t coldim, uint64_t nnz,
+                        uint64_t sigma = 0);
+
+template <class Field, class IndexT>
+inline void sparse_init(const Field &F, Sparse<Field, SparseMatrix_t::SELL_ZO> &A, const IndexT *row,
+                        const IndexT *col, typename Field::ConstElement_ptr dat, uint64_t rowdim, uint64_t coldim,
+                        uint64_t nnz, uint64_t sigma = 0);
+
+/* Same for the P A P^T of the given reordering of a square matrix: the
+ * rows of P A P^T are then sorted by length inside the sigma windows.
+ */
+template <class Field, class IndexT>
+inline void sparse_init(const Field &F, Sparse<Field, SparseMatrix_t::SELL> &A, const IndexT *row, const IndexT *col,
+                        typename Field::ConstElement_ptr dat, uint64_t rowdim, uint64_t coldim, uint64_t nnz,
+                        uint64_t sigma, SparseReordering reorder);
+
+template <class Field, class IndexT>
+inline void sparse_init(const Field &F, Sparse<Field, SparseMatrix_t::SELL_ZO> &A, const IndexT *row,
+                        const IndexT *col, typename Field::ConstElement_ptr dat, uint64_t rowdim, uint64_t coldim,
+                        uint64_t nnz, uint64_t sigma, SparseReordering reorder);
+
+template <class Field> inline void sparse_delete(const Sparse<Field, SparseMatrix_t::SELL> &A);
+
+template <class Field> inline void sparse_delete(const Sparse<Field, SparseMatrix_t::SELL_ZO> &A);
+
 } // FFLAS
 
 #include "fflas-ffpack/fflas/fflas_sparse/sell/sell_utils.inl"
 #include "fflas-ffpack/fflas/fflas_sparse/sell/sell_spmv.inl"
-#if defined(__FFLASFFPACK_USE_OPENMP)
+#include "fflas-ffpack/fflas/fflas_sparse/sell/sell_spmm.inl"
 #include "fflas-ffpack/fflas/fflas_sparse/sell/sell_pspmv.inl"
-#endif
-// #include "fflas-ffpack/fflas/fflas_sparse/sell/sell_spmm.inl"
-// #include "fflas-ffpack/fflas/fflas_sparse/sell/sell_pspmm.inl"
+#include "fflas-ffpack/fflas/fflas_sparse/sell/sell_pspmm.inl"
 
-#endif // __FFLASFFPACK_fflas_sparse_SELL_H
\ No newline at end of file
+#endif // __FFLASFFPACK_fflas_sparse_SELL_H
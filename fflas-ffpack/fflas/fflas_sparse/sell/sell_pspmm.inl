@@ -0,0 +1,177 @@
+/* -*- mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+// vim:sts=4:sw=4:ts=4:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/*
+ * Copyright (C) 2016 the FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ * ========LICENCE========
+ *.
+ */
+
+#ifndef __FFLASFFPACK_fflas_sparse_SELL_pspmm_INL
+#define __FFLASFFPACK_fflas_sparse_SELL_pspmm_INL
+
+namespace FFLAS {
+namespace sparse_details_impl {
+
+template <class Field>
+inline void pfspmm(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, size_t blockSize,
+                   typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                   FieldCategories::GenericTag) {
+    sell_parallel_chunks(A, [&](index_t ibeg, index_t iend) {
+        fspmm_chunks(F, A, ibeg, iend, blockSize, x, ldx, y, ldy, FieldCategories::GenericTag());
+    });
+}
+
+template <class Field>
+inline void pfspmm(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, size_t blockSize,
+                   typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                   FieldCategories::UnparametricTag) {
+    sell_parallel_chunks(A, [&](index_t ibeg, index_t iend) {
+        fspmm_chunks(F, A, ibeg, iend, blockSize, x, ldx, y, ldy, FieldCategories::UnparametricTag());
+    });
+}
+
+template <class Field>
+inline void pfspmm(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, size_t blockSize,
+                   typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                   const uint64_t kmax) {
+    sell_parallel_chunks(A, [&](index_t ibeg, index_t iend) {
+        fspmm_chunks(F, A, ibeg, iend, blockSize, x, ldx, y, ldy, kmax);
+    });
+}
+
+template <class Field>
+inline void pfspmm_simd_aligned(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, size_t blockSize,
+                                typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                                FieldCategories::UnparametricTag) {
+    pfspmm(F, A, blockSize, x, ldx, y, ldy, FieldCategories::UnparametricTag());
+}
+
+template <class Field>
+inline void pfspmm_simd_unaligned(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, size_t blockSize,
+                                  typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                                  FieldCategories::UnparametricTag) {
+    pfspmm(F, A, blockSize, x, ldx, y, ldy, FieldCategories::UnparametricTag());
+}
+
+template <class Field>
+inline void pfspmm_simd_aligned(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, size_t blockSize,
+                                typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                                const uint64_t kmax) {
+    pfspmm(F, A, blockSize, x, ldx, y, ldy, kmax);
+}
+
+template <class Field>
+inline void pfspmm_simd_unaligned(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, size_t blockSize,
+                                  typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                                  const uint64_t kmax) {
+    pfspmm(F, A, blockSize, x, ldx, y, ldy, kmax);
+}
+
+template <class Field, class FieldCat>
+inline void pfspmm_zo(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A, size_t blockSize,
+                      typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy, bool one,
+                      FieldCat tag) {
+    typename Field::Element_ptr x1 = sparse_details::zo_padded_input(F, A, blockSize, x, ldx);
+    typename Field::ConstElement_ptr xx = x1 ? x1 : x;
+    const int ldxx = x1 ? (int)blockSize : ldx;
+    sell_parallel_chunks(A, [&](index_t ibeg, index_t iend) {
+        fspmm_zo_chunks(F, A, ibeg, iend, blockSize, xx, ldxx, y, ldy, one, tag);
+    });
+    fflas_delete(x1);
+}
+
+template <class Field, class FieldCat>
+inline void pfspmm_one(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A, size_t blockSize,
+                       typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                       FieldCat tag) {
+    pfspmm_zo(F, A, blockSize, x, ldx, y, ldy, true, tag);
+}
+
+template <class Field, class FieldCat>
+inline void pfspmm_mone(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A, size_t blockSize,
+                        typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                        FieldCat tag) {
+    pfspmm_zo(F, A, blockSize, x, ldx, y, ldy, false, tag);
+}
+
+template <class Field>
+inline void pfspmm_one_simd_aligned(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A,
+                                    size_t blockSize, typename Field::ConstElement_ptr x, int ldx,
+                                    typename Field::Element_ptr y, int ldy, FieldCategories::UnparametricTag) {
+    pfspmm_zo(F, A, blockSize, x, ldx, y, ldy, true, FieldCategories::UnparametricTag());
+}
+
+template <class Field>
+inline void pfspmm_one_simd_unaligned(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A,
+                                      size_t blockSize, typename Field::ConstElement_ptr x, int ldx,
+                                      typename Field::Element_ptr y, int ldy, FieldCategories::UnparametricTag) {
+    pfspmm_zo(F, A, blockSize, x, ldx, y, ldy, true, FieldCategories::UnparametricTag());
+}
+
+template <class Field>
+inline void pfspmm_mone_simd_aligned(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A,
+                                     size_t blockSize, typename Field::ConstElement_ptr x, int ldx,
+                                     typename Field::Element_ptr y, int ldy, FieldCategories::UnparametricTag) {
+    pfspmm_zo(F, A, blockSize, x, ldx, y, ldy, false, FieldCategories::UnparametricTag());
+}
+
+template <class Field>
+inline void pfspmm_mone_simd_unaligned(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A,
+                                       size_t blockSize, typename Field::ConstElement_ptr x, int ldx,
+                                       typename Field::Element_ptr y, int ldy, FieldCategories::UnparametricTag) {
+    pfspmm_zo(F, A, blockSize, x, ldx, y, ldy, false, FieldCategories::UnparametricTag());
+}
+
+/* The transposed product splits the columns of X and Y among the threads,
+ * which scatter all the chunks into disjoint columns of Y.
+ */
+template <class Field, class SM>
+inline void sell_pfspmm_transpose(const Field &F, const SM &A, size_t blockSize, typename Field::ConstElement_ptr x,
+                                  int ldx, typename Field::Element_ptr y, int ldy) {
+    const size_t nt = std::min<size_t>(MAX_THREADS, blockSize);
+    if (nt <= 1) {
+        fspmm_transpose_chunks(F, A, 0, A.nChunks, blockSize, x, ldx, y, ldy, FieldCategories::GenericTag());
+        return;
+    }
+    const ParSeqHelper::Parallel<CuttingStrategy::Block, StrategyParameter::Threads> psh(nt);
+    Protected::pforblock1d_static(blockSize, psh, [&](size_t bb, size_t be) {
+        fspmm_transpose_chunks(F, A, 0, A.nChunks, be - bb, x + bb, ldx, y + bb, ldy, FieldCategories::GenericTag());
+    });
+}
+
+template <class Field>
+inline void pfspmm_transpose(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, size_t blockSize,
+                             typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                             FieldCategories::GenericTag) {
+    sell_pfspmm_transpose(F, A, blockSize, x, ldx, y, ldy);
+}
+
+template <class Field>
+inline void pfspmm_transpose(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A, size_t blockSize,
+                             typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                             FieldCategories::GenericTag) {
+    sell_pfspmm_transpose(F, A, blockSize, x, ldx, y, ldy);
+}
+
+} // sparse_details_impl
+
+} // FFLAS
+
+#endif // __FFLASFFPACK_fflas_sparse_SELL_pspmm_INL
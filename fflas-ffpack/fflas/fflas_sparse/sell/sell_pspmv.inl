@@ -26,656 +26,168 @@
  *.
  */
 
-#ifndef __FFLASFFPACK_fflas_sparse_sell_pspmv_INL
-#define __FFLASFFPACK_fflas_sparse_sell_pspmv_INL
-
-#ifdef __FFLASFFPACK_USE_TBB
-#include "tbb/parallel_for.h"
-#include "tbb/blocked_range.h"
-#endif
+#ifndef __FFLASFFPACK_fflas_sparse_SELL_pspmv_INL
+#define __FFLASFFPACK_fflas_sparse_SELL_pspmv_INL
 
 namespace FFLAS {
 namespace sparse_details_impl {
+
+/* The parallel products give each thread a contiguous range of chunks
+ * holding about nElements/p entries, padding included: the chunks of a SELL
+ * matrix have different widths, an even split of the chunks would leave the
+ * threads holding the long rows behind. The rows of the chunks of distinct
+ * threads are distinct, the threads write disjoint entries of y.
+ */
 template <class Field>
-inline void pfspmv(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, typename Field::ConstElement_ptr x_,
-                   typename Field::Element_ptr y_, FieldCategories::GenericTag) {
-    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(chunkSize, A.chunkSize, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(dat, A.dat, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
-    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
-#ifdef __FFLASFFPACK_USE_TBB
-    tbb::parallel_for(tbb::blocked_range<index_t>(0, A.nbChunks, 2),
-                      [&F, &A, x, y, col, st, dat, chunkSize](const tbb::blocked_range<index_t> &r) {
-        for (index_t i = r.begin(), end = r.end(); i < end; ++i) {
-            index_t start = st[i];
-            index_t size = chunkSize[i];
-            index_t j = 0;
-            for (; j < size; j++) {
-                for (index_t k = 0; k < A.chunk; ++k) {
-                    F.axpyin(y[i * A.chunk + k], dat[start + j * A.chunk + k], x[col[start + j * A.chunk + k]]);
-                }
-            }
-        }
-    });
-#else
-#pragma omp parallel for
-    for (index_t i = 0; i < A.nChunks; ++i) {
-        index_t start = st[i];
-        index_t size = chunkSize[i];
-        index_t j = 0;
-        for (; j < size; j++) {
-            for (index_t k = 0; k < A.chunk; ++k) {
-                F.axpyin(y[i * A.chunk + k], dat[start + j * A.chunk + k], x[col[start + j * A.chunk + k]]);
-            }
-        }
-    }
-#endif
+inline index_t sell_chunk_split(const Sparse<Field, SparseMatrix_t::SELL> &A, uint64_t t, uint64_t p) {
+    if (t == 0)
+        return 0;
+    if (t == p)
+        return A.nChunks;
+    const uint64_t *start = A.st, *stop = A.st + A.nChunks;
+    return (index_t)(std::lower_bound(start, stop, A.nElements * t / p) - start);
 }
 
-#ifdef __FFLASFFPACK_USE_SIMD
-
-template <class Field>
-inline void pfspmv_simd(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A,
-                        typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
-                        FieldCategories::UnparametricTag) {
-    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(chunkSize, A.chunkSize, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(dat, A.dat, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
-    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
-    using simd = Simd<typename Field::Element>;
-    using vect_t = typename simd::vect_t;
-#ifdef __FFLASFFPACK_USE_TBB
-    tbb::parallel_for(tbb::blocked_range<index_t>(0, A.nbChunks, 2),
-                      [&F, &A, x, y, st, col, dat, chunkSize](const tbb::blocked_range<index_t> &r) {
-        for (index_t i = r.begin(), end = r.end(); i < end; ++i) {
-            index_t start = st[i];
-            index_t size = chunkSize[i];
-            vect_t x1, x2, y1, y2, dat1, dat2;
-            y1 = simd::zero();
-            y2 = simd::zero();
-            index_t j = 0;
-            for (; j < ROUND_DOWN(size, 2); j += 2) {
-                dat1 = simd::load(dat + start + j * A.chunk);
-                dat2 = simd::load(dat + start + (j + 1) * A.chunk);
-                x1 = simd::gather(x, col + start + j * A.chunk);
-                x2 = simd::gather(x, col + start + (j + 1) * A.chunk);
-                y1 = simd::fmadd(y1, dat1, x1);
-                y2 = simd::fmadd(y2, dat2, x2);
-            }
-            if (size % 2 != 0) {
-                dat1 = simd::load(dat + start + j * A.chunk);
-                x1 = simd::gather(x, col + start + j * A.chunk);
-                y1 = simd::fmadd(y1, dat1, x1);
-            }
-            simd::store(y + i * A.chunk, simd::add(simd::load(y + i * A.chunk), simd::add(y1, y2)));
-        }
-    });
-#else
-#pragma omp parallel for
-    for (index_t i = 0; i < A.nChunks; ++i) {
-        index_t start = st[i];
-        index_t size = chunkSize[i];
-        vect_t x1, x2, y1, y2, dat1, dat2;
-        y1 = simd::zero();
-        y2 = simd::zero();
-        index_t j = 0;
-        for (; j < ROUND_DOWN(size, 2); j += 2) {
-            dat1 = simd::load(dat + start + j * A.chunk);
-            dat2 = simd::load(dat + start + (j + 1) * A.chunk);
-            x1 = simd::gather(x, col + start + j * A.chunk);
-            x2 = simd::gather(x, col + start + (j + 1) * A.chunk);
-            y1 = simd::fmadd(y1, dat1, x1);
-            y2 = simd::fmadd(y2, dat2, x2);
-        }
-        if (size % 2 != 0) {
-            dat1 = simd::load(dat + start + j * A.chunk);
-            x1 = simd::gather(x, col + start + j * A.chunk);
-            y1 = simd::fmadd(y1, dat1, x1);
-        }
-        simd::store(y + i * A.chunk, simd::add(simd::load(y + i * A.chunk), simd::add(y1, y2)));
+template <class Field, class Func>
+inline void sell_parallel_chunks(const Sparse<Field, SparseMatrix_t::SELL> &A, Func f) {
+    const size_t nt = std::min<size_t>(MAX_THREADS, A.nChunks);
+    if (nt <= 1) {
+        f((index_t)0, (index_t)A.nChunks);
+        return;
     }
-#endif // TBB
+    // one block per thread, run by paladin: OpenMP, TBB or the native threads
+    const ParSeqHelper::Parallel<CuttingStrategy::Block, StrategyParameter::Threads> psh(nt);
+    Protected::pforblock1d_static(nt, psh, [&](size_t tb, size_t te) {
+        for (size_t t = tb; t < te; ++t)
+            f(sell_chunk_split(A, t, nt), sell_chunk_split(A, t + 1, nt));
+    });
 }
 
-#endif // SIMD
-
 template <class Field>
-inline void pfspmv(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, typename Field::ConstElement_ptr x_,
-                   typename Field::Element_ptr y_, FieldCategories::UnparametricTag) {
-    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(chunkSize, A.chunkSize, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(dat, A.dat, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
-    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
-#ifdef __FFLASFFPACK_USE_TBB
-    tbb::parallel_for(tbb::blocked_range<index_t>(0, A.nbChunks, 2),
-                      [&F, &A, x, y, st, col, dat, chunkSize](const tbb::blocked_range<index_t> &r) {
-        for (index_t i = r.begin(), end = r.end(); i < end; ++i) {
-            index_t start = st[i];
-            index_t size = chunkSize[i];
-            for (index_t j = 0; j < size; ++j) {
-                size_t k = 0;
-                for (; k < ROUND_DOWN(A.chunk, 4); k += 4) {
-                    y[i * A.chunk + k] += dat[start + j * A.chunk + k] * x[col[start + j * A.chunk + k]];
-                    y[i * A.chunk + k + 1] += dat[start + j * A.chunk + k + 1] * x[col[start + j * A.chunk + k + 1]];
-                    y[i * A.chunk + k + 2] += dat[start + j * A.chunk + k + 2] * x[col[start + j * A.chunk + k + 2]];
-                    y[i * A.chunk + k + 3] += dat[start + j * A.chunk + k + 3] * x[col[start + j * A.chunk + k + 3]];
-                }
-                for (; k < size; ++k) {
-                    y[i * A.chunk + k] += dat[start + j * A.chunk + k] * x[col[start + j * A.chunk + k]];
-                }
-            }
-        }
+inline void pfspmv(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A,
+                   typename Field::ConstElement_ptr x, typename Field::Element_ptr y, FieldCategories::GenericTag) {
+    sell_parallel_chunks(A, [&](index_t ibeg, index_t iend) {
+        fspmv_chunks(F, A, ibeg, iend, x, y, FieldCategories::GenericTag());
     });
-#else
-#pragma omp parallel for
-    for (index_t i = 0; i < A.nChunks; ++i) {
-        index_t start = st[i];
-        index_t size = chunkSize[i];
-        for (index_t j = 0; j < size; ++j) {
-            size_t k = 0;
-            for (; k < ROUND_DOWN(A.chunk, 4); k += 4) {
-                y[i * A.chunk + k] += dat[start + j * A.chunk + k] * x[col[start + j * A.chunk + k]];
-                y[i * A.chunk + k + 1] += dat[start + j * A.chunk + k + 1] * x[col[start + j * A.chunk + k + 1]];
-                y[i * A.chunk + k + 2] += dat[start + j * A.chunk + k + 2] * x[col[start + j * A.chunk + k + 2]];
-                y[i * A.chunk + k + 3] += dat[start + j * A.chunk + k + 3] * x[col[start + j * A.chunk + k + 3]];
-            }
-            for (; k < size; ++k) {
-                y[i * A.chunk + k] += dat[start + j * A.chunk + k] * x[col[start + j * A.chunk + k]];
-            }
-        }
-    }
-#endif // TBB
 }
 
-#ifdef __FFLASFFPACK_USE_SIMD
 template <class Field>
-inline void pfspmv_simd(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A,
-                        typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_, const int64_t kmax) {
-    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(chunkSize, A.chunkSize, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(dat, A.dat, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
-    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
-    index_t chunk = A.chunk;
-    using simd = Simd<typename Field::Element>;
-    using vect_t = typename simd::vect_t;
-
-    vect_t X, Y, D, C, Q, TMP, NEGP, INVP, MIN, MAX, P;
-    double p = (typename Field::Element)F.characteristic();
-
-    P = simd::set1(p);
-    NEGP = simd::set1(-p);
-    INVP = simd::set1(1 / p);
-    MIN = simd::set1(F.minElement());
-    MAX = simd::set1(F.maxElement());
-
-#ifdef __FFLASFFPACK_USE_TBB
-    tbb::parallel_for(tbb::blocked_range<index_t>(0, A.nbChunks, 2),
-                      [&F, &A, x, y, st, col, dat, chunkSize](const tbb::blocked_range<index_t> &r) {
-        for (index_t i = r.begin(), end = r.end(); i < end; ++i) {
-            index_t j = 0;
-            index_t j_loc = 0;
-            Y = simd::load(y + i * A.chunk);
-            index_t size = chunkSize[i];
-            index_t start = st[i];
-            index_t block = size / kmax;
-            for (size_t l = 0; l < block; ++l) {
-                j_loc += kmax;
-                for (; j < j_loc; ++j) {
-                    D = simd::load(dat + start + j * A.chunk);
-                    X = simd::gather(x, col + start + j * A.chunk);
-                    Y = simd::fmadd(Y, D, X);
-                }
-                simd::mod(Y, P, INVP, NEGP, MIN, MAX, Q, TMP);
-            }
-            for (; j < size; ++j) {
-                D = simd::load(dat + start + j * A.chunk);
-                X = simd::gather(x, col + start + j * A.chunk);
-                Y = simd::fmadd(Y, D, X);
-            }
-            simd::mod(Y, P, INVP, NEGP, MIN, MAX, Q, TMP);
-            simd::store(y + i * A.chunk, Y);
-        }
+inline void pfspmv(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A,
+                   typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
+                   FieldCategories::UnparametricTag) {
+    sell_parallel_chunks(A, [&](index_t ibeg, index_t iend) {
+        fspmv_chunks(F, A, ibeg, iend, x, y, FieldCategories::UnparametricTag());
     });
-#else
-#pragma omp parallel for
-    for (size_t i = 0; i < A.nChunks; ++i) {
-        index_t j = 0;
-        index_t j_loc = 0;
-        Y = simd::load(y + i * A.chunk);
-        index_t size = chunkSize[i];
-        index_t start = st[i];
-        index_t block = size / kmax;
-        for (size_t l = 0; l < block; ++l) {
-            j_loc += kmax;
-            for (; j < j_loc; ++j) {
-                D = simd::load(dat + start + j * A.chunk);
-                X = simd::gather(x, col + start + j * A.chunk);
-                Y = simd::fmadd(Y, D, X);
-            }
-            simd::mod(Y, P, INVP, NEGP, MIN, MAX, Q, TMP);
-        }
-        for (; j < size; ++j) {
-            D = simd::load(dat + start + j * A.chunk);
-            X = simd::gather(x, col + start + j * A.chunk);
-            Y = simd::fmadd(Y, D, X);
-        }
-        simd::mod(Y, P, INVP, NEGP, MIN, MAX, Q, TMP);
-        simd::store(y + i * A.chunk, Y);
-    }
-#endif // TBB
 }
 
-#endif // SIMD
+template <class Field>
+inline void pfspmv(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A,
+                   typename Field::ConstElement_ptr x, typename Field::Element_ptr y, const uint64_t kmax) {
+    sell_parallel_chunks(A, [&](index_t ibeg, index_t iend) { fspmv_chunks(F, A, ibeg, iend, x, y, kmax); });
+}
 
 template <class Field>
-inline void pfspmv(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, typename Field::ConstElement_ptr x_,
-                   typename Field::Element_ptr y_, const int64_t kmax) {
-    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(chunkSize, A.chunkSize, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(dat, A.dat, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
-    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
-    index_t chunk = A.chunk;
-#ifdef __FFLASFFPACK_USE_TBB
-    tbb::parallel_for(tbb::blocked_range<index_t>(0, A.nbChunks, 2),
-                      [&F, &A, &x, &y, st, col, dat, chunkSize](const tbb::blocked_range<index_t> &r) {
-        for (index_t i = r.begin(), end = r.end(); i < end; ++i) {
-            index_t j = 0;
-            index_t j_loc = 0;
-            index_t size = chunkSize[i];
-            index_t start = st[i];
-            index_t block = size / kmax;
-            for (size_t l = 0; l < block; ++l) {
-                j_loc += kmax;
-                for (; j < j_loc; ++j) {
-                    size_t k = 0;
-                    for (; k < ROUND_DOWN(A.chunk, 4); k += 4) {
-                        y[i * A.chunk + k] += dat[start + j * A.chunk + k] * x[col[start + j * A.chunk + k]];
-                        y[i * A.chunk + k + 1] +=
-                            dat[start + j * A.chunk + k + 1] * x[col[start + j * A.chunk + k + 1]];
-                        y[i * A.chunk + k + 2] +=
-                            dat[start + j * A.chunk + k + 2] * x[col[start + j * A.chunk + k + 2]];
-                        y[i * A.chunk + k + 3] +=
-                            dat[start + j * A.chunk + k + 3] * x[col[start + j * A.chunk + k + 3]];
-                    }
-                    for (; k < size; ++k) {
-                        y[i * A.chunk + k] += dat[start + j * A.chunk + k] * x[col[start + j * A.chunk + k]];
-                    }
-                }
-                for (size_t k = 0; k < size; ++k) {
-                    F.reduce(y[i * A.chunk + k]);
-                }
-            }
-            for (; j < size; ++j) {
-                size_t k = 0;
-                for (; k < ROUND_DOWN(A.chunk, 4); k += 4) {
-                    y[i * A.chunk + k] += dat[start + j * A.chunk + k] * x[col[start + j * A.chunk + k]];
-                    y[i * A.chunk + k + 1] += dat[start + j * A.chunk + k + 1] * x[col[start + j * A.chunk + k + 1]];
-                    y[i * A.chunk + k + 2] += dat[start + j * A.chunk + k + 2] * x[col[start + j * A.chunk + k + 2]];
-                    y[i * A.chunk + k + 3] += dat[start + j * A.chunk + k + 3] * x[col[start + j * A.chunk + k + 3]];
-                }
-                for (; k < size; ++k) {
-                    y[i * A.chunk + k] += dat[start + j * A.chunk + k] * x[col[start + j * A.chunk + k]];
-                }
-            }
-            for (size_t k = 0; k < size; ++k) {
-                F.reduce(y[i * A.chunk + k]);
-            }
-        }
+inline void pfspmv_simd(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A,
+                        typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
+                        FieldCategories::UnparametricTag) {
+    sell_parallel_chunks(A, [&](index_t ibeg, index_t iend) {
+        fspmv_simd_chunks(F, A, ibeg, iend, x, y, FieldCategories::UnparametricTag());
     });
-
-#else
-#pragma omp parallel for
-    for (size_t i = 0; i < A.nChunks; ++i) {
-        index_t j = 0;
-        index_t j_loc = 0;
-        index_t size = chunkSize[i];
-        index_t start = st[i];
-        index_t block = size / kmax;
-        for (size_t l = 0; l < block; ++l) {
-            j_loc += kmax;
-            for (; j < j_loc; ++j) {
-                size_t k = 0;
-                for (; k < ROUND_DOWN(A.chunk, 4); k += 4) {
-                    y[i * A.chunk + k] += dat[start + j * A.chunk + k] * x[col[start + j * A.chunk + k]];
-                    y[i * A.chunk + k + 1] += dat[start + j * A.chunk + k + 1] * x[col[start + j * A.chunk + k + 1]];
-                    y[i * A.chunk + k + 2] += dat[start + j * A.chunk + k + 2] * x[col[start + j * A.chunk + k + 2]];
-                    y[i * A.chunk + k + 3] += dat[start + j * A.chunk + k + 3] * x[col[start + j * A.chunk + k + 3]];
-                }
-                for (; k < size; ++k) {
-                    y[i * A.chunk + k] += dat[start + j * A.chunk + k] * x[col[start + j * A.chunk + k]];
-                }
-            }
-            for (size_t k = 0; k < size; ++k) {
-                F.reduce(y[i * A.chunk + k]);
-            }
-        }
-        for (; j < size; ++j) {
-            size_t k = 0;
-            for (; k < ROUND_DOWN(A.chunk, 4); k += 4) {
-                y[i * A.chunk + k] += dat[start + j * A.chunk + k] * x[col[start + j * A.chunk + k]];
-                y[i * A.chunk + k + 1] += dat[start + j * A.chunk + k + 1] * x[col[start + j * A.chunk + k + 1]];
-                y[i * A.chunk + k + 2] += dat[start + j * A.chunk + k + 2] * x[col[start + j * A.chunk + k + 2]];
-                y[i * A.chunk + k + 3] += dat[start + j * A.chunk + k + 3] * x[col[start + j * A.chunk + k + 3]];
-            }
-            for (; k < size; ++k) {
-                y[i * A.chunk + k] += dat[start + j * A.chunk + k] * x[col[start + j * A.chunk + k]];
-            }
-        }
-        for (size_t k = 0; k < size; ++k) {
-            F.reduce(y[i * A.chunk + k]);
-        }
-    }
-#endif // TBB
 }
 
 template <class Field>
+inline void pfspmv_simd(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A,
+                        typename Field::ConstElement_ptr x, typename Field::Element_ptr y, const uint64_t kmax) {
+    sell_parallel_chunks(A, [&](index_t ibeg, index_t iend) { fspmv_simd_chunks(F, A, ibeg, iend, x, y, kmax); });
+}
+
+template <class Field, class FieldCat>
 inline void pfspmv_one(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A,
-                       typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
-                       FieldCategories::GenericTag) {
-    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(chunkSize, A.chunkSize, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
-    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
-#ifdef __FFLASFFPACK_USE_TBB
-    tbb::parallel_for(tbb::blocked_range<index_t>(0, A.nbChunks, 2),
-                      [&F, &A, x, y, st, col, chunkSize](const tbb::blocked_range<index_t> &r) {
-        for (index_t i = r.begin(), end = r.end(); i < end; ++i) {
-            index_t start = st[i];
-            index_t size = chunkSize[i];
-            index_t j = 0;
-            for (; j < size; j++) {
-                for (index_t k = 0; k < A.chunk; ++k) {
-                    F.addin(y[i * A.chunk + k], x[col[start + j * A.chunk + k]]);
-                }
-            }
-        }
-    });
-#else
-#pragma omp parallel for
-    for (index_t i = 0; i < A.nChunks; ++i) {
-        index_t start = st[i];
-        index_t size = chunkSize[i];
-        index_t j = 0;
-        for (; j < size; j++) {
-            for (index_t k = 0; k < A.chunk; ++k) {
-                F.addin(y[i * A.chunk + k], x[col[start + j * A.chunk + k]]);
-            }
-        }
-    }
-#endif
+                       typename Field::ConstElement_ptr x, typename Field::Element_ptr y, FieldCat tag) {
+    typename Field::Element_ptr x1 = sparse_details::zo_padded_input(F, A, 1, x, 1);
+    typename Field::ConstElement_ptr xx = x1 ? x1 : x;
+    sell_parallel_chunks(A, [&](index_t ibeg, index_t iend) { fspmv_one_chunks(F, A, ibeg, iend, xx, y, tag); });
+    fflas_delete(x1);
 }
 
-template <class Field>
+template <class Field, class FieldCat>
 inline void pfspmv_mone(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A,
-                        typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
-                        FieldCategories::GenericTag) {
-    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(chunkSize, A.chunkSize, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
-    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
-#ifdef __FFLASFFPACK_USE_TBB
-    tbb::parallel_for(tbb::blocked_range<index_t>(0, A.nbChunks, 2),
-                      [&F, &A, x, y, st, col, chunkSize](const tbb::blocked_range<index_t> &r) {
-        for (index_t i = r.begin(), end = r.end(); i < end; ++i) {
-            index_t start = st[i];
-            index_t size = chunkSize[i];
-            index_t j = 0;
-            for (; j < size; j++) {
-                for (index_t k = 0; k < A.chunk; ++k) {
-                    F.subin(y[i * A.chunk + k], x[col[start + j * A.chunk + k]]);
-                }
-            }
-        }
-    });
-#else
-#pragma omp parallel for
-    for (index_t i = 0; i < A.nChunks; ++i) {
-        index_t start = st[i];
-        index_t size = chunkSize[i];
-        index_t j = 0;
-        for (; j < size; j++) {
-            for (index_t k = 0; k < A.chunk; ++k) {
-                F.subin(y[i * A.chunk + k], x[col[start + j * A.chunk + k]]);
-            }
-        }
-    }
-#endif
+                        typename Field::ConstElement_ptr x, typename Field::Element_ptr y, FieldCat tag) {
+    typename Field::Element_ptr x1 = sparse_details::zo_padded_input(F, A, 1, x, 1);
+    typename Field::ConstElement_ptr xx = x1 ? x1 : x;
+    sell_parallel_chunks(A, [&](index_t ibeg, index_t iend) { fspmv_mone_chunks(F, A, ibeg, iend, xx, y, tag); });
+    fflas_delete(x1);
 }
 
-#ifdef __FFLASFFPACK_USE_SIMD
-
 template <class Field>
 inline void pfspmv_one_simd(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A,
-                            typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
+                            typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
                             FieldCategories::UnparametricTag) {
-    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(chunkSize, A.chunkSize, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
-    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
-    using simd = Simd<typename Field::Element>;
-    using vect_t = typename simd::vect_t;
-#ifdef __FFLASFFPACK_USE_TBB
-    tbb::parallel_for(tbb::blocked_range<index_t>(0, A.nbChunks, 2),
-                      [&F, &A, x, y, st, col, chunkSize](const tbb::blocked_range<index_t> &r) {
-        for (index_t i = r.begin(), end = r.end(); i < end; ++i) {
-            index_t start = st[i];
-            index_t size = chunkSize[i];
-            vect_t x1, x2, y1, y2;
-            y1 = simd::zero();
-            y2 = simd::zero();
-            index_t j = 0;
-            for (; j < ROUND_DOWN(size, 2); j += 2) {
-                x1 = simd::gather(x, col + start + j * A.chunk);
-                x2 = simd::gather(x, col + start + (j + 1) * A.chunk);
-                y1 = simd::add(y1, x1);
-                y2 = simd::add(y2, x2);
-            }
-            if (size % 2 != 0) {
-                x1 = simd::gather(x, col + start + j * A.chunk);
-                y1 = simd::add(y1, x1);
-            }
-            simd::store(y + i * A.chunk, simd::add(simd::load(y + i * A.chunk), simd::add(y1, y2)));
-        }
+    typename Field::Element_ptr x1 = sparse_details::zo_padded_input(F, A, 1, x, 1);
+    typename Field::ConstElement_ptr xx = x1 ? x1 : x;
+    sell_parallel_chunks(A, [&](index_t ibeg, index_t iend) {
+        fspmv_zo_simd_chunks<Field, true>(F, A, ibeg, iend, xx, y);
     });
-#else
-#pragma omp parallel for
-    for (index_t i = 0; i < A.nChunks; ++i) {
-        index_t start = st[i];
-        index_t size = chunkSize[i];
-        vect_t x1, x2, y1, y2;
-        y1 = simd::zero();
-        y2 = simd::zero();
-        index_t j = 0;
-        for (; j < ROUND_DOWN(size, 2); j += 2) {
-            x1 = simd::gather(x, col + start + j * A.chunk);
-            x2 = simd::gather(x, col + start + (j + 1) * A.chunk);
-            y1 = simd::add(y1, x1);
-            y2 = simd::add(y2, x2);
-        }
-        if (size % 2 != 0) {
-            x1 = simd::gather(x, col + start + j * A.chunk);
-            y1 = simd::add(y1, x1);
-        }
-        simd::store(y + i * A.chunk, simd::add(simd::load(y + i * A.chunk), simd::add(y1, y2)));
-    }
-#endif // TBB
+    fflas_delete(x1);
 }
 
 template <class Field>
 inline void pfspmv_mone_simd(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A,
-                             typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
+                             typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
                              FieldCategories::UnparametricTag) {
-    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(chunkSize, A.chunkSize, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
-    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
-    using simd = Simd<typename Field::Element>;
-    using vect_t = typename simd::vect_t;
-#ifdef __FFLASFFPACK_USE_TBB
-    tbb::parallel_for(tbb::blocked_range<index_t>(0, A.nbChunks, 2),
-                      [&F, &A, x, y, st, col, chunkSize](const tbb::blocked_range<index_t> &r) {
-        for (index_t i = r.begin(), end = r.end(); i < end; ++i) {
-            index_t start = st[i];
-            index_t size = chunkSize[i];
-            vect_t x1, x2, y1, y2;
-            y1 = simd::zero();
-            y2 = simd::zero();
-            index_t j = 0;
-            for (; j < ROUND_DOWN(size, 2); j += 2) {
-                x1 = simd::gather(x, col + start + j * A.chunk);
-                x2 = simd::gather(x, col + start + (j + 1) * A.chunk);
-                y1 = simd::add(y1, x1);
-                y2 = simd::add(y2, x2);
-            }
-            if (size % 2 != 0) {
-                x1 = simd::gather(x, col + start + j * A.chunk);
-                y1 = simd::add(y1, x1);
-            }
-            simd::store(y + i * A.chunk, simd::sub(simd::load(y + i * A.chunk), simd::add(y1, y2)));
-        }
+    typename Field::Element_ptr x1 = sparse_details::zo_padded_input(F, A, 1, x, 1);
+    typename Field::ConstElement_ptr xx = x1 ? x1 : x;
+    sell_parallel_chunks(A, [&](index_t ibeg, index_t iend) {
+        fspmv_zo_simd_chunks<Field, false>(F, A, ibeg, iend, xx, y);
     });
-#else
-#pragma omp parallel for
-    for (index_t i = 0; i < A.nChunks; ++i) {
-        index_t start = st[i];
-        index_t size = chunkSize[i];
-        vect_t x1, x2, y1, y2;
-        y1 = simd::zero();
-        y2 = simd::zero();
-        index_t j = 0;
-        for (; j < ROUND_DOWN(size, 2); j += 2) {
-            x1 = simd::gather(x, col + start + j * A.chunk);
-            x2 = simd::gather(x, col + start + (j + 1) * A.chunk);
-            y1 = simd::add(y1, x1);
-            y2 = simd::add(y2, x2);
-        }
-        if (size % 2 != 0) {
-            x1 = simd::gather(x, col + start + j * A.chunk);
-            y1 = simd::add(y1, x1);
-        }
-        simd::store(y + i * A.chunk, simd::sub(simd::load(y + i * A.chunk), simd::add(y1, y2)));
-    }
-#endif // TBB
+    fflas_delete(x1);
 }
 
-#endif // SIMD
-
-template <class Field>
-inline void pfspmv_one(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A,
-                       typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
-                       FieldCategories::UnparametricTag) {
-    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(chunkSize, A.chunkSize, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
-    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
-#ifdef __FFLASFFPACK_USE_TBB
-    tbb::parallel_for(tbb::blocked_range<index_t>(0, A.nbChunks, 2),
-                      [&F, &A, x, y, st, col, chunkSize](const tbb::blocked_range<index_t> &r) {
-        for (index_t i = r.begin(), end = r.end(); i < end; ++i) {
-            index_t start = st[i];
-            index_t size = chunkSize[i];
-            for (index_t j = 0; j < size; j++) {
-                size_t k = 0;
-                for (; k < ROUND_DOWN(A.chunk, 4); k += 4) {
-                    y[i * A.chunk + k] += x[col[start + j * A.chunk + k]];
-                    y[i * A.chunk + k + 1] += x[col[start + j * A.chunk + k + 1]];
-                    y[i * A.chunk + k + 2] += x[col[start + j * A.chunk + k + 2]];
-                    y[i * A.chunk + k + 3] += x[col[start + j * A.chunk + k + 3]];
-                }
-                for (; k < size; ++k) {
-                    y[i * A.chunk + k] += x[col[start + j * A.chunk + k]];
-                }
-            }
+/* The transposed product scatters the rows of A into y: each thread adds its
+ * range of chunks to its own copy of y, and the copies are then summed into y
+ * by ranges of entries.
+ */
+template <class Field, class SM>
+inline void sell_pfspmv_transpose(const Field &F, const SM &A, typename Field::ConstElement_ptr x,
+                                  typename Field::Element_ptr y) {
+    const size_t nt = std::min<size_t>(MAX_THREADS, A.nChunks);
+    if (nt <= 1) {
+        fspmv_transpose_chunks(F, A, 0, A.nChunks, x, y, FieldCategories::GenericTag());
+        return;
+    }
+    typename Field::Element_ptr yt = fflas_new(F, nt * A.n, 1, Alignment::CACHE_LINE);
+    const ParSeqHelper::Parallel<CuttingStrategy::Block, StrategyParameter::Threads> psh(nt);
+    Protected::pforblock1d_static(nt, psh, [&](size_t tb, size_t te) {
+        for (size_t t = tb; t < te; ++t) {
+            fzero(F, A.n, yt + t * A.n, 1);
+            fspmv_transpose_chunks(F, A, sell_chunk_split(A, t, nt), sell_chunk_split(A, t + 1, nt), x,
+                                   yt + t * A.n, FieldCategories::GenericTag());
         }
     });
-#else
-#pragma omp parallel for
-    for (index_t i = 0; i < A.nChunks; ++i) {
-        index_t start = st[i];
-        index_t size = chunkSize[i];
-        for (index_t j = 0; j < size; j++) {
-            size_t k = 0;
-            for (; k < ROUND_DOWN(A.chunk, 4); k += 4) {
-                y[i * A.chunk + k] += x[col[start + j * A.chunk + k]];
-                y[i * A.chunk + k + 1] += x[col[start + j * A.chunk + k + 1]];
-                y[i * A.chunk + k + 2] += x[col[start + j * A.chunk + k + 2]];
-                y[i * A.chunk + k + 3] += x[col[start + j * A.chunk + k + 3]];
-            }
-            for (; k < size; ++k) {
-                y[i * A.chunk + k] += x[col[start + j * A.chunk + k]];
-            }
-        }
-    }
-#endif // TBB
+    Protected::pforblock1d_static(A.n, psh, [&](size_t cb, size_t ce) {
+        for (size_t t = 0; t < nt; ++t)
+            for (size_t c = cb; c < ce; ++c)
+                F.addin(y[c], yt[t * A.n + c]);
+    });
+    fflas_delete(yt);
 }
 
 template <class Field>
-inline void pfspmv_mone(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A,
-                        typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
-                        FieldCategories::UnparametricTag) {
-    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(chunkSize, A.chunkSize, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
-    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
-#ifdef __FFLASFFPACK_USE_TBB
-    tbb::parallel_for(tbb::blocked_range<index_t>(0, A.nbChunks, 2),
-                      [&F, &A, x, y, st, col, chunkSize](const tbb::blocked_range<index_t> &r) {
-        for (index_t i = r.begin(), end = r.end(); i < end; ++i) {
-            index_t start = st[i];
-            index_t size = chunkSize[i];
-            for (index_t j = 0; j < size; j++) {
-                size_t k = 0;
-                for (; k < ROUND_DOWN(A.chunk, 4); k += 4) {
-                    y[i * A.chunk + k] -= x[col[start + j * A.chunk + k]];
-                    y[i * A.chunk + k + 1] -= x[col[start + j * A.chunk + k + 1]];
-                    y[i * A.chunk + k + 2] -= x[col[start + j * A.chunk + k + 2]];
-                    y[i * A.chunk + k + 3] -= x[col[start + j * A.chunk + k + 3]];
-                }
-                for (; k < size; ++k) {
-                    y[i * A.chunk + k] -= x[col[start + j * A.chunk + k]];
-                }
-            }
-        }
-    });
-#else
-#pragma omp parallel for
-    for (index_t i = 0; i < A.nChunks; ++i) {
-        index_t start = st[i];
-        index_t size = chunkSize[i];
-        for (index_t j = 0; j < size; j++) {
-            size_t k = 0;
-            for (; k < ROUND_DOWN(A.chunk, 4); k += 4) {
-                y[i * A.chunk + k] -= x[col[start + j * A.chunk + k]];
-                y[i * A.chunk + k + 1] -= x[col[start + j * A.chunk + k + 1]];
-                y[i * A.chunk + k + 2] -= x[col[start + j * A.chunk + k + 2]];
-                y[i * A.chunk + k + 3] -= x[col[start + j * A.chunk + k + 3]];
-            }
-            for (; k < size; ++k) {
-                y[i * A.chunk + k] -= x[col[start + j * A.chunk + k]];
-            }
-        }
-    }
-#endif // TBB
+inline void pfspmv_transpose(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A,
+                             typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
+                             FieldCategories::GenericTag) {
+    sell_pfspmv_transpose(F, A, x, y);
+}
+
+template <class Field>
+inline void pfspmv_transpose(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A,
+                             typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
+                             FieldCategories::GenericTag) {
+    sell_pfspmv_transpose(F, A, x, y);
 }
 
-} // SELL_details
+} // sparse_details_impl
 
 } // FFLAS
 
-#endif //  __FFLASFFPACK_fflas_SELL_spmv_INL
\ No newline at end of file
+#endif // __FFLASFFPACK_fflas_sparse_SELL_pspmv_INL
@@ -0,0 +1,334 @@
+/* -*- mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+// vim:sts=4:sw=4:ts=4:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/*
+ * Copyright (C) 2016 the FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ * ========LICENCE========
+ *.
+ */
+
+#ifndef __FFLASFFPACK_fflas_sparse_SELL_spmm_INL
+#define __FFLASFFPACK_fflas_sparse_SELL_spmm_INL
+
+namespace FFLAS {
+namespace sparse_details_impl {
+
+// Y += A X on the chunks ibeg..iend-1, slot k of chunk i writing row A.perm[i * A.chunk + k] of Y
+template <class Field>
+inline void fspmm_chunks(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, index_t ibeg, index_t iend,
+                         size_t blockSize, typename Field::ConstElement_ptr x_, int ldx, typename Field::Element_ptr y_,
+                         int ldy, FieldCategories::GenericTag) {
+    assume_aligned(dat, A.dat, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
+    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
+    for (index_t i = ibeg; i < iend; ++i) {
+        const index_t r = sell_chunk_rows(A, i);
+        const uint64_t start = A.st[i];
+        for (index_t j = 0; j < A.chunkSize[i]; ++j)
+            for (index_t k = 0; k < r; ++k) {
+                const uint64_t e = start + j * A.chunk + k;
+                for (size_t b = 0; b < blockSize; ++b)
+                    F.axpyin(y[A.perm[i * A.chunk + k] * ldy + b], dat[e], x[col[e] * ldx + b]);
+            }
+    }
+}
+
+template <class Field>
+inline void fspmm_chunks(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, index_t ibeg, index_t iend,
+                         size_t blockSize, typename Field::ConstElement_ptr x_, int ldx, typename Field::Element_ptr y_,
+                         int ldy, FieldCategories::UnparametricTag) {
+    assume_aligned(dat, A.dat, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
+    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
+    for (index_t i = ibeg; i < iend; ++i) {
+        const index_t r = sell_chunk_rows(A, i);
+        const uint64_t start = A.st[i];
+        for (index_t j = 0; j < A.chunkSize[i]; ++j)
+            for (index_t k = 0; k < r; ++k) {
+                const uint64_t e = start + j * A.chunk + k;
+                const typename Field::Element d = dat[e];
+                typename Field::ConstElement_ptr xj = x + col[e] * ldx;
+                typename Field::Element_ptr yi = y + A.perm[i * A.chunk + k] * ldy;
+                for (size_t b = 0; b < blockSize; ++b)
+                    yi[b] += d * xj[b];
+            }
+    }
+}
+
+template <class Field>
+inline void fspmm_chunks(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, index_t ibeg, index_t iend,
+                         size_t blockSize, typename Field::ConstElement_ptr x_, int ldx, typename Field::Element_ptr y_,
+                         int ldy, const uint64_t kmax) {
+    assume_aligned(dat, A.dat, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
+    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
+    const index_t km = (index_t)std::max<uint64_t>(1, std::min<uint64_t>(kmax, A.maxrow));
+    for (index_t i = ibeg; i < iend; ++i) {
+        const index_t r = sell_chunk_rows(A, i);
+        const uint64_t start = A.st[i];
+        for (index_t j = 0; j < A.chunkSize[i]; j += km) {
+            const index_t jend = std::min<index_t>(A.chunkSize[i], j + km);
+            for (index_t jj = j; jj < jend; ++jj)
+                for (index_t k = 0; k < r; ++k) {
+                    const uint64_t e = start + jj * A.chunk + k;
+                    const typename Field::Element d = dat[e];
+                    typename Field::ConstElement_ptr xj = x + col[e] * ldx;
+                    typename Field::Element_ptr yi = y + A.perm[i * A.chunk + k] * ldy;
+                    for (size_t b = 0; b < blockSize; ++b)
+                        yi[b] += d * xj[b];
+                }
+            for (index_t k = 0; k < r; ++k)
+                freduce(F, blockSize, y + A.perm[i * A.chunk + k] * ldy, 1);
+        }
+    }
+}
+
+template <class Field>
+inline void fspmm(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, size_t blockSize,
+                  typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                  FieldCategories::GenericTag) {
+    fspmm_chunks(F, A, 0, A.nChunks, blockSize, x, ldx, y, ldy, FieldCategories::GenericTag());
+}
+
+template <class Field>
+inline void fspmm(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, size_t blockSize,
+                  typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                  FieldCategories::UnparametricTag) {
+    fspmm_chunks(F, A, 0, A.nChunks, blockSize, x, ldx, y, ldy, FieldCategories::UnparametricTag());
+}
+
+template <class Field>
+inline void fspmm(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, size_t blockSize,
+                  typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                  const uint64_t kmax) {
+    fspmm_chunks(F, A, 0, A.nChunks, blockSize, x, ldx, y, ldy, kmax);
+}
+
+/* The loop over the block is contiguous in X and Y and left to the compiler
+ * vectorizer: the simd entry points of the dispatch forward to it.
+ */
+template <class Field>
+inline void fspmm_simd_aligned(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, size_t blockSize,
+                               typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                               FieldCategories::UnparametricTag) {
+    fspmm(F, A, blockSize, x, ldx, y, ldy, FieldCategories::UnparametricTag());
+}
+
+template <class Field>
+inline void fspmm_simd_unaligned(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, size_t blockSize,
+                                 typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                                 FieldCategories::UnparametricTag) {
+    fspmm(F, A, blockSize, x, ldx, y, ldy, FieldCategories::UnparametricTag());
+}
+
+template <class Field>
+inline void fspmm_simd_aligned(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, size_t blockSize,
+                               typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                               const uint64_t kmax) {
+    fspmm(F, A, blockSize, x, ldx, y, ldy, kmax);
+}
+
+template <class Field>
+inline void fspmm_simd_unaligned(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, size_t blockSize,
+                                 typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                                 const uint64_t kmax) {
+    fspmm(F, A, blockSize, x, ldx, y, ldy, kmax);
+}
+
+// X has a zero row at index A.n for the padding entries
+template <class Field>
+inline void fspmm_zo_chunks(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A, index_t ibeg,
+                            index_t iend, size_t blockSize, typename Field::ConstElement_ptr x_, int ldx,
+                            typename Field::Element_ptr y_, int ldy, bool one, FieldCategories::GenericTag) {
+    assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
+    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
+    for (index_t i = ibeg; i < iend; ++i) {
+        const index_t r = sell_chunk_rows(A, i);
+        const uint64_t start = A.st[i];
+        for (index_t j = 0; j < A.chunkSize[i]; ++j)
+            for (index_t k = 0; k < r; ++k) {
+                typename Field::ConstElement_ptr xj = x + col[start + j * A.chunk + k] * ldx;
+                typename Field::Element_ptr yi = y + A.perm[i * A.chunk + k] * ldy;
+                if (one)
+                    for (size_t b = 0; b < blockSize; ++b)
+                        F.addin(yi[b], xj[b]);
+                else
+                    for (size_t b = 0; b < blockSize; ++b)
+                        F.subin(yi[b], xj[b]);
+            }
+    }
+}
+
+template <class Field>
+inline void fspmm_zo_chunks(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A, index_t ibeg,
+                            index_t iend, size_t blockSize, typename Field::ConstElement_ptr x_, int ldx,
+                            typename Field::Element_ptr y_, int ldy, bool one, FieldCategories::UnparametricTag) {
+    assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
+    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
+    for (index_t i = ibeg; i < iend; ++i) {
+        const index_t r = sell_chunk_rows(A, i);
+        const uint64_t start = A.st[i];
+        for (index_t j = 0; j < A.chunkSize[i]; ++j)
+            for (index_t k = 0; k < r; ++k) {
+                typename Field::ConstElement_ptr xj = x + col[start + j * A.chunk + k] * ldx;
+                typename Field::Element_ptr yi = y + A.perm[i * A.chunk + k] * ldy;
+                if (one)
+                    for (size_t b = 0; b < blockSize; ++b)
+                        yi[b] += xj[b];
+                else
+                    for (size_t b = 0; b < blockSize; ++b)
+                        yi[b] -= xj[b];
+            }
+    }
+}
+
+template <class Field, class FieldCat>
+inline void fspmm_one(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A, size_t blockSize,
+                      typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                      FieldCat tag) {
+    typename Field::Element_ptr x1 = sparse_details::zo_padded_input(F, A, blockSize, x, ldx);
+    if (x1)
+        fspmm_zo_chunks(F, A, 0, A.nChunks, blockSize, x1, (int)blockSize, y, ldy, true, tag);
+    else
+        fspmm_zo_chunks(F, A, 0, A.nChunks, blockSize, x, ldx, y, ldy, true, tag);
+    fflas_delete(x1);
+}
+
+template <class Field, class FieldCat>
+inline void fspmm_mone(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A, size_t blockSize,
+                       typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                       FieldCat tag) {
+    typename Field::Element_ptr x1 = sparse_details::zo_padded_input(F, A, blockSize, x, ldx);
+    if (x1)
+        fspmm_zo_chunks(F, A, 0, A.nChunks, blockSize, x1, (int)blockSize, y, ldy, false, tag);
+    else
+        fspmm_zo_chunks(F, A, 0, A.nChunks, blockSize, x, ldx, y, ldy, false, tag);
+    fflas_delete(x1);
+}
+
+template <class Field>
+inline void fspmm_one_simd_aligned(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A,
+                                   size_t blockSize, typename Field::ConstElement_ptr x, int ldx,
+                                   typename Field::Element_ptr y, int ldy, FieldCategories::UnparametricTag) {
+    fspmm_one(F, A, blockSize, x, ldx, y, ldy, FieldCategories::UnparametricTag());
+}
+
+template <class Field>
+inline void fspmm_one_simd_unaligned(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A,
+                                     size_t blockSize, typename Field::ConstElement_ptr x, int ldx,
+                                     typename Field::Element_ptr y, int ldy, FieldCategories::UnparametricTag) {
+    fspmm_one(F, A, blockSize, x, ldx, y, ldy, FieldCategories::UnparametricTag());
+}
+
+template <class Field>
+inline void fspmm_mone_simd_aligned(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A,
+                                    size_t blockSize, typename Field::ConstElement_ptr x, int ldx,
+                                    typename Field::Element_ptr y, int ldy, FieldCategories::UnparametricTag) {
+    fspmm_mone(F, A, blockSize, x, ldx, y, ldy, FieldCategories::UnparametricTag());
+}
+
+template <class Field>
+inline void fspmm_mone_simd_unaligned(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A,
+                                      size_t blockSize, typename Field::ConstElement_ptr x, int ldx,
+                                      typename Field::Element_ptr y, int ldy, FieldCategories::UnparametricTag) {
+    fspmm_mone(F, A, blockSize, x, ldx, y, ldy, FieldCategories::UnparametricTag());
+}
+
+// Y += A^T X on the chunks ibeg..iend-1, by the scatter of fspmv_transpose_chunks
+template <class Field>
+inline void fspmm_transpose_chunks(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, index_t ibeg,
+                                   index_t iend, size_t blockSize, typename Field::ConstElement_ptr x_, int ldx,
+                                   typename Field::Element_ptr y_, int ldy, FieldCategories::GenericTag) {
+    assume_aligned(dat, A.dat, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
+    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
+    for (index_t i = ibeg; i < iend; ++i) {
+        const index_t r = sell_chunk_rows(A, i);
+        const uint64_t start = A.st[i];
+        for (index_t k = 0; k < r; ++k) {
+            typename Field::ConstElement_ptr xk = x + A.perm[i * A.chunk + k] * ldx;
+            for (index_t j = 0; j < A.chunkSize[i]; ++j) {
+                const uint64_t e = start + j * A.chunk + k;
+                if (F.isZero(dat[e]))
+                    continue;
+                typename Field::Element_ptr yc = y + col[e] * ldy;
+                for (size_t b = 0; b < blockSize; ++b)
+                    F.axpyin(yc[b], dat[e], xk[b]);
+            }
+        }
+    }
+}
+
+template <class Field>
+inline void fspmm_transpose_chunks(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A, index_t ibeg,
+                                   index_t iend, size_t blockSize, typename Field::ConstElement_ptr x_, int ldx,
+                                   typename Field::Element_ptr y_, int ldy, FieldCategories::GenericTag) {
+    assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
+    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
+    const bool one = F.isOne(A.cst), mone = F.isMOne(A.cst);
+    for (index_t i = ibeg; i < iend; ++i) {
+        const index_t r = sell_chunk_rows(A, i);
+        const uint64_t start = A.st[i];
+        for (index_t k = 0; k < r; ++k) {
+            typename Field::ConstElement_ptr xk = x + A.perm[i * A.chunk + k] * ldx;
+            for (index_t j = 0; j < A.chunkSize[i]; ++j) {
+                const index_t c = col[start + j * A.chunk + k];
+                if (c == A.n)
+                    break;
+                typename Field::Element_ptr yc = y + c * ldy;
+                if (one)
+                    for (size_t b = 0; b < blockSize; ++b)
+                        F.addin(yc[b], xk[b]);
+                else if (mone)
+                    for (size_t b = 0; b < blockSize; ++b)
+                        F.subin(yc[b], xk[b]);
+                else
+                    for (size_t b = 0; b < blockSize; ++b)
+                        F.axpyin(yc[b], A.cst, xk[b]);
+            }
+        }
+    }
+}
+
+template <class Field>
+inline void fspmm_transpose(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, size_t blockSize,
+                            typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                            FieldCategories::GenericTag) {
+    fspmm_transpose_chunks(F, A, 0, A.nChunks, blockSize, x, ldx, y, ldy, FieldCategories::GenericTag());
+}
+
+template <class Field>
+inline void fspmm_transpose(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A, size_t blockSize,
+                            typename Field::ConstElement_ptr x, int ldx, typename Field::Element_ptr y, int ldy,
+                            FieldCategories::GenericTag) {
+    fspmm_transpose_chunks(F, A, 0, A.nChunks, blockSize, x, ldx, y, ldy, FieldCategories::GenericTag());
+}
+
+} // sparse_details_impl
+
+} // FFLAS
+
+#endif // __FFLASFFPACK_fflas_sparse_SELL_spmm_INL
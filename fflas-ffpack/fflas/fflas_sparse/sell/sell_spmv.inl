@@ -26,371 +26,425 @@
  *.
  */
 
-#ifndef __FFLASFFPACK_fflas_sparse_sell_spmv_INL
-#define __FFLASFFPACK_fflas_sparse_sell_spmv_INL
-
-// #define SELL_DEBUG 1
+#ifndef __FFLASFFPACK_fflas_sparse_SELL_spmv_INL
+#define __FFLASFFPACK_fflas_sparse_SELL_spmv_INL
 
 namespace FFLAS {
 namespace sparse_details_impl {
+
+/* The kernels compute the chunks ibeg..iend-1 of y += A x, the sequential
+ * products taking all the chunks and the parallel ones a range per thread.
+ * Entry k of column j of chunk i is at A.st[i] + j * A.chunk + k and belongs
+ * to row A.perm[i * A.chunk + k]: y is in the order of the rows of A. The
+ * slots of the last chunk beyond A.m are padding and are never written.
+ */
+template <class Field>
+inline index_t sell_chunk_rows(const Sparse<Field, SparseMatrix_t::SELL> &A, index_t i) {
+    return std::min<index_t>((index_t)A.chunk, A.m - i * (index_t)A.chunk);
+}
+
 template <class Field>
-inline void fspmv(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, typename Field::ConstElement_ptr x_,
-                  typename Field::Element_ptr y_, FieldCategories::GenericTag) {
+inline void fspmv_chunks(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, index_t ibeg, index_t iend,
+                         typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
+                         FieldCategories::GenericTag) {
     assume_aligned(dat, A.dat, (size_t)Alignment::CACHE_LINE);
     assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(chunkSize, A.chunkSize, (size_t)Alignment::CACHE_LINE);
     assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
     assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
-    for (index_t i = 0; i < A.nChunks; ++i) {
-        index_t start = st[i];
-        index_t size = chunkSize[i];
-        index_t j = 0;
-        for (; j < size; j++) {
-            for (index_t k = 0; k < A.chunk; ++k) {
-                F.axpyin(y[i * A.chunk + k], dat[start + j * A.chunk + k], x[col[start + j * A.chunk + k]]);
-            }
+    for (index_t i = ibeg; i < iend; ++i) {
+        const index_t r = sell_chunk_rows(A, i);
+        for (index_t k = 0; k < r; ++k) {
+            typename Field::Element &yk = y[A.perm[i * A.chunk + k]];
+            for (index_t j = 0; j < A.chunkSize[i]; ++j)
+                F.axpyin(yk, dat[A.st[i] + j * A.chunk + k], x[col[A.st[i] + j * A.chunk + k]]);
         }
     }
 }
 
-// #ifdef __FFLASFFPACK_USE_SIMD
-
 template <class Field>
-inline void fspmv_simd(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A,
-                       typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
-                       FieldCategories::UnparametricTag) {
+inline void fspmv_chunks(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, index_t ibeg, index_t iend,
+                         typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
+                         FieldCategories::UnparametricTag) {
     assume_aligned(dat, A.dat, (size_t)Alignment::CACHE_LINE);
     assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(chunkSize, A.chunkSize, (size_t)Alignment::CACHE_LINE);
     assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
     assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
-    using simd = Simd<typename Field::Element>;
-    using vect_t = typename simd::vect_t;
-    for (index_t i = 0; i < A.nChunks; ++i) {
-        index_t start = st[i];
-        index_t size = chunkSize[i];
-        vect_t x1, x2, y1, y2, dat1, dat2;
-        y1 = simd::zero();
-        y2 = simd::zero();
-        index_t j = 0;
-        for (; j < ROUND_DOWN(size, 2); j += 2) {
-            dat1 = simd::load(dat + start + j * A.chunk);
-            dat2 = simd::load(dat + start + (j + 1) * A.chunk);
-            x1 = simd::gather(x, col + start + j * A.chunk);
-            x2 = simd::gather(x, col + start + (j + 1) * A.chunk);
-            y1 = simd::fmadd(y1, dat1, x1);
-            y2 = simd::fmadd(y2, dat2, x2);
+    for (index_t i = ibeg; i < iend; ++i) {
+        const index_t r = sell_chunk_rows(A, i);
+        for (index_t k = 0; k < r; ++k) {
+            typename Field::Element yk = 0;
+            for (index_t j = 0; j < A.chunkSize[i]; ++j)
+                yk += dat[A.st[i] + j * A.chunk + k] * x[col[A.st[i] + j * A.chunk + k]];
+            y[A.perm[i * A.chunk + k]] += yk;
         }
-        if (size % 2 != 0) {
-            dat1 = simd::load(dat + start + j * A.chunk);
-            x1 = simd::gather(x, col + start + j * A.chunk);
-            y1 = simd::fmadd(y1, dat1, x1);
-        }
-        simd::store(y + i * A.chunk, simd::add(simd::load(y + i * A.chunk), simd::add(y1, y2)));
     }
 }
 
-// #endif
-
+// a row is reduced after each group of kmax entries
 template <class Field>
-inline void fspmv(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, typename Field::ConstElement_ptr x_,
-                  typename Field::Element_ptr y_, FieldCategories::UnparametricTag) {
+inline void fspmv_chunks(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, index_t ibeg, index_t iend,
+                         typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_, const uint64_t kmax) {
     assume_aligned(dat, A.dat, (size_t)Alignment::CACHE_LINE);
     assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(chunkSize, A.chunkSize, (size_t)Alignment::CACHE_LINE);
     assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
     assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
-    for (index_t i = 0; i < A.nChunks; ++i) {
-        index_t start = st[i];
-        index_t size = chunkSize[i];
-        for (index_t j = 0; j < size; ++j) {
-            size_t k = 0;
-            for (; k < ROUND_DOWN(A.chunk, 4); k += 4) {
-                y[i * A.chunk + k] += dat[start + j * A.chunk + k] * x[col[start + j * A.chunk + k]];
-                y[i * A.chunk + k + 1] += dat[start + j * A.chunk + k + 1] * x[col[start + j * A.chunk + k + 1]];
-                y[i * A.chunk + k + 2] += dat[start + j * A.chunk + k + 2] * x[col[start + j * A.chunk + k + 2]];
-                y[i * A.chunk + k + 3] += dat[start + j * A.chunk + k + 3] * x[col[start + j * A.chunk + k + 3]];
-            }
-            for (; k < size; ++k) {
-                y[i * A.chunk + k] += dat[start + j * A.chunk + k] * x[col[start + j * A.chunk + k]];
+    const index_t km = (index_t)std::max<uint64_t>(1, std::min<uint64_t>(kmax, A.maxrow));
+    for (index_t i = ibeg; i < iend; ++i) {
+        const index_t r = sell_chunk_rows(A, i);
+        for (index_t k = 0; k < r; ++k) {
+            typename Field::Element &yk = y[A.perm[i * A.chunk + k]];
+            for (index_t j = 0; j < A.chunkSize[i]; j += km) {
+                const index_t jend = std::min<index_t>(A.chunkSize[i], j + km);
+                for (index_t jj = j; jj < jend; ++jj)
+                    yk += dat[A.st[i] + jj * A.chunk + k] * x[col[A.st[i] + jj * A.chunk + k]];
+                F.reduce(yk);
             }
         }
     }
 }
 
-// #ifdef __FFLASFFPACK_USE_SIMD
+#ifdef __FFLASFFPACK_USE_SIMD
+
+/* A full chunk is accumulated in a vector, a column of the chunk being one
+ * load of dat and one gather of x, then added to the rows of its slots.
+ */
 template <class Field>
-inline void fspmv_simd(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A,
-                       typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_, const uint64_t kmax) {
+inline void fspmv_simd_chunks(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, index_t ibeg,
+                              index_t iend, typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
+                              FieldCategories::UnparametricTag) {
+    using simd = Simd<typename Field::Element>;
+    using vect_t = typename simd::vect_t;
     assume_aligned(dat, A.dat, (size_t)Alignment::CACHE_LINE);
     assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(chunkSize, A.chunkSize, (size_t)Alignment::CACHE_LINE);
     assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
     assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
-    index_t chunk = A.chunk;
-    using simd = Simd<typename Field::Element>;
-    using vect_t = typename simd::vect_t;
-
-    vect_t X, Y, D, C, Q, TMP, NEGP, INVP, MIN, MAX, P;
-    double p = (typename Field::Element)F.characteristic();
-
-    P = simd::set1(p);
-    NEGP = simd::set1(-p);
-    INVP = simd::set1(1 / p);
-    MIN = simd::set1(F.minElement());
-    MAX = simd::set1(F.maxElement());
-
-    for (size_t i = 0; i < A.nChunks; ++i) {
-        index_t j = 0;
-        index_t j_loc = 0;
-        Y = simd::load(y + i * chunk);
-        index_t size = chunkSize[i];
-        index_t start = st[i];
-        index_t block = size / kmax;
-        for (size_t l = 0; l < block; ++l) {
-            j_loc += kmax;
-            for (; j < j_loc; ++j) {
-                D = simd::load(dat + start + j * A.chunk);
-                X = simd::gather(x, col + start + j * A.chunk);
-                Y = simd::fmadd(Y, D, X);
-            }
-            simd::mod(Y, P, INVP, NEGP, MIN, MAX, Q, TMP);
+    typename Field::Element tmp[simd::vect_size];
+    for (index_t i = ibeg; i < iend; ++i) {
+        if (sell_chunk_rows(A, i) != (index_t)A.chunk) {
+            fspmv_chunks(F, A, i, i + 1, x, y, FieldCategories::UnparametricTag());
+            continue;
         }
-        for (; j < size; ++j) {
-            D = simd::load(dat + start + j * A.chunk);
-            X = simd::gather(x, col + start + j * A.chunk);
-            Y = simd::fmadd(Y, D, X);
+        const uint64_t start = A.st[i];
+        vect_t y1 = simd::zero(), y2 = simd::zero();
+        index_t j = 0;
+        for (; j + 1 < A.chunkSize[i]; j += 2) {
+            y1 = simd::fmadd(y1, simd::load(dat + start + j * A.chunk), simd::gather(x, col + start + j * A.chunk));
+            y2 = simd::fmadd(y2, simd::load(dat + start + (j + 1) * A.chunk),
+                             simd::gather(x, col + start + (j + 1) * A.chunk));
         }
-        simd::mod(Y, P, INVP, NEGP, MIN, MAX, Q, TMP);
-        simd::store(y + i * A.chunk, Y);
+        if (j < A.chunkSize[i])
+            y1 = simd::fmadd(y1, simd::load(dat + start + j * A.chunk), simd::gather(x, col + start + j * A.chunk));
+        simd::storeu(tmp, simd::add(y1, y2));
+        for (index_t k = 0; k < (index_t)A.chunk; ++k)
+            y[A.perm[i * A.chunk + k]] += tmp[k];
     }
 }
-// #endif
+
 template <class Field>
-inline void fspmv(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, typename Field::ConstElement_ptr x_,
-                  typename Field::Element_ptr y_, const uint64_t kmax) {
+inline void fspmv_simd_chunks(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, index_t ibeg,
+                              index_t iend, typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
+                              const uint64_t kmax) {
+    using simd = Simd<typename Field::Element>;
+    using vect_t = typename simd::vect_t;
     assume_aligned(dat, A.dat, (size_t)Alignment::CACHE_LINE);
     assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(chunkSize, A.chunkSize, (size_t)Alignment::CACHE_LINE);
     assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
     assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
-    index_t chunk = A.chunk;
-    for (size_t i = 0; i < A.nChunks; ++i) {
-        index_t j = 0;
-        index_t j_loc = 0;
-        index_t size = chunkSize[i];
-        index_t start = st[i];
-        index_t block = size / kmax;
-        for (size_t l = 0; l < block; ++l) {
-            j_loc += kmax;
-            for (; j < j_loc; ++j) {
-                size_t k = 0;
-                for (; k < ROUND_DOWN(A.chunk, 4); k += 4) {
-                    y[i * A.chunk + k] += dat[start + j * chunk + k] * x[col[start + j * chunk + k]];
-                    y[i * A.chunk + k + 1] += dat[start + j * chunk + k + 1] * x[col[start + j * chunk + k + 1]];
-                    y[i * A.chunk + k + 2] += dat[start + j * chunk + k + 2] * x[col[start + j * chunk + k + 2]];
-                    y[i * A.chunk + k + 3] += dat[start + j * chunk + k + 3] * x[col[start + j * chunk + k + 3]];
-                }
-                for (; k < size; ++k) {
-                    y[i * A.chunk + k] += dat[start + j * chunk + k] * x[col[start + j * chunk + k]];
-                }
-            }
-            for (size_t k = 0; k < size; ++k) {
-                F.reduce(y[i * A.chunk + k]);
-            }
-        }
-        for (; j < size; ++j) {
-            size_t k = 0;
-            for (; k < ROUND_DOWN(A.chunk, 4); k += 4) {
-                y[i * A.chunk + k] += dat[start + j * chunk + k] * x[col[start + j * chunk + k]];
-                y[i * A.chunk + k + 1] += dat[start + j * chunk + k + 1] * x[col[start + j * chunk + k + 1]];
-                y[i * A.chunk + k + 2] += dat[start + j * chunk + k + 2] * x[col[start + j * chunk + k + 2]];
-                y[i * A.chunk + k + 3] += dat[start + j * chunk + k + 3] * x[col[start + j * chunk + k + 3]];
-            }
-            for (; k < size; ++k) {
-                y[i * A.chunk + k] += dat[start + j * chunk + k] * x[col[start + j * chunk + k]];
-            }
+    const index_t km = (index_t)std::max<uint64_t>(1, std::min<uint64_t>(kmax, A.maxrow));
+    typename Field::Element tmp[simd::vect_size];
+    for (index_t i = ibeg; i < iend; ++i) {
+        if (sell_chunk_rows(A, i) != (index_t)A.chunk) {
+            fspmv_chunks(F, A, i, i + 1, x, y, kmax);
+            continue;
         }
-        for (size_t k = 0; k < size; ++k) {
-            F.reduce(y[i * A.chunk + k]);
+        const uint64_t start = A.st[i];
+        for (index_t k = 0; k < (index_t)A.chunk; ++k)
+            tmp[k] = y[A.perm[i * A.chunk + k]];
+        for (index_t j = 0; j < A.chunkSize[i]; j += km) {
+            const index_t jend = std::min<index_t>(A.chunkSize[i], j + km);
+            vect_t y1 = simd::loadu(tmp);
+            for (index_t jj = j; jj < jend; ++jj)
+                y1 = simd::fmadd(y1, simd::load(dat + start + jj * A.chunk),
+                                 simd::gather(x, col + start + jj * A.chunk));
+            simd::storeu(tmp, y1);
+            freduce(F, A.chunk, tmp, 1);
         }
+        for (index_t k = 0; k < (index_t)A.chunk; ++k)
+            y[A.perm[i * A.chunk + k]] = tmp[k];
     }
 }
 
+#else
+
+// without SIMD the simd entry points run the scalar kernels
 template <class Field>
-inline void fspmv_one(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A,
-                      typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
-                      FieldCategories::GenericTag) {
+inline void fspmv_simd_chunks(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, index_t ibeg,
+                              index_t iend, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
+                              FieldCategories::UnparametricTag) {
+    fspmv_chunks(F, A, ibeg, iend, x, y, FieldCategories::UnparametricTag());
+}
+
+template <class Field>
+inline void fspmv_simd_chunks(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, index_t ibeg,
+                              index_t iend, typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
+                              const uint64_t kmax) {
+    fspmv_chunks(F, A, ibeg, iend, x, y, kmax);
+}
+
+#endif // __FFLASFFPACK_USE_SIMD
+
+template <class Field>
+inline void fspmv(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, typename Field::ConstElement_ptr x,
+                  typename Field::Element_ptr y, FieldCategories::GenericTag) {
+    fspmv_chunks(F, A, 0, A.nChunks, x, y, FieldCategories::GenericTag());
+}
+
+template <class Field>
+inline void fspmv(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, typename Field::ConstElement_ptr x,
+                  typename Field::Element_ptr y, FieldCategories::UnparametricTag) {
+    fspmv_chunks(F, A, 0, A.nChunks, x, y, FieldCategories::UnparametricTag());
+}
+
+template <class Field>
+inline void fspmv(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, typename Field::ConstElement_ptr x,
+                  typename Field::Element_ptr y, const uint64_t kmax) {
+    fspmv_chunks(F, A, 0, A.nChunks, x, y, kmax);
+}
+
+template <class Field>
+inline void fspmv_simd(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, typename Field::ConstElement_ptr x,
+                       typename Field::Element_ptr y, FieldCategories::UnparametricTag) {
+    fspmv_simd_chunks(F, A, 0, A.nChunks, x, y, FieldCategories::UnparametricTag());
+}
+
+template <class Field>
+inline void fspmv_simd(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, typename Field::ConstElement_ptr x,
+                       typename Field::Element_ptr y, const uint64_t kmax) {
+    fspmv_simd_chunks(F, A, 0, A.nChunks, x, y, kmax);
+}
+
+/* ZO kernels: x has a zero at index A.n for the padding entries, see
+ * sparse_details::zo_padded_input.
+ */
+template <class Field>
+inline void fspmv_one_chunks(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A, index_t ibeg,
+                             index_t iend, typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
+                             FieldCategories::GenericTag) {
     assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(chunkSize, A.chunkSize, (size_t)Alignment::CACHE_LINE);
     assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
     assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
-    for (index_t i = 0; i < A.nChunks; ++i) {
-        index_t start = st[i];
-        index_t size = chunkSize[i];
-        index_t j = 0;
-        for (; j < size; j++) {
-            for (index_t k = 0; k < A.chunk; ++k) {
-                F.addin(y[i * A.chunk + k], x[col[start + j * A.chunk + k]]);
-            }
+    for (index_t i = ibeg; i < iend; ++i) {
+        const index_t r = sell_chunk_rows(A, i);
+        for (index_t k = 0; k < r; ++k) {
+            typename Field::Element &yk = y[A.perm[i * A.chunk + k]];
+            for (index_t j = 0; j < A.chunkSize[i]; ++j)
+                F.addin(yk, x[col[A.st[i] + j * A.chunk + k]]);
         }
     }
 }
 
 template <class Field>
-inline void fspmv_mone(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A,
-                       typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
-                       FieldCategories::GenericTag) {
+inline void fspmv_mone_chunks(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A, index_t ibeg,
+                              index_t iend, typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
+                              FieldCategories::GenericTag) {
     assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(chunkSize, A.chunkSize, (size_t)Alignment::CACHE_LINE);
     assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
     assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
-    for (index_t i = 0; i < A.nChunks; ++i) {
-        index_t start = st[i];
-        index_t size = chunkSize[i];
-        index_t j = 0;
-        for (; j < size; j++) {
-            for (index_t k = 0; k < A.chunk; ++k) {
-                F.subin(y[i * A.chunk + k], x[col[start + j * A.chunk + k]]);
-            }
+    for (index_t i = ibeg; i < iend; ++i) {
+        const index_t r = sell_chunk_rows(A, i);
+        for (index_t k = 0; k < r; ++k) {
+            typename Field::Element &yk = y[A.perm[i * A.chunk + k]];
+            for (index_t j = 0; j < A.chunkSize[i]; ++j)
+                F.subin(yk, x[col[A.st[i] + j * A.chunk + k]]);
         }
     }
 }
 
-// #ifdef __FFLASFFPACK_USE_SIMD
 template <class Field>
-inline void fspmv_one_simd(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A,
-                           typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
-                           FieldCategories::UnparametricTag) {
+inline void fspmv_one_chunks(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A, index_t ibeg,
+                             index_t iend, typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
+                             FieldCategories::UnparametricTag) {
     assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(chunkSize, A.chunkSize, (size_t)Alignment::CACHE_LINE);
     assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
     assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
-
-    using simd = Simd<typename Field::Element>;
-    using vect_t = typename simd::vect_t;
-    for (index_t i = 0; i < A.nChunks; ++i) {
-        index_t start = st[i];
-        index_t size = chunkSize[i];
-        vect_t x1, x2, y1, y2;
-        y1 = simd::zero();
-        y2 = simd::zero();
-        index_t j = 0;
-        for (; j < ROUND_DOWN(size, 2); j += 2) {
-            x1 = simd::gather(x, col + start + j * A.chunk);
-            x2 = simd::gather(x, col + start + (j + 1) * A.chunk);
-            y1 = simd::add(y1, x1);
-            y2 = simd::add(y2, x2);
-        }
-        if (size % 2 != 0) {
-            x1 = simd::gather(x, col + start + j * A.chunk);
-            y1 = simd::add(y1, x1);
+    for (index_t i = ibeg; i < iend; ++i) {
+        const index_t r = sell_chunk_rows(A, i);
+        for (index_t k = 0; k < r; ++k) {
+            typename Field::Element yk = 0;
+            for (index_t j = 0; j < A.chunkSize[i]; ++j)
+                yk += x[col[A.st[i] + j * A.chunk + k]];
+            y[A.perm[i * A.chunk + k]] += yk;
         }
-        simd::store(y + i * A.chunk, simd::add(simd::load(y + i * A.chunk), simd::add(y1, y2)));
     }
 }
 
 template <class Field>
-inline void fspmv_mone_simd(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A,
-                            typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
-                            FieldCategories::UnparametricTag) {
+inline void fspmv_mone_chunks(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A, index_t ibeg,
+                              index_t iend, typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
+                              FieldCategories::UnparametricTag) {
     assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(chunkSize, A.chunkSize, (size_t)Alignment::CACHE_LINE);
     assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
     assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
+    for (index_t i = ibeg; i < iend; ++i) {
+        const index_t r = sell_chunk_rows(A, i);
+        for (index_t k = 0; k < r; ++k) {
+            typename Field::Element yk = 0;
+            for (index_t j = 0; j < A.chunkSize[i]; ++j)
+                yk += x[col[A.st[i] + j * A.chunk + k]];
+            y[A.perm[i * A.chunk + k]] -= yk;
+        }
+    }
+}
 
+#ifdef __FFLASFFPACK_USE_SIMD
+// y += cst * (sum of the gathered columns), cst being 1 or -1
+template <class Field, bool one>
+inline void fspmv_zo_simd_chunks(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A, index_t ibeg,
+                                 index_t iend, typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_) {
     using simd = Simd<typename Field::Element>;
     using vect_t = typename simd::vect_t;
-    for (index_t i = 0; i < A.nChunks; ++i) {
-        index_t start = st[i];
-        index_t size = chunkSize[i];
-        vect_t x1, x2, y1, y2;
-        y1 = simd::zero();
-        y2 = simd::zero();
+    assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
+    assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
+    assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
+    typename Field::Element tmp[simd::vect_size];
+    for (index_t i = ibeg; i < iend; ++i) {
+        if (sell_chunk_rows(A, i) != (index_t)A.chunk) {
+            if (one)
+                fspmv_one_chunks(F, A, i, i + 1, x, y, FieldCategories::UnparametricTag());
+            else
+                fspmv_mone_chunks(F, A, i, i + 1, x, y, FieldCategories::UnparametricTag());
+            continue;
+        }
+        const uint64_t start = A.st[i];
+        vect_t y1 = simd::zero(), y2 = simd::zero();
         index_t j = 0;
-        for (; j < ROUND_DOWN(size, 2); j += 2) {
-            x1 = simd::gather(x, col + start + j * A.chunk);
-            x2 = simd::gather(x, col + start + (j + 1) * A.chunk);
-            y1 = simd::add(y1, x1);
-            y2 = simd::add(y2, x2);
+        for (; j + 1 < A.chunkSize[i]; j += 2) {
+            y1 = simd::add(y1, simd::gather(x, col + start + j * A.chunk));
+            y2 = simd::add(y2, simd::gather(x, col + start + (j + 1) * A.chunk));
         }
-        if (size % 2 != 0) {
-            x1 = simd::gather(x, col + start + j * A.chunk);
-            y1 = simd::add(y1, x1);
+        if (j < A.chunkSize[i])
+            y1 = simd::add(y1, simd::gather(x, col + start + j * A.chunk));
+        simd::storeu(tmp, simd::add(y1, y2));
+        for (index_t k = 0; k < (index_t)A.chunk; ++k) {
+            if (one)
+                y[A.perm[i * A.chunk + k]] += tmp[k];
+            else
+                y[A.perm[i * A.chunk + k]] -= tmp[k];
         }
-        simd::store(y + i * A.chunk, simd::sub(simd::load(y + i * A.chunk), simd::add(y1, y2)));
     }
 }
+#else
 
-// #endif
+template <class Field, bool one>
+inline void fspmv_zo_simd_chunks(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A, index_t ibeg,
+                                 index_t iend, typename Field::ConstElement_ptr x, typename Field::Element_ptr y) {
+    if (one)
+        fspmv_one_chunks(F, A, ibeg, iend, x, y, FieldCategories::UnparametricTag());
+    else
+        fspmv_mone_chunks(F, A, ibeg, iend, x, y, FieldCategories::UnparametricTag());
+}
 
-template <class Field>
+#endif // __FFLASFFPACK_USE_SIMD
+
+template <class Field, class FieldCat>
 inline void fspmv_one(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A,
-                      typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
-                      FieldCategories::UnparametricTag) {
+                      typename Field::ConstElement_ptr x, typename Field::Element_ptr y, FieldCat tag) {
+    typename Field::Element_ptr x1 = sparse_details::zo_padded_input(F, A, 1, x, 1);
+    fspmv_one_chunks(F, A, 0, A.nChunks, x1 ? x1 : x, y, tag);
+    fflas_delete(x1);
+}
+
+template <class Field, class FieldCat>
+inline void fspmv_mone(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A,
+                       typename Field::ConstElement_ptr x, typename Field::Element_ptr y, FieldCat tag) {
+    typename Field::Element_ptr x1 = sparse_details::zo_padded_input(F, A, 1, x, 1);
+    fspmv_mone_chunks(F, A, 0, A.nChunks, x1 ? x1 : x, y, tag);
+    fflas_delete(x1);
+}
+
+template <class Field>
+inline void fspmv_one_simd(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A,
+                           typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
+                           FieldCategories::UnparametricTag) {
+    typename Field::Element_ptr x1 = sparse_details::zo_padded_input(F, A, 1, x, 1);
+    fspmv_zo_simd_chunks<Field, true>(F, A, 0, A.nChunks, x1 ? x1 : x, y);
+    fflas_delete(x1);
+}
+
+template <class Field>
+inline void fspmv_mone_simd(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A,
+                            typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
+                            FieldCategories::UnparametricTag) {
+    typename Field::Element_ptr x1 = sparse_details::zo_padded_input(F, A, 1, x, 1);
+    fspmv_zo_simd_chunks<Field, false>(F, A, 0, A.nChunks, x1 ? x1 : x, y);
+    fflas_delete(x1);
+}
+
+/* y += A^T x on the chunks ibeg..iend-1, as ELL does: slot k of chunk i
+ * scatters its row into y, scaled by the entry of x at A.perm[i * A.chunk + k].
+ * The SELL padding adds zeros to y[0]; the SELL_ZO padding, at column A.n
+ * after the entries of its slot, ends the slot.
+ */
+template <class Field>
+inline void fspmv_transpose_chunks(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A, index_t ibeg,
+                                   index_t iend, typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
+                                   FieldCategories::GenericTag) {
+    assume_aligned(dat, A.dat, (size_t)Alignment::CACHE_LINE);
     assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(chunkSize, A.chunkSize, (size_t)Alignment::CACHE_LINE);
     assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
     assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
-    auto chunk = A.chunk;
-    for (index_t i = 0; i < A.nChunks; ++i) {
-        index_t start = st[i];
-        index_t size = chunkSize[i];
-        for (index_t j = 0; j < size; j++) {
-            size_t k = 0;
-            for (; k < ROUND_DOWN(A.chunk, 4); k += 4) {
-                y[i * A.chunk + k] += x[col[start + j * chunk + k]];
-                y[i * A.chunk + k + 1] += x[col[start + j * chunk + k + 1]];
-                y[i * A.chunk + k + 2] += x[col[start + j * chunk + k + 2]];
-                y[i * A.chunk + k + 3] += x[col[start + j * chunk + k + 3]];
-            }
-            for (; k < size; ++k) {
-                y[i * A.chunk + k] += x[col[start + j * chunk + k]];
-            }
+    for (index_t i = ibeg; i < iend; ++i) {
+        const index_t r = sell_chunk_rows(A, i);
+        for (index_t k = 0; k < r; ++k) {
+            const typename Field::Element &xk = x[A.perm[i * A.chunk + k]];
+            if (F.isZero(xk))
+                continue;
+            for (index_t j = 0; j < A.chunkSize[i]; ++j)
+                F.axpyin(y[col[A.st[i] + j * A.chunk + k]], dat[A.st[i] + j * A.chunk + k], xk);
         }
     }
 }
 
 template <class Field>
-inline void fspmv_mone(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A,
-                       typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
-                       FieldCategories::UnparametricTag) {
+inline void fspmv_transpose_chunks(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A, index_t ibeg,
+                                   index_t iend, typename Field::ConstElement_ptr x_, typename Field::Element_ptr y_,
+                                   FieldCategories::GenericTag) {
     assume_aligned(col, A.col, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(st, A.st, (size_t)Alignment::CACHE_LINE);
-    assume_aligned(chunkSize, A.chunkSize, (size_t)Alignment::CACHE_LINE);
     assume_aligned(x, x_, (size_t)Alignment::DEFAULT);
     assume_aligned(y, y_, (size_t)Alignment::DEFAULT);
-    auto chunk = A.chunk;
-    for (index_t i = 0; i < A.nChunks; ++i) {
-        index_t start = st[i];
-        index_t size = chunkSize[i];
-        for (index_t j = 0; j < size; j++) {
-            size_t k = 0;
-            for (; k < ROUND_DOWN(A.chunk, 4); k += 4) {
-                y[i * A.chunk + k] -= x[col[start + j * chunk + k]];
-                y[i * A.chunk + k + 1] -= x[col[start + j * chunk + k + 1]];
-                y[i * A.chunk + k + 2] -= x[col[start + j * chunk + k + 2]];
-                y[i * A.chunk + k + 3] -= x[col[start + j * chunk + k + 3]];
-            }
-            for (; k < size; ++k) {
-                y[i * A.chunk + k] -= x[col[start + j * chunk + k]];
+    typename Field::Element xk;
+    for (index_t i = ibeg; i < iend; ++i) {
+        const index_t r = sell_chunk_rows(A, i);
+        for (index_t k = 0; k < r; ++k) {
+            F.mul(xk, A.cst, x[A.perm[i * A.chunk + k]]);
+            if (F.isZero(xk))
+                continue;
+            for (index_t j = 0; j < A.chunkSize[i]; ++j) {
+                const index_t c = col[A.st[i] + j * A.chunk + k];
+                if (c == A.n)
+                    break;
+                F.addin(y[c], xk);
             }
         }
     }
 }
 
-} // SELL_details
+template <class Field>
+inline void fspmv_transpose(const Field &F, const Sparse<Field, SparseMatrix_t::SELL> &A,
+                            typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
+                            FieldCategories::GenericTag) {
+    fspmv_transpose_chunks(F, A, 0, A.nChunks, x, y, FieldCategories::GenericTag());
+}
+
+template <class Field>
+inline void fspmv_transpose(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A,
+                            typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
+                            FieldCategories::GenericTag) {
+    fspmv_transpose_chunks(F, A, 0, A.nChunks, x, y, FieldCategories::GenericTag());
+}
+
+} // sparse_details_impl
 
 } // FFLAS
 
-#endif //  __FFLASFFPACK_fflas_SELL_spmv_INL
\ No newline at end of file
+#endif // __FFLASFFPACK_fflas_sparse_SELL_spmv_INL
@@ -29,253 +29,168 @@
 #ifndef __FFLASFFPACK_fflas_sparse_sell_utils_INL
 #define __FFLASFFPACK_fflas_sparse_sell_utils_INL
 
-namespace FFLAS {
+#include <algorithm>
+#include <numeric>
+#include <vector>
 
-template <class Field>
-inline void fspmv(const Field &F, const Sparse<Field, SparseMatrix_t::SELL_ZO> &A, typename Field::ConstElement_ptr x,
-                  typename Field::Element_ptr y, FieldCategories::ModularTag) {
-    fspmv(F, A, x, y, FieldCategories::UnparametricTag());
-    freduce(F, A.m, y, 1);
-}
+namespace FFLAS {
 
 template <class Field> inline void sparse_delete(const Sparse<Field, SparseMatrix_t::SELL> &A) {
     fflas_delete(A.dat);
     fflas_delete(A.col);
     fflas_delete(A.st);
     fflas_delete(A.chunkSize);
+    fflas_delete(A.perm);
+    fflas_delete(A.reorder);
+    sparse_details::reorder_scratch_delete(A.reorderScratch);
 }
 
 template <class Field> inline void sparse_delete(const Sparse<Field, SparseMatrix_t::SELL_ZO> &A) {
     fflas_delete(A.col);
     fflas_delete(A.st);
     fflas_delete(A.chunkSize);
-}
-
-namespace sell_details {
-
-struct Info {
-    uint64_t size = 0;
-    uint64_t perm = 0;
-    uint64_t begin = 0;
-
-    Info(uint64_t it, uint64_t s, uint64_t p) : size(s), perm(p), begin(it) {}
-    Info() = default;
-    Info(const Info &) = default;
-    Info(Info &&) = default;
-
-    Info &operator=(const Info &) = default;
-    Info &operator=(Info &&) = default;
-};
-
-template <class ValT, class IdxT> struct Coo {
-    using Self = Coo<ValT, IdxT>;
-
-    ValT val = 0;
-    IdxT row = 0;
-    IdxT col = 0;
-
-    Coo(ValT v, IdxT r, IdxT c) : val(v), row(r), col(c) {}
-    Coo() = default;
-    Coo(const Self &) = default;
-    Coo(Self &&) = default;
-
-    Self &operator=(const Self &) = default;
-    Self &operator=(Self &&) = default;
-};
+    fflas_delete(A.perm);
+    fflas_delete(A.reorder);
+    sparse_details::reorder_scratch_delete(A.reorderScratch);
 }
 
 template <class Field> inline void sparse_print(const Sparse<Field, SparseMatrix_t::SELL> &A) {
-    uint64_t it = 0;
-    for (size_t i = 0; i < A.nChunks; ++i) {
-        for (size_t k = 0; k < A.chunk; ++k) {
-            std::cout << i *A.chunk + k << " : ";
-            for (size_t j = 0; j < A.chunkSize[i]; ++j) {
-                std::cout << A.dat[it + j * A.chunk + k] << " ";
-            }
-            std::cout << std::endl;
-        }
-        it += A.chunkSize[i] * A.chunk;
+    for (index_t s = 0; s < A.m; ++s) {
+        const index_t i = s / A.chunk, k = s % A.chunk;
+        std::cout << A.perm[s] << " : ";
+        for (index_t j = 0; j < A.chunkSize[i]; ++j)
+            std::cout << A.dat[A.st[i] + j * A.chunk + k] << " ";
+        std::cout << std::endl;
     }
 }
 
+namespace sparse_details {
+
+/* Pattern of a SELL matrix from a COO matrix in any order, the entries of a
+ * row keeping their input order; the padding entries get column pad. Returns
+ * the position in A.col of each input entry.
+ */
 template <class Field, class IndexT>
-inline void sparse_init(const Field &F, Sparse<Field, SparseMatrix_t::SELL> &A, const IndexT *row, const IndexT *col,
-                        typename Field::ConstElement_ptr dat, uint64_t rowdim, uint64_t coldim, uint64_t nnz,
-                        uint64_t sigma = 0) {
-    using namespace sell_details;
-    using coo = Coo<typename Field::Element, IndexT>;
-    if (!sigma)
-        sigma = rowdim;
-    A.kmax = Protected::DotProdBoundClassic(F, F.one);
-    A.m = rowdim;
-    A.n = coldim;
-    A.nnz = nnz;
+inline std::vector<uint64_t> sell_init_pattern(Sparse<Field, SparseMatrix_t::SELL> &A, const IndexT *row,
+                                               const IndexT *col, uint64_t rowdim, uint64_t coldim, uint64_t nnz,
+                                               uint64_t sigma, index_t pad) {
 #ifdef __FFLASFFPACK_USE_SIMD
     using simd = Simd<typename Field::Element>;
     A.chunk = simd::vect_size;
 #else
     A.chunk = 8;
 #endif
-    index_t m = (A.m % A.chunk == 0) ? A.m : ROUND_DOWN(A.m, A.chunk) + A.chunk;
-    A.nChunks = (m / A.chunk);
+    const uint64_t chunk = A.chunk;
+    A.m = rowdim;
+    A.n = coldim;
+    A.nnz = nnz;
+    A.nChunks = (rowdim + chunk - 1) / chunk;
+    // the sorting windows are made of whole chunks, the whole matrix by default
+    if (sigma == 0 || sigma > rowdim)
+        sigma = rowdim;
+    sigma = ((sigma + chunk - 1) / chunk) * chunk;
+    A.sigma = sigma;
+
+    std::vector<uint64_t> rst(rowdim + 1, 0);
+    for (uint64_t k = 0; k < nnz; ++k)
+        rst[row[k] + 1]++;
+    std::vector<index_t> len(rst.begin() + 1, rst.end());
+    A.maxrow = (rowdim > 0) ? *(std::max_element(len.begin(), len.end())) : 0;
+    for (uint64_t i = 1; i <= rowdim; ++i)
+        rst[i] += rst[i - 1];
+    std::vector<uint64_t> order(nnz), next(rst.begin(), rst.end() - 1);
+    for (uint64_t k = 0; k < nnz; ++k)
+        order[next[row[k]]++] = k;
 
-    std::vector<coo> data;
-    std::vector<Info> infos(A.nChunks * A.chunk);
+    A.perm = fflas_new<index_t>(rowdim, Alignment::CACHE_LINE);
+    std::iota(A.perm, A.perm + rowdim, 0);
+    for (uint64_t w = 0; w < rowdim; w += sigma)
+        std::stable_sort(A.perm + w, A.perm + std::min(rowdim, w + sigma),
+                         [&len](index_t a, index_t b) { return len[a] > len[b]; });
 
-    for (uint64_t i = 0; i < nnz; ++i) {
-        data.emplace_back(dat[i], row[i], col[i]);
+    A.chunkSize = fflas_new<index_t>(A.nChunks, Alignment::CACHE_LINE);
+    A.st = fflas_new<uint64_t>(A.nChunks + 1, Alignment::CACHE_LINE);
+    A.st[0] = 0;
+    for (index_t i = 0; i < A.nChunks; ++i) {
+        A.chunkSize[i] = 0;
+        for (uint64_t s = i * chunk; s < std::min(rowdim, (i + 1) * chunk); ++s)
+            A.chunkSize[i] = std::max(A.chunkSize[i], len[A.perm[s]]);
+        A.st[i + 1] = A.st[i] + A.chunkSize[i] * chunk;
     }
-
-    IndexT currow = row[0];
-
-    infos[currow].begin = 0;
-    for (uint64_t i = 0; i < nnz; ++i) {
-        if (row[i] != currow) {
-            currow = row[i];
-            infos[currow].begin = i;
+    A.nElements = A.st[A.nChunks];
+
+    A.col = fflas_new<index_t>(A.nElements, Alignment::CACHE_LINE);
+    for (uint64_t e = 0; e < A.nElements; ++e)
+        A.col[e] = pad;
+    std::vector<uint64_t> pos(nnz);
+    for (uint64_t s = 0; s < rowdim; ++s) {
+        const uint64_t r = A.perm[s], start = A.st[s / chunk] + s % chunk;
+        for (uint64_t t = 0; t < len[r]; ++t) {
+            const uint64_t k = order[rst[r] + t];
+            pos[k] = start + t * chunk;
+            A.col[pos[k]] = static_cast<index_t>(col[k]);
         }
-        infos[row[i]].size++;
     }
+    return pos;
+}
 
-    A.maxrow = (std::max_element(infos.begin(), infos.end(),
-                                 [](const Info &a, const Info &b) { return a.size >= b.size; }))->size;
-
-    // cout << "maxrow : " << A.maxrow << endl;
+} // sparse_details
 
-    if (A.maxrow < A.kmax)
+template <class Field, class IndexT>
+inline void sparse_init(const Field &F, Sparse<Field, SparseMatrix_t::SELL> &A, const IndexT *row, const IndexT *col,
+                        typename Field::ConstElement_ptr dat, uint64_t rowdim, uint64_t coldim, uint64_t nnz,
+                        uint64_t sigma) {
+    A.kmax = Protected::DotProdBoundClassic(F, F.one);
+    std::vector<uint64_t> pos = sparse_details::sell_init_pattern(A, row, col, rowdim, coldim, nnz, sigma, 0);
+    if (A.kmax > A.maxrow)
         A.delayed = true;
+    A.dat = fflas_new(F, A.nElements, 1, Alignment::CACHE_LINE);
+    for (uint64_t e = 0; e < A.nElements; ++e)
+        F.assign(A.dat[e], F.zero);
+    for (uint64_t k = 0; k < nnz; ++k)
+        F.assign(A.dat[pos[k]], dat[k]);
+}
 
-    for (uint64_t i = 0; i < rowdim; ++i) {
-        infos[i].perm = i;
-    }
-
-#ifdef SELL_DEBUG
-    for (auto &x : infos) {
-        cout << x.size << " ";
-    }
-    std::cout << std::endl;
-#endif
-
-    uint64_t it = 0;
-    for (; it < ROUND_DOWN(rowdim, sigma); it += sigma) {
-        std::sort(infos.begin() + it, infos.begin() + it + sigma,
-                  [](const Info &a, const Info &b) { return a.size >= b.size; });
-    }
-    if (it != rowdim) {
-        std::sort(infos.begin() + it, infos.end(), [](Info a, Info b) { return a.size >= b.size; });
-    }
-
-    // cout << "sorted : " << std::is_sorted(infos.begin(), infos.end(), [](Info
-    // a, Info b){
-    // 	return a.size >= b.size;
-    // }) << endl;
-
-    for (size_t i = 0; i < infos.size(); ++i) {
-        if (infos[i].begin > nnz)
-            std::cout << "ERROR sort " << i << " size : " << infos[i].size << " begin : " << infos[i].begin
-                 << " perm : " << infos[i].perm << std::endl;
-    }
-
-#ifdef SELL_DEBUG
-    for (auto &x : infos) {
-        cout << x.size << " ";
-    }
-    std::cout << std::endl;
-#endif
-
-    A.perm = fflas_new<index_t>(rowdim, Alignment::CACHE_LINE);
-
-    // cout << "perm : ";
-    for (uint64_t i = 0; i < rowdim; ++i) {
-        // cout << "(" << i << " , " << infos[i].perm << ") ";
-        A.perm[infos[i].perm] = i;
-    }
-
-    // for(size_t i = 0 ; i < A.m ; ++i)
-    //           cout << A.perm[i] << " ";
-    //       cout << endl;
-    // cout << endl;
-
-    // add info if rowdim%chunk != 0, with empty infos (size = 0, begin = 0)
-    // infos.resize(A.nChunks*A.chunk);
-
-    // for(auto & x:infos)
-    // 	if(x.begin > nnz)
-    // 		cout << "ERROR resize" << endl;
-
-    A.chunkSize = fflas_new<index_t>(A.nChunks, Alignment::CACHE_LINE);
-
-    for (uint64_t i = 0; i < A.nChunks; ++i)
-        A.chunkSize[i] = 0;
-
-    for (uint64_t i = 0; i < A.nChunks; ++i) {
-        for (uint64_t j = 0; j < A.chunk; ++j) {
-            if (infos[i * A.chunk + j].size >= A.chunkSize[i])
-                A.chunkSize[i] = infos[i * A.chunk + j].size;
-        }
-    }
-
-#ifdef SELL_DEBUG
-    for (uint64_t i = 0; i < A.nChunks; ++i)
-        cout << "chunk " << i << " : " << A.chunkSize[i] << endl;
-    ;
-#endif
-    uint64_t sum = 0;
-    for (uint64_t i = 0; i < A.nChunks; ++i)
-        sum += A.chunkSize[i];
-#ifdef SELL_DEBUG
-    cout << "sum :  " << sum << " chunk : " << A.chunk << endl;
-#endif
-    A.col = fflas_new<index_t>(sum * A.chunk, Alignment::CACHE_LINE);
-    A.dat = fflas_new(F, sum * A.chunk, 1, Alignment::CACHE_LINE);
-    A.nElements = sum * A.chunk;
+// the padding entries point to column n, see sparse_details::zo_padded_input
+template <class Field, class IndexT>
+inline void sparse_init(const Field &F, Sparse<Field, SparseMatrix_t::SELL_ZO> &A, const IndexT *row,
+                        const IndexT *col, typename Field::ConstElement_ptr dat, uint64_t rowdim, uint64_t coldim,
+                        uint64_t nnz, uint64_t sigma) {
+    A.kmax = Protected::DotProdBoundClassic(F, F.one);
+    A.delayed = true;
+    sparse_details::sell_init_pattern(A, row, col, rowdim, coldim, nnz, sigma, (index_t)coldim);
+}
 
-    for (uint64_t i = 0; i < sum * A.chunk; ++i) {
-        A.col[i] = 0;
-        F.assign(A.dat[i], F.zero);
+template <class Field, class IndexT>
+inline void sparse_init(const Field &F, Sparse<Field, SparseMatrix_t::SELL> &A, const IndexT *row, const IndexT *col,
+                        typename Field::ConstElement_ptr dat, uint64_t rowdim, uint64_t coldim, uint64_t nnz,
+                        uint64_t sigma, SparseReordering reorder) {
+    if (reorder == SparseReordering::NONE || rowdim != coldim) {
+        sparse_init(F, A, row, col, dat, rowdim, coldim, nnz, sigma);
+        return;
     }
+    sparse_details::sparse_init_reordered<Field>(
+        A, row, col, dat, rowdim, nnz,
+        [&](const index_t *r, const index_t *c, typename Field::ConstElement_ptr d) {
+            sparse_init(F, A, r, c, d, rowdim, coldim, nnz, sigma);
+        });
+}
 
-    it = 0;
-    for (uint64_t i = 0; i < A.nChunks; ++i) {
-        for (uint64_t k = 0; k < A.chunk; ++k) {
-            uint64_t start = infos[i * A.chunk + k].begin;
-#ifdef SELL_DEBUG
-            cout << it << " " << start << " " << infos[i * A.chunk + k].size << endl;
-            cout << "	";
-#endif
-            for (uint64_t j = 0; j < infos[i * A.chunk + k].size; ++j) {
-                if (it + k + j * A.chunk >= sum * A.chunk)
-                    std::cout << "error : " << it + k + j *A.chunk << " " << sum *A.chunk << std::endl;
-                A.dat[it + k + j * A.chunk] = data[start + j].val;
-                A.col[it + k + j * A.chunk] = data[start + j].col;
-#ifdef SELL_DEBUG
-                cout << data[start + j].val << " ";
-#endif
-            }
-#ifdef SELL_DEBUG
-            cout << endl;
-#endif
-        }
-        it += A.chunkSize[i] * A.chunk;
-    }
-    A.st = fflas_new<uint64_t>(A.nChunks, Alignment::CACHE_LINE);
-    A.st[0] = 0;
-    for (uint64_t i = 1; i < A.nChunks; ++i) {
-        A.st[i] = A.chunkSize[i - 1] * A.chunk;
-    }
-    for (uint64_t i = 1; i < A.nChunks; ++i) {
-        A.st[i] += A.st[i - 1];
+template <class Field, class IndexT>
+inline void sparse_init(const Field &F, Sparse<Field, SparseMatrix_t::SELL_ZO> &A, const IndexT *row,
+                        const IndexT *col, typename Field::ConstElement_ptr dat, uint64_t rowdim, uint64_t coldim,
+                        uint64_t nnz, uint64_t sigma, SparseReordering reorder) {
+    if (reorder == SparseReordering::NONE || rowdim != coldim) {
+        sparse_init(F, A, row, col, dat, rowdim, coldim, nnz, sigma);
+        return;
     }
-#ifdef SELL_DEBUG
-    cout << "st : ";
-    for (uint64_t i = 0; i < A.nChunks; ++i)
-        cout << A.st[i] << " ";
-    cout << endl;
-#endif
+    sparse_details::sparse_init_reordered<Field>(
+        A, row, col, dat, rowdim, nnz,
+        [&](const index_t *r, const index_t *c, typename Field::ConstElement_ptr d) {
+            sparse_init(F, A, r, c, d, rowdim, coldim, nnz, sigma);
+        });
 }
 
-template <class Field, class IndexT>
-inline void sparse_init(const Field &F, Sparse<Field, SparseMatrix_t::SELL_ZO> &A, const IndexT *row, const IndexT *col,
-                        typename Field::ConstElement_ptr dat, uint64_t rowdim, uint64_t coldim, uint64_t nnz) {}
 } // FFLAS
-#endif
\ No newline at end of file
+
+#endif // __FFLASFFPACK_fflas_sparse_sell_utils_INL
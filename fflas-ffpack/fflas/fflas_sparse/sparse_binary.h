@@ -0,0 +1,461 @@
+/* -*- mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+// vim:sts=4:sw=4:ts=4:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/*
+ * Copyright (C) 2016 the FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ * ========LICENCE========
+ *.
+ */
+
+/** @file fflas/fflas_sparse/sparse_binary.h
+ * Binary on-disk CSR matrices.
+ *
+ * The file is the CSR arrays of the matrix behind a fixed 128 bytes header:
+ * \code
+ *   header | st[rowdim+1] | col[nnz] | dat[nnz]
+ * \endcode
+ * each array starting on a 64 bytes boundary, in the byte order, index_t and
+ * Element types of the writer. The header records them with the modulus of
+ * the field, so that sparse_map can refuse a file it cannot use as is.
+ *
+ * sparse_map maps such a file (copy on write) and points a Sparse<Field, CSR>
+ * to the arrays, without reading or copying them; the matrix is released
+ * with sparse_unmap, never with sparse_delete.
+ *
+ * readSmsFormatParallel is a multithreaded SMS parser producing the CSR
+ * arrays; convertSmsToCsrBinary and convertSprToCsrBinary are the first time
+ * ingestion of text matrices.
+ */
+
+#ifndef __FFLASFFPACK_fflas_fflas_sparse_sparse_binary_H
+#define __FFLASFFPACK_fflas_fflas_sparse_sparse_binary_H
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace FFLAS {
+
+struct CsrBinaryHeader {
+    static constexpr uint64_t version_number = 1;
+    static constexpr uint64_t alignment = 64;
+    static constexpr uint64_t byte_order = 0x0102030405060708_ui64;
+    enum ElementKind : uint64_t { Unsigned = 0, Signed = 1, FloatingPoint = 2 };
+
+    char magic[8] = {'F', 'F', 'L', 'A', 'S', 'C', 'S', 'R'};
+    uint64_t version = version_number;
+    uint64_t endian = byte_order;
+    uint64_t index_size = 0;
+    uint64_t element_size = 0;
+    uint64_t element_kind = 0;
+    uint64_t modulus = 0;
+    uint64_t rowdim = 0;
+    uint64_t coldim = 0;
+    uint64_t nnz = 0;
+    uint64_t maxrow = 0;
+    uint64_t st_offset = 0;
+    uint64_t col_offset = 0;
+    uint64_t dat_offset = 0;
+    uint64_t file_size = 0;
+    uint64_t reserved = 0;
+};
+
+static_assert(sizeof(CsrBinaryHeader) == 128, "the CSR binary header is 128 bytes");
+
+namespace sparse_details {
+
+inline uint64_t csr_binary_round(uint64_t offset) {
+    return (offset + CsrBinaryHeader::alignment - 1) / CsrBinaryHeader::alignment * CsrBinaryHeader::alignment;
+}
+
+// offsets of the arrays, functions of the dimensions and of the type sizes
+inline void csr_binary_layout(CsrBinaryHeader &h) {
+    h.st_offset = csr_binary_round(sizeof(CsrBinaryHeader));
+    h.col_offset = csr_binary_round(h.st_offset + (h.rowdim + 1) * h.index_size);
+    h.dat_offset = csr_binary_round(h.col_offset + h.nnz * h.index_size);
+    h.file_size = h.dat_offset + h.nnz * h.element_size;
+}
+
+template <class Field>
+inline CsrBinaryHeader csr_binary_header(const Field &F, uint64_t rowdim, uint64_t coldim, uint64_t nnz) {
+    using Element = typename Field::Element;
+    static_assert(std::is_arithmetic<Element>::value, "the CSR binary format needs machine type elements");
+    CsrBinaryHeader h;
+    h.index_size = sizeof(index_t);
+    h.element_size = sizeof(Element);
+    h.element_kind = std::is_floating_point<Element>::value
+                         ? CsrBinaryHeader::FloatingPoint
+                         : (std::is_signed<Element>::value ? CsrBinaryHeader::Signed : CsrBinaryHeader::Unsigned);
+    h.modulus = static_cast<uint64_t>(F.characteristic());
+    h.rowdim = rowdim;
+    h.coldim = coldim;
+    h.nnz = nnz;
+    csr_binary_layout(h);
+    return h;
+}
+
+// private mapping of a whole file, unmapped by the destructor
+struct MappedFile {
+    char *addr = nullptr;
+    size_t length = 0;
+
+    MappedFile(const std::string &path, bool writable = false) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("cannot open " + path);
+        struct stat sb;
+        if (::fstat(fd, &sb) != 0) {
+            ::close(fd);
+            throw std::runtime_error("cannot stat " + path);
+        }
+        length = (size_t)sb.st_size;
+        if (length > 0) {
+            // MAP_PRIVATE: writing to the mapping never modifies the file
+            void *p = ::mmap(nullptr, length, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("cannot map " + path);
+            }
+            addr = static_cast<char *>(p);
+        }
+        ::close(fd);
+    }
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    ~MappedFile() {
+        if (addr)
+            ::munmap(addr, length);
+    }
+    // the caller now owns the mapping
+    char *release() {
+        char *p = addr;
+        addr = nullptr;
+        return p;
+    }
+};
+
+inline void csr_binary_pad(std::ofstream &file, uint64_t &pos, uint64_t offset) {
+    static const char zeros[CsrBinaryHeader::alignment] = {};
+    file.write(zeros, (std::streamsize)(offset - pos));
+    pos = offset;
+}
+
+} // sparse_details
+
+/* Writes the CSR matrix given by its row pointers st[0..rowdim], its columns
+ * and values to path in the binary format.
+ */
+template <class Field>
+inline void writeCsrBinary(const std::string &path, const Field &F, uint64_t rowdim, uint64_t coldim, uint64_t nnz,
+                           const index_t *st, const index_t *col, typename Field::ConstElement_ptr dat) {
+    CsrBinaryHeader h = sparse_details::csr_binary_header(F, rowdim, coldim, nnz);
+    for (uint64_t i = 0; i < rowdim; ++i)
+        h.maxrow = std::max<uint64_t>(h.maxrow, st[i + 1] - st[i]);
+    std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file)
+        throw std::runtime_error("cannot write " + path);
+    uint64_t pos = sizeof(CsrBinaryHeader);
+    file.write(reinterpret_cast<const char *>(&h), sizeof(CsrBinaryHeader));
+    sparse_details::csr_binary_pad(file, pos, h.st_offset);
+    file.write(reinterpret_cast<const char *>(st), (std::streamsize)((rowdim + 1) * sizeof(index_t)));
+    pos += (rowdim + 1) * sizeof(index_t);
+    sparse_details::csr_binary_pad(file, pos, h.col_offset);
+    file.write(reinterpret_cast<const char *>(col), (std::streamsize)(nnz * sizeof(index_t)));
+    pos += nnz * sizeof(index_t);
+    sparse_details::csr_binary_pad(file, pos, h.dat_offset);
+    file.write(reinterpret_cast<const char *>(dat), (std::streamsize)(nnz * sizeof(typename Field::Element)));
+    if (!file)
+        throw std::runtime_error("error while writing " + path);
+}
+
+template <class Field>
+inline void writeCsrBinary(const std::string &path, const Field &F, const Sparse<Field, SparseMatrix_t::CSR> &A) {
+    if (A.reorder != nullptr)
+        throw std::runtime_error("cannot write a reordered matrix to " + path);
+    writeCsrBinary(path, F, A.m, A.n, A.nnz, A.st, A.col, A.dat);
+}
+
+/* Maps the binary CSR file path into A. The file must have been written with
+ * the same index_t and Element types, byte order and modulus as F, and be
+ * exactly as long as its header says: sparse_unmap recomputes the mapped
+ * length from the dimensions.
+ */
+template <class Field>
+inline void sparse_map(const Field &F, Sparse<Field, SparseMatrix_t::CSR> &A, const std::string &path) {
+    sparse_details::MappedFile file(path, true);
+    if (file.length < sizeof(CsrBinaryHeader))
+        throw std::runtime_error(path + " is not a CSR binary file");
+    CsrBinaryHeader h;
+    std::memcpy(&h, file.addr, sizeof(CsrBinaryHeader));
+    if (std::memcmp(h.magic, CsrBinaryHeader().magic, sizeof(h.magic)) != 0)
+        throw std::runtime_error(path + " is not a CSR binary file");
+    if (h.version != CsrBinaryHeader::version_number)
+        throw std::runtime_error(path + ": unsupported CSR binary version");
+    if (h.endian != CsrBinaryHeader::byte_order)
+        throw std::runtime_error(path + ": CSR binary file of another byte order");
+    const CsrBinaryHeader e = sparse_details::csr_binary_header(F, h.rowdim, h.coldim, h.nnz);
+    if (h.index_size != e.index_size || h.element_size != e.element_size || h.element_kind != e.element_kind)
+        throw std::runtime_error(path + ": CSR binary file of other index or element types");
+    if (h.modulus != e.modulus)
+        throw std::runtime_error(path + ": CSR binary file over another field");
+    if (h.st_offset != e.st_offset || h.col_offset != e.col_offset || h.dat_offset != e.dat_offset ||
+        h.file_size != e.file_size || file.length != h.file_size)
+        throw std::runtime_error(path + ": truncated or corrupted CSR binary file");
+
+    char *base = file.release();
+    A.m = (index_t)h.rowdim;
+    A.n = (index_t)h.coldim;
+    A.nnz = h.nnz;
+    A.nElements = h.nnz;
+    A.maxrow = h.maxrow;
+    A.kmax = Protected::DotProdBoundClassic(F, F.one);
+    A.delayed = A.kmax > A.maxrow;
+    A.st = reinterpret_cast<index_t *>(base + h.st_offset);
+    A.stend = A.st + 1;
+    A.col = reinterpret_cast<index_t *>(base + h.col_offset);
+    A.dat = reinterpret_cast<typename Field::Element_ptr>(base + h.dat_offset);
+}
+
+// releases a matrix given by sparse_map
+template <class Field> inline void sparse_unmap(const Sparse<Field, SparseMatrix_t::CSR> &A) {
+    if (A.st == nullptr)
+        return;
+    CsrBinaryHeader h;
+    h.index_size = sizeof(index_t);
+    h.element_size = sizeof(typename Field::Element);
+    h.rowdim = A.m;
+    h.nnz = A.nnz;
+    sparse_details::csr_binary_layout(h);
+    ::munmap(reinterpret_cast<char *>(A.st) - h.st_offset, h.file_size);
+}
+
+namespace sparse_details {
+
+// position after the end of the line containing p
+inline const char *sms_next_line(const char *p, const char *end) {
+    while (p < end && *p != '\n')
+        ++p;
+    return (p < end) ? p + 1 : end;
+}
+
+inline const char *sms_skip_blanks(const char *p, const char *end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+        ++p;
+    return p;
+}
+
+inline bool sms_parse_integer(const char *&p, const char *end, int64_t &v) {
+    p = sms_skip_blanks(p, end);
+    bool neg = false;
+    if (p < end && (*p == '-' || *p == '+'))
+        neg = (*p++ == '-');
+    if (p == end || *p < '0' || *p > '9')
+        return false;
+    uint64_t u = 0;
+    for (; p < end && *p >= '0' && *p <= '9'; ++p)
+        u = 10 * u + (uint64_t)(*p - '0');
+    v = neg ? -(int64_t)u : (int64_t)u;
+    return true;
+}
+
+/* Entries of the SMS lines in [begin, end), the last line of the block
+ * possibly running over end. Stops after the "0 0 0" terminator, setting
+ * terminated; a malformed or out of range line sets error.
+ */
+template <class Field> struct SmsBlock {
+    std::vector<index_t> row, col;
+    std::vector<typename Field::Element> dat;
+    bool terminated = false;
+    bool error = false;
+
+    void parse(const Field &F, const char *begin, const char *end, const char *fileEnd, uint64_t rowdim,
+               uint64_t coldim) {
+        for (const char *p = begin; p < end; p = sms_next_line(p, fileEnd)) {
+            const char *q = sms_skip_blanks(p, fileEnd);
+            if (q == fileEnd || *q == '\n' || *q == '%')
+                continue;
+            int64_t l, c, d;
+            if (!sms_parse_integer(q, fileEnd, l) || !sms_parse_integer(q, fileEnd, c) ||
+                !sms_parse_integer(q, fileEnd, d)) {
+                error = true;
+                return;
+            }
+            if (l == 0 && c == 0 && d == 0) {
+                terminated = true;
+                return;
+            }
+            if (l < 1 || c < 1 || (uint64_t)l > rowdim || (uint64_t)c > coldim) {
+                error = true;
+                return;
+            }
+            typename Field::Element v;
+            F.init(v, d);
+            if (F.isZero(v))
+                continue;
+            row.push_back((index_t)(l - 1));
+            col.push_back((index_t)(c - 1));
+            dat.push_back(v);
+        }
+    }
+};
+
+} // sparse_details
+
+/* Multithreaded readSmsFormat: the body of the file is cut into one block of
+ * lines per thread, the blocks are parsed concurrently and the entries
+ * scattered into CSR arrays; the entries of each row are then sorted by
+ * column. Returns the row pointers st[0..rowdim], as readSmsFormat with
+ * sorted = true. Zero entries are dropped.
+ */
+template <class Field>
+inline void readSmsFormatParallel(const std::string &path, const Field &F, index_t *&st, index_t *&col,
+                                  typename Field::Element_ptr &val, index_t &rowdim, index_t &coldim, uint64_t &nnz) {
+    using Element = typename Field::Element;
+    sparse_details::MappedFile file(path);
+    const char *p = file.addr, *end = file.addr + file.length;
+
+    // header: the first line which is neither empty nor a comment
+    for (;; p = sparse_details::sms_next_line(p, end)) {
+        if (p == end)
+            throw std::runtime_error(path + " is not in sms format");
+        const char *q = sparse_details::sms_skip_blanks(p, end);
+        if (q < end && *q != '\n' && *q != '%')
+            break;
+    }
+    int64_t r, c;
+    if (!sparse_details::sms_parse_integer(p, end, r) || !sparse_details::sms_parse_integer(p, end, c) || r <= 0 ||
+        c <= 0)
+        throw std::runtime_error(path + " is not in sms format");
+    rowdim = (index_t)r;
+    coldim = (index_t)c;
+    const char *body = sparse_details::sms_next_line(p, end);
+
+    const size_t nt = std::max<size_t>(1, std::min<size_t>(MAX_THREADS, (end - body) / 4096 + 1));
+    std::vector<sparse_details::SmsBlock<Field>> blocks(nt);
+    std::vector<const char *> cut(nt + 1);
+    for (size_t t = 0; t <= nt; ++t) {
+        // block t starts on the line following its nominal start
+        const char *s = body + (size_t)(end - body) * t / nt;
+        cut[t] = (t == 0 || t == nt) ? s : sparse_details::sms_next_line(s - 1, end);
+    }
+    const ParSeqHelper::Parallel<CuttingStrategy::Block, StrategyParameter::Threads> par(nt);
+    Protected::pforblock1d_static(nt, par, [&](size_t tb, size_t te) {
+        for (size_t t = tb; t < te; ++t)
+            blocks[t].parse(F, cut[t], cut[t + 1], end, rowdim, coldim);
+    });
+
+    // the blocks after the "0 0 0" line are not part of the matrix
+    size_t last = 0;
+    while (last + 1 < nt && !blocks[last].terminated)
+        ++last;
+    for (size_t t = 0; t <= last; ++t)
+        if (blocks[t].error)
+            throw std::runtime_error(path + ": malformed sms entry");
+
+    st = fflas_new<index_t>(rowdim + 1, Alignment::CACHE_LINE);
+    std::fill(st, st + rowdim + 1, 0);
+    nnz = 0;
+    for (size_t t = 0; t <= last; ++t) {
+        nnz += blocks[t].row.size();
+        for (index_t i : blocks[t].row)
+            st[i + 1]++;
+    }
+    for (index_t i = 0; i < rowdim; ++i)
+        st[i + 1] += st[i];
+
+    col = fflas_new<index_t>(nnz, Alignment::CACHE_LINE);
+    val = fflas_new(F, nnz, 1, Alignment::CACHE_LINE);
+    std::vector<index_t> pos(st, st + rowdim);
+    for (size_t t = 0; t <= last; ++t) {
+        const auto &b = blocks[t];
+        for (size_t k = 0; k < b.row.size(); ++k) {
+            const index_t e = pos[b.row[k]]++;
+            col[e] = b.col[k];
+            val[e] = b.dat[k];
+        }
+    }
+    blocks.clear();
+
+    // blocks of 1024 rows, whose lengths may differ a lot
+    const ParSeqHelper::Parallel<CuttingStrategy::Block, StrategyParameter::Grain> rows(1024);
+    Protected::pforblock1d_static(rowdim, rows, [&](size_t ib, size_t ie) {
+        for (index_t i = (index_t)ib; i < (index_t)ie; ++i) {
+            // insertion sort, the rows of SMS files are usually sorted already
+            for (index_t k = st[i] + 1; k < st[i + 1]; ++k) {
+                const index_t cj = col[k];
+                const Element vj = val[k];
+                index_t l = k;
+                for (; l > st[i] && col[l - 1] > cj; --l) {
+                    col[l] = col[l - 1];
+                    val[l] = val[l - 1];
+                }
+                col[l] = cj;
+                val[l] = vj;
+            }
+        }
+    });
+}
+
+// first time ingestion of an SMS file: parses it in parallel and writes it in the binary format
+template <class Field>
+inline void convertSmsToCsrBinary(const Field &F, const std::string &smsPath, const std::string &binPath) {
+    index_t *st, *col, rowdim, coldim;
+    typename Field::Element_ptr val;
+    uint64_t nnz;
+    readSmsFormatParallel(smsPath, F, st, col, val, rowdim, coldim, nnz);
+    writeCsrBinary(binPath, F, rowdim, coldim, nnz, st, col, val);
+    fflas_delete(st);
+    fflas_delete(col);
+    fflas_delete(val);
+}
+
+// same for an SPR file
+template <class Field>
+inline void convertSprToCsrBinary(const Field &F, const std::string &sprPath, const std::string &binPath) {
+    index_t *row, *col, rowdim, coldim;
+    typename Field::Element_ptr val;
+    uint64_t nnz;
+    readSprFormat(sprPath, F, row, col, val, rowdim, coldim, nnz);
+    // readSprFormat returns the row of each entry, sorted; it may shrink rowdim
+    for (uint64_t k = 0; k < nnz; ++k)
+        rowdim = std::max<index_t>(rowdim, row[k] + 1);
+    index_t *st = fflas_new<index_t>(rowdim + 1);
+    std::fill(st, st + rowdim + 1, 0);
+    for (uint64_t k = 0; k < nnz; ++k)
+        st[row[k] + 1]++;
+    for (index_t i = 0; i < rowdim; ++i)
+        st[i + 1] += st[i];
+    writeCsrBinary(binPath, F, rowdim, coldim, nnz, st, col, val);
+    fflas_delete(st);
+    fflas_delete(row);
+    fflas_delete(col);
+    fflas_delete(val);
+}
+
+} // FFLAS
+
+#endif // __FFLASFFPACK_fflas_fflas_sparse_sparse_binary_H
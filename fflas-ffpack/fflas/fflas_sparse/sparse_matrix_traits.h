@@ -45,6 +45,10 @@ template <class Field> struct isSparseMatrix<Field, Sparse<Field, SparseMatrix_t
 
 template <class Field> struct isSparseMatrix<Field, Sparse<Field, SparseMatrix_t::CSR_ZO>> : public std::true_type {};
 
+template <class Field> struct isSparseMatrix<Field, Sparse<Field, SparseMatrix_t::CSC>> : public std::true_type {};
+
+template <class Field> struct isSparseMatrix<Field, Sparse<Field, SparseMatrix_t::CSC_ZO>> : public std::true_type {};
+
 template <class Field> struct isSparseMatrix<Field, Sparse<Field, SparseMatrix_t::COO>> : public std::true_type {};
 
 template <class Field> struct isSparseMatrix<Field, Sparse<Field, SparseMatrix_t::COO_ZO>> : public std::true_type {};
@@ -66,11 +70,18 @@ template <class Field> struct isSparseMatrix<Field, Sparse<Field, SparseMatrix_t
 
 template <class Field> struct isSparseMatrix<Field, Sparse<Field, SparseMatrix_t::HYB_ZO>> : public std::true_type {};
 
+template <class Field>
+struct isSparseMatrix<Field, Sparse<Field, SparseMatrix_t::CSR_TILED>> : public std::true_type {};
+
+template <class Field> struct isSparseMatrix<Field, Sparse<Field, SparseMatrix_t::AUTO>> : public std::true_type {};
+
 
 template <class F, class M> struct isZOSparseMatrix : public std::false_type {};
 
 template <class Field> struct isZOSparseMatrix<Field, Sparse<Field, SparseMatrix_t::CSR_ZO>> : public std::true_type {};
 
+template <class Field> struct isZOSparseMatrix<Field, Sparse<Field, SparseMatrix_t::CSC_ZO>> : public std::true_type {};
+
 template <class Field> struct isZOSparseMatrix<Field, Sparse<Field, SparseMatrix_t::COO_ZO>> : public std::true_type {};
 
 template <class Field> struct isZOSparseMatrix<Field, Sparse<Field, SparseMatrix_t::ELL_ZO>> : public std::true_type {};
@@ -93,6 +104,10 @@ template<class Field> struct isSparseMatrixSimdFormat<Field, Sparse<Field, Spars
 
 template<class Field> struct isSparseMatrixSimdFormat<Field, Sparse<Field, SparseMatrix_t::ELL_simd>> : public support_simd<typename Field::Element>::type {};
 
+template<class Field> struct isSparseMatrixSimdFormat<Field, Sparse<Field, SparseMatrix_t::SELL_ZO>> : public support_simd<typename Field::Element>::type {};
+
+template<class Field> struct isSparseMatrixSimdFormat<Field, Sparse<Field, SparseMatrix_t::ELL_simd_ZO>> : public support_simd<typename Field::Element>::type {};
+
 #endif // __FFLASFFPACK_USE_SIMD
 
 using SimdSparseMatrix = std::true_type;
@@ -35,6 +35,8 @@
 #include <algorithm>
 #include <numeric>
 #include <vector>
+#include <cmath>
+#include <iostream>
 
 namespace FFLAS{
 
@@ -66,33 +68,158 @@ struct StatsMatrix {
     uint64_t nEmptyRows = 0;
     uint64_t nEmptyCols = 0;
     uint64_t nEmptyColsEnd = 0;
+    // largest and average |i - j| over the entries (i, j), before and after the reordering
+    uint64_t bandwidth = 0;
+    uint64_t averageBandwidth = 0;
+    bool reordered = false;
+    uint64_t reorderedBandwidth = 0;
+    uint64_t reorderedAverageBandwidth = 0;
     std::vector<uint64_t> denseRows;
     std::vector<uint64_t> denseCols;
+
+    std::ostream &print(std::ostream &os = std::cout) const {
+        os << "dimensions : " << rowdim << " x " << coldim << ", nnz : " << nnz << std::endl;
+        os << "entries 1 / -1 / others : " << nOnes << " / " << nMOnes << " / " << nOthers << std::endl;
+        os << "row length min / max / average / deviation : " << minRow << " / " << maxRow << " / " << averageRow
+           << " / " << deviationRow << std::endl;
+        os << "col length min / max / average / deviation : " << minCol << " / " << maxCol << " / " << averageCol
+           << " / " << deviationCol << std::endl;
+        os << "empty rows / cols : " << nEmptyRows << " / " << nEmptyCols << std::endl;
+        os << "dense rows / cols : " << nDenseRows << " / " << nDenseCols << std::endl;
+        os << "bandwidth max / average : " << bandwidth << " / " << averageBandwidth << std::endl;
+        if (reordered)
+            os << "bandwidth after RCM max / average : " << reorderedBandwidth << " / " << reorderedAverageBandwidth
+               << std::endl;
+        return os;
+    }
 };
 
 template <class It> double computeDeviation(It begin, It end) {
-    using T = typename std::decay<decltype(*begin)>::type;
-    T average = 0;
-    average = std::accumulate(begin, end, 0) / (end - begin);
-    T sum = 0;
-    for (It i = begin; i != end; ++i) {
-        sum += ((*(i)) - average) * ((*(i)) - average);
+    if (begin == end)
+        return 0;
+    const double n = (double)(end - begin);
+    double average = 0;
+    for (It i = begin; i != end; ++i)
+        average += (double)(*i);
+    average /= n;
+    double sum = 0;
+    for (It i = begin; i != end; ++i)
+        sum += ((double)(*i) - average) * ((double)(*i) - average);
+    return std::sqrt(sum / n);
+}
+
+/* Reverse Cuthill-McKee ordering of a square matrix of dimension n given in
+ * coordinate format: perm[k] is the row (and column) of A put at position k.
+ * Each connected component of the graph of A + A^T is numbered by a breadth
+ * first search from a pseudo-peripheral vertex, visiting the neighbours by
+ * increasing degree, and the whole numbering is reversed.
+ */
+template <class IndexT>
+inline std::vector<index_t> rcmOrdering(const IndexT *row, const IndexT *col, uint64_t n, uint64_t nnz) {
+    // adjacency lists of A + A^T without the diagonal
+    std::vector<uint64_t> st(n + 1, 0);
+    for (uint64_t k = 0; k < nnz; ++k)
+        if (row[k] != col[k]) {
+            st[row[k] + 1]++;
+            st[col[k] + 1]++;
+        }
+    for (uint64_t i = 0; i < n; ++i)
+        st[i + 1] += st[i];
+    std::vector<index_t> adj(st[n]);
+    std::vector<uint64_t> next(st.begin(), st.end() - 1);
+    for (uint64_t k = 0; k < nnz; ++k)
+        if (row[k] != col[k]) {
+            adj[next[row[k]]++] = static_cast<index_t>(col[k]);
+            adj[next[col[k]]++] = static_cast<index_t>(row[k]);
+        }
+    std::vector<index_t> deg(n);
+    for (uint64_t i = 0; i < n; ++i) {
+        std::sort(adj.begin() + st[i], adj.begin() + st[i + 1]);
+        deg[i] = (index_t)(std::unique(adj.begin() + st[i], adj.begin() + st[i + 1]) - (adj.begin() + st[i]));
     }
-    return std::sqrt(sum / (end - begin));
+
+    std::vector<index_t> perm;
+    perm.reserve(n);
+    std::vector<char> visited(n, 0);
+    // levels of the breadth first search from r, in a component not numbered yet
+    std::vector<uint64_t> level(n, 0), mark(n, 0);
+    std::vector<index_t> queue;
+    uint64_t stamp = 0;
+    auto levels = [&](index_t r) {
+        ++stamp;
+        queue.assign(1, r);
+        mark[r] = stamp;
+        level[r] = 0;
+        for (size_t h = 0; h < queue.size(); ++h) {
+            const index_t u = queue[h];
+            for (uint64_t k = st[u]; k < st[u] + deg[u]; ++k)
+                if (mark[adj[k]] != stamp) {
+                    mark[adj[k]] = stamp;
+                    level[adj[k]] = level[u] + 1;
+                    queue.push_back(adj[k]);
+                }
+        }
+        return level[queue.back()];
+    };
+
+    std::vector<index_t> byDegree(n);
+    std::iota(byDegree.begin(), byDegree.end(), 0);
+    std::stable_sort(byDegree.begin(), byDegree.end(), [&deg](index_t a, index_t b) { return deg[a] < deg[b]; });
+    for (index_t v : byDegree) {
+        if (visited[v])
+            continue;
+        // pseudo-peripheral vertex (George and Liu): the vertex of smallest
+        // degree of the last level, while the eccentricity increases
+        index_t r = v;
+        uint64_t ecc = levels(r);
+        for (;;) {
+            index_t s = queue.back();
+            for (size_t h = queue.size(); h-- > 0 && level[queue[h]] == ecc;)
+                if (deg[queue[h]] < deg[s])
+                    s = queue[h];
+            const uint64_t e = levels(s);
+            if (e <= ecc)
+                break;
+            r = s;
+            ecc = e;
+        }
+        const size_t first = perm.size();
+        perm.push_back(r);
+        visited[r] = 1;
+        for (size_t h = first; h < perm.size(); ++h) {
+            const index_t u = perm[h];
+            const size_t begin = perm.size();
+            for (uint64_t k = st[u]; k < st[u] + deg[u]; ++k)
+                if (!visited[adj[k]]) {
+                    visited[adj[k]] = 1;
+                    perm.push_back(adj[k]);
+                }
+            std::stable_sort(perm.begin() + begin, perm.end(), [&deg](index_t a, index_t b) { return deg[a] < deg[b]; });
+        }
+    }
+    std::reverse(perm.begin(), perm.end());
+    return perm;
 }
 
-template <class Field>
-StatsMatrix getStat(const Field &F, const index_t *row, const index_t *col, typename Field::ConstElement_ptr val,
-              uint64_t rowdim, uint64_t coldim, uint64_t nnz) {
+/* Statistics of a matrix given in coordinate format, as for sparse_init:
+ * row lengths, column lengths, number of +1 and -1 entries, the rows
+ * (resp. columns) with at least DENSE_THRESHOLD * coldim (resp. rowdim)
+ * non zero entries, and the bandwidth. With reorder = RCM, the bandwidth of
+ * the matrix reordered as by sparse_init is computed too, for a square matrix.
+ */
+template <class Field, class IndexT>
+StatsMatrix getStat(const Field &F, const IndexT *row, const IndexT *col, typename Field::ConstElement_ptr val,
+              uint64_t rowdim, uint64_t coldim, uint64_t nnz, SparseReordering reorder = SparseReordering::NONE) {
     StatsMatrix stats;
     stats.nnz = nnz;
     stats.rowdim = rowdim;
     stats.coldim = coldim;
-    std::vector<int64_t> rows(rowdim+1);
-    std::vector<int64_t> cols(coldim);
-    std::fill(rows.begin(), rows.end(), 0);
-    std::fill(cols.begin(), cols.end(), 0);
+    if (rowdim == 0 || coldim == 0)
+        return stats;
+    std::vector<uint64_t> rows(rowdim, 0);
+    std::vector<uint64_t> cols(coldim, 0);
     for (uint64_t i = 0; i < nnz; ++i) {
+        rows[row[i]]++;
         cols[col[i]]++;
         if (F.isOne(val[i])) {
             stats.nOnes++;
@@ -102,29 +229,151 @@ StatsMatrix getStat(const Field &F, const index_t *row, const index_t *col, type
             stats.nOthers++;
         }
     }
-    rows[0] = row[0];
-    for(size_t i = 1 ; i < rowdim+1 ; ++i){
-        rows[i] = row[i] - row[i-1];
-    }
     stats.nEmptyRows = std::count(rows.begin(), rows.end(), 0);
     stats.nEmptyCols = std::count(cols.begin(), cols.end(), 0);
+    for (auto it = cols.rbegin(); it != cols.rend() && *it == 0; ++it)
+        stats.nEmptyColsEnd++;
     auto rowMinMax = std::minmax_element(rows.begin(), rows.end());
     auto colMinMax = std::minmax_element(cols.begin(), cols.end());
     stats.minRow = (*(rowMinMax.first));
     stats.maxRow = (*(rowMinMax.second));
     stats.minCol = (*(colMinMax.first));
     stats.maxCol = (*(colMinMax.second));
-    stats.averageRow = std::accumulate(rows.begin(), rows.end(), 0) / rowdim;
-    stats.averageCol = std::accumulate(cols.begin(), cols.end(), 0) / coldim;
+    stats.averageRow = nnz / rowdim;
+    stats.averageCol = nnz / coldim;
     stats.deviationRow = (uint64_t)computeDeviation(rows.begin(), rows.end());
     stats.deviationCol = (uint64_t)computeDeviation(cols.begin(), cols.end());
-    stats.nDenseRows = std::count_if(rows.begin(), rows.begin(),
-                                     [rowdim](uint64_t &x) { return x >= DENSE_THRESHOLD * rowdim; });
-    stats.nDenseCols = std::count_if(cols.begin(), cols.begin(),
-                                     [coldim](uint64_t &x) { return x >= DENSE_THRESHOLD * coldim; });
+    for (uint64_t i = 0; i < rowdim; ++i)
+        if (rows[i] >= DENSE_THRESHOLD * coldim)
+            stats.denseRows.push_back(i);
+    for (uint64_t j = 0; j < coldim; ++j)
+        if (cols[j] >= DENSE_THRESHOLD * rowdim)
+            stats.denseCols.push_back(j);
+    stats.nDenseRows = stats.denseRows.size();
+    stats.nDenseCols = stats.denseCols.size();
+    uint64_t sum = 0;
+    for (uint64_t k = 0; k < nnz; ++k) {
+        const uint64_t d = (row[k] > col[k]) ? row[k] - col[k] : col[k] - row[k];
+        stats.bandwidth = std::max(stats.bandwidth, d);
+        sum += d;
+    }
+    stats.averageBandwidth = (nnz > 0) ? sum / nnz : 0;
+    if (reorder == SparseReordering::RCM && rowdim == coldim) {
+        const std::vector<index_t> perm = rcmOrdering(row, col, rowdim, nnz);
+        std::vector<index_t> inv(rowdim);
+        for (uint64_t k = 0; k < rowdim; ++k)
+            inv[perm[k]] = (index_t)k;
+        sum = 0;
+        for (uint64_t k = 0; k < nnz; ++k) {
+            const uint64_t i = inv[row[k]], j = inv[col[k]];
+            const uint64_t d = (i > j) ? i - j : j - i;
+            stats.reorderedBandwidth = std::max(stats.reorderedBandwidth, d);
+            sum += d;
+        }
+        stats.reorderedAverageBandwidth = (nnz > 0) ? sum / nnz : 0;
+        stats.reordered = true;
+    }
     return stats;
 }
 
+namespace sparse_details {
+
+/* The padding entries of the chunked ZO formats (ELL_simd_ZO, SELL_ZO) have
+ * column n, their products read X through a copy with a zero row appended.
+ * Returns that copy, of leading dimension blockSize, or nullptr when A has no
+ * padding and X can be read directly.
+ */
+template <class Field, class SM>
+inline typename Field::Element_ptr zo_padded_input(const Field &F, const SM &A, size_t blockSize,
+                                                   typename Field::ConstElement_ptr x, int ldx) {
+    if (A.nElements == A.nnz)
+        return nullptr;
+    typename Field::Element_ptr x1 = fflas_new(F, A.n + 1, blockSize, Alignment::CACHE_LINE);
+    fassign(F, A.n, blockSize, x, ldx, x1, blockSize);
+    fzero(F, 1, blockSize, x1 + A.n * blockSize, blockSize);
+    return x1;
+}
+
+/* Permuted copies of x and y for the products of a matrix stored as P A P^T
+ * (see reordered_product), n x blockSize each. They are allocated with the
+ * reordering for one vector, grown to the largest block multiplied so far,
+ * and shared with the transposed views: the products with a same reordered
+ * matrix must not run concurrently.
+ */
+template <class Field> struct ReorderScratch {
+    size_t blockSize = 0;
+    typename Field::Element_ptr x = nullptr;
+    typename Field::Element_ptr y = nullptr;
+};
+
+template <class Field> inline void reorder_scratch_reserve(ReorderScratch<Field> &S, const size_t n, const size_t blockSize) {
+    if (S.blockSize >= blockSize)
+        return;
+    fflas_delete(S.x, S.y);
+    S.x = fflas_new<typename Field::Element>(n * blockSize, Alignment::CACHE_LINE);
+    S.y = fflas_new<typename Field::Element>(n * blockSize, Alignment::CACHE_LINE);
+    S.blockSize = blockSize;
+}
+
+template <class Field> inline void reorder_scratch_delete(ReorderScratch<Field> *S) {
+    if (S == nullptr)
+        return;
+    fflas_delete(S->x, S->y);
+    delete S;
+}
+
+/* Reordering of the formats storing P A P^T (CSR, SELL and their ZO versions,
+ * see SparseReordering): the order of their rows and the scratch of their
+ * products, nullptr for the others.
+ */
+template <class SM> inline auto reordering(const SM &A, int) -> decltype((const index_t *)A.reorder) {
+    return A.reorder;
+}
+
+template <class SM> inline const index_t *reordering(const SM &, long) { return nullptr; }
+
+template <class Field, class SM>
+inline auto reorder_scratch(const SM &A, int) -> decltype((ReorderScratch<Field> *)A.reorderScratch) {
+    return A.reorderScratch;
+}
+
+template <class Field, class SM> inline ReorderScratch<Field> *reorder_scratch(const SM &, long) { return nullptr; }
+
+/* sparse_init with a reordering, for a square matrix: init(row, col, dat) is
+ * sparse_init on the entries of P A P^T sorted by rows, and A keeps the
+ * permutation and the scratch of its products. dat may be nullptr for the ZO
+ * formats.
+ */
+template <class Field, class SM, class IndexT, class Init>
+inline void sparse_init_reordered(SM &A, const IndexT *row, const IndexT *col, typename Field::ConstElement_ptr dat,
+                                  uint64_t rowdim, uint64_t nnz, Init init) {
+    const std::vector<index_t> perm = rcmOrdering(row, col, rowdim, nnz);
+    std::vector<index_t> inv(rowdim);
+    for (uint64_t k = 0; k < rowdim; ++k)
+        inv[perm[k]] = (index_t)k;
+    std::vector<uint64_t> st(rowdim + 1, 0);
+    for (uint64_t k = 0; k < nnz; ++k)
+        st[inv[row[k]] + 1]++;
+    for (uint64_t i = 0; i < rowdim; ++i)
+        st[i + 1] += st[i];
+    std::vector<index_t> prow(nnz), pcol(nnz);
+    std::vector<typename Field::Element> pdat((dat != nullptr) ? nnz : 0);
+    for (uint64_t k = 0; k < nnz; ++k) {
+        const uint64_t p = st[inv[row[k]]]++;
+        prow[p] = inv[row[k]];
+        pcol[p] = inv[col[k]];
+        if (dat != nullptr)
+            pdat[p] = dat[k];
+    }
+    init(prow.data(), pcol.data(), (dat != nullptr) ? pdat.data() : nullptr);
+    A.reorder = fflas_new<index_t>(rowdim, Alignment::CACHE_LINE);
+    std::copy(perm.begin(), perm.end(), A.reorder);
+    A.reorderScratch = new ReorderScratch<Field>;
+    reorder_scratch_reserve(*A.reorderScratch, rowdim, 1);
+}
+
+} // sparse_details
+
 }
 
 #endif
@@ -214,6 +214,21 @@ namespace FFPACK { /* Permutations */
 	      typename Field::Element_ptr A, const size_t lda,
 	      size_t* P, size_t* Q, int nt);
 
+	/** Parallel PLUQ on tiles of nb rows with look-ahead.
+	 * The trailing update of a tile by the step k is a task depending on the
+	 * factorization of the tile k and on the previous updates of the tile only:
+	 * the factorization of the tile k+1 overlaps the other updates of the step k.
+	 * With dataflow (__FFLASFFPACK_USE_DATAFLOW) the steps also overlap each other.
+	 * @param nt number of threads
+	 * @param nb number of rows of the tiles (0 for a default depending on nt)
+	 */
+	template<class Field>
+	size_t
+	pPLUQ_tile(const Field& Fi, const FFLAS::FFLAS_DIAG Diag,
+		   const size_t M, const size_t N,
+		   typename Field::Element_ptr A, const size_t lda,
+		   size_t* P, size_t* Q, int nt, size_t nb=0);
+
 
 //#endif
 
@@ -433,6 +448,145 @@ namespace FFPACK { /* PLUQ */
 } // FFPACK PLUQ
 // #include "ffpack_pluq.inl"
 
+namespace FFPACK { /* batched */
+
+	/** @brief PLUQ factorizations of a batch of small matrices of the same shape.
+	 * Each \p M x \p N matrix <code>A[b]</code>, \f$0 \leq b < \f$ \p batchCount, of
+	 * leading dimension \p lda, is overwritten by its PLUQ factorization as with PLUQ;
+	 * <code>P[b]</code> and <code>Q[b]</code> receive its permutations, using LAPACK's
+	 * convention, and <code>ranks[b]</code> its rank.
+	 * @param psH FFLAS::ParSeqHelper::Sequential (the default), or
+	 * FFLAS::ParSeqHelper::Parallel to distribute the batch over threads
+	 */
+	template<class Field, class PSHelper>
+	void
+	PLUQ_batched (const Field& F, const FFLAS::FFLAS_DIAG Diag,
+		      const size_t M, const size_t N,
+		      typename Field::Element_ptr const* A, const size_t lda,
+		      size_t* const* P, size_t* const* Q, size_t* ranks,
+		      const size_t batchCount, const PSHelper& psH);
+
+	template<class Field>
+	void
+	PLUQ_batched (const Field& F, const FFLAS::FFLAS_DIAG Diag,
+		      const size_t M, const size_t N,
+		      typename Field::Element_ptr const* A, const size_t lda,
+		      size_t* const* P, size_t* const* Q, size_t* ranks,
+		      const size_t batchCount);
+
+	/** Strided PLUQ_batched: the \c b-th matrix is at <code>A+b*strideA</code> and its
+	 * permutations at <code>P+b*M</code> and <code>Q+b*N</code>.
+	 */
+	template<class Field, class PSHelper>
+	void
+	PLUQ_batched (const Field& F, const FFLAS::FFLAS_DIAG Diag,
+		      const size_t M, const size_t N,
+		      typename Field::Element_ptr A, const size_t lda, const size_t strideA,
+		      size_t* P, size_t* Q, size_t* ranks,
+		      const size_t batchCount, const PSHelper& psH);
+
+	template<class Field>
+	void
+	PLUQ_batched (const Field& F, const FFLAS::FFLAS_DIAG Diag,
+		      const size_t M, const size_t N,
+		      typename Field::Element_ptr A, const size_t lda, const size_t strideA,
+		      size_t* P, size_t* Q, size_t* ranks,
+		      const size_t batchCount);
+
+	/** @brief Ranks of a batch of small matrices of the same shape.
+	 * <code>ranks[b]</code> receives the rank of the \p M x \p N matrix <code>A[b]</code>,
+	 * \f$0 \leq b < \f$ \p batchCount. Unlike Rank, the matrices are left unchanged.
+	 * @param psH FFLAS::ParSeqHelper::Sequential (the default), or
+	 * FFLAS::ParSeqHelper::Parallel to distribute the batch over threads
+	 */
+	template<class Field, class PSHelper>
+	void
+	Rank_batched (const Field& F, const size_t M, const size_t N,
+		      typename Field::ConstElement_ptr const* A, const size_t lda,
+		      size_t* ranks, const size_t batchCount, const PSHelper& psH);
+
+	template<class Field>
+	void
+	Rank_batched (const Field& F, const size_t M, const size_t N,
+		      typename Field::ConstElement_ptr const* A, const size_t lda,
+		      size_t* ranks, const size_t batchCount);
+
+	//! Strided Rank_batched: the \c b-th matrix is at <code>A+b*strideA</code>.
+	template<class Field, class PSHelper>
+	void
+	Rank_batched (const Field& F, const size_t M, const size_t N,
+		      typename Field::ConstElement_ptr A, const size_t lda, const size_t strideA,
+		      size_t* ranks, const size_t batchCount, const PSHelper& psH);
+
+	template<class Field>
+	void
+	Rank_batched (const Field& F, const size_t M, const size_t N,
+		      typename Field::ConstElement_ptr A, const size_t lda, const size_t strideA,
+		      size_t* ranks, const size_t batchCount);
+
+	/** Rank_batched on interleaved matrices: entry \f$(i,j)\f$ of the \c b-th matrix is
+	 * at <code>A[(i*N+j)*batchCount+b]</code>, as for FFLAS::fgemm_batched_interleaved.
+	 * \p A is overwritten.
+	 */
+	template<class Field, class PSHelper>
+	void
+	Rank_batched_interleaved (const Field& F, const size_t M, const size_t N,
+				  typename Field::Element_ptr A, size_t* ranks,
+				  const size_t batchCount, const PSHelper& psH);
+
+	template<class Field>
+	void
+	Rank_batched_interleaved (const Field& F, const size_t M, const size_t N,
+				  typename Field::Element_ptr A, size_t* ranks, const size_t batchCount);
+
+} // FFPACK batched
+// #include "ffpack_batched.inl"
+
+namespace FFPACK { /* fsytrf */
+
+	/** @brief Computes the LDLT factorization of a symmetric matrix, with symmetric pivoting.
+	 *
+	 * Computes \f$ P A P^T = L D L^T \f$ (or \f$ U^T D U \f$ for \c UpLo==FflasUpper),
+	 * \c L unit lower triangular. Only the \p UpLo triangle of \p A is
+	 * referenced and it is overwritten by \c L (or \c U) and \c D. The
+	 * factorization is recursive: the off diagonal blocks are updated by
+	 * ftrsm and fgemm, the diagonal ones by fsyrk. The pivots are the non zero
+	 * diagonal entries of the Schur complements: if the returned number of
+	 * pivots \c r is less than \p N, the trailing \c (N-r)x(N-r) block is the
+	 * Schur complement, of zero diagonal, and \p A has rank \c r if and only
+	 * if it is zero (a non zero one, like \f$\begin{bmatrix}0&1\\1&0\end{bmatrix}\f$,
+	 * has no LDLT factorization with a diagonal \c D).
+	 * @param F field
+	 * @param UpLo which triangle of \p A is stored
+	 * @param N dimension of \p A
+	 * @param A input matrix
+	 * @param lda leading dimension of \p A
+	 * @param P the symmetric permutation, in LAPACK's convention (applied to the rows and to the columns of \p A)
+	 * @return the number of pivots
+	 */
+	template <class Field>
+	size_t
+	fsytrf (const Field& F, const FFLAS::FFLAS_UPLO UpLo, const size_t N,
+		typename Field::Element_ptr A, const size_t lda, size_t* P);
+
+	template <class Field>
+	size_t
+	fsytrf (const Field& F, const FFLAS::FFLAS_UPLO UpLo, const size_t N,
+		typename Field::Element_ptr A, const size_t lda, size_t* P,
+		const FFLAS::ParSeqHelper::Sequential seq);
+
+	/** Parallel fsytrf: \p par is given to ftrsm, fgemm and fsyrk, to be
+	 * run in a parallel region (PAR_BLOCK).
+	 */
+	template <class Field, class Cut, class Param>
+	size_t
+	fsytrf (const Field& F, const FFLAS::FFLAS_UPLO UpLo, const size_t N,
+		typename Field::Element_ptr A, const size_t lda, size_t* P,
+		const FFLAS::ParSeqHelper::Parallel<Cut,Param> par);
+
+} // FFPACK fsytrf
+// #include "ffpack_fsytrf.inl"
+
 namespace FFPACK { /* ludivine */
 
 	/** @brief Compute the CUP factorization of the given matrix.
@@ -519,6 +673,20 @@ namespace FFPACK { /* ludivine */
 				    , const size_t kg_j  =0
 				  );
 
+		template <class Field, class PSHelper>
+		size_t
+		LUdivine_construct( const Field& F, const FFLAS::FFLAS_DIAG Diag,
+				    const size_t M, const size_t N,
+				    typename Field::ConstElement_ptr A, const size_t lda,
+				    typename Field::Element_ptr X, const size_t ldx,
+				    typename Field::Element_ptr u, size_t* P,
+				    bool computeX, const FFPACK_MINPOLY_TAG MinTag
+				    , const size_t kg_mc
+				    , const size_t kg_mb
+				    , const size_t kg_j
+				    , const PSHelper& psH
+				  );
+
 	} // Protected
 
 } //FFPACK ludivine, turbo
@@ -762,6 +930,25 @@ namespace FFPACK { /* charpoly */
 		  typename Field::Element_ptr A, const size_t lda,
 		  const FFPACK_CHARPOLY_TAG CharpTag= FfpackArithProg);
 
+	/** Characteristic polynomial with the fgemm, ftrsm and Krylov iterations
+	 * run with the given ParSeqHelper.
+	 * Only FfpackLUK and FfpackArithProg have a parallel variant, the other
+	 * tags fall back to the sequential code.
+	 * @param psH ParSeqHelper::Sequential or ParSeqHelper::Parallel<Block,Threads>,
+	 * to be called inside a PAR_BLOCK.
+	 */
+	template <class Field, class Polynomial, class PSHelper>
+	std::list<Polynomial>&
+	CharPoly( const Field& F, std::list<Polynomial>& charp, const size_t N,
+		  typename Field::Element_ptr A, const size_t lda,
+		  const FFPACK_CHARPOLY_TAG CharpTag, const PSHelper& psH);
+
+	template <class Field, class Polynomial, class PSHelper>
+	Polynomial&
+	CharPoly( const Field& F, Polynomial& charp, const size_t N,
+		  typename Field::Element_ptr A, const size_t lda,
+		  const FFPACK_CHARPOLY_TAG CharpTag, const PSHelper& psH);
+
 
 	namespace Protected {
 		template <class Field, class Polynomial>
@@ -796,6 +983,12 @@ namespace FFPACK { /* charpoly */
 			  typename Field::Element_ptr A, const size_t lda,
 			  typename Field::Element_ptr U, const size_t ldu);
 
+		template <class Field, class Polynomial, class PSHelper>
+		std::list<Polynomial>&
+		LUKrylov( const Field& F, std::list<Polynomial>& charp, const size_t N,
+			  typename Field::Element_ptr A, const size_t lda,
+			  typename Field::Element_ptr U, const size_t ldu, const PSHelper& psH);
+
 		template <class Field, class Polynomial>
 		std::list<Polynomial>&
 		Danilevski (const Field& F, std::list<Polynomial>& charp,
@@ -821,6 +1014,13 @@ namespace FFPACK { /* frobenius, charpoly */
 	CharpolyArithProg (const Field& F, std::list<Polynomial>& frobeniusForm,
 			   const size_t N, typename Field::Element_ptr A, const size_t lda, const size_t c);
 
+	//! Frobenius form with the fgemm and ftrsm calls run with the ParSeqHelper psH
+	template <class Field, class Polynomial, class PSHelper>
+	std::list<Polynomial>&
+	CharpolyArithProg (const Field& F, std::list<Polynomial>& frobeniusForm,
+			   const size_t N, typename Field::Element_ptr A, const size_t lda, const size_t c,
+			   const PSHelper& psH);
+
 
 } // FFPACK frobenius
 // #include "ffpack_frobenius.inl"
@@ -846,6 +1046,18 @@ namespace FFPACK { /* minpoly */
 		 const FFPACK_MINPOLY_TAG MinTag= FFPACK::FfpackDense,
 		 const size_t kg_mc=0, const size_t kg_mb=0, const size_t kg_j=0 );
 
+	/** Minimal polynomial with the Krylov iterates, ftrsm and fgemm run with
+	 * the ParSeqHelper psH.
+	 */
+	template <class Field, class Polynomial, class PSHelper>
+	Polynomial&
+	MinPoly( const Field& F, Polynomial& minP, const size_t N,
+		 typename Field::ConstElement_ptr A, const size_t lda,
+		 typename Field::Element_ptr X, const size_t ldx, size_t* P,
+		 const FFPACK_MINPOLY_TAG MinTag,
+		 const size_t kg_mc, const size_t kg_mb, const size_t kg_j,
+		 const PSHelper& psH);
+
 } // FFPACK minpoly
 // #include "ffpack_minpoly.inl"
 
@@ -1431,6 +1643,8 @@ namespace FFPACK { /* not used */
 #include "ffpack_pluq.inl"
 #include "ffpack_pluq_mp.inl"
 #include "ffpack_ppluq.inl"
+#include "ffpack_fsytrf.inl"
+#include "ffpack_batched.inl"
 #include "ffpack_ludivine.inl"
 #include "ffpack_ludivine_mp.inl"
 #include "ffpack_echelonforms.inl"
@@ -0,0 +1,349 @@
+/* -*- mode: C++; tab-width: 8; indent-tabs-mode: t; c-basic-offset: 8 -*- */
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/*
+ * Copyright (C) 2016 the FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ *.
+ */
+
+/** @file ffpack/ffpack_batched.inl
+ * @brief PLUQ and rank of many small matrices of the same shape.
+ *
+ * Rank_batched interleaves the matrices by groups of one SIMD vector, as
+ * fgemm_batched does, and reduces the rows of each matrix against an echelon
+ * basis: the row operations work on \c vect_size matrices at once, only the
+ * choice of the pivots is made lane by lane.
+ * PLUQ_batched has to produce one pair of permutations per matrix, and calls
+ * the Crout base case of PLUQ on each matrix of the batch.
+ */
+
+#ifndef __FFLASFFPACK_ffpack_batched_INL
+#define __FFLASFFPACK_ffpack_batched_INL
+
+#include <vector>
+
+#ifndef __FFLASFFPACK_PLUQ_BATCHED_BASECASE
+//! largest min(M,N) for which PLUQ_batched uses the Crout base case
+#define __FFLASFFPACK_PLUQ_BATCHED_BASECASE 64
+#endif
+
+namespace FFPACK { namespace Protected { namespace batched {
+
+	/** \internal
+	 * Generic lane of an interleaved rank computation.
+	 * \p A is \p M x \p N with stride \p inc between consecutive entries,
+	 * \p E (\p N x \p N) and \p has (\p N) are workspaces with the same stride,
+	 * where row \c c of \p E is the basis row with pivot in column \c c, if <code>has[c]</code>.
+	 */
+	template<class Field>
+	inline size_t rank_lane (const Field& F, const size_t M, const size_t N,
+				 typename Field::Element* A, const size_t inc,
+				 typename Field::Element* E, typename Field::Element* has)
+	{
+		size_t rank = 0;
+		for (size_t c = 0; c < N; ++c) F.assign(has[c*inc], F.zero);
+		for (size_t i = 0; i < M && rank < N; ++i) {
+			typename Field::Element* Ri = A + i*N*inc;
+			for (size_t c = 0; c < N; ++c) {
+				if (F.isZero(Ri[c*inc])) continue;
+				typename Field::Element* Ec = E + c*N*inc;
+				if (F.isZero(has[c*inc])) {
+					typename Field::Element inv;
+					F.init(inv);
+					F.inv(inv, Ri[c*inc]);
+					for (size_t j = c; j < N; ++j)
+						F.mul(Ec[j*inc], Ri[j*inc], inv);
+					F.assign(has[c*inc], F.one);
+					++rank;
+					break;
+				}
+				typename Field::Element mult;
+				F.init(mult);
+				F.neg(mult, Ri[c*inc]);
+				for (size_t j = c; j < N; ++j)
+					F.axpyin(Ri[j*inc], mult, Ec[j*inc]);
+			}
+		}
+		return rank;
+	}
+
+#ifdef __FFLASFFPACK_USE_SIMD
+	/** \internal
+	 * SIMD part of rank_interleaved: full vectors of lanes of \f$[0,nb[\f$,
+	 * returns the number of lanes done.
+	 * The elimination by the basis row of column \c c is done on every lane,
+	 * with a multiplier cancelled by <code>has[c]</code> in \f$\{0,1\}\f$ on the lanes
+	 * having no such row; one product is accumulated before each reduction.
+	 */
+	template<class Field>
+	inline size_t rank_interleaved_simd (const Field& F, const size_t M, const size_t N,
+					     typename Field::Element* A, const size_t inc, const size_t nb,
+					     typename Field::Element* E, typename Field::Element* has,
+					     size_t* ranks, std::true_type)
+	{
+		typedef FFLAS::Protected::batched::BatchTraits<Field> BT;
+		typedef typename BT::simd simd;
+		typedef typename simd::vect_t vect_t;
+		const size_t vs = BT::vect_size;
+		FFLAS::vectorised::HelperModSimd<Field, simd> H(F);
+
+		size_t b = 0;
+		for (; b+vs <= nb; b += vs) {
+			bool placed[BT::vect_size];
+			for (size_t l = 0; l < vs; ++l) ranks[b+l] = 0;
+			for (size_t c = 0; c < N; ++c)
+				simd::storeu(has+c*inc+b, simd::zero());
+			for (size_t i = 0; i < M; ++i) {
+				typename Field::Element* Ri = A + i*N*inc + b;
+				for (size_t l = 0; l < vs; ++l) placed[l] = (ranks[b+l] == N);
+				for (size_t c = 0; c < N; ++c) {
+					typename Field::Element* Ec = E + c*N*inc + b;
+					const vect_t mult = simd::mul(simd::loadu(Ri+c*inc), simd::loadu(has+c*inc+b));
+					for (size_t j = c; j < N; ++j) {
+						vect_t r = simd::fnmadd(simd::loadu(Ri+j*inc), mult, simd::loadu(Ec+j*inc));
+						FFLAS::vectorised::VEC_MOD<Field,simd,0>(r,H);
+						simd::storeu(Ri+j*inc, r);
+					}
+					// new basis rows
+					for (size_t l = 0; l < vs; ++l) {
+						if (placed[l] || !F.isZero(has[c*inc+b+l]) || F.isZero(Ri[c*inc+l]))
+							continue;
+						typename Field::Element inv;
+						F.init(inv);
+						F.inv(inv, Ri[c*inc+l]);
+						for (size_t j = c; j < N; ++j)
+							F.mul(Ec[j*inc+l], Ri[j*inc+l], inv);
+						F.assign(has[c*inc+b+l], F.one);
+						placed[l] = true;
+						++ranks[b+l];
+					}
+				}
+			}
+		}
+		return b;
+	}
+#endif
+
+	template<class Field>
+	inline size_t rank_interleaved_simd (const Field&, const size_t, const size_t,
+					     typename Field::Element*, const size_t, const size_t,
+					     typename Field::Element*, typename Field::Element*,
+					     size_t*, std::false_type)
+	{
+		return 0;
+	}
+
+	/** \internal
+	 * Ranks of the lanes \f$[0,nb[\f$ of interleaved \p M x \p N matrices, which are overwritten.
+	 * \p E and \p has are \p N x \p N and \p N interleaved workspaces of stride \p inc.
+	 */
+	template<class Field>
+	inline void rank_interleaved (const Field& F, const size_t M, const size_t N,
+				      typename Field::Element* A, const size_t inc, const size_t nb,
+				      typename Field::Element* E, typename Field::Element* has,
+				      size_t* ranks, const bool vectorised)
+	{
+		size_t b = 0;
+		if (vectorised)
+			b = rank_interleaved_simd(F, M, N, A, inc, nb, E, has, ranks,
+						  std::integral_constant<bool, FFLAS::Protected::batched::BatchTraits<Field>::vectorised>());
+		for (; b < nb; ++b)
+			ranks[b] = rank_lane(F, M, N, A+b, inc, E+b, has+b);
+	}
+
+	//! ranks of the matrices \f$[first,last[\f$ of a pointer array, by interleaved groups
+	template<class Field>
+	inline void rank_range (const Field& F, const size_t M, const size_t N,
+				typename Field::ConstElement_ptr const* A, const size_t lda,
+				size_t* ranks, const size_t first, const size_t last, const bool vectorised)
+	{
+		typedef typename Field::Element Element;
+		const size_t G = FFLAS::Protected::batched::BatchTraits<Field>::vect_size;
+		Element* W = FFLAS::fflas_new<Element>((M*N+N*N+N)*G, Alignment::CACHE_LINE);
+		for (size_t i = 0; i < (M*N+N*N+N)*G; ++i) F.assign(W[i], F.zero);
+		Element* E = W + M*N*G;
+		Element* has = E + N*N*G;
+		for (size_t b0 = first; b0 < last; b0 += G) {
+			const size_t nb = std::min(G, last-b0);
+			FFLAS::Protected::batched::interleave<Element>(W, G, A+b0, nb, M, N, lda);
+			size_t r[FFLAS::Protected::batched::BatchTraits<Field>::vect_size];
+			// the lanes past nb are computed and discarded
+			rank_interleaved(F, M, N, W, G, G, E, has, r, vectorised);
+			for (size_t l = 0; l < nb; ++l) ranks[b0+l] = r[l];
+		}
+		FFLAS::fflas_delete(W);
+	}
+
+	//! PLUQ of the matrices \f$[first,last[\f$ of pointer arrays
+	template<class Field>
+	inline void pluq_range (const Field& F, const FFLAS::FFLAS_DIAG Diag, const size_t M, const size_t N,
+				typename Field::Element_ptr const* A, const size_t lda,
+				size_t* const* P, size_t* const* Q, size_t* ranks,
+				const size_t first, const size_t last)
+	{
+		const bool crout = std::min(M,N) <= __FFLASFFPACK_PLUQ_BATCHED_BASECASE;
+		for (size_t b = first; b < last; ++b)
+			ranks[b] = crout ? PLUQ_basecaseCrout(F, Diag, M, N, A[b], lda, P[b], Q[b])
+				         : PLUQ(F, Diag, M, N, A[b], lda, P[b], Q[b]);
+	}
+
+} // batched
+} // Protected
+} // FFPACK
+
+namespace FFPACK {
+
+	template<class Field, class PSHelper>
+	inline void
+	PLUQ_batched (const Field& F, const FFLAS::FFLAS_DIAG Diag,
+		      const size_t M, const size_t N,
+		      typename Field::Element_ptr const* A, const size_t lda,
+		      size_t* const* P, size_t* const* Q, size_t* ranks,
+		      const size_t batchCount, const PSHelper& psH)
+	{
+		auto range = [&](size_t b0, size_t b1) {
+			Protected::batched::pluq_range(F, Diag, M, N, A, lda, P, Q, ranks, b0, b1);
+		};
+		FFLAS::Protected::batched::forGroups(batchCount, range, psH);
+	}
+
+	template<class Field>
+	inline void
+	PLUQ_batched (const Field& F, const FFLAS::FFLAS_DIAG Diag,
+		      const size_t M, const size_t N,
+		      typename Field::Element_ptr const* A, const size_t lda,
+		      size_t* const* P, size_t* const* Q, size_t* ranks,
+		      const size_t batchCount)
+	{
+		PLUQ_batched(F, Diag, M, N, A, lda, P, Q, ranks, batchCount, FFLAS::ParSeqHelper::Sequential());
+	}
+
+	template<class Field, class PSHelper>
+	inline void
+	PLUQ_batched (const Field& F, const FFLAS::FFLAS_DIAG Diag,
+		      const size_t M, const size_t N,
+		      typename Field::Element_ptr A, const size_t lda, const size_t strideA,
+		      size_t* P, size_t* Q, size_t* ranks,
+		      const size_t batchCount, const PSHelper& psH)
+	{
+		std::vector<typename Field::Element_ptr> Ab(batchCount);
+		std::vector<size_t*> Pb(batchCount), Qb(batchCount);
+		for (size_t b = 0; b < batchCount; ++b) {
+			Ab[b] = A+b*strideA;
+			Pb[b] = P+b*M;
+			Qb[b] = Q+b*N;
+		}
+		PLUQ_batched(F, Diag, M, N, Ab.data(), lda, Pb.data(), Qb.data(), ranks, batchCount, psH);
+	}
+
+	template<class Field>
+	inline void
+	PLUQ_batched (const Field& F, const FFLAS::FFLAS_DIAG Diag,
+		      const size_t M, const size_t N,
+		      typename Field::Element_ptr A, const size_t lda, const size_t strideA,
+		      size_t* P, size_t* Q, size_t* ranks,
+		      const size_t batchCount)
+	{
+		PLUQ_batched(F, Diag, M, N, A, lda, strideA, P, Q, ranks, batchCount, FFLAS::ParSeqHelper::Sequential());
+	}
+
+	template<class Field, class PSHelper>
+	inline void
+	Rank_batched (const Field& F, const size_t M, const size_t N,
+		      typename Field::ConstElement_ptr const* A, const size_t lda,
+		      size_t* ranks, const size_t batchCount, const PSHelper& psH)
+	{
+		if (!M || !N) {
+			for (size_t b = 0; b < batchCount; ++b) ranks[b] = 0;
+			return;
+		}
+		const size_t G = FFLAS::Protected::batched::BatchTraits<Field>::vect_size;
+		const bool vectorised = FFLAS::Protected::batched::MaxDelayedProducts(F) > 0;
+		auto range = [&](size_t g0, size_t g1) {
+			Protected::batched::rank_range(F, M, N, A, lda, ranks, g0*G, std::min(g1*G, batchCount), vectorised);
+		};
+		FFLAS::Protected::batched::forGroups((batchCount+G-1)/G, range, psH);
+	}
+
+	template<class Field>
+	inline void
+	Rank_batched (const Field& F, const size_t M, const size_t N,
+		      typename Field::ConstElement_ptr const* A, const size_t lda,
+		      size_t* ranks, const size_t batchCount)
+	{
+		Rank_batched(F, M, N, A, lda, ranks, batchCount, FFLAS::ParSeqHelper::Sequential());
+	}
+
+	template<class Field, class PSHelper>
+	inline void
+	Rank_batched (const Field& F, const size_t M, const size_t N,
+		      typename Field::ConstElement_ptr A, const size_t lda, const size_t strideA,
+		      size_t* ranks, const size_t batchCount, const PSHelper& psH)
+	{
+		std::vector<typename Field::ConstElement_ptr> Ab(batchCount);
+		for (size_t b = 0; b < batchCount; ++b)
+			Ab[b] = A+b*strideA;
+		Rank_batched(F, M, N, Ab.data(), lda, ranks, batchCount, psH);
+	}
+
+	template<class Field>
+	inline void
+	Rank_batched (const Field& F, const size_t M, const size_t N,
+		      typename Field::ConstElement_ptr A, const size_t lda, const size_t strideA,
+		      size_t* ranks, const size_t batchCount)
+	{
+		Rank_batched(F, M, N, A, lda, strideA, ranks, batchCount, FFLAS::ParSeqHelper::Sequential());
+	}
+
+	template<class Field, class PSHelper>
+	inline void
+	Rank_batched_interleaved (const Field& F, const size_t M, const size_t N,
+				  typename Field::Element_ptr A, size_t* ranks,
+				  const size_t batchCount, const PSHelper& psH)
+	{
+		if (!M || !N) {
+			for (size_t b = 0; b < batchCount; ++b) ranks[b] = 0;
+			return;
+		}
+		typedef typename Field::Element Element;
+		const size_t G = FFLAS::Protected::batched::BatchTraits<Field>::vect_size;
+		const bool vectorised = FFLAS::Protected::batched::MaxDelayedProducts(F) > 0;
+		Element* W = FFLAS::fflas_new<Element>((N*N+N)*batchCount, Alignment::CACHE_LINE);
+		for (size_t i = 0; i < (N*N+N)*batchCount; ++i) F.assign(W[i], F.zero);
+		auto range = [&](size_t g0, size_t g1) {
+			const size_t b0 = g0*G;
+			Protected::batched::rank_interleaved(F, M, N, A+b0, batchCount, std::min(g1*G, batchCount)-b0,
+							     W+b0, W+N*N*batchCount+b0, ranks+b0, vectorised);
+		};
+		FFLAS::Protected::batched::forGroups((batchCount+G-1)/G, range, psH);
+		FFLAS::fflas_delete(W);
+	}
+
+	template<class Field>
+	inline void
+	Rank_batched_interleaved (const Field& F, const size_t M, const size_t N,
+				  typename Field::Element_ptr A, size_t* ranks, const size_t batchCount)
+	{
+		Rank_batched_interleaved(F, M, N, A, ranks, batchCount, FFLAS::ParSeqHelper::Sequential());
+	}
+
+} // FFPACK
+
+#endif // __FFLASFFPACK_ffpack_batched_INL
@@ -0,0 +1,631 @@
+/* -*- mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+// vim:sts=4:sw=4:ts=4:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/*
+ * Copyright (C) 2016 the FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ *.
+ */
+
+/** @file ffpack/ffpack_blockwiedemann.inl
+ * @brief Block Wiedemann algorithm on sparse matrices.
+ *
+ * For a black box B of dimension N and random U (b x N), V (N x b), the
+ * sequence \f$S_i = U B^i V\f$ of length L = 2 ceil(N/b) + 4 is generated by
+ * fspmm on b columns and fgemm. Its minimal right matrix generator
+ * \f$P = \sum_k P_k x^k\f$, with \f$\sum_k S_{i+k} P_k = 0\f$, is read from a
+ * sigma basis of \f$[S(x) \; -I]\f$ of order L: PM-Basis halves the order,
+ * the residual and the product of the two bases being polynomial matrix
+ * products made of one fgemm per coefficient, down to the iterative M-Basis.
+ * Column \c j of P has degree \f$\delta_j\f$, its coefficient \c k being the
+ * coefficient \f$\delta_j-k\f$ of the approximant.
+ *
+ * With high probability, det P is the product of the b largest invariant
+ * factors of \f$xI-B\f$, and \f$\sum_k B^k V P_k = 0\f$. Then:
+ * - Det: with B = DA, D a random diagonal, det P is the characteristic
+ *   polynomial of DA times \f$\det P_{lc}\f$, the leading matrix of P;
+ * - Solve: with y the first column of V, \f$A X = V P_0\f$ for
+ *   \f$X = -\sum_{k>0} A^{k-1} V P_k\f$, and \f$x = X P_0^{-1} e_1\f$;
+ * - NullSpace: with V = AZ, \f$A^{e+1} w = 0\f$ for \f$w = \sum_k A^{k-e} Z P_k e_j\f$,
+ *   e the valuation of column j, and the last non zero \f$A^i w\f$ is in the nullspace;
+ * - Rank: with \f$B = D_1 A^T D_2 A D_1\f$, the characteristic polynomial of B is
+ *   \f$x^{n-r} g\f$, g square-free, \f$g(0)\neq 0\f$, and its minimal polynomial
+ *   is \f$x g\f$, hence \f$r = \sum_j \delta_j - b + \mathrm{rank}(P_0)\f$.
+ *
+ * Det, Solve and NullSpace check their result and restart with new random
+ * matrices when it is wrong; Rank is Monte Carlo. The probabilities of
+ * success assume a large field.
+ */
+
+#ifndef __FFLASFFPACK_ffpack_blockwiedemann_INL
+#define __FFLASFFPACK_ffpack_blockwiedemann_INL
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include <givaro/givranditer.h>
+
+#ifndef __FFLASFFPACK_BLOCK_WIEDEMANN_MBASIS
+//! largest order of the sigma bases computed by M-Basis
+#define __FFLASFFPACK_BLOCK_WIEDEMANN_MBASIS 32
+#endif
+
+namespace FFPACK { namespace Protected { namespace block_wiedemann {
+
+	//! number of random choices tried by Det, Solve and NullSpace
+	static const size_t tries = 4;
+
+	/** \internal
+	 * formats with the products of the Rank black box: fspmm_transpose and
+	 * pfspmm_transpose, besides the parallel fspmm
+	 */
+	template <class Field, class SM>
+	struct has_transpose_products : public std::false_type {};
+
+	template <class Field>
+	struct has_transpose_products<Field, FFLAS::Sparse<Field, FFLAS::SparseMatrix_t::CSR> > : public std::true_type {};
+
+	template <class Field>
+	struct has_transpose_products<Field, FFLAS::Sparse<Field, FFLAS::SparseMatrix_t::CSR_ZO> > : public std::true_type {};
+
+	template <class Field>
+	struct has_transpose_products<Field, FFLAS::Sparse<Field, FFLAS::SparseMatrix_t::CSC> > : public std::true_type {};
+
+	template <class Field>
+	struct has_transpose_products<Field, FFLAS::Sparse<Field, FFLAS::SparseMatrix_t::CSC_ZO> > : public std::true_type {};
+
+	template <class Field>
+	struct has_transpose_products<Field, FFLAS::Sparse<Field, FFLAS::SparseMatrix_t::SELL> > : public std::true_type {};
+
+	template <class Field>
+	struct has_transpose_products<Field, FFLAS::Sparse<Field, FFLAS::SparseMatrix_t::SELL_ZO> > : public std::true_type {};
+
+	/** \internal
+	 * rows x cols matrix polynomial with \c size coefficients, stored side by
+	 * side: coefficient k starts at column k*cols of a rows x (cols*cap) matrix.
+	 */
+	template <class Field>
+	struct PolynomialMatrix {
+		size_t rows, cols, size, cap;
+		typename Field::Element_ptr dat;
+
+		PolynomialMatrix (const Field& F, size_t r, size_t c, size_t s) :
+			rows(r), cols(c), size(s), cap(std::max<size_t>(s, 1)),
+			dat(FFLAS::fflas_new(F, r, c * std::max<size_t>(s, 1)))
+		{
+			FFLAS::fzero(F, rows, cols * cap, dat, cols * cap);
+		}
+		PolynomialMatrix (PolynomialMatrix&& P) :
+			rows(P.rows), cols(P.cols), size(P.size), cap(P.cap), dat(P.dat)
+		{
+			P.dat = nullptr;
+		}
+		PolynomialMatrix& operator= (PolynomialMatrix&& P)
+		{
+			std::swap(rows, P.rows);
+			std::swap(cols, P.cols);
+			std::swap(size, P.size);
+			std::swap(cap, P.cap);
+			std::swap(dat, P.dat);
+			return *this;
+		}
+		PolynomialMatrix (const PolynomialMatrix&) = delete;
+		~PolynomialMatrix () { FFLAS::fflas_delete(dat); }
+
+		size_t ld () const { return cols * cap; }
+		typename Field::Element_ptr operator[] (size_t k) { return dat + k * cols; }
+		typename Field::ConstElement_ptr operator[] (size_t k) const { return dat + k * cols; }
+
+		//! removes the zero leading coefficients, keeping one
+		void trim (const Field& F)
+		{
+			while (size > 1 && FFLAS::fiszero(F, rows, cols, (*this)[size - 1], ld()))
+				--size;
+		}
+	};
+
+	/** \internal
+	 * Coefficients lo..hi-1 of A B, A and B truncated to their first
+	 * \p asize and \p bsize coefficients: one fgemm per coefficient of A.
+	 */
+	template <class Field>
+	inline PolynomialMatrix<Field>
+	polmul (const Field& F, const PolynomialMatrix<Field>& A, const size_t asize,
+			const PolynomialMatrix<Field>& B, const size_t bsize, const size_t lo, const size_t hi)
+	{
+		PolynomialMatrix<Field> C(F, A.rows, B.cols, hi - lo);
+		for (size_t i = 0; i < asize && i < hi; ++i) {
+			const size_t jlo = (lo > i) ? lo - i : 0;
+			const size_t jhi = std::min(bsize, hi - i);
+			if (jlo >= jhi)
+				continue;
+			FFLAS::fgemm(F, FFLAS::FflasNoTrans, FFLAS::FflasNoTrans, A.rows, B.cols * (jhi - jlo), A.cols,
+						 F.one, A[i], A.ld(), B[jlo], B.ld(), F.one, C[i + jlo - lo], C.ld());
+		}
+		return C;
+	}
+
+	/** \internal
+	 * Sigma basis M of order L of G (q x s): the columns of G M are zero
+	 * modulo x^L. \p delta are the shifted degrees, updated.
+	 * Iterative M-Basis: at each order, the residual coefficient is reduced by
+	 * column elimination, the pivots being taken by increasing shifted degree,
+	 * and the pivot columns are multiplied by x.
+	 */
+	template <class Field>
+	inline PolynomialMatrix<Field>
+	mbasis (const Field& F, const PolynomialMatrix<Field>& G, const size_t L, std::vector<size_t>& delta)
+	{
+		const size_t q = G.rows, s = G.cols;
+		PolynomialMatrix<Field> M(F, s, s, L + 1);
+		M.size = 1;
+		for (size_t j = 0; j < s; ++j)
+			F.assign(M[0][j * M.ld() + j], F.one);
+		typename Field::Element_ptr R = FFLAS::fflas_new(F, q, s);
+		std::vector<size_t> order(s);
+		std::vector<std::pair<size_t, size_t> > pivots;
+		typename Field::Element a;
+
+		for (size_t k = 0; k < L; ++k) {
+			// coefficient k of G M
+			FFLAS::fzero(F, q, s, R, s);
+			for (size_t t = 0; t < M.size && t <= k; ++t)
+				FFLAS::fgemm(F, FFLAS::FflasNoTrans, FFLAS::FflasNoTrans, q, s, s,
+							 F.one, G[k - t], G.ld(), M[t], M.ld(), F.one, R, s);
+
+			std::iota(order.begin(), order.end(), 0);
+			std::stable_sort(order.begin(), order.end(),
+							 [&](size_t i, size_t j) { return delta[i] < delta[j]; });
+			pivots.clear();
+			for (size_t c : order) {
+				for (auto& p : pivots) {
+					if (F.isZero(R[p.first * s + c]))
+						continue;
+					F.div(a, R[p.first * s + c], R[p.first * s + p.second]);
+					F.negin(a);
+					FFLAS::faxpy(F, q, a, R + p.second, s, R + c, s);
+					for (size_t t = 0; t < M.size; ++t)
+						FFLAS::faxpy(F, s, a, M[t] + p.second, M.ld(), M[t] + c, M.ld());
+				}
+				for (size_t i = 0; i < q; ++i)
+					if (!F.isZero(R[i * s + c])) {
+						pivots.emplace_back(i, c);
+						break;
+					}
+			}
+
+			if (pivots.empty())
+				continue;
+			for (auto& p : pivots) {
+				const size_t c = p.second;
+				for (size_t t = M.size; t > 0; --t)
+					FFLAS::fassign(F, s, M[t - 1] + c, M.ld(), M[t] + c, M.ld());
+				FFLAS::fzero(F, s, M[0] + c, M.ld());
+				++delta[c];
+			}
+			++M.size;
+		}
+		FFLAS::fflas_delete(R);
+		M.trim(F);
+		return M;
+	}
+
+	/** \internal
+	 * Sigma basis of order L of G, by PM-Basis.
+	 */
+	template <class Field>
+	inline PolynomialMatrix<Field>
+	pmbasis (const Field& F, const PolynomialMatrix<Field>& G, const size_t L, std::vector<size_t>& delta)
+	{
+		if (L <= __FFLASFFPACK_BLOCK_WIEDEMANN_MBASIS)
+			return mbasis(F, G, L, delta);
+		const size_t L1 = L / 2;
+		PolynomialMatrix<Field> M1 = pmbasis(F, G, L1, delta);
+		PolynomialMatrix<Field> R = polmul(F, G, std::min(G.size, L), M1, M1.size, L1, L);
+		PolynomialMatrix<Field> M2 = pmbasis(F, R, L - L1, delta);
+		PolynomialMatrix<Field> M = polmul(F, M1, M1.size, M2, M2.size, 0, M1.size + M2.size - 1);
+		M.trim(F);
+		return M;
+	}
+
+	/** \internal
+	 * Black box Y = B X, with w columns: B is A, D1 A if \p gram is false
+	 * and \p d1 is given, and D1 A^T D2 A D1 if \p gram is true.
+	 */
+	template <class Field, class SM>
+	class BlackBox {
+	public:
+		BlackBox (const Field& F, const SM& A, const size_t b, const bool gram,
+				  typename Field::ConstElement_ptr d1, typename Field::ConstElement_ptr d2) :
+			_F(F), _A(A), _gram(gram), _d1(d1), _d2(d2),
+			_T(gram ? FFLAS::fflas_new(F, A.n + A.m, b) : nullptr)
+		{}
+		~BlackBox () { FFLAS::fflas_delete(_T); }
+
+		size_t dim () const { return _gram ? _A.n : _A.m; }
+
+		void apply (typename Field::ConstElement_ptr X, typename Field::Element_ptr Y, const size_t w) const
+		{
+			if (!_gram) {
+				FFLAS::fspmm(_F, _A, w, X, (int)w, _F.zero, Y, (int)w, FFLAS::ParSeqHelper::Parallel<>());
+				scale(_d1, _A.m, Y, w);
+				return;
+			}
+			typename Field::Element_ptr T1 = _T, T2 = _T + _A.n * w;
+			FFLAS::fassign(_F, _A.n * w, X, 1, T1, 1);
+			scale(_d1, _A.n, T1, w);
+			FFLAS::fspmm(_F, _A, w, T1, (int)w, _F.zero, T2, (int)w, FFLAS::ParSeqHelper::Parallel<>());
+			scale(_d2, _A.m, T2, w);
+#if defined(__FFLASFFPACK_USE_OPENMP)
+			FFLAS::pfspmm_transpose(_F, _A, w, T2, (int)w, _F.zero, Y, (int)w);
+#else
+			FFLAS::fspmm_transpose(_F, _A, w, T2, (int)w, _F.zero, Y, (int)w);
+#endif
+			scale(_d1, _A.n, Y, w);
+		}
+
+	private:
+		void scale (typename Field::ConstElement_ptr d, const size_t n, typename Field::Element_ptr Y, const size_t w) const
+		{
+			if (d == nullptr)
+				return;
+			for (size_t i = 0; i < n; ++i)
+				FFLAS::fscalin(_F, w, d[i], Y + i * w, 1);
+		}
+
+		const Field& _F;
+		const SM& _A;
+		const bool _gram;
+		typename Field::ConstElement_ptr _d1, _d2;
+		typename Field::Element_ptr _T;
+	};
+
+	//! b, when not given: one column per thread, at least 4, at most N
+	inline size_t blocking_factor (const size_t N, const size_t blockSize)
+	{
+		const size_t b = blockSize ? blockSize : std::max<size_t>(4, MAX_THREADS);
+		return std::max<size_t>(1, std::min(b, N));
+	}
+
+	//! random vector with non zero entries
+	template <class Field>
+	inline void random_nonzero (const Field&, typename Field::RandIter& G, const size_t n,
+								typename Field::Element_ptr d)
+	{
+		Givaro::GeneralRingNonZeroRandIter<Field> nzg(G);
+		for (size_t i = 0; i < n; ++i)
+			nzg.random(d[i]);
+	}
+
+	/** \internal
+	 * Minimal right generator P of U B^i V, U being b x N, V being N x b, and
+	 * the degrees \p deg of its columns.
+	 */
+	template <class Field, class SM>
+	inline PolynomialMatrix<Field>
+	generator (const Field& F, const BlackBox<Field, SM>& B, const size_t b,
+			   typename Field::ConstElement_ptr U, typename Field::ConstElement_ptr V,
+			   std::vector<size_t>& deg)
+	{
+		const size_t N = B.dim();
+		const size_t L = 2 * ((N + b - 1) / b) + 4;
+
+		// G = [S(x) -I], S_i = U B^i V
+		PolynomialMatrix<Field> G(F, b, 2 * b, L);
+		typename Field::Element_ptr X = FFLAS::fflas_new(F, N, b);
+		typename Field::Element_ptr Y = FFLAS::fflas_new(F, N, b);
+		FFLAS::fassign(F, N, b, V, b, X, b);
+		for (size_t i = 0; i < L; ++i) {
+			FFLAS::fgemm(F, FFLAS::FflasNoTrans, FFLAS::FflasNoTrans, b, b, N,
+						 F.one, U, N, X, b, F.zero, G[i], G.ld());
+			if (i + 1 < L) {
+				B.apply(X, Y, b);
+				std::swap(X, Y);
+			}
+		}
+		FFLAS::fflas_delete(X, Y);
+		for (size_t j = 0; j < b; ++j)
+			F.assign(G[0][j * G.ld() + b + j], F.mOne);
+
+		std::vector<size_t> delta(2 * b, 0);
+		std::fill(delta.begin() + b, delta.end(), 1);
+		PolynomialMatrix<Field> M = pmbasis(F, G, L, delta);
+
+		// the b columns of smallest shifted degrees, reversed
+		std::vector<size_t> order(2 * b);
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(), [&](size_t i, size_t j) { return delta[i] < delta[j]; });
+		deg.resize(b);
+		size_t D = 0;
+		for (size_t j = 0; j < b; ++j) {
+			deg[j] = delta[order[j]];
+			D = std::max(D, deg[j]);
+		}
+		PolynomialMatrix<Field> P(F, b, b, D + 1);
+		for (size_t j = 0; j < b; ++j)
+			for (size_t k = 0; k <= deg[j]; ++k)
+				if (deg[j] - k < M.size)
+					FFLAS::fassign(F, b, M[deg[j] - k] + order[j], M.ld(), P[k] + j, P.ld());
+		return P;
+	}
+
+	//! rank of the b x b matrix A, which is kept
+	template <class Field>
+	inline size_t rank (const Field& F, const size_t b, typename Field::ConstElement_ptr A, const size_t lda)
+	{
+		typename Field::Element_ptr T = FFLAS::fflas_new(F, b, b);
+		FFLAS::fassign(F, b, b, A, lda, T, b);
+		const size_t r = Rank(F, b, b, T, b);
+		FFLAS::fflas_delete(T);
+		return r;
+	}
+
+	//! determinant of the b x b matrix A, which is kept
+	template <class Field>
+	inline typename Field::Element det (const Field& F, const size_t b, typename Field::ConstElement_ptr A,
+										const size_t lda)
+	{
+		typename Field::Element_ptr T = FFLAS::fflas_new(F, b, b);
+		FFLAS::fassign(F, b, b, A, lda, T, b);
+		const typename Field::Element d = Det(F, b, b, T, b);
+		FFLAS::fflas_delete(T);
+		return d;
+	}
+
+}}} // FFPACK::Protected::block_wiedemann
+
+namespace FFPACK {
+
+	template <class Field, class SM>
+	inline size_t
+	BlockWiedemannRank (const Field& F, const SM& A, const size_t blockSize)
+	{
+		using namespace Protected::block_wiedemann;
+		static_assert(has_transpose_products<Field, SM>::value,
+					  "BlockWiedemannRank needs a CSR, CSC or SELL matrix, or their ZO versions");
+		const size_t m = A.m, n = A.n;
+		if (m == 0 || n == 0)
+			return 0;
+		const size_t b = blocking_factor(n, blockSize);
+		typename Field::RandIter G(F);
+		typename Field::Element_ptr d1 = FFLAS::fflas_new(F, n, 1);
+		typename Field::Element_ptr d2 = FFLAS::fflas_new(F, m, 1);
+		typename Field::Element_ptr U = FFLAS::fflas_new(F, b, n);
+		typename Field::Element_ptr V = FFLAS::fflas_new(F, n, b);
+		random_nonzero(F, G, n, d1);
+		random_nonzero(F, G, m, d2);
+		FFLAS::frand(F, G, b, n, U, n);
+		FFLAS::frand(F, G, n, b, V, b);
+
+		BlackBox<Field, SM> B(F, A, b, true, d1, d2);
+		std::vector<size_t> deg;
+		PolynomialMatrix<Field> P = generator(F, B, b, U, V, deg);
+		const size_t sum = std::accumulate(deg.begin(), deg.end(), (size_t)0);
+		const size_t r0 = rank(F, b, P[0], P.ld());
+		FFLAS::fflas_delete(d1, d2, U, V);
+		return (sum + r0 < b) ? 0 : std::min(std::min(m, n), sum + r0 - b);
+	}
+
+	template <class Field, class SM>
+	inline typename Field::Element
+	BlockWiedemannDet (const Field& F, const SM& A, const size_t blockSize)
+	{
+		using namespace Protected::block_wiedemann;
+		const size_t n = A.n;
+		if (A.m != n)
+			return F.zero;
+		if (n == 0)
+			return F.one;
+		const size_t b = blocking_factor(n, blockSize);
+		typename Field::RandIter G(F);
+		typename Field::Element_ptr d = FFLAS::fflas_new(F, n, 1);
+		typename Field::Element_ptr U = FFLAS::fflas_new(F, b, n);
+		typename Field::Element_ptr V = FFLAS::fflas_new(F, n, b);
+		typename Field::Element_ptr Plc = FFLAS::fflas_new(F, b, b);
+		typename Field::Element res;
+
+		for (size_t t = 0; t < tries; ++t) {
+			random_nonzero(F, G, n, d);
+			FFLAS::frand(F, G, b, n, U, n);
+			FFLAS::frand(F, G, n, b, V, b);
+			BlackBox<Field, SM> B(F, A, b, false, d, nullptr);
+			std::vector<size_t> deg;
+			PolynomialMatrix<Field> P = generator(F, B, b, U, V, deg);
+
+			// x divides det P, hence the characteristic polynomial of DA
+			if (rank(F, b, P[0], P.ld()) < b) {
+				FFLAS::fflas_delete(d, U, V, Plc);
+				return F.zero;
+			}
+			for (size_t j = 0; j < b; ++j)
+				FFLAS::fassign(F, b, P[deg[j]] + j, P.ld(), Plc + j, b);
+			if (std::accumulate(deg.begin(), deg.end(), (size_t)0) != n || rank(F, b, Plc, b) < b)
+				continue;
+
+			// det A = (-1)^n det P_0 / (det P_lc det D)
+			typename Field::Element q = det(F, b, Plc, b);
+			for (size_t i = 0; i < n; ++i)
+				F.mulin(q, d[i]);
+			F.div(res, det(F, b, P[0], P.ld()), q);
+			if (n & 1)
+				F.negin(res);
+			FFLAS::fflas_delete(d, U, V, Plc);
+			return res;
+		}
+		FFLAS::fflas_delete(d, U, V, Plc);
+		throw std::runtime_error("BlockWiedemannDet: no characteristic polynomial found, the field may be too small");
+	}
+
+	template <class Field, class SM>
+	inline typename Field::Element_ptr
+	BlockWiedemannSolve (const Field& F, const SM& A, typename Field::Element_ptr x,
+						 typename Field::ConstElement_ptr y, const size_t blockSize)
+	{
+		using namespace Protected::block_wiedemann;
+		const size_t n = A.n;
+		if (A.m != n)
+			throw std::runtime_error("BlockWiedemannSolve: the matrix is not square");
+		if (n == 0)
+			return x;
+		const size_t b = blocking_factor(n, blockSize);
+		typename Field::RandIter G(F);
+		typename Field::Element_ptr U = FFLAS::fflas_new(F, b, n);
+		typename Field::Element_ptr V = FFLAS::fflas_new(F, n, b);
+		typename Field::Element_ptr P0 = FFLAS::fflas_new(F, b, b);
+		typename Field::Element_ptr z = FFLAS::fflas_new(F, b, 1);
+		typename Field::Element_ptr e = FFLAS::fflas_new(F, b, 1);
+		typename Field::Element_ptr c = FFLAS::fflas_new(F, b, 1);
+		typename Field::Element_ptr w = FFLAS::fflas_new(F, n, 1);
+		BlackBox<Field, SM> B(F, A, b, false, nullptr, nullptr);
+
+		for (size_t t = 0; t < tries; ++t) {
+			FFLAS::frand(F, G, b, n, U, n);
+			FFLAS::frand(F, G, n, b, V, b);
+			FFLAS::fassign(F, n, y, 1, V, b);
+			std::vector<size_t> deg;
+			PolynomialMatrix<Field> P = generator(F, B, b, U, V, deg);
+			if (P.size < 2 || rank(F, b, P[0], P.ld()) < b)
+				continue;
+
+			// z = P_0^{-1} e_1
+			FFLAS::fassign(F, b, b, P[0], P.ld(), P0, b);
+			FFLAS::fzero(F, b, e, 1);
+			F.assign(e[0], F.one);
+			Solve(F, b, P0, b, z, 1, e, 1);
+
+			// x = - sum_{k>0} A^{k-1} V P_k z, by Horner
+			FFLAS::fzero(F, n, x, 1);
+			for (size_t k = P.size - 1; k > 0; --k) {
+				if (k + 1 < P.size)
+					B.apply(x, w, 1);
+				else
+					FFLAS::fzero(F, n, w, 1);
+				FFLAS::fgemv(F, FFLAS::FflasNoTrans, b, b, F.one, P[k], P.ld(), z, 1, F.zero, c, 1);
+				FFLAS::fgemv(F, FFLAS::FflasNoTrans, n, b, F.one, V, b, c, 1, F.one, w, 1);
+				FFLAS::fassign(F, n, w, 1, x, 1);
+			}
+			FFLAS::fnegin(F, n, x, 1);
+
+			B.apply(x, w, 1);
+			if (FFLAS::fequal(F, n, w, 1, y, 1)) {
+				FFLAS::fflas_delete(U, V, P0, z, e, c, w);
+				return x;
+			}
+		}
+		FFLAS::fflas_delete(U, V, P0, z, e, c, w);
+		throw std::runtime_error("BlockWiedemannSolve: no solution found, the matrix may be singular");
+	}
+
+	template <class Field, class SM>
+	inline size_t
+	BlockWiedemannNullSpace (const Field& F, const SM& A, typename Field::Element_ptr& NS, size_t& ldn,
+							 size_t& NSdim, const size_t blockSize)
+	{
+		using namespace Protected::block_wiedemann;
+		const size_t n = A.n;
+		if (A.m != n)
+			throw std::runtime_error("BlockWiedemannNullSpace: the matrix is not square");
+		NSdim = 0;
+		ldn = 0;
+		NS = nullptr;
+		if (n == 0)
+			return 0;
+		const size_t b = blocking_factor(n, blockSize);
+		typename Field::RandIter G(F);
+		typename Field::Element_ptr U = FFLAS::fflas_new(F, b, n);
+		typename Field::Element_ptr Z = FFLAS::fflas_new(F, n, b);
+		typename Field::Element_ptr V = FFLAS::fflas_new(F, n, b);
+		typename Field::Element_ptr W = FFLAS::fflas_new(F, n, b);
+		typename Field::Element_ptr Y = FFLAS::fflas_new(F, n, b);
+		typename Field::Element_ptr K = FFLAS::fflas_new(F, n, b);
+		BlackBox<Field, SM> B(F, A, b, false, nullptr, nullptr);
+
+		for (size_t t = 0; t < tries; ++t) {
+			FFLAS::frand(F, G, b, n, U, n);
+			FFLAS::frand(F, G, n, b, Z, b);
+			B.apply(Z, V, b);
+			std::vector<size_t> deg;
+			PolynomialMatrix<Field> P = generator(F, B, b, U, V, deg);
+
+			// Q e_j = x^{-e_j} P e_j, e_j the valuation of the column j of P
+			std::vector<size_t> val(b, 0);
+			size_t D = 0, E = 0;
+			for (size_t j = 0; j < b; ++j) {
+				while (val[j] < deg[j] && FFLAS::fiszero(F, b, 1, P[val[j]] + j, P.ld()))
+					++val[j];
+				D = std::max(D, deg[j] - val[j]);
+				E = std::max(E, val[j]);
+			}
+			PolynomialMatrix<Field> Q(F, b, b, D + 1);
+			for (size_t j = 0; j < b; ++j)
+				for (size_t k = val[j]; k <= deg[j]; ++k)
+					FFLAS::fassign(F, b, P[k] + j, P.ld(), Q[k - val[j]] + j, Q.ld());
+
+			// W = sum_k A^k Z Q_k, by Horner
+			FFLAS::fgemm(F, FFLAS::FflasNoTrans, FFLAS::FflasNoTrans, n, b, b, F.one, Z, b, Q[D], Q.ld(), F.zero, W, b);
+			for (size_t k = D; k > 0; --k) {
+				B.apply(W, Y, b);
+				FFLAS::fgemm(F, FFLAS::FflasNoTrans, FFLAS::FflasNoTrans, n, b, b, F.one, Z, b, Q[k - 1], Q.ld(), F.one, Y, b);
+				std::swap(W, Y);
+			}
+
+			// A^{e_j+1} W e_j = 0: the last non zero A^i W e_j are in the nullspace
+			std::vector<bool> done(b, false);
+			size_t found = 0, left = 0;
+			for (size_t j = 0; j < b; ++j)
+				done[j] = FFLAS::fiszero(F, n, 1, W + j, b);
+			for (size_t i = 0; i <= E; ++i) {
+				B.apply(W, Y, b);
+				for (size_t j = 0; j < b; ++j) {
+					if (done[j])
+						continue;
+					if (FFLAS::fiszero(F, n, 1, Y + j, b)) {
+						FFLAS::fassign(F, n, 1, W + j, b, K + found, b);
+						++found;
+						done[j] = true;
+					} else
+						FFLAS::fassign(F, n, 1, Y + j, b, W + j, b);
+				}
+			}
+			for (size_t j = 0; j < b; ++j)
+				left += !done[j];
+			// no vector reached zero: the generator is wrong
+			if (found == 0 && left > 0 && t + 1 < tries)
+				continue;
+
+			// a basis of the vectors found
+			size_t* rk = nullptr;
+			FFLAS::fassign(F, n, found, K, b, Y, b);
+			NSdim = found ? ColumnRankProfile(F, n, found, Y, b, rk, FfpackTileRecursive) : 0;
+			ldn = NSdim;
+			NS = FFLAS::fflas_new(F, n, std::max<size_t>(NSdim, 1));
+			for (size_t j = 0; j < NSdim; ++j)
+				FFLAS::fassign(F, n, 1, K + rk[j], b, NS + j, ldn);
+			FFLAS::fflas_delete(rk);
+			break;
+		}
+		FFLAS::fflas_delete(U, Z, V, W, Y, K);
+		return NSdim;
+	}
+
+} // FFPACK
+
+#endif // __FFLASFFPACK_ffpack_blockwiedemann_INL
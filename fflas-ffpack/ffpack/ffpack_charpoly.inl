@@ -132,6 +132,49 @@ namespace FFPACK {
 		}
 	}
 
+	template <class Field, class Polynomial, class PSHelper>
+	std::list<Polynomial>&
+	CharPoly (const Field& F, std::list<Polynomial>& charp, const size_t N,
+		  typename Field::Element_ptr A, const size_t lda,
+		  const FFPACK_CHARPOLY_TAG CharpTag, const PSHelper& psH)
+	{
+		switch (CharpTag) {
+		case FfpackLUK:
+			{
+				typename Field::Element_ptr X = FFLAS::fflas_new (F, N, N+1);
+				Protected::LUKrylov (F, charp, N, A, lda, X, N, psH);
+				FFLAS::fflas_delete (X);
+				return charp;
+			}
+		case FfpackArithProg:
+			{
+				size_t attempts=0;
+				bool cont = false;
+				const uint64_t p = static_cast<uint64_t>(F.characteristic());
+				if (p < static_cast<uint64_t>(N)){
+					return CharPoly (F, charp, N, A, lda, FfpackLUK, psH);
+				}
+
+				do{
+					try {
+						CharpolyArithProg (F, charp, N, A, lda, __FFPACK_CHARPOLY_THRESHOLD, psH);
+					}
+					catch (CharpolyFailed){
+						if (attempts++ < 2)
+							cont = true;
+						else
+							return CharPoly(F, charp, N, A, lda, FfpackLUK, psH);
+
+					}
+				} while (cont);
+				return charp;
+			}
+		default:
+			// no parallel variant: Keller-Gehrig and Danilevski
+			return CharPoly (F, charp, N, A, lda, CharpTag);
+		}
+	}
+
 	template<class Polynomial, class Field>
 	Polynomial & mulpoly(const Field& F, Polynomial &res, const Polynomial & P1, const Polynomial & P2)
 	{
@@ -170,6 +213,31 @@ namespace FFPACK {
 		return charp;
 	}
 
+	template <class Field, class Polynomial, class PSHelper>
+	Polynomial&
+	CharPoly( const Field& F, Polynomial& charp, const size_t N,
+		  typename Field::Element_ptr A, const size_t lda,
+		  const FFPACK_CHARPOLY_TAG CharpTag, const PSHelper& psH)
+	{
+
+		std::list<Polynomial> factor_list;
+		CharPoly (F, factor_list, N, A, lda, CharpTag, psH);
+		typename std::list<Polynomial >::const_iterator it;
+		it = factor_list.begin();
+
+		charp.resize(N+1);
+
+		Polynomial P = charp = *(it++);
+
+		while( it!=factor_list.end() ){
+			mulpoly (F,charp, P, *it);
+			P = charp;
+			++it;
+		}
+
+		return charp;
+	}
+
 
 	namespace Protected {
 		template <class Field, class Polynomial>
@@ -178,6 +246,15 @@ namespace FFPACK {
 			  typename Field::Element_ptr A, const size_t lda,
 			  typename Field::Element_ptr X, const size_t ldx)
 		{
+			return LUKrylov (F, charp, N, A, lda, X, ldx, FFLAS::ParSeqHelper::Sequential());
+		}
+
+		template <class Field, class Polynomial, class PSHelper>
+		std::list<Polynomial>&
+		LUKrylov (const Field& F, std::list<Polynomial>& charp, const size_t N,
+			  typename Field::Element_ptr A, const size_t lda,
+			  typename Field::Element_ptr X, const size_t ldx, const PSHelper& psH)
+		{
 
 			typedef typename Field::Element elt;
 			elt* Ai, *Xi, *X2=X;
@@ -187,7 +264,8 @@ namespace FFPACK {
 			while (Ncurr > 0){
 				size_t *P = FFLAS::fflas_new<size_t>((size_t)Ncurr);
 				Polynomial minP;//=new Polynomial();
-				FFPACK::MinPoly (F, minP, (size_t)Ncurr, A, lda, X2, ldx, P);
+				FFPACK::MinPoly (F, minP, (size_t)Ncurr, A, lda, X2, ldx, P,
+						 FFPACK::FfpackDense, 0, 0, 0, psH);
 				int k = int(minP.size()-1); // degre of minpoly
 				if ((k==1) && F.isZero ((minP)[0])){ // minpoly is X
 					Ai = A;
@@ -227,7 +305,7 @@ namespace FFPACK {
 				// X21 = X21 . S1^-1
 				ftrsm(F, FFLAS::FflasRight, FFLAS::FflasUpper,
 				      FFLAS::FflasNoTrans, FFLAS::FflasUnit, Nrest, (size_t)k,
-				      F.one, X2, ldx, X21, ldx);
+				      F.one, X2, ldx, X21, ldx, psH);
 				// Creation of the matrix A2 for recurise call
 				for (Xi = X22, Ai = A;
 				     Xi != X22 + Nrest*ldx;
@@ -235,7 +313,7 @@ namespace FFPACK {
 					for (size_t jj=0; jj<Nrest; ++jj)
 						*(Ai++) = *(Xi++);
 				fgemm (F, FFLAS::FflasNoTrans, FFLAS::FflasNoTrans, Nrest, Nrest, (size_t)k, F.mOne,
-				       X21, ldx, X2+k, ldx, F.one, A, lda);
+				       X21, ldx, X2+k, ldx, F.one, A, lda, psH);
 				X2 = X22;
 				Ncurr = int(Nrest);
 			}
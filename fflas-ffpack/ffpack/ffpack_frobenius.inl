@@ -79,6 +79,15 @@ FFPACK::CharpolyArithProg (const Field& F, std::list<Polynomial>& frobeniusForm,
 			   const size_t N, typename Field::Element_ptr A, const size_t lda,
 			   const size_t c)
 {
+	return CharpolyArithProg (F, frobeniusForm, N, A, lda, c, FFLAS::ParSeqHelper::Sequential());
+}
+
+template <class Field, class Polynomial, class PSHelper>
+std::list<Polynomial>&
+FFPACK::CharpolyArithProg (const Field& F, std::list<Polynomial>& frobeniusForm,
+			   const size_t N, typename Field::Element_ptr A, const size_t lda,
+			   const size_t c, const PSHelper& psH)
+{
 
 	FFLASFFPACK_check(c);
 
@@ -111,7 +120,7 @@ FFPACK::CharpolyArithProg (const Field& F, std::list<Polynomial>& frobeniusForm,
 	for (size_t i = 1; i<c; ++i){
 // #warning "leaks here"
 		fgemm( F, FFLAS::FflasNoTrans, FFLAS::FflasTrans,  noc, N, N,F.one,
-		       K+(i-1)*Nnoc, ldk, A, lda, F.zero, K+i*Nnoc, ldk);
+		       K+(i-1)*Nnoc, ldk, A, lda, F.zero, K+i*Nnoc, ldk, psH);
 	}
 	// K2 <- K (re-ordering)
 	//! @todo swap to save space ??
@@ -174,21 +183,21 @@ FFPACK::CharpolyArithProg (const Field& F, std::list<Polynomial>& frobeniusForm,
 	FFLAS::fflas_delete (K2);
 
 	// K <- K A^T
-	fgemm( F, FFLAS::FflasNoTrans, FFLAS::FflasTrans, Mk, N, N,F.one,  K3, ldk, A, lda, F.zero, K4, ldk);
+	fgemm( F, FFLAS::FflasNoTrans, FFLAS::FflasTrans, Mk, N, N,F.one,  K3, ldk, A, lda, F.zero, K4, ldk, psH);
 
 	// K <- K P^T
 	applyP (F, FFLAS::FflasRight, FFLAS::FflasTrans,
 		Mk, 0,(int) R, K4, ldk, Pk);
 
 	// K <- K U^-1
-	ftrsm (F, FFLAS::FflasRight, FFLAS::FflasUpper, FFLAS::FflasNoTrans, FFLAS::FflasNonUnit, Mk, R,F.one, K, ldk, K4, ldk);
+	ftrsm (F, FFLAS::FflasRight, FFLAS::FflasUpper, FFLAS::FflasNoTrans, FFLAS::FflasNonUnit, Mk, R,F.one, K, ldk, K4, ldk, psH);
 
 	// L <-  Q^T L
 	applyP(F, FFLAS::FflasLeft, FFLAS::FflasNoTrans,
 	       N, 0,(int) R, K, ldk, Qk);
 
 	// K <- K L^-1
-	ftrsm (F, FFLAS::FflasRight, FFLAS::FflasLower, FFLAS::FflasNoTrans, FFLAS::FflasUnit, Mk, R,F.one, K, ldk, K4, ldk);
+	ftrsm (F, FFLAS::FflasRight, FFLAS::FflasLower, FFLAS::FflasNoTrans, FFLAS::FflasUnit, Mk, R,F.one, K, ldk, K4, ldk, psH);
 
 	//undoing permutation on L
 	applyP(F, FFLAS::FflasLeft, FFLAS::FflasTrans,
@@ -269,7 +278,7 @@ FFPACK::CharpolyArithProg (const Field& F, std::list<Polynomial>& frobeniusForm,
 
 		// K21 = K21 . S1^-1
 		ftrsm (F, FFLAS::FflasRight, FFLAS::FflasUpper, FFLAS::FflasNoTrans, FFLAS::FflasNonUnit, Nrest, R,
-		      F.one, K, ldk, K21, ldk);
+		      F.one, K, ldk, K21, ldk, psH);
 
 		typename Field::Element_ptr Arec = FFLAS::fflas_new (F, Nrest, Nrest);
 		size_t ldarec = Nrest;
@@ -281,13 +290,13 @@ FFPACK::CharpolyArithProg (const Field& F, std::list<Polynomial>& frobeniusForm,
 			for ( size_t j=0; j<Nrest; ++j )
 				*(Ai++) = *(Ki++);
 		fgemm (F, FFLAS::FflasNoTrans, FFLAS::FflasNoTrans, Nrest, Nrest, R,F.mOne,
-		       K21, ldk, K+R, ldk,F.one, Arec, ldarec);
+		       K21, ldk, K+R, ldk,F.one, Arec, ldarec, psH);
 
 		std::list<Polynomial> polyList;
 		polyList.clear();
 
 		// Recursive call on the complementary subspace
-		CharPoly(F, polyList, Nrest, Arec, ldarec);
+		CharPoly(F, polyList, Nrest, Arec, ldarec, FfpackArithProg, psH);
 		FFLAS::fflas_delete (Arec);
 		frobeniusForm.merge(polyList);
 	}
@@ -410,9 +419,9 @@ FFPACK::CharpolyArithProg (const Field& F, std::list<Polynomial>& frobeniusForm,
 
 		// K <- A K
 		fgemm (F, FFLAS::FflasNoTrans, FFLAS::FflasNoTrans, Ncurr-Ma, nb_full_blocks, Ma,F.one,
-		       Ac, ldac, K+(Ncurr-Ma)*ldk, ldk,F.one, K, ldk);
+		       Ac, ldac, K+(Ncurr-Ma)*ldk, ldk,F.one, K, ldk, psH);
 		fgemm (F, FFLAS::FflasNoTrans, FFLAS::FflasNoTrans, Ma, nb_full_blocks, Ma,F.one,
-		       Ac+(Ncurr-Ma)*ldac, ldac, K+(Ncurr-Ma)*ldk, ldk, F.zero, Arp, ldarp);
+		       Ac+(Ncurr-Ma)*ldac, ldac, K+(Ncurr-Ma)*ldk, ldk, F.zero, Arp, ldarp, psH);
 		for (size_t i=0; i< Ma; ++i)
 			FFLAS::fassign(F, nb_full_blocks, Arp+i*ldarp, 1, K+(Ncurr-Ma+i)*ldk, 1);
 
@@ -445,13 +454,13 @@ FFPACK::CharpolyArithProg (const Field& F, std::list<Polynomial>& frobeniusForm,
 			//			exit(-1);
 		}
 		ftrsm (F, FFLAS::FflasLeft, FFLAS::FflasLower, FFLAS::FflasNoTrans, FFLAS::FflasUnit, Mk, Mk,F.one,
-		       K3 + (Ncurr-Mk)*ldk, ldk, K+(Ncurr-Mk)*ldk, ldk);
+		       K3 + (Ncurr-Mk)*ldk, ldk, K+(Ncurr-Mk)*ldk, ldk, psH);
 		ftrsm (F, FFLAS::FflasLeft, FFLAS::FflasUpper, FFLAS::FflasNoTrans, FFLAS::FflasNonUnit, Mk, Mk,F.one,
-		       K3+(Ncurr-Mk)*ldk, ldk, K+(Ncurr-Mk)*ldk, ldk);
+		       K3+(Ncurr-Mk)*ldk, ldk, K+(Ncurr-Mk)*ldk, ldk, psH);
 		applyP (F, FFLAS::FflasLeft, FFLAS::FflasTrans,
 			Mk, 0,(int) Mk, K+(Ncurr-Mk)*ldk,ldk, P);
 		fgemm (F, FFLAS::FflasNoTrans, FFLAS::FflasNoTrans, Ncurr-Mk, Mk, Mk,F.mOne,
-		       K3, ldk, K+(Ncurr-Mk)*ldk,ldk,F.one, K, ldk);
+		       K3, ldk, K+(Ncurr-Mk)*ldk,ldk,F.one, K, ldk, psH);
 		FFLAS::fflas_delete( P);
 		FFLAS::fflas_delete( Q);
 
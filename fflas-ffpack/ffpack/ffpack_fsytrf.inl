@@ -0,0 +1,226 @@
+/* -*- mode: C++; tab-width: 8; indent-tabs-mode: t; c-basic-offset: 8 -*- */
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/*
+ * Copyright (C) 2016 the FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ *.
+ */
+
+/** @file ffpack/ffpack_fsytrf.inl
+ * @brief LDLT factorization of a symmetric matrix, with symmetric pivoting.
+ */
+
+#ifndef __FFLASFFPACK_ffpack_fsytrf_INL
+#define __FFLASFFPACK_ffpack_fsytrf_INL
+
+#ifndef __FFLASFFPACK_FSYTRF_THRESHOLD
+//! dimension under which fsytrf eliminates one pivot at a time
+#define __FFLASFFPACK_FSYTRF_THRESHOLD 32
+#endif
+
+namespace FFPACK { namespace Protected {
+
+	/* The functions below work on the whole N x N matrix: the entry (i,j),
+	 * i >= j, of the lower triangle is A[i*rs+j*cs], that is (i,j) for
+	 * Lower and (j,i) for Upper.
+	 */
+
+	/* Symmetric transposition of the indices i and j: rows and columns of
+	 * the matrix, the rows of L already computed being swapped along.
+	 */
+	template <class Field>
+	inline void
+	fsytrf_swap (const Field& F, const FFLAS::FFLAS_UPLO UpLo, const size_t N,
+		     typename Field::Element_ptr A, const size_t lda, size_t* MathP,
+		     size_t i, size_t j)
+	{
+		if (i == j) return;
+		if (i > j) std::swap (i, j);
+		const size_t rs = (UpLo == FFLAS::FflasLower) ? lda : 1;
+		const size_t cs = (UpLo == FFLAS::FflasLower) ? 1 : lda;
+		FFLAS::fswap (F, 1, A+i*(lda+1), 1, A+j*(lda+1), 1);
+		FFLAS::fswap (F, i, A+i*rs, cs, A+j*rs, cs);
+		FFLAS::fswap (F, j-i-1, A+(i+1)*rs+i*cs, rs, A+j*rs+(i+1)*cs, cs);
+		FFLAS::fswap (F, N-j-1, A+(j+1)*rs+i*cs, rs, A+(j+1)*rs+j*cs, rs);
+		std::swap (MathP[i], MathP[j]);
+	}
+
+	//! Moves the indices [b,c) before the indices [a,b)
+	template <class Field>
+	inline void
+	fsytrf_rotate (const Field& F, const FFLAS::FFLAS_UPLO UpLo, const size_t N,
+		       typename Field::Element_ptr A, const size_t lda, size_t* MathP,
+		       const size_t a, const size_t b, const size_t c)
+	{
+		for (size_t i = a, j = b; i+1 < j; ++i, --j)
+			fsytrf_swap (F, UpLo, N, A, lda, MathP, i, j-1);
+		for (size_t i = b, j = c; i+1 < j; ++i, --j)
+			fsytrf_swap (F, UpLo, N, A, lda, MathP, i, j-1);
+		for (size_t i = a, j = c; i+1 < j; ++i, --j)
+			fsytrf_swap (F, UpLo, N, A, lda, MathP, i, j-1);
+	}
+
+	/* Right looking elimination of the n x n block at (off,off), taking
+	 * as pivot the first non zero diagonal entry. Returns the number r of
+	 * pivots: the Schur complement in the block of the r pivots, stored in
+	 * the last n-r indices, has a zero diagonal.
+	 */
+	template <class Field>
+	inline size_t
+	fsytrf_base (const Field& F, const FFLAS::FFLAS_UPLO UpLo, const size_t N,
+		     typename Field::Element_ptr A, const size_t lda, size_t* MathP,
+		     const size_t off, const size_t n)
+	{
+		const size_t rs = (UpLo == FFLAS::FflasLower) ? lda : 1;
+		const size_t cs = (UpLo == FFLAS::FflasLower) ? 1 : lda;
+		typename Field::Element_ptr Ad = A + off*(lda+1);
+		typename Field::Element dinv, l;
+		size_t r = 0;
+		for (; r < n; ++r) {
+			size_t j = r;
+			while (j < n && F.isZero (Ad[j*(lda+1)])) ++j;
+			if (j == n) break;
+			fsytrf_swap (F, UpLo, N, A, lda, MathP, off+r, off+j);
+			F.inv (dinv, Ad[r*(lda+1)]);
+			// the rows are updated from the bottom, so that the
+			// entries (k,r), k<i, used by row i are not scaled yet
+			for (size_t i = n; i-- > r+1; ) {
+				F.mul (l, Ad[i*rs+r*cs], dinv);
+				F.negin (l);
+				FFLAS::faxpy (F, i-r, l, Ad+(r+1)*rs+r*cs, rs, Ad+i*rs+(r+1)*cs, cs);
+				F.neg (Ad[i*rs+r*cs], l);
+			}
+		}
+		return r;
+	}
+
+	/* Recursive elimination of the n x n block at (off,off), whose last z
+	 * indices have a zero diagonal. The pivots of the first half are found
+	 * recursively; if there is none, this half has a zero diagonal and is
+	 * moved to the end, else the Schur complement is updated and its
+	 * pivots are found recursively, the indices of the first half without
+	 * pivot being moved to the end.
+	 */
+	template <class Field, class PSHelper>
+	inline size_t
+	fsytrf_rec (const Field& F, const FFLAS::FFLAS_UPLO UpLo, const size_t N,
+		    typename Field::Element_ptr A, const size_t lda, size_t* MathP,
+		    const size_t off, const size_t n, size_t z, const PSHelper& psh)
+	{
+		typename Field::Element_ptr Ad = A + off*(lda+1);
+		while (n > z) {
+			if (n <= __FFLASFFPACK_FSYTRF_THRESHOLD)
+				return fsytrf_base (F, UpLo, N, A, lda, MathP, off, n);
+
+			const size_t n1 = (n-z+1) >> 1;
+			const size_t n2 = n - n1;
+			const size_t r1 = fsytrf_rec (F, UpLo, N, A, lda, MathP, off, n1, 0, psh);
+			if (!r1) {
+				fsytrf_rotate (F, UpLo, N, A, lda, MathP, off, off+n1, off+n-z);
+				z += n1;
+				continue;
+			}
+
+			typename Field::Element_ptr A22 = Ad + n1*(lda+1);
+			if (UpLo == FFLAS::FflasLower) {
+				// X = A21 L1^-T, then A21' -= X L1'^T for the rows r1..n1 of L
+				typename Field::Element_ptr X = Ad + n1*lda;
+				FFLAS::ftrsm (F, FFLAS::FflasRight, FFLAS::FflasLower, FFLAS::FflasTrans, FFLAS::FflasUnit,
+					      n2, r1, F.one, Ad, lda, X, lda, psh);
+				if (n1 > r1)
+					FFLAS::fgemm (F, FFLAS::FflasNoTrans, FFLAS::FflasTrans, n2, n1-r1, r1,
+						      F.mOne, X, lda, Ad+r1*lda, lda, F.one, X+r1, lda, psh);
+			} else {
+				typename Field::Element_ptr X = Ad + n1;
+				FFLAS::ftrsm (F, FFLAS::FflasLeft, FFLAS::FflasUpper, FFLAS::FflasTrans, FFLAS::FflasUnit,
+					      r1, n2, F.one, Ad, lda, X, lda, psh);
+				if (n1 > r1)
+					FFLAS::fgemm (F, FFLAS::FflasTrans, FFLAS::FflasNoTrans, n1-r1, n2, r1,
+						      F.mOne, Ad+r1, lda, X, lda, F.one, X+r1*lda, lda, psh);
+			}
+
+			// A22 -= X D1^-1 X^T, then L21 = X D1^-1
+			const size_t rs = (UpLo == FFLAS::FflasLower) ? lda : 1;
+			const size_t cs = (UpLo == FFLAS::FflasLower) ? 1 : lda;
+			typename Field::Element_ptr X = Ad + n1*rs;
+			typename Field::Element_ptr Dinv = FFLAS::fflas_new (F, r1);
+			for (size_t k = 0; k < r1; ++k)
+				F.inv (Dinv[k], Ad[k*(lda+1)]);
+			FFLAS::fsyrk (F, UpLo, (UpLo == FFLAS::FflasLower) ? FFLAS::FflasNoTrans : FFLAS::FflasTrans,
+				      n2, r1, F.mOne, X, lda, Dinv, 1, F.one, A22, lda, psh);
+			for (size_t k = 0; k < r1; ++k)
+				FFLAS::fscalin (F, n2, Dinv[k], X+k*cs, rs);
+			FFLAS::fflas_delete (Dinv);
+
+			fsytrf_rotate (F, UpLo, N, A, lda, MathP, off+r1, off+n1, off+n);
+			return r1 + fsytrf_rec (F, UpLo, N, A, lda, MathP, off+r1, n-r1, n1-r1, psh);
+		}
+		return 0;
+	}
+
+	template <class Field, class PSHelper>
+	inline size_t
+	fsytrf (const Field& F, const FFLAS::FFLAS_UPLO UpLo, const size_t N,
+		typename Field::Element_ptr A, const size_t lda, size_t* P,
+		const PSHelper& psh)
+	{
+		size_t* MathP = FFLAS::fflas_new<size_t> (N);
+		for (size_t i = 0; i < N; ++i)
+			MathP[i] = i;
+		size_t r = fsytrf_rec (F, UpLo, N, A, lda, MathP, 0, N, 0, psh);
+		MathPerm2LAPACKPerm (P, MathP, N);
+		FFLAS::fflas_delete (MathP);
+		return r;
+	}
+
+} // Protected
+} // FFPACK
+
+namespace FFPACK {
+
+	template <class Field>
+	inline size_t
+	fsytrf (const Field& F, const FFLAS::FFLAS_UPLO UpLo, const size_t N,
+		typename Field::Element_ptr A, const size_t lda, size_t* P)
+	{
+		return Protected::fsytrf (F, UpLo, N, A, lda, P, FFLAS::ParSeqHelper::Sequential());
+	}
+
+	template <class Field>
+	inline size_t
+	fsytrf (const Field& F, const FFLAS::FFLAS_UPLO UpLo, const size_t N,
+		typename Field::Element_ptr A, const size_t lda, size_t* P,
+		const FFLAS::ParSeqHelper::Sequential seq)
+	{
+		return Protected::fsytrf (F, UpLo, N, A, lda, P, seq);
+	}
+
+	template <class Field, class Cut, class Param>
+	inline size_t
+	fsytrf (const Field& F, const FFLAS::FFLAS_UPLO UpLo, const size_t N,
+		typename Field::Element_ptr A, const size_t lda, size_t* P,
+		const FFLAS::ParSeqHelper::Parallel<Cut,Param> par)
+	{
+		return Protected::fsytrf (F, UpLo, N, A, lda, P, par);
+	}
+
+} // FFPACK
+
+#endif // __FFLASFFPACK_ffpack_fsytrf_INL
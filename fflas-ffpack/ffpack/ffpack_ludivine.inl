@@ -648,6 +648,55 @@ namespace FFPACK {
 				    , const size_t kg_j // =0
 				  )
 		{
+			return LUdivine_construct (F, Diag, M, N, A, lda, X, ldx, u, P, computeX,
+						   MinTag, kg_mc, kg_mb, kg_j, FFLAS::ParSeqHelper::Sequential());
+		}
+
+		// Krylov iterate y <- A x
+		template <class Field>
+		inline void
+		KrylovIterate (const Field& F, const size_t N,
+			       typename Field::ConstElement_ptr A, const size_t lda,
+			       typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
+			       const FFLAS::ParSeqHelper::Sequential&)
+		{
+			fgemv (F, FFLAS::FflasNoTrans, N, N, F.one, A, lda, x, 1, F.zero, y, 1);
+		}
+
+		// Krylov iterate y <- A x, by row blocks of A in parallel
+		template <class Field, class Cut, class Param>
+		inline void
+		KrylovIterate (const Field& F, const size_t N,
+			       typename Field::ConstElement_ptr A, const size_t lda,
+			       typename Field::ConstElement_ptr x, typename Field::Element_ptr y,
+			       const FFLAS::ParSeqHelper::Parallel<Cut,Param>& psH)
+		{
+			SYNCH_GROUP(
+				FORBLOCK1D(iter, N, SPLITTER(psH.numthreads()),
+					   size_t rowsize = iter.end()-iter.begin();
+					   TASK(MODE(CONSTREFERENCE(F) READ(A[iter.begin()*lda], x[0]) WRITE(y[iter.begin()])),
+						fgemv (F, FFLAS::FflasNoTrans, rowsize, N, F.one, A+iter.begin()*lda, lda,
+						       x, 1, F.zero, y+iter.begin(), 1);
+						);
+					   );
+				);
+		}
+
+		template <class Field, class PSHelper>
+		size_t
+		LUdivine_construct( const Field& F, const FFLAS::FFLAS_DIAG Diag,
+				    const size_t M, const size_t N,
+				    typename Field::ConstElement_ptr A, const size_t lda,
+				    typename Field::Element_ptr X, const size_t ldx,
+				    typename Field::Element_ptr u, size_t* P,
+				    bool computeX
+				    , const FFPACK::FFPACK_MINPOLY_TAG MinTag
+				    , const size_t kg_mc
+				    , const size_t kg_mb
+				    , const size_t kg_j
+				    , const PSHelper& psH
+				  )
+		{
 
 			size_t MN = std::min(M,N);
 
@@ -687,7 +736,7 @@ namespace FFPACK {
 
 				// Recursive call on NW
 				size_t R = LUdivine_construct(F, Diag, Nup, N, A, lda, X, ldx, u,
-							      P, computeX, MinTag, kg_mc, kg_mb, kg_j );
+							      P, computeX, MinTag, kg_mc, kg_mb, kg_j, psH);
 				if (R==Nup){
 					typename Field::Element_ptr Xr = X + Nup*ldx; //  SW
 					typename Field::Element_ptr Xc = X + Nup;     //  NE
@@ -696,8 +745,7 @@ namespace FFPACK {
 					if ( computeX ){
 						if (MinTag == FFPACK::FfpackDense)
 							for (size_t i=0; i< Ndown; ++i, Xi+=ldx){
-								fgemv(F, FFLAS::FflasNoTrans, N, N, F.one,
-								      A, lda, u, 1, F.zero, Xi,1);
+								KrylovIterate (F, N, A, lda, u, Xi, psH);
 								FFLAS::fassign(F, N,Xi, 1, u,1);
 							}
 						else // Keller-Gehrig Fast algorithm's matrix
@@ -713,18 +761,18 @@ namespace FFPACK {
 					// Triangular block inversion of NW and apply to SW
 					// Xr <- Xr.U1^-1
 					ftrsm( F, FFLAS::FflasRight, FFLAS::FflasUpper, FFLAS::FflasNoTrans, Diag,
-					       Ndown, R, F.one, X, ldx, Xr, ldx);
+					       Ndown, R, F.one, X, ldx, Xr, ldx, psH);
 
 					// Update of SE
 					// Xn <- Xn - Xr*Xc
 					fgemm( F, FFLAS::FflasNoTrans, FFLAS::FflasNoTrans, Ndown, N-Nup, Nup,
-					       F.mOne, Xr, ldx, Xc, ldx, F.one, Xn, ldx);
+					       F.mOne, Xr, ldx, Xc, ldx, F.one, Xn, ldx, psH);
 
 					// Recursive call on SE
 
 					size_t R2 = LUdivine_construct(F, Diag, Ndown, N-Nup, A, lda,
 								       Xn, ldx, u, P + Nup,
-								       false, MinTag, kg_mc, kg_mb, kg_j);
+								       false, MinTag, kg_mc, kg_mb, kg_j, psH);
 					for ( size_t i=R;i<R+R2;++i) P[i] += R;
 
 					FFPACK::applyP( F, FFLAS::FflasRight, FFLAS::FflasTrans,
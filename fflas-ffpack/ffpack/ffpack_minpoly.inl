@@ -41,6 +41,23 @@ namespace FFPACK {
 		 ,const size_t kg_mb//=0
 		 ,const size_t kg_j //=0
 		 )
+	{
+		return MinPoly (F, minP, N, A, lda, X, ldx, P, MinTag, kg_mc, kg_mb, kg_j,
+				FFLAS::ParSeqHelper::Sequential());
+	}
+
+	template <class Field, class Polynomial, class PSHelper>
+	Polynomial&
+	MinPoly( const Field& F, Polynomial& minP, const size_t N
+		 ,typename Field::ConstElement_ptr A, const size_t lda
+		 ,typename Field::Element_ptr X, const size_t ldx
+		 ,size_t* P
+		 ,const FFPACK_MINPOLY_TAG MinTag
+		 ,const size_t kg_mc
+		 ,const size_t kg_mb
+		 ,const size_t kg_j
+		 ,const PSHelper& psH
+		 )
 	{
 		// nRow is the number of row in the krylov base already computed
 		size_t j, k ;
@@ -63,7 +80,7 @@ namespace FFPACK {
 		// nRow = 1;
 		// LUP factorization of the Krylov Base Matrix
 		k = Protected::LUdivine_construct (F, FFLAS::FflasUnit, N+1, N, A, lda, X, ldx, U, P, true,
-					MinTag, kg_mc, kg_mb, kg_j);
+					MinTag, kg_mc, kg_mb, kg_j, psH);
 		//FFLAS::fflas_delete( U);
 		minP.resize(k+1);
 		minP[k] = F.one;
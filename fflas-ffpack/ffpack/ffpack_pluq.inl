@@ -35,7 +35,7 @@
 //#define BCV3
 //#define LEFTLOOKING
 #ifndef BASECASE_K
-#define BASECASE_K 256
+#define BASECASE_K (FFLAS::tuning().pluq_basecase)
 #endif
 
 
@@ -431,11 +431,15 @@ namespace FFPACK {
 	}
 
 
+	namespace Protected {
+	/* The recursion of PLUQ: the four recursive calls go through PLUQ, so
+	 * that each of them is dispatched again by the compiled library.
+	 */
 	template<class Field>
 	inline size_t
-	PLUQ (const Field& Fi, const FFLAS::FFLAS_DIAG Diag,
-	      const size_t M, const size_t N,
-	      typename Field::Element_ptr A, const size_t lda, size_t*P, size_t *Q)
+	PLUQ_recursive (const Field& Fi, const FFLAS::FFLAS_DIAG Diag,
+			const size_t M, const size_t N,
+			typename Field::Element_ptr A, const size_t lda, size_t*P, size_t *Q)
 	{
 #ifdef BCONLY
   #ifdef CROUT
@@ -626,7 +630,16 @@ namespace FFPACK {
 
 		return R1+R2+R3+R4;
 	}
+	} // Protected
 
+	template<class Field>
+	inline size_t
+	PLUQ (const Field& Fi, const FFLAS::FFLAS_DIAG Diag,
+	      const size_t M, const size_t N,
+	      typename Field::Element_ptr A, const size_t lda, size_t*P, size_t *Q)
+	{
+		return Protected::PLUQ_recursive (Fi, Diag, M, N, A, lda, P, Q);
+	}
 
 } // namespace FFPACK
 #endif // __FFLASFFPACK_ffpack_pluq_INL
@@ -34,7 +34,9 @@
 
 #define __FFLAS__TRSM_READONLY
 
-#define PBASECASE_K 256
+#ifndef PBASECASE_K
+#define PBASECASE_K (FFLAS::tuning().ppluq_basecase)
+#endif
 
 
 namespace FFPACK {
@@ -45,13 +47,15 @@ namespace FFPACK {
 		size_t H1, H2, H3;
 		size_t M2 = m>>1;
 		size_t N2 = n>>1;
+		size_t nt = (size_t) std::max(nbthreads,1);
 
 		H1 = ((m-N2)*r*(N2-r))<<1;
 		H2 = ((M2-r)*r*(n-N2))<<1;
 		H3 = ((m-M2)*r*(n-N2))<<1;
 
 		// if we take into account 2 concurrent pluq calls....
-		size_t h;
+		// (weighted as much as the fgemm calls)
+		const size_t h = 1;
 		size_t z1= h*((m-M2)*(N2-r)*(N2-r)-(N2-r)*(N2-r)*(N2-r)/3);
 		size_t z2= h*((n-N2)*(M2-r)*(M2-r)-(M2-r)*(M2-r)*(M2-r)/3);
 
@@ -59,22 +63,27 @@ namespace FFPACK {
 		H2+= z2;
 
 		// compute number of threads for each fgemm call
-		*W1=std::max(H1*nbthreads/(H1+H2+H3),(size_t)1);
-		*W2=std::max(H2*nbthreads/(H1+H2+H3),(size_t)1);
-		*W3=std::max(nbthreads-*W1-*W2,(size_t)1);
+		size_t Htot = std::max(H1+H2+H3,(size_t)1);
+		*W1=std::max(H1*nt/Htot,(size_t)1);
+		*W2=std::max(H2*nt/Htot,(size_t)1);
+		*W3=std::max(nt-std::min(nt,*W1+*W2),(size_t)1);
 
 		// add gamma factor to change number of threads for pluq calls
-		W1-= gamma*z1/(z1+z2);
-		W2-= gamma*(1-z1/(z1+z2));
-		W3+= gamma;
-
+		if (z1+z2) {
+			size_t g1 = gamma*z1/(z1+z2);
+			size_t g2 = gamma-g1;
+			*W1 = (*W1 > g1) ? *W1-g1 : 1;
+			*W2 = (*W2 > g2) ? *W2-g2 : 1;
+			*W3 += gamma;
+		}
 	}
 
 	template<class Field>
 	void threads_ftrsm(const size_t m, const size_t n, int nbthreads, size_t * t1, size_t * t2)
 	{
-		*t1 = nbthreads*m/(m+n);
-		*t2 = nbthreads-(int)*t1;
+		size_t nt = (size_t) std::max(nbthreads,1);
+		*t1 = (m+n) ? nt*m/(m+n) : 0;
+		*t2 = nt-*t1;
 	}
 
 
@@ -400,6 +409,157 @@ namespace FFPACK {
     //#endif
 	  }
 	
+	namespace Protected {
+
+		/* Factors the tile k of rows [k*nb, k*nb+nb) of the tile PLUQ, once its
+		 * rows are updated by the previous steps.
+		 * rs[k] is the rank of the rows above the tile; the columns [rs[k], N)
+		 * of the tile are factored, and the rk pivot rows moved above the
+		 * rows found dependent so far. Sets rs[k+1] = rs[k]+rk.
+		 * The column permutation of the step is stored in Qs+k*N: it is applied
+		 * to the rows below by pluq_tile_update and to the U rows above at the end.
+		 */
+		template<class Field>
+		void pluq_tile_panel (const Field& Fi, const FFLAS::FFLAS_DIAG Diag,
+				      const size_t M, const size_t N,
+				      typename Field::Element_ptr A, const size_t lda,
+				      const size_t k, const size_t nb,
+				      size_t* rs, size_t* Qs, size_t* MathP, size_t* MathQ)
+		{
+			const size_t i = k*nb;
+			const size_t h = std::min(nb, M-i);
+			const size_t r = rs[k];
+			size_t * Pk = FFLAS::fflas_new<size_t>(h);
+			size_t * Qk = Qs + k*N;
+
+			size_t rk = PLUQ (Fi, Diag, h, N-r, A+i*lda+r, lda, Pk, Qk);
+
+			// L part on the left of the tile
+			applyP (Fi, FFLAS::FflasLeft, FFLAS::FflasNoTrans, r, 0, h, A+i*lda, lda, Pk);
+			for (size_t j=0; j<h; ++j)
+				if (Pk[j] != j) std::swap (MathP[i+j], MathP[i+Pk[j]]);
+			for (size_t j=0; j<N-r; ++j)
+				if (Qk[j] != j) std::swap (MathQ[r+j], MathQ[r+Qk[j]]);
+
+			// [ 0 ]    [ U ]
+			// [ U ] <- [ 0 ]
+			if (rk && i > r){
+				typename Field::Element_ptr tmp = FFLAS::fflas_new (Fi, rk, N);
+				FFLAS::fassign (Fi, rk, N, A+i*lda, lda, tmp, N);
+				for (size_t l=i; l-->r; )
+					FFLAS::fassign (Fi, N, A+l*lda, 1, A+(l+rk)*lda, 1);
+				FFLAS::fassign (Fi, rk, N, tmp, N, A+r*lda, lda);
+				FFLAS::fflas_delete (tmp);
+				std::rotate (MathP+r, MathP+i, MathP+i+rk);
+			}
+			rs[k+1] = r+rk;
+			FFLAS::fflas_delete (Pk);
+		}
+
+		/* Updates the tile t of rows [t*nb, t*nb+nb) by the step k:
+		 * [ X1 X2 ] <- [ X1 X2 ] Q_k^T
+		 * X1 <- X1 U_k^-1
+		 * X2 <- X2 - X1 V_k
+		 */
+		template<class Field>
+		void pluq_tile_update (const Field& Fi, const FFLAS::FFLAS_DIAG Diag,
+				       const size_t M, const size_t N,
+				       typename Field::Element_ptr A, const size_t lda,
+				       const size_t k, const size_t t, const size_t nb,
+				       const size_t* rs, const size_t* Qs)
+		{
+			const size_t i = t*nb;
+			const size_t h = std::min(nb, M-i);
+			const size_t r = rs[k];
+			const size_t rk = rs[k+1]-r;
+			typename Field::Element_ptr X = A+i*lda+r;
+			typename Field::ConstElement_ptr U = A+r*lda+r;
+
+			applyP (Fi, FFLAS::FflasRight, FFLAS::FflasTrans, h, 0, N-r, X, lda, Qs+k*N);
+			if (!rk) return;
+			ftrsm (Fi, FFLAS::FflasRight, FFLAS::FflasUpper, FFLAS::FflasNoTrans, Diag,
+			       h, rk, Fi.one, U, lda, X, lda);
+			fgemm (Fi, FFLAS::FflasNoTrans, FFLAS::FflasNoTrans, h, N-r-rk, rk,
+			       Fi.mOne, X, lda, U+rk, lda, Fi.one, X+rk, lda);
+		}
+
+		/* Applies the column permutations of the steps following their
+		 * factorization to the U rows [rbeg, rend).
+		 */
+		template<class Field>
+		void pluq_tile_permuteU (const Field& Fi, const size_t N,
+					 typename Field::Element_ptr A, const size_t lda,
+					 const size_t rbeg, const size_t rend, const size_t K,
+					 const size_t* rs, const size_t* Qs)
+		{
+			for (size_t k=1; k<K; ++k)
+				if (rs[k] > rbeg)
+					applyP (Fi, FFLAS::FflasRight, FFLAS::FflasTrans, std::min(rend,rs[k])-rbeg,
+						0, N-rs[k], A+rbeg*lda+rs[k], lda, Qs+k*N);
+		}
+
+	} // Protected
+
+	template<class Field>
+	inline size_t
+	pPLUQ_tile (const Field& Fi, const FFLAS::FFLAS_DIAG Diag,
+		    const size_t M, const size_t N,
+		    typename Field::Element_ptr A, const size_t lda,
+		    size_t* P, size_t* Q, int nt, size_t nb)
+	{
+		for (size_t i=0; i<M; ++i) P[i] = i;
+		for (size_t i=0; i<N; ++i) Q[i] = i;
+		if (std::min(M,N) == 0) return 0;
+
+		size_t nth = (size_t) std::max(nt,1);
+		if (!nb)
+			nb = std::max ((size_t)32, std::min ((size_t)256, M/(4*nth)));
+		const size_t K = (M+nb-1)/nb;
+
+		size_t * rs = FFLAS::fflas_new<size_t>(K+1);
+		size_t * Qs = FFLAS::fflas_new<size_t>(K*N);
+		size_t * MathP = FFLAS::fflas_new<size_t>(M);
+		size_t * MathQ = FFLAS::fflas_new<size_t>(N);
+		for (size_t i=0; i<M; ++i) MathP[i] = i;
+		for (size_t i=0; i<N; ++i) MathQ[i] = i;
+		rs[0] = 0;
+		// dependency tokens of the tile rows and of the panel factorizations
+		char * tdep = FFLAS::fflas_new<char>(K);
+		char * pdep = FFLAS::fflas_new<char>(K);
+
+		Protected::pluq_tile_panel (Fi, Diag, M, N, A, lda, 0, nb, rs, Qs, MathP, MathQ);
+
+		SYNCH_GROUP(
+		for (size_t k=0; k+1<K; ++k){
+			// look-ahead: the next panel only waits for its own tile to be updated
+			TASK(MODE(CONSTREFERENCE(Fi) READ(pdep[k]) READWRITE(tdep[k+1]) WRITE(pdep[k+1])),
+			     Protected::pluq_tile_update (Fi, Diag, M, N, A, lda, k, k+1, nb, rs, Qs);
+			     Protected::pluq_tile_panel (Fi, Diag, M, N, A, lda, k+1, nb, rs, Qs, MathP, MathQ);
+			     );
+			for (size_t t=k+2; t<K; ++t)
+				TASK(MODE(CONSTREFERENCE(Fi) READ(pdep[k]) READWRITE(tdep[t])),
+				     Protected::pluq_tile_update (Fi, Diag, M, N, A, lda, k, t, nb, rs, Qs);
+				     );
+			// with dataflow, the steps overlap as far as the dependencies allow
+			CHECK_DEPENDENCIES;
+		}
+		);
+		const size_t R = rs[K];
+
+		SYNCH_GROUP(
+		for (size_t i=0; i<R; i+=nb)
+			TASK(MODE(CONSTREFERENCE(Fi)),
+			     Protected::pluq_tile_permuteU (Fi, N, A, lda, i, std::min(i+nb,R), K, rs, Qs);
+			     );
+		);
+
+		MathPerm2LAPACKPerm (P, MathP, M);
+		MathPerm2LAPACKPerm (Q, MathQ, N);
+
+		FFLAS::fflas_delete (rs, Qs, MathP, MathQ, tdep, pdep);
+		return R;
+	}
+
 }// namespace FFPACK
 
 //#endif // OPENMP
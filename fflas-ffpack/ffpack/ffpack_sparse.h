@@ -0,0 +1,193 @@
+/* -*- mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+// vim:sts=4:sw=4:ts=4:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/*
+ * Copyright (C) 2016 the FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ *.
+ */
+
+/** @file ffpack/ffpack_sparse.h
+ * @brief Sparse matrices: elimination (rank, rank profiles and PLUQ permutations)
+ * and the black box methods of block Wiedemann (rank, determinant, system solving
+ * and nullspace).
+ *
+ * Like fflas_sparse.h for FFLAS, this header is not included by ffpack.h.
+ */
+
+#ifndef __FFLASFFPACK_ffpack_sparse_H
+#define __FFLASFFPACK_ffpack_sparse_H
+
+#include "fflas-ffpack/ffpack/ffpack.h"
+#include "fflas-ffpack/fflas/fflas_sparse.h"
+
+#ifndef __FFLASFFPACK_SPARSE_PLUQ_DENSITY
+//! density of the Schur complement above which SparsePLUQ switches to the dense PLUQ
+#define __FFLASFFPACK_SPARSE_PLUQ_DENSITY 0.05
+#endif
+
+#ifndef __FFLASFFPACK_SPARSE_PLUQ_MARKOWITZ
+//! largest Markowitz cost (r-1)(c-1) of a pivot eliminated by the sparse phase of SparsePLUQ
+#define __FFLASFFPACK_SPARSE_PLUQ_MARKOWITZ 1024
+#endif
+
+namespace FFPACK { /* sparse PLUQ */
+
+	/** @brief Computes the rank and the PLUQ permutations of a sparse matrix.
+	 *
+	 * Structured Gaussian elimination: at each round, the rows whose first
+	 * non zero entry is in a column \c j are the candidate pivots of \c j, the
+	 * shortest one is the pivot if its Markowitz cost is at most \p markowitz,
+	 * and the other rows are reduced by the pivots of the round. When the
+	 * Schur complement has a density above \p density, or no pivot can be
+	 * taken, it is stored densely and factorized by PLUQ.
+	 *
+	 * Such pivots keep the column rank profile: rows \c MathP[0..R) and columns
+	 * \c MathQ[0..R) form a non singular minor with a generic rank profile
+	 * (\c MathP, \c MathQ being the LAPACK permutations \p P and \p Q in
+	 * Maths format), and the columns \c MathQ[0..R) are the column rank profile
+	 * of \p A. The factors \c L and \c U are not computed.
+	 * @param F field
+	 * @param A input matrix, of dimension \c A.m x \c A.n
+	 * @param P the row permutation, of dimension \c A.m
+	 * @param Q the column permutation, of dimension \c A.n
+	 * @param density switching density of the Schur complement
+	 * @param markowitz largest Markowitz cost of a sparse pivot
+	 * @return the rank of \p A
+	 * @bib
+	 * - Bouillaguet C., Delaplace C. <i>\c Sparse Gaussian elimination modulo p: an update</i>, CASC'16, 2016
+	 * .
+	 */
+	template <class Field>
+	size_t
+	SparsePLUQ (const Field& F, const FFLAS::Sparse<Field, FFLAS::SparseMatrix_t::CSR>& A,
+				size_t* P, size_t* Q,
+				const double density = __FFLASFFPACK_SPARSE_PLUQ_DENSITY,
+				const uint64_t markowitz = __FFLASFFPACK_SPARSE_PLUQ_MARKOWITZ);
+
+	/** Computes the rank of a sparse matrix with SparsePLUQ.
+	 * @param F field
+	 * @param A input matrix
+	 */
+	template <class Field>
+	size_t
+	SparseRank (const Field& F, const FFLAS::Sparse<Field, FFLAS::SparseMatrix_t::CSR>& A);
+
+	/**  @brief Computes the column rank profile of a sparse matrix with SparsePLUQ.
+	 *
+	 * @param F field
+	 * @param A input matrix
+	 * @param rkprofile return the rank profile as an array of column indexes, of dimension r=rank(A)
+	 *
+	 * rkprofile is allocated during the computation.
+	 * @returns R
+	 */
+	template <class Field>
+	size_t
+	SparseColumnRankProfile (const Field& F, const FFLAS::Sparse<Field, FFLAS::SparseMatrix_t::CSR>& A,
+							 size_t* &rkprofile);
+
+	/**  @brief Computes the row rank profile of a sparse matrix, the column rank profile of its transpose.
+	 *
+	 * @param F field
+	 * @param A input matrix
+	 * @param rkprofile return the rank profile as an array of row indexes, of dimension r=rank(A)
+	 *
+	 * rkprofile is allocated during the computation.
+	 * @returns R
+	 */
+	template <class Field>
+	size_t
+	SparseRowRankProfile (const Field& F, const FFLAS::Sparse<Field, FFLAS::SparseMatrix_t::CSR>& A,
+						  size_t* &rkprofile);
+
+} // FFPACK sparse PLUQ
+
+namespace FFPACK { /* block Wiedemann */
+
+	/** @brief Computes the rank of a sparse matrix by the block Wiedemann algorithm.
+	 *
+	 * Monte Carlo: the result may be too small, with a probability which
+	 * decreases with the size of the field.
+	 * Works on CSR, CSC, SELL and their ZO versions, the formats with sequential and
+	 * parallel fspmm_transpose; the other formats fail a static assertion.
+	 * @param F field
+	 * @param A input matrix
+	 * @param blockSize the blocking factor, chosen from the number of threads if 0
+	 * @bib
+	 * - Coppersmith D. <i>\c Solving homogeneous linear equations over GF(2) via block Wiedemann algorithm</i>, Math. Comp. 62, 1994
+	 * - Giorgi P., Jeannerod C.-P., Villard G. <i>\c On the complexity of polynomial matrix computations</i>, ISSAC'03, 2003
+	 * .
+	 */
+	template <class Field, class SM>
+	size_t
+	BlockWiedemannRank (const Field& F, const SM& A, const size_t blockSize = 0);
+
+	/** @brief Computes the determinant of a sparse matrix by the block Wiedemann algorithm.
+	 *
+	 * The determinant of a non square matrix is zero.
+	 * @param F field
+	 * @param A input matrix
+	 * @param blockSize the blocking factor, chosen from the number of threads if 0
+	 * @throw std::runtime_error if no characteristic polynomial is found (small field)
+	 */
+	template <class Field, class SM>
+	typename Field::Element
+	BlockWiedemannDet (const Field& F, const SM& A, const size_t blockSize = 0);
+
+	/** @brief Solves the non singular sparse system \f$Ax=y\f$ by the block Wiedemann algorithm.
+	 *
+	 * @param F field
+	 * @param A square input matrix
+	 * @param x the solution, of dimension \c A.n
+	 * @param y right hand side, of dimension \c A.n
+	 * @param blockSize the blocking factor, chosen from the number of threads if 0
+	 * @throw std::runtime_error if A is not square, or no solution is found (A singular)
+	 * @return x
+	 */
+	template <class Field, class SM>
+	typename Field::Element_ptr
+	BlockWiedemannSolve (const Field& F, const SM& A, typename Field::Element_ptr x,
+						 typename Field::ConstElement_ptr y, const size_t blockSize = 0);
+
+	/** @brief Computes vectors of the right nullspace of a square sparse matrix by the block Wiedemann algorithm.
+	 *
+	 * At most \p blockSize independent vectors are found: they are a basis of
+	 * the nullspace with high probability when its dimension is at most the
+	 * blocking factor.
+	 * @param F field
+	 * @param A square input matrix
+	 * @param[out] NS output matrix of dimension \c A.n x NSdim (allocated here)
+	 * @param[out] ldn
+	 * @param[out] NSdim the number of vectors found
+	 * @param blockSize the blocking factor, chosen from the number of threads if 0
+	 * @throw std::runtime_error if A is not square
+	 * @return NSdim
+	 */
+	template <class Field, class SM>
+	size_t
+	BlockWiedemannNullSpace (const Field& F, const SM& A, typename Field::Element_ptr& NS, size_t& ldn,
+							 size_t& NSdim, const size_t blockSize = 0);
+
+} // FFPACK block Wiedemann
+
+#include "ffpack_sparse_pluq.inl"
+#include "ffpack_blockwiedemann.inl"
+
+#endif // __FFLASFFPACK_ffpack_sparse_H
@@ -0,0 +1,398 @@
+/* -*- mode: C++; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+// vim:sts=4:sw=4:ts=4:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/*
+ * Copyright (C) 2016 the FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ *.
+ */
+
+/** @file ffpack/ffpack_sparse_pluq.inl
+ * @brief Structured Gaussian elimination of a CSR matrix, ended by a dense PLUQ.
+ *
+ * The active rows are sparse vectors whose columns are increasing. A round
+ * takes as pivot of column \c j the shortest active row starting in \c j,
+ * when its Markowitz cost is small enough, then reduces the other active rows
+ * starting in a later column, by a sparse triangular solve in a dense
+ * accumulator, the pivot columns of the round being visited in increasing
+ * order. Each thread reduces a contiguous range of rows, of about the same
+ * number of entries.
+ *
+ * If \c J are the pivot columns of a round, the column rank profile of the
+ * active rows is \c J and the column rank profile of their Schur complement,
+ * whose columns keep their order: the pivot rows are in echelon form with
+ * leading columns \c J and the reduced rows are zero on \c J.
+ */
+
+#ifndef __FFLASFFPACK_ffpack_sparse_pluq_INL
+#define __FFLASFFPACK_ffpack_sparse_pluq_INL
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <vector>
+
+namespace FFPACK { namespace Protected { namespace sparse_pluq {
+
+	//! rows of a sparse matrix under elimination
+	template <class Field>
+	struct Rows {
+		std::vector<std::vector<index_t> > col;
+		std::vector<std::vector<typename Field::Element> > dat;
+
+		//! copies the rows of \p A, sorted, without their zero entries
+		Rows (const Field& F, const FFLAS::Sparse<Field, FFLAS::SparseMatrix_t::CSR>& A) :
+			col(A.m), dat(A.m)
+		{
+			std::vector<std::pair<index_t, typename Field::Element> > row;
+			for (index_t i = 0; i < A.m; ++i) {
+				row.clear();
+				for (index_t k = A.st[i]; k < A.st[i+1]; ++k)
+					if (!F.isZero(A.dat[k]))
+						row.emplace_back(A.col[k], A.dat[k]);
+				std::sort(row.begin(), row.end(),
+						  [](const std::pair<index_t, typename Field::Element>& a,
+							 const std::pair<index_t, typename Field::Element>& b) { return a.first < b.first; });
+				col[i].reserve(row.size());
+				dat[i].reserve(row.size());
+				for (auto& e : row) {
+					col[i].push_back(e.first);
+					dat[i].push_back(e.second);
+				}
+			}
+		}
+
+		size_t size (size_t i) const { return col[i].size(); }
+
+		void clear (size_t i)
+		{
+			std::vector<index_t>().swap(col[i]);
+			std::vector<typename Field::Element>().swap(dat[i]);
+		}
+	};
+
+	//! workspace of a thread: dense accumulator and its markers
+	template <class Field>
+	struct Accumulator {
+		std::vector<typename Field::Element> acc;
+		std::vector<uint64_t> mark;
+		std::vector<index_t> touched;
+		std::priority_queue<index_t, std::vector<index_t>, std::greater<index_t> > pending;
+		uint64_t stamp;
+
+		Accumulator (const Field& F, size_t n) : acc(n, F.zero), mark(n, 0), stamp(0) {}
+	};
+
+	/** \internal
+	 * Reduces the row \p i by the pivot rows <code>piv[j]</code> of its columns \c j,
+	 * whose first entry is one. \p none marks the columns without pivot.
+	 */
+	template <class Field>
+	inline void reduce_row (const Field& F, Rows<Field>& R, const size_t i,
+							const std::vector<size_t>& piv, const size_t none, Accumulator<Field>& W)
+	{
+		std::vector<index_t>& ci = R.col[i];
+		std::vector<typename Field::Element>& di = R.dat[i];
+		bool pivot = false;
+		for (index_t c : ci)
+			pivot = pivot || (piv[c] != none);
+		if (!pivot)
+			return;
+
+		const uint64_t s = ++W.stamp;
+		W.touched.clear();
+		for (size_t k = 0; k < ci.size(); ++k) {
+			W.mark[ci[k]] = s;
+			W.touched.push_back(ci[k]);
+			F.assign(W.acc[ci[k]], di[k]);
+			if (piv[ci[k]] != none)
+				W.pending.push(ci[k]);
+		}
+		typename Field::Element a;
+		while (!W.pending.empty()) {
+			const index_t j = W.pending.top();
+			W.pending.pop();
+			if (F.isZero(W.acc[j]))
+				continue;
+			F.neg(a, W.acc[j]);
+			const std::vector<index_t>& cp = R.col[piv[j]];
+			const std::vector<typename Field::Element>& dp = R.dat[piv[j]];
+			for (size_t k = 0; k < cp.size(); ++k) {
+				const index_t c = cp[k];
+				if (W.mark[c] != s) {
+					W.mark[c] = s;
+					W.touched.push_back(c);
+					F.assign(W.acc[c], F.zero);
+					if (piv[c] != none)
+						W.pending.push(c);
+				}
+				F.axpyin(W.acc[c], a, dp[k]);
+			}
+		}
+		std::sort(W.touched.begin(), W.touched.end());
+		ci.clear();
+		di.clear();
+		for (index_t c : W.touched)
+			if (piv[c] == none && !F.isZero(W.acc[c])) {
+				ci.push_back(c);
+				di.push_back(W.acc[c]);
+			}
+	}
+
+	/** \internal
+	 * Eliminates the rows of \p A, and writes in \p MathP and \p MathQ the
+	 * pivot rows and columns, followed by the others in increasing order.
+	 * @return the rank of \p A
+	 */
+	template <class Field>
+	inline size_t eliminate (const Field& F, const FFLAS::Sparse<Field, FFLAS::SparseMatrix_t::CSR>& A,
+							 size_t* MathP, size_t* MathQ, const double density, const uint64_t markowitz)
+	{
+		const size_t m = A.m, n = A.n;
+		Rows<Field> R(F, A);
+		std::vector<size_t> active;
+		for (size_t i = 0; i < m; ++i)
+			if (R.size(i))
+				active.push_back(i);
+
+		const size_t nt = std::max<size_t>(1, std::min<size_t>(MAX_THREADS, m));
+		std::vector<Accumulator<Field> > W(nt, Accumulator<Field>(F, n));
+		std::vector<size_t> piv(n, m), best(n, m), rest;
+		std::vector<uint64_t> cnt(n, 0), len;
+		std::vector<std::pair<index_t, size_t> > round;
+		std::vector<bool> isPivRow(m, false), isPivCol(n, false);
+		size_t r = 0;
+
+		while (!active.empty()) {
+			uint64_t nnz = 0;
+			for (size_t i : active)
+				nnz += R.size(i);
+			if ((double)nnz > density * (double)active.size() * (double)(n - r))
+				break;
+
+			// shortest candidate of each column, and Markowitz costs
+			for (size_t i : active) {
+				for (index_t c : R.col[i])
+					++cnt[c];
+				size_t& b = best[R.col[i][0]];
+				if (b == m || R.size(i) < R.size(b))
+					b = i;
+			}
+			round.clear();
+			for (size_t i : active) {
+				const index_t j = R.col[i][0];
+				if (best[j] == i && (R.size(i) - 1) * (cnt[j] - 1) <= markowitz)
+					round.emplace_back(j, i);
+			}
+			for (size_t i : active) {
+				for (index_t c : R.col[i])
+					cnt[c] = 0;
+				best[R.col[i][0]] = m;
+			}
+			if (round.empty())
+				break;
+
+			// the pivots of the round, with leading entry one, by increasing columns
+			std::sort(round.begin(), round.end());
+			typename Field::Element inv;
+			for (auto& p : round) {
+				MathQ[r] = p.first;
+				MathP[r] = p.second;
+				++r;
+				piv[p.first] = p.second;
+				isPivRow[p.second] = true;
+				isPivCol[p.first] = true;
+				F.inv(inv, R.dat[p.second][0]);
+				for (auto& x : R.dat[p.second])
+					F.mulin(x, inv);
+			}
+
+			rest.clear();
+			len.assign(1, 0);
+			for (size_t i : active)
+				if (!isPivRow[i]) {
+					rest.push_back(i);
+					len.push_back(len.back() + R.size(i));
+				}
+			const size_t p = std::max<size_t>(1, std::min<size_t>(nt, rest.size()));
+			// one block of rows per thread, balanced by their lengths
+			const FFLAS::ParSeqHelper::Parallel<FFLAS::CuttingStrategy::Block, FFLAS::StrategyParameter::Threads> par(p);
+			FFLAS::Protected::pforblock1d_static (p, par, [&](size_t tb, size_t te) {
+				for (size_t t = tb; t < te; ++t) {
+					const size_t ibeg = (t == 0) ? 0 : (size_t)(std::lower_bound(len.begin(), len.end(), len.back() * t / p) - len.begin());
+					const size_t iend = (t + 1 == p) ? rest.size() : (size_t)(std::lower_bound(len.begin(), len.end(), len.back() * (t + 1) / p) - len.begin());
+					for (size_t k = ibeg; k < iend; ++k)
+						reduce_row(F, R, rest[k], piv, m, W[t]);
+				}
+			});
+
+			for (auto& q : round) {
+				piv[q.first] = m;
+				R.clear(q.second);
+			}
+			active.clear();
+			for (size_t i : rest)
+				if (R.size(i))
+					active.push_back(i);
+				else
+					R.clear(i);
+		}
+
+		if (!active.empty()) {
+			// dense Schur complement, on the columns having an entry, in increasing order
+			std::vector<size_t> cols;
+			for (size_t i : active)
+				for (index_t c : R.col[i])
+					if (piv[c] == m) {
+						piv[c] = 0;
+						cols.push_back(c);
+					}
+			std::sort(cols.begin(), cols.end());
+			for (size_t k = 0; k < cols.size(); ++k)
+				piv[cols[k]] = k;
+			const size_t ms = active.size(), ns = cols.size();
+			typename Field::Element_ptr S = FFLAS::fflas_new(F, ms, ns);
+			FFLAS::fzero(F, ms, ns, S, ns);
+			for (size_t k = 0; k < ms; ++k) {
+				const size_t i = active[k];
+				for (size_t l = 0; l < R.size(i); ++l)
+					F.assign(S[k*ns + piv[R.col[i][l]]], R.dat[i][l]);
+				R.clear(i);
+			}
+			size_t* P2 = FFLAS::fflas_new<size_t>(ms);
+			size_t* Q2 = FFLAS::fflas_new<size_t>(ns);
+			const size_t r2 = PLUQ(F, FFLAS::FflasNonUnit, ms, ns, S, ns, P2, Q2);
+			size_t* MathP2 = FFLAS::fflas_new<size_t>(ms);
+			size_t* MathQ2 = FFLAS::fflas_new<size_t>(ns);
+			LAPACKPerm2MathPerm(MathP2, P2, ms);
+			LAPACKPerm2MathPerm(MathQ2, Q2, ns);
+			for (size_t k = 0; k < r2; ++k) {
+				MathP[r] = active[MathP2[k]];
+				MathQ[r] = cols[MathQ2[k]];
+				isPivRow[MathP[r]] = true;
+				isPivCol[MathQ[r]] = true;
+				++r;
+			}
+			FFLAS::fflas_delete(S, P2, Q2, MathP2, MathQ2);
+		}
+
+		size_t k = r;
+		for (size_t i = 0; i < m; ++i)
+			if (!isPivRow[i])
+				MathP[k++] = i;
+		k = r;
+		for (size_t j = 0; j < n; ++j)
+			if (!isPivCol[j])
+				MathQ[k++] = j;
+		return r;
+	}
+
+	//! \p T is the transpose of \p A, its rows being sorted
+	template <class Field>
+	inline void transpose (const Field& F, const FFLAS::Sparse<Field, FFLAS::SparseMatrix_t::CSR>& A,
+						   FFLAS::Sparse<Field, FFLAS::SparseMatrix_t::CSR>& T)
+	{
+		const uint64_t nnz = A.st[A.m];
+		T.m = A.n;
+		T.n = A.m;
+		T.nnz = nnz;
+		T.nElements = nnz;
+		T.st = FFLAS::fflas_new<index_t>(T.m + 1, FFLAS::Alignment::CACHE_LINE);
+		T.col = FFLAS::fflas_new<index_t>(nnz, FFLAS::Alignment::CACHE_LINE);
+		T.dat = FFLAS::fflas_new(F, nnz, 1, FFLAS::Alignment::CACHE_LINE);
+		std::fill(T.st, T.st + T.m + 1, 0);
+		for (uint64_t k = 0; k < nnz; ++k)
+			++T.st[A.col[k] + 1];
+		T.maxrow = 0;
+		for (index_t j = 0; j < T.m; ++j) {
+			T.maxrow = std::max<uint64_t>(T.maxrow, T.st[j + 1]);
+			T.st[j + 1] += T.st[j];
+		}
+		std::vector<index_t> pos(T.st, T.st + T.m);
+		for (index_t i = 0; i < A.m; ++i)
+			for (index_t k = A.st[i]; k < A.st[i + 1]; ++k) {
+				T.col[pos[A.col[k]]] = i;
+				F.assign(T.dat[pos[A.col[k]]++], A.dat[k]);
+			}
+		T.stend = nullptr;
+	}
+
+}}} // FFPACK::Protected::sparse_pluq
+
+namespace FFPACK {
+
+	template <class Field>
+	inline size_t
+	SparsePLUQ (const Field& F, const FFLAS::Sparse<Field, FFLAS::SparseMatrix_t::CSR>& A,
+				size_t* P, size_t* Q, const double density, const uint64_t markowitz)
+	{
+		// the permutations refer to the rows and columns of A as stored
+		FFLASFFPACK_check(A.reorder == nullptr);
+		size_t* MathP = FFLAS::fflas_new<size_t>(A.m);
+		size_t* MathQ = FFLAS::fflas_new<size_t>(A.n);
+		const size_t R = Protected::sparse_pluq::eliminate(F, A, MathP, MathQ, density, markowitz);
+		MathPerm2LAPACKPerm(P, MathP, A.m);
+		MathPerm2LAPACKPerm(Q, MathQ, A.n);
+		FFLAS::fflas_delete(MathP, MathQ);
+		return R;
+	}
+
+	template <class Field>
+	inline size_t
+	SparseRank (const Field& F, const FFLAS::Sparse<Field, FFLAS::SparseMatrix_t::CSR>& A)
+	{
+		size_t* MathP = FFLAS::fflas_new<size_t>(A.m);
+		size_t* MathQ = FFLAS::fflas_new<size_t>(A.n);
+		const size_t R = Protected::sparse_pluq::eliminate(F, A, MathP, MathQ,
+														   __FFLASFFPACK_SPARSE_PLUQ_DENSITY,
+														   __FFLASFFPACK_SPARSE_PLUQ_MARKOWITZ);
+		FFLAS::fflas_delete(MathP, MathQ);
+		return R;
+	}
+
+	template <class Field>
+	inline size_t
+	SparseColumnRankProfile (const Field& F, const FFLAS::Sparse<Field, FFLAS::SparseMatrix_t::CSR>& A,
+							 size_t* &rkprofile)
+	{
+		size_t* P = FFLAS::fflas_new<size_t>(A.m);
+		size_t* Q = FFLAS::fflas_new<size_t>(A.n);
+		const size_t R = SparsePLUQ(F, A, P, Q);
+		rkprofile = FFLAS::fflas_new<size_t>(R);
+		RankProfileFromLU(Q, A.n, R, rkprofile, FfpackTileRecursive);
+		FFLAS::fflas_delete(P, Q);
+		return R;
+	}
+
+	template <class Field>
+	inline size_t
+	SparseRowRankProfile (const Field& F, const FFLAS::Sparse<Field, FFLAS::SparseMatrix_t::CSR>& A,
+						  size_t* &rkprofile)
+	{
+		FFLASFFPACK_check(A.reorder == nullptr);
+		FFLAS::Sparse<Field, FFLAS::SparseMatrix_t::CSR> T;
+		Protected::sparse_pluq::transpose(F, A, T);
+		const size_t R = SparseColumnRankProfile(F, T, rkprofile);
+		FFLAS::sparse_delete(T);
+		return R;
+	}
+
+} // FFPACK
+
+#endif // __FFLASFFPACK_ffpack_sparse_pluq_INL
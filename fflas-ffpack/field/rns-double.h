@@ -49,6 +49,7 @@
 #include "fflas-ffpack/utils/align-allocator.h"
 #include "fflas-ffpack/field/modular-extended.h"
 #include "fflas-ffpack/field/rns-double-elt.h"
+#include "fflas-ffpack/paladin/parallel.h"
 
 namespace FFPACK {
 
@@ -209,9 +210,42 @@ namespace FFPACK {
 		
 		// reduce entries of Arns to be less than the rns basis elements
 		void reduce(size_t n, double* Arns, size_t rda, bool RNS_MAJOR=false) const;
-		
 
-		
+		// same as above, with the work spread over the threads of a ParSeqHelper:
+		// the Kronecker transforms by blocks of rows of A, the CRT products by a
+		// parallel fgemm and the reductions by blocks of entries of Arns
+		void init(size_t m, size_t n, double* Arns, size_t rda, const integer* A, size_t lda, size_t k,
+			  const FFLAS::ParSeqHelper::Sequential&, bool RNS_MAJOR=false) const
+		{
+			init(m,n,Arns,rda,A,lda,k,RNS_MAJOR);
+		}
+		template<class Cut, class Param>
+		void init(size_t m, size_t n, double* Arns, size_t rda, const integer* A, size_t lda, size_t k,
+			  const FFLAS::ParSeqHelper::Parallel<Cut,Param>& ps, bool RNS_MAJOR=false) const;
+
+		void convert(size_t m, size_t n, integer gamma, integer* A, size_t lda, const double* Arns, size_t rda,
+			     const FFLAS::ParSeqHelper::Sequential&, bool RNS_MAJOR=false) const
+		{
+			convert(m,n,gamma,A,lda,Arns,rda,RNS_MAJOR);
+		}
+		template<class Cut, class Param>
+		void convert(size_t m, size_t n, integer gamma, integer* A, size_t lda, const double* Arns, size_t rda,
+			     const FFLAS::ParSeqHelper::Parallel<Cut,Param>& ps, bool RNS_MAJOR=false) const;
+
+		void reduce(size_t n, double* Arns, size_t rda, const FFLAS::ParSeqHelper::Sequential&, bool RNS_MAJOR=false) const
+		{
+			reduce(n,Arns,rda,RNS_MAJOR);
+		}
+		template<class Cut, class Param>
+		void reduce(size_t n, double* Arns, size_t rda, const FFLAS::ParSeqHelper::Parallel<Cut,Param>& ps, bool RNS_MAJOR=false) const;
+
+		// Kronecker transform in base 2^16 of the rows [ibeg,iend) of the m x n matrix A:
+		// the k words of A[i*lda+j] go to A_beta[(i*n+j)*k..(i*n+j+1)*k)
+		void kronecker_split(size_t ibeg, size_t iend, size_t n, double* A_beta, const integer* A, size_t lda, size_t k) const;
+		// inverse transform of the rows [ibeg,iend) of A_beta (_ldm words per entry),
+		// reduced modulo _M in symmetric representation, into A <- gamma A + result
+		void kronecker_merge(size_t ibeg, size_t iend, size_t n, integer gamma, integer* A, size_t lda, const double* A_beta) const;
+
 	}; // end of struct rns_double
 	
 	/* Structure that handles rns representation given a bound and bitsize for prime moduli, allow large moduli
@@ -44,33 +44,14 @@ namespace FFPACK {
 		}
 		size_t mn=m*n;
 		double *A_beta = FFLAS::fflas_new<double >(mn*k);
-		const integer* Aiter=A;
 			// split A into A_beta according to a Kronecker transform in base 2^16
 //		auto sp=SPLITTER(MAX_THREADS,FFLAS::CuttingStrategy::Column,FFLAS::StrategyParameter::Threads);
 
 		Givaro::Timer tkr; tkr.start();
 		auto sp=SPLITTER(MAX_THREADS);
 		FOR1D(i,m,sp,
-				  for(size_t j=0;j<n;j++){
-					  size_t idx=j+i*n;
-					  const mpz_t*    m0     = reinterpret_cast<const mpz_t*>(Aiter+j+i*lda);
-					  const uint16_t* m0_ptr = reinterpret_cast<const uint16_t*>(m0[0]->_mp_d);
-					  size_t l=0;
-						  //size_t maxs=std::min(k,(Aiter[j+i*lda].size())<<2);
-					  size_t maxs=std::min(k,(Aiter[j+i*lda].size())*sizeof(mp_limb_t)/2);// to ensure 32 bits portability
-
-					  if (m0[0]->_mp_size >= 0)
-						  for (;l<maxs;l++)
-							  A_beta[l+idx*k]=  m0_ptr[l];
-					  else
-						  for (;l<maxs;l++)
-							  A_beta[l+idx*k]= - double(m0_ptr[l]);
-					  for (;l<k;l++)
-						  A_beta[l+idx*k]=  0.;
-
-						  // 	   );
-				  }
-				  );
+			  kronecker_split(i,i+1,n,A_beta,A,lda,k);
+			  );
 
 			tkr.stop();
 			//if(m>1 && n>1) std::cerr<<"Kronecker : "<<tkr.realtime()<<std::endl;
@@ -191,7 +172,6 @@ namespace FFPACK {
 
 #endif
 
-		integer hM= (_M-1)>>1;
 		size_t  mn= m*n;
 		double *A_beta= FFLAS::fflas_new<double>(mn*_ldm);
 		Givaro::Timer tfgemmc;tfgemmc.start();
@@ -207,72 +187,12 @@ namespace FFPACK {
 		tfgemmc.stop();
 		//if(m>1 && n>1) std::cerr<<"fgemm Convert : "<<tfgemmc.realtime()<<std::endl;
 			// compute A using inverse Kronecker transform of A_beta expressed in base 2^log_beta
-		integer* Aiter= A;
-		size_t k=_ldm;
-		size_t k4=((k+3)>>2)+ (((k+3)%4==0)?0:1);
-		std::vector<uint16_t> A0(k4<<2,0),A1(k4<<2,0),A2(k4<<2,0),A3(k4<<2,0);
-		integer a0,a1,a2,a3,res;
-		mpz_t *m0,*m1,*m2,*m3;
-		m0= reinterpret_cast<mpz_t*>(&a0);
-		m1= reinterpret_cast<mpz_t*>(&a1);
-		m2= reinterpret_cast<mpz_t*>(&a2);
-		m3= reinterpret_cast<mpz_t*>(&a3);
-		mp_limb_t *m0_d,*m1_d,*m2_d,*m3_d;
-		m0_d = m0[0]->_mp_d;
-		m1_d = m1[0]->_mp_d;
-		m2_d = m2[0]->_mp_d;
-		m3_d = m3[0]->_mp_d;
-		m0[0]->_mp_alloc = m1[0]->_mp_alloc = m2[0]->_mp_alloc = m3[0]->_mp_alloc = (int) (k4*8/sizeof(mp_limb_t)); // to ensure 32 bits portability
-		m0[0]->_mp_size  = m1[0]->_mp_size  = m2[0]->_mp_size  = m3[0]->_mp_size  = (int) (k4*8/sizeof(mp_limb_t)); // to ensure 32 bits portability
 		Givaro::Timer tkroc;
 		tkroc.start();
-//		auto sp=SPLITTER();
-//		PARFOR1D(i,m,sp,
-		for(size_t i=0;i<m;i++)
-			for (size_t j=0;j<n;j++){
-				size_t idx=i*n+j;
-				for (size_t l=0;l<k;l++){
-					uint64_t tmp=(uint64_t)A_beta[l+idx*k];
-					uint16_t* tptr= reinterpret_cast<uint16_t*>(&tmp);
-					A0[l  ]= tptr[0];
-					A1[l+1]= tptr[1];
-					A2[l+2]= tptr[2];
-					A3[l+3]= tptr[3];
-				}
-					// see A0,A1,A2,A3 as a the gmp integers a0,a1,a2,a3
-				m0[0]->_mp_d= reinterpret_cast<mp_limb_t*>(&A0[0]);
-				m1[0]->_mp_d= reinterpret_cast<mp_limb_t*>(&A1[0]);
-				m2[0]->_mp_d= reinterpret_cast<mp_limb_t*>(&A2[0]);
-				m3[0]->_mp_d= reinterpret_cast<mp_limb_t*>(&A3[0]);
-				res = a0;res+= a1;res+= a2;res+= a3;
-				res%=_M;
-
-					// get the correct result according to the expected sign of A
-				if (res>hM)
-					res-=_M;
-				if (gamma==0)
-					Aiter[j+i*lda]=res;
-				else
-					if (gamma==integer(1))
-						Aiter[j+i*lda]+=res;
-					else
-						if (gamma==integer(-1))
-							Aiter[j+i*lda]=res-Aiter[j+i*lda];
-						else{
-							Aiter[j+i*lda]*=gamma;
-							Aiter[j+i*lda]+=res;
-						}
-
-			}
-				 tkroc.stop();
+		kronecker_merge(0,m,n,gamma,A,lda,A_beta);
+		tkroc.stop();
 		//if(m>1 && n>1) std::cerr<<"Kronecker Convert : "<<tkroc.realtime()<<std::endl;
 
-		m0[0]->_mp_d = m0_d;
-		m1[0]->_mp_d = m1_d;
-		m2[0]->_mp_d = m2_d;
-		m3[0]->_mp_d = m3_d;
-		m0[0]->_mp_alloc = m1[0]->_mp_alloc = m2[0]->_mp_alloc= m3[0]->_mp_alloc = 1;
-		m0[0]->_mp_size  = m1[0]->_mp_size  = m2[0]->_mp_size = m3[0]->_mp_size  = 0;
 		FFLAS::fflas_delete( A_beta);
 
 #ifdef CHECK_RNS
@@ -460,6 +380,173 @@ namespace FFPACK {
 	}
 
 
+	inline void rns_double::kronecker_split(size_t ibeg, size_t iend, size_t n, double* A_beta, const integer* A, size_t lda, size_t k) const
+	{
+		for(size_t i=ibeg;i<iend;i++)
+			for(size_t j=0;j<n;j++){
+				size_t idx=j+i*n;
+				const mpz_t*    m0     = reinterpret_cast<const mpz_t*>(A+j+i*lda);
+				const uint16_t* m0_ptr = reinterpret_cast<const uint16_t*>(m0[0]->_mp_d);
+				size_t l=0;
+				size_t maxs=std::min(k,(A[j+i*lda].size())*sizeof(mp_limb_t)/2);// to ensure 32 bits portability
+
+				if (m0[0]->_mp_size >= 0)
+					for (;l<maxs;l++)
+						A_beta[l+idx*k]=  m0_ptr[l];
+				else
+					for (;l<maxs;l++)
+						A_beta[l+idx*k]= - double(m0_ptr[l]);
+				for (;l<k;l++)
+					A_beta[l+idx*k]=  0.;
+			}
+	}
+
+		// the gmp integers a0,a1,a2,a3 are local, so that the rows of A can
+		// be merged concurrently by several threads
+	inline void rns_double::kronecker_merge(size_t ibeg, size_t iend, size_t n, integer gamma, integer* A, size_t lda, const double* A_beta) const
+	{
+		integer hM= (_M-1)>>1;
+		integer* Aiter= A;
+		size_t k=_ldm;
+		size_t k4=((k+3)>>2)+ (((k+3)%4==0)?0:1);
+		std::vector<uint16_t> A0(k4<<2,0),A1(k4<<2,0),A2(k4<<2,0),A3(k4<<2,0);
+		integer a0,a1,a2,a3,res;
+		mpz_t *m0,*m1,*m2,*m3;
+		m0= reinterpret_cast<mpz_t*>(&a0);
+		m1= reinterpret_cast<mpz_t*>(&a1);
+		m2= reinterpret_cast<mpz_t*>(&a2);
+		m3= reinterpret_cast<mpz_t*>(&a3);
+		mp_limb_t *m0_d,*m1_d,*m2_d,*m3_d;
+		m0_d = m0[0]->_mp_d;
+		m1_d = m1[0]->_mp_d;
+		m2_d = m2[0]->_mp_d;
+		m3_d = m3[0]->_mp_d;
+		m0[0]->_mp_alloc = m1[0]->_mp_alloc = m2[0]->_mp_alloc = m3[0]->_mp_alloc = (int) (k4*8/sizeof(mp_limb_t)); // to ensure 32 bits portability
+		m0[0]->_mp_size  = m1[0]->_mp_size  = m2[0]->_mp_size  = m3[0]->_mp_size  = (int) (k4*8/sizeof(mp_limb_t)); // to ensure 32 bits portability
+		for(size_t i=ibeg;i<iend;i++)
+			for (size_t j=0;j<n;j++){
+				size_t idx=i*n+j;
+				for (size_t l=0;l<k;l++){
+					uint64_t tmp=(uint64_t)A_beta[l+idx*k];
+					uint16_t* tptr= reinterpret_cast<uint16_t*>(&tmp);
+					A0[l  ]= tptr[0];
+					A1[l+1]= tptr[1];
+					A2[l+2]= tptr[2];
+					A3[l+3]= tptr[3];
+				}
+					// see A0,A1,A2,A3 as a the gmp integers a0,a1,a2,a3
+				m0[0]->_mp_d= reinterpret_cast<mp_limb_t*>(&A0[0]);
+				m1[0]->_mp_d= reinterpret_cast<mp_limb_t*>(&A1[0]);
+				m2[0]->_mp_d= reinterpret_cast<mp_limb_t*>(&A2[0]);
+				m3[0]->_mp_d= reinterpret_cast<mp_limb_t*>(&A3[0]);
+				res = a0;res+= a1;res+= a2;res+= a3;
+				res%=_M;
+
+					// get the correct result according to the expected sign of A
+				if (res>hM)
+					res-=_M;
+				if (gamma==0)
+					Aiter[j+i*lda]=res;
+				else
+					if (gamma==integer(1))
+						Aiter[j+i*lda]+=res;
+					else
+						if (gamma==integer(-1))
+							Aiter[j+i*lda]=res-Aiter[j+i*lda];
+						else{
+							Aiter[j+i*lda]*=gamma;
+							Aiter[j+i*lda]+=res;
+						}
+			}
+		m0[0]->_mp_d = m0_d;
+		m1[0]->_mp_d = m1_d;
+		m2[0]->_mp_d = m2_d;
+		m3[0]->_mp_d = m3_d;
+		m0[0]->_mp_alloc = m1[0]->_mp_alloc = m2[0]->_mp_alloc= m3[0]->_mp_alloc = 1;
+		m0[0]->_mp_size  = m1[0]->_mp_size  = m2[0]->_mp_size = m3[0]->_mp_size  = 0;
+	}
+
+		// Parallel versions: the rows of A are cut in blocks, one task per block,
+		// for the Kronecker transforms; the CRT matrix products are parallel fgemm
+	template<class Cut, class Param>
+	inline void rns_double::init(size_t m, size_t n, double* Arns, size_t rda, const integer* A, size_t lda, size_t k,
+								 const FFLAS::ParSeqHelper::Parallel<Cut,Param>& ps, bool RNS_MAJOR) const
+	{
+		if (k>_ldm){
+			FFPACK::failure()(__func__,__FILE__,__LINE__,"rns_struct: init (too large entry)");
+			std::cerr<<"k="<<k<<" _ldm="<<_ldm<<std::endl;
+		}
+		size_t mn=m*n;
+		double *A_beta = FFLAS::fflas_new<double >(mn*k);
+		FFLAS::ParSeqHelper::Parallel<FFLAS::CuttingStrategy::Block,FFLAS::StrategyParameter::Threads> sp(ps.numthreads());
+		SYNCH_GROUP(
+			FORBLOCK1D(iter,m,sp,
+					   TASK(MODE(CONSTREFERENCE(A_beta)),
+							kronecker_split(iter.begin(),iter.end(),n,A_beta,A,lda,k););
+					   );
+			);
+
+		FFLAS::ParSeqHelper::Parallel<FFLAS::CuttingStrategy::Recursive,FFLAS::StrategyParameter::TwoDAdaptive> pg(ps.numthreads());
+		if (RNS_MAJOR==false)
+				// Arns = _crt_in x A_beta^T
+			FFLAS::fgemm (Givaro::ZRing<double>(), FFLAS::FflasNoTrans,FFLAS::FflasTrans,_size,mn,k,1.0,_crt_in.data(),_ldm,A_beta,k,0.,Arns,rda,pg);
+		else
+				// Arns =  A_beta x _crt_in^T
+			FFLAS::fgemm (Givaro::ZRing<double>(), FFLAS::FflasNoTrans,FFLAS::FflasTrans,mn,_size,k,1.0,A_beta,k,_crt_in.data(),_ldm,0.,Arns,_size,pg);
+
+		reduce(mn,Arns,rda,ps,RNS_MAJOR);
+
+		FFLAS::fflas_delete( A_beta);
+	}
+
+	template<class Cut, class Param>
+	inline void rns_double::convert(size_t m, size_t n, integer gamma, integer* A, size_t lda,
+									const double* Arns, size_t rda,
+									const FFLAS::ParSeqHelper::Parallel<Cut,Param>& ps, bool RNS_MAJOR) const
+	{
+		size_t  mn= m*n;
+		double *A_beta= FFLAS::fflas_new<double>(mn*_ldm);
+		FFLAS::ParSeqHelper::Parallel<FFLAS::CuttingStrategy::Recursive,FFLAS::StrategyParameter::TwoDAdaptive> pg(ps.numthreads());
+		if (RNS_MAJOR==false)
+				// compute A_beta = Ap^T x M_beta
+			FFLAS::fgemm(Givaro::ZRing<double>(),FFLAS::FflasTrans, FFLAS::FflasNoTrans, mn, _ldm, _size, 1.0 , Arns, rda, _crt_out.data(), _ldm, 0., A_beta, _ldm, pg);
+		else // compute A_beta = Ap x M_Beta
+			FFLAS::fgemm(Givaro::ZRing<double>(),FFLAS::FflasNoTrans, FFLAS::FflasNoTrans, mn, _ldm, _size, 1.0 , Arns, _size, _crt_out.data(), _ldm, 0., A_beta, _ldm, pg);
+
+			// compute A using inverse Kronecker transform of A_beta, by blocks of rows
+		FFLAS::ParSeqHelper::Parallel<FFLAS::CuttingStrategy::Block,FFLAS::StrategyParameter::Threads> sp(ps.numthreads());
+		SYNCH_GROUP(
+			FORBLOCK1D(iter,m,sp,
+					   TASK(MODE(CONSTREFERENCE(A_beta,gamma)),
+							kronecker_merge(iter.begin(),iter.end(),n,gamma,A,lda,A_beta););
+					   );
+			);
+		FFLAS::fflas_delete( A_beta);
+	}
+
+		// the entries of Arns are cut in blocks: in RNS major the residues of
+		// an entry are contiguous, otherwise each block is reduced modulo each
+		// moduli of the basis
+	template<class Cut, class Param>
+	inline void rns_double::reduce(size_t n, double* Arns, size_t rda,
+								   const FFLAS::ParSeqHelper::Parallel<Cut,Param>& ps, bool RNS_MAJOR) const
+	{
+		FFLAS::ParSeqHelper::Parallel<FFLAS::CuttingStrategy::Block,FFLAS::StrategyParameter::Threads> sp(ps.numthreads());
+		SYNCH_GROUP(
+			FORBLOCK1D(iter,n,sp,
+					   TASK(MODE(CONSTREFERENCE(Arns)),
+							{
+								if (RNS_MAJOR)
+									reduce(iter.end()-iter.begin(),Arns+iter.begin()*_size,rda,true);
+								else
+									for(size_t i=0;i<_size;i++)
+										FFLAS::freduce (_field_rns[i],iter.end()-iter.begin(),Arns+i*rda+iter.begin(),1);
+							});
+					   );
+			);
+	}
+
+
 // TODO: less naive implementation
 	inline void rns_double_extended::init(size_t m, double* Arns, const integer* A, size_t lda) const{
 		for(size_t i = 0 ; i < m ; ++i){
@@ -172,6 +172,20 @@ namespace FFLAS {
 		F.rns().convert(m,n,alpha,B,ldb,A._ptr,A._stride);
 	}
 
+	// same as above, the conversions being spread over the threads of the ParSeqHelper ps
+	template<typename RNS, class ParSeq>
+	void finit_rns(const FFPACK::RNSInteger<RNS> &F, const size_t m, const size_t n, size_t k,
+		   const Givaro::Integer *B, const size_t ldb, typename FFPACK::RNSInteger<RNS>::Element_ptr A, const ParSeq& ps)
+	{
+		F.rns().init(m,n,A._ptr,A._stride, B,ldb,k,ps);
+	}
+	template<typename RNS, class ParSeq>
+	void fconvert_rns(const FFPACK::RNSInteger<RNS> &F, const size_t m, const size_t n,
+		      Givaro::Integer alpha, Givaro::Integer *B, const size_t ldb, typename FFPACK::RNSInteger<RNS>::ConstElement_ptr A, const ParSeq& ps)
+	{
+		F.rns().convert(m,n,alpha,B,ldb,A._ptr,A._stride,ps);
+	}
+
 
 } // end of namespace FFLAS
 
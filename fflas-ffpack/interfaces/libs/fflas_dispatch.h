@@ -0,0 +1,226 @@
+/* -*- mode: C++; tab-width: 8; indent-tabs-mode: t; c-basic-offset: 8 -*- */
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/* fflas_dispatch.h
+ * Copyright (C) 2016 FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ *.
+ */
+
+/** @file interfaces/libs/fflas_dispatch.h
+ * @brief Runtime selection of the SIMD kernels compiled in libfflas.
+ *
+ * The header-only library picks its SIMD code at compile time.  With
+ * <code>--enable-simd-dispatch</code>, libfflas and libffpack are compiled
+ * for the baseline of the architecture only, and contain AVX2 and AVX512F
+ * builds of the hot kernels (freduce, fscal, faxpy, igemm_colmajor, the
+ * ELL_simd spmv) and of the entry points fgemm, fgemv and PLUQ, the best
+ * one supported by the running CPU being chosen when the library is loaded.
+ * The environment variable \c FFLAS_SIMD_DISPATCH (<code>baseline</code>,
+ * <code>avx2</code> or <code>avx512</code>) caps that choice.
+ *
+ * Each variant is a translation unit of its own, fflas_dispatch_avx2.C and
+ * fflas_dispatch_avx512f.C, that compiles the fflas and ffpack headers with
+ * the macros of its instruction set, inside a renamed copy of the FFLAS and
+ * FFPACK namespaces.  The headers of the other libraries are compiled for
+ * the baseline before, so that no inline function of an instruction set
+ * above the baseline can be merged by the linker with the rest of libfflas.
+ *
+ * This header does not depend on fflas.h, so that the variants can include
+ * it before their renamed copy of the FFLAS namespace.
+ */
+
+#ifndef __FFLASFFPACK_interfaces_libs_fflas_dispatch_H
+#define __FFLASFFPACK_interfaces_libs_fflas_dispatch_H
+
+#include <cstddef>
+#include <cstdint>
+#include "givaro/modular.h"
+#include "givaro/modular-balanced.h"
+
+#ifndef index_t
+#define index_t uint32_t
+#endif
+
+namespace FFLAS { namespace Dispatch {
+
+	/// Instruction set a kernel table was compiled for
+	enum IsaLevel {
+		IsaBaseline = 0, /**< no instruction set flag */
+		IsaAVX2     = 1, /**< avx2, fma */
+		IsaAVX512F  = 2  /**< avx2, fma, avx512f, avx512dq */
+	};
+
+	/// ELL_simd matrix as seen by the dispatched spmv (does not own its arrays)
+	template<class Element>
+	struct EllSimdView {
+		bool delayed;
+		int chunk;
+		uint64_t m;
+		uint64_t ld;
+		uint64_t nChunks;
+		uint64_t kmax;
+		const index_t * col;
+		const Element * dat;
+	};
+
+	/// Kernels of one instruction set for the field \p Field
+	template<class Field>
+	struct KernelTable {
+		typedef typename Field::Element Element;
+
+		/// \f$x \gets x \mod p\f$
+		void (*freduce) (const Field& F, const size_t n, Element* X, const size_t incX);
+		/// \f$y \gets \alpha x\f$
+		void (*fscal) (const Field& F, const size_t n, const Element alpha,
+			       const Element* X, const size_t incX, Element* Y, const size_t incY);
+		/// \f$y \gets \alpha x + y\f$
+		void (*faxpy) (const Field& F, const size_t n, const Element alpha,
+			       const Element* X, const size_t incX, Element* Y, const size_t incY);
+		/// \f$y \gets A x + y\f$ for an ELL_simd matrix
+		void (*fspmv_ell_simd) (const Field& F, const EllSimdView<Element>& A,
+					const Element* x, Element* y);
+		/// fgemm without helper, the one exported by libfflas (\c true for FflasTrans)
+		Element* (*fgemm) (const Field& F, const bool transA, const bool transB,
+				   const size_t m, const size_t n, const size_t k,
+				   const Element alpha, const Element* A, const size_t lda,
+				   const Element* B, const size_t ldb,
+				   const Element beta, Element* C, const size_t ldc);
+		/// fgemv without helper, the one exported by libfflas (\c true for FflasTrans)
+		Element* (*fgemv) (const Field& F, const bool transA,
+				   const size_t M, const size_t N,
+				   const Element alpha, const Element* A, const size_t lda,
+				   const Element* X, const size_t incX,
+				   const Element beta, Element* Y, const size_t incY);
+		/// PLUQ of the variant (\c true for FflasUnit), null for the baseline, whose PLUQ is in libffpack
+		size_t (*pluq) (const Field& F, const bool unitDiag, const size_t M, const size_t N,
+				Element* A, const size_t lda, size_t* P, size_t* Q);
+	};
+
+	/// All the kernels of one instruction set
+	struct KernelTables {
+		IsaLevel isa;
+		KernelTable<Givaro::Modular<double> >         modular_double;
+		KernelTable<Givaro::Modular<float> >          modular_float;
+		KernelTable<Givaro::ModularBalanced<double> > modularbalanced_double;
+		KernelTable<Givaro::ModularBalanced<float> >  modularbalanced_float;
+		KernelTable<Givaro::Modular<int32_t> >        modular_int32;
+		KernelTable<Givaro::ModularBalanced<int32_t> > modularbalanced_int32;
+		/// \f$C \gets \alpha op(A) op(B) + C\f$, column major
+		void (*igemm_colmajor) (const bool transA, const bool transB,
+					const size_t rows, const size_t cols, const size_t depth,
+					const int64_t alpha,
+					const int64_t* A, const size_t lda, const int64_t* B, const size_t ldb,
+					int64_t* C, const size_t ldc);
+	};
+
+	/** Fill \p T with the kernels of one instruction set.
+	 * Only the baseline is always compiled, see \c __FFLASFFPACK_DISPATCH_AVX2
+	 * and \c __FFLASFFPACK_DISPATCH_AVX512F.
+	 * The specialisations of fgemm and fgemv in libfflas call the fgemm
+	 * and fgemv entries, see fflas_dispatch_spec.inl, and the one of PLUQ
+	 * in libffpack calls the pluq entry.
+	 */
+	void fillKernelsBaseline (KernelTables& T);
+	void fillKernelsAVX2 (KernelTables& T);
+	void fillKernelsAVX512F (KernelTables& T);
+
+	/// Kernels selected for the running CPU
+	const KernelTables& kernels();
+
+	/// Instruction set of the selected kernels
+	inline IsaLevel isaLevel() { return kernels().isa; }
+
+	/// Name of an instruction set level
+	const char* isaName (const IsaLevel isa);
+
+	namespace Protected {
+		template<class Field> struct TableOf;
+#define __FFLAS_DISPATCH_TABLEOF(FIELD,MEMBER) \
+		template<> struct TableOf<FIELD > { \
+			static const KernelTable<FIELD >& get(const KernelTables& T) { return T.MEMBER; } \
+		};
+		__FFLAS_DISPATCH_TABLEOF(Givaro::Modular<double>, modular_double)
+		__FFLAS_DISPATCH_TABLEOF(Givaro::Modular<float>, modular_float)
+		__FFLAS_DISPATCH_TABLEOF(Givaro::ModularBalanced<double>, modularbalanced_double)
+		__FFLAS_DISPATCH_TABLEOF(Givaro::ModularBalanced<float>, modularbalanced_float)
+		__FFLAS_DISPATCH_TABLEOF(Givaro::Modular<int32_t>, modular_int32)
+		__FFLAS_DISPATCH_TABLEOF(Givaro::ModularBalanced<int32_t>, modularbalanced_int32)
+#undef __FFLAS_DISPATCH_TABLEOF
+	} // Protected
+
+	/// Selected kernel table for \p Field
+	template<class Field>
+	inline const KernelTable<Field>& kernels() { return Protected::TableOf<Field>::get(kernels()); }
+
+	template<class Field>
+	inline void freduce (const Field& F, const size_t n, typename Field::Element_ptr X, const size_t incX)
+	{
+		kernels<Field>().freduce(F,n,X,incX);
+	}
+
+	template<class Field>
+	inline void fscal (const Field& F, const size_t n, const typename Field::Element alpha,
+			   typename Field::ConstElement_ptr X, const size_t incX,
+			   typename Field::Element_ptr Y, const size_t incY)
+	{
+		kernels<Field>().fscal(F,n,alpha,X,incX,Y,incY);
+	}
+
+	template<class Field>
+	inline void faxpy (const Field& F, const size_t n, const typename Field::Element alpha,
+			   typename Field::ConstElement_ptr X, const size_t incX,
+			   typename Field::Element_ptr Y, const size_t incY)
+	{
+		kernels<Field>().faxpy(F,n,alpha,X,incX,Y,incY);
+	}
+
+	/** \f$y \gets A x + y\f$.
+	 * \p SM is a <code>Sparse<Field, SparseMatrix_t::ELL_simd></code> built by
+	 * sparse_init, with any chunk size.
+	 */
+	template<class Field, class SM>
+	inline void fspmv_ell_simd (const Field& F, const SM& A,
+				    typename Field::ConstElement_ptr x, typename Field::Element_ptr y)
+	{
+		EllSimdView<typename Field::Element> V;
+		V.delayed = A.delayed;
+		V.chunk = A.chunk;
+		V.m = A.m;
+		V.ld = A.ld;
+		V.nChunks = A.nChunks;
+		V.kmax = A.kmax;
+		V.col = A.col;
+		V.dat = A.dat;
+		kernels<Field>().fspmv_ell_simd(F,V,x,y);
+	}
+
+	inline void igemm_colmajor (const bool transA, const bool transB,
+				    const size_t rows, const size_t cols, const size_t depth,
+				    const int64_t alpha,
+				    const int64_t* A, const size_t lda, const int64_t* B, const size_t ldb,
+				    int64_t* C, const size_t ldc)
+	{
+		kernels().igemm_colmajor(transA,transB,rows,cols,depth,alpha,A,lda,B,ldb,C,ldc);
+	}
+
+} // Dispatch
+} // FFLAS
+
+#endif // __FFLASFFPACK_interfaces_libs_fflas_dispatch_H
@@ -0,0 +1,216 @@
+/* -*- mode: C++; tab-width: 8; indent-tabs-mode: t; c-basic-offset: 8 -*- */
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/* fflas_dispatch_implem.inl
+ * Copyright (C) 2016 FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ *.
+ */
+
+/* Kernel table of one instruction set.
+ * To be included, once per translation unit, with
+ *  - FFLAS_DISPATCH_NS        the namespace the fflas headers were compiled in,
+ *  - FFLAS_DISPATCH_FFPACK_NS the one of the ffpack headers, for the variants
+ *                             only (the baseline PLUQ is the one of libffpack),
+ *  - FFLAS_DISPATCH_FILL      the name of the fill function,
+ *  - FFLAS_DISPATCH_ISA       its IsaLevel.
+ * The adaptors have internal linkage, the kernels they instantiate live in
+ * FFLAS_DISPATCH_NS: nothing here can be merged by the linker with the
+ * kernels of another instruction set.
+ */
+
+namespace FFLAS { namespace Dispatch {
+
+	namespace {
+
+		template<class Field>
+		void freduce_k (const Field& F, const size_t n, typename Field::Element* X, const size_t incX)
+		{
+			FFLAS_DISPATCH_NS::freduce(F,n,X,incX);
+		}
+
+		template<class Field>
+		void fscal_k (const Field& F, const size_t n, const typename Field::Element alpha,
+			      const typename Field::Element* X, const size_t incX,
+			      typename Field::Element* Y, const size_t incY)
+		{
+			FFLAS_DISPATCH_NS::fscal(F,n,alpha,X,incX,Y,incY);
+		}
+
+		template<class Field>
+		void faxpy_k (const Field& F, const size_t n, const typename Field::Element alpha,
+			      const typename Field::Element* X, const size_t incX,
+			      typename Field::Element* Y, const size_t incY)
+		{
+			FFLAS_DISPATCH_NS::faxpy(F,n,alpha,X,incX,Y,incY);
+		}
+
+		// chunk of the ELL_simd matrices the vectorised spmv can take (0: any)
+		template<class Field>
+		int ell_chunk_k ()
+		{
+#ifdef __FFLASFFPACK_USE_SIMD
+			return (int) FFLAS_DISPATCH_NS::Simd<typename Field::Element>::vect_size;
+#else
+			return 0;
+#endif
+		}
+
+		template<class Field>
+		void fspmv_ell_simd_k (const Field& F, const EllSimdView<typename Field::Element>& V,
+				       const typename Field::Element* x, typename Field::Element* y)
+		{
+			typedef typename Field::Element Element;
+			FFLAS_DISPATCH_NS::Sparse<Field, FFLAS_DISPATCH_NS::SparseMatrix_t::ELL_simd> A;
+			A.delayed = V.delayed;
+			A.chunk = V.chunk;
+			A.m = (index_t) V.m;
+			A.ld = (index_t) V.ld;
+			A.nChunks = V.nChunks;
+			A.kmax = V.kmax;
+			A.col = const_cast<index_t*>(V.col);
+			A.dat = const_cast<Element*>(V.dat);
+
+			const int chunk = ell_chunk_k<Field>();
+			if (!chunk || A.chunk == chunk)
+				FFLAS_DISPATCH_NS::sparse_details::fspmv_dispatch(F, A, x, y,
+										   typename FFLAS_DISPATCH_NS::FieldTraits<Field>::category(),
+										   FFLAS_DISPATCH_NS::NotZOSparseMatrix());
+			else if (A.delayed) {
+				// the matrix was built for another vector width
+				FFLAS_DISPATCH_NS::sparse_details_impl::fspmv(F, A, x, y,
+									      FFLAS_DISPATCH_NS::FieldCategories::UnparametricTag());
+				FFLAS_DISPATCH_NS::freduce(F, A.m, y, 1);
+			}
+			else
+				FFLAS_DISPATCH_NS::sparse_details_impl::fspmv(F, A, x, y, A.kmax);
+			// A is only a view
+			A.col = nullptr;
+			A.dat = nullptr;
+		}
+
+		// the body of FFLAS::fgemm, whose specialisations call this kernel
+		template<class Field>
+		typename Field::Element* fgemm_k (const Field& F, const bool transA, const bool transB,
+						  const size_t m, const size_t n, const size_t k,
+						  const typename Field::Element alpha,
+						  const typename Field::Element* A, const size_t lda,
+						  const typename Field::Element* B, const size_t ldb,
+						  const typename Field::Element beta,
+						  typename Field::Element* C, const size_t ldc)
+		{
+			using FFLAS_DISPATCH_NS::FflasNoTrans;
+			using FFLAS_DISPATCH_NS::FflasTrans;
+			if (!m || !n) {return C;}
+			if (!k || F.isZero (alpha)){
+				FFLAS_DISPATCH_NS::fscalin(F, m, n, beta, C, ldc);
+				return C;
+			}
+			return FFLAS_DISPATCH_NS::fgemm(F, transA ? FflasTrans : FflasNoTrans, transB ? FflasTrans : FflasNoTrans,
+							m,n,k,alpha,A,lda,B,ldb,beta,C,ldc,
+							FFLAS_DISPATCH_NS::ParSeqHelper::Sequential());
+		}
+
+		// the body of FFLAS::fgemv, whose specialisations call this kernel
+		template<class Field>
+		typename Field::Element* fgemv_k (const Field& F, const bool transA,
+						  const size_t M, const size_t N,
+						  const typename Field::Element alpha,
+						  const typename Field::Element* A, const size_t lda,
+						  const typename Field::Element* X, const size_t incX,
+						  const typename Field::Element beta,
+						  typename Field::Element* Y, const size_t incY)
+		{
+			using FFLAS_DISPATCH_NS::FflasNoTrans;
+			using FFLAS_DISPATCH_NS::FflasTrans;
+			if (!M) {return Y;}
+			size_t Ydim = transA?N:M;
+			size_t Xdim = transA?M:N;
+			if (!Xdim || F.isZero (alpha)){
+				FFLAS_DISPATCH_NS::fscalin(F, Ydim, beta, Y, incY);
+				return Y;
+			}
+			FFLAS_DISPATCH_NS::MMHelper<Field, FFLAS_DISPATCH_NS::MMHelperAlgo::Classic > HW (F, 0);
+			return FFLAS_DISPATCH_NS::fgemv (F, transA ? FflasTrans : FflasNoTrans, M, N, alpha,
+							 const_cast<typename Field::Element_ptr>(A), lda,
+							 const_cast<typename Field::Element_ptr>(X), incX,
+							 beta, Y, incY, HW);
+		}
+
+#ifdef FFLAS_DISPATCH_FFPACK_NS
+		template<class Field>
+		size_t pluq_k (const Field& F, const bool unitDiag, const size_t M, const size_t N,
+			       typename Field::Element* A, const size_t lda, size_t* P, size_t* Q)
+		{
+			return FFLAS_DISPATCH_FFPACK_NS::PLUQ (F, unitDiag ? FFLAS_DISPATCH_NS::FflasUnit : FFLAS_DISPATCH_NS::FflasNonUnit,
+							       M, N, A, lda, P, Q);
+		}
+#endif
+
+		void igemm_colmajor_k (const bool transA, const bool transB,
+				       const size_t rows, const size_t cols, const size_t depth,
+				       const int64_t alpha,
+				       const int64_t* A, const size_t lda, const int64_t* B, const size_t ldb,
+				       int64_t* C, const size_t ldc)
+		{
+			using FFLAS_DISPATCH_NS::FflasNoTrans;
+			using FFLAS_DISPATCH_NS::FflasTrans;
+			if (!depth || !alpha) return;
+			if (!transA && !transB)
+				FFLAS_DISPATCH_NS::Protected::igemm_colmajor<FflasNoTrans,FflasNoTrans>(rows,cols,depth,alpha,A,lda,B,ldb,C,ldc);
+			else if (!transA)
+				FFLAS_DISPATCH_NS::Protected::igemm_colmajor<FflasNoTrans,FflasTrans>(rows,cols,depth,alpha,A,lda,B,ldb,C,ldc);
+			else if (!transB)
+				FFLAS_DISPATCH_NS::Protected::igemm_colmajor<FflasTrans,FflasNoTrans>(rows,cols,depth,alpha,A,lda,B,ldb,C,ldc);
+			else
+				FFLAS_DISPATCH_NS::Protected::igemm_colmajor<FflasTrans,FflasTrans>(rows,cols,depth,alpha,A,lda,B,ldb,C,ldc);
+		}
+
+		template<class Field>
+		void fill_k (KernelTable<Field>& T)
+		{
+			T.freduce = &freduce_k<Field>;
+			T.fscal = &fscal_k<Field>;
+			T.faxpy = &faxpy_k<Field>;
+			T.fspmv_ell_simd = &fspmv_ell_simd_k<Field>;
+			T.fgemm = &fgemm_k<Field>;
+			T.fgemv = &fgemv_k<Field>;
+#ifdef FFLAS_DISPATCH_FFPACK_NS
+			T.pluq = &pluq_k<Field>;
+#else
+			T.pluq = nullptr;
+#endif
+		}
+
+	} // anonymous
+
+	void FFLAS_DISPATCH_FILL (KernelTables& T)
+	{
+		T.isa = FFLAS_DISPATCH_ISA;
+		fill_k(T.modular_double);
+		fill_k(T.modular_float);
+		fill_k(T.modularbalanced_double);
+		fill_k(T.modularbalanced_float);
+		fill_k(T.modular_int32);
+		fill_k(T.modularbalanced_int32);
+		T.igemm_colmajor = &igemm_colmajor_k;
+	}
+
+} // Dispatch
+} // FFLAS
@@ -0,0 +1,126 @@
+/* -*- mode: C++; tab-width: 8; indent-tabs-mode: t; c-basic-offset: 8 -*- */
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/* fflas_dispatch_prelude.inl
+ * Copyright (C) 2016 FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ *.
+ */
+
+/* Headers of the SIMD variants that are not compiled for their instruction
+ * set: all the headers of the other libraries that fflas.h, fflas_sparse.h
+ * and ffpack.h include.  fflas_dispatch_avx2.C and fflas_dispatch_avx512f.C
+ * include this file before their #pragma GCC target, so that the inline
+ * functions and templates defined here are the baseline ones, and only
+ * those of the renamed FFLAS and FFPACK namespaces use the instruction set
+ * of the variant.
+ * A header of another library added to fflas or ffpack must be added here.
+ */
+
+#ifndef __FFLASFFPACK_interfaces_libs_fflas_dispatch_prelude_INL
+#define __FFLASFFPACK_interfaces_libs_fflas_dispatch_prelude_INL
+
+#include "fflas-ffpack/fflas-ffpack-config.h"
+#include "fflas-ffpack/config.h"
+#include "fflas-ffpack/config-blas.h"
+#include "fflas-ffpack/utils/fflas_intrinsic.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <time.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#ifdef __FFLASFFPACK_USE_OPENMP
+#include <omp.h>
+#  ifndef __GIVARO_USE_OPENMP
+#    define __GIVARO_USE_OPENMP 1
+#  endif
+#endif
+
+#include <recint/recint.h>
+#include <givaro/givinteger.h>
+#include <givaro/givintprime.h>
+#include <givaro/givranditer.h>
+#include <givaro/givtimer.h>
+#ifdef __GIVARO_USE_OPENMP
+#include <givaro/givomptimer.h>
+#endif
+#include <givaro/modular.h>
+#include <givaro/modular-balanced.h>
+#include <givaro/modular-general.h>
+#include <givaro/modular-integer.h>
+#include <givaro/ring-interface.h>
+#include <givaro/udl.h>
+#include <givaro/zring.h>
+
+// the fflas headers that define functions outside of the FFLAS namespace;
+// Alignment::DEFAULT stays the one of the baseline, which the buffers given
+// to the variants are aligned on
+#include "fflas-ffpack/utils/align-allocator.h"
+#include "fflas-ffpack/utils/bit_manipulation.h"
+#include "fflas-ffpack/utils/flimits.h"
+
+// index_t as fflas.h leaves it (see paladin/parallel.h), for EllSimdView
+#ifndef index_t
+#ifdef __FFLASFFPACK_HAVE_MKL
+#define index_t MKL_INT
+#else
+#define index_t size_t
+#endif
+#endif
+#include "fflas_dispatch.h"
+
+#endif // __FFLASFFPACK_interfaces_libs_fflas_dispatch_prelude_INL
@@ -0,0 +1,60 @@
+/* -*- mode: C++; tab-width: 8; indent-tabs-mode: t; c-basic-offset: 8 -*- */
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/* fflas_dispatch_spec.inl
+ * Copyright (C) 2016 FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ *.
+ */
+
+/* With --enable-simd-dispatch, fgemm and fgemv without helper are
+ * specialised by libfflas for its fields: the specialisations, defined in
+ * fflas_dispatch.C, call the kernels selected at load time.
+ * This file declares them, for the translation units of the library that
+ * could otherwise instantiate the header versions: it must be included
+ * right after fflas.h, and the explicit instantiations of these two
+ * functions that follow then have no effect.
+ */
+
+#ifndef __FFLASFFPACK_interfaces_libs_fflas_dispatch_spec_INL
+#define __FFLASFFPACK_interfaces_libs_fflas_dispatch_spec_INL
+
+#define __FFLAS_DISPATCH_SPEC(FIELD,ELT) \
+	template<> \
+	ELT* fgemm (const FIELD<ELT>& F, const FFLAS_TRANSPOSE ta, const FFLAS_TRANSPOSE tb, \
+		    const size_t m, const size_t n, const size_t k, \
+		    const ELT alpha, const ELT* A, const size_t lda, const ELT* B, const size_t ldb, \
+		    const ELT beta, ELT* C, const size_t ldc); \
+	template<> \
+	ELT* fgemv (const FIELD<ELT>& F, const FFLAS_TRANSPOSE ta, const size_t M, const size_t N, \
+		    const ELT alpha, const ELT* A, const size_t lda, const ELT* X, const size_t incX, \
+		    const ELT beta, ELT* Y, const size_t incY);
+
+namespace FFLAS {
+	__FFLAS_DISPATCH_SPEC(Givaro::Modular, double)
+	__FFLAS_DISPATCH_SPEC(Givaro::Modular, float)
+	__FFLAS_DISPATCH_SPEC(Givaro::Modular, int32_t)
+	__FFLAS_DISPATCH_SPEC(Givaro::ModularBalanced, double)
+	__FFLAS_DISPATCH_SPEC(Givaro::ModularBalanced, float)
+	__FFLAS_DISPATCH_SPEC(Givaro::ModularBalanced, int32_t)
+} // FFLAS
+
+#undef __FFLAS_DISPATCH_SPEC
+
+#endif // __FFLASFFPACK_interfaces_libs_fflas_dispatch_spec_INL
@@ -94,6 +94,12 @@ namespace FFPACK {
 				 FFLAS_ELT* A, const size_t lda,
 				 size_t* P, size_t* Q, int nt);
 
+	template INST_OR_DECL
+	size_t pPLUQ_tile(const FFLAS_FIELD<FFLAS_ELT>& Fi, const FFLAS::FFLAS_DIAG Diag,
+					  const size_t M, const size_t N,
+					  FFLAS_ELT* A, const size_t lda,
+					  size_t* P, size_t* Q, int nt, size_t nb);
+
 	template INST_OR_DECL
 	void fgetrs (const FFLAS_FIELD<FFLAS_ELT>& F,
 				 const FFLAS::FFLAS_SIDE Side,
@@ -31,7 +31,12 @@
 
 #include "fflas-ffpack/config.h"
 
-#ifndef __FFLASFFPACK_USE_OPENMP
+#if defined(__FFLASFFPACK_USE_NATIVE_THREADS) && !defined(__FFLASFFPACK_FORCE_SEQ)
+   #undef __FFLASFFPACK_USE_OPENMP
+   #undef __FFLASFFPACK_USE_TBB
+   #undef __FFLASFFPACK_USE_KAAPI
+   #include "fflas-ffpack/paladin/thread_pool.h"
+#elif !defined(__FFLASFFPACK_USE_OPENMP)
 #define  __FFLASFFPACK_SEQUENTIAL
 #else
 #include "omp.h"
@@ -75,6 +80,7 @@
 
 #ifdef __FFLASFFPACK_FORCE_SEQ
 
+   #undef __FFLASFFPACK_USE_NATIVE_THREADS
    #undef __FFLASFFPACK_USE_OPENMP
    #undef __FFLASFFPACK_USE_KAAPI
    #undef __FFLASFFPACK_USE_TBB
@@ -318,9 +324,9 @@
 
 
 /*********************************************************/
-/*************************** TBB  ************************/ 
+/************** lambda captures (TBB, native) ************/
 /*********************************************************/
-#ifdef __FFLASFFPACK_USE_TBB
+#if defined(__FFLASFFPACK_USE_TBB) || defined(__FFLASFFPACK_USE_NATIVE_THREADS)
 
 // workaround to overload macro CONSTREFERENCE
 
@@ -363,6 +369,14 @@
 #define GET_VAL(_1,_2,_3,_4,_5, NAME,...) NAME
 #define VALUE(...) GET_VAL(__VA_ARGS__, VAL5,VAL4,VAL3,VAL2,VAL1)(__VA_ARGS__)
 
+#endif // lambda captures
+
+/*********************************************************/
+/*************************** TBB  ************************/ 
+/*********************************************************/
+#ifdef __FFLASFFPACK_USE_TBB
+
+
 // need task_group to lunch a group of tasks in parallel
 #define SYNCH_GROUP(Args...) \
   {tbb::task_group g;  \
@@ -464,6 +478,102 @@
 
 #endif // end TBB macros
 
+/*********************************************************/
+/******************** NATIVE THREADS *********************/
+/*********************************************************/
+
+#ifdef __FFLASFFPACK_USE_NATIVE_THREADS // persistent work-stealing pool
+
+// a task is a child of the running task (or of the top level of the calling thread)
+#define TASK(M, I)                                      \
+    { FFLAS::Native::spawn([=M](){I;}); }
+
+// waits for the children of the current task, executing pending tasks meanwhile
+#define WAIT FFLAS::Native::taskwait()
+#define CHECK_DEPENDENCIES FFLAS::Native::taskwait()
+#define BARRIER FFLAS::Native::taskwait()
+// the pool is persistent: no parallel region to open
+#define PAR_BLOCK
+
+#define SYNCH_GROUP(Args...)     {{Args};} WAIT;
+
+#define NUM_THREADS FFLAS::Native::numThreads()
+#define MAX_THREADS FFLAS::Native::numThreads()
+
+#define READ(Args...)
+#define WRITE(Args...)
+#define READWRITE(Args...)
+
+#define BEGIN_PARALLEL_MAIN(Args...) int main(Args)  {
+#define END_PARALLEL_MAIN(void)  return 0; }
+
+////////////////////   CUTTING LOOP MACROS 1D //////////////////////
+
+// for strategy 1D with access to the iterator
+#define FORBLOCK1D(iter, m, Helper, Args...)                            \
+    { FFLAS::ForStrategy1D<std::remove_const<decltype(m)>::type, typename decltype(Helper)::Cut, typename  decltype(Helper)::Param> iter(m, Helper); \
+        for(iter.initialize(); !iter.isTerminated(); ++iter)            \
+        {Args;} }
+
+// for strategy 1D: one task per block
+#define FOR1D(i, m, Helper, Args...)                                    \
+    FORBLOCK1D(_internal_iterator, m, Helper,                           \
+        TASK( ,                                                         \
+             {for(auto i=_internal_iterator.begin(); i!=_internal_iterator.end(); ++i) \
+                 { Args; } });)                                         \
+        WAIT;
+
+// parallel for 1D with access to the range of each block through iter
+// (the loop waits for its blocks, which can thus refer to the enclosing scope)
+#define PARFORBLOCK1D(iter, m, Helper, Args...)                         \
+    { FFLAS::ForStrategy1D<std::remove_const<decltype(m)>::type, typename decltype(Helper)::Cut, typename  decltype(Helper)::Param> NATIVEstrategyIterator(m, Helper); \
+        for(NATIVEstrategyIterator.initialize(); !NATIVEstrategyIterator.isTerminated(); ++NATIVEstrategyIterator) \
+            FFLAS::Native::spawn([&, NATIVEstrategyIterator]() {       \
+                    const auto & iter = NATIVEstrategyIterator;         \
+                    {Args;} });                                         \
+        FFLAS::Native::taskwait(); }
+
+// parallel for 1D
+#define PARFOR1D(i, m, Helper, Args...)                                 \
+    PARFORBLOCK1D(_internal_iterator, m, Helper,                        \
+                  for(auto i=_internal_iterator.begin(); i!=_internal_iterator.end(); ++i) \
+                  { Args; } )
+
+////////////////////   CUTTING LOOP MACROS 2D //////////////////////
+
+// for strategy 2D with access to the range and control of iterator
+#define FORBLOCK2D(iter, m, n, Helper, Args...)                         \
+    { FFLAS::ForStrategy2D<std::remove_const<decltype(m)>::type, typename decltype(Helper)::Cut, typename  decltype(Helper)::Param> iter(m,n,Helper); \
+        for(iter.initialize(); !iter.isTerminated(); ++iter)            \
+        {Args;} }
+
+// for strategy 2D: one task per block
+#define FOR2D(i, j, m, n, Helper, Args...)                              \
+    FORBLOCK2D(_internal_iterator, m, n, Helper,                        \
+               TASK(,                                                   \
+                    for(auto i=_internal_iterator.ibegin(); i!=_internal_iterator.iend(); ++i) \
+                        for(auto j=_internal_iterator.jbegin(); j!=_internal_iterator.jend(); ++j) \
+                        { Args; });)                                    \
+    WAIT;
+
+// parallel for strategy 2D with access to the range of each block through iter
+#define PARFORBLOCK2D(iter, m, n, Helper, Args...)                      \
+    { FFLAS::ForStrategy2D<std::remove_const<decltype(m)>::type, typename decltype(Helper)::Cut, typename  decltype(Helper)::Param> NATIVEstrategyIterator(m,n,Helper); \
+        for(NATIVEstrategyIterator.initialize(); !NATIVEstrategyIterator.isTerminated(); ++NATIVEstrategyIterator) \
+            FFLAS::Native::spawn([&, NATIVEstrategyIterator]() {       \
+                    const auto & iter = NATIVEstrategyIterator;         \
+                    {Args;} });                                         \
+        FFLAS::Native::taskwait(); }
+
+// parallel for strategy 2D
+#define PARFOR2D(i, j, m, n, Helper, Args...)                           \
+    PARFORBLOCK2D(_internal_iterator, m, n, Helper,                     \
+                  for(auto i=_internal_iterator.ibegin(); i!=_internal_iterator.iend(); ++i) \
+                      for(auto j=_internal_iterator.jbegin(); j!=_internal_iterator.jend(); ++j) \
+                      { Args; })
+
+#endif // native threads macros
+
 /*********************************************************/
 /************************* KAAPI *************************/
 /*********************************************************/
@@ -0,0 +1,431 @@
+/* -*- mode: C++; tab-width: 8; indent-tabs-mode: t; c-basic-offset: 8 -*- */
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/* paladin/thread_pool.h
+ * Copyright (C) 2016 the FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ *.
+ */
+
+/** @file paladin/thread_pool.h
+ * @brief Persistent work-stealing thread pool, runtime of the native paladin backend.
+ *
+ * Used by parallel.h when \c __FFLASFFPACK_USE_NATIVE_THREADS is defined.
+ * The pool is created on first use and lives until the end of the program:
+ * - each worker owns a lock-free Chase-Lev deque, pushes and pops at its
+ *   bottom, and steals at the top of the others, workers of its own NUMA
+ *   node first;
+ * - tasks spawned by a thread that is not a worker (e.g. an application
+ *   thread) go to a shared injection queue;
+ * - a thread waiting for its children (taskwait) executes pending tasks
+ *   instead of blocking, so that any number of application threads can call
+ *   the parallel routines concurrently without nesting runtimes.
+ *
+ * Environment: \c FFLAS_NUM_THREADS sets the number of threads (workers +
+ * calling thread, default std::thread::hardware_concurrency()), and
+ * \c FFLAS_BIND_THREADS=1 pins the workers to the cpus of the process
+ * (Linux only).
+ */
+
+#ifndef __FFLASFFPACK_paladin_thread_pool_H
+#define __FFLASFFPACK_paladin_thread_pool_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace FFLAS { namespace Native {
+
+	struct TaskContext;
+
+	//! A spawned task, and the context of the task that spawned it
+	struct Task {
+		std::function<void()> run;
+		TaskContext* parent;
+	};
+
+	//! Children of the running task (or of the top level of a thread)
+	struct TaskContext {
+		std::atomic<size_t> pending;
+		TaskContext() : pending(0) {}
+	};
+
+	/** Chase-Lev work-stealing deque.
+	 * push and pop by the owner only, steal by anyone.
+	 * See Lê, Pop, Cohen, Zappa Nardelli, PPoPP'13 for the memory orders.
+	 */
+	class WorkStealingDeque {
+		struct Array {
+			const int64_t capacity;
+			std::atomic<Task*>* buffer;
+			Array(int64_t c) : capacity(c), buffer(new std::atomic<Task*>[c]) {}
+			~Array() { delete[] buffer; }
+			Task* get(int64_t i) const { return buffer[i & (capacity-1)].load(std::memory_order_relaxed); }
+			void put(int64_t i, Task* t) { buffer[i & (capacity-1)].store(t, std::memory_order_relaxed); }
+		};
+
+		std::atomic<int64_t> _top;
+		std::atomic<int64_t> _bottom;
+		std::atomic<Array*> _array;
+		// arrays replaced by a larger one are kept until the deque dies:
+		// a concurrent thief may still read them
+		std::vector<Array*> _retired;
+
+	public:
+		WorkStealingDeque(int64_t capacity = 1024) : _top(0), _bottom(0), _array(new Array(capacity)) {}
+
+		~WorkStealingDeque()
+		{
+			delete _array.load();
+			for (auto a : _retired) delete a;
+		}
+
+		void push(Task* t)
+		{
+			int64_t b = _bottom.load(std::memory_order_relaxed);
+			int64_t tp = _top.load(std::memory_order_acquire);
+			Array* a = _array.load(std::memory_order_relaxed);
+			if (b - tp > a->capacity - 1) {
+				Array* na = new Array(2*a->capacity);
+				for (int64_t i = tp; i < b; ++i)
+					na->put(i, a->get(i));
+				_retired.push_back(a);
+				_array.store(na, std::memory_order_release);
+				a = na;
+			}
+			a->put(b, t);
+			std::atomic_thread_fence(std::memory_order_release);
+			_bottom.store(b+1, std::memory_order_relaxed);
+		}
+
+		Task* pop()
+		{
+			int64_t b = _bottom.load(std::memory_order_relaxed) - 1;
+			Array* a = _array.load(std::memory_order_relaxed);
+			_bottom.store(b, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t tp = _top.load(std::memory_order_relaxed);
+			Task* t = nullptr;
+			if (tp <= b) {
+				t = a->get(b);
+				if (tp == b) {
+					// last element: race against the thieves
+					if (!_top.compare_exchange_strong(tp, tp+1, std::memory_order_seq_cst, std::memory_order_relaxed))
+						t = nullptr;
+					_bottom.store(b+1, std::memory_order_relaxed);
+				}
+			} else
+				_bottom.store(b+1, std::memory_order_relaxed);
+			return t;
+		}
+
+		Task* steal()
+		{
+			int64_t tp = _top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t b = _bottom.load(std::memory_order_acquire);
+			if (tp < b) {
+				Array* a = _array.load(std::memory_order_acquire);
+				Task* t = a->get(tp);
+				if (!_top.compare_exchange_strong(tp, tp+1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					return nullptr;
+				return t;
+			}
+			return nullptr;
+		}
+	};
+
+	namespace Protected {
+
+		//! index of the calling worker, -1 for any other thread
+		inline int& workerId()
+		{
+			static thread_local int id = -1;
+			return id;
+		}
+
+		//! context in which TASK registers its children
+		inline TaskContext*& currentContext()
+		{
+			static thread_local TaskContext root;
+			static thread_local TaskContext* current = &root;
+			return current;
+		}
+
+		inline size_t envThreads()
+		{
+			const char* env = std::getenv("FFLAS_NUM_THREADS");
+			if (env != NULL && std::atoi(env) > 0)
+				return (size_t) std::atoi(env);
+			size_t n = std::thread::hardware_concurrency();
+			return n ? n : 1;
+		}
+
+		// cpus the process may run on, and the NUMA node of each of them
+		inline void cpuTopology(std::vector<int>& cpus, std::vector<int>& nodes)
+		{
+			cpus.clear();
+			nodes.clear();
+#ifdef __linux__
+			cpu_set_t set;
+			CPU_ZERO(&set);
+			if (!sched_getaffinity(0, sizeof(set), &set))
+				for (int c = 0; c < CPU_SETSIZE; ++c)
+					if (CPU_ISSET(c, &set)) cpus.push_back(c);
+			std::vector<int> nodeOf(CPU_SETSIZE, 0);
+			for (int node = 0; ; ++node) {
+				char path[64];
+				snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+				FILE* f = fopen(path, "r");
+				if (f == NULL) break;
+				int lo, hi;
+				while (fscanf(f, "%d", &lo) == 1) {
+					hi = lo;
+					int c = fgetc(f);
+					if (c == '-') {
+						if (fscanf(f, "%d", &hi) != 1) break;
+						c = fgetc(f);
+					}
+					for (int i = lo; i <= hi && i < CPU_SETSIZE; ++i) nodeOf[i] = node;
+					if (c != ',') break;
+				}
+				fclose(f);
+			}
+			for (auto c : cpus) nodes.push_back(nodeOf[c]);
+#endif
+			if (cpus.empty()) {
+				cpus.push_back(0);
+				nodes.push_back(0);
+			}
+		}
+
+	} // Protected
+
+	class ThreadPool {
+		struct Worker {
+			WorkStealingDeque deque;
+			int cpu;
+			int node;
+			std::vector<int> victims; // steal order, own node first
+			std::thread thread;
+		};
+
+		std::vector<std::unique_ptr<Worker> > _workers;
+		std::mutex _injectMutex;
+		std::deque<Task*> _inject;
+		std::atomic<size_t> _injected;
+		std::atomic<long> _queued;
+		std::atomic<int> _sleepers;
+		std::atomic<bool> _stop;
+		std::mutex _sleepMutex;
+		std::condition_variable _sleepCv;
+
+		ThreadPool() : _injected(0), _queued(0), _sleepers(0), _stop(false)
+		{
+			const size_t nthreads = Protected::envThreads();
+			std::vector<int> cpus, nodes;
+			Protected::cpuTopology(cpus, nodes);
+			const char* bind = std::getenv("FFLAS_BIND_THREADS");
+			const bool pin = (bind != NULL && std::atoi(bind) != 0);
+
+			// the calling thread takes part in the computation when it waits
+			for (size_t i = 0; i+1 < nthreads; ++i) {
+				_workers.emplace_back(new Worker);
+				_workers[i]->cpu = cpus[(i+1) % cpus.size()];
+				_workers[i]->node = nodes[(i+1) % cpus.size()];
+			}
+			for (size_t i = 0; i < _workers.size(); ++i) {
+				std::vector<int>& v = _workers[i]->victims;
+				for (size_t d = 1; d < _workers.size(); ++d) {
+					size_t j = (i+d) % _workers.size();
+					if (_workers[j]->node == _workers[i]->node) v.push_back((int)j);
+				}
+				for (size_t d = 1; d < _workers.size(); ++d) {
+					size_t j = (i+d) % _workers.size();
+					if (_workers[j]->node != _workers[i]->node) v.push_back((int)j);
+				}
+			}
+			for (size_t i = 0; i < _workers.size(); ++i) {
+				_workers[i]->thread = std::thread(&ThreadPool::workerLoop, this, (int)i);
+#ifdef __linux__
+				if (pin) {
+					cpu_set_t set;
+					CPU_ZERO(&set);
+					CPU_SET(_workers[i]->cpu, &set);
+					pthread_setaffinity_np(_workers[i]->thread.native_handle(), sizeof(set), &set);
+				}
+#else
+				(void)pin;
+#endif
+			}
+		}
+
+		void workerLoop(int id)
+		{
+			Protected::workerId() = id;
+			unsigned idle = 0;
+			while (!_stop.load(std::memory_order_relaxed)) {
+				Task* t = take(id);
+				if (t != nullptr) {
+					execute(t);
+					idle = 0;
+				} else if (++idle < 64) {
+					std::this_thread::yield();
+				} else {
+					std::unique_lock<std::mutex> lock(_sleepMutex);
+					++_sleepers;
+					_sleepCv.wait(lock, [this]{ return _stop.load() || _queued.load() > 0; });
+					--_sleepers;
+					idle = 0;
+				}
+			}
+		}
+
+		Task* takeInjected()
+		{
+			std::lock_guard<std::mutex> lock(_injectMutex);
+			if (_inject.empty()) return nullptr;
+			Task* t = _inject.front();
+			_inject.pop_front();
+			--_injected;
+			return t;
+		}
+
+		Task* take(int self)
+		{
+			Task* t = nullptr;
+			if (self >= 0) {
+				Worker& w = *_workers[(size_t)self];
+				t = w.deque.pop();
+				if (t == nullptr && _injected.load() > 0) t = takeInjected();
+				for (size_t i = 0; t == nullptr && i < w.victims.size(); ++i)
+					t = _workers[(size_t)w.victims[i]]->deque.steal();
+			} else {
+				if (_injected.load() > 0) t = takeInjected();
+				for (size_t i = 0; t == nullptr && i < _workers.size(); ++i)
+					t = _workers[i]->deque.steal();
+			}
+			if (t != nullptr) --_queued;
+			return t;
+		}
+
+		void execute(Task* t)
+		{
+			TaskContext children;
+			TaskContext*& current = Protected::currentContext();
+			TaskContext* saved = current;
+			current = &children;
+			t->run();
+			// children may capture the locals of the task: they end with it
+			helpWhile(children);
+			current = saved;
+			--t->parent->pending;
+			delete t;
+		}
+
+	public:
+		static ThreadPool& instance()
+		{
+			static ThreadPool pool;
+			return pool;
+		}
+
+		~ThreadPool()
+		{
+			{
+				std::lock_guard<std::mutex> lock(_sleepMutex);
+				_stop = true;
+			}
+			_sleepCv.notify_all();
+			for (auto& w : _workers) w->thread.join();
+		}
+
+		//! number of threads executing tasks, the calling thread included
+		size_t size() const { return _workers.size() + 1; }
+
+		void submit(Task* t)
+		{
+			const int self = Protected::workerId();
+			// counted before being visible, so that _queued never goes below 0
+			++_queued;
+			if (self >= 0)
+				_workers[(size_t)self]->deque.push(t);
+			else {
+				std::lock_guard<std::mutex> lock(_injectMutex);
+				_inject.push_back(t);
+				++_injected;
+			}
+			if (_sleepers.load() > 0) {
+				std::lock_guard<std::mutex> lock(_sleepMutex);
+				_sleepCv.notify_one();
+			}
+		}
+
+		//! executes pending tasks until all the children of \p ctx are done
+		void helpWhile(TaskContext& ctx)
+		{
+			const int self = Protected::workerId();
+			unsigned idle = 0;
+			while (ctx.pending.load() > 0) {
+				Task* t = take(self);
+				if (t != nullptr) {
+					execute(t);
+					idle = 0;
+				} else if (++idle > 16)
+					std::this_thread::yield();
+			}
+		}
+	};
+
+	//! runs \p f asynchronously, as a child of the current task
+	template<class Func>
+	inline void spawn(Func&& f)
+	{
+		TaskContext* ctx = Protected::currentContext();
+		++ctx->pending;
+		ThreadPool::instance().submit(new Task{std::function<void()>(std::forward<Func>(f)), ctx});
+	}
+
+	//! waits for the children of the current task
+	inline void taskwait()
+	{
+		ThreadPool::instance().helpWhile(*Protected::currentContext());
+	}
+
+	inline size_t numThreads()
+	{
+		return ThreadPool::instance().size();
+	}
+
+} // Native
+} // FFLAS
+
+#endif // __FFLASFFPACK_paladin_thread_pool_H
@@ -25,69 +25,484 @@
 #define __FFLASFFPACK_matio_H
 
 #include <cstring>
+#include <limits>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdexcept>
+#include <string>
+#include <sstream>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "fflas-ffpack/fflas-ffpack-config.h"
+#ifdef __FFLASFFPACK_HAVE_ZLIB
+#include <zlib.h>
+#endif
 //#include "fflas-ffpack/fflas/fflas.h"
 #include "fflas_memory.h"
 
 // Reading and writing matrices over field
+//
+// Text format: a line "m n M", then one line "i j v" per non zero entry,
+// 1-based, and a final "0 0 0". Files ending in .gz are (de)compressed on
+// the fly, with zlib when available and through a gzip pipe otherwise.
+//
+// Binary format: a 64 bytes header (magic "FFLASDNS", version, element
+// kind and size, modulus, m, n) and the m x n elements, row major and little
+// endian. It is read with one mapping of the file, or mapped in place.
+
+namespace FFLAS { namespace details_matio {
+
+	inline bool is_gzipped(const std::string & path)
+	{
+		return path.size() > 3 && path.compare(path.size() - 3, 3, ".gz") == 0;
+	}
+
+	inline bool little_endian()
+	{
+		const uint16_t one = 1;
+		return *reinterpret_cast<const unsigned char*>(&one) == 1;
+	}
+
+	/* Buffered input of a text matrix: a plain file, a gzFile or a gunzip
+	 * pipe, read by blocks of 1MB and parsed in place.
+	 */
+	class TextInput {
+		static const size_t block = 1 << 20;
+		FILE * _file = NULL;
+		bool _pipe = false;
+#ifdef __FFLASFFPACK_HAVE_ZLIB
+		gzFile _gz = NULL;
+#endif
+		char * _buf;
+		size_t _pos = 0, _len = 0;
+
+		bool fill()
+		{
+			_pos = 0;
+#ifdef __FFLASFFPACK_HAVE_ZLIB
+			if (_gz != NULL) {
+				int r = gzread(_gz, _buf, (unsigned)block);
+				_len = (r > 0) ? (size_t)r : 0;
+				return _len > 0;
+			}
+#endif
+			_len = (_file != NULL) ? fread(_buf, 1, block, _file) : 0;
+			return _len > 0;
+		}
+
+		// next character, without consuming it; -1 at the end
+		int peek()
+		{
+			if (_pos == _len && !fill())
+				return -1;
+			return (unsigned char)_buf[_pos];
+		}
+
+		void skip_blanks()
+		{
+			for (int c = peek(); c == ' ' || c == '\t' || c == '\n' || c == '\r'; c = peek())
+				++_pos;
+		}
+
+	public:
+		TextInput(const std::string & path) : _buf(new char[block])
+		{
+			if (is_gzipped(path)) {
+#ifdef __FFLASFFPACK_HAVE_ZLIB
+				_gz = gzopen(path.c_str(), "rb");
+				if (_gz != NULL)
+					gzbuffer(_gz, (unsigned)block);
+#else
+				_file = popen(("gunzip -c '" + path + "'").c_str(), "r");
+				_pipe = true;
+#endif
+			}
+			else
+				_file = fopen(path.c_str(), "rb");
+		}
+
+		~TextInput()
+		{
+#ifdef __FFLASFFPACK_HAVE_ZLIB
+			if (_gz != NULL)
+				gzclose(_gz);
+#endif
+			if (_file != NULL) {
+				if (_pipe)
+					pclose(_file);
+				else
+					fclose(_file);
+			}
+			delete[] _buf;
+		}
+
+		bool good() const
+		{
+#ifdef __FFLASFFPACK_HAVE_ZLIB
+			if (_gz != NULL)
+				return true;
+#endif
+			return _file != NULL;
+		}
+
+		bool next_integer(long & v)
+		{
+			skip_blanks();
+			int c = peek();
+			bool neg = false;
+			if (c == '-' || c == '+') {
+				neg = (c == '-');
+				++_pos;
+				c = peek();
+			}
+			if (c < '0' || c > '9')
+				return false;
+			unsigned long u = 0;
+			for (; c >= '0' && c <= '9'; c = peek()) {
+				u = 10 * u + (unsigned long)(c - '0');
+				++_pos;
+			}
+			v = neg ? -(long)u : (long)u;
+			return true;
+		}
+
+		// skips the next word, as the M of the header
+		void next_word()
+		{
+			skip_blanks();
+			for (int c = peek(); c != -1 && c != ' ' && c != '\t' && c != '\n' && c != '\r'; c = peek())
+				++_pos;
+		}
+	};
+
+	// Buffered output of a text matrix, compressed when the path ends in .gz
+	class TextOutput {
+		static const size_t block = 1 << 20;
+		FILE * _file = NULL;
+		bool _pipe = false;
+#ifdef __FFLASFFPACK_HAVE_ZLIB
+		gzFile _gz = NULL;
+#endif
+		char * _buf;
+		size_t _len = 0;
+
+	public:
+		TextOutput(const std::string & path) : _buf(new char[block])
+		{
+			if (is_gzipped(path)) {
+#ifdef __FFLASFFPACK_HAVE_ZLIB
+				_gz = gzopen(path.c_str(), "wb6");
+#else
+				_file = popen(("gzip -c > '" + path + "'").c_str(), "w");
+				_pipe = true;
+#endif
+			}
+			else
+				_file = fopen(path.c_str(), "wb");
+			if (!good())
+				throw std::runtime_error("cannot write " + path);
+		}
+
+		~TextOutput()
+		{
+			flush();
+#ifdef __FFLASFFPACK_HAVE_ZLIB
+			if (_gz != NULL)
+				gzclose(_gz);
+#endif
+			if (_file != NULL) {
+				if (_pipe)
+					pclose(_file);
+				else
+					fclose(_file);
+			}
+			delete[] _buf;
+		}
+
+		bool good() const
+		{
+#ifdef __FFLASFFPACK_HAVE_ZLIB
+			if (_gz != NULL)
+				return true;
+#endif
+			return _file != NULL;
+		}
+
+		void flush()
+		{
+#ifdef __FFLASFFPACK_HAVE_ZLIB
+			if (_gz != NULL && _len > 0)
+				gzwrite(_gz, _buf, (unsigned)_len);
+#endif
+			if (_file != NULL && _len > 0)
+				fwrite(_buf, 1, _len, _file);
+			_len = 0;
+		}
+
+		void put(const char * s, size_t n)
+		{
+			if (_len + n > block)
+				flush();
+			memcpy(_buf + _len, s, n);
+			_len += n;
+		}
+
+		void put(char c) { put(&c, 1); }
+
+		void put_integer(long v)
+		{
+			char d[24];
+			size_t k = sizeof(d);
+			unsigned long u = (v < 0) ? 0UL - (unsigned long)v : (unsigned long)v;
+			do {
+				d[--k] = (char)('0' + u % 10);
+				u /= 10;
+			} while (u);
+			if (v < 0)
+				d[--k] = '-';
+			put(d + k, sizeof(d) - k);
+		}
+
+		template<class Element>
+		typename std::enable_if<std::is_arithmetic<Element>::value>::type put_element(const Element & e)
+		{
+			put_integer((long)e);
+		}
+
+		template<class Element>
+		typename std::enable_if<!std::is_arithmetic<Element>::value>::type put_element(const Element & e)
+		{
+			std::ostringstream os;
+			os << e;
+			put(os.str().c_str(), os.str().size());
+		}
+	};
+
+	struct DenseBinaryHeader {
+		char magic[8] = {'F', 'F', 'L', 'A', 'S', 'D', 'N', 'S'};
+		uint64_t version = 1;
+		uint64_t element_kind = 0; // 0 unsigned, 1 signed integer, 2 floating point
+		uint64_t element_size = 0;
+		uint64_t modulus = 0;
+		uint64_t rowdim = 0;
+		uint64_t coldim = 0;
+		uint64_t reserved = 0;
+	};
+
+	template<class Field>
+	DenseBinaryHeader dense_binary_header(const Field & F, size_t m, size_t n)
+	{
+		typedef typename Field::Element Element;
+		static_assert(std::is_arithmetic<Element>::value, "the binary format needs machine type elements");
+		DenseBinaryHeader h;
+		h.element_kind = std::is_floating_point<Element>::value ? 2 : (std::is_signed<Element>::value ? 1 : 0);
+		h.element_size = sizeof(Element);
+		h.modulus = static_cast<uint64_t>(F.characteristic());
+		h.rowdim = m;
+		h.coldim = n;
+		return h;
+	}
+
+	// the header fields and the elements are stored little endian
+	inline void to_little_endian(void * p, size_t size, size_t count)
+	{
+		if (little_endian())
+			return;
+		unsigned char * b = static_cast<unsigned char *>(p);
+		for (size_t i = 0; i < count; ++i, b += size)
+			for (size_t k = 0; k < size / 2; ++k)
+				std::swap(b[k], b[size - 1 - k]);
+	}
+
+	inline void header_to_little_endian(DenseBinaryHeader & h)
+	{
+		to_little_endian(&h.version, sizeof(uint64_t), 7);
+	}
+
+	// bytes of the elements of h, false if the file could not hold them
+	inline bool dense_binary_size(const DenseBinaryHeader & h, size_t & size)
+	{
+		const uint64_t max = std::numeric_limits<size_t>::max() - sizeof(DenseBinaryHeader);
+		if (h.coldim && h.rowdim > max / h.coldim)
+			return false;
+		const uint64_t mn = h.rowdim * h.coldim;
+		if (h.element_size && mn > max / h.element_size)
+			return false;
+		size = (size_t)(mn * h.element_size);
+		return true;
+	}
+
+	/* Maps the binary file path and checks its header against F; returns the
+	 * base of the mapping, of length *len. The file must be exactly as long
+	 * as its header says: unmap_field_binary recomputes the mapped length
+	 * from the dimensions.
+	 */
+	template<class Field>
+	char * map_dense_binary(const Field & F, const std::string & path, DenseBinaryHeader & h, size_t * len)
+	{
+		int fd = open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+			throw std::runtime_error("cannot open " + path);
+		struct stat sb;
+		if (fstat(fd, &sb) != 0 || (size_t)sb.st_size < sizeof(DenseBinaryHeader)) {
+			close(fd);
+			throw std::runtime_error(path + " is not a binary matrix");
+		}
+		*len = (size_t)sb.st_size;
+		void * p = mmap(NULL, *len, PROT_READ, MAP_PRIVATE, fd, 0);
+		close(fd);
+		if (p == MAP_FAILED)
+			throw std::runtime_error("cannot map " + path);
+		char * base = static_cast<char *>(p);
+		memcpy(&h, base, sizeof(DenseBinaryHeader));
+		header_to_little_endian(h);
+		const DenseBinaryHeader e = dense_binary_header(F, h.rowdim, h.coldim);
+		const char * error = NULL;
+		size_t size = 0;
+		if (memcmp(h.magic, e.magic, sizeof(h.magic)) != 0 || h.version != e.version)
+			error = " is not a binary matrix";
+		else if (h.element_kind != e.element_kind || h.element_size != e.element_size)
+			error = ": binary matrix of another element type";
+		else if (h.modulus != e.modulus)
+			error = ": binary matrix over another field";
+		else if (!dense_binary_size(h, size) || *len != sizeof(DenseBinaryHeader) + size)
+			error = ": truncated or corrupted binary matrix";
+		if (error != NULL) {
+			munmap(base, *len);
+			throw std::runtime_error(path + error);
+		}
+		madvise(base, *len, MADV_SEQUENTIAL);
+		return base;
+	}
+
+} // details_matio
+} // FFLAS
 
 // Reading a matrice from a (eventually zipped) file
 template<class Field>
 typename Field::Element_ptr read_field(const Field& F, const char * mat_file,int* tni,int* tnj)
 {
-	char *UT = NULL;
-	const char* File_Name;
-	int is_gzipped = 0;
-	size_t s = strlen(mat_file);
 	typename Field::Element_ptr X = NULL;
-	if ((mat_file[--s] == 'z') &&
-	    (mat_file[--s] == 'g') &&
-	    (mat_file[--s] == '.')) {
-		is_gzipped = 1;
-		char tmp_nam[] = "/tmp/bbXXXXXX_";
-		if (mkstemp(tmp_nam))
-			printf("Error opening file]\n");
-		File_Name  = tmp_nam;
-
-		UT = FFLAS::fflas_new<char>(s+34+strlen(File_Name));
-		sprintf(UT,"gunzip -c %s > %s", mat_file, File_Name);
-		if (system(UT))
-			printf("Error uncompressing file\n");
-		sprintf(UT,"\\rm %s", File_Name);
-	} else {
-		File_Name = mat_file;
+	FFLAS::details_matio::TextInput in(mat_file);
+	if (!in.good()) {
+		printf("Error opening file %s\n", mat_file);
+		return X;
 	}
-
-	FILE* FileDes = fopen(File_Name, "r");
-	if (FileDes != NULL) {
-		char  tmp [200];// unsigned long tni, tnj;
-		if (fscanf(FileDes,"%d %d %199s\n",tni, tnj, tmp)<0)
-			printf("Error Reading first line of file \n");
-		int n=*tni;
-		int p=*tnj;
-		X = FFLAS::fflas_new<typename Field::Element>(n*p);
-		for (int i=0;i<n*p;++i)
-			F.assign(X[i], F.zero);
-		long i,j; long val;
-		if(fscanf(FileDes,"%ld %ld %ld\n",&i, &j, &val)<0)
+	long n, p;
+	if (!in.next_integer(n) || !in.next_integer(p) || n < 0 || p < 0) {
+		printf("Error Reading first line of file \n");
+		return X;
+	}
+	in.next_word();
+	*tni = (int)n;
+	*tnj = (int)p;
+	X = FFLAS::fflas_new(F, (size_t)n, (size_t)p, FFLAS::Alignment::CACHE_LINE);
+	for (long i=0;i<n*p;++i)
+		F.assign(X[i], F.zero);
+	long i,j,val;
+	while (in.next_integer(i) && in.next_integer(j) && in.next_integer(val) && i && j) {
+		if (i < 1 || i > n || j < 1 || j > p) {
 			printf("Read Error\n");
-		while(i && j) {
-			F.init(X[p*(i-1)+j-1],val);
-			if(fscanf(FileDes,"%ld %ld %ld\n",&i, &j, &val)<0)
-				printf("Read Error\n");
+			break;
+		}
+		F.init(X[p*(i-1)+j-1],val);
+	}
+	return X;
+}
+
+// Writing a matrix in the format of read_field, compressed if mat_file ends in .gz
+template<class Field>
+void write_field_file(const Field& F, const char * mat_file,
+		      typename Field::ConstElement_ptr A, size_t m, size_t n, size_t lda)
+{
+	FFLAS::details_matio::TextOutput out(mat_file);
+	out.put_integer((long)m); out.put(' ');
+	out.put_integer((long)n); out.put(" M\n", 3);
+	for (size_t i = 0; i < m; ++i)
+		for (size_t j = 0; j < n; ++j)
+			if (!F.isZero(A[i*lda+j])) {
+				out.put_integer((long)i+1); out.put(' ');
+				out.put_integer((long)j+1); out.put(' ');
+				out.put_element(A[i*lda+j]); out.put('\n');
+			}
+	out.put("0 0 0\n", 6);
+}
+
+// Writing a matrix in the binary format
+template<class Field>
+void write_field_binary(const Field& F, const char * mat_file,
+			typename Field::ConstElement_ptr A, size_t m, size_t n, size_t lda)
+{
+	typedef typename Field::Element Element;
+	using namespace FFLAS::details_matio;
+	DenseBinaryHeader h = dense_binary_header(F, m, n);
+	header_to_little_endian(h);
+	FILE * file = fopen(mat_file, "wb");
+	if (file == NULL)
+		throw std::runtime_error(std::string("cannot write ") + mat_file);
+	bool ok = fwrite(&h, sizeof(h), 1, file) == 1;
+	if (little_endian() && lda == n)
+		ok = ok && fwrite(A, sizeof(Element), m*n, file) == m*n;
+	else {
+		Element * row = new Element[n ? n : 1];
+		for (size_t i = 0; ok && i < m; ++i) {
+			memcpy(row, A + i*lda, n*sizeof(Element));
+			to_little_endian(row, sizeof(Element), n);
+			ok = fwrite(row, sizeof(Element), n, file) == n;
 		}
-		fclose(FileDes);
+		delete[] row;
 	}
+	ok = (fclose(file) == 0) && ok;
+	if (!ok)
+		throw std::runtime_error(std::string("error while writing ") + mat_file);
+}
 
-	if (is_gzipped)
-		if (system(UT))
-			printf("Error uncompressing file\n");
-	if (UT != NULL)
-		FFLAS::fflas_delete( UT);
+// Reading a matrix in the binary format into a cache line aligned buffer
+template<class Field>
+typename Field::Element_ptr read_field_binary(const Field& F, const char * mat_file, int* tni, int* tnj)
+{
+	typedef typename Field::Element Element;
+	using namespace FFLAS::details_matio;
+	DenseBinaryHeader h;
+	size_t len;
+	char * base = map_dense_binary(F, mat_file, h, &len);
+	*tni = (int)h.rowdim;
+	*tnj = (int)h.coldim;
+	typename Field::Element_ptr X = FFLAS::fflas_new(F, h.rowdim, h.coldim, FFLAS::Alignment::CACHE_LINE);
+	memcpy(X, base + sizeof(DenseBinaryHeader), h.rowdim*h.coldim*sizeof(Element));
+	to_little_endian(X, sizeof(Element), h.rowdim*h.coldim);
+	munmap(base, len);
 	return X;
 }
 
+/* Mapping a matrix in the binary format without copying it: the elements
+ * start 64 bytes after the page aligned mapping. Little endian machines
+ * only; release it with unmap_field_binary.
+ */
+template<class Field>
+typename Field::ConstElement_ptr map_field_binary(const Field& F, const char * mat_file, int* tni, int* tnj)
+{
+	using namespace FFLAS::details_matio;
+	if (!little_endian())
+		throw std::runtime_error("map_field_binary needs a little endian machine, use read_field_binary");
+	DenseBinaryHeader h;
+	size_t len;
+	char * base = map_dense_binary(F, mat_file, h, &len);
+	*tni = (int)h.rowdim;
+	*tnj = (int)h.coldim;
+	return reinterpret_cast<typename Field::ConstElement_ptr>(base + sizeof(DenseBinaryHeader));
+}
+
+template<class Field>
+void unmap_field_binary(const Field&, typename Field::ConstElement_ptr A, int m, int n)
+{
+	const char * base = reinterpret_cast<const char *>(A) - sizeof(FFLAS::details_matio::DenseBinaryHeader);
+	munmap(const_cast<char *>(base), sizeof(FFLAS::details_matio::DenseBinaryHeader) + (size_t)m*n*sizeof(typename Field::Element));
+}
+
 // Displays a matrix
 template<class Field>
 std::ostream& write_field(const Field& F,std::ostream& c,
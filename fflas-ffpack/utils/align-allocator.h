@@ -51,11 +51,14 @@ enum class Alignment : size_t {
   Normal = sizeof(void*),
   SSE = 16,
   AVX = 32,
+  AVX512 = 64,
   XEON_PHI = 64,
   CACHE_LINE = 64,
   CACHE_PAGESIZE = 4096,
   DEFAULT =
-#ifdef __FFLASFFPACK_USE_AVX
+#ifdef __FFLASFFPACK_USE_AVX512F
+  64
+#elif defined(__FFLASFFPACK_USE_AVX)
   32
 #else
   16
@@ -379,5 +379,67 @@ inline int queryTopLevelCacheSize()
   return (std::max)(l2,l3);
 }
 
+//---------- Instruction set extensions ----------
+
+/** \brief SIMD extensions supported by the running CPU (and enabled by the OS).
+ * Unlike the \c __FFLASFFPACK_USE_XXX macros, which describe what the code
+ * was compiled for, this is what the machine executing it can do.
+ */
+struct CpuFeatures {
+	bool sse41    = false;
+	bool avx      = false;
+	bool fma      = false;
+	bool avx2     = false;
+	bool avx512f  = false;
+	bool avx512dq = false;
+};
+
+/** \internal
+ * Queries the CPU with cpuid, and xgetbv for the register state saved by the OS */
+inline CpuFeatures queryCpuFeatures()
+{
+	CpuFeatures f;
+#if defined(EIGEN_CPUID) && defined(__GNUC__)
+	int abcd[4] = {0,0,0,0};
+	EIGEN_CPUID(abcd,0x0,0);
+	int max_std_funcs = abcd[0];
+	if (max_std_funcs < 1)
+		return f;
+
+	EIGEN_CPUID(abcd,0x1,0);
+	f.sse41 = (abcd[2] >> 19) & 1; // C[19]
+	bool osxsave = (abcd[2] >> 27) & 1; // C[27]
+	bool cpu_avx = (abcd[2] >> 28) & 1; // C[28]
+	bool cpu_fma = (abcd[2] >> 12) & 1; // C[12]
+
+	// XCR0[2:1] : SSE and AVX states, XCR0[7:5] : opmask and ZMM states
+	uint64_t xcr0 = 0;
+	if (osxsave) {
+		uint32_t eax, edx;
+		__asm__ __volatile__ ("xgetbv" : "=a" (eax), "=d" (edx) : "c" (0));
+		xcr0 = ((uint64_t)edx << 32) | eax;
+	}
+	bool os_avx    = (xcr0 & 0x06) == 0x06;
+	bool os_avx512 = (xcr0 & 0xE6) == 0xE6;
+
+	f.avx = cpu_avx && os_avx;
+	f.fma = cpu_fma && f.avx;
+	if (max_std_funcs >= 7) {
+		EIGEN_CPUID(abcd,0x7,0);
+		f.avx2     = f.avx && ((abcd[1] >> 5) & 1);  // B[5]
+		f.avx512f  = os_avx512 && f.avx2 && ((abcd[1] >> 16) & 1); // B[16]
+		f.avx512dq = f.avx512f && ((abcd[1] >> 17) & 1); // B[17]
+	}
+#endif
+	return f;
+}
+
+/** \returns the SIMD extensions of the running CPU (queried once) */
+inline const CpuFeatures& cpuFeatures()
+{
+	static const CpuFeatures features = queryCpuFeatures();
+	return features;
+}
+
 } // namespace FFLAS
 #endif // __FFLASFFPACK_memory_H
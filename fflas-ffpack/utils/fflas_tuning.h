@@ -0,0 +1,262 @@
+/* -*- mode: C++; tab-width: 8; indent-tabs-mode: t; c-basic-offset: 8 -*- */
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/*
+ * Copyright (C) 2016 the FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ *.
+ */
+
+/** @file utils/fflas_tuning.h
+ * @brief Machine profile holding the run time thresholds of the library.
+ *
+ * The profile is read once, on first use of FFLAS::tuning(), from the file
+ * named by the environment variable \c FFLASFFPACK_PROFILE, or else from
+ * \c __FFLASFFPACK_PROFILE_PATH if defined, or else from
+ * \c $HOME/.fflas-ffpack-profile. Setting \c FFLASFFPACK_PROFILE to an empty
+ * string disables the profile. Thresholds missing from the file keep their
+ * compile time default. The file is written by the \c fflas-ffpack-tune tool
+ * and is made of <tt>key = value</tt> lines, \c # starting a comment.
+ */
+
+#ifndef __FFLASFFPACK_utils_fflas_tuning_H
+#define __FFLASFFPACK_utils_fflas_tuning_H
+
+#include "fflas-ffpack/fflas-ffpack-config.h"
+
+#include <cstdlib>
+#include <cstddef>
+#include <climits>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <string>
+
+// compile time defaults, used for the thresholds missing from the profile
+#ifndef __FFLASFFPACK_WINOTHRESHOLD_INT64
+#define __FFLASFFPACK_WINOTHRESHOLD_INT64 __FFLASFFPACK_WINOTHRESHOLD
+#endif
+
+#ifndef __FFLASFFPACK_DEFAULT_DOUBLE_TO_FLOAT_CROSSOVER
+#define __FFLASFFPACK_DEFAULT_DOUBLE_TO_FLOAT_CROSSOVER 800
+#endif
+
+#ifndef __FFLASFFPACK_DEFAULT_SEQPARTHRESHOLD
+#define __FFLASFFPACK_DEFAULT_SEQPARTHRESHOLD 220
+#endif
+
+#ifndef __FFLASFFPACK_DEFAULT_PTRSM_THRESHOLD
+#define __FFLASFFPACK_DEFAULT_PTRSM_THRESHOLD 256
+#endif
+
+#ifndef __FFLASFFPACK_DEFAULT_PLUQ_BASECASE
+#define __FFLASFFPACK_DEFAULT_PLUQ_BASECASE 256
+#endif
+
+#ifndef __FFLASFFPACK_DEFAULT_PPLUQ_BASECASE
+#define __FFLASFFPACK_DEFAULT_PPLUQ_BASECASE 256
+#endif
+
+#ifndef __FFLASFFPACK_DEFAULT_SPARSE_DENSE_THRESHOLD
+#define __FFLASFFPACK_DEFAULT_SPARSE_DENSE_THRESHOLD 0.5
+#endif
+
+namespace FFLAS {
+
+	struct TuningProfile {
+		//! fgemm: dimension from which one Strassen-Winograd level pays off
+		size_t winothreshold;           // Modular<double>
+		size_t winothreshold_flt;       // Modular<float>
+		size_t winothreshold_bal;       // ModularBalanced<double>
+		size_t winothreshold_bal_flt;   // ModularBalanced<float>
+		size_t winothreshold_int64;     // Modular<int64_t> and ModularBalanced<int64_t>
+		//! cardinality below which integer and double fields compute over float
+		//! (2 never converts)
+		size_t double_to_float_crossover;
+		//! pfgemm: square root of the smallest block given to a task
+		size_t seqpar_threshold;
+		//! pfgemm: cutting strategy measured as the fastest (informative)
+		std::string pfgemm_strategy;
+		//! pftrsm: smallest number of rows of B given to a task
+		size_t ptrsm_threshold;
+		//! PLUQ and pPLUQ: dimension under which the Crout base case is used
+		size_t pluq_basecase;
+		size_t ppluq_basecase;
+		//! sparse: proportion of non zero entries from which a row is dense
+		double sparse_dense_threshold;
+		//! sparse: fastest formats for regular and irregular row lengths
+		std::string sparse_format_regular;
+		std::string sparse_format_irregular;
+		//! file the profile was read from, empty if none
+		std::string source;
+
+		TuningProfile() :
+			winothreshold(__FFLASFFPACK_WINOTHRESHOLD),
+			winothreshold_flt(__FFLASFFPACK_WINOTHRESHOLD_FLT),
+			winothreshold_bal(__FFLASFFPACK_WINOTHRESHOLD_BAL),
+			winothreshold_bal_flt(__FFLASFFPACK_WINOTHRESHOLD_BAL_FLT),
+			winothreshold_int64(__FFLASFFPACK_WINOTHRESHOLD_INT64),
+			double_to_float_crossover(__FFLASFFPACK_DEFAULT_DOUBLE_TO_FLOAT_CROSSOVER),
+			seqpar_threshold(__FFLASFFPACK_DEFAULT_SEQPARTHRESHOLD),
+			pfgemm_strategy("Recursive-TwoDAdaptive"),
+			ptrsm_threshold(__FFLASFFPACK_DEFAULT_PTRSM_THRESHOLD),
+			pluq_basecase(__FFLASFFPACK_DEFAULT_PLUQ_BASECASE),
+			ppluq_basecase(__FFLASFFPACK_DEFAULT_PPLUQ_BASECASE),
+			sparse_dense_threshold(__FFLASFFPACK_DEFAULT_SPARSE_DENSE_THRESHOLD),
+			sparse_format_regular("ELL"),
+			sparse_format_irregular("CSR_HYB")
+		{}
+
+		/** Reads the \p key = \p value lines of \p filename.
+		 * Returns false if the file can not be opened; unknown keys and
+		 * malformed or out of range values are skipped, keeping the
+		 * current value.
+		 */
+		bool load (const std::string & filename)
+		{
+			std::ifstream in (filename.c_str());
+			if (!in) return false;
+			std::string line;
+			while (std::getline (in, line)) {
+				size_t c = line.find('#');
+				if (c != std::string::npos) line.erase(c);
+				size_t e = line.find('=');
+				if (e == std::string::npos) continue;
+				std::string key, value;
+				std::istringstream (line.substr(0,e)) >> key;
+				std::istringstream (line.substr(e+1)) >> value;
+				if (!key.empty() && !value.empty())
+					set (key, value);
+			}
+			source = filename;
+			return true;
+		}
+
+		/** Sets the threshold named \p key, returns false, leaving it
+		 * unchanged, if \p key or \p value is invalid.
+		 * The dimensions must be positive integers fitting an int: a zero
+		 * Winograd threshold would never stop the recursion.
+		 */
+		bool set (const std::string & key, const std::string & value)
+		{
+			std::istringstream v (value);
+			if (key == "winothreshold")                  return readDim (v, winothreshold);
+			if (key == "winothreshold_flt")              return readDim (v, winothreshold_flt);
+			if (key == "winothreshold_bal")              return readDim (v, winothreshold_bal);
+			if (key == "winothreshold_bal_flt")          return readDim (v, winothreshold_bal_flt);
+			if (key == "winothreshold_int64")            return readDim (v, winothreshold_int64);
+			if (key == "double_to_float_crossover")      return readDim (v, double_to_float_crossover);
+			if (key == "seqpar_threshold")               return readDim (v, seqpar_threshold);
+			if (key == "pfgemm_strategy")                return read (v, pfgemm_strategy);
+			if (key == "ptrsm_threshold")                return readDim (v, ptrsm_threshold);
+			if (key == "pluq_basecase")                  return readDim (v, pluq_basecase);
+			if (key == "ppluq_basecase")                 return readDim (v, ppluq_basecase);
+			if (key == "sparse_dense_threshold")         return readRatio (v, sparse_dense_threshold);
+			if (key == "sparse_format_regular")          return read (v, sparse_format_regular);
+			if (key == "sparse_format_irregular")        return read (v, sparse_format_irregular);
+			return false;
+		}
+
+		std::ostream& write (std::ostream & out) const
+		{
+			return out << "winothreshold = "             << winothreshold << std::endl
+				   << "winothreshold_flt = "         << winothreshold_flt << std::endl
+				   << "winothreshold_bal = "         << winothreshold_bal << std::endl
+				   << "winothreshold_bal_flt = "     << winothreshold_bal_flt << std::endl
+				   << "winothreshold_int64 = "       << winothreshold_int64 << std::endl
+				   << "double_to_float_crossover = " << double_to_float_crossover << std::endl
+				   << "seqpar_threshold = "          << seqpar_threshold << std::endl
+				   << "pfgemm_strategy = "           << pfgemm_strategy << std::endl
+				   << "ptrsm_threshold = "           << ptrsm_threshold << std::endl
+				   << "pluq_basecase = "             << pluq_basecase << std::endl
+				   << "ppluq_basecase = "            << ppluq_basecase << std::endl
+				   << "sparse_dense_threshold = "    << sparse_dense_threshold << std::endl
+				   << "sparse_format_regular = "     << sparse_format_regular << std::endl
+				   << "sparse_format_irregular = "   << sparse_format_irregular << std::endl;
+		}
+
+		bool save (const std::string & filename) const
+		{
+			std::ofstream out (filename.c_str());
+			if (!out) return false;
+			out << "# fflas-ffpack machine profile" << std::endl;
+			write (out);
+			return (bool) out;
+		}
+
+	private:
+		template<class T>
+		static bool read (std::istringstream & v, T & x)
+		{
+			T y;
+			char c;
+			if (!(v >> y) || (v >> c)) return false;
+			x = y;
+			return true;
+		}
+
+		// read as signed, so that "-1" is rejected rather than wrapped
+		static bool readDim (std::istringstream & v, size_t & x)
+		{
+			long long y;
+			if (!read (v, y) || y <= 0 || y > INT_MAX) return false;
+			x = (size_t) y;
+			return true;
+		}
+
+		static bool readRatio (std::istringstream & v, double & x)
+		{
+			double y;
+			if (!read (v, y) || !(y > 0. && y <= 1.)) return false;
+			x = y;
+			return true;
+		}
+	};
+
+	//! Name of the profile file read by tuning(), empty if none
+	inline std::string tuningProfilePath ()
+	{
+		const char * env = std::getenv ("FFLASFFPACK_PROFILE");
+		if (env) return std::string (env);
+#ifdef __FFLASFFPACK_PROFILE_PATH
+		return std::string (__FFLASFFPACK_PROFILE_PATH);
+#else
+		const char * home = std::getenv ("HOME");
+		return home ? std::string (home) + "/.fflas-ffpack-profile" : std::string ();
+#endif
+	}
+
+	/** Machine profile of the library.
+	 * Loaded on the first call; the thresholds can be changed afterwards
+	 * but not concurrently with the routines using them.
+	 */
+	inline TuningProfile & tuning ()
+	{
+		static TuningProfile P = [] {
+			TuningProfile T;
+			std::string file = tuningProfilePath ();
+			if (!file.empty()) T.load (file);
+			return T;
+		}();
+		return P;
+	}
+
+} // FFLAS
+
+#endif // __FFLASFFPACK_utils_fflas_tuning_H
@@ -0,0 +1,174 @@
+/* -*- mode: C++; tab-width: 8; indent-tabs-mode: t; c-basic-offset: 8 -*- */
+// vim:sts=8:sw=8:ts=8:noet:sr:cino=>s,f0,{0,g0,(0,\:0,t0,+0,=s
+/*
+ * Copyright (C) 2016 the FFLAS-FFPACK group
+ *
+ * ========LICENCE========
+ * This file is part of the library FFLAS-FFPACK.
+ *
+ * FFLAS-FFPACK is free software: you can redistribute it and/or modify
+ * it under the terms of the  GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ * ========LICENCE========
+ *.
+ */
+
+/** @file utils/fflas_workspace.h
+ * @brief Stack arena for the temporaries of the recursive fgemm schedules.
+ *
+ * A MMWorkspace is one aligned buffer handing out sub-buffers in stack
+ * order. It is attached to a MMHelper (field \c workspace) and every
+ * recursion level of Strassen-Winograd takes its temporaries on top of
+ * it instead of calling fflas_new/fflas_delete. The arena is not thread
+ * safe: it is only used by sequential helpers.
+ */
+
+#ifndef __FFLASFFPACK_utils_fflas_workspace_H
+#define __FFLASFFPACK_utils_fflas_workspace_H
+
+#include <cstddef>
+#include <type_traits>
+
+#include "fflas-ffpack/utils/fflas_memory.h"
+
+namespace FFLAS {
+
+	class MMWorkspace {
+	public:
+		//! granularity of the sub-buffers, in bytes
+		static const size_t align = (size_t) Alignment::CACHE_LINE;
+
+		//! number of bytes taken in the arena by \p nelts elements of type \p T
+		template<class T>
+		static size_t footprint (const size_t nelts)
+		{
+			return ((nelts*sizeof(T) + align - 1) / align) * align;
+		}
+
+		//! an arena of \p bytes bytes
+		explicit MMWorkspace (const size_t bytes) :
+			_base(bytes ? malloc_align<char>(bytes, Alignment::CACHE_LINE) : nullptr),
+			_size(_base ? bytes : 0), _top(0), _peak(0), _misses(0)
+		{}
+
+		//! an arena holding \p nelts elements of \p F (as returned by fgemm_workspace_size)
+		template<class Field>
+		MMWorkspace (const Field& F, const size_t nelts) :
+			MMWorkspace(nelts * sizeof(typename Field::Element))
+		{}
+
+		~MMWorkspace() { free(_base); }
+
+		MMWorkspace (const MMWorkspace&) = delete;
+		MMWorkspace& operator= (const MMWorkspace&) = delete;
+
+		//! size of the arena in bytes
+		size_t capacity() const { return _size; }
+		//! bytes currently handed out
+		size_t used() const { return _top; }
+		//! largest number of bytes handed out since construction
+		size_t peak() const { return _peak; }
+		//! number of allocations refused because the arena was full
+		size_t misses() const { return _misses; }
+
+		size_t mark() const { return _top; }
+		void rewind (const size_t m) { _top = m; }
+
+		/** Takes \p m x \p n elements of \p F on top of the arena.
+		 * Returns \c nullptr when the arena is full or when the elements
+		 * need to be constructed (multiprecision fields): the caller then
+		 * falls back to fflas_new.
+		 */
+		template<class Field>
+		typename Field::Element_ptr allocate (const Field& F, const size_t m, const size_t n)
+		{
+			typedef typename Field::Element Element;
+			if (!std::is_trivial<Element>::value)
+				return nullptr;
+			const size_t b = footprint<Element>(m*n);
+			if (b > _size - _top) {
+				++_misses;
+				return nullptr;
+			}
+			typename Field::Element_ptr p = reinterpret_cast<typename Field::Element_ptr>(_base + _top);
+			_top += b;
+			if (_top > _peak) _peak = _top;
+			return p;
+		}
+
+		//! whether \p p was handed out by this arena
+		bool owns (const void* p) const
+		{
+			return (const char*)p >= _base && (const char*)p < _base + _size;
+		}
+
+	private:
+		char * _base;
+		size_t _size;
+		size_t _top;
+		size_t _peak;
+		size_t _misses;
+	};
+
+	namespace Protected {
+
+		/** Scope of one recursion level in a MMWorkspace.
+		 * Buffers are taken from the arena when there is one and it is
+		 * large enough, from fflas_new otherwise. Arena buffers are all
+		 * given back when the frame goes out of scope, so that release
+		 * only frees the heap ones and buffers can be released in any
+		 * order.
+		 */
+		class WorkspaceFrame {
+		public:
+			explicit WorkspaceFrame (MMWorkspace * W) :
+				_ws(W), _mark(W ? W->mark() : 0)
+			{}
+
+			~WorkspaceFrame() { if (_ws) _ws->rewind(_mark); }
+
+			template<class Field>
+			typename Field::Element_ptr allocate (const Field& F, const size_t m, const size_t n)
+			{
+				typename Field::Element_ptr p = nullptr;
+				if (_ws) p = _ws->allocate(F, m, n);
+				return p ? p : fflas_new(F, m, n);
+			}
+
+			template<class Element_ptr>
+			void release (Element_ptr p)
+			{
+				if (!(_ws && _ws->owns(p)))
+					fflas_delete(p);
+			}
+
+			template<class Ptr, class ...Args>
+			void release (Ptr p, Args ... args)
+			{
+				release(p);
+				release(args...);
+			}
+
+			WorkspaceFrame (const WorkspaceFrame&) = delete;
+			WorkspaceFrame& operator= (const WorkspaceFrame&) = delete;
+
+		private:
+			MMWorkspace * _ws;
+			size_t _mark;
+		};
+
+	} // Protected
+
+} // FFLAS
+
+#endif // __FFLASFFPACK_utils_fflas_workspace_H
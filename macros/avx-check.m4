@@ -22,7 +22,7 @@ dnl
 
 dnl FF_CHECK_AVX
 dnl
-dnl turn on AVX or AVX2 extensions if available
+dnl turn on AVX, AVX2 or AVX512F extensions if available
 
 AC_DEFUN([FF_CHECK_AVX],
 [
@@ -100,6 +100,85 @@ AC_DEFUN([FF_CHECK_AVX],
 				AC_DEFINE(USE_AVX2,1,[Define if AVX2 is available])
 				AVXFLAGS=${AVX2FLAGS}
 				AC_SUBST(AVXFLAGS)
+
+		        dnl Check for AVX512F
+				AC_MSG_CHECKING(for AVX512F)
+
+			    for switch_avx512flags in "" "-mfma -mavx2 -mavx512f" "-mfma -mavx2 -mavx512f -mavx512dq"; do
+				    CXXFLAGS="${BACKUP_CXXFLAGS} -O0 ${switch_avx512flags}"
+				    AC_TRY_RUN(
+				    [
+				        #define __try_avx2
+				        #define __try_avx512f
+					    ${CODE_AVX}
+				    ],
+				    [
+				        avx512_found="yes"
+				        AVX512FLAGS=${switch_avx512flags}
+				        break
+			        ],
+				    [
+				        avx512_found="no"
+			        ],
+				    [
+				        echo "cross compiling...disabling"
+				        avx512_found="no"
+				        break
+				    ])
+				done
+
+		        dnl Is AVX512F found?
+				AS_IF([ test "x$avx512_found" = "xyes" ],
+				[
+					AC_MSG_RESULT(yes)
+					AC_DEFINE(USE_AVX512F,1,[Define if AVX512F is available])
+					AVXFLAGS=${AVX512FLAGS}
+					AC_SUBST(AVXFLAGS)
+
+			        dnl Check for AVX512IFMA (52 bits integer multiply-add, used by igemm modulo p)
+					AC_MSG_CHECKING(for AVX512IFMA)
+
+				    for switch_ifmaflags in "" "-mavx512ifma"; do
+					    CXXFLAGS="${BACKUP_CXXFLAGS} -O0 ${AVX512FLAGS} ${switch_ifmaflags}"
+					    AC_TRY_RUN(
+					    [
+					        #define __try_avx2
+					        #define __try_avx512f
+					        #define __try_avx512ifma
+						    ${CODE_AVX}
+					    ],
+					    [
+					        ifma_found="yes"
+					        IFMAFLAGS=${switch_ifmaflags}
+					        break
+				        ],
+					    [
+					        ifma_found="no"
+				        ],
+					    [
+					        echo "cross compiling...disabling"
+					        ifma_found="no"
+					        break
+					    ])
+					done
+
+					AS_IF([ test "x$ifma_found" = "xyes" ],
+					[
+						AC_MSG_RESULT(yes)
+						AC_DEFINE(USE_AVX512IFMA,1,[Define if AVX512IFMA is available])
+						AVXFLAGS="${AVX512FLAGS} ${IFMAFLAGS}"
+						AC_SUBST(AVXFLAGS)
+					],
+					[
+						AC_MSG_RESULT(no)
+					]
+					)
+				],
+				[
+			        dnl No AVX512F
+				    AC_MSG_RESULT(no)
+			    ]
+				)
 			],
 			[
 		        dnl No AVX2
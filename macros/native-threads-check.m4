@@ -0,0 +1,69 @@
+dnl Check for the native thread pool of paladin
+dnl  Copyright (c) 2016 FFLAS-FFPACK
+dnl ========LICENCE========
+dnl This file is part of the library FFLAS-FFPACK.
+dnl
+dnl FFLAS-FFPACK is free software: you can redistribute it and/or modify
+dnl it under the terms of the  GNU Lesser General Public
+dnl License as published by the Free Software Foundation; either
+dnl version 2.1 of the License, or (at your option) any later version.
+dnl
+dnl This library is distributed in the hope that it will be useful,
+dnl but WITHOUT ANY WARRANTY; without even the implied warranty of
+dnl MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+dnl Lesser General Public License for more details.
+dnl
+dnl You should have received a copy of the GNU Lesser General Public
+dnl License along with this library; if not, write to the Free Software
+dnl Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+dnl ========LICENCE========
+dnl
+
+
+dnl FF_CHECK_NATIVE_THREADS
+dnl
+dnl use the std::thread work-stealing pool of paladin instead of OpenMP.
+dnl Must be called before FF_CHECK_OMP, which it disables.
+
+AC_DEFUN([FF_CHECK_NATIVE_THREADS],
+	[ AC_ARG_ENABLE(native-threads,
+		[AC_HELP_STRING([--enable-native-threads],
+				[ Use the native thread pool instead of OpenMP ])
+		],
+		[ avec_native_threads=$enable_native_threads],
+		[ avec_native_threads=no ]
+		)
+	  AC_MSG_CHECKING(for native threads)
+	  THREADFLAGS=
+	  AS_IF([ test "x$avec_native_threads" != "xno" ],
+		[
+		BACKUP_CXXFLAGS=${CXXFLAGS}
+		THREADFLAGS="-pthread"
+		CXXFLAGS="${BACKUP_CXXFLAGS} ${THREADFLAGS}"
+		AC_TRY_LINK([
+#include <thread>
+#include <atomic>
+			void f(std::atomic<int> * a) { ++(*a); }
+		],
+		[ std::atomic<int> a(0); std::thread t(f,&a); t.join(); return a-1; ],
+		[ native_found="yes" ],
+		[ native_found="no" ])
+		CXXFLAGS=${BACKUP_CXXFLAGS}
+		AS_IF(	[ test "x$native_found" = "xyes" ],
+			[
+				AC_DEFINE(USE_NATIVE_THREADS,1,[Define to use the native thread pool])
+				AC_MSG_RESULT(yes)
+				enable_openmp=no
+			],
+			[
+				THREADFLAGS=
+				AC_MSG_RESULT(no)
+			]
+		)
+		],
+		[ AC_MSG_RESULT(no) ]
+	)
+	AM_CONDITIONAL(FFLASFFPACK_NATIVE_THREADS, test "x$native_found" = "xyes")
+	AC_SUBST(THREADFLAGS)
+]
+)
@@ -0,0 +1,88 @@
+dnl Check for the SIMD runtime dispatch
+dnl  Copyright (c) 2016 FFLAS-FFPACK
+dnl ========LICENCE========
+dnl This file is part of the library FFLAS-FFPACK.
+dnl
+dnl FFLAS-FFPACK is free software: you can redistribute it and/or modify
+dnl it under the terms of the  GNU Lesser General Public
+dnl License as published by the Free Software Foundation; either
+dnl version 2.1 of the License, or (at your option) any later version.
+dnl
+dnl This library is distributed in the hope that it will be useful,
+dnl but WITHOUT ANY WARRANTY; without even the implied warranty of
+dnl MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+dnl Lesser General Public License for more details.
+dnl
+dnl You should have received a copy of the GNU Lesser General Public
+dnl License along with this library; if not, write to the Free Software
+dnl Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+dnl ========LICENCE========
+dnl
+
+
+dnl FF_CHECK_SIMD_DISPATCH
+dnl
+dnl compile libfflas and libffpack for the baseline of the architecture,
+dnl without the instruction set flags found by FF_CHECK_SSE/FF_CHECK_AVX,
+dnl and add AVX2 and AVX512F variants of some kernels and of fgemm, fgemv
+dnl and PLUQ, selected at runtime. Each variant is a translation unit whose
+dnl fflas and ffpack code follows a #pragma GCC target. Needs FF_PRECOMPILE.
+
+AC_DEFUN([FF_CHECK_SIMD_DISPATCH],
+[
+	AC_ARG_ENABLE(simd-dispatch,
+	[ AC_HELP_STRING([--enable-simd-dispatch], [ Build libfflas/libffpack for any CPU of the architecture, with AVX2/AVX512F variants selected at runtime ]) ],
+	[ avec_dispatch=$enable_simd_dispatch ],
+	[ avec_dispatch=no ]
+	)
+
+	dispatch_avx2="no"
+	dispatch_avx512="no"
+	LIBPARFLAGS='${PARFLAGS}'
+
+	AC_MSG_CHECKING(for SIMD runtime dispatch)
+
+	AS_IF([ test "x$avec_dispatch" != "xno" -a "x$enable_precompilation" = "xyes" ],
+	[
+		AC_MSG_RESULT(yes)
+
+		dnl AVX2 variants
+		AC_MSG_CHECKING(whether the AVX2 variants can be compiled)
+		AC_COMPILE_IFELSE([AC_LANG_PROGRAM([[#include <immintrin.h>
+			#pragma GCC push_options
+			#pragma GCC target("avx2,fma")
+			int f(int x) { __m256i a = _mm256_set1_epi64x(x); a = _mm256_add_epi64(a,a); return _mm256_extract_epi32(a,0); }
+			#pragma GCC pop_options]],
+			[[ return f(1) != 2; ]])],
+		[
+			dispatch_avx2="yes"
+			AC_DEFINE(DISPATCH_AVX2,1,[Define if libfflas contains the AVX2 variants of the runtime dispatch])
+		])
+		AC_MSG_RESULT($dispatch_avx2)
+
+		dnl AVX512F variants
+		AC_MSG_CHECKING(whether the AVX512F variants can be compiled)
+		AC_COMPILE_IFELSE([AC_LANG_PROGRAM([[#include <immintrin.h>
+			#pragma GCC push_options
+			#pragma GCC target("avx512f,avx512dq,avx2,fma")
+			long f(long x) { __m512i a = _mm512_set1_epi64(x); a = _mm512_mullo_epi64(a,a); return _mm512_reduce_add_epi64(a); }
+			#pragma GCC pop_options]],
+			[[ return f(1) != 8; ]])],
+		[
+			dispatch_avx512="yes"
+			AC_DEFINE(DISPATCH_AVX512F,1,[Define if libfflas contains the AVX512F variants of the runtime dispatch])
+		])
+		AC_MSG_RESULT($dispatch_avx512)
+
+		dnl the libraries get neither the flags nor the macros of FF_CHECK_SSE/FF_CHECK_AVX,
+		dnl the variants define the macros of their instruction set
+		LIBPARFLAGS='${OMPFLAGS} ${THREADFLAGS} -D__FFLASFFPACK_DISPATCH_BASELINE'
+	],
+	[
+		dnl no precompilation or --enable-simd-dispatch=no
+		AC_MSG_RESULT(no)
+	]
+	)
+
+	AC_SUBST(LIBPARFLAGS)
+])
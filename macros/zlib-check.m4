@@ -0,0 +1,65 @@
+dnl Check for zlib, used by the compressed matrix readers of Matio.h
+dnl  Copyright (c) 2016 FFLAS-FFPACK
+dnl ========LICENCE========
+dnl This file is part of the library FFLAS-FFPACK.
+dnl
+dnl FFLAS-FFPACK is free software: you can redistribute it and/or modify
+dnl it under the terms of the  GNU Lesser General Public
+dnl License as published by the Free Software Foundation; either
+dnl version 2.1 of the License, or (at your option) any later version.
+dnl
+dnl This library is distributed in the hope that it will be useful,
+dnl but WITHOUT ANY WARRANTY; without even the implied warranty of
+dnl MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+dnl Lesser General Public License for more details.
+dnl
+dnl You should have received a copy of the GNU Lesser General Public
+dnl License along with this library; if not, write to the Free Software
+dnl Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+dnl ========LICENCE========
+dnl
+
+
+dnl FF_CHECK_ZLIB
+dnl
+dnl zlib is optional: without it the .gz matrices are read through a
+dnl gunzip pipe.
+
+AC_DEFUN([FF_CHECK_ZLIB],
+	[ AC_ARG_WITH(zlib,
+		[AC_HELP_STRING([--with-zlib],
+				[ Read and write compressed matrices with zlib (default: when found) ])
+		],
+		[ avec_zlib=$withval ],
+		[ avec_zlib=check ]
+		)
+	  AC_MSG_CHECKING(for zlib)
+	  ZLIB_LIBS=
+	  AS_IF([ test "x$avec_zlib" != "xno" ],
+		[
+		BACKUP_LIBS=${LIBS}
+		LIBS="${BACKUP_LIBS} -lz"
+		AC_TRY_LINK([
+#include <zlib.h>
+		],
+		[ gzFile f = gzopen("", "rb"); return f != 0; ],
+		[ zlib_found="yes" ],
+		[ zlib_found="no" ])
+		LIBS=${BACKUP_LIBS}
+		AS_IF(	[ test "x$zlib_found" = "xyes" ],
+			[
+				AC_DEFINE(HAVE_ZLIB,1,[Define if zlib is available])
+				ZLIB_LIBS="-lz"
+				AC_MSG_RESULT(yes)
+			],
+			[
+				AC_MSG_RESULT(no)
+				AS_IF([ test "x$avec_zlib" = "xyes" ], [ AC_MSG_ERROR([zlib was requested but not found]) ])
+			]
+		)
+		],
+		[ AC_MSG_RESULT(no) ]
+	)
+	AC_SUBST(ZLIB_LIBS)
+]
+)
@@ -39,11 +39,15 @@
 #include "fflas-ffpack/utils/debug.h"
 #include "fflas-ffpack/ffpack/ffpack.h"
 #include "fflas-ffpack/utils/fflas_randommatrix.h"
+#include "fflas-ffpack/fflas/fflas_sparse.h"
 #include <givaro/givinteger.h>
 #include <givaro/givintprime.h>
 #include <givaro/givranditer.h>
 #include <chrono>
+#include <iostream>
+#include <limits>
 #include <random>
+#include <vector>
 
 namespace FFPACK {
 
@@ -98,6 +102,137 @@ namespace FFPACK {
 		return new Field(p);
 	}
 
+	//! Entries of the random sparse matrices
+	enum class SparseEntries {
+		Random,       //!< random elements of the field
+		One,          //!< all one, for the ZO formats
+		PlusMinusOne  //!< 1 or -1, but one in 8 random
+	};
+
+	/*! Random m x n matrix in coordinate format and its dense copy D, of leading dimension n.
+	 * Row i has about len(i) entries, len(i) >= n giving a dense row, and the column fullcol,
+	 * if any, is full. The entries are sorted by rows, or by columns with bycolumns.
+	 */
+	template<class Field, class RowLength>
+	void random_sparse(const Field & F, size_t m, size_t n, RowLength len, SparseEntries entries,
+			   std::vector<index_t> & row, std::vector<index_t> & col,
+			   std::vector<typename Field::Element> & dat, typename Field::Element_ptr D,
+			   size_t fullcol = std::numeric_limits<size_t>::max(), bool bycolumns = false)
+	{
+		typename Field::RandIter G(F);
+		typename Field::Element x;
+		FFLAS::fzero(F, m, n, D, n);
+		for (size_t a = 0 ; a < (bycolumns ? n : m) ; ++a)
+			for (size_t b = 0 ; b < (bycolumns ? m : n) ; ++b) {
+				const size_t i = bycolumns ? b : a;
+				const size_t j = bycolumns ? a : b;
+				if (j != fullcol && (size_t)rand() % n >= len(i)) continue;
+				if (entries == SparseEntries::One)
+					F.assign(x, F.one);
+				else if (entries == SparseEntries::PlusMinusOne && (rand() % 8))
+					F.assign(x, (rand() % 2) ? F.one : F.mOne);
+				else
+					G.random(x);
+				row.push_back((index_t)i);
+				col.push_back((index_t)j);
+				dat.push_back(x);
+				F.assign(D[i*n+j], x);
+			}
+	}
+
+	/*! Sparse matrix A with the non zero entries of the m x n dense matrix D, of leading
+	 * dimension n, for the tests that modify a random_sparse matrix densely.
+	 */
+	template<class Field, class SM>
+	void sparse_from_dense(const Field & F, SM & A, typename Field::ConstElement_ptr D, size_t m, size_t n)
+	{
+		std::vector<index_t> row, col;
+		std::vector<typename Field::Element> dat;
+		for (size_t i = 0 ; i < m ; ++i)
+			for (size_t j = 0 ; j < n ; ++j)
+				if (!F.isZero(D[i*n+j])) {
+					row.push_back((index_t)i);
+					col.push_back((index_t)j);
+					dat.push_back(D[i*n+j]);
+				}
+		FFLAS::sparse_init(F, A, row.data(), col.data(), dat.data(), m, n, dat.size());
+	}
+
+	/*! Checks the products y = beta y + op(A) x for one and several vectors, op(A) being A
+	 * or A^T, against fgemv and fgemm on the dense copy D of A. With par, also checks
+	 * fspmv and fspmm with a ParSeqHelper::Parallel, and pfspmv and pfspmm, or their
+	 * transposes, with OpenMP.
+	 */
+	template<class Field, class SM>
+	bool check_products(const Field & F, const SM & A, typename Field::ConstElement_ptr D, size_t m, size_t n,
+			    const char * name, FFLAS::FFLAS_TRANSPOSE ta = FFLAS::FflasNoTrans, bool par = true)
+	{
+		typedef typename Field::Element_ptr Element_ptr;
+		const bool notrans = (ta == FFLAS::FflasNoTrans);
+		const size_t bs = 5;
+		const size_t rx = notrans ? n : m;
+		const size_t ry = notrans ? m : n;
+		Element_ptr x = FFLAS::fflas_new(F, rx, bs);
+		Element_ptr y = FFLAS::fflas_new(F, ry, bs);
+		Element_ptr z = FFLAS::fflas_new(F, ry, bs);
+		RandomMatrix(F, x, rx, bs, bs);
+		RandomMatrix(F, y, ry, bs, bs);
+		FFLAS::fassign(F, ry, bs, y, bs, z, bs);
+		typename Field::Element beta;
+		F.init(beta, 3);
+
+		// the sparse products update y, the dense ones z
+		bool pass = true;
+		auto check_mv = [&]() {
+			FFLAS::fgemv(F, ta, m, n, F.one, D, n, x, bs, beta, z, bs);
+			pass &= FFLAS::fequal(F, ry, 1, y, bs, z, bs);
+		};
+		auto check_mm = [&](const typename Field::Element & b) {
+			FFLAS::fgemm(F, ta, FFLAS::FflasNoTrans, ry, bs, rx, F.one, D, n, x, bs, b, z, bs);
+			pass &= FFLAS::fequal(F, ry, bs, y, bs, z, bs);
+		};
+
+		if (notrans) {
+			FFLAS::fspmv(F, A, x, beta, y);
+			check_mv();
+			FFLAS::fspmm(F, A, bs, x, bs, F.zero, y, bs);
+			check_mm(F.zero);
+			FFLAS::fspmm(F, A, bs, x, bs, beta, y, bs);
+			check_mm(beta);
+			if (par) {
+				FFLAS::fspmv(F, A, x, beta, y, FFLAS::ParSeqHelper::Parallel<>());
+				check_mv();
+				FFLAS::fspmm(F, A, bs, x, bs, beta, y, bs, FFLAS::ParSeqHelper::Parallel<>());
+				check_mm(beta);
+			}
+		} else {
+			FFLAS::fspmv_transpose(F, A, x, beta, y);
+			check_mv();
+			FFLAS::fspmm_transpose(F, A, bs, x, bs, F.zero, y, bs);
+			check_mm(F.zero);
+			FFLAS::fspmm_transpose(F, A, bs, x, bs, beta, y, bs);
+			check_mm(beta);
+		}
+#if defined(__FFLASFFPACK_USE_OPENMP)
+		if (par && notrans) {
+			FFLAS::pfspmv(F, A, x, beta, y);
+			check_mv();
+			FFLAS::pfspmm(F, A, bs, x, bs, beta, y, bs);
+			check_mm(beta);
+		} else if (par) {
+			FFLAS::pfspmv_transpose(F, A, x, beta, y);
+			check_mv();
+			FFLAS::pfspmm_transpose(F, A, bs, x, bs, beta, y, bs);
+			check_mm(beta);
+		}
+#endif
+
+		if (!pass)
+			F.write(std::cout << name << (notrans ? " A x" : " A^T x") << " failed over ") << std::endl;
+		FFLAS::fflas_delete(x, y, z);
+		return pass;
+	}
+
 
 
 } // FFPACK